@@ -0,0 +1,82 @@
+/**
+ * @file BenchmarkCommon.hpp
+ * @brief VoxelCraft Benchmarks - Shared timing and reporting helpers
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#ifndef VOXELCRAFT_BENCHMARKS_BENCHMARK_COMMON_HPP
+#define VOXELCRAFT_BENCHMARKS_BENCHMARK_COMMON_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace VoxelCraft {
+namespace Benchmark {
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Keep a value alive so the optimizer cannot drop the work producing it
+     */
+    template<typename T>
+    inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r,m"(value) : "memory");
+#else
+        static volatile const T* sink;
+        sink = &value;
+#endif
+    }
+
+    /**
+     * @brief Run fn once and return elapsed seconds
+     */
+    template<typename Fn>
+    inline double MeasureSeconds(Fn&& fn) {
+        auto start = Clock::now();
+        fn();
+        auto end = Clock::now();
+        return std::chrono::duration<double>(end - start).count();
+    }
+
+    /**
+     * @brief Run fn repetitions times and return the best elapsed seconds
+     */
+    template<typename Fn>
+    inline double MeasureBestSeconds(int repetitions, Fn&& fn) {
+        double best = 1e300;
+        for (int i = 0; i < repetitions; ++i) {
+            best = std::min(best, MeasureSeconds(fn));
+        }
+        return best;
+    }
+
+    /**
+     * @brief Percentile of a sample set (p in [0, 100])
+     */
+    inline double Percentile(std::vector<double> samples, double p) {
+        if (samples.empty()) {
+            return 0.0;
+        }
+        std::sort(samples.begin(), samples.end());
+        size_t index = static_cast<size_t>((p / 100.0) * static_cast<double>(samples.size() - 1) + 0.5);
+        return samples[std::min(index, samples.size() - 1)];
+    }
+
+    inline void PrintHeader(const std::string& title) {
+        std::printf("\n=== %s ===\n", title.c_str());
+    }
+
+    inline void PrintRow(const std::string& label, double value, const char* unit) {
+        std::printf("  %-40s %14.3f %s\n", label.c_str(), value, unit);
+    }
+
+} // namespace Benchmark
+} // namespace VoxelCraft
+
+#endif // VOXELCRAFT_BENCHMARKS_BENCHMARK_COMMON_HPP
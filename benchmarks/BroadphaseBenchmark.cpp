@@ -0,0 +1,370 @@
+/**
+ * @file BroadphaseBenchmark.cpp
+ * @brief Broadphase pair finding: brute force, spatial hash, sweep and prune, dynamic AABB tree
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * Boxes of 0.5 to 2 blocks drift through a cube sized for a constant
+ * density; one in ten is static. Every frame each broadphase updates its
+ * structure for the new positions and then reports all overlapping pairs.
+ * The hash and sweep and prune mirror CollisionSystem (hash rebuilt every
+ * frame, SAP kept sorted on x by insertion sort); the tree is the
+ * DynamicAABBTree it now uses. 50k is PhysicsConfig::maxColliders.
+ *
+ * Every method must report the same pairs each frame (count and an
+ * order-independent checksum). Brute force is only run for the first few
+ * frames at the larger sizes.
+ *
+ * Usage: BroadphaseBenchmark [frames]
+ */
+
+#include "BenchmarkCommon.hpp"
+
+#include "physics/DynamicAABBTree.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <unordered_map>
+
+using namespace VoxelCraft;
+using namespace VoxelCraft::Benchmark;
+
+namespace {
+
+    constexpr float TIME_STEP = 1.0f / 60.0f;
+    constexpr float VOLUME_PER_BODY = 24.0f;
+    constexpr float MAX_SPEED = 4.0f;           // Blocks per second
+    constexpr float HASH_CELL_SIZE = 2.0f;
+
+    struct Body {
+        TreeBounds bounds;
+        float velocity[3];
+        bool isStatic;
+    };
+
+    struct FrameResult {
+        uint64_t pairs = 0;
+        uint64_t checksum = 0;
+
+        void Add(uint32_t a, uint32_t b) {
+            if (a > b) {
+                std::swap(a, b);
+            }
+            uint64_t h = (static_cast<uint64_t>(a) << 32 | b) * 0x9E3779B97F4A7C15ull;
+            h ^= h >> 29;
+            checksum += h;
+            ++pairs;
+        }
+
+        bool operator==(const FrameResult& other) const {
+            return pairs == other.pairs && checksum == other.checksum;
+        }
+    };
+
+    class Scene {
+    public:
+        Scene(size_t count, uint32_t seed) : m_extent(std::cbrt(VOLUME_PER_BODY * static_cast<float>(count))) {
+            std::mt19937 rng(seed);
+            std::uniform_real_distribution<float> position(0.0f, m_extent);
+            std::uniform_real_distribution<float> size(0.5f, 2.0f);
+            std::uniform_real_distribution<float> speed(-MAX_SPEED, MAX_SPEED);
+
+            m_bodies.resize(count);
+            for (size_t i = 0; i < count; ++i) {
+                Body& body = m_bodies[i];
+                body.isStatic = i % 10 == 0;
+                for (int axis = 0; axis < 3; ++axis) {
+                    body.bounds.min[axis] = position(rng);
+                    body.bounds.max[axis] = body.bounds.min[axis] + size(rng);
+                    body.velocity[axis] = body.isStatic ? 0.0f : speed(rng);
+                }
+            }
+        }
+
+        void Step() {
+            for (Body& body : m_bodies) {
+                if (body.isStatic) {
+                    continue;
+                }
+                for (int axis = 0; axis < 3; ++axis) {
+                    const float delta = body.velocity[axis] * TIME_STEP;
+                    body.bounds.min[axis] += delta;
+                    body.bounds.max[axis] += delta;
+                    if (body.bounds.min[axis] < 0.0f || body.bounds.max[axis] > m_extent) {
+                        body.velocity[axis] = -body.velocity[axis];
+                    }
+                }
+            }
+        }
+
+        const std::vector<Body>& GetBodies() const { return m_bodies; }
+
+    private:
+        float m_extent;
+        std::vector<Body> m_bodies;
+    };
+
+    /**
+     * @brief Interface shared by the four broadphases under test
+     */
+    class Broadphase {
+    public:
+        virtual ~Broadphase() = default;
+        virtual const char* GetName() const = 0;
+        virtual void Update(const std::vector<Body>& bodies) = 0;
+        virtual FrameResult FindPairs(const std::vector<Body>& bodies) = 0;
+    };
+
+    class BruteForce : public Broadphase {
+    public:
+        const char* GetName() const override { return "brute force"; }
+
+        void Update(const std::vector<Body>&) override {}
+
+        FrameResult FindPairs(const std::vector<Body>& bodies) override {
+            FrameResult result;
+            const uint32_t count = static_cast<uint32_t>(bodies.size());
+            for (uint32_t i = 0; i < count; ++i) {
+                for (uint32_t j = i + 1; j < count; ++j) {
+                    if (bodies[i].bounds.Overlaps(bodies[j].bounds)) {
+                        result.Add(i, j);
+                    }
+                }
+            }
+            return result;
+        }
+    };
+
+    class SpatialHash : public Broadphase {
+    public:
+        const char* GetName() const override { return "spatial hash"; }
+
+        void Update(const std::vector<Body>& bodies) override {
+            m_cells.clear();
+            for (uint32_t i = 0; i < bodies.size(); ++i) {
+                const TreeBounds& b = bodies[i].bounds;
+                for (int x = Cell(b.min[0]); x <= Cell(b.max[0]); ++x) {
+                    for (int y = Cell(b.min[1]); y <= Cell(b.max[1]); ++y) {
+                        for (int z = Cell(b.min[2]); z <= Cell(b.max[2]); ++z) {
+                            m_cells[Key(x, y, z)].push_back(i);
+                        }
+                    }
+                }
+            }
+        }
+
+        FrameResult FindPairs(const std::vector<Body>& bodies) override {
+            FrameResult result;
+            for (const auto& cell : m_cells) {
+                const std::vector<uint32_t>& ids = cell.second;
+                for (size_t i = 0; i < ids.size(); ++i) {
+                    for (size_t j = i + 1; j < ids.size(); ++j) {
+                        const TreeBounds& a = bodies[ids[i]].bounds;
+                        const TreeBounds& b = bodies[ids[j]].bounds;
+                        if (!a.Overlaps(b)) {
+                            continue;
+                        }
+                        const uint64_t owner = Key(Cell(std::max(a.min[0], b.min[0])),
+                                                   Cell(std::max(a.min[1], b.min[1])),
+                                                   Cell(std::max(a.min[2], b.min[2])));
+                        if (owner == cell.first) {
+                            result.Add(ids[i], ids[j]);
+                        }
+                    }
+                }
+            }
+            return result;
+        }
+
+    private:
+        static int Cell(float v) { return static_cast<int>(std::floor(v / HASH_CELL_SIZE)); }
+
+        static uint64_t Key(int x, int y, int z) {
+            const uint64_t mask = (1ull << 21) - 1;
+            return (static_cast<uint64_t>(x) & mask) << 42 |
+                   (static_cast<uint64_t>(y) & mask) << 21 |
+                   (static_cast<uint64_t>(z) & mask);
+        }
+
+        std::unordered_map<uint64_t, std::vector<uint32_t>> m_cells;
+    };
+
+    class SweepAndPrune : public Broadphase {
+    public:
+        const char* GetName() const override { return "sweep and prune"; }
+
+        void Update(const std::vector<Body>& bodies) override {
+            if (m_sorted.size() != bodies.size()) {
+                m_sorted.resize(bodies.size());
+                for (uint32_t i = 0; i < bodies.size(); ++i) {
+                    m_sorted[i] = i;
+                }
+            }
+
+            for (size_t i = 1; i < m_sorted.size(); ++i) {
+                const uint32_t id = m_sorted[i];
+                const float key = bodies[id].bounds.min[0];
+                size_t j = i;
+                while (j > 0 && bodies[m_sorted[j - 1]].bounds.min[0] > key) {
+                    m_sorted[j] = m_sorted[j - 1];
+                    --j;
+                }
+                m_sorted[j] = id;
+            }
+        }
+
+        FrameResult FindPairs(const std::vector<Body>& bodies) override {
+            FrameResult result;
+            for (size_t i = 0; i < m_sorted.size(); ++i) {
+                const TreeBounds& a = bodies[m_sorted[i]].bounds;
+                for (size_t j = i + 1; j < m_sorted.size(); ++j) {
+                    const TreeBounds& b = bodies[m_sorted[j]].bounds;
+                    if (b.min[0] > a.max[0]) {
+                        break;
+                    }
+                    if (a.Overlaps(b)) {
+                        result.Add(m_sorted[i], m_sorted[j]);
+                    }
+                }
+            }
+            return result;
+        }
+
+    private:
+        std::vector<uint32_t> m_sorted;
+    };
+
+    class TreeBroadphase : public Broadphase {
+    public:
+        const char* GetName() const override { return "dynamic AABB tree"; }
+
+        void Update(const std::vector<Body>& bodies) override {
+            if (m_proxies.empty()) {
+                for (uint32_t i = 0; i < bodies.size(); ++i) {
+                    m_proxies.push_back(m_tree.CreateProxy(bodies[i].bounds, reinterpret_cast<void*>(static_cast<uintptr_t>(i))));
+                }
+                return;
+            }
+
+            for (uint32_t i = 0; i < bodies.size(); ++i) {
+                const Body& body = bodies[i];
+                if (body.isStatic) {
+                    continue;
+                }
+                float displacement[3];
+                for (int axis = 0; axis < 3; ++axis) {
+                    displacement[axis] = body.velocity[axis] * TIME_STEP;
+                }
+                m_tree.MoveProxy(m_proxies[i], body.bounds, displacement);
+            }
+        }
+
+        FrameResult FindPairs(const std::vector<Body>& bodies) override {
+            FrameResult result;
+            m_tree.QueryAllPairs([&](int32_t proxyA, int32_t proxyB) {
+                const uint32_t a = Id(proxyA);
+                const uint32_t b = Id(proxyB);
+                if (bodies[a].bounds.Overlaps(bodies[b].bounds)) {
+                    result.Add(a, b);
+                }
+            });
+            return result;
+        }
+
+        const DynamicAABBTree& GetTree() const { return m_tree; }
+
+    private:
+        uint32_t Id(int32_t proxyId) const {
+            return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(m_tree.GetUserData(proxyId)));
+        }
+
+        DynamicAABBTree m_tree;
+        std::vector<int32_t> m_proxies;
+    };
+
+    struct MethodTiming {
+        double updateSeconds = 0.0;
+        double pairSeconds = 0.0;
+        int frames = 0;
+    };
+
+    bool RunSize(size_t count, int frames) {
+        PrintHeader(std::to_string(count) + " bodies, " + std::to_string(frames) + " frames");
+
+        BruteForce brute;
+        SpatialHash hash;
+        SweepAndPrune sap;
+        TreeBroadphase tree;
+        Broadphase* methods[] = { &brute, &hash, &sap, &tree };
+        constexpr int METHOD_COUNT = 4;
+
+        // Brute force is quadratic; a few frames are enough to time it
+        const int bruteFrames = count <= 1000 ? frames : (count <= 10000 ? 4 : 1);
+
+        Scene scene(count, 1234u);
+        MethodTiming timings[METHOD_COUNT];
+        uint64_t totalPairs = 0;
+        bool agree = true;
+
+        for (int frame = 0; frame < frames; ++frame) {
+            scene.Step();
+            const std::vector<Body>& bodies = scene.GetBodies();
+
+            FrameResult reference;
+            bool haveReference = false;
+            for (int m = 0; m < METHOD_COUNT; ++m) {
+                if (methods[m] == &brute && frame >= bruteFrames) {
+                    continue;
+                }
+
+                FrameResult result;
+                timings[m].updateSeconds += MeasureSeconds([&] { methods[m]->Update(bodies); });
+                timings[m].pairSeconds += MeasureSeconds([&] { result = methods[m]->FindPairs(bodies); });
+                ++timings[m].frames;
+
+                if (!haveReference) {
+                    reference = result;
+                    haveReference = true;
+                } else if (!(result == reference)) {
+                    std::printf("  MISMATCH frame %d: %s found %llu pairs, expected %llu\n", frame,
+                                methods[m]->GetName(), static_cast<unsigned long long>(result.pairs),
+                                static_cast<unsigned long long>(reference.pairs));
+                    agree = false;
+                }
+            }
+            totalPairs += reference.pairs;
+        }
+
+        PrintRow("overlapping pairs per frame", static_cast<double>(totalPairs) / frames, "");
+        for (int m = 0; m < METHOD_COUNT; ++m) {
+            const double frameCount = std::max(timings[m].frames, 1);
+            const std::string name = methods[m]->GetName();
+            PrintRow(name + " update", timings[m].updateSeconds * 1000.0 / frameCount, "ms/frame");
+            PrintRow(name + " pairs", timings[m].pairSeconds * 1000.0 / frameCount, "ms/frame");
+            PrintRow(name + " total", (timings[m].updateSeconds + timings[m].pairSeconds) * 1000.0 / frameCount, "ms/frame");
+        }
+
+        // The first update builds the tree; these are the per-frame reinsertions after that
+        const DynamicAABBTree::Stats stats = tree.GetTree().GetStats();
+        PrintRow("tree reinsertions per frame", static_cast<double>(stats.reinsertions) / std::max(frames - 1, 1), "");
+        PrintRow("tree rotations per frame", static_cast<double>(stats.rotations) / std::max(frames - 1, 1), "");
+        PrintRow("tree height", static_cast<double>(stats.height), "");
+        PrintRow("tree area ratio", static_cast<double>(stats.areaRatio), "");
+
+        const bool valid = tree.GetTree().Validate();
+        std::printf("  tree valid: %s, pairs agree: %s\n", valid ? "yes" : "NO", agree ? "yes" : "NO");
+        return valid && agree;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? std::max(2, std::atoi(argv[1])) : 60;
+
+    bool ok = true;
+    for (size_t count : { size_t(1000), size_t(10000), size_t(50000) }) {
+        ok &= RunSize(count, frames);
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,344 @@
+/**
+ * @file ChunkCacheBenchmark.cpp
+ * @brief Scripted back-and-forth walk against the compressed chunk cache
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * A player with a 17x17-chunk view walks back and forth over a home strip,
+ * takes one long trip away and comes back to the strip, once on foot and
+ * once by teleporting straight home. Chunks leaving the
+ * view are compressed into the cache; chunks entering it come from the
+ * cache, from "disk" (chunks written back earlier) or are regenerated.
+ * One chunk in ten gets a player edit, so it must survive eviction, a disk
+ * round trip and the reload.
+ *
+ * Compared at the same byte budget: the old cache (unordered_map erased
+ * from begin() once over an entry count, saves written at unload) and
+ * CompressedChunkCache with LRU and with ARC. Regeneration uses a cheap
+ * analytic terrain, so times understate what a miss costs in the game.
+ *
+ * Usage: ChunkCacheBenchmark [budget MiB]
+ */
+
+#include "BenchmarkCommon.hpp"
+
+#include "blocks/Block.hpp"
+#include "world/Chunk.hpp"
+#include "world/ChunkCodec.hpp"
+#include "world/CompressedChunkCache.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace VoxelCraft;
+using namespace VoxelCraft::Benchmark;
+
+namespace {
+
+    constexpr int32_t VIEW_RADIUS = 8;
+    constexpr int32_t HOME_LENGTH = 64;
+    constexpr int32_t HOME_TRIPS = 4;
+    constexpr int32_t EXCURSION_LENGTH = 256;
+    constexpr int32_t SEA_LEVEL = 62;
+    constexpr uint8_t EDIT_Y = 120;
+
+    int32_t SurfaceHeight(int32_t x, int32_t z) {
+        double h = 64.0 +
+                   8.0 * std::sin(x * 0.045) * std::cos(z * 0.038) +
+                   4.0 * std::sin((x + z) * 0.11) +
+                   1.5 * std::cos(x * 0.31 - z * 0.27);
+        return static_cast<int32_t>(h);
+    }
+
+    std::shared_ptr<Chunk> GenerateTerrain(const ChunkCoord& coord) {
+        auto chunk = std::make_shared<Chunk>(coord);
+
+        for (int32_t z = 0; z < 16; ++z) {
+            for (int32_t x = 0; x < 16; ++x) {
+                const int32_t wx = coord.x * 16 + x;
+                const int32_t wz = coord.z * 16 + z;
+                const int32_t height = SurfaceHeight(wx, wz);
+
+                for (int32_t y = 0; y <= std::max(height, SEA_LEVEL); ++y) {
+                    BlockType type = BlockType::STONE;
+                    if (y == 0) {
+                        type = BlockType::BEDROCK;
+                    } else if (y > height) {
+                        type = BlockType::WATER;
+                    } else if (y == height) {
+                        type = height >= SEA_LEVEL ? BlockType::GRASS_BLOCK : BlockType::DIRT;
+                    } else if (y + 4 > height) {
+                        type = BlockType::DIRT;
+                    } else if ((wx * 7 + y * 13 + wz * 31) % 97 == 0) {
+                        type = BlockType::COAL_ORE;
+                    }
+                    chunk->SetBlockId(static_cast<uint8_t>(x), static_cast<uint8_t>(y), static_cast<uint8_t>(z),
+                        static_cast<uint16_t>(type));
+                }
+            }
+        }
+
+        return chunk;
+    }
+
+    bool IsEdited(const ChunkCoord& coord) {
+        return ((coord.x * 31 + coord.z * 17) % 10 + 10) % 10 == 0;
+    }
+
+    // Player x position for every step of the script; the excursion ends
+    // by walking home or by teleporting (respawn, portal) straight there
+    std::vector<int32_t> WalkScript(bool teleportHome) {
+        std::vector<int32_t> steps;
+        auto walk = [&steps](int32_t from, int32_t to) {
+            const int32_t direction = to > from ? 1 : -1;
+            for (int32_t x = from; x != to; x += direction) {
+                steps.push_back(x);
+            }
+        };
+
+        for (int32_t trip = 0; trip < HOME_TRIPS; ++trip) {
+            walk(0, HOME_LENGTH);
+            walk(HOME_LENGTH, 0);
+        }
+        walk(0, -EXCURSION_LENGTH);
+        if (!teleportHome) {
+            walk(-EXCURSION_LENGTH, 0);
+        }
+        for (int32_t trip = 0; trip < HOME_TRIPS; ++trip) {
+            walk(0, HOME_LENGTH);
+            walk(HOME_LENGTH, 0);
+        }
+        steps.push_back(0);
+        return steps;
+    }
+
+    struct WalkResult {
+        uint64_t loads = 0;
+        uint64_t hits = 0;
+        uint64_t diskReads = 0;
+        uint64_t regenerated = 0;
+        uint64_t evictions = 0;
+        uint64_t writes = 0;
+        uint64_t lostEdits = 0;
+        size_t peakBytes = 0;
+        double seconds = 0.0;
+    };
+
+    // The two cache shapes behind one interface
+    struct CacheAdapter {
+        virtual ~CacheAdapter() = default;
+        // Dirty frames that must be written are appended to toWrite
+        virtual void Put(const ChunkCoord& coord, std::vector<uint8_t> frame, bool dirty,
+                         std::vector<DirtyChunkFrame>& toWrite) = 0;
+        virtual bool Take(const ChunkCoord& coord, std::vector<uint8_t>& frame, bool& dirty) = 0;
+        virtual uint64_t Evictions() const = 0;
+        virtual size_t Bytes() const = 0;
+    };
+
+    // Before: entry-count cap, arbitrary victims, modified chunks written at unload
+    struct UnorderedCache : CacheAdapter {
+        explicit UnorderedCache(size_t maxEntries) : capacity(maxEntries) {}
+
+        void Put(const ChunkCoord& coord, std::vector<uint8_t> frame, bool dirty,
+                 std::vector<DirtyChunkFrame>& toWrite) override {
+            if (dirty) {
+                toWrite.push_back({ coord, frame });
+            }
+            bytes += frame.size();
+            auto& slot = entries[coord];
+            bytes -= slot.size();
+            slot = std::move(frame);
+            while (entries.size() > capacity) {
+                bytes -= entries.begin()->second.size();
+                entries.erase(entries.begin());
+                ++evictions;
+            }
+        }
+
+        bool Take(const ChunkCoord& coord, std::vector<uint8_t>& frame, bool& dirty) override {
+            auto it = entries.find(coord);
+            if (it == entries.end()) {
+                return false;
+            }
+            frame = std::move(it->second);
+            bytes -= frame.size();
+            entries.erase(it);
+            dirty = false;
+            return true;
+        }
+
+        uint64_t Evictions() const override { return evictions; }
+        size_t Bytes() const override { return bytes; }
+
+        size_t capacity;
+        size_t bytes = 0;
+        uint64_t evictions = 0;
+        std::unordered_map<ChunkCoord, std::vector<uint8_t>> entries;
+    };
+
+    struct BudgetedCache : CacheAdapter {
+        BudgetedCache(size_t budget, ChunkCachePolicy policy) : cache(budget, policy) {}
+
+        void Put(const ChunkCoord& coord, std::vector<uint8_t> frame, bool dirty,
+                 std::vector<DirtyChunkFrame>& toWrite) override {
+            cache.Put(coord, std::move(frame), dirty, toWrite);
+        }
+
+        bool Take(const ChunkCoord& coord, std::vector<uint8_t>& frame, bool& dirty) override {
+            return cache.Take(coord, frame, dirty);
+        }
+
+        uint64_t Evictions() const override { return cache.GetStats().evictions; }
+        size_t Bytes() const override { return cache.GetStats().bytes; }
+
+        CompressedChunkCache cache;
+    };
+
+    struct LiveChunk {
+        std::shared_ptr<Chunk> chunk;
+        bool dirty = false;
+    };
+
+    WalkResult Walk(CacheAdapter& cache, const std::vector<int32_t>& script) {
+        WalkResult result;
+        std::unordered_map<ChunkCoord, LiveChunk> live;
+        std::unordered_map<ChunkCoord, std::vector<uint8_t>> disk;
+        std::unordered_set<ChunkCoord> edited;
+        std::vector<DirtyChunkFrame> toWrite;
+
+        auto write = [&]() {
+            for (auto& frame : toWrite) {
+                disk[frame.coord] = std::move(frame.data);
+                ++result.writes;
+            }
+            toWrite.clear();
+        };
+
+        auto load = [&](const ChunkCoord& coord) {
+            ++result.loads;
+            LiveChunk entry;
+            std::vector<uint8_t> frame;
+            size_t rawSize = 0;
+
+            if (cache.Take(coord, frame, entry.dirty)) {
+                ++result.hits;
+                entry.chunk = std::make_shared<Chunk>(coord);
+                const uint8_t* raw = ChunkCompression::Decode(frame.data(), frame.size(), rawSize);
+                entry.chunk->Deserialize(raw, rawSize);
+            } else if (auto it = disk.find(coord); it != disk.end()) {
+                ++result.diskReads;
+                entry.chunk = std::make_shared<Chunk>(coord);
+                const uint8_t* raw = ChunkCompression::Decode(it->second.data(), it->second.size(), rawSize);
+                entry.chunk->Deserialize(raw, rawSize);
+            } else {
+                ++result.regenerated;
+                entry.chunk = GenerateTerrain(coord);
+            }
+
+            if (edited.count(coord) && entry.chunk->GetBlockId(0, EDIT_Y, 0) != static_cast<uint16_t>(BlockType::GLASS)) {
+                ++result.lostEdits;
+            }
+            if (IsEdited(coord) && edited.insert(coord).second) {
+                entry.chunk->SetBlockId(0, EDIT_Y, 0, static_cast<uint16_t>(BlockType::GLASS));
+                entry.dirty = true;
+            }
+            live.emplace(coord, std::move(entry));
+        };
+
+        auto unload = [&](const ChunkCoord& coord) {
+            auto it = live.find(coord);
+            const auto raw = it->second.chunk->Serialize();
+            std::vector<uint8_t> frame;
+            ChunkCompression::Encode(ChunkCodecType::LZ4, 0, raw.data(), raw.size(), frame);
+            cache.Put(coord, std::move(frame), it->second.dirty, toWrite);
+            write();
+            live.erase(it);
+        };
+
+        auto inView = [](const ChunkCoord& coord, int32_t playerX) {
+            return std::abs(coord.x - playerX) <= VIEW_RADIUS && std::abs(coord.z) <= VIEW_RADIUS;
+        };
+
+        result.seconds = MeasureSeconds([&]() {
+            std::vector<ChunkCoord> leaving;
+            for (const int32_t playerX : script) {
+                leaving.clear();
+                for (const auto& pair : live) {
+                    if (!inView(pair.first, playerX)) {
+                        leaving.push_back(pair.first);
+                    }
+                }
+                for (const auto& coord : leaving) {
+                    unload(coord);
+                }
+
+                for (int32_t x = playerX - VIEW_RADIUS; x <= playerX + VIEW_RADIUS; ++x) {
+                    for (int32_t z = -VIEW_RADIUS; z <= VIEW_RADIUS; ++z) {
+                        if (!live.count(ChunkCoord(x, z))) {
+                            load(ChunkCoord(x, z));
+                        }
+                    }
+                }
+                result.peakBytes = std::max(result.peakBytes, cache.Bytes());
+            }
+        });
+
+        result.evictions = cache.Evictions();
+        return result;
+    }
+
+    void Report(const std::string& title, const WalkResult& result) {
+        PrintHeader(title);
+        PrintRow("chunk loads", static_cast<double>(result.loads), "");
+        PrintRow("cache hit rate", 100.0 * static_cast<double>(result.hits) / static_cast<double>(result.loads), "%");
+        PrintRow("regenerated", static_cast<double>(result.regenerated), "chunks");
+        PrintRow("read back from disk", static_cast<double>(result.diskReads), "chunks");
+        PrintRow("evictions", static_cast<double>(result.evictions), "");
+        PrintRow("disk writes", static_cast<double>(result.writes), "");
+        PrintRow("peak cache size", static_cast<double>(result.peakBytes) / (1024.0 * 1024.0), "MiB");
+        PrintRow("walk time", result.seconds * 1e3, "ms");
+        if (result.lostEdits > 0) {
+            std::printf("  ERROR: %llu edits lost\n", static_cast<unsigned long long>(result.lostEdits));
+        }
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const double budgetMiB = argc > 1 ? std::atof(argv[1]) : 2.0;
+    const size_t budget = static_cast<size_t>(budgetMiB * 1024 * 1024);
+
+    // Size the old entry cap from the average frame so both get the same memory
+    size_t sampleBytes = 0;
+    for (int32_t x = 0; x < 16; ++x) {
+        const auto raw = GenerateTerrain(ChunkCoord(x * 7, x * 3))->Serialize();
+        std::vector<uint8_t> frame;
+        ChunkCompression::Encode(ChunkCodecType::LZ4, 0, raw.data(), raw.size(), frame);
+        sampleBytes += frame.size();
+    }
+    const size_t capacity = budget / (sampleBytes / 16);
+
+    std::printf("Chunk cache benchmark: %dx%d view, %.1f MiB budget (~%zu chunks)\n",
+        2 * VIEW_RADIUS + 1, 2 * VIEW_RADIUS + 1, budgetMiB, capacity);
+    std::printf("Script: %d home trips over %d chunks, one %d-chunk excursion, %d home trips\n",
+        HOME_TRIPS, HOME_LENGTH, EXCURSION_LENGTH, HOME_TRIPS);
+
+    for (const bool teleportHome : { false, true }) {
+        const auto script = WalkScript(teleportHome);
+        const std::string suffix = teleportHome ? " [teleport home]" : " [walk home]";
+
+        UnorderedCache unordered(capacity);
+        Report("unordered_map, entry cap (before)" + suffix, Walk(unordered, script));
+
+        BudgetedCache lru(budget, ChunkCachePolicy::LRU);
+        Report("CompressedChunkCache LRU" + suffix, Walk(lru, script));
+
+        BudgetedCache arc(budget, ChunkCachePolicy::ARC);
+        Report("CompressedChunkCache ARC" + suffix, Walk(arc, script));
+    }
+
+    return 0;
+}
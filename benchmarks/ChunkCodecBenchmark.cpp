@@ -0,0 +1,156 @@
+/**
+ * @file ChunkCodecBenchmark.cpp
+ * @brief Ratio and throughput of every chunk codec built into this binary
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * Serializes a 32x32-chunk terrain area and runs each available codec at
+ * its fast (hot tier) and high-ratio (cold tier) level over all of it.
+ * DEFLATE at its high-ratio level is what every save used to pay on the
+ * save thread. The last table is the process-wide ChunkCompression::GetStats()
+ * that ChunkSystemStats::codecs reports.
+ */
+
+#include "BenchmarkCommon.hpp"
+
+#include "blocks/Block.hpp"
+#include "world/Chunk.hpp"
+#include "world/ChunkCodec.hpp"
+
+#include <cmath>
+#include <memory>
+
+using namespace VoxelCraft;
+using namespace VoxelCraft::Benchmark;
+
+namespace {
+
+    constexpr int32_t WORLD_CHUNKS = 32;
+    constexpr int32_t SEA_LEVEL = 62;
+    constexpr int REPETITIONS = 3;
+
+    int32_t SurfaceHeight(int32_t x, int32_t z) {
+        double h = 64.0 +
+                   8.0 * std::sin(x * 0.045) * std::cos(z * 0.038) +
+                   4.0 * std::sin((x + z) * 0.11) +
+                   1.5 * std::cos(x * 0.31 - z * 0.27);
+        return static_cast<int32_t>(h);
+    }
+
+    std::shared_ptr<Chunk> GenerateTerrain(const ChunkCoord& coord) {
+        auto chunk = std::make_shared<Chunk>(coord);
+
+        for (int32_t z = 0; z < 16; ++z) {
+            for (int32_t x = 0; x < 16; ++x) {
+                const int32_t wx = coord.x * 16 + x;
+                const int32_t wz = coord.z * 16 + z;
+                const int32_t height = SurfaceHeight(wx, wz);
+
+                for (int32_t y = 0; y <= std::max(height, SEA_LEVEL); ++y) {
+                    BlockType type = BlockType::STONE;
+                    if (y == 0) {
+                        type = BlockType::BEDROCK;
+                    } else if (y > height) {
+                        type = BlockType::WATER;
+                    } else if (y == height) {
+                        type = height >= SEA_LEVEL ? BlockType::GRASS_BLOCK : BlockType::DIRT;
+                    } else if (y + 4 > height) {
+                        type = BlockType::DIRT;
+                    } else if ((wx * 7 + y * 13 + wz * 31) % 97 == 0) {
+                        type = BlockType::COAL_ORE;
+                    } else if ((wx * 11 + y * 5 + wz * 17) % 61 == 0) {
+                        type = BlockType::AIR; // Sparse caves keep sections non-uniform
+                    }
+                    chunk->SetBlockId(static_cast<uint8_t>(x), static_cast<uint8_t>(y), static_cast<uint8_t>(z),
+                        static_cast<uint16_t>(type));
+                }
+            }
+        }
+
+        return chunk;
+    }
+
+    void RunCodec(ChunkCodecType type, const char* tier, int level,
+                  const std::vector<std::vector<uint8_t>>& payloads, uint64_t rawBytes) {
+        std::vector<std::vector<uint8_t>> frames(payloads.size());
+        uint64_t frameBytes = 0;
+
+        const double compressSeconds = MeasureBestSeconds(REPETITIONS, [&]() {
+            frameBytes = 0;
+            for (size_t i = 0; i < payloads.size(); ++i) {
+                ChunkCompression::Encode(type, level, payloads[i].data(), payloads[i].size(), frames[i]);
+                frameBytes += frames[i].size();
+            }
+        });
+
+        bool intact = true;
+        const double decompressSeconds = MeasureBestSeconds(REPETITIONS, [&]() {
+            for (size_t i = 0; i < frames.size(); ++i) {
+                size_t rawSize = 0;
+                const uint8_t* raw = ChunkCompression::Decode(frames[i].data(), frames[i].size(), rawSize);
+                intact &= raw != nullptr && rawSize == payloads[i].size();
+                DoNotOptimize(raw);
+            }
+        });
+
+        const double mib = static_cast<double>(rawBytes) / (1024.0 * 1024.0);
+        const std::string label = std::string(ChunkCompression::GetName(type)) + " " + tier +
+            " (level " + std::to_string(level) + ")";
+
+        PrintHeader(label);
+        PrintRow("ratio", static_cast<double>(rawBytes) / static_cast<double>(frameBytes), "x");
+        PrintRow("average frame", static_cast<double>(frameBytes) / static_cast<double>(payloads.size()), "bytes");
+        PrintRow("compress", mib / compressSeconds, "MB/s");
+        PrintRow("compress per chunk", compressSeconds * 1e6 / static_cast<double>(payloads.size()), "us");
+        PrintRow("decompress", mib / decompressSeconds, "MB/s");
+        if (!intact) {
+            std::printf("  WARNING: round trip failed\n");
+        }
+    }
+
+} // namespace
+
+int main() {
+    std::printf("Chunk codec benchmark: %dx%d terrain chunks\n", WORLD_CHUNKS, WORLD_CHUNKS);
+
+    std::vector<std::vector<uint8_t>> payloads;
+    uint64_t rawBytes = 0;
+    for (int32_t z = 0; z < WORLD_CHUNKS; ++z) {
+        for (int32_t x = 0; x < WORLD_CHUNKS; ++x) {
+            payloads.push_back(GenerateTerrain(ChunkCoord(x, z))->Serialize());
+            rawBytes += payloads.back().size();
+        }
+    }
+    PrintRow("average serialized chunk", static_cast<double>(rawBytes) / static_cast<double>(payloads.size()), "bytes");
+
+    for (size_t i = 0; i < CHUNK_CODEC_COUNT; ++i) {
+        const auto type = static_cast<ChunkCodecType>(i);
+        const ChunkCodec* codec = ChunkCompression::GetCodec(type);
+        if (type == ChunkCodecType::NONE) {
+            continue;
+        }
+        if (!codec) {
+            std::printf("\n%s: not built into this binary\n", ChunkCompression::GetName(type));
+            continue;
+        }
+
+        RunCodec(type, "hot", codec->GetFastLevel(), payloads, rawBytes);
+        if (codec->GetHighRatioLevel() != codec->GetFastLevel()) {
+            RunCodec(type, "cold", codec->GetHighRatioLevel(), payloads, rawBytes);
+        }
+    }
+
+    PrintHeader("ChunkSystemStats::codecs (all runs)");
+    const auto stats = ChunkCompression::GetStats();
+    for (size_t i = 0; i < CHUNK_CODEC_COUNT; ++i) {
+        if (!stats[i].available || stats[i].compressions == 0) {
+            continue;
+        }
+        const std::string name = ChunkCompression::GetName(static_cast<ChunkCodecType>(i));
+        PrintRow(name + " ratio", stats[i].ratio, "x");
+        PrintRow(name + " compress", stats[i].compressMBps, "MB/s");
+        PrintRow(name + " decompress", stats[i].decompressMBps, "MB/s");
+    }
+
+    return 0;
+}
@@ -0,0 +1,254 @@
+/**
+ * @file ChunkPipelineBenchmark.cpp
+ * @brief Measures staged chunk pipeline throughput against worker count
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * Simulates fast flight: the focus moves one chunk per step along +x and
+ * every chunk within the load radius is requested READY, nearest first,
+ * without waiting for earlier steps. Each chunk goes through synthetic
+ * terrain, trees spilling into neighbors, a full BFS relight and greedy
+ * meshing. Reports READY chunks per second and scaling for 1..N workers.
+ */
+
+#include "BenchmarkCommon.hpp"
+
+#include "blocks/Block.hpp"
+#include "blocks/BlockMeshGenerator.hpp"
+#include "core/WorkStealingPool.hpp"
+#include "world/Chunk.hpp"
+#include "world/ChunkPipeline.hpp"
+#include "world/LightPropagator.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+using namespace VoxelCraft;
+using namespace VoxelCraft::Benchmark;
+
+namespace {
+
+    constexpr int32_t LOAD_RADIUS = 8;
+    constexpr int32_t FLIGHT_CHUNKS = 48;
+    constexpr int32_t SEA_LEVEL = 62;
+
+    int32_t SurfaceHeight(int32_t x, int32_t z) {
+        double h = 64.0 +
+                   8.0 * std::sin(x * 0.045) * std::cos(z * 0.038) +
+                   4.0 * std::sin((x + z) * 0.11) +
+                   1.5 * std::cos(x * 0.31 - z * 0.27);
+        return static_cast<int32_t>(h);
+    }
+
+    // Per-chunk deterministic hash so workers need no shared RNG
+    uint32_t Hash(int32_t x, int32_t z, uint32_t salt) {
+        uint32_t h = static_cast<uint32_t>(x) * 0x8da6b343u ^ static_cast<uint32_t>(z) * 0xd8163841u ^ salt * 0xcb1ab31fu;
+        h ^= h >> 13;
+        h *= 0x5bd1e995u;
+        return h ^ (h >> 15);
+    }
+
+    std::shared_ptr<Chunk> GenerateTerrain(const ChunkCoord& coord) {
+        auto chunk = std::make_shared<Chunk>(coord);
+
+        for (int32_t z = 0; z < 16; ++z) {
+            for (int32_t x = 0; x < 16; ++x) {
+                const int32_t wx = coord.x * 16 + x;
+                const int32_t wz = coord.z * 16 + z;
+                const int32_t height = SurfaceHeight(wx, wz);
+
+                for (int32_t y = 0; y <= std::max(height, SEA_LEVEL); ++y) {
+                    BlockType type = BlockType::STONE;
+                    if (y == 0) {
+                        type = BlockType::BEDROCK;
+                    } else if (y > height) {
+                        type = BlockType::WATER;
+                    } else if (y == height) {
+                        type = height >= SEA_LEVEL ? BlockType::GRASS_BLOCK : BlockType::DIRT;
+                    } else if (y + 4 > height) {
+                        type = BlockType::DIRT;
+                    } else if (Hash(wx, wz, static_cast<uint32_t>(y)) % 90 == 0) {
+                        type = BlockType::COAL_ORE;
+                    }
+                    chunk->SetBlockId(static_cast<uint8_t>(x), static_cast<uint8_t>(y), static_cast<uint8_t>(z),
+                        static_cast<uint16_t>(type));
+                }
+            }
+        }
+
+        return chunk;
+    }
+
+    // Write through the neighborhood so leaves cross chunk borders
+    void SetInArea(const ChunkNeighborhood& area, int32_t x, int32_t y, int32_t z, BlockType type) {
+        const int dx = x < 0 ? -1 : (x >= 16 ? 1 : 0);
+        const int dz = z < 0 ? -1 : (z >= 16 ? 1 : 0);
+        Chunk* chunk = area.Get(dx, dz).get();
+        const uint8_t lx = static_cast<uint8_t>(x - dx * 16);
+        const uint8_t lz = static_cast<uint8_t>(z - dz * 16);
+        if (chunk->GetBlockId(lx, static_cast<uint8_t>(y), lz) == static_cast<uint16_t>(BlockType::AIR)) {
+            chunk->SetBlockId(lx, static_cast<uint8_t>(y), lz, static_cast<uint16_t>(type));
+        }
+    }
+
+    void DecorateTrees(const ChunkNeighborhood& area) {
+        const ChunkCoord coord = area.Center()->GetCoord();
+
+        for (uint32_t tree = 0; tree < 3; ++tree) {
+            const int32_t x = static_cast<int32_t>(Hash(coord.x, coord.z, 100 + tree) % 16);
+            const int32_t z = static_cast<int32_t>(Hash(coord.x, coord.z, 200 + tree) % 16);
+            const int32_t base = SurfaceHeight(coord.x * 16 + x, coord.z * 16 + z) + 1;
+            if (base <= SEA_LEVEL) {
+                continue;
+            }
+
+            for (int32_t dy = 3; dy <= 5; ++dy) {
+                for (int32_t dz = -2; dz <= 2; ++dz) {
+                    for (int32_t dx = -2; dx <= 2; ++dx) {
+                        if (std::abs(dx) + std::abs(dz) <= (dy == 5 ? 1 : 3)) {
+                            SetInArea(area, x + dx, base + dy, z + dz, BlockType::OAK_LEAVES);
+                        }
+                    }
+                }
+            }
+            for (int32_t dy = 0; dy < 5; ++dy) {
+                area.Center()->SetBlockId(static_cast<uint8_t>(x), static_cast<uint8_t>(base + dy),
+                    static_cast<uint8_t>(z), static_cast<uint16_t>(BlockType::OAK_LOG));
+            }
+        }
+    }
+
+    ChunkPriority PriorityFor(const ChunkCoord& focus, const ChunkCoord& coord) {
+        const float distance = focus.distance(coord);
+        if (distance <= 1.0f) return ChunkPriority::CRITICAL;
+        if (distance <= 2.0f) return ChunkPriority::HIGH;
+        return ChunkPriority::MEDIUM;
+    }
+
+    struct FlightResult {
+        double seconds = 0.0;
+        uint64_t readyChunks = 0;
+        uint64_t vertices = 0;
+        uint64_t stolen = 0;
+        std::array<ChunkStageStats, CHUNK_STAGE_COUNT> stages{};
+    };
+
+    FlightResult Fly(size_t threads, const BlockMeshGenerator& generator) {
+        WorkStealingPool pool(threads);
+        pool.Initialize();
+
+        ChunkPipeline* pipelinePtr = nullptr;
+        LightPropagator propagator([&pipelinePtr](const ChunkCoord& coord) {
+            return pipelinePtr->GetChunk(coord);
+        });
+        std::atomic<uint64_t> vertices{ 0 };
+
+        ChunkStageHandlers handlers;
+        handlers.generate = [](const ChunkCoord& coord, ChunkStage& reached) {
+            reached = ChunkStage::GENERATE;
+            return GenerateTerrain(coord);
+        };
+        handlers.decorate = DecorateTrees;
+        handlers.light = [&propagator](const ChunkNeighborhood& area) {
+            propagator.RelightChunk(area.Center().get());
+        };
+        handlers.mesh = [&generator, &vertices](const ChunkNeighborhood& area) {
+            thread_local PackedChunkMesh mesh;
+            ChunkMeshNeighbors neighbors;
+            for (size_t i = 0; i < neighbors.chunks.size(); ++i) {
+                neighbors.chunks[i] = area.chunks[i].get();
+            }
+            generator.GenerateChunkMesh(area.Center().get(), MeshingMode::GREEDY, neighbors, mesh);
+            vertices.fetch_add(mesh.GetVertexCount(), std::memory_order_relaxed);
+        };
+
+        FlightResult result;
+        {
+            ChunkPipeline pipeline(std::move(handlers), &pool);
+            pipelinePtr = &pipeline;
+
+            result.seconds = MeasureSeconds([&]() {
+                for (int32_t step = 0; step <= FLIGHT_CHUNKS; ++step) {
+                    const ChunkCoord focus(step, 0);
+
+                    std::vector<ChunkCoord> coords;
+                    for (int32_t z = -LOAD_RADIUS; z <= LOAD_RADIUS; ++z) {
+                        for (int32_t x = -LOAD_RADIUS; x <= LOAD_RADIUS; ++x) {
+                            coords.push_back(ChunkCoord(focus.x + x, focus.z + z));
+                        }
+                    }
+                    std::sort(coords.begin(), coords.end(), [&focus](const ChunkCoord& a, const ChunkCoord& b) {
+                        return focus.distance(a) < focus.distance(b);
+                    });
+
+                    for (const auto& coord : coords) {
+                        pipeline.Request(coord, ChunkStage::READY, PriorityFor(focus, coord));
+                    }
+                }
+                pipeline.WaitIdle();
+            });
+
+            result.stages = pipeline.GetStageStats();
+            result.readyChunks = result.stages[static_cast<size_t>(ChunkStage::READY)].completed;
+            pipeline.Shutdown();
+        }
+
+        result.vertices = vertices.load();
+        result.stolen = pool.GetStats().tasksStolen;
+        pool.Shutdown();
+        return result;
+    }
+
+    const char* StageName(size_t stage) {
+        static const char* names[] = { "none", "generate", "decorate", "light", "mesh", "ready" };
+        return names[stage];
+    }
+
+} // namespace
+
+int main() {
+    const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("Chunk pipeline benchmark: radius %d, %d-chunk flight, %zu hardware threads\n",
+        LOAD_RADIUS, FLIGHT_CHUNKS, cores);
+
+    BlockMeshGenerator generator;
+    generator.Initialize();
+
+    std::vector<size_t> threadCounts;
+    for (size_t t = 1; t < cores; t *= 2) {
+        threadCounts.push_back(t);
+    }
+    threadCounts.push_back(cores);
+
+    double baseline = 0.0;
+    FlightResult last;
+    for (size_t threads : threadCounts) {
+        FlightResult result = Fly(threads, generator);
+        const double chunksPerSecond = static_cast<double>(result.readyChunks) / result.seconds;
+        if (baseline == 0.0) {
+            baseline = chunksPerSecond;
+        }
+
+        PrintHeader(std::to_string(threads) + " worker(s)");
+        PrintRow("ready chunks", static_cast<double>(result.readyChunks), "");
+        PrintRow("wall time", result.seconds * 1e3, "ms");
+        PrintRow("throughput", chunksPerSecond, "chunks/s");
+        PrintRow("speedup vs 1 worker", chunksPerSecond / baseline, "x");
+        PrintRow("parallel efficiency", 100.0 * chunksPerSecond / baseline / static_cast<double>(threads), "%");
+        PrintRow("tasks stolen", static_cast<double>(result.stolen), "");
+        last = result;
+    }
+
+    PrintHeader("stage cost (last run)");
+    for (size_t stage = static_cast<size_t>(ChunkStage::GENERATE); stage < static_cast<size_t>(ChunkStage::READY); ++stage) {
+        PrintRow(std::string(StageName(stage)) + " avg", last.stages[stage].averageTime, "ms");
+        PrintRow(std::string(StageName(stage)) + " completed", static_cast<double>(last.stages[stage].completed), "");
+    }
+    PrintRow("vertices per ready chunk",
+        static_cast<double>(last.vertices) / static_cast<double>(std::max<uint64_t>(last.readyChunks, 1)), "");
+
+    return 0;
+}
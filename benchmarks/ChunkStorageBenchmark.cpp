@@ -0,0 +1,211 @@
+/**
+ * @file ChunkStorageBenchmark.cpp
+ * @brief Compares palette-compressed section storage against the legacy
+ *        std::array + mutex chunk layout
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * Workloads: random get, random set and full-volume sweep over one
+ * 16x256x16 chunk filled with terrain-like data.
+ */
+
+#include "BenchmarkCommon.hpp"
+
+#include "blocks/Block.hpp"
+#include "world/ChunkSection.hpp"
+
+#include <array>
+#include <mutex>
+#include <random>
+
+using namespace VoxelCraft;
+using namespace VoxelCraft::Benchmark;
+
+namespace {
+
+    constexpr uint32_t CHUNK_SIZE = 16;
+    constexpr uint32_t CHUNK_HEIGHT = 256;
+    constexpr uint32_t CHUNK_VOLUME = CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE;
+    constexpr size_t RANDOM_OPS = 4'000'000;
+    constexpr int SWEEPS = 64;
+
+    /**
+     * @brief The layout Chunk used before section storage: flat array,
+     *        one mutex taken on every access, solidity via Block::CreateBlock
+     */
+    class LegacyChunkStorage {
+    public:
+        LegacyChunkStorage() { m_blocks.fill(0); }
+
+        uint16_t Get(uint8_t x, uint8_t y, uint8_t z) const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_blocks[Index(x, y, z)];
+        }
+
+        void Set(uint8_t x, uint8_t y, uint8_t z, uint16_t id) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            size_t index = Index(x, y, z);
+            uint16_t oldId = m_blocks[index];
+
+            bool wasSolid = Block::CreateBlock(static_cast<BlockType>(oldId))->IsSolid();
+            bool isSolid = Block::CreateBlock(static_cast<BlockType>(id))->IsSolid();
+            if (wasSolid && !isSolid) {
+                m_solidBlockCount--;
+            } else if (!wasSolid && isSolid) {
+                m_solidBlockCount++;
+            }
+
+            m_blocks[index] = id;
+        }
+
+        size_t GetMemoryUsage() const { return sizeof(*this); }
+
+    private:
+        static size_t Index(uint8_t x, uint8_t y, uint8_t z) {
+            return static_cast<size_t>(x) + static_cast<size_t>(z) * CHUNK_SIZE +
+                   static_cast<size_t>(y) * CHUNK_SIZE * CHUNK_SIZE;
+        }
+
+        std::array<uint16_t, CHUNK_VOLUME> m_blocks;
+        mutable std::mutex m_mutex;
+        uint32_t m_solidBlockCount = 0;
+    };
+
+    struct Op {
+        uint8_t x, y, z;
+        uint16_t id;
+    };
+
+    uint16_t TerrainBlockAt(uint32_t x, uint32_t y, uint32_t z, std::mt19937& rng) {
+        uint32_t height = 60 + ((x * 7 + z * 13) % 9);
+        if (y > height) {
+            return y < 62 ? static_cast<uint16_t>(BlockType::WATER) : static_cast<uint16_t>(BlockType::AIR);
+        }
+        if (y == height) {
+            return static_cast<uint16_t>(BlockType::GRASS_BLOCK);
+        }
+        if (y + 3 > height) {
+            return static_cast<uint16_t>(BlockType::DIRT);
+        }
+        if (y == 0) {
+            return static_cast<uint16_t>(BlockType::BEDROCK);
+        }
+        if (rng() % 100 == 0) {
+            return static_cast<uint16_t>(BlockType::COAL_ORE);
+        }
+        return static_cast<uint16_t>(BlockType::STONE);
+    }
+
+    template<typename Storage>
+    void FillTerrain(Storage& storage) {
+        std::mt19937 rng(1337);
+        for (uint32_t y = 0; y < CHUNK_HEIGHT; ++y) {
+            for (uint32_t z = 0; z < CHUNK_SIZE; ++z) {
+                for (uint32_t x = 0; x < CHUNK_SIZE; ++x) {
+                    storage.Set(static_cast<uint8_t>(x), static_cast<uint8_t>(y), static_cast<uint8_t>(z),
+                        TerrainBlockAt(x, y, z, rng));
+                }
+            }
+        }
+    }
+
+    std::vector<Op> MakeOps(uint32_t seed) {
+        const uint16_t palette[] = {
+            static_cast<uint16_t>(BlockType::AIR),
+            static_cast<uint16_t>(BlockType::STONE),
+            static_cast<uint16_t>(BlockType::DIRT),
+            static_cast<uint16_t>(BlockType::COBBLESTONE),
+            static_cast<uint16_t>(BlockType::WOOD_PLANKS),
+            static_cast<uint16_t>(BlockType::GLASS),
+        };
+
+        std::mt19937 rng(seed);
+        std::vector<Op> ops(RANDOM_OPS);
+        for (auto& op : ops) {
+            op.x = static_cast<uint8_t>(rng() % CHUNK_SIZE);
+            op.y = static_cast<uint8_t>(rng() % CHUNK_HEIGHT);
+            op.z = static_cast<uint8_t>(rng() % CHUNK_SIZE);
+            op.id = palette[rng() % (sizeof(palette) / sizeof(palette[0]))];
+        }
+        return ops;
+    }
+
+    template<typename Storage>
+    void RunWorkloads(const char* name, Storage& storage, const std::vector<Op>& ops) {
+        PrintHeader(name);
+
+        FillTerrain(storage);
+        PrintRow("memory after terrain fill", static_cast<double>(storage.GetMemoryUsage()) / 1024.0, "KiB");
+
+        double getSeconds = MeasureBestSeconds(3, [&]() {
+            uint32_t sum = 0;
+            for (const auto& op : ops) {
+                sum += storage.Get(op.x, op.y, op.z);
+            }
+            DoNotOptimize(sum);
+        });
+        PrintRow("random get", static_cast<double>(ops.size()) / getSeconds / 1e6, "Mops/s");
+
+        double sweepSeconds = MeasureBestSeconds(3, [&]() {
+            uint32_t sum = 0;
+            for (int sweep = 0; sweep < SWEEPS; ++sweep) {
+                for (uint32_t y = 0; y < CHUNK_HEIGHT; ++y) {
+                    for (uint32_t z = 0; z < CHUNK_SIZE; ++z) {
+                        for (uint32_t x = 0; x < CHUNK_SIZE; ++x) {
+                            sum += storage.Get(static_cast<uint8_t>(x), static_cast<uint8_t>(y), static_cast<uint8_t>(z));
+                        }
+                    }
+                }
+            }
+            DoNotOptimize(sum);
+        });
+        PrintRow("full-volume sweep (Get)",
+            static_cast<double>(CHUNK_VOLUME) * SWEEPS / sweepSeconds / 1e6, "Mblocks/s");
+
+        double setSeconds = MeasureSeconds([&]() {
+            for (const auto& op : ops) {
+                storage.Set(op.x, op.y, op.z, op.id);
+            }
+        });
+        PrintRow("random set", static_cast<double>(ops.size()) / setSeconds / 1e6, "Mops/s");
+        PrintRow("memory after random sets", static_cast<double>(storage.GetMemoryUsage()) / 1024.0, "KiB");
+    }
+
+} // namespace
+
+int main() {
+    std::printf("Chunk storage benchmark: %zu random ops, %d sweeps of %u blocks\n",
+        RANDOM_OPS, SWEEPS, CHUNK_VOLUME);
+
+    const auto ops = MakeOps(42);
+
+    auto legacy = std::make_unique<LegacyChunkStorage>();
+    RunWorkloads("legacy std::array + mutex", *legacy, ops);
+
+    auto sections = std::make_unique<ChunkBlockStorage>();
+    RunWorkloads("palette sections (lock-free reads)", *sections, ops);
+
+    // Section storage also offers a bulk decode path used by meshing
+    auto compacted = std::make_unique<ChunkBlockStorage>();
+    FillTerrain(*compacted);
+    compacted->Compact();
+
+    PrintHeader("palette sections, compacted terrain");
+    PrintRow("memory", static_cast<double>(compacted->GetMemoryUsage()) / 1024.0, "KiB");
+
+    std::vector<uint16_t> decoded(ChunkSection::SECTION_VOLUME);
+    double unpackSeconds = MeasureBestSeconds(3, [&]() {
+        uint32_t sum = 0;
+        for (int sweep = 0; sweep < SWEEPS; ++sweep) {
+            for (uint32_t s = 0; s < ChunkBlockStorage::SECTION_COUNT; ++s) {
+                compacted->GetSection(s).Unpack(decoded.data());
+                sum += decoded[static_cast<size_t>(sweep) % decoded.size()];
+            }
+        }
+        DoNotOptimize(sum);
+    });
+    PrintRow("full-volume sweep (Unpack)",
+        static_cast<double>(CHUNK_VOLUME) * SWEEPS / unpackSeconds / 1e6, "Mblocks/s");
+
+    return 0;
+}
@@ -0,0 +1,674 @@
+/**
+ * @file CullingBenchmark.cpp
+ * @brief Section frustum and cave culling along a recorded camera path
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * Builds a synthetic world of rolling hills over solid stone with a
+ * tunnel network at y ~40 (tubes every 48 blocks along X and Z), a shaft
+ * from the surface down into it at the origin, and sealed chambers in the
+ * bottom section between the tunnels. Each section's connectivity is
+ * computed with SectionCulling::ComputeConnectivity, as the MESH stage
+ * does, and handed to a SectionOcclusionCuller.
+ *
+ * The camera replays a path, by default a built-in recording at 60 fps:
+ * a walk over the surface looking around, down the shaft, along a tunnel
+ * and a flight over the terrain looking down. Each frame is culled three
+ * ways:
+ *
+ *   distance   every section within the render distance (what
+ *              ChunkSystem::Render drew before)
+ *   frustum    sections whose box touches the view frustum
+ *   occlusion  frustum, then the cave visibility walk from the camera
+ *
+ * Reported: sections drawn per frame for each mode and path phase, CPU
+ * per frame of each Cull (grid rebuilds included), connectivity cost per
+ * section at mesh time, and the frustum test alone, scalar vs. SSE2.
+ *
+ * Checks: the SSE2 frustum test equals the scalar one and
+ * ViewFrustum::TestBox on every frame; FromMatrix on the camera's
+ * OpenGL view-projection agrees with FromCamera; occlusion only drops sections;
+ * no section the camera sees along sampled rays through open blocks is
+ * culled; and seen from the surface or the sky no sealed chamber is
+ * drawn with occlusion culling, although the frustum keeps some. Any
+ * failure prints FAILED and exits with 1.
+ *
+ * Usage: CullingBenchmark [render distance] [path file]
+ *
+ * A path file holds one frame per line: "x y z yaw pitch" (degrees; yaw 0
+ * looks along +Z, 90 along +X). Lines starting with # are skipped.
+ */
+
+#include "BenchmarkCommon.hpp"
+
+#include "world/SectionCulling.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+
+using namespace VoxelCraft;
+using namespace VoxelCraft::Benchmark;
+
+namespace {
+
+    constexpr float PI = 3.14159265f;
+    constexpr int SECTIONS = SectionCulling::SECTIONS_PER_CHUNK;
+    constexpr int ROWS_PER_SECTION = 16 * 16;
+    constexpr int TUNNEL_SPACING = 48;
+    constexpr float TUNNEL_RADIUS = 3.0f;
+    constexpr float SHAFT_RADIUS = 2.0f;
+    constexpr float CHAMBER_RADIUS = 5.0f;
+    constexpr int CHAMBER_Y = 8;
+    constexpr float FOV_Y = 70.0f * PI / 180.0f;
+    constexpr float ASPECT = 16.0f / 9.0f;
+    constexpr float EYE_HEIGHT = 1.7f;
+
+    bool g_failed = false;
+
+    void Check(bool condition, const char* what) {
+        if (!condition) {
+            std::printf("  FAILED: %s\n", what);
+            g_failed = true;
+        }
+    }
+
+    int FloorDiv(int value, int divisor) {
+        return value >= 0 ? value / divisor : -((-value + divisor - 1) / divisor);
+    }
+
+    float SurfaceHeight(float x, float z) {
+        return 64.0f + 10.0f * std::sin(x * 0.045f) * std::cos(z * 0.06f) + 4.0f * std::sin((x + z) * 0.11f);
+    }
+
+    float TunnelCenterY(float along) {
+        return 40.0f + 4.0f * std::sin(along * 0.03f);
+    }
+
+    /**
+     * @brief Distance from a coordinate to the nearest multiple of spacing (offset shifts the grid)
+     */
+    float GridDistance(float value, float spacing, float offset) {
+        const float shifted = value - offset;
+        return shifted - std::round(shifted / spacing) * spacing;
+    }
+
+    /**
+     * @brief Opaque bits of every section, one 256-row block per section
+     */
+    struct SyntheticWorld {
+        int extent = 0;                           ///< Chunks span [-extent, extent] on X and Z
+        std::vector<uint16_t> rows;
+
+        int Width() const { return 2 * extent + 1; }
+
+        bool Contains(int chunkX, int chunkZ) const {
+            return std::abs(chunkX) <= extent && std::abs(chunkZ) <= extent;
+        }
+
+        size_t SectionOffset(int chunkX, int chunkZ, int section) const {
+            const size_t column = static_cast<size_t>((chunkZ + extent) * Width() + (chunkX + extent));
+            return (column * SECTIONS + static_cast<size_t>(section)) * ROWS_PER_SECTION;
+        }
+
+        const uint16_t* Section(int chunkX, int chunkZ, int section) const {
+            return &rows[SectionOffset(chunkX, chunkZ, section)];
+        }
+
+        bool IsOpaque(int x, int y, int z) const {
+            if (y < 0 || y >= 256) {
+                return false;
+            }
+            const int chunkX = FloorDiv(x, 16);
+            const int chunkZ = FloorDiv(z, 16);
+            if (!Contains(chunkX, chunkZ)) {
+                return false;
+            }
+            const uint16_t row = Section(chunkX, chunkZ, y >> 4)[(y & 15) * 16 + (z - chunkZ * 16)];
+            return (row >> (x - chunkX * 16)) & 1;
+        }
+    };
+
+    void ClearColumnRange(bool* column, float from, float to) {
+        const int y0 = std::max(0, static_cast<int>(std::ceil(from)));
+        const int y1 = std::min(255, static_cast<int>(std::floor(to)));
+        for (int y = y0; y <= y1; ++y) {
+            column[y] = false;
+        }
+    }
+
+    SyntheticWorld BuildWorld(int extent) {
+        SyntheticWorld world;
+        world.extent = extent;
+        world.rows.assign(static_cast<size_t>(world.Width() * world.Width()) * SECTIONS * ROWS_PER_SECTION, 0);
+
+        bool column[256];
+        for (int chunkZ = -extent; chunkZ <= extent; ++chunkZ) {
+            for (int chunkX = -extent; chunkX <= extent; ++chunkX) {
+                for (int lz = 0; lz < 16; ++lz) {
+                    for (int lx = 0; lx < 16; ++lx) {
+                        // Block centers
+                        const float x = static_cast<float>(chunkX * 16 + lx) + 0.5f;
+                        const float z = static_cast<float>(chunkZ * 16 + lz) + 0.5f;
+                        const float surface = SurfaceHeight(x, z);
+                        for (int y = 0; y < 256; ++y) {
+                            column[y] = static_cast<float>(y) + 0.5f < surface;
+                        }
+
+                        // Tubes along X (at z = k * 48) and along Z (at x = k * 48)
+                        const float dz = GridDistance(z, TUNNEL_SPACING, 0.0f);
+                        if (std::abs(dz) <= TUNNEL_RADIUS) {
+                            const float half = std::sqrt(TUNNEL_RADIUS * TUNNEL_RADIUS - dz * dz);
+                            ClearColumnRange(column, TunnelCenterY(x) - half - 0.5f, TunnelCenterY(x) + half - 0.5f);
+                        }
+                        const float dx = GridDistance(x, TUNNEL_SPACING, 0.0f);
+                        if (std::abs(dx) <= TUNNEL_RADIUS) {
+                            const float half = std::sqrt(TUNNEL_RADIUS * TUNNEL_RADIUS - dx * dx);
+                            ClearColumnRange(column, TunnelCenterY(z) - half - 0.5f, TunnelCenterY(z) + half - 0.5f);
+                        }
+
+                        // Shaft from the surface into the tunnels at the origin
+                        if (x * x + z * z <= SHAFT_RADIUS * SHAFT_RADIUS) {
+                            ClearColumnRange(column, TunnelCenterY(0.0f), surface + 1.0f);
+                        }
+
+                        // Sealed chambers inside section 0, centered between the tunnels
+                        const float cx = GridDistance(x, TUNNEL_SPACING, TUNNEL_SPACING / 2.0f);
+                        const float cz = GridDistance(z, TUNNEL_SPACING, TUNNEL_SPACING / 2.0f);
+                        const float flat = cx * cx + cz * cz;
+                        if (flat <= CHAMBER_RADIUS * CHAMBER_RADIUS) {
+                            const float half = std::sqrt(CHAMBER_RADIUS * CHAMBER_RADIUS - flat);
+                            ClearColumnRange(column, CHAMBER_Y - half, CHAMBER_Y + half);
+                        }
+
+                        for (int y = 0; y < 256; ++y) {
+                            if (column[y]) {
+                                const size_t offset = world.SectionOffset(chunkX, chunkZ, y >> 4);
+                                world.rows[offset + static_cast<size_t>((y & 15) * 16 + lz)] |= static_cast<uint16_t>(1u << lx);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        return world;
+    }
+
+    bool IsChamberSection(int chunkX, int chunkZ, int section) {
+        // Chambers sit at x, z = 24 + 48k: the middle of chunks 1 + 3k
+        return section == 0 && FloorDiv(chunkX - 1, 3) * 3 == chunkX - 1 && FloorDiv(chunkZ - 1, 3) * 3 == chunkZ - 1;
+    }
+
+    struct CameraFrame {
+        float x = 0.0f, y = 0.0f, z = 0.0f;
+        float yaw = 0.0f;                         ///< Degrees, 0 = +Z, 90 = +X
+        float pitch = 0.0f;                       ///< Degrees, positive looks up
+        int phase = 0;
+    };
+
+    const char* PHASE_NAMES[] = { "surface", "shaft", "tunnel", "sky", "file" };
+    constexpr int PHASE_COUNT = 5;
+
+    std::vector<CameraFrame> BuiltInPath() {
+        std::vector<CameraFrame> path;
+        auto add = [&](float x, float y, float z, float yaw, float pitch, int phase) {
+            CameraFrame frame;
+            frame.x = x; frame.y = y; frame.z = z;
+            frame.yaw = yaw; frame.pitch = pitch; frame.phase = phase;
+            path.push_back(frame);
+        };
+
+        // Walk north over the hills toward the shaft, looking around
+        for (int i = 0; i <= 720; ++i) {
+            const float t = static_cast<float>(i) / 720.0f;
+            const float z = -60.0f + 57.0f * t;
+            add(4.0f, SurfaceHeight(4.0f, z) + EYE_HEIGHT, z, 70.0f * std::sin(t * 6.0f * PI),
+                -10.0f + 20.0f * std::sin(t * 4.0f * PI), 0);
+        }
+
+        // Down the shaft, first looking down, then level
+        const float top = SurfaceHeight(0.0f, 0.0f) + EYE_HEIGHT;
+        for (int i = 0; i <= 240; ++i) {
+            const float t = static_cast<float>(i) / 240.0f;
+            add(0.0f, top + (TunnelCenterY(0.0f) - top) * t, 0.0f, 90.0f * t, -80.0f + 80.0f * t, 1);
+        }
+
+        // Along the tunnel, past the crossing at x = 48
+        for (int i = 0; i <= 900; ++i) {
+            const float t = static_cast<float>(i) / 900.0f;
+            const float x = 100.0f * t;
+            add(x, TunnelCenterY(x), 0.0f, 90.0f + 45.0f * std::sin(t * 8.0f * PI), 10.0f * std::sin(t * 5.0f * PI), 2);
+        }
+
+        // Fly back over the terrain looking down at it
+        for (int i = 0; i <= 600; ++i) {
+            const float t = static_cast<float>(i) / 600.0f;
+            add(100.0f - 160.0f * t, 140.0f, -60.0f * t, -120.0f + 60.0f * t, -45.0f, 3);
+        }
+        return path;
+    }
+
+    bool LoadPath(const std::string& file, std::vector<CameraFrame>& path) {
+        std::ifstream in(file);
+        if (!in) {
+            return false;
+        }
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            std::istringstream fields(line);
+            CameraFrame frame;
+            if (fields >> frame.x >> frame.y >> frame.z >> frame.yaw >> frame.pitch) {
+                frame.phase = PHASE_COUNT - 1;
+                path.push_back(frame);
+            }
+        }
+        return !path.empty();
+    }
+
+    struct FrameView {
+        float position[3];
+        float forward[3];
+        float right[3];
+        float up[3];
+        ViewFrustum frustum;
+    };
+
+    FrameView MakeView(const CameraFrame& frame) {
+        const float yaw = frame.yaw * PI / 180.0f;
+        const float pitch = std::max(-85.0f, std::min(85.0f, frame.pitch)) * PI / 180.0f;
+
+        FrameView view;
+        view.position[0] = frame.x; view.position[1] = frame.y; view.position[2] = frame.z;
+        view.forward[0] = std::cos(pitch) * std::sin(yaw);
+        view.forward[1] = std::sin(pitch);
+        view.forward[2] = std::cos(pitch) * std::cos(yaw);
+
+        // right = forward x worldUp, up = right x forward (as FromCamera builds them)
+        const float worldUp[3] = { 0.0f, 1.0f, 0.0f };
+        view.right[0] = -view.forward[2];
+        view.right[1] = 0.0f;
+        view.right[2] = view.forward[0];
+        const float length = std::sqrt(view.right[0] * view.right[0] + view.right[2] * view.right[2]);
+        view.right[0] /= length;
+        view.right[2] /= length;
+        view.up[0] = view.right[1] * view.forward[2] - view.right[2] * view.forward[1];
+        view.up[1] = view.right[2] * view.forward[0] - view.right[0] * view.forward[2];
+        view.up[2] = view.right[0] * view.forward[1] - view.right[1] * view.forward[0];
+
+        view.frustum = ViewFrustum::FromCamera(view.position, view.forward, worldUp, FOV_Y, ASPECT, 0.1f, 1000.0f);
+        return view;
+    }
+
+    /**
+     * @brief Column-major OpenGL projection * view of the same camera
+     */
+    void MakeViewProjection(const FrameView& view, float nearPlane, float farPlane, float out[16]) {
+        const float f = 1.0f / std::tan(FOV_Y * 0.5f);
+        const float* axes[3] = { view.right, view.up, view.forward };
+        float viewMatrix[4][4] = {};                // [row][column]
+        for (int row = 0; row < 3; ++row) {
+            const float sign = row == 2 ? -1.0f : 1.0f;     // The camera looks down -Z
+            float translation = 0.0f;
+            for (int column = 0; column < 3; ++column) {
+                viewMatrix[row][column] = sign * axes[row][column];
+                translation -= viewMatrix[row][column] * view.position[column];
+            }
+            viewMatrix[row][3] = translation;
+        }
+        viewMatrix[3][3] = 1.0f;
+
+        float projection[4][4] = {};
+        projection[0][0] = f / ASPECT;
+        projection[1][1] = f;
+        projection[2][2] = (farPlane + nearPlane) / (nearPlane - farPlane);
+        projection[2][3] = 2.0f * farPlane * nearPlane / (nearPlane - farPlane);
+        projection[3][2] = -1.0f;
+
+        for (int row = 0; row < 4; ++row) {
+            for (int column = 0; column < 4; ++column) {
+                float sum = 0.0f;
+                for (int k = 0; k < 4; ++k) {
+                    sum += projection[row][k] * viewMatrix[k][column];
+                }
+                out[column * 4 + row] = sum;
+            }
+        }
+    }
+
+    /**
+     * @brief Sections around the camera chunk, keyed like the culler's grid
+     */
+    struct SectionSet {
+        int centerX = 0, centerZ = 0, radius = 0;
+        std::vector<uint8_t> present;
+
+        void Reset(int cx, int cz, int r) {
+            centerX = cx; centerZ = cz; radius = r;
+            present.assign(static_cast<size_t>((2 * r + 1) * (2 * r + 1) * SECTIONS), 0);
+        }
+
+        bool InRange(int chunkX, int chunkZ) const {
+            return std::abs(chunkX - centerX) <= radius && std::abs(chunkZ - centerZ) <= radius;
+        }
+
+        size_t Index(int chunkX, int chunkZ, int section) const {
+            const int width = 2 * radius + 1;
+            return static_cast<size_t>(((chunkZ - centerZ + radius) * width + (chunkX - centerX + radius)) * SECTIONS + section);
+        }
+
+        void Fill(const std::vector<VisibleSection>& sections) {
+            for (const VisibleSection& s : sections) {
+                present[Index(s.chunk.x, s.chunk.z, s.section)] = 1;
+            }
+        }
+
+        bool Has(int chunkX, int chunkZ, int section) const {
+            return InRange(chunkX, chunkZ) && present[Index(chunkX, chunkZ, section)] != 0;
+        }
+    };
+
+    /**
+     * @brief Cast rays through the frustum; count sections seen through open blocks but culled
+     */
+    size_t CountRayMisses(const SyntheticWorld& world, const FrameView& view, const SectionSet& visible,
+                          int renderDistance, int rays, std::mt19937& rng, size_t& checked) {
+        std::uniform_real_distribution<float> ndc(-0.98f, 0.98f);
+        const float halfV = std::tan(FOV_Y * 0.5f);
+        const float halfH = halfV * ASPECT;
+        const int cameraChunkX = FloorDiv(static_cast<int>(std::floor(view.position[0])), 16);
+        const int cameraChunkZ = FloorDiv(static_cast<int>(std::floor(view.position[2])), 16);
+
+        size_t misses = 0;
+        for (int r = 0; r < rays; ++r) {
+            const float sx = ndc(rng) * halfH;
+            const float sy = ndc(rng) * halfV;
+            float dir[3];
+            for (int i = 0; i < 3; ++i) {
+                dir[i] = view.forward[i] + view.right[i] * sx + view.up[i] * sy;
+            }
+
+            // Voxel walk (Amanatides-Woo) until the first opaque block
+            int voxel[3];
+            int step[3];
+            float tMax[3];
+            float tDelta[3];
+            for (int i = 0; i < 3; ++i) {
+                voxel[i] = static_cast<int>(std::floor(view.position[i]));
+                step[i] = dir[i] >= 0.0f ? 1 : -1;
+                const float boundary = static_cast<float>(voxel[i] + (step[i] > 0 ? 1 : 0));
+                tMax[i] = dir[i] != 0.0f ? (boundary - view.position[i]) / dir[i] : 1e30f;
+                tDelta[i] = dir[i] != 0.0f ? std::abs(1.0f / dir[i]) : 1e30f;
+            }
+
+            while (true) {
+                if (voxel[1] < 0 || voxel[1] >= 256) {
+                    break;
+                }
+                const int chunkX = FloorDiv(voxel[0], 16);
+                const int chunkZ = FloorDiv(voxel[2], 16);
+                const int dx = chunkX - cameraChunkX;
+                const int dz = chunkZ - cameraChunkZ;
+                if (dx * dx + dz * dz > renderDistance * renderDistance || !world.Contains(chunkX, chunkZ)) {
+                    break;
+                }
+
+                ++checked;
+                if (!visible.Has(chunkX, chunkZ, voxel[1] >> 4)) {
+                    ++misses;
+                }
+                if (world.IsOpaque(voxel[0], voxel[1], voxel[2])) {
+                    break;
+                }
+
+                const int axis = tMax[0] < tMax[1] ? (tMax[0] < tMax[2] ? 0 : 2) : (tMax[1] < tMax[2] ? 1 : 2);
+                voxel[axis] += step[axis];
+                tMax[axis] += tDelta[axis];
+            }
+        }
+        return misses;
+    }
+
+    struct ModeStats {
+        double sections[PHASE_COUNT] = {};
+        int frames[PHASE_COUNT] = {};
+        std::vector<double> micros;
+    };
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int renderDistance = argc > 1 ? std::max(1, std::atoi(argv[1])) : 12;
+
+    std::vector<CameraFrame> path;
+    if (argc > 2) {
+        if (!LoadPath(argv[2], path)) {
+            std::printf("Cannot read camera path %s\n", argv[2]);
+            return 1;
+        }
+    } else {
+        path = BuiltInPath();
+    }
+
+    // The path reaches x = 100 and z = -60: keep the render distance inside the world
+    const int extent = renderDistance + 8;
+
+    std::printf("Culling benchmark: render distance %d, %zu frames, SSE2 frustum test: %s\n",
+                renderDistance, path.size(), SectionCulling::IsVectorized() ? "yes" : "no");
+
+    SyntheticWorld world;
+    const double buildSeconds = MeasureSeconds([&] { world = BuildWorld(extent); });
+    const int width = world.Width();
+    const size_t sectionCount = static_cast<size_t>(width * width * SECTIONS);
+
+    // Mesh-time connectivity
+    std::vector<uint16_t> connectivity(sectionCount);
+    const double connectivitySeconds = MeasureBestSeconds(3, [&] {
+        for (size_t s = 0; s < sectionCount; ++s) {
+            connectivity[s] = SectionCulling::ComputeConnectivity(&world.rows[s * ROWS_PER_SECTION]);
+        }
+        DoNotOptimize(connectivity);
+    });
+
+    SectionOcclusionCuller culler;
+    for (int chunkZ = -extent; chunkZ <= extent; ++chunkZ) {
+        for (int chunkX = -extent; chunkX <= extent; ++chunkX) {
+            std::array<uint16_t, SECTIONS> sections;
+            const size_t first = world.SectionOffset(chunkX, chunkZ, 0) / ROWS_PER_SECTION;
+            std::copy(connectivity.begin() + static_cast<std::ptrdiff_t>(first),
+                      connectivity.begin() + static_cast<std::ptrdiff_t>(first + SECTIONS), sections.begin());
+            culler.SetChunk(ChunkCoord(chunkX, chunkZ), sections);
+        }
+    }
+
+    PrintHeader("World");
+    PrintRow("chunks", static_cast<double>(width * width), "");
+    PrintRow("sections", static_cast<double>(sectionCount), "");
+    PrintRow("generation", buildSeconds * 1000.0, "ms");
+    PrintRow("connectivity per section (mesh time)", connectivitySeconds * 1e6 / static_cast<double>(sectionCount), "us");
+
+    // Replay the path
+    ModeStats distanceStats, frustumStats, occlusionStats;
+    std::vector<VisibleSection> frustumVisible, occlusionVisible;
+    SectionBoxes boxes;
+    std::vector<uint8_t> simdVisible, scalarVisible;
+    int boxesChunkX = 0, boxesChunkZ = 0;
+    bool boxesValid = false;
+
+    SectionSet frustumSet, occlusionSet;
+    std::mt19937 rng(2024);
+    bool simdMatches = true;
+    bool testBoxMatches = true;
+    size_t matrixMismatches = 0, matrixTests = 0;
+    bool occlusionSubset = true;
+    size_t rayMisses = 0, rayVoxels = 0;
+    size_t chambersFrustum = 0, chambersOcclusion = 0;
+    size_t occlusionFallbacks = 0;
+
+    for (size_t f = 0; f < path.size(); ++f) {
+        const CameraFrame& frame = path[f];
+        const FrameView view = MakeView(frame);
+        const int cameraChunkX = FloorDiv(static_cast<int>(std::floor(frame.x)), 16);
+        const int cameraChunkZ = FloorDiv(static_cast<int>(std::floor(frame.z)), 16);
+
+        // Distance only: every section in the circle
+        int columns = 0;
+        for (int dz = -renderDistance; dz <= renderDistance; ++dz) {
+            for (int dx = -renderDistance; dx <= renderDistance; ++dx) {
+                columns += dx * dx + dz * dz <= renderDistance * renderDistance ? 1 : 0;
+            }
+        }
+        distanceStats.sections[frame.phase] += columns * SECTIONS;
+        distanceStats.frames[frame.phase]++;
+
+        frustumStats.micros.push_back(1e6 * MeasureSeconds([&] {
+            culler.Cull(view.frustum, frame.x, frame.y, frame.z, renderDistance, false, frustumVisible);
+        }));
+        frustumStats.sections[frame.phase] += static_cast<double>(frustumVisible.size());
+        frustumStats.frames[frame.phase]++;
+
+        occlusionStats.micros.push_back(1e6 * MeasureSeconds([&] {
+            culler.Cull(view.frustum, frame.x, frame.y, frame.z, renderDistance, true, occlusionVisible);
+        }));
+        occlusionStats.sections[frame.phase] += static_cast<double>(occlusionVisible.size());
+        occlusionStats.frames[frame.phase]++;
+        occlusionFallbacks += culler.GetStats().occlusionUsed ? 0u : 1u;
+
+        // SIMD vs. scalar vs. TestBox on the same boxes the culler tests
+        if (!boxesValid || boxesChunkX != cameraChunkX || boxesChunkZ != cameraChunkZ) {
+            boxes.Clear();
+            for (int dz = -renderDistance; dz <= renderDistance; ++dz) {
+                for (int dx = -renderDistance; dx <= renderDistance; ++dx) {
+                    if (dx * dx + dz * dz > renderDistance * renderDistance) {
+                        continue;
+                    }
+                    const float x0 = static_cast<float>((cameraChunkX + dx) * 16);
+                    const float z0 = static_cast<float>((cameraChunkZ + dz) * 16);
+                    for (int s = 0; s < SECTIONS; ++s) {
+                        const float y0 = static_cast<float>(s * 16);
+                        boxes.Add(x0, y0, z0, x0 + 16.0f, y0 + 16.0f, z0 + 16.0f);
+                    }
+                }
+            }
+            simdVisible.resize(boxes.Size());
+            scalarVisible.resize(boxes.Size());
+            boxesChunkX = cameraChunkX;
+            boxesChunkZ = cameraChunkZ;
+            boxesValid = true;
+        }
+        const size_t simdPassed = SectionCulling::CullBoxes(view.frustum, boxes, simdVisible.data());
+        const size_t scalarPassed = SectionCulling::CullBoxesScalar(view.frustum, boxes, scalarVisible.data());
+        simdMatches &= simdPassed == scalarPassed && simdVisible == scalarVisible;
+        if (std::abs(cameraChunkX) + renderDistance <= extent && std::abs(cameraChunkZ) + renderDistance <= extent) {
+            simdMatches &= simdPassed == frustumVisible.size();     // Every box here is a loaded section
+        }
+        for (size_t i = 0; i < boxes.Size() && testBoxMatches; i += 7) {
+            testBoxMatches = view.frustum.TestBox(boxes.minX[i], boxes.minY[i], boxes.minZ[i],
+                                                  boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i]) == (scalarVisible[i] != 0);
+        }
+
+        // The matrix form of the same camera must agree (up to boxes grazing a plane)
+        if (f % 50 == 0) {
+            float viewProjection[16];
+            MakeViewProjection(view, 0.1f, 1000.0f, viewProjection);
+            const ViewFrustum fromMatrix = ViewFrustum::FromMatrix(viewProjection);
+            for (size_t i = 0; i < boxes.Size(); ++i) {
+                const bool inside = fromMatrix.TestBox(boxes.minX[i], boxes.minY[i], boxes.minZ[i],
+                                                       boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i]);
+                matrixMismatches += inside != (scalarVisible[i] != 0) ? 1u : 0u;
+                ++matrixTests;
+            }
+        }
+
+        frustumSet.Reset(cameraChunkX, cameraChunkZ, renderDistance);
+        frustumSet.Fill(frustumVisible);
+        occlusionSet.Reset(cameraChunkX, cameraChunkZ, renderDistance);
+        occlusionSet.Fill(occlusionVisible);
+
+        // The camera's own section may be added even when the near plane clips it
+        const int cameraSection = static_cast<int>(std::floor(frame.y / 16.0f));
+        for (const VisibleSection& s : occlusionVisible) {
+            const bool isCamera = s.chunk == ChunkCoord(cameraChunkX, cameraChunkZ) && s.section == cameraSection;
+            occlusionSubset &= isCamera || frustumSet.Has(s.chunk.x, s.chunk.z, s.section);
+        }
+
+        if (f % 10 == 0) {
+            rayMisses += CountRayMisses(world, view, occlusionSet, renderDistance, 400, rng, rayVoxels);
+        }
+
+        if (frame.phase == 0 || frame.phase == 3) {
+            for (const VisibleSection& s : frustumVisible) {
+                chambersFrustum += IsChamberSection(s.chunk.x, s.chunk.z, s.section) ? 1u : 0u;
+            }
+            for (const VisibleSection& s : occlusionVisible) {
+                chambersOcclusion += IsChamberSection(s.chunk.x, s.chunk.z, s.section) ? 1u : 0u;
+            }
+        }
+    }
+
+    PrintHeader("Sections drawn per frame");
+    std::printf("  %-10s %12s %12s %12s %10s\n", "phase", "distance", "frustum", "occlusion", "frames");
+    for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+        const int frames = distanceStats.frames[phase];
+        if (frames == 0) {
+            continue;
+        }
+        std::printf("  %-10s %12.1f %12.1f %12.1f %10d\n", PHASE_NAMES[phase],
+                    distanceStats.sections[phase] / frames, frustumStats.sections[phase] / frames,
+                    occlusionStats.sections[phase] / frames, frames);
+    }
+
+    PrintHeader("Cull CPU per frame");
+    PrintRow("frustum p50", Percentile(frustumStats.micros, 50.0), "us");
+    PrintRow("frustum p99", Percentile(frustumStats.micros, 99.0), "us");
+    PrintRow("frustum + occlusion p50", Percentile(occlusionStats.micros, 50.0), "us");
+    PrintRow("frustum + occlusion p99", Percentile(occlusionStats.micros, 99.0), "us");
+    PrintRow("frames without occlusion (camera not meshed)", static_cast<double>(occlusionFallbacks), "");
+
+    // Frustum test alone, on the last frame's boxes
+    const FrameView lastView = MakeView(path.back());
+    const int repetitions = 2000;
+    const double scalarSeconds = MeasureBestSeconds(5, [&] {
+        for (int i = 0; i < repetitions; ++i) {
+            DoNotOptimize(SectionCulling::CullBoxesScalar(lastView.frustum, boxes, scalarVisible.data()));
+        }
+    });
+    const double simdSeconds = MeasureBestSeconds(5, [&] {
+        for (int i = 0; i < repetitions; ++i) {
+            DoNotOptimize(SectionCulling::CullBoxes(lastView.frustum, boxes, simdVisible.data()));
+        }
+    });
+    const double perBox = 1e9 / static_cast<double>(repetitions) / static_cast<double>(boxes.Size());
+
+    PrintHeader("Frustum test");
+    PrintRow("boxes", static_cast<double>(boxes.Size()), "");
+    PrintRow("scalar", scalarSeconds * perBox, "ns/box");
+    PrintRow(SectionCulling::IsVectorized() ? "SSE2" : "CullBoxes (scalar build)", simdSeconds * perBox, "ns/box");
+
+    PrintHeader("Checks");
+    PrintRow("matrix vs. camera frustum disagreements", static_cast<double>(matrixMismatches), "");
+    PrintRow("ray voxels checked", static_cast<double>(rayVoxels), "");
+    PrintRow("ray voxels in culled sections", static_cast<double>(rayMisses), "");
+    PrintRow("chamber sections kept by frustum (surface, sky)", static_cast<double>(chambersFrustum), "");
+    PrintRow("chamber sections kept by occlusion (surface, sky)", static_cast<double>(chambersOcclusion), "");
+
+    Check(simdMatches, "SIMD frustum test matches scalar and the culler");
+    Check(testBoxMatches, "CullBoxes matches ViewFrustum::TestBox");
+    Check(matrixMismatches * 1000 <= matrixTests, "ViewFrustum::FromMatrix agrees with FromCamera");
+    Check(occlusionSubset, "occlusion culling only removes frustum survivors");
+    Check(rayMisses == 0, "no section seen through open blocks is culled");
+    if (argc <= 2) {
+        Check(chambersFrustum > 0 && chambersOcclusion == 0, "sealed chambers are culled from the surface and sky");
+    }
+
+    if (g_failed) {
+        std::printf("\nFAILED\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,328 @@
+/**
+ * @file EntityStorageBenchmark.cpp
+ * @brief Milliseconds per transform/physics update over 100k entities
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * The same entity population is stored two ways:
+ *
+ *   legacy     what EntityManager did: entities in an unordered_map of
+ *              unique_ptr, components as heap objects with virtual Update,
+ *              a ComponentMap by type_index, and GetComponentsOfType<T>()
+ *              building a fresh vector under the shared_mutex with a
+ *              dynamic_cast per element; physics looks up the owner's
+ *              transform through the entity's own locked component map
+ *   archetype  ArchetypeStorage: SoA columns in 16 KiB chunks, iterated
+ *              through cached queries with no virtual calls or locks
+ *
+ * 20% of the entities have only a transform, 70% have transform and
+ * physics and 10% also carry a tag, so the physics query spans two
+ * archetypes. The math is the one in TransformSystem and PhysicsSystem.
+ * After the timed frames both sides must hold identical positions.
+ *
+ * Usage: EntityStorageBenchmark [entities] [frames]
+ */
+
+#include "BenchmarkCommon.hpp"
+
+#include "entities/ArchetypeStorage.hpp"
+#include "entities/ComponentData.hpp"
+
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <shared_mutex>
+#include <typeindex>
+#include <unordered_map>
+
+using namespace VoxelCraft;
+using namespace VoxelCraft::Benchmark;
+
+namespace {
+
+    constexpr float DELTA_TIME = 1.0f / 60.0f;
+    const glm::vec3 GRAVITY(0.0f, -9.81f, 0.0f);
+
+    struct TagData {
+        uint32_t group = 0;
+    };
+
+    // Shared kernels, identical to TransformSystem / PhysicsSystem
+    inline void ComputeWorldMatrix(TransformData& transform) {
+        glm::mat4 matrix = glm::mat4_cast(transform.rotation);
+        matrix[0] *= transform.scale.x;
+        matrix[1] *= transform.scale.y;
+        matrix[2] *= transform.scale.z;
+        matrix[3] = glm::vec4(transform.position, 1.0f);
+        transform.worldMatrix = matrix;
+    }
+
+    inline void Integrate(TransformData& transform, PhysicsData& body, float deltaTime) {
+        glm::vec3& position = transform.position;
+        const glm::vec3 acceleration = body.useGravity ? body.acceleration + GRAVITY : body.acceleration;
+        body.velocity += acceleration * deltaTime;
+        body.velocity *= std::max(0.0f, 1.0f - body.drag * deltaTime);
+        position += body.velocity * deltaTime;
+
+        body.grounded = position.y <= body.groundHeight;
+        if (body.grounded) {
+            position.y = body.groundHeight;
+            body.velocity.y = std::max(body.velocity.y, 0.0f);
+        }
+    }
+
+    // ---- Legacy storage, as EntityManager/Entity/Component laid it out ----
+
+    class LegacyEntity;
+
+    class LegacyComponent {
+    public:
+        virtual ~LegacyComponent() = default;
+        virtual void Update(float deltaTime) = 0;
+        LegacyEntity* owner = nullptr;
+    };
+
+    class LegacyEntity {
+    public:
+        explicit LegacyEntity(uint64_t entityId) : id(entityId) {}
+
+        template<typename T>
+        T* AddComponent() {
+            std::unique_lock lock(mutex);
+            auto component = std::make_unique<T>();
+            component->owner = this;
+            T* rawPtr = component.get();
+            components[std::type_index(typeid(T))] = std::move(component);
+            return rawPtr;
+        }
+
+        template<typename T>
+        T* GetComponent() const {
+            std::shared_lock lock(mutex);
+            auto it = components.find(std::type_index(typeid(T)));
+            return it != components.end() ? static_cast<T*>(it->second.get()) : nullptr;
+        }
+
+        uint64_t id;
+        mutable std::shared_mutex mutex;
+        std::unordered_map<std::type_index, std::unique_ptr<LegacyComponent>> components;
+    };
+
+    class LegacyTransform : public LegacyComponent {
+    public:
+        void Update(float) override { ComputeWorldMatrix(data); }
+        TransformData data;
+    };
+
+    class LegacyPhysics : public LegacyComponent {
+    public:
+        void Update(float deltaTime) override {
+            LegacyTransform* transform = owner->GetComponent<LegacyTransform>();
+            if (transform) {
+                Integrate(transform->data, data, deltaTime);
+            }
+        }
+        PhysicsData data;
+    };
+
+    class LegacyTag : public LegacyComponent {
+    public:
+        void Update(float) override {}
+        TagData data;
+    };
+
+    class LegacyManager {
+    public:
+        LegacyEntity* CreateEntity() {
+            const uint64_t id = m_NextId++;
+            auto entity = std::make_unique<LegacyEntity>(id);
+            LegacyEntity* rawPtr = entity.get();
+            m_Entities[id] = std::move(entity);
+            return rawPtr;
+        }
+
+        template<typename T>
+        T* AddComponent(LegacyEntity* entity) {
+            T* component = entity->AddComponent<T>();
+            std::unique_lock lock(m_ComponentMutex);
+            m_ComponentMap[std::type_index(typeid(T))].push_back(component);
+            return component;
+        }
+
+        template<typename T>
+        std::vector<T*> GetComponentsOfType() const {
+            std::shared_lock lock(m_ComponentMutex);
+            std::vector<T*> result;
+            auto it = m_ComponentMap.find(std::type_index(typeid(T)));
+            if (it != m_ComponentMap.end()) {
+                for (LegacyComponent* component : it->second) {
+                    if (T* typed = dynamic_cast<T*>(component)) {
+                        result.push_back(typed);
+                    }
+                }
+            }
+            return result;
+        }
+
+        template<typename T>
+        void UpdateAll(float deltaTime) {
+            for (T* component : GetComponentsOfType<T>()) {
+                component->Update(deltaTime);
+            }
+        }
+
+        const std::unordered_map<uint64_t, std::unique_ptr<LegacyEntity>>& GetEntities() const { return m_Entities; }
+
+    private:
+        uint64_t m_NextId = 1;
+        std::unordered_map<uint64_t, std::unique_ptr<LegacyEntity>> m_Entities;
+        std::unordered_map<std::type_index, std::vector<LegacyComponent*>> m_ComponentMap;
+        mutable std::shared_mutex m_ComponentMutex;
+    };
+
+    struct Spawn {
+        TransformData transform;
+        PhysicsData body;
+        bool hasPhysics = false;
+        bool hasTag = false;
+    };
+
+    std::vector<Spawn> MakePopulation(size_t count) {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::uniform_real_distribution<float> spread(-500.0f, 500.0f);
+
+        std::vector<Spawn> spawns(count);
+        for (Spawn& spawn : spawns) {
+            const float kind = unit(rng);
+            spawn.hasPhysics = kind >= 0.2f;
+            spawn.hasTag = kind >= 0.9f;
+
+            spawn.transform.position = glm::vec3(spread(rng), 64.0f + unit(rng) * 64.0f, spread(rng));
+            const float angle = unit(rng) * 6.2831853f;
+            spawn.transform.rotation = glm::quat(std::cos(angle * 0.5f), 0.0f, std::sin(angle * 0.5f), 0.0f);
+            spawn.transform.scale = glm::vec3(0.5f + unit(rng));
+
+            spawn.body.velocity = glm::vec3(spread(rng), spread(rng), spread(rng)) * 0.01f;
+            spawn.body.acceleration = glm::vec3(0.0f, unit(rng) * 2.0f, 0.0f);
+            spawn.body.drag = unit(rng) * 0.5f;
+            spawn.body.groundHeight = 60.0f + unit(rng) * 8.0f;
+            spawn.body.useGravity = unit(rng) > 0.1f;
+        }
+        return spawns;
+    }
+
+    struct Timings {
+        std::vector<double> transform;
+        std::vector<double> physics;
+    };
+
+    void PrintTimings(const std::string& label, const Timings& timings) {
+        PrintRow(label + " transform p50", Percentile(timings.transform, 50.0) * 1e3, "ms");
+        PrintRow(label + " physics p50", Percentile(timings.physics, 50.0) * 1e3, "ms");
+        PrintRow(label + " physics p99", Percentile(timings.physics, 99.0) * 1e3, "ms");
+    }
+
+}
+
+int main(int argc, char** argv) {
+    const size_t entityCount = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 100000;
+    const int frames = argc > 2 ? std::atoi(argv[2]) : 120;
+
+    const std::vector<Spawn> spawns = MakePopulation(entityCount);
+
+    LegacyManager legacy;
+    std::vector<LegacyTransform*> legacyTransforms;
+    legacyTransforms.reserve(entityCount);
+    double legacyBuild = MeasureSeconds([&]() {
+        for (const Spawn& spawn : spawns) {
+            LegacyEntity* entity = legacy.CreateEntity();
+            LegacyTransform* transform = legacy.AddComponent<LegacyTransform>(entity);
+            transform->data = spawn.transform;
+            legacyTransforms.push_back(transform);
+            if (spawn.hasPhysics) {
+                legacy.AddComponent<LegacyPhysics>(entity)->data = spawn.body;
+            }
+            if (spawn.hasTag) {
+                legacy.AddComponent<LegacyTag>(entity);
+            }
+        }
+    });
+
+    ArchetypeStorage storage;
+    std::vector<ArchetypeStorage::EntityHandle> handles;
+    handles.reserve(entityCount);
+    double archetypeBuild = MeasureSeconds([&]() {
+        for (const Spawn& spawn : spawns) {
+            const ArchetypeStorage::EntityHandle entity = storage.Create();
+            storage.Add<TransformData>(entity, spawn.transform);
+            if (spawn.hasPhysics) {
+                storage.Add<PhysicsData>(entity, spawn.body);
+            }
+            if (spawn.hasTag) {
+                storage.Add<TagData>(entity);
+            }
+            handles.push_back(entity);
+        }
+    });
+
+    const ArchetypeQuery<TransformData> transformQuery = storage.Query<TransformData>();
+    const ArchetypeQuery<TransformData, PhysicsData> physicsQuery = storage.Query<TransformData, PhysicsData>();
+
+    Timings legacyTimings;
+    Timings archetypeTimings;
+    for (int frame = 0; frame < frames; ++frame) {
+        legacyTimings.physics.push_back(MeasureSeconds([&]() { legacy.UpdateAll<LegacyPhysics>(DELTA_TIME); }));
+        legacyTimings.transform.push_back(MeasureSeconds([&]() { legacy.UpdateAll<LegacyTransform>(DELTA_TIME); }));
+
+        archetypeTimings.physics.push_back(MeasureSeconds([&]() {
+            physicsQuery.ForEachChunk([](size_t count, TransformData* transforms, PhysicsData* bodies) {
+                for (size_t i = 0; i < count; ++i) {
+                    Integrate(transforms[i], bodies[i], DELTA_TIME);
+                }
+            });
+        }));
+        archetypeTimings.transform.push_back(MeasureSeconds([&]() {
+            transformQuery.ForEachChunk([](size_t count, TransformData* transforms) {
+                for (size_t i = 0; i < count; ++i) {
+                    ComputeWorldMatrix(transforms[i]);
+                }
+            });
+        }));
+    }
+
+    // Both layouts ran the same kernels in the same order per entity
+    size_t mismatches = 0;
+    for (size_t i = 0; i < entityCount; ++i) {
+        const TransformData* transform = storage.Get<TransformData>(handles[i]);
+        if (!transform || transform->position != legacyTransforms[i]->data.position ||
+            transform->worldMatrix[3] != legacyTransforms[i]->data.worldMatrix[3]) {
+            mismatches++;
+        }
+    }
+
+    size_t chunks = 0;
+    for (const Archetype* archetype : transformQuery.GetArchetypes()) {
+        chunks += archetype->GetChunkCount();
+    }
+
+    PrintHeader("Entity storage: " + std::to_string(entityCount) + " entities, " + std::to_string(frames) + " frames");
+    PrintRow("physics entities", static_cast<double>(physicsQuery.Count()), "");
+    PrintRow("archetypes", static_cast<double>(storage.GetArchetypeCount()), "");
+    PrintRow("transform chunks", static_cast<double>(chunks), "");
+    PrintRow("legacy build", legacyBuild * 1e3, "ms");
+    PrintRow("archetype build", archetypeBuild * 1e3, "ms");
+    PrintTimings("legacy", legacyTimings);
+    PrintTimings("archetype", archetypeTimings);
+
+    PrintHeader("Speedup (legacy p50 / archetype p50)");
+    PrintRow("transform", Percentile(legacyTimings.transform, 50.0) / Percentile(archetypeTimings.transform, 50.0), "x");
+    PrintRow("physics", Percentile(legacyTimings.physics, 50.0) / Percentile(archetypeTimings.physics, 50.0), "x");
+
+    if (mismatches != 0) {
+        std::printf("\nFAILED: %zu entities differ between legacy and archetype storage\n", mismatches);
+        return 1;
+    }
+    return 0;
+}
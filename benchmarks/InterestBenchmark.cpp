@@ -0,0 +1,399 @@
+/**
+ * @file InterestBenchmark.cpp
+ * @brief Server egress and CPU with interest management, 100 simulated clients
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * Simulates a server tick loop (20 TPS) with clients spread uniformly
+ * over a 4096x4096 block map. Most walk, some fly fast enough to cross a
+ * chunk every second; all of them join on the first tick. Mobs wander
+ * around the players, and every player is also an entity the others see.
+ * No sockets are opened: sends are counted in bytes on the wire.
+ *
+ *   broadcast  what Server::BroadcastPacket does today: every entity
+ *              update to every client every tick, and every chunk that
+ *              enters a client's view sent at once
+ *   interest   InterestManager: entity updates only inside the client's
+ *              view, every 1/2/4/8 ticks by distance; chunks from a
+ *              queue ordered by distance and view direction, with
+ *              per-client and per-server byte budgets per tick
+ *
+ * Chunk frames are sized like the LZ4 + dictionary CHUNK_DATA frames of
+ * PacketCompressionBenchmark (1.4-2.5 KB); entity updates use the size
+ * of a serialized PlayerPositionAndRotationPacket.
+ *
+ * Reported per mode: egress per second (entities and chunks), peak and
+ * p99 egress per tick, server CPU per tick spent deciding who gets what
+ * and queueing frame references on each client (as ServerTransport's
+ * send queues do; the writev itself is not included), and chunks
+ * within two chunks of a player still missing (averaged over ticks) as a
+ * measure of how quickly what matters arrives.
+ *
+ * Checks: with the clients standing still every view fills completely
+ * and nothing outside view + unloadMargin stays loaded, the queue starts
+ * with the player's chunk and leans the way they look, the budgets hold,
+ * and interest sends fewer entity bytes than broadcast. Any failure
+ * prints FAILED and exits with 1.
+ *
+ * Usage: InterestBenchmark [clients] [seconds] [mobs per client]
+ */
+
+#include "BenchmarkCommon.hpp"
+
+#include "network/InterestManager.hpp"
+#include "network/Packet.hpp"
+#include "network/PacketBuffer.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <random>
+
+using namespace VoxelCraft;
+using namespace VoxelCraft::Benchmark;
+
+namespace {
+
+    constexpr float MAP_SIZE = 4096.0f;
+    constexpr int TICKS_PER_SECOND = 20;
+    constexpr size_t TRANSPORT_PREFIX = 4;      // ServerTransport frame length
+    constexpr float WALK_SPEED = 4.3f / TICKS_PER_SECOND;
+    constexpr float FLY_SPEED = 20.0f / TICKS_PER_SECOND;
+    constexpr uint32_t ENTITY_ID_BASE = 1u << 20;
+    constexpr int NEAR_RADIUS = 2;
+
+    bool g_failed = false;
+
+    void Check(bool condition, const char* what) {
+        if (!condition) {
+            std::printf("  FAILED: %s\n", what);
+            g_failed = true;
+        }
+    }
+
+    struct Mover {
+        uint32_t id = 0;
+        float x = 0.0f, y = 70.0f, z = 0.0f;
+        float heading = 0.0f;
+        float speed = 0.0f;
+        int turnTimer = 0;
+    };
+
+    struct Simulation {
+        std::vector<Mover> clients;
+        std::vector<Mover> mobs;
+    };
+
+    Simulation CreateSimulation(size_t clientCount, size_t mobsPerClient, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> position(0.0f, MAP_SIZE);
+        std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+        std::uniform_real_distribution<float> offset(-96.0f, 96.0f);
+
+        Simulation simulation;
+        for (size_t i = 0; i < clientCount; ++i) {
+            Mover client;
+            client.id = static_cast<uint32_t>(i + 1);
+            client.x = position(rng);
+            client.z = position(rng);
+            client.heading = angle(rng);
+            client.speed = i % 10 == 0 ? FLY_SPEED : WALK_SPEED;
+            simulation.clients.push_back(client);
+
+            for (size_t m = 0; m < mobsPerClient; ++m) {
+                Mover mob;
+                mob.id = ENTITY_ID_BASE + static_cast<uint32_t>(simulation.mobs.size());
+                mob.x = client.x + offset(rng);
+                mob.z = client.z + offset(rng);
+                mob.y = 64.0f;
+                mob.heading = angle(rng);
+                mob.speed = 1.0f / TICKS_PER_SECOND;
+                simulation.mobs.push_back(mob);
+            }
+        }
+        return simulation;
+    }
+
+    void Step(std::vector<Mover>& movers, std::mt19937& rng) {
+        std::uniform_real_distribution<float> turn(-1.5f, 1.5f);
+        std::uniform_int_distribution<int> timer(40, 200);
+        for (Mover& mover : movers) {
+            if (--mover.turnTimer <= 0) {
+                mover.heading += turn(rng);
+                mover.turnTimer = timer(rng);
+            }
+            mover.x = std::clamp(mover.x + std::cos(mover.heading) * mover.speed, 0.0f, MAP_SIZE);
+            mover.z = std::clamp(mover.z + std::sin(mover.heading) * mover.speed, 0.0f, MAP_SIZE);
+        }
+    }
+
+    // LZ4 + dictionary CHUNK_DATA frames run 1.4-2.5 KB; fixed per chunk so both modes pay the same
+    size_t ChunkWireBytes(const ChunkCoord& coord) {
+        uint32_t hash = static_cast<uint32_t>(coord.x) * 73856093u ^ static_cast<uint32_t>(coord.z) * 83492791u;
+        hash ^= hash >> 15;
+        return TRANSPORT_PREFIX + 1400 + hash % 1100;
+    }
+
+    struct Mode {
+        const char* name;
+        InterestConfig config;
+        bool filterEntities;
+    };
+
+    struct ModeResult {
+        uint64_t entityBytes = 0;
+        uint64_t chunkBytes = 0;
+        uint64_t entityUpdates = 0;
+        std::vector<double> tickBytes;
+        std::vector<double> tickChunkBytes;
+        std::vector<double> tickMicros;
+        double nearMissing = 0.0;               // Summed over ticks
+        InterestStats stats;
+    };
+
+    struct Frames {
+        PacketBuffer entity;
+        PacketBuffer chunk;
+        PacketBuffer unload;
+    };
+
+    ModeResult RunMode(const Mode& mode, size_t clientCount, size_t mobsPerClient, int ticks, const Frames& frames) {
+        const size_t entityBytes = TRANSPORT_PREFIX + frames.entity.Size();
+        const size_t unloadBytes = TRANSPORT_PREFIX + frames.unload.Size();
+
+        Simulation simulation = CreateSimulation(clientCount, mobsPerClient, 1234);
+        std::mt19937 rng(99);
+
+        InterestManager interest(mode.config);
+        for (const Mover& client : simulation.clients) {
+            interest.AddClient(client.id);
+        }
+
+        ModeResult result;
+        std::vector<uint32_t> recipients;
+        recipients.reserve(clientCount);
+
+        // Per-client send queues holding frame references, as in ServerTransport
+        std::vector<std::vector<PacketBuffer>> queues(clientCount + 1);
+
+        for (int tick = 0; tick < ticks; ++tick) {
+            Step(simulation.clients, rng);
+            Step(simulation.mobs, rng);
+
+            uint64_t tickEntityBytes = 0;
+            uint64_t tickChunkBytes = 0;
+            const auto start = Clock::now();
+
+            for (const Mover& client : simulation.clients) {
+                interest.UpdateClient(client.id, client.x, client.y, client.z,
+                                      std::cos(client.heading), std::sin(client.heading));
+            }
+
+            auto sendEntity = [&](const Mover& entity, uint32_t exclude) {
+                recipients.clear();
+                if (mode.filterEntities) {
+                    interest.CollectEntityRecipients(entity.id, entity.x, entity.y, entity.z,
+                                                     static_cast<uint64_t>(tick), recipients, exclude);
+                } else {
+                    for (const Mover& client : simulation.clients) {
+                        if (client.id != exclude) {
+                            recipients.push_back(client.id);
+                        }
+                    }
+                }
+                for (uint32_t id : recipients) {
+                    queues[id].push_back(frames.entity);
+                }
+                tickEntityBytes += recipients.size() * entityBytes;
+                result.entityUpdates += recipients.size();
+            };
+            for (const Mover& mob : simulation.mobs) {
+                sendEntity(mob, 0);
+            }
+            for (const Mover& client : simulation.clients) {
+                sendEntity(client, client.id);
+            }
+
+            interest.ScheduleChunks(
+                [&](uint32_t id, const ChunkCoord& coord) {
+                    const size_t bytes = ChunkWireBytes(coord);
+                    queues[id].push_back(frames.chunk);
+                    tickChunkBytes += bytes;
+                    return bytes;
+                },
+                [&](uint32_t id, const ChunkCoord&) {
+                    queues[id].push_back(frames.unload);
+                    tickChunkBytes += unloadBytes;
+                });
+
+            // The reactor writes everything out and drops its references
+            for (auto& queue : queues) {
+                queue.clear();
+            }
+
+            result.tickMicros.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+            result.tickBytes.push_back(static_cast<double>(tickEntityBytes + tickChunkBytes));
+            result.tickChunkBytes.push_back(static_cast<double>(tickChunkBytes));
+            result.entityBytes += tickEntityBytes;
+            result.chunkBytes += tickChunkBytes;
+
+            for (const Mover& client : simulation.clients) {
+                const ChunkCoord center = InterestManager::ToChunkCoord(client.x, client.z);
+                for (int dz = -NEAR_RADIUS; dz <= NEAR_RADIUS; ++dz) {
+                    for (int dx = -NEAR_RADIUS; dx <= NEAR_RADIUS; ++dx) {
+                        if (!interest.HasChunk(client.id, ChunkCoord(center.x + dx, center.z + dz))) {
+                            result.nearMissing += 1.0;
+                        }
+                    }
+                }
+            }
+        }
+
+        // Standing still, every view must fill and nothing stale may remain
+        for (int tick = 0; tick < 100000; ++tick) {
+            bool queued = false;
+            for (const Mover& client : simulation.clients) {
+                queued |= interest.GetQueuedChunkCount(client.id) != 0;
+            }
+            if (!queued && tick > 0) {
+                break;
+            }
+            interest.ScheduleChunks([](uint32_t, const ChunkCoord& coord) { return ChunkWireBytes(coord); }, nullptr);
+        }
+
+        bool complete = true;
+        bool bounded = true;
+        const int radius = mode.config.viewDistance;
+        const int keep = radius + mode.config.unloadMargin;
+        for (const Mover& client : simulation.clients) {
+            const ChunkCoord center = InterestManager::ToChunkCoord(client.x, client.z);
+            size_t inKeep = 0;
+            for (int dz = -keep; dz <= keep; ++dz) {
+                for (int dx = -keep; dx <= keep; ++dx) {
+                    const bool has = interest.HasChunk(client.id, ChunkCoord(center.x + dx, center.z + dz));
+                    if (dx * dx + dz * dz <= radius * radius) {
+                        complete &= has;
+                    }
+                    if (has && dx * dx + dz * dz <= keep * keep) {
+                        inKeep++;
+                    }
+                }
+            }
+            bounded &= inKeep == interest.GetSentChunkCount(client.id);
+        }
+        Check(complete, "every chunk in view reaches a standing client");
+        Check(bounded, "chunks outside view + unloadMargin are unloaded");
+
+        result.stats = interest.GetStats();
+        return result;
+    }
+
+    void Report(const Mode& mode, const ModeResult& result, int ticks, size_t clientCount) {
+        const double seconds = static_cast<double>(ticks) / TICKS_PER_SECOND;
+        PrintHeader(mode.name);
+        PrintRow("egress total", static_cast<double>(result.entityBytes + result.chunkBytes) / seconds / 1e6, "MB/s");
+        PrintRow("  entity updates", static_cast<double>(result.entityBytes) / seconds / 1e6, "MB/s");
+        PrintRow("  chunks", static_cast<double>(result.chunkBytes) / seconds / 1e6, "MB/s");
+        PrintRow("entity updates per client per tick",
+                 static_cast<double>(result.entityUpdates) / static_cast<double>(ticks) / static_cast<double>(clientCount), "");
+        PrintRow("egress per tick p99", Percentile(result.tickBytes, 99.0) / 1e6, "MB");
+        PrintRow("egress per tick peak", Percentile(result.tickBytes, 100.0) / 1e6, "MB");
+        PrintRow("server CPU per tick p50 (decide + enqueue)", Percentile(result.tickMicros, 50.0), "us");
+        PrintRow("server CPU per tick p99 (decide + enqueue)", Percentile(result.tickMicros, 99.0), "us");
+        PrintRow("near chunks missing per client", result.nearMissing / static_cast<double>(ticks) / static_cast<double>(clientCount), "");
+        PrintRow("chunks sent", static_cast<double>(result.stats.chunksSent), "");
+        PrintRow("chunks unloaded", static_cast<double>(result.stats.chunksUnloaded), "");
+        PrintRow("queue rebuilds", static_cast<double>(result.stats.queueRebuilds), "");
+    }
+
+    void CheckOrdering() {
+        InterestConfig config;
+        config.viewDistance = 8;
+        InterestManager interest(config);
+        interest.AddClient(1);
+        interest.UpdateClient(1, 8.0f, 70.0f, 8.0f, 1.0f, 0.0f);   // Looking towards +X
+
+        std::vector<ChunkCoord> order;
+        interest.ScheduleChunks([&](uint32_t, const ChunkCoord& coord) {
+            order.push_back(coord);
+            return size_t(2000);
+        }, nullptr);
+
+        Check(!order.empty() && order.front() == ChunkCoord(0, 0), "queue starts with the player's chunk");
+        int forward = 0;
+        for (size_t i = 0; i < std::min<size_t>(order.size(), 20); ++i) {
+            forward += order[i].x;
+        }
+        Check(forward > 0, "queue leans towards the view direction");
+        Check(order.size() * 2000 <= config.clientChunkBytesPerTick + 2000, "client budget holds");
+
+        // Chunks not ready yet keep their place
+        size_t calls = 0;
+        interest.ScheduleChunks([&](uint32_t, const ChunkCoord&) { calls++; return size_t(0); }, nullptr);
+        Check(calls == config.maxChunkAttemptsPerTick, "unavailable chunks are bounded by maxChunkAttemptsPerTick");
+        const size_t queued = interest.GetQueuedChunkCount(1);
+        interest.ScheduleChunks([](uint32_t, const ChunkCoord&) { return size_t(0); }, nullptr);
+        Check(interest.GetQueuedChunkCount(1) == queued, "unavailable chunks stay queued");
+
+        Check(interest.GetEntityUpdateInterval(10.0f, 8) == 1, "near entities every tick");
+        Check(interest.GetEntityUpdateInterval(50.0f, 8) == 2, "entities at 50 blocks every 2 ticks");
+        Check(interest.GetEntityUpdateInterval(100.0f, 8) == 4, "entities at 100 blocks every 4 ticks");
+        Check(interest.GetEntityUpdateInterval(200.0f, 8) == 0, "entities beyond the view are culled");
+
+        std::vector<uint32_t> recipients;
+        interest.CollectChunkRecipients(ChunkCoord(0, 0), recipients);
+        Check(recipients.size() == 1, "block updates reach clients that have the chunk");
+        recipients.clear();
+        interest.CollectChunkRecipients(ChunkCoord(40, 40), recipients);
+        Check(recipients.empty(), "block updates skip clients without the chunk");
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t clients = argc > 1 ? static_cast<size_t>(std::max(1, std::atoi(argv[1]))) : 100;
+    const int seconds = argc > 2 ? std::max(1, std::atoi(argv[2])) : 30;
+    const size_t mobsPerClient = argc > 3 ? static_cast<size_t>(std::max(0, std::atoi(argv[3]))) : 20;
+    const int ticks = seconds * TICKS_PER_SECOND;
+
+    PlayerPositionAndRotationPacket entityPacket(100.5, 70.0, -20.25, 90.0f, 0.0f, true);
+    ChunkDataPacket chunkPacket(0, 0, true, 0xFFFF, std::vector<uint8_t>(1950, 1));
+    ChunkDataPacket unloadPacket(0, 0, true, 0, std::vector<uint8_t>());
+    entityPacket.Serialize();
+    chunkPacket.Serialize();
+    unloadPacket.Serialize();
+    const Frames frames{ entityPacket.GetBuffer(), chunkPacket.GetBuffer(), unloadPacket.GetBuffer() };
+
+    std::printf("Interest benchmark: %zu clients, %zu mobs, %d s at %d TPS\n",
+                clients, clients * mobsPerClient, seconds, TICKS_PER_SECOND);
+    PrintRow("entity update frame", static_cast<double>(TRANSPORT_PREFIX + frames.entity.Size()), "bytes");
+    PrintRow("chunk unload frame", static_cast<double>(TRANSPORT_PREFIX + frames.unload.Size()), "bytes");
+
+    Mode broadcast{ "broadcast", InterestConfig(), false };
+    broadcast.config.facingWeight = 0.0f;
+    broadcast.config.clientChunkBytesPerTick = std::numeric_limits<size_t>::max() / 4;
+    broadcast.config.totalChunkBytesPerTick = std::numeric_limits<size_t>::max() / 4;
+    broadcast.config.maxChunkAttemptsPerTick = std::numeric_limits<size_t>::max();
+
+    const Mode interest{ "interest", InterestConfig(), true };
+
+    const ModeResult broadcastResult = RunMode(broadcast, clients, mobsPerClient, ticks, frames);
+    Report(broadcast, broadcastResult, ticks, clients);
+
+    const ModeResult interestResult = RunMode(interest, clients, mobsPerClient, ticks, frames);
+    Report(interest, interestResult, ticks, clients);
+
+    const double maxChunk = static_cast<double>(TRANSPORT_PREFIX + 2500);
+    Check(Percentile(interestResult.tickChunkBytes, 100.0) <=
+          static_cast<double>(interest.config.totalChunkBytesPerTick) + maxChunk * static_cast<double>(clients),
+          "server chunk budget holds");
+    Check(interestResult.entityBytes < broadcastResult.entityBytes, "interest sends fewer entity bytes");
+
+    CheckOrdering();
+
+    if (g_failed) {
+        std::printf("\nFAILED\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,193 @@
+/**
+ * @file LightingBenchmark.cpp
+ * @brief Measures BFS relight cost in a loaded 16x16-chunk area
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * Workloads: full relight of every chunk, then incremental updates for
+ * torch placement/removal and for roofing/unroofing a sky-lit cell.
+ * Incremental updates are compared against relighting the whole chunk.
+ */
+
+#include "BenchmarkCommon.hpp"
+
+#include "blocks/Block.hpp"
+#include "world/Chunk.hpp"
+#include "world/LightPropagator.hpp"
+#include "core/ThreadPool.hpp"
+
+#include <memory>
+#include <random>
+#include <unordered_map>
+
+using namespace VoxelCraft;
+using namespace VoxelCraft::Benchmark;
+
+namespace {
+
+    constexpr int32_t AREA_CHUNKS = 16;
+    constexpr int32_t AREA_BLOCKS = AREA_CHUNKS * 16;
+    constexpr int TORCH_OPS = 2000;
+
+    using ChunkMap = std::unordered_map<ChunkCoord, std::shared_ptr<Chunk>>;
+
+    int32_t SurfaceHeight(int32_t x, int32_t z) {
+        return 64 + ((x * 7 + z * 13) % 9);
+    }
+
+    ChunkMap BuildArea() {
+        ChunkMap chunks;
+        std::mt19937 rng(1337);
+
+        for (int32_t cz = 0; cz < AREA_CHUNKS; ++cz) {
+            for (int32_t cx = 0; cx < AREA_CHUNKS; ++cx) {
+                auto chunk = std::make_shared<Chunk>(ChunkCoord(cx, cz));
+
+                for (uint8_t z = 0; z < 16; ++z) {
+                    for (uint8_t x = 0; x < 16; ++x) {
+                        int32_t height = SurfaceHeight(cx * 16 + x, cz * 16 + z);
+                        for (int32_t y = 0; y <= height; ++y) {
+                            BlockType type = BlockType::STONE;
+                            if (y == height) {
+                                type = BlockType::GRASS_BLOCK;
+                            } else if (y + 3 > height) {
+                                type = BlockType::DIRT;
+                            } else if (y < 40 && rng() % 12 == 0) {
+                                type = BlockType::AIR; // Caves for block light to fill
+                            }
+                            chunk->SetBlockId(x, static_cast<uint8_t>(y), z, static_cast<uint16_t>(type));
+                        }
+                    }
+                }
+
+                chunks[ChunkCoord(cx, cz)] = chunk;
+            }
+        }
+
+        return chunks;
+    }
+
+    struct Sample {
+        WorldCoord coord;
+        std::shared_ptr<Chunk> chunk;
+    };
+
+    std::vector<Sample> PickSurfaceCells(ChunkMap& chunks, int count, uint32_t seed, int32_t heightAboveSurface) {
+        std::mt19937 rng(seed);
+        std::vector<Sample> samples;
+        samples.reserve(static_cast<size_t>(count));
+
+        // Stay one chunk away from the edge so every update has all neighbors
+        std::uniform_int_distribution<int32_t> dist(16, AREA_BLOCKS - 17);
+        for (int i = 0; i < count; ++i) {
+            int32_t x = dist(rng);
+            int32_t z = dist(rng);
+            WorldCoord coord(x, SurfaceHeight(x, z) + heightAboveSurface, z);
+            samples.push_back({ coord, chunks[coord.toChunkCoord()] });
+        }
+        return samples;
+    }
+
+    void SetBlock(LightPropagator& propagator, const Sample& sample, BlockType type) {
+        auto local = sample.coord.toBlockCoord();
+        uint16_t oldId = sample.chunk->GetBlockId(local.x, local.y, local.z);
+        sample.chunk->SetBlockId(local.x, local.y, local.z, static_cast<uint16_t>(type));
+        propagator.UpdateBlock(sample.coord, oldId, static_cast<uint16_t>(type));
+    }
+
+    void ReportLatencies(const char* label, const std::vector<double>& micros) {
+        double sum = 0.0;
+        for (double value : micros) {
+            sum += value;
+        }
+        std::string name(label);
+        PrintRow(name + " mean", sum / static_cast<double>(micros.size()), "us");
+        PrintRow(name + " p50", Percentile(micros, 50.0), "us");
+        PrintRow(name + " p99", Percentile(micros, 99.0), "us");
+    }
+
+    template<typename Fn>
+    std::vector<double> TimeEach(const std::vector<Sample>& samples, Fn&& fn) {
+        std::vector<double> micros;
+        micros.reserve(samples.size());
+        for (const auto& sample : samples) {
+            micros.push_back(MeasureSeconds([&]() { fn(sample); }) * 1e6);
+        }
+        return micros;
+    }
+
+} // namespace
+
+int main() {
+    std::printf("Lighting benchmark: %dx%d chunk area, %d ops per workload\n",
+        AREA_CHUNKS, AREA_CHUNKS, TORCH_OPS);
+
+    ChunkMap chunks = BuildArea();
+    LightPropagator propagator([&chunks](const ChunkCoord& coord) -> std::shared_ptr<Chunk> {
+        auto it = chunks.find(coord);
+        return it != chunks.end() ? it->second : nullptr;
+    });
+
+    PrintHeader("full relight");
+
+    double relightSeconds = MeasureSeconds([&]() {
+        for (auto& pair : chunks) {
+            propagator.RelightChunk(pair.second.get());
+        }
+    });
+    PrintRow("all chunks", relightSeconds * 1e3, "ms");
+    PrintRow("per chunk", relightSeconds * 1e6 / static_cast<double>(chunks.size()), "us");
+
+    double batchSeconds = MeasureSeconds([&]() {
+        for (auto& pair : chunks) {
+            propagator.QueueChunkRelight(pair.first);
+        }
+        propagator.ProcessQueued();
+    });
+    PrintRow("all chunks (queued batch, inline)", batchSeconds * 1e3, "ms");
+
+    ThreadPool pool;
+    pool.Initialize();
+    double pooledSeconds = MeasureSeconds([&]() {
+        for (auto& pair : chunks) {
+            propagator.QueueChunkRelight(pair.first);
+        }
+        propagator.ProcessQueued(&pool);
+    });
+    pool.Shutdown();
+    PrintRow("all chunks (queued batch, thread pool)", pooledSeconds * 1e3, "ms");
+
+    auto torches = PickSurfaceCells(chunks, TORCH_OPS, 42, 1);
+    auto roofs = PickSurfaceCells(chunks, TORCH_OPS, 43, 4);
+
+    PrintHeader("incremental torch updates");
+    ReportLatencies("place torch", TimeEach(torches, [&](const Sample& s) {
+        SetBlock(propagator, s, BlockType::TORCH);
+    }));
+    ReportLatencies("break torch", TimeEach(torches, [&](const Sample& s) {
+        SetBlock(propagator, s, BlockType::AIR);
+    }));
+
+    PrintHeader("incremental sky updates");
+    ReportLatencies("place roof block", TimeEach(roofs, [&](const Sample& s) {
+        SetBlock(propagator, s, BlockType::STONE);
+    }));
+    ReportLatencies("break roof block", TimeEach(roofs, [&](const Sample& s) {
+        SetBlock(propagator, s, BlockType::AIR);
+    }));
+
+    PrintHeader("whole-chunk relight per change (baseline)");
+    std::vector<Sample> baselineSamples(torches.begin(), torches.begin() + 200);
+    ReportLatencies("place torch + relight chunk", TimeEach(baselineSamples, [&](const Sample& s) {
+        auto local = s.coord.toBlockCoord();
+        s.chunk->SetBlockId(local.x, local.y, local.z, static_cast<uint16_t>(BlockType::TORCH));
+        propagator.RelightChunk(s.chunk.get());
+    }));
+
+    auto stats = propagator.GetStats();
+    PrintHeader("propagator counters");
+    PrintRow("nodes added", static_cast<double>(stats.nodesAdded), "nodes");
+    PrintRow("nodes removed", static_cast<double>(stats.nodesRemoved), "nodes");
+
+    return 0;
+}
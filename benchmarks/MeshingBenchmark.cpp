@@ -0,0 +1,202 @@
+/**
+ * @file MeshingBenchmark.cpp
+ * @brief Compares naive and greedy chunk meshing (CPU only)
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * Meshes the inner chunks of a lit terrain area three ways: the float
+ * Vertex path (48-byte vertices plus indices), packed 8-byte vertices with
+ * one quad per face, and packed greedy quads. Reports vertices, bytes and
+ * milliseconds per chunk.
+ */
+
+#include "BenchmarkCommon.hpp"
+
+#include "blocks/Block.hpp"
+#include "blocks/BlockMeshGenerator.hpp"
+#include "world/Chunk.hpp"
+#include "world/LightPropagator.hpp"
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <unordered_map>
+
+using namespace VoxelCraft;
+using namespace VoxelCraft::Benchmark;
+
+namespace {
+
+    constexpr int32_t AREA_CHUNKS = 7;      // Inner 5x5 chunks have all neighbors
+    constexpr int32_t SEA_LEVEL = 62;
+    constexpr int REPETITIONS = 5;
+
+    using ChunkMap = std::unordered_map<ChunkCoord, std::shared_ptr<Chunk>>;
+
+    int32_t SurfaceHeight(int32_t x, int32_t z) {
+        double h = 64.0 +
+                   8.0 * std::sin(x * 0.045) * std::cos(z * 0.038) +
+                   4.0 * std::sin((x + z) * 0.11) +
+                   1.5 * std::cos(x * 0.31 - z * 0.27);
+        return static_cast<int32_t>(h);
+    }
+
+    void Set(Chunk& chunk, int32_t x, int32_t y, int32_t z, BlockType type) {
+        if (x < 0 || x >= 16 || z < 0 || z >= 16 || y < 0 || y >= 256) {
+            return;
+        }
+        chunk.SetBlockId(static_cast<uint8_t>(x), static_cast<uint8_t>(y), static_cast<uint8_t>(z),
+            static_cast<uint16_t>(type));
+    }
+
+    void GenerateChunk(Chunk& chunk, std::mt19937& rng) {
+        const ChunkCoord coord = chunk.GetCoord();
+
+        for (int32_t z = 0; z < 16; ++z) {
+            for (int32_t x = 0; x < 16; ++x) {
+                const int32_t height = SurfaceHeight(coord.x * 16 + x, coord.z * 16 + z);
+
+                for (int32_t y = 0; y <= std::max(height, SEA_LEVEL); ++y) {
+                    BlockType type = BlockType::STONE;
+                    if (y == 0) {
+                        type = BlockType::BEDROCK;
+                    } else if (y > height) {
+                        type = BlockType::WATER;
+                    } else if (y == height) {
+                        type = height >= SEA_LEVEL ? BlockType::GRASS_BLOCK : BlockType::DIRT;
+                    } else if (y + 4 > height) {
+                        type = BlockType::DIRT;
+                    } else if (rng() % 90 == 0) {
+                        type = BlockType::COAL_ORE;
+                    } else if (y < 40 && rng() % 150 == 0) {
+                        type = BlockType::IRON_ORE;
+                    }
+                    Set(chunk, x, y, z, type);
+                }
+            }
+        }
+
+        // A few trees so the surface is not a pure heightfield
+        for (int tree = 0; tree < 3; ++tree) {
+            const int32_t x = 2 + static_cast<int32_t>(rng() % 12);
+            const int32_t z = 2 + static_cast<int32_t>(rng() % 12);
+            const int32_t base = SurfaceHeight(coord.x * 16 + x, coord.z * 16 + z) + 1;
+            if (base <= SEA_LEVEL) {
+                continue;
+            }
+
+            for (int32_t dy = 3; dy <= 5; ++dy) {
+                for (int32_t dz = -2; dz <= 2; ++dz) {
+                    for (int32_t dx = -2; dx <= 2; ++dx) {
+                        if (std::abs(dx) + std::abs(dz) <= (dy == 5 ? 1 : 3)) {
+                            Set(chunk, x + dx, base + dy, z + dz, BlockType::OAK_LEAVES);
+                        }
+                    }
+                }
+            }
+            for (int32_t dy = 0; dy < 5; ++dy) {
+                Set(chunk, x, base + dy, z, BlockType::OAK_LOG);
+            }
+        }
+    }
+
+    struct Result {
+        double vertices = 0.0;
+        double bytes = 0.0;
+        double milliseconds = 0.0;
+    };
+
+    void PrintResult(const char* name, const Result& result, const Result& baseline) {
+        PrintHeader(name);
+        PrintRow("vertices per chunk", result.vertices, "");
+        PrintRow("bytes per chunk", result.bytes, "B");
+        PrintRow("time per chunk", result.milliseconds, "ms");
+        PrintRow("memory vs float naive", baseline.bytes / std::max(result.bytes, 1.0), "x smaller");
+    }
+
+} // namespace
+
+int main() {
+    std::printf("Meshing benchmark: %dx%d terrain chunks, inner %dx%d meshed\n",
+        AREA_CHUNKS, AREA_CHUNKS, AREA_CHUNKS - 2, AREA_CHUNKS - 2);
+
+    ChunkMap chunks;
+    std::mt19937 rng(2024);
+    for (int32_t cz = 0; cz < AREA_CHUNKS; ++cz) {
+        for (int32_t cx = 0; cx < AREA_CHUNKS; ++cx) {
+            auto chunk = std::make_shared<Chunk>(ChunkCoord(cx, cz));
+            GenerateChunk(*chunk, rng);
+            chunks[ChunkCoord(cx, cz)] = chunk;
+        }
+    }
+
+    LightPropagator propagator([&chunks](const ChunkCoord& coord) -> std::shared_ptr<Chunk> {
+        auto it = chunks.find(coord);
+        return it != chunks.end() ? it->second : nullptr;
+    });
+    for (auto& pair : chunks) {
+        propagator.RelightChunk(pair.second.get());
+    }
+
+    std::vector<std::pair<const Chunk*, ChunkMeshNeighbors>> targets;
+    for (int32_t cz = 1; cz < AREA_CHUNKS - 1; ++cz) {
+        for (int32_t cx = 1; cx < AREA_CHUNKS - 1; ++cx) {
+            ChunkMeshNeighbors neighbors;
+            for (int dz = -1; dz <= 1; ++dz) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    neighbors.chunks[ChunkMeshNeighbors::Index(dx, dz)] = chunks[ChunkCoord(cx + dx, cz + dz)].get();
+                }
+            }
+            targets.emplace_back(chunks[ChunkCoord(cx, cz)].get(), neighbors);
+        }
+    }
+    const double chunkCount = static_cast<double>(targets.size());
+
+    BlockMeshGenerator generator;
+    generator.Initialize();
+
+    // Float vertices, one quad per face
+    Result floatNaive;
+    {
+        size_t vertices = 0;
+        size_t bytes = 0;
+        double seconds = MeasureBestSeconds(REPETITIONS, [&]() {
+            vertices = 0;
+            bytes = 0;
+            for (const auto& target : targets) {
+                BlockMesh mesh = generator.GenerateChunkMesh(target.first, target.second);
+                vertices += mesh.vertices.size();
+                bytes += mesh.vertices.size() * sizeof(Vertex) + mesh.indices.size() * sizeof(unsigned int);
+            }
+        });
+        floatNaive = { static_cast<double>(vertices) / chunkCount, static_cast<double>(bytes) / chunkCount,
+            seconds * 1e3 / chunkCount };
+    }
+
+    auto runPacked = [&](MeshingMode mode) {
+        PackedChunkMesh mesh;
+        size_t vertices = 0;
+        double seconds = MeasureBestSeconds(REPETITIONS, [&]() {
+            vertices = 0;
+            for (const auto& target : targets) {
+                generator.GenerateChunkMesh(target.first, mode, target.second, mesh);
+                vertices += mesh.GetVertexCount();
+            }
+        });
+        const double verticesPerChunk = static_cast<double>(vertices) / chunkCount;
+        return Result{ verticesPerChunk, verticesPerChunk * sizeof(PackedVertex), seconds * 1e3 / chunkCount };
+    };
+
+    Result packedNaive = runPacked(MeshingMode::NAIVE);
+    Result packedGreedy = runPacked(MeshingMode::GREEDY);
+
+    PrintResult("naive, float Vertex (48 B) + indices", floatNaive, floatNaive);
+    PrintResult("naive, PackedVertex (8 B)", packedNaive, floatNaive);
+    PrintResult("greedy, PackedVertex (8 B)", packedGreedy, floatNaive);
+
+    PrintHeader("greedy vs packed naive");
+    PrintRow("quad reduction", packedNaive.vertices / std::max(packedGreedy.vertices, 1.0), "x");
+    PrintRow("texture layers", static_cast<double>(generator.GetTextureLayers().size()), "");
+
+    return 0;
+}
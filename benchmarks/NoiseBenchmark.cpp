@@ -0,0 +1,299 @@
+/**
+ * @file NoiseBenchmark.cpp
+ * @brief Noise throughput: per-point GetNoise vs. batch grid kernels
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * Terrain generation samples 2D noise once per column (16x16 per chunk)
+ * and 3D noise once per voxel (16x16x16 per section). For every noise
+ * type this fills the same chunk grids through:
+ *
+ *   GetNoise      one call per sample, the way TerrainGenerator samples
+ *   cached        GetNoise with the coordinate cache on, cold then warm
+ *                 (2D Perlin and Fractal only, to show what it costs)
+ *   batch scalar  FillGrid2D / FillGrid3D with the one-lane kernels
+ *   batch SSE4.1  the same, four lanes (if the CPU has it)
+ *   batch AVX2    the same, eight lanes (if the CPU has it)
+ *
+ * Throughput is reported in Mnoise/s (millions of samples per second).
+ * Before timing, every batch level is checked to be bit-identical to
+ * GetNoise for several seeds, on chunk grids and on odd-sized grids and
+ * point lists that exercise the partial-vector tails.
+ *
+ * Usage: NoiseBenchmark [chunks] [repetitions]
+ */
+
+#include "BenchmarkCommon.hpp"
+
+#include "world/NoiseGenerator.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace VoxelCraft;
+using namespace VoxelCraft::Benchmark;
+
+namespace {
+
+    constexpr int CHUNK_SIZE = 16;
+    constexpr int SEEDS[] = {1, 1337, -987654};
+
+    struct TypeCase {
+        NoiseType type;
+        const char* name;
+    };
+
+    constexpr TypeCase TYPES[] = {
+        {NoiseType::Perlin, "Perlin"},
+        {NoiseType::Simplex, "Simplex"},
+        {NoiseType::Value, "Value"},
+        {NoiseType::Worley, "Worley"},
+        {NoiseType::White, "White"},
+        {NoiseType::Fractal, "Fractal x4"},
+        {NoiseType::Ridged, "Ridged x4"},
+        {NoiseType::Billow, "Billow x4"},
+        {NoiseType::Hybrid, "Hybrid x4"}
+    };
+
+    const char* LevelName(NoiseSimdLevel level) {
+        switch (level) {
+            case NoiseSimdLevel::AVX2:  return "AVX2";
+            case NoiseSimdLevel::SSE41: return "SSE4.1";
+            default:                    return "scalar";
+        }
+    }
+
+    std::vector<NoiseSimdLevel> SupportedLevels() {
+        std::vector<NoiseSimdLevel> levels = {NoiseSimdLevel::Scalar};
+        if (NoiseGenerator::GetSupportedSimdLevel() >= NoiseSimdLevel::SSE41) {
+            levels.push_back(NoiseSimdLevel::SSE41);
+        }
+        if (NoiseGenerator::GetSupportedSimdLevel() >= NoiseSimdLevel::AVX2) {
+            levels.push_back(NoiseSimdLevel::AVX2);
+        }
+        return levels;
+    }
+
+    std::unique_ptr<NoiseGenerator> MakeGenerator(NoiseType type, int seed) {
+        NoiseConfig config = NoiseGeneratorFactory::GetDefaultConfig(type, seed);
+        config.frequency = 0.0173f;
+        return NoiseGeneratorFactory::CreateGenerator(config);
+    }
+
+    std::string Describe(NoiseType type, int seed, NoiseSimdLevel level, const char* what) {
+        for (const TypeCase& entry : TYPES) {
+            if (entry.type == type) {
+                return std::string(entry.name) + " seed " + std::to_string(seed) + " " + LevelName(level) + " " + what;
+            }
+        }
+        return what;
+    }
+
+    /**
+     * @brief Compare every batch entry point against per-point GetNoise
+     * @return Empty on success, otherwise what differed
+     */
+    std::string CheckBitIdentical(NoiseType type, int seed) {
+        auto generator = MakeGenerator(type, seed);
+
+        struct GridShape { float x, y, z, step; int width, height, depth; };
+        const GridShape shapes[] = {
+            {-37.0f * CHUNK_SIZE, 0.0f, 12.0f * CHUNK_SIZE, 1.0f, 16, 16, 16},
+            {-3.25f, -70.5f, 1021.75f, 0.37f, 13, 7, 5},
+            {100003.0f, 64.0f, -250001.0f, 1.0f, 3, 2, 9}
+        };
+
+        for (NoiseSimdLevel level : SupportedLevels()) {
+            generator->SetSimdLevel(level);
+
+            for (const GridShape& s : shapes) {
+                const size_t count2D = static_cast<size_t>(s.width) * static_cast<size_t>(s.height);
+                std::vector<float> batch(count2D), expected(count2D);
+                generator->FillGrid2D(batch.data(), s.x, s.z, s.step, s.width, s.height);
+                for (int j = 0; j < s.height; ++j) {
+                    for (int i = 0; i < s.width; ++i) {
+                        expected[static_cast<size_t>(j * s.width + i)] =
+                            generator->GetNoise(s.x + static_cast<float>(i) * s.step, s.z + static_cast<float>(j) * s.step);
+                    }
+                }
+                if (std::memcmp(batch.data(), expected.data(), count2D * sizeof(float)) != 0) {
+                    return Describe(type, seed, level, "FillGrid2D");
+                }
+
+                const size_t count3D = count2D * static_cast<size_t>(s.depth);
+                batch.assign(count3D, 0.0f);
+                expected.assign(count3D, 0.0f);
+                generator->FillGrid3D(batch.data(), s.x, s.y, s.z, s.step, s.width, s.height, s.depth);
+                for (int j = 0; j < s.height; ++j) {
+                    for (int k = 0; k < s.depth; ++k) {
+                        for (int i = 0; i < s.width; ++i) {
+                            expected[static_cast<size_t>((j * s.depth + k) * s.width + i)] =
+                                generator->GetNoise(s.x + static_cast<float>(i) * s.step,
+                                                    s.y + static_cast<float>(j) * s.step,
+                                                    s.z + static_cast<float>(k) * s.step);
+                        }
+                    }
+                }
+                if (std::memcmp(batch.data(), expected.data(), count3D * sizeof(float)) != 0) {
+                    return Describe(type, seed, level, "FillGrid3D");
+                }
+            }
+
+            // Scattered points, count not a multiple of any vector width
+            const size_t points = 37;
+            std::vector<float> xs(points), ys(points), zs(points), batch(points), expected(points);
+            for (size_t i = 0; i < points; ++i) {
+                xs[i] = std::sin(static_cast<float>(i) * 1.7f) * 900.0f;
+                ys[i] = static_cast<float>(i) * 3.3f - 60.0f;
+                zs[i] = std::cos(static_cast<float>(i) * 0.9f) * 1200.0f;
+            }
+            generator->GetNoiseBatch(xs.data(), zs.data(), points, batch.data());
+            for (size_t i = 0; i < points; ++i) {
+                expected[i] = generator->GetNoise(xs[i], zs[i]);
+            }
+            if (std::memcmp(batch.data(), expected.data(), points * sizeof(float)) != 0) {
+                return Describe(type, seed, level, "GetNoiseBatch 2D");
+            }
+            generator->GetNoiseBatch(xs.data(), ys.data(), zs.data(), points, batch.data());
+            for (size_t i = 0; i < points; ++i) {
+                expected[i] = generator->GetNoise(xs[i], ys[i], zs[i]);
+            }
+            if (std::memcmp(batch.data(), expected.data(), points * sizeof(float)) != 0) {
+                return Describe(type, seed, level, "GetNoiseBatch 3D");
+            }
+        }
+        return std::string();
+    }
+
+    double Mnoise(size_t samples, double seconds) {
+        return static_cast<double>(samples) / seconds / 1e6;
+    }
+
+    /// Chunk origins on a square, as terrain generation would visit them
+    std::vector<std::pair<float, float>> ChunkOrigins(int chunks) {
+        std::vector<std::pair<float, float>> origins;
+        const int side = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(chunks))));
+        for (int c = 0; c < chunks; ++c) {
+            origins.emplace_back(static_cast<float>((c % side - side / 2) * CHUNK_SIZE),
+                                 static_cast<float>((c / side - side / 2) * CHUNK_SIZE));
+        }
+        return origins;
+    }
+
+    void Run2D(const TypeCase& entry, int chunks, int repetitions) {
+        auto generator = MakeGenerator(entry.type, 1337);
+        const auto origins = ChunkOrigins(chunks);
+        const size_t samples = origins.size() * CHUNK_SIZE * CHUNK_SIZE;
+        std::vector<float> out(CHUNK_SIZE * CHUNK_SIZE);
+
+        auto perPoint = [&]() {
+            for (const auto& origin : origins) {
+                for (int z = 0; z < CHUNK_SIZE; ++z) {
+                    for (int x = 0; x < CHUNK_SIZE; ++x) {
+                        out[static_cast<size_t>(z * CHUNK_SIZE + x)] =
+                            generator->GetNoise(origin.first + static_cast<float>(x), origin.second + static_cast<float>(z));
+                    }
+                }
+                DoNotOptimize(out[0]);
+            }
+        };
+
+        PrintHeader(std::string(entry.name) + " 2D, 16x16 columns");
+        const double pointSeconds = MeasureBestSeconds(repetitions, perPoint);
+        PrintRow("GetNoise", Mnoise(samples, pointSeconds), "Mnoise/s");
+
+        if (entry.type == NoiseType::Perlin || entry.type == NoiseType::Fractal) {
+            generator->SetCachingEnabled(true);
+            const double cold = MeasureSeconds(perPoint);
+            const double warm = MeasureBestSeconds(repetitions, perPoint);
+            generator->SetCachingEnabled(false);
+            PrintRow("GetNoise cached, cold", Mnoise(samples, cold), "Mnoise/s");
+            PrintRow("GetNoise cached, warm", Mnoise(samples, warm), "Mnoise/s");
+        }
+
+        double best = 0.0;
+        for (NoiseSimdLevel level : SupportedLevels()) {
+            generator->SetSimdLevel(level);
+            const double seconds = MeasureBestSeconds(repetitions, [&]() {
+                for (const auto& origin : origins) {
+                    generator->FillGrid2D(out.data(), origin.first, origin.second, 1.0f, CHUNK_SIZE, CHUNK_SIZE);
+                    DoNotOptimize(out[0]);
+                }
+            });
+            PrintRow(std::string("batch ") + LevelName(level), Mnoise(samples, seconds), "Mnoise/s");
+            best = std::max(best, Mnoise(samples, seconds));
+        }
+        PrintRow("best batch vs GetNoise", best / Mnoise(samples, pointSeconds), "x");
+    }
+
+    void Run3D(const TypeCase& entry, int chunks, int repetitions) {
+        auto generator = MakeGenerator(entry.type, 1337);
+        // One 16^3 section per chunk keeps the 3D run comparable in length
+        const auto origins = ChunkOrigins(std::max(1, chunks / 4));
+        const size_t samples = origins.size() * CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE;
+        std::vector<float> out(CHUNK_SIZE * CHUNK_SIZE * CHUNK_SIZE);
+
+        PrintHeader(std::string(entry.name) + " 3D, 16x16x16 sections");
+        const double pointSeconds = MeasureBestSeconds(repetitions, [&]() {
+            for (const auto& origin : origins) {
+                for (int y = 0; y < CHUNK_SIZE; ++y) {
+                    for (int z = 0; z < CHUNK_SIZE; ++z) {
+                        for (int x = 0; x < CHUNK_SIZE; ++x) {
+                            out[static_cast<size_t>((y * CHUNK_SIZE + z) * CHUNK_SIZE + x)] =
+                                generator->GetNoise(origin.first + static_cast<float>(x), 64.0f + static_cast<float>(y),
+                                                    origin.second + static_cast<float>(z));
+                        }
+                    }
+                }
+                DoNotOptimize(out[0]);
+            }
+        });
+        PrintRow("GetNoise", Mnoise(samples, pointSeconds), "Mnoise/s");
+
+        double best = 0.0;
+        for (NoiseSimdLevel level : SupportedLevels()) {
+            generator->SetSimdLevel(level);
+            const double seconds = MeasureBestSeconds(repetitions, [&]() {
+                for (const auto& origin : origins) {
+                    generator->FillGrid3D(out.data(), origin.first, 64.0f, origin.second, 1.0f,
+                                          CHUNK_SIZE, CHUNK_SIZE, CHUNK_SIZE);
+                    DoNotOptimize(out[0]);
+                }
+            });
+            PrintRow(std::string("batch ") + LevelName(level), Mnoise(samples, seconds), "Mnoise/s");
+            best = std::max(best, Mnoise(samples, seconds));
+        }
+        PrintRow("best batch vs GetNoise", best / Mnoise(samples, pointSeconds), "x");
+    }
+
+}
+
+int main(int argc, char** argv) {
+    const int chunks = argc > 1 ? std::max(1, std::atoi(argv[1])) : 64;
+    const int repetitions = argc > 2 ? std::max(1, std::atoi(argv[2])) : 5;
+
+    std::printf("Noise: %d chunks per run, best of %d, CPU supports %s\n", chunks, repetitions,
+                LevelName(NoiseGenerator::GetSupportedSimdLevel()));
+
+    for (const TypeCase& entry : TYPES) {
+        for (int seed : SEEDS) {
+            const std::string failure = CheckBitIdentical(entry.type, seed);
+            if (!failure.empty()) {
+                std::printf("FAILED: %s differs from GetNoise\n", failure.c_str());
+                return 1;
+            }
+        }
+    }
+    std::printf("  every batch level is bit-identical to GetNoise (%zu types, %zu seeds)\n",
+                sizeof(TYPES) / sizeof(TYPES[0]), sizeof(SEEDS) / sizeof(SEEDS[0]));
+
+    for (const TypeCase& entry : TYPES) {
+        Run2D(entry, chunks, repetitions);
+        Run3D(entry, chunks, repetitions);
+    }
+    return 0;
+}
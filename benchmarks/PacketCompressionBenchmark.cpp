@@ -0,0 +1,411 @@
+/**
+ * @file PacketCompressionBenchmark.cpp
+ * @brief Bytes on the wire and CPU cost per chunk sent, per packet codec
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * Serializes two terrain areas far apart: the first trains the chunk
+ * dictionary (as it would be trained offline from saved worlds and shipped
+ * with the server), the second is what gets streamed. Every chunk goes out
+ * as a ChunkDataPacket frame.
+ *
+ *   raw            no compression
+ *   rle            the previous byte-pair RLE of Packet::Compress, re-implemented here
+ *   <codec>        PacketCompression at the codec's fast level
+ *   <codec> + dict the same with the trained dictionary
+ *
+ * Reported per chunk: bytes on the wire (transport length prefix + packet
+ * header + payload), ratio against raw, compress time (network worker
+ * CPU) and decompress + parse time (client CPU). The last table is the
+ * game thread's cost per chunk send when compressing inline versus
+ * posting to the NetworkWorker.
+ *
+ * Checks: every round trip, the size threshold, and HANDSHAKE
+ * negotiation (codec fallback, dictionary sent only to a client that
+ * lacks it). Any failure prints FAILED and exits with 1.
+ *
+ * Usage: PacketCompressionBenchmark [chunks per side]
+ */
+
+#include "BenchmarkCommon.hpp"
+
+#include "blocks/Block.hpp"
+#include "network/NetworkWorker.hpp"
+#include "network/Packet.hpp"
+#include "network/PacketCompression.hpp"
+#include "world/Chunk.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <memory>
+
+using namespace VoxelCraft;
+using namespace VoxelCraft::Benchmark;
+
+namespace {
+
+    constexpr int32_t SEA_LEVEL = 62;
+    constexpr int32_t STREAM_OFFSET = 4096;     // Chunks between the training and streamed areas
+    constexpr size_t TRANSPORT_PREFIX = 4;      // ServerTransport frame length
+    constexpr int REPETITIONS = 3;
+
+    bool g_failed = false;
+
+    void Check(bool condition, const char* what) {
+        if (!condition) {
+            std::printf("  FAILED: %s\n", what);
+            g_failed = true;
+        }
+    }
+
+    int32_t SurfaceHeight(int32_t x, int32_t z) {
+        double h = 64.0 +
+                   10.0 * std::sin(x * 0.021) * std::cos(z * 0.017) +
+                   5.0 * std::sin((x - z) * 0.063) +
+                   2.0 * std::cos(x * 0.29 + z * 0.23);
+        return static_cast<int32_t>(h);
+    }
+
+    std::vector<uint8_t> GenerateChunk(const ChunkCoord& coord) {
+        auto chunk = std::make_shared<Chunk>(coord);
+
+        for (int32_t z = 0; z < 16; ++z) {
+            for (int32_t x = 0; x < 16; ++x) {
+                const int32_t wx = coord.x * 16 + x;
+                const int32_t wz = coord.z * 16 + z;
+                const int32_t height = SurfaceHeight(wx, wz);
+
+                for (int32_t y = 0; y <= std::max(height, SEA_LEVEL); ++y) {
+                    BlockType type = BlockType::STONE;
+                    const uint32_t noise = (static_cast<uint32_t>(wx) * 73856093u) ^ (static_cast<uint32_t>(y) * 19349663u) ^ (static_cast<uint32_t>(wz) * 83492791u);
+                    if (y == 0 || (y < 4 && noise % 3 == 0)) {
+                        type = BlockType::BEDROCK;
+                    } else if (y > height) {
+                        type = BlockType::WATER;
+                    } else if (y == height) {
+                        type = height >= SEA_LEVEL ? BlockType::GRASS_BLOCK : BlockType::DIRT;
+                    } else if (y + 4 > height) {
+                        type = BlockType::DIRT;
+                    } else if (noise % 89 == 0) {
+                        type = BlockType::COAL_ORE;
+                    } else if (y < 40 && noise % 151 == 0) {
+                        type = BlockType::IRON_ORE;
+                    } else if (std::sin(wx * 0.19) + std::sin(y * 0.23) + std::sin(wz * 0.21) > 2.2) {
+                        type = BlockType::AIR; // Tunnels keep the underground sections non-uniform
+                    }
+                    chunk->SetBlockId(static_cast<uint8_t>(x), static_cast<uint8_t>(y), static_cast<uint8_t>(z),
+                        static_cast<uint16_t>(type));
+                }
+            }
+        }
+
+        return chunk->Serialize();
+    }
+
+    std::vector<std::vector<uint8_t>> GenerateArea(int32_t origin, int32_t side) {
+        std::vector<std::vector<uint8_t>> chunks;
+        for (int32_t z = 0; z < side; ++z) {
+            for (int32_t x = 0; x < side; ++x) {
+                chunks.push_back(GenerateChunk(ChunkCoord(origin + x, origin + z)));
+            }
+        }
+        return chunks;
+    }
+
+    std::shared_ptr<ChunkDataPacket> MakePacket(size_t index, const std::vector<uint8_t>& data) {
+        auto packet = std::make_shared<ChunkDataPacket>(static_cast<int32_t>(index), 0, true, 0xFFFF, data);
+        packet->SetCompressed(false);
+        packet->Serialize();
+        return packet;
+    }
+
+    // Previous Packet::Compress: (value, count) byte pairs, abandoned once it stops shrinking
+    std::vector<uint8_t> LegacyRleCompress(std::span<const uint8_t> data) {
+        std::vector<uint8_t> out;
+        size_t i = 0;
+        while (i < data.size() && out.size() < data.size()) {
+            const uint8_t current = data[i];
+            size_t count = 1;
+            while (i + count < data.size() && data[i + count] == current && count < 255) {
+                count++;
+            }
+            out.push_back(current);
+            out.push_back(static_cast<uint8_t>(count));
+            i += count;
+        }
+        return out;
+    }
+
+    std::vector<uint8_t> LegacyRleDecompress(const std::vector<uint8_t>& data) {
+        std::vector<uint8_t> out;
+        for (size_t i = 0; i + 1 < data.size(); i += 2) {
+            out.insert(out.end(), data[i + 1], data[i]);
+        }
+        return out;
+    }
+
+    struct Result {
+        double wireBytes = 0.0;             // Per chunk
+        double compressMicros = 0.0;
+        double decompressMicros = 0.0;
+    };
+
+    void Report(const std::string& label, const Result& result, double rawWireBytes) {
+        PrintHeader(label);
+        PrintRow("bytes on the wire per chunk", result.wireBytes, "bytes");
+        PrintRow("ratio vs raw", rawWireBytes / result.wireBytes, "x");
+        PrintRow("compress per chunk (network worker)", result.compressMicros, "us");
+        PrintRow("decompress + parse per chunk (client)", result.decompressMicros, "us");
+    }
+
+    Result RunRaw(const std::vector<std::vector<uint8_t>>& chunks) {
+        Result result;
+        uint64_t wire = 0;
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            wire += TRANSPORT_PREFIX + MakePacket(i, chunks[i])->GetBuffer().Size();
+        }
+        result.wireBytes = static_cast<double>(wire) / static_cast<double>(chunks.size());
+
+        std::vector<std::shared_ptr<ChunkDataPacket>> packets;
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            packets.push_back(MakePacket(i, chunks[i]));
+        }
+        const double seconds = MeasureBestSeconds(REPETITIONS, [&]() {
+            for (size_t i = 0; i < packets.size(); ++i) {
+                auto parsed = Packet::FromBytes(packets[i]->GetBuffer().Span());
+                DoNotOptimize(parsed);
+            }
+        });
+        result.decompressMicros = seconds * 1e6 / static_cast<double>(chunks.size());
+        return result;
+    }
+
+    Result RunLegacyRle(const std::vector<std::vector<uint8_t>>& chunks) {
+        std::vector<std::shared_ptr<ChunkDataPacket>> packets;
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            packets.push_back(MakePacket(i, chunks[i]));
+        }
+
+        std::vector<std::vector<uint8_t>> compressed(chunks.size());
+        uint64_t wire = 0;
+        const double compressSeconds = MeasureBestSeconds(REPETITIONS, [&]() {
+            wire = 0;
+            for (size_t i = 0; i < packets.size(); ++i) {
+                std::span<const uint8_t> payload = packets[i]->GetPayload();
+                compressed[i] = LegacyRleCompress(payload);
+                // Kept uncompressed when RLE does not shrink it
+                wire += TRANSPORT_PREFIX + PacketHeader::WIRE_SIZE + std::min(compressed[i].size(), payload.size());
+            }
+        });
+
+        bool intact = true;
+        const double decompressSeconds = MeasureBestSeconds(REPETITIONS, [&]() {
+            for (size_t i = 0; i < packets.size(); ++i) {
+                std::span<const uint8_t> payload = packets[i]->GetPayload();
+                if (compressed[i].size() < payload.size()) {
+                    std::vector<uint8_t> raw = LegacyRleDecompress(compressed[i]);
+                    intact &= raw.size() == payload.size();
+                }
+            }
+        });
+        Check(intact, "rle round trip");
+
+        Result result;
+        result.wireBytes = static_cast<double>(wire) / static_cast<double>(chunks.size());
+        result.compressMicros = compressSeconds * 1e6 / static_cast<double>(chunks.size());
+        result.decompressMicros = decompressSeconds * 1e6 / static_cast<double>(chunks.size());
+        return result;
+    }
+
+    Result RunCodec(const PacketCompressionSettings& settings, const std::vector<std::vector<uint8_t>>& chunks) {
+        std::vector<std::shared_ptr<ChunkDataPacket>> packets(chunks.size());
+        uint64_t wire = 0;
+        double compressSeconds = 1e30;
+
+        // Compress needs a fresh uncompressed packet each repetition; only Compress is timed
+        for (int repetition = 0; repetition < REPETITIONS; ++repetition) {
+            for (size_t i = 0; i < chunks.size(); ++i) {
+                packets[i] = MakePacket(i, chunks[i]);
+            }
+            wire = 0;
+            const double seconds = MeasureSeconds([&]() {
+                for (auto& packet : packets) {
+                    packet->Compress(settings);
+                }
+            });
+            compressSeconds = std::min(compressSeconds, seconds);
+            for (const auto& packet : packets) {
+                wire += TRANSPORT_PREFIX + packet->GetBuffer().Size();
+            }
+        }
+
+        bool intact = true;
+        const double decompressSeconds = MeasureBestSeconds(REPETITIONS, [&]() {
+            for (size_t i = 0; i < packets.size(); ++i) {
+                auto parsed = std::dynamic_pointer_cast<ChunkDataPacket>(Packet::FromBytes(packets[i]->GetBuffer().Span()));
+                intact &= parsed && parsed->GetData() == chunks[i];
+            }
+        });
+        Check(intact, "codec round trip");
+
+        Result result;
+        result.wireBytes = static_cast<double>(wire) / static_cast<double>(chunks.size());
+        result.compressMicros = compressSeconds * 1e6 / static_cast<double>(chunks.size());
+        result.decompressMicros = decompressSeconds * 1e6 / static_cast<double>(chunks.size());
+        return result;
+    }
+
+    void CheckNegotiation(uint32_t dictionaryId) {
+        PacketCompressionSettings preferred;
+        preferred.codec = PacketCodec::ZSTD;
+        preferred.dictionaryId = dictionaryId;
+
+        // A client that can only do LZ4 and has never seen the dictionary
+        PacketBuffer offerBytes = PacketBuffer::Allocate(16);
+        offerBytes.WriteUInt8(1u << static_cast<uint8_t>(PacketCodec::LZ4));
+        offerBytes.WriteUInt8(0);
+        PacketReader offerReader(offerBytes.Span());
+        PacketCompressionOffer offer;
+        Check(PacketCompression::ReadOffer(offerReader, offer), "read offer");
+
+        PacketCompressionSettings settings = PacketCompression::Negotiate(offer, preferred);
+        Check(settings.codec == PacketCodec::LZ4, "negotiate falls back to a codec the client has");
+        Check(settings.dictionaryId == dictionaryId, "negotiate keeps the dictionary");
+
+        PacketBuffer withDictionary = PacketBuffer::Allocate(64);
+        PacketCompression::WriteSettings(settings, !offer.HasDictionary(settings.dictionaryId), withDictionary);
+        PacketReader settingsReader(withDictionary.Span());
+        PacketCompressionSettings received;
+        Check(PacketCompression::ReadSettings(settingsReader, received), "read settings");
+        Check(received.codec == settings.codec && received.dictionaryId == dictionaryId, "settings round trip");
+
+        // A client that already has it gets only the id
+        PacketBuffer ownOffer = PacketBuffer::Allocate(64);
+        PacketCompression::WriteOffer(ownOffer);
+        PacketReader ownReader(ownOffer.Span());
+        Check(PacketCompression::ReadOffer(ownReader, offer) && offer.HasDictionary(dictionaryId), "offer lists dictionary");
+        PacketBuffer withoutDictionary = PacketBuffer::Allocate(64);
+        PacketCompression::WriteSettings(settings, !offer.HasDictionary(settings.dictionaryId), withoutDictionary);
+
+        // No common codec: compression off
+        offer.codecs = 0;
+        Check(!PacketCompression::Negotiate(offer, preferred).IsEnabled(), "no common codec disables compression");
+
+        PrintHeader("HANDSHAKE negotiation");
+        PrintRow("reply with dictionary", static_cast<double>(withDictionary.Size()), "bytes");
+        PrintRow("reply when client has it", static_cast<double>(withoutDictionary.Size()), "bytes");
+    }
+
+    void CheckThreshold() {
+        PacketCompressionSettings settings;
+        settings.codec = PacketCodec::LZ4;
+        settings.threshold = 256;
+
+        std::vector<uint8_t> small(200, 0);
+        PacketBuffer out;
+        Check(!PacketCompression::Compress(settings, small, out) && !out, "payload below threshold is sent as is");
+
+        std::vector<uint8_t> large(4096, 0);
+        Check(PacketCompression::Compress(settings, large, out) && out.Size() < large.size(), "payload above threshold is compressed");
+    }
+
+    void RunGameThreadCost(const PacketCompressionSettings& settings, const std::vector<std::vector<uint8_t>>& chunks) {
+        // Inline: the game thread serializes and compresses every chunk itself
+        const double inlineSeconds = MeasureBestSeconds(REPETITIONS, [&]() {
+            for (size_t i = 0; i < chunks.size(); ++i) {
+                auto packet = MakePacket(i, chunks[i]);
+                packet->Compress(settings);
+                DoNotOptimize(packet);
+            }
+        });
+
+        // Worker: the game thread serializes and posts; compression happens on the network worker
+        NetworkWorker worker;
+        worker.Start();
+        double postSeconds = 1e30;
+        for (int repetition = 0; repetition < REPETITIONS; ++repetition) {
+            const double seconds = MeasureSeconds([&]() {
+                for (size_t i = 0; i < chunks.size(); ++i) {
+                    auto packet = MakePacket(i, chunks[i]);
+                    worker.Post([packet, &settings]() { packet->Compress(settings); });
+                }
+            });
+            postSeconds = std::min(postSeconds, seconds);
+            while (!worker.IsIdle()) {
+                std::this_thread::yield();
+            }
+        }
+        const NetworkWorkerStats stats = worker.GetStats();
+        worker.Stop();
+
+        PrintHeader("game thread cost per chunk send (" + std::string(PacketCompression::GetName(settings.codec)) + " + dict)");
+        PrintRow("compress inline", inlineSeconds * 1e6 / static_cast<double>(chunks.size()), "us");
+        PrintRow("post to network worker", postSeconds * 1e6 / static_cast<double>(chunks.size()), "us");
+        PrintRow("worker busy per chunk", static_cast<double>(stats.busyNanoseconds) * 1e-3 / static_cast<double>(stats.tasksExecuted), "us");
+        Check(stats.tasksExecuted == stats.tasksPosted, "worker ran every task");
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int32_t side = argc > 1 ? std::max(2, std::atoi(argv[1])) : 16;
+    std::printf("Packet compression benchmark: %dx%d chunks streamed, %dx%d trained\n", side, side, side, side);
+
+    const auto training = GenerateArea(0, side);
+    const auto streamed = GenerateArea(STREAM_OFFSET, side);
+
+    std::vector<std::span<const uint8_t>> samples(training.begin(), training.end());
+    std::shared_ptr<const PacketDictionary> dictionary;
+    const double trainSeconds = MeasureSeconds([&]() {
+        dictionary = std::make_shared<const PacketDictionary>(PacketDictionary::Train(samples));
+    });
+    const uint32_t dictionaryId = PacketCompression::RegisterDictionary(dictionary);
+
+    uint64_t rawBytes = 0;
+    for (const auto& chunk : streamed) {
+        rawBytes += chunk.size();
+    }
+    PrintRow("average serialized chunk", static_cast<double>(rawBytes) / static_cast<double>(streamed.size()), "bytes");
+    PrintRow("dictionary size", static_cast<double>(dictionary->GetSize()), "bytes");
+    PrintRow("dictionary training", trainSeconds * 1e3, "ms");
+
+    const Result raw = RunRaw(streamed);
+    Report("raw", raw, raw.wireBytes);
+    Report("rle (previous)", RunLegacyRle(streamed), raw.wireBytes);
+
+    PacketCompressionSettings fastest;
+    for (PacketCodec codec : { PacketCodec::LZ4, PacketCodec::ZSTD, PacketCodec::DEFLATE }) {
+        if (!PacketCompression::IsAvailable(codec)) {
+            std::printf("\n%s: not built into this binary\n", PacketCompression::GetName(codec));
+            continue;
+        }
+
+        PacketCompressionSettings settings;
+        settings.codec = codec;
+        Report(PacketCompression::GetName(codec), RunCodec(settings, streamed), raw.wireBytes);
+
+        settings.dictionaryId = dictionaryId;
+        const Result withDictionary = RunCodec(settings, streamed);
+        Report(std::string(PacketCompression::GetName(codec)) + " + dict", withDictionary, raw.wireBytes);
+        if (codec == PacketCodec::LZ4) {
+            fastest = settings;
+        }
+    }
+
+    RunGameThreadCost(fastest, streamed);
+    CheckThreshold();
+    CheckNegotiation(dictionaryId);
+
+    const PacketCompressionStats stats = PacketCompression::GetStats();
+    PrintHeader("PacketCompression::GetStats (all runs)");
+    PrintRow("compressions", static_cast<double>(stats.compressions), "");
+    PrintRow("skipped below threshold", static_cast<double>(stats.skippedBelowThreshold), "");
+    PrintRow("skipped without gain", static_cast<double>(stats.skippedNoGain), "");
+    PrintRow("failures", static_cast<double>(stats.failures), "");
+
+    if (g_failed) {
+        std::printf("\nFAILED\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,306 @@
+/**
+ * @file PathRequestBenchmark.cpp
+ * @brief Tick time with a horde of mobs chasing one player
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * One player walks a circle over rolling terrain with 2% pillars; hostile
+ * mobs spawned 8-36 blocks away chase it at 20 Hz. Each mob asks for a new
+ * path every 20 ticks (staggered) and steps one waypoint every 4 ticks.
+ * Every 10 ticks a pillar next to the player is placed or removed, which is
+ * reported to the service like ChunkSystem::SetBlock would.
+ *
+ *   per-mob     every mob owns a Pathfinding and searches inside the tick,
+ *               as Mob does today
+ *   service A*  PathRequestService on a worker pool, flow fields disabled:
+ *               per-tick budget and coalescing only
+ *   service     PathRequestService with flow fields for the chased player
+ *
+ * The tick time is the whole mob update including PathRequestService::Tick.
+ * With the service, the loop sleeps until the next 50 ms boundary like a
+ * server would, which is when the workers get to run on small machines.
+ * p99 is what the request targets; latency is the number of ticks between
+ * asking for a path and getting it.
+ *
+ * Usage: PathRequestBenchmark [ticks] [mobs]
+ */
+
+#include "BenchmarkCommon.hpp"
+
+#include "ai/PathRequestService.hpp"
+#include "core/WorkStealingPool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <random>
+#include <thread>
+
+using namespace VoxelCraft;
+using namespace VoxelCraft::Benchmark;
+
+namespace {
+
+    constexpr int WORLD_HALF = 128;
+    constexpr int TICK_MS = 50;
+    constexpr int REPATH_TICKS = 20;
+    constexpr int STEP_TICKS = 4;
+    constexpr int BLOCK_CHANGE_TICKS = 10;
+    constexpr float PLAYER_SPEED = 4.3f / 20.0f;    // Blocks per tick
+    constexpr float PLAYER_CIRCLE = 20.0f;
+
+    // Heights are atomics so workers can read while the tick places blocks
+    class Terrain {
+    public:
+        Terrain() : m_heights(static_cast<size_t>(WORLD_HALF * 2) * WORLD_HALF * 2) {
+            for (int z = -WORLD_HALF; z < WORLD_HALF; ++z) {
+                for (int x = -WORLD_HALF; x < WORLD_HALF; ++x) {
+                    double h = 64.0 + 4.0 * std::sin(x * 0.07) * std::cos(z * 0.053) + 2.0 * std::sin((x + z) * 0.031);
+                    int top = static_cast<int>(std::floor(h));
+                    if (IsPillar(x, z)) {
+                        top += 4;
+                    }
+                    m_heights[Index(x, z)].store(static_cast<int16_t>(top), std::memory_order_relaxed);
+                }
+            }
+        }
+
+        int GetBlock(int x, int y, int z) const {
+            if (y < 0) {
+                return 1;
+            }
+            if (x < -WORLD_HALF || x >= WORLD_HALF || z < -WORLD_HALF || z >= WORLD_HALF) {
+                return y < 256 ? 1 : 0;
+            }
+            return y <= m_heights[Index(x, z)].load(std::memory_order_relaxed) ? 1 : 0;
+        }
+
+        int GetHeight(int x, int z) const {
+            return m_heights[Index(x, z)].load(std::memory_order_relaxed);
+        }
+
+        void SetHeight(int x, int z, int height) {
+            m_heights[Index(x, z)].store(static_cast<int16_t>(height), std::memory_order_relaxed);
+        }
+
+        bool IsObstacle(int x, int z) const {
+            return IsPillar(x, z);
+        }
+
+    private:
+        std::vector<std::atomic<int16_t>> m_heights;
+
+        static size_t Index(int x, int z) {
+            return static_cast<size_t>(z + WORLD_HALF) * (WORLD_HALF * 2) + static_cast<size_t>(x + WORLD_HALF);
+        }
+
+        static bool IsPillar(int x, int z) {
+            uint32_t h = static_cast<uint32_t>(x) * 73856093u ^ static_cast<uint32_t>(z) * 19349663u;
+            h ^= h >> 13;
+            h *= 0x5bd1e995u;
+            h ^= h >> 15;
+            return (h % 100) < 2;
+        }
+    };
+
+    enum class Mode {
+        PER_MOB,
+        SERVICE_ASTAR,
+        SERVICE
+    };
+
+    struct Mob {
+        glm::vec3 position;
+        std::vector<glm::ivec3> path;
+        size_t waypoint = 0;
+        int nextRepath = 0;
+        bool waiting = false;
+        int requestedAt = 0;
+        std::unique_ptr<Pathfinding> pathfinding;
+    };
+
+    struct Result {
+        std::vector<double> tickMs;
+        std::vector<double> latencyTicks;
+        uint64_t pathsReceived = 0;
+        uint64_t emptyPaths = 0;
+        PathRequestService::Stats stats{};
+    };
+
+    glm::vec3 PlayerPosition(int tick) {
+        const float angle = static_cast<float>(tick) * PLAYER_SPEED / PLAYER_CIRCLE;
+        return glm::vec3(std::cos(angle) * PLAYER_CIRCLE, 70.0f, std::sin(angle) * PLAYER_CIRCLE);
+    }
+
+    Result Run(Mode mode, int ticks, int mobCount, WorkStealingPool* pool) {
+        Terrain terrain;
+        auto blockQuery = [&terrain](int x, int y, int z) { return terrain.GetBlock(x, y, z); };
+
+        PathRequestConfig config;
+        if (mode == Mode::SERVICE_ASTAR) {
+            config.flowFieldDemand = std::numeric_limits<float>::infinity();
+        }
+        std::unique_ptr<PathRequestService> service;
+        if (mode != Mode::PER_MOB) {
+            service = std::make_unique<PathRequestService>(blockQuery, pool, config);
+        }
+
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+        std::uniform_real_distribution<float> distance(8.0f, 36.0f);
+
+        std::vector<Mob> mobs(static_cast<size_t>(mobCount));
+        const glm::vec3 spawnCenter = PlayerPosition(0);
+        for (size_t i = 0; i < mobs.size(); ++i) {
+            Mob& mob = mobs[i];
+            float x;
+            float z;
+            do {
+                const float a = angle(rng);
+                const float d = distance(rng);
+                x = std::round(spawnCenter.x + std::cos(a) * d);
+                z = std::round(spawnCenter.z + std::sin(a) * d);
+            } while (terrain.IsObstacle(static_cast<int>(x), static_cast<int>(z)));
+            mob.position = glm::vec3(x, 120.0f, z);
+            mob.nextRepath = static_cast<int>(i % REPATH_TICKS);
+            if (mode == Mode::PER_MOB) {
+                mob.pathfinding = std::make_unique<Pathfinding>(blockQuery);
+            }
+        }
+
+        Result result;
+        result.tickMs.reserve(static_cast<size_t>(ticks));
+        std::vector<std::pair<int, int>> placed;    // Pillars placed by the player
+        std::uniform_int_distribution<int> offset(-12, 12);
+
+        auto tickStart = std::chrono::steady_clock::now();
+        for (int tick = 0; tick < ticks; ++tick) {
+            const glm::vec3 player = PlayerPosition(tick);
+
+            // Place or remove a pillar near the player (not timed)
+            if (tick % BLOCK_CHANGE_TICKS == 0) {
+                int x;
+                int z;
+                if (!placed.empty() && (tick / BLOCK_CHANGE_TICKS) % 2 == 0) {
+                    x = placed.back().first;
+                    z = placed.back().second;
+                    placed.pop_back();
+                    terrain.SetHeight(x, z, terrain.GetHeight(x, z) - 2);
+                } else {
+                    x = static_cast<int>(player.x) + offset(rng);
+                    z = static_cast<int>(player.z) + offset(rng);
+                    placed.emplace_back(x, z);
+                    terrain.SetHeight(x, z, terrain.GetHeight(x, z) + 2);
+                }
+                if (service) {
+                    service->OnBlockChanged(x, terrain.GetHeight(x, z), z);
+                }
+            }
+
+            const double seconds = MeasureSeconds([&]() {
+                for (size_t i = 0; i < mobs.size(); ++i) {
+                    Mob& mob = mobs[i];
+
+                    if (tick % STEP_TICKS == 0 && mob.waypoint + 1 < mob.path.size()) {
+                        mob.waypoint++;
+                        mob.position = glm::vec3(mob.path[mob.waypoint]);
+                    }
+
+                    if (tick < mob.nextRepath || mob.waiting) {
+                        continue;
+                    }
+                    mob.nextRepath = tick + REPATH_TICKS;
+
+                    if (mode == Mode::PER_MOB) {
+                        mob.path = mob.pathfinding->FindPath(mob.position, player);
+                        mob.waypoint = 0;
+                        result.pathsReceived++;
+                        result.emptyPaths += mob.path.empty() ? 1u : 0u;
+                        result.latencyTicks.push_back(0.0);
+                        continue;
+                    }
+
+                    mob.waiting = true;
+                    mob.requestedAt = tick;
+                    service->RequestPath(mob.position, player,
+                        [&result, &mob, &tick](PathRequestService::RequestId, const std::vector<glm::ivec3>& path) {
+                            mob.path = path;
+                            mob.waypoint = 0;
+                            mob.waiting = false;
+                            result.pathsReceived++;
+                            result.emptyPaths += path.empty() ? 1u : 0u;
+                            result.latencyTicks.push_back(static_cast<double>(tick - mob.requestedAt));
+                        });
+                }
+
+                if (service) {
+                    service->Tick();
+                }
+            });
+            result.tickMs.push_back(seconds * 1000.0);
+
+            // Workers run between ticks, as on a server waiting for the next one
+            tickStart += std::chrono::milliseconds(TICK_MS);
+            if (service) {
+                std::this_thread::sleep_until(tickStart);
+            }
+        }
+
+        if (service) {
+            result.stats = service->GetStats();
+        }
+        return result;
+    }
+
+    double Mean(const std::vector<double>& samples) {
+        double sum = 0.0;
+        for (double sample : samples) {
+            sum += sample;
+        }
+        return samples.empty() ? 0.0 : sum / static_cast<double>(samples.size());
+    }
+
+    void Print(const std::string& title, const Result& result, bool service) {
+        PrintHeader(title);
+        PrintRow("Tick p50", Percentile(result.tickMs, 50.0), "ms");
+        PrintRow("Tick p99", Percentile(result.tickMs, 99.0), "ms");
+        PrintRow("Tick max", Percentile(result.tickMs, 100.0), "ms");
+        PrintRow("Tick mean", Mean(result.tickMs), "ms");
+        PrintRow("Paths received", static_cast<double>(result.pathsReceived), "");
+        PrintRow("Empty paths", static_cast<double>(result.emptyPaths), "");
+        PrintRow("Latency p50", Percentile(result.latencyTicks, 50.0), "ticks");
+        PrintRow("Latency p99", Percentile(result.latencyTicks, 99.0), "ticks");
+        if (!service) {
+            return;
+        }
+        PrintRow("A* searches", static_cast<double>(result.stats.searches), "");
+        PrintRow("Flow fields built", static_cast<double>(result.stats.flowFields), "");
+        PrintRow("Flow field hits", static_cast<double>(result.stats.flowFieldHits), "");
+        PrintRow("Cache hits", static_cast<double>(result.stats.cacheHits), "");
+        PrintRow("Coalesced", static_cast<double>(result.stats.coalesced), "");
+        PrintRow("Invalidated", static_cast<double>(result.stats.invalidated), "");
+        PrintRow("Deferred (budget)", static_cast<double>(result.stats.deferred), "");
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int ticks = argc > 1 ? std::max(100, std::atoi(argv[1])) : 600;
+    const int mobCount = argc > 2 ? std::max(1, std::atoi(argv[2])) : 320;
+
+    WorkStealingPool pool;
+    pool.Initialize();
+
+    std::printf("Path request benchmark: %d mobs chasing one player, %d ticks at 20 Hz, %zu workers\n",
+                mobCount, ticks, pool.GetThreadCount());
+
+    Print("Per-mob FindPath in the tick", Run(Mode::PER_MOB, ticks, mobCount, nullptr), false);
+    Print("PathRequestService, A* only", Run(Mode::SERVICE_ASTAR, ticks, mobCount, &pool), true);
+    Print("PathRequestService, flow fields", Run(Mode::SERVICE, ticks, mobCount, &pool), true);
+
+    pool.Shutdown();
+    return 0;
+}
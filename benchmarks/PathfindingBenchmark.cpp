@@ -0,0 +1,291 @@
+/**
+ * @file PathfindingBenchmark.cpp
+ * @brief Paths per second at 16, 64 and 256 blocks
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * Rolling terrain cut into 48x48 rooms by 3-high walls with one 4-wide
+ * doorway per side, plus scattered 4-high pillars, so most long paths have
+ * to detour. Random start/goal pairs at each distance are solved by:
+ *
+ *   legacy        the previous open list (unordered_map scanned with
+ *                 min_element, a new neighbour vector per node)
+ *   flat          binary-heap A* on the per-thread node arena
+ *   hierarchical  portal-level plan over 16x16 chunk columns, refined per
+ *                 chunk; "cold" starts with an empty portal cache, "warm"
+ *                 repeats the same pairs with it filled
+ *
+ * All searches use the same movement rules. Path cost is compared with the
+ * flat A* result to show what the portal plan gives up in path quality.
+ *
+ * Usage: PathfindingBenchmark [pairs per distance]
+ */
+
+#include "BenchmarkCommon.hpp"
+
+#include "ai/Pathfinding.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <unordered_map>
+
+using namespace VoxelCraft;
+using namespace VoxelCraft::Benchmark;
+
+namespace {
+
+    constexpr int WORLD_HALF = 512;
+    constexpr int ROOM_SIZE = 48;
+    constexpr int MAX_NODES = 400 * 400;
+
+    class Terrain {
+    public:
+        Terrain() : m_heights(static_cast<size_t>(WORLD_HALF * 2) * WORLD_HALF * 2) {
+            for (int z = -WORLD_HALF; z < WORLD_HALF; ++z) {
+                for (int x = -WORLD_HALF; x < WORLD_HALF; ++x) {
+                    double h = 64.0 + 6.0 * std::sin(x * 0.05) * std::cos(z * 0.043) + 3.0 * std::sin((x + z) * 0.021);
+                    int top = static_cast<int>(std::floor(h));
+                    if (IsWall(x, z) || IsPillar(x, z)) {
+                        top += IsWall(x, z) ? 3 : 4;
+                    }
+                    m_heights[Index(x, z)] = static_cast<int16_t>(top);
+                }
+            }
+        }
+
+        int GetBlock(int x, int y, int z) const {
+            if (y < 0) {
+                return 1;
+            }
+            if (x < -WORLD_HALF || x >= WORLD_HALF || z < -WORLD_HALF || z >= WORLD_HALF) {
+                return y < 256 ? 1 : 0;
+            }
+            return y <= m_heights[Index(x, z)] ? 1 : 0;
+        }
+
+        bool IsObstacle(int x, int z) const {
+            return IsWall(x, z) || IsPillar(x, z);
+        }
+
+    private:
+        std::vector<int16_t> m_heights;
+
+        static size_t Index(int x, int z) {
+            return static_cast<size_t>(z + WORLD_HALF) * (WORLD_HALF * 2) + static_cast<size_t>(x + WORLD_HALF);
+        }
+
+        static int Mod(int value, int m) {
+            return ((value % m) + m) % m;
+        }
+
+        static bool IsWall(int x, int z) {
+            const bool wallX = Mod(x, ROOM_SIZE) == 0 && (Mod(z, ROOM_SIZE) < 22 || Mod(z, ROOM_SIZE) >= 26);
+            const bool wallZ = Mod(z, ROOM_SIZE) == 0 && (Mod(x, ROOM_SIZE) < 10 || Mod(x, ROOM_SIZE) >= 14);
+            return wallX || wallZ;
+        }
+
+        static bool IsPillar(int x, int z) {
+            uint32_t h = static_cast<uint32_t>(x) * 73856093u ^ static_cast<uint32_t>(z) * 19349663u;
+            h ^= h >> 13;
+            h *= 0x5bd1e995u;
+            h ^= h >> 15;
+            return (h % 100) < 2;
+        }
+    };
+
+    struct KeyHash {
+        size_t operator()(const glm::ivec3& p) const {
+            return static_cast<size_t>(p.x) * 73856093u ^ static_cast<size_t>(p.y) * 19349663u ^
+                   static_cast<size_t>(p.z) * 83492791u;
+        }
+    };
+
+    // The previous search: open set scanned with min_element every expansion
+    std::vector<glm::ivec3> LegacyFindPath(const PathfindingGrid& grid, glm::ivec3 start, glm::ivec3 goal) {
+        struct Entry {
+            float gCost;
+            float fCost;
+            glm::ivec3 parent;
+        };
+
+        auto heuristic = [&](const glm::ivec3& p) {
+            float dx = static_cast<float>(std::abs(p.x - goal.x));
+            float dy = static_cast<float>(std::abs(p.y - goal.y));
+            float dz = static_cast<float>(std::abs(p.z - goal.z));
+            return std::max(dx, dz) + std::min(dx, dz) * 0.414f + dy;
+        };
+
+        std::unordered_map<glm::ivec3, Entry, KeyHash> open;
+        std::unordered_map<glm::ivec3, Entry, KeyHash> closed;
+        open[start] = {0.0f, heuristic(start), start};
+
+        int explored = 0;
+        while (!open.empty() && explored <= MAX_NODES) {
+            auto best = std::min_element(open.begin(), open.end(), [](const auto& a, const auto& b) {
+                return a.second.fCost < b.second.fCost;
+            });
+            const glm::ivec3 current = best->first;
+            const Entry entry = best->second;
+            open.erase(best);
+            closed[current] = entry;
+
+            if (current == goal) {
+                std::vector<glm::ivec3> path{current};
+                glm::ivec3 p = current;
+                while (p != start) {
+                    p = closed[p].parent;
+                    path.push_back(p);
+                }
+                std::reverse(path.begin(), path.end());
+                return path;
+            }
+
+            for (const glm::ivec3& next : grid.GetNeighbors(current)) {
+                if (closed.count(next)) {
+                    continue;
+                }
+                const float g = entry.gCost + grid.GetMovementCost(current, next);
+                auto it = open.find(next);
+                if (it == open.end() || g < it->second.gCost) {
+                    open[next] = {g, g + heuristic(next), current};
+                }
+            }
+            explored++;
+        }
+        return {};
+    }
+
+    float PathCost(const PathfindingGrid& grid, const std::vector<glm::ivec3>& path) {
+        float cost = 0.0f;
+        for (size_t i = 1; i < path.size(); ++i) {
+            cost += grid.GetMovementCost(path[i - 1], path[i]);
+        }
+        return cost;
+    }
+
+    struct Pair {
+        glm::vec3 start;
+        glm::vec3 goal;
+    };
+
+    // Start and goal on open ground, so every pair has a path
+    std::vector<Pair> MakePairs(const Terrain& terrain, int distance, int count, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> coord(-300.0f, 300.0f);
+        std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+        const float reach = static_cast<float>(distance);
+
+        std::vector<Pair> pairs;
+        while (static_cast<int>(pairs.size()) < count) {
+            const float x = std::round(coord(rng));
+            const float z = std::round(coord(rng));
+            const float a = angle(rng);
+            const float gx = std::round(x + std::cos(a) * reach);
+            const float gz = std::round(z + std::sin(a) * reach);
+            if (terrain.IsObstacle(static_cast<int>(x), static_cast<int>(z)) ||
+                terrain.IsObstacle(static_cast<int>(gx), static_cast<int>(gz))) {
+                continue;
+            }
+            pairs.push_back({glm::vec3(x, 120.0f, z), glm::vec3(gx, 120.0f, gz)});
+        }
+        return pairs;
+    }
+
+    struct RunResult {
+        double seconds = 0.0;
+        int found = 0;
+        double cost = 0.0;
+    };
+
+    template<typename Fn>
+    RunResult RunPairs(const std::vector<Pair>& pairs, size_t count, const PathfindingGrid& grid, Fn&& find) {
+        RunResult result;
+        std::vector<std::vector<glm::ivec3>> paths(count);
+        result.seconds = MeasureSeconds([&]() {
+            for (size_t i = 0; i < count; ++i) {
+                paths[i] = find(pairs[i]);
+            }
+        });
+        for (const auto& path : paths) {
+            if (!path.empty()) {
+                result.found++;
+                result.cost += PathCost(grid, path);
+            }
+        }
+        return result;
+    }
+
+    void PrintRun(const std::string& label, const RunResult& run, size_t count, double referenceCost) {
+        PrintRow(label, static_cast<double>(count) / run.seconds, "paths/s");
+        if (referenceCost > 0.0 && run.found > 0) {
+            std::printf("  %-40s %14.3f %s\n", ("  cost vs flat, found " + std::to_string(run.found) + "/" +
+                        std::to_string(count)).c_str(), run.cost / referenceCost, "x");
+        }
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int pairScale = argc > 1 ? std::max(1, std::atoi(argv[1])) : 100;
+
+    Terrain terrain;
+    auto blockQuery = [&terrain](int x, int y, int z) { return terrain.GetBlock(x, y, z); };
+    PathfindingGrid grid(blockQuery);
+
+    std::printf("Pathfinding benchmark: %dx%d rooms with doorways, 2%% pillars\n", ROOM_SIZE, ROOM_SIZE);
+
+    const int distances[] = {16, 64, 256};
+    for (int distance : distances) {
+        const int pairCount = distance == 256 ? std::max(1, pairScale / 4) : pairScale;
+        const std::vector<Pair> pairs = MakePairs(terrain, distance, pairCount, 42u + static_cast<uint32_t>(distance));
+
+        PrintHeader(std::to_string(distance) + " blocks, " + std::to_string(pairCount) + " pairs");
+
+        Pathfinding flat(blockQuery);
+        flat.SetMaxSearchDistance(400);
+        RunResult flatRun = RunPairs(pairs, pairs.size(), grid, [&](const Pair& p) {
+            return flat.FindPath(p.start, p.goal);
+        });
+        PrintRun("Flat A* (binary heap, arena)", flatRun, pairs.size(), 0.0);
+
+        // Legacy is quadratic in the open set; keep the long runs short
+        const size_t legacyCount = std::min(pairs.size(), distance == 256 ? size_t(3) : pairs.size());
+        RunResult legacyRun = RunPairs(pairs, legacyCount, grid, [&](const Pair& p) {
+            glm::ivec3 start = glm::round(p.start);
+            glm::ivec3 goal = glm::round(p.goal);
+            start.y = grid.FindGroundLevel(start);
+            goal.y = grid.FindGroundLevel(goal);
+            return LegacyFindPath(grid, start, goal);
+        });
+        PrintRun("Legacy A* (" + std::to_string(legacyCount) + " pairs)", legacyRun, legacyCount, 0.0);
+
+        if (distance < 48) {
+            continue;
+        }
+
+        Pathfinding hierarchical(blockQuery);
+        hierarchical.SetMaxSearchDistance(400);
+        hierarchical.EnableHierarchical(true);
+        hierarchical.SetHierarchicalThreshold(0);
+
+        RunResult cold = RunPairs(pairs, pairs.size(), grid, [&](const Pair& p) {
+            hierarchical.GetPortalGraph()->Clear();
+            return hierarchical.FindPath(p.start, p.goal);
+        });
+        PrintRun("Hierarchical, cold cache", cold, pairs.size(), flatRun.cost);
+
+        // Fill the cache, then time the same pairs again
+        for (const Pair& p : pairs) {
+            hierarchical.FindPath(p.start, p.goal);
+        }
+        RunResult warm = RunPairs(pairs, pairs.size(), grid, [&](const Pair& p) {
+            return hierarchical.FindPath(p.start, p.goal);
+        });
+        PrintRun("Hierarchical, warm cache", warm, pairs.size(), flatRun.cost);
+        PrintRow("Cached chunk graphs", static_cast<double>(hierarchical.GetPortalGraph()->GetCachedChunkCount()), "");
+        PrintRow("Flat paths found", flatRun.found, "");
+    }
+
+    return 0;
+}
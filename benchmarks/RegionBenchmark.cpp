@@ -0,0 +1,252 @@
+/**
+ * @file RegionBenchmark.cpp
+ * @brief Compares one-file-per-chunk storage against region files
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * Saves a 64x64-chunk world in the legacy layout (one file per chunk,
+ * create_directories on every save, istreambuf_iterator reads) and in
+ * 32x32-chunk region files, then loads every chunk back into a Chunk.
+ * Cold loads drop the files from the page cache first (posix_fadvise);
+ * directory entries and inodes stay cached, which flatters the legacy
+ * layout. Payloads are uncompressed so only the file layout differs.
+ *
+ * Usage: RegionBenchmark [scratch directory]
+ */
+
+#include "BenchmarkCommon.hpp"
+
+#include "blocks/Block.hpp"
+#include "world/Chunk.hpp"
+#include "world/RegionFile.hpp"
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace VoxelCraft;
+using namespace VoxelCraft::Benchmark;
+
+namespace {
+
+    constexpr int32_t WORLD_CHUNKS = 64;
+    constexpr int32_t SEA_LEVEL = 62;
+    constexpr int COLD_RUNS = 3;
+
+    int32_t SurfaceHeight(int32_t x, int32_t z) {
+        double h = 64.0 +
+                   8.0 * std::sin(x * 0.045) * std::cos(z * 0.038) +
+                   4.0 * std::sin((x + z) * 0.11) +
+                   1.5 * std::cos(x * 0.31 - z * 0.27);
+        return static_cast<int32_t>(h);
+    }
+
+    std::shared_ptr<Chunk> GenerateTerrain(const ChunkCoord& coord) {
+        auto chunk = std::make_shared<Chunk>(coord);
+
+        for (int32_t z = 0; z < 16; ++z) {
+            for (int32_t x = 0; x < 16; ++x) {
+                const int32_t wx = coord.x * 16 + x;
+                const int32_t wz = coord.z * 16 + z;
+                const int32_t height = SurfaceHeight(wx, wz);
+
+                for (int32_t y = 0; y <= std::max(height, SEA_LEVEL); ++y) {
+                    BlockType type = BlockType::STONE;
+                    if (y == 0) {
+                        type = BlockType::BEDROCK;
+                    } else if (y > height) {
+                        type = BlockType::WATER;
+                    } else if (y == height) {
+                        type = height >= SEA_LEVEL ? BlockType::GRASS_BLOCK : BlockType::DIRT;
+                    } else if (y + 4 > height) {
+                        type = BlockType::DIRT;
+                    } else if ((wx * 7 + y * 13 + wz * 31) % 97 == 0) {
+                        type = BlockType::COAL_ORE;
+                    }
+                    chunk->SetBlockId(static_cast<uint8_t>(x), static_cast<uint8_t>(y), static_cast<uint8_t>(z),
+                        static_cast<uint16_t>(type));
+                }
+            }
+        }
+
+        return chunk;
+    }
+
+    std::filesystem::path LegacyPath(const std::filesystem::path& root, const ChunkCoord& coord) {
+        return root / "chunks" / (std::to_string(coord.x) + "_" + std::to_string(coord.z) + ".chunk");
+    }
+
+    // Flush and drop every file under root from the page cache
+    bool EvictPageCache(const std::filesystem::path& root) {
+#ifdef _WIN32
+        (void)root;
+        return false;
+#else
+        bool evicted = true;
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(root)) {
+            if (!entry.is_regular_file()) {
+                continue;
+            }
+            int fd = ::open(entry.path().c_str(), O_RDONLY);
+            if (fd < 0) {
+                evicted = false;
+                continue;
+            }
+            ::fdatasync(fd);
+            evicted &= ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+            ::close(fd);
+        }
+        return evicted;
+#endif
+    }
+
+    struct DiskUsage {
+        uint64_t files = 0;
+        uint64_t bytes = 0;
+    };
+
+    DiskUsage Measure(const std::filesystem::path& directory) {
+        DiskUsage usage;
+        for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+            ++usage.files;
+            usage.bytes += entry.file_size();
+        }
+        return usage;
+    }
+
+    void SaveLegacy(const std::filesystem::path& root, const std::vector<ChunkCoord>& coords,
+                    const std::vector<std::vector<uint8_t>>& payloads) {
+        for (size_t i = 0; i < coords.size(); ++i) {
+            const auto path = LegacyPath(root, coords[i]);
+            std::filesystem::create_directories(path.parent_path());
+            std::ofstream file(path, std::ios::binary);
+            file.write(reinterpret_cast<const char*>(payloads[i].data()), static_cast<std::streamsize>(payloads[i].size()));
+        }
+    }
+
+    void SaveRegions(const std::filesystem::path& root, const std::vector<ChunkCoord>& coords,
+                     const std::vector<std::vector<uint8_t>>& payloads) {
+        RegionStorage storage((root / "region").string());
+        for (size_t i = 0; i < coords.size(); ++i) {
+            storage.WriteChunk(coords[i], payloads[i].data(), payloads[i].size());
+        }
+        storage.Flush();
+    }
+
+    uint64_t LoadLegacy(const std::filesystem::path& root, const std::vector<ChunkCoord>& coords) {
+        uint64_t loaded = 0;
+        for (const auto& coord : coords) {
+            const auto path = LegacyPath(root, coord);
+            if (!std::filesystem::exists(path)) {
+                continue;
+            }
+            std::ifstream file(path, std::ios::binary);
+            std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            auto chunk = std::make_shared<Chunk>(coord);
+            loaded += chunk->Deserialize(data) ? 1u : 0u;
+            DoNotOptimize(chunk);
+        }
+        return loaded;
+    }
+
+    uint64_t LoadRegions(const std::filesystem::path& root, const std::vector<ChunkCoord>& coords) {
+        // A fresh storage so region opening and mapping are part of the cost
+        RegionStorage storage((root / "region").string());
+        uint64_t loaded = 0;
+        for (const auto& coord : coords) {
+            auto chunk = std::make_shared<Chunk>(coord);
+            storage.ReadChunk(coord, [&chunk, &loaded](const uint8_t* data, size_t size) {
+                loaded += chunk->Deserialize(data, size) ? 1u : 0u;
+            });
+            DoNotOptimize(chunk);
+        }
+        return loaded;
+    }
+
+    template<typename LoadFn>
+    void ReportLoads(const std::string& title, const std::filesystem::path& root, size_t chunkCount, LoadFn&& load) {
+        PrintHeader(title);
+
+        uint64_t loaded = 0;
+        bool cold = true;
+        double coldSeconds = 1e300;
+        for (int run = 0; run < COLD_RUNS; ++run) {
+            cold &= EvictPageCache(root);
+            coldSeconds = std::min(coldSeconds, MeasureSeconds([&]() { loaded = load(); }));
+        }
+        const double warmSeconds = MeasureBestSeconds(COLD_RUNS, [&]() { loaded = load(); });
+
+        PrintRow("chunks loaded", static_cast<double>(loaded), "");
+        if (loaded != chunkCount) {
+            std::printf("  WARNING: expected %zu chunks\n", chunkCount);
+        }
+        PrintRow(cold ? "cold load" : "cold load (page cache not evicted)", static_cast<double>(loaded) / coldSeconds, "chunks/s");
+        PrintRow("warm load", static_cast<double>(loaded) / warmSeconds, "chunks/s");
+    }
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const std::filesystem::path root = std::filesystem::path(argc > 1 ? argv[1] :
+        (std::filesystem::temp_directory_path() / "voxelcraft_region_benchmark").string());
+    const std::filesystem::path legacyRoot = root / "legacy";
+    const std::filesystem::path regionRoot = root / "regions";
+
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(legacyRoot);
+    std::filesystem::create_directories(regionRoot);
+
+    std::printf("Region benchmark: %dx%d chunks in %s\n", WORLD_CHUNKS, WORLD_CHUNKS, root.string().c_str());
+
+    std::vector<ChunkCoord> coords;
+    std::vector<std::vector<uint8_t>> payloads;
+    uint64_t payloadBytes = 0;
+    for (int32_t z = -WORLD_CHUNKS / 2; z < WORLD_CHUNKS / 2; ++z) {
+        for (int32_t x = -WORLD_CHUNKS / 2; x < WORLD_CHUNKS / 2; ++x) {
+            coords.push_back(ChunkCoord(x, z));
+            payloads.push_back(GenerateTerrain(coords.back())->Serialize());
+            payloadBytes += payloads.back().size();
+        }
+    }
+    PrintRow("average payload", static_cast<double>(payloadBytes) / static_cast<double>(coords.size()), "bytes");
+
+    PrintHeader("save");
+    const double legacySave = MeasureSeconds([&]() { SaveLegacy(legacyRoot, coords, payloads); });
+    const double regionSave = MeasureSeconds([&]() { SaveRegions(regionRoot, coords, payloads); });
+    PrintRow("one file per chunk", static_cast<double>(coords.size()) / legacySave, "chunks/s");
+    PrintRow("region files", static_cast<double>(coords.size()) / regionSave, "chunks/s");
+
+    PrintHeader("disk usage");
+    const DiskUsage legacyUsage = Measure(legacyRoot / "chunks");
+    const DiskUsage regionUsage = Measure(regionRoot / "region");
+    PrintRow("one file per chunk: files", static_cast<double>(legacyUsage.files), "");
+    PrintRow("one file per chunk: bytes", static_cast<double>(legacyUsage.bytes) / (1024.0 * 1024.0), "MiB");
+    PrintRow("region files: files", static_cast<double>(regionUsage.files), "");
+    PrintRow("region files: bytes", static_cast<double>(regionUsage.bytes) / (1024.0 * 1024.0), "MiB");
+
+    PrintHeader("directory scan");
+    PrintRow("one file per chunk", MeasureBestSeconds(COLD_RUNS, [&]() { Measure(legacyRoot / "chunks"); }) * 1e3, "ms");
+    PrintRow("region files", MeasureBestSeconds(COLD_RUNS, [&]() { Measure(regionRoot / "region"); }) * 1e3, "ms");
+
+    ReportLoads("load: one file per chunk", legacyRoot, coords.size(),
+        [&]() { return LoadLegacy(legacyRoot, coords); });
+    ReportLoads("load: region files (mapped, zero-copy)", regionRoot, coords.size(),
+        [&]() { return LoadRegions(regionRoot, coords); });
+
+    PrintHeader("compaction");
+    RegionStorage storage((regionRoot / "region").string());
+    const double compactSeconds = MeasureSeconds([&]() { storage.CompactAll(); });
+    storage.Close();
+    PrintRow("compact all regions", compactSeconds * 1e3, "ms");
+    PrintRow("region files: bytes after", static_cast<double>(Measure(regionRoot / "region").bytes) / (1024.0 * 1024.0), "MiB");
+
+    std::filesystem::remove_all(root);
+    return 0;
+}
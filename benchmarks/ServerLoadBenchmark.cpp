@@ -0,0 +1,477 @@
+/**
+ * @file ServerLoadBenchmark.cpp
+ * @brief Loopback load generator: epoll ServerTransport vs. the sleep-polling network loop
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * Opens N TCP connections to 127.0.0.1 and keeps a fixed number of
+ * length-prefixed frames in flight on each; the server echoes every frame
+ * back and the client records the round trip. Two servers are driven the
+ * same way:
+ *
+ *   polling    the previous network loop, re-implemented here as it was:
+ *              recv on every socket, packets handed over through a
+ *              mutex-guarded std::queue, one send() per packet, then
+ *              sleep_for(10 ms)
+ *   reactor    ServerTransport: edge-triggered epoll, per-connection
+ *              read ring and send queue, queued frames batched into
+ *              writev
+ *
+ * Reported per server: connections established, echoed packets per
+ * second and round-trip latency percentiles (p50, p99).
+ *
+ * A backpressure check follows: one client stops reading while the server
+ * keeps sending. Send must start returning BACKPRESSURE instead of
+ * buffering without bound, the server must stop reading the requests the
+ * stalled client keeps sending, the client must be disconnected after
+ * slowClientTimeout, and a healthy client on the same reactor must still
+ * receive every frame queued for it. Any failure prints FAILED and exits
+ * with 1.
+ *
+ * Usage: ServerLoadBenchmark [connections] [seconds] [payload bytes] [in flight per connection]
+ */
+
+#include "BenchmarkCommon.hpp"
+
+#include "network/ServerTransport.hpp"
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <queue>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace VoxelCraft;
+using namespace VoxelCraft::Benchmark;
+
+namespace {
+
+    struct LoadResult {
+        size_t connections = 0;
+        uint64_t roundTrips = 0;
+        double seconds = 0.0;
+        std::vector<double> latencyMicros;
+    };
+
+    uint64_t NowNanos() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            Clock::now().time_since_epoch()).count());
+    }
+
+    void SetNonBlocking(int fd) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    }
+
+    int ConnectLoopback(uint16_t port) {
+        int fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+            if (fd >= 0) {
+                close(fd);
+            }
+            return -1;
+        }
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+        return fd;
+    }
+
+    std::vector<uint8_t> MakeFrame(size_t payload, uint64_t timestamp) {
+        std::vector<uint8_t> frame(4 + payload, 0xAB);
+        const uint32_t size = static_cast<uint32_t>(payload);
+        for (int i = 0; i < 4; ++i) {
+            frame[static_cast<size_t>(i)] = static_cast<uint8_t>(size >> (i * 8));
+        }
+        std::memcpy(frame.data() + 4, &timestamp, sizeof(timestamp));
+        return frame;
+    }
+
+    bool SendAll(int fd, const uint8_t* data, size_t size) {
+        while (size > 0) {
+            ssize_t sent = send(fd, data, size, MSG_NOSIGNAL);
+            if (sent < 0 && errno == EINTR) {
+                continue;
+            }
+            if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                std::this_thread::yield();
+                continue;
+            }
+            if (sent <= 0) {
+                return false;
+            }
+            data += sent;
+            size -= static_cast<size_t>(sent);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Client side: N connections, closed loop with a fixed number of frames in flight
+     */
+    LoadResult RunClients(uint16_t port, size_t connections, double seconds, size_t payload, size_t inFlight) {
+        LoadResult result;
+        std::vector<int> sockets;
+        std::vector<std::vector<uint8_t>> buffers;
+        for (size_t i = 0; i < connections; ++i) {
+            int fd = ConnectLoopback(port);
+            if (fd < 0) {
+                break;
+            }
+            sockets.push_back(fd);
+        }
+        buffers.resize(sockets.size());
+        result.connections = sockets.size();
+
+        int epollFd = epoll_create1(EPOLL_CLOEXEC);
+        for (size_t i = 0; i < sockets.size(); ++i) {
+            for (size_t k = 0; k < inFlight; ++k) {
+                auto frame = MakeFrame(payload, NowNanos());
+                SendAll(sockets[i], frame.data(), frame.size());
+            }
+            SetNonBlocking(sockets[i]);
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.u64 = i;
+            epoll_ctl(epollFd, EPOLL_CTL_ADD, sockets[i], &event);
+        }
+
+        std::vector<epoll_event> events(256);
+        uint8_t chunk[65536];
+        const auto start = Clock::now();
+        const auto end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds));
+
+        while (Clock::now() < end) {
+            int count = epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), 50);
+            for (int e = 0; e < count; ++e) {
+                const size_t index = static_cast<size_t>(events[static_cast<size_t>(e)].data.u64);
+                auto& buffer = buffers[index];
+                while (true) {
+                    ssize_t received = recv(sockets[index], chunk, sizeof(chunk), 0);
+                    if (received <= 0) {
+                        break;
+                    }
+                    buffer.insert(buffer.end(), chunk, chunk + received);
+                }
+
+                size_t offset = 0;
+                const uint64_t now = NowNanos();
+                while (buffer.size() - offset >= 4) {
+                    uint32_t size = 0;
+                    for (int i = 0; i < 4; ++i) {
+                        size |= static_cast<uint32_t>(buffer[offset + static_cast<size_t>(i)]) << (i * 8);
+                    }
+                    if (buffer.size() - offset < 4 + size) {
+                        break;
+                    }
+                    uint64_t timestamp = 0;
+                    std::memcpy(&timestamp, buffer.data() + offset + 4, sizeof(timestamp));
+                    result.latencyMicros.push_back(static_cast<double>(now - timestamp) / 1000.0);
+                    result.roundTrips++;
+                    offset += 4 + size;
+
+                    auto frame = MakeFrame(payload, NowNanos());
+                    SendAll(sockets[index], frame.data(), frame.size());
+                }
+                buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(offset));
+            }
+        }
+        result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        for (int fd : sockets) {
+            close(fd);
+        }
+        close(epollFd);
+        return result;
+    }
+
+    /**
+     * @brief The previous server loop: poll every socket, queue, send one by one, sleep 10 ms
+     */
+    class PollingEchoServer {
+    public:
+        bool Start() {
+            m_listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            if (bind(m_listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+                listen(m_listenFd, SOMAXCONN) != 0) {
+                return false;
+            }
+            socklen_t length = sizeof(address);
+            getsockname(m_listenFd, reinterpret_cast<sockaddr*>(&address), &length);
+            m_port = ntohs(address.sin_port);
+            m_running = true;
+            m_thread = std::thread([this]() { Loop(); });
+            return true;
+        }
+
+        void Stop() {
+            m_running = false;
+            m_thread.join();
+            for (auto& client : m_clients) {
+                close(client.fd);
+            }
+            close(m_listenFd);
+        }
+
+        uint16_t GetPort() const { return m_port; }
+
+    private:
+        struct ClientState {
+            int fd;
+            std::vector<uint8_t> buffer;
+        };
+
+        void Loop() {
+            uint8_t chunk[65536];
+            while (m_running) {
+                int fd;
+                while ((fd = accept4(m_listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+                    int noDelay = 1;
+                    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+                    m_clients.push_back(ClientState{ fd, {} });
+                }
+
+                // ReceiveNetworkPackets -> incoming queue
+                for (auto& client : m_clients) {
+                    ssize_t received;
+                    while ((received = recv(client.fd, chunk, sizeof(chunk), 0)) > 0) {
+                        client.buffer.insert(client.buffer.end(), chunk, chunk + received);
+                    }
+                    size_t offset = 0;
+                    while (client.buffer.size() - offset >= 4) {
+                        uint32_t size = 0;
+                        for (int i = 0; i < 4; ++i) {
+                            size |= static_cast<uint32_t>(client.buffer[offset + static_cast<size_t>(i)]) << (i * 8);
+                        }
+                        if (client.buffer.size() - offset < 4 + size) {
+                            break;
+                        }
+                        std::lock_guard<std::mutex> lock(m_queueMutex);
+                        m_outgoing.emplace(client.fd, std::vector<uint8_t>(client.buffer.begin() + static_cast<std::ptrdiff_t>(offset),
+                            client.buffer.begin() + static_cast<std::ptrdiff_t>(offset + 4 + size)));
+                        offset += 4 + size;
+                    }
+                    client.buffer.erase(client.buffer.begin(), client.buffer.begin() + static_cast<std::ptrdiff_t>(offset));
+                }
+
+                // ProcessOutgoingPackets: one send per packet
+                {
+                    std::lock_guard<std::mutex> lock(m_queueMutex);
+                    while (!m_outgoing.empty()) {
+                        auto& packet = m_outgoing.front();
+                        SendAll(packet.first, packet.second.data(), packet.second.size());
+                        m_outgoing.pop();
+                    }
+                }
+
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+
+        int m_listenFd = -1;
+        uint16_t m_port = 0;
+        std::atomic<bool> m_running{ false };
+        std::thread m_thread;
+        std::vector<ClientState> m_clients;
+        std::mutex m_queueMutex;
+        std::queue<std::pair<int, std::vector<uint8_t>>> m_outgoing;
+    };
+
+    void Report(const std::string& label, const LoadResult& result) {
+        PrintRow(label + " connections", static_cast<double>(result.connections), "");
+        PrintRow(label + " packets/s (echoed)", static_cast<double>(result.roundTrips) / result.seconds, "pkt/s");
+        PrintRow(label + " latency p50", Percentile(result.latencyMicros, 50.0), "us");
+        PrintRow(label + " latency p99", Percentile(result.latencyMicros, 99.0), "us");
+    }
+
+    bool CheckBackpressure() {
+        ServerTransport transport;
+        ServerTransportConfig config;
+        config.bindAddress = "127.0.0.1";
+        config.port = 0;
+        config.writeBufferSize = 16 * 1024;
+        config.slowClientTimeout = std::chrono::milliseconds(300);
+
+        std::mutex connectedMutex;
+        std::vector<uint32_t> connected;
+        transport.SetFrameCallback([&transport](uint32_t connectionId, const uint8_t* data, size_t size) {
+            transport.Send(connectionId, data, size);
+        });
+        transport.SetConnectCallback([&](uint32_t connectionId, const std::string&) {
+            std::lock_guard<std::mutex> lock(connectedMutex);
+            connected.push_back(connectionId);
+        });
+        if (!transport.Start(config)) {
+            return false;
+        }
+
+        // The stalled client never reads and advertises a tiny receive window
+        int stalled = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        int small = 4096;
+        setsockopt(stalled, SOL_SOCKET, SO_RCVBUF, &small, sizeof(small));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(transport.GetPort());
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        connect(stalled, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        SetNonBlocking(stalled);
+        int healthy = ConnectLoopback(transport.GetPort());
+
+        while (true) {
+            std::lock_guard<std::mutex> lock(connectedMutex);
+            if (connected.size() == 2) {
+                break;
+            }
+        }
+        // Accepted in connect order
+        const uint32_t stalledId = connected[0];
+        const uint32_t healthyId = connected[1];
+
+        std::atomic<uint64_t> healthyReceived{ 0 };
+        std::thread reader([&]() {
+            std::vector<uint8_t> buffer;
+            uint8_t chunk[65536];
+            ssize_t received;
+            while ((received = recv(healthy, chunk, sizeof(chunk), 0)) > 0) {
+                buffer.insert(buffer.end(), chunk, chunk + received);
+                size_t offset = 0;
+                while (buffer.size() - offset >= 4) {
+                    uint32_t size = 0;
+                    for (int i = 0; i < 4; ++i) {
+                        size |= static_cast<uint32_t>(buffer[offset + static_cast<size_t>(i)]) << (i * 8);
+                    }
+                    if (buffer.size() - offset < 4 + size) {
+                        break;
+                    }
+                    offset += 4 + size;
+                    healthyReceived++;
+                }
+                buffer.erase(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(offset));
+            }
+        });
+
+        // The stalled client also keeps sending requests whose echoes it never reads
+        std::vector<uint8_t> request = MakeFrame(1024, 0);
+        size_t requestOffset = 0;
+        auto feedStalled = [&]() {
+            ssize_t sent;
+            while ((sent = send(stalled, request.data() + requestOffset, request.size() - requestOffset, MSG_NOSIGNAL)) > 0) {
+                requestOffset = (requestOffset + static_cast<size_t>(sent)) % request.size();
+            }
+        };
+
+        std::vector<uint8_t> payload(1024, 0x5A);
+        uint64_t healthyQueued = 0;
+        uint64_t stalledRejected = 0;
+        const auto end = Clock::now() + std::chrono::milliseconds(1000);
+        while (Clock::now() < end) {
+            feedStalled();
+            if (transport.Send(stalledId, payload.data(), payload.size()) == ServerTransport::SendResult::BACKPRESSURE) {
+                stalledRejected++;
+            }
+            while (transport.Send(healthyId, payload.data(), payload.size()) != ServerTransport::SendResult::QUEUED) {
+                std::this_thread::yield();
+            }
+            healthyQueued++;
+            if ((healthyQueued & 63) == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        const auto deadline = Clock::now() + std::chrono::seconds(5);
+        while (healthyReceived < healthyQueued && Clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+
+        ServerTransportStats stats = transport.GetStats();
+        PrintRow("frames refused to the stalled client", static_cast<double>(stalledRejected), "");
+        PrintRow("read pauses", static_cast<double>(stats.readPauses), "");
+        PrintRow("slow client disconnects", static_cast<double>(stats.slowClientDisconnects), "");
+        PrintRow("healthy client frames queued", static_cast<double>(healthyQueued), "");
+        PrintRow("healthy client frames received", static_cast<double>(healthyReceived.load()), "");
+
+        bool ok = stalledRejected > 0 && stats.readPauses > 0 && stats.slowClientDisconnects == 1 &&
+                  healthyReceived == healthyQueued && transport.GetConnectionCount() == 1;
+
+        transport.Stop();
+        shutdown(healthy, SHUT_RDWR);
+        reader.join();
+        close(healthy);
+        close(stalled);
+        return ok;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const size_t connections = argc > 1 ? static_cast<size_t>(std::max(1, std::atoi(argv[1]))) : 200;
+    const double seconds = argc > 2 ? std::max(0.1, std::atof(argv[2])) : 3.0;
+    const size_t payload = argc > 3 ? static_cast<size_t>(std::max(8, std::atoi(argv[3]))) : 64;
+    const size_t inFlight = argc > 4 ? static_cast<size_t>(std::max(1, std::atoi(argv[4]))) : 1;
+
+    std::printf("Loopback echo: %zu connections, %zu-byte payload, %zu in flight each, %.1f s per server\n",
+                connections, payload, inFlight, seconds);
+
+    PrintHeader("Polling loop (sleep 10 ms, queue, send per packet)");
+    PollingEchoServer polling;
+    if (!polling.Start()) {
+        std::printf("cannot start polling server\n");
+        return 1;
+    }
+    LoadResult pollingResult = RunClients(polling.GetPort(), connections, seconds, payload, inFlight);
+    polling.Stop();
+    Report("polling", pollingResult);
+
+    PrintHeader("ServerTransport (epoll edge-triggered, writev)");
+    ServerTransport transport;
+    ServerTransportConfig config;
+    config.bindAddress = "127.0.0.1";
+    config.port = 0;
+    config.maxConnections = connections + 16;
+    transport.SetFrameCallback([&transport](uint32_t connectionId, const uint8_t* data, size_t size) {
+        transport.Send(connectionId, data, size);
+    });
+    if (!transport.Start(config)) {
+        std::printf("cannot start server transport\n");
+        return 1;
+    }
+    LoadResult reactorResult = RunClients(transport.GetPort(), connections, seconds, payload, inFlight);
+    ServerTransportStats stats = transport.GetStats();
+    transport.Stop();
+    Report("reactor", reactorResult);
+    PrintRow("reactor frames per writev", static_cast<double>(stats.framesSent) / static_cast<double>(std::max<uint64_t>(1, stats.writevCalls)), "");
+    PrintRow("reactor frames per epoll wakeup", static_cast<double>(stats.framesReceived) / static_cast<double>(std::max<uint64_t>(1, stats.wakeups)), "");
+
+    PrintHeader("Comparison");
+    PrintRow("packets/s", (static_cast<double>(reactorResult.roundTrips) / reactorResult.seconds) /
+             std::max(1.0, static_cast<double>(pollingResult.roundTrips) / pollingResult.seconds), "x");
+    PrintRow("p99 latency", Percentile(pollingResult.latencyMicros, 99.0) /
+             std::max(1e-3, Percentile(reactorResult.latencyMicros, 99.0)), "x lower");
+
+    PrintHeader("Backpressure");
+    bool ok = CheckBackpressure();
+    if (reactorResult.connections != connections || reactorResult.roundTrips == 0) {
+        std::printf("  reactor did not serve every connection\n");
+        ok = false;
+    }
+
+    if (!ok) {
+        std::printf("\nFAILED\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,291 @@
+/**
+ * @file SnapshotDeltaBenchmark.cpp
+ * @brief Snapshot bytes per tick per client with per-client delta baselines
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * A 20 Hz server builds one snapshot per tick in the GameStateSync layout
+ * (timestamp, sequence, 1 KiB world block, 52-byte player records). Three
+ * quarters of the players walk and turn, the rest stand still. Each snapshot
+ * goes to every client through a loopback stand-in with 2-4 ticks of latency
+ * and 2% loss each way; clients ack what they decode and the server encodes
+ * against each client's last ack. One client in sixteen loses its link for
+ * 50 ticks, longer than the baseline history, so it has to recover from a
+ * full snapshot.
+ *
+ * Every decoded snapshot is compared byte for byte with what the server
+ * built. Full-snapshot bytes are what every tick cost before.
+ *
+ * Usage: SnapshotDeltaBenchmark [ticks]
+ */
+
+#include "BenchmarkCommon.hpp"
+
+#include "core/SnapshotDelta.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <random>
+#include <unordered_map>
+
+using namespace VoxelCraft;
+using namespace VoxelCraft::Benchmark;
+
+namespace {
+
+    constexpr double TICK_SECONDS = 0.05;
+    constexpr size_t WORLD_BYTES = 1024;
+    constexpr size_t HEADER_BYTES = sizeof(uint64_t) * 2;   // sequence + baseline
+    constexpr double LOSS_RATE = 0.02;
+    constexpr int MIN_LATENCY_TICKS = 2;
+    constexpr int MAX_LATENCY_TICKS = 4;
+    constexpr int OUTAGE_START = 200;
+    constexpr int OUTAGE_TICKS = 50;
+
+    struct SimPlayer {
+        uint32_t id;
+        float position[3];
+        float rotation[3];
+        float velocity[3];
+        float health;
+        bool walking;
+    };
+
+    template<typename T>
+    void Append(std::vector<uint8_t>& out, const T& value) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    // Same layout as GameStateSync::SerializeSnapshot / SerializePlayerState
+    std::vector<uint8_t> BuildSnapshot(uint64_t timestamp, uint64_t sequence, uint32_t worldTime,
+                                       const std::vector<SimPlayer>& players) {
+        std::vector<uint8_t> world(WORLD_BYTES, 0);
+        std::memcpy(world.data(), &worldTime, sizeof(worldTime));
+
+        std::vector<uint8_t> playerData;
+        playerData.reserve(players.size() * 52);
+        for (const SimPlayer& player : players) {
+            Append(playerData, player.id);
+            for (float v : player.position) Append(playerData, v);
+            for (float v : player.rotation) Append(playerData, v);
+            for (float v : player.velocity) Append(playerData, v);
+            Append(playerData, player.health);
+            Append(playerData, timestamp);
+        }
+
+        std::vector<uint8_t> data;
+        Append(data, timestamp);
+        Append(data, sequence);
+        Append(data, static_cast<uint32_t>(world.size()));
+        data.insert(data.end(), world.begin(), world.end());
+        Append(data, static_cast<uint32_t>(playerData.size()));
+        data.insert(data.end(), playerData.begin(), playerData.end());
+        return data;
+    }
+
+    void StepPlayers(std::vector<SimPlayer>& players, std::mt19937& rng) {
+        std::uniform_real_distribution<float> turn(-0.05f, 0.05f);
+        std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+
+        for (SimPlayer& player : players) {
+            if (!player.walking) {
+                continue;
+            }
+            player.rotation[1] += turn(rng);
+            player.rotation[0] = std::clamp(player.rotation[0] + turn(rng) * 0.5f, -1.5f, 1.5f);
+            player.velocity[0] = std::sin(player.rotation[1]) * 4.3f;
+            player.velocity[2] = std::cos(player.rotation[1]) * 4.3f;
+            for (int axis = 0; axis < 3; ++axis) {
+                player.position[axis] += player.velocity[axis] * static_cast<float>(TICK_SECONDS);
+            }
+            if (chance(rng) < 0.01f) {
+                player.health = std::max(1.0f, player.health - 1.0f);
+            }
+        }
+    }
+
+    struct InFlight {
+        int deliverTick;
+        uint64_t sequence;      // Snapshot sequence, or acked sequence for acks
+        uint64_t baseline;
+        std::vector<uint8_t> payload;
+    };
+
+    struct SimClient {
+        SnapshotBaselineStore store;
+        std::deque<InFlight> toClient;
+        std::deque<InFlight> toServer;
+        bool outage = false;
+        uint64_t decodeFailures = 0;
+        uint64_t mismatches = 0;
+        uint64_t delivered = 0;
+    };
+
+    struct Result {
+        double fullBytesPerClient;
+        double deltaBytesPerClient;
+        double encodeMsPerTick;
+        uint64_t fullSnapshots;
+        uint64_t deltaSnapshots;
+        uint64_t baselineMisses;
+        uint64_t decodeFailures;
+        uint64_t mismatches;
+        uint64_t delivered;
+    };
+
+    Result Run(size_t playerCount, int ticks) {
+        std::mt19937 rng(1234 + static_cast<uint32_t>(playerCount));
+        std::uniform_real_distribution<float> spread(-200.0f, 200.0f);
+        std::uniform_real_distribution<double> loss(0.0, 1.0);
+        std::uniform_int_distribution<int> latency(MIN_LATENCY_TICKS, MAX_LATENCY_TICKS);
+
+        std::vector<SimPlayer> players(playerCount);
+        for (size_t i = 0; i < playerCount; ++i) {
+            SimPlayer& p = players[i];
+            p.id = static_cast<uint32_t>(i + 1);
+            p.position[0] = spread(rng);
+            p.position[1] = 70.0f;
+            p.position[2] = spread(rng);
+            p.rotation[0] = 0.0f;
+            p.rotation[1] = spread(rng) * 0.01f;
+            p.rotation[2] = 0.0f;
+            p.velocity[0] = p.velocity[1] = p.velocity[2] = 0.0f;
+            p.health = 20.0f;
+            p.walking = (i % 4) != 3;
+        }
+
+        SnapshotBaselineTracker tracker;
+        std::vector<SimClient> clients(playerCount);
+        for (size_t i = 0; i < playerCount; ++i) {
+            tracker.AddClient(static_cast<uint32_t>(i));
+        }
+
+        // What the server actually built, to check decodes against
+        std::unordered_map<uint64_t, std::vector<uint8_t>> sent;
+
+        uint64_t fullBytes = 0;
+        uint64_t deltaBytes = 0;
+        double encodeSeconds = 0.0;
+        uint64_t timestamp = 1700000000000ull;
+        std::vector<uint8_t> payload;
+
+        for (int tick = 0; tick < ticks; ++tick) {
+            const uint64_t sequence = static_cast<uint64_t>(tick) + 1;
+            timestamp += 50;
+            StepPlayers(players, rng);
+
+            // Acks that arrived this tick
+            for (size_t c = 0; c < clients.size(); ++c) {
+                auto& queue = clients[c].toServer;
+                while (!queue.empty() && queue.front().deliverTick <= tick) {
+                    tracker.Acknowledge(static_cast<uint32_t>(c), queue.front().sequence);
+                    queue.pop_front();
+                }
+            }
+
+            std::vector<uint8_t> snapshot = BuildSnapshot(timestamp, sequence, static_cast<uint32_t>(tick), players);
+            sent[sequence] = snapshot;
+            sent.erase(sequence > 64 ? sequence - 64 : 0);
+
+            encodeSeconds += MeasureSeconds([&]() {
+                tracker.PushSnapshot(sequence, snapshot);
+                for (size_t c = 0; c < clients.size(); ++c) {
+                    SimClient& client = clients[c];
+                    const uint64_t baseline = tracker.EncodeForClient(static_cast<uint32_t>(c), payload);
+                    deltaBytes += payload.size() + HEADER_BYTES;
+
+                    if (client.outage || loss(rng) < LOSS_RATE) {
+                        continue;
+                    }
+                    client.toClient.push_back({tick + latency(rng), sequence, baseline, payload});
+                }
+            });
+            fullBytes += (snapshot.size() + HEADER_BYTES) * clients.size();
+
+            // Client side: decode, verify, ack
+            for (size_t c = 0; c < clients.size(); ++c) {
+                SimClient& client = clients[c];
+                client.outage = (c % 16 == 0) && tick >= OUTAGE_START && tick < OUTAGE_START + OUTAGE_TICKS;
+
+                auto& queue = client.toClient;
+                // Latency jitter reorders packets; deliver whatever is due
+                for (auto it = queue.begin(); it != queue.end();) {
+                    if (it->deliverTick > tick) {
+                        ++it;
+                        continue;
+                    }
+
+                    std::vector<uint8_t> decoded;
+                    uint64_t ack = it->sequence;
+                    if (!client.store.Decode(it->sequence, it->baseline, it->payload.data(), it->payload.size(), decoded)) {
+                        client.decodeFailures++;
+                        ack = 0;
+                    } else {
+                        client.delivered++;
+                        auto expected = sent.find(it->sequence);
+                        if (expected == sent.end() || expected->second != decoded) {
+                            client.mismatches++;
+                        }
+                    }
+
+                    if (!client.outage && loss(rng) >= LOSS_RATE) {
+                        client.toServer.push_back({tick + latency(rng), ack, 0, {}});
+                    }
+                    it = queue.erase(it);
+                }
+            }
+        }
+
+        Result result{};
+        const double clientTicks = static_cast<double>(ticks) * static_cast<double>(playerCount);
+        result.fullBytesPerClient = static_cast<double>(fullBytes) / clientTicks;
+        result.deltaBytesPerClient = static_cast<double>(deltaBytes) / clientTicks;
+        result.encodeMsPerTick = encodeSeconds * 1000.0 / ticks;
+        result.fullSnapshots = tracker.GetStats().fullSnapshots;
+        result.deltaSnapshots = tracker.GetStats().deltaSnapshots;
+        result.baselineMisses = tracker.GetStats().baselineMisses;
+        for (const SimClient& client : clients) {
+            result.decodeFailures += client.decodeFailures;
+            result.mismatches += client.mismatches;
+            result.delivered += client.delivered;
+        }
+        return result;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int ticks = argc > 1 ? std::max(100, std::atoi(argv[1])) : 600;
+
+    std::printf("Snapshot delta benchmark: %d ticks at 20 Hz, %.0f%% loss each way, %d-%d tick latency\n",
+                ticks, LOSS_RATE * 100.0, MIN_LATENCY_TICKS, MAX_LATENCY_TICKS);
+
+    bool ok = true;
+    for (size_t playerCount : {16u, 64u, 128u}) {
+        const Result result = Run(playerCount, ticks);
+
+        PrintHeader(std::to_string(playerCount) + " players");
+        PrintRow("Full snapshot", result.fullBytesPerClient, "bytes/tick/client");
+        PrintRow("Delta vs acked baseline", result.deltaBytesPerClient, "bytes/tick/client");
+        PrintRow("Reduction", result.fullBytesPerClient / result.deltaBytesPerClient, "x");
+        PrintRow("Server upload (delta)", result.deltaBytesPerClient * static_cast<double>(playerCount) * 20.0 / 1024.0, "KiB/s");
+        PrintRow("Encode time", result.encodeMsPerTick, "ms/tick");
+        PrintRow("Full snapshots sent", static_cast<double>(result.fullSnapshots), "");
+        PrintRow("Delta snapshots sent", static_cast<double>(result.deltaSnapshots), "");
+        PrintRow("Server baseline misses", static_cast<double>(result.baselineMisses), "");
+        PrintRow("Client baseline misses", static_cast<double>(result.decodeFailures), "");
+        PrintRow("Snapshots decoded", static_cast<double>(result.delivered), "");
+        PrintRow("Decode mismatches", static_cast<double>(result.mismatches), "");
+
+        ok = ok && result.mismatches == 0;
+    }
+
+    if (!ok) {
+        std::printf("\nFAILED: decoded snapshots differ from what the server sent\n");
+        return 1;
+    }
+    return 0;
+}
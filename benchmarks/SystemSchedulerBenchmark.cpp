@@ -0,0 +1,387 @@
+/**
+ * @file SystemSchedulerBenchmark.cpp
+ * @brief Frame time of six ECS systems run serially vs. by SystemScheduler
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * 100k entities in ArchetypeStorage and six systems with declared access:
+ *
+ *   Integrate    writes TransformData, PhysicsData
+ *   Matrices     writes TransformData
+ *   Bounds       reads TransformData, writes BoundsData
+ *   Listener     reads TransformData, writes ListenerData
+ *   Animation    writes AnimationData (heaviest, independent)
+ *   Health       writes HealthData (independent)
+ *
+ * so the DAG is Integrate -> Matrices -> {Bounds, Listener} with Animation
+ * and Health free to overlap. Three modes are timed:
+ *
+ *   serial       no pool, systems one after another (the old UpdateSystems)
+ *   dag          non-conflicting systems in parallel, each system serial
+ *   dag+chunks   as dag, plus ParallelForEachChunk inside every system
+ *
+ * Every mode starts from the same population and must end with identical
+ * data. The last dag+chunks frame trace is printed.
+ *
+ * Usage: SystemSchedulerBenchmark [entities] [frames] [threads]
+ */
+
+#include "BenchmarkCommon.hpp"
+
+#include "core/WorkStealingPool.hpp"
+#include "entities/ArchetypeStorage.hpp"
+#include "entities/ComponentData.hpp"
+#include "entities/System.hpp"
+#include "entities/SystemScheduler.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+
+using namespace VoxelCraft;
+using namespace VoxelCraft::Benchmark;
+
+namespace {
+
+    constexpr float DELTA_TIME = 1.0f / 60.0f;
+
+    struct BoundsData {
+        glm::vec3 min{0.0f};
+        glm::vec3 max{0.0f};
+    };
+
+    struct ListenerData {
+        float distance = 0.0f;
+        float gain = 0.0f;
+    };
+
+    struct AnimationData {
+        float phase = 0.0f;
+        float speed = 1.0f;
+        float pose[8] = {};
+    };
+
+    struct HealthData {
+        float health = 20.0f;
+        float regen = 0.1f;
+    };
+
+    /**
+     * @brief System over one ArchetypeStorage query, optionally chunk-parallel
+     */
+    template<typename... Ts>
+    class BenchSystem : public System {
+    public:
+        BenchSystem(const char* name, ArchetypeStorage& storage, SystemScheduler& scheduler, bool parallelChunks)
+            : m_Query(storage.Query<Ts...>())
+            , m_Scheduler(scheduler)
+            , m_ParallelChunks(parallelChunks)
+        {
+            m_Name = name;
+        }
+
+        void Update(float deltaTime) override {
+            auto chunk = [this, deltaTime](size_t count, Ts*... columns) {
+                UpdateChunk(deltaTime, count, columns...);
+            };
+            if (m_ParallelChunks) {
+                m_Scheduler.ParallelForEachChunk(m_Query, chunk, 4);
+            } else {
+                m_Query.ForEachChunk(chunk);
+            }
+        }
+
+        template<typename T>
+        void DeclareRead() { Reads<T>(); }
+
+        template<typename T>
+        void DeclareWrite() { Writes<T>(); }
+
+    protected:
+        virtual void UpdateChunk(float deltaTime, size_t count, Ts*... columns) = 0;
+
+    private:
+        ArchetypeQuery<Ts...> m_Query;
+        SystemScheduler& m_Scheduler;
+        bool m_ParallelChunks;
+    };
+
+    class IntegrateSystem : public BenchSystem<TransformData, PhysicsData> {
+    public:
+        using BenchSystem::BenchSystem;
+
+    protected:
+        void UpdateChunk(float deltaTime, size_t count, TransformData* transforms, PhysicsData* bodies) override {
+            const glm::vec3 gravity(0.0f, -9.81f, 0.0f);
+            for (size_t i = 0; i < count; ++i) {
+                PhysicsData& body = bodies[i];
+                glm::vec3& position = transforms[i].position;
+                body.velocity += (body.useGravity ? body.acceleration + gravity : body.acceleration) * deltaTime;
+                body.velocity *= std::max(0.0f, 1.0f - body.drag * deltaTime);
+                position += body.velocity * deltaTime;
+                body.grounded = position.y <= body.groundHeight;
+                if (body.grounded) {
+                    position.y = body.groundHeight;
+                    body.velocity.y = std::max(body.velocity.y, 0.0f);
+                }
+            }
+        }
+    };
+
+    class MatrixSystem : public BenchSystem<TransformData> {
+    public:
+        using BenchSystem::BenchSystem;
+
+    protected:
+        void UpdateChunk(float, size_t count, TransformData* transforms) override {
+            for (size_t i = 0; i < count; ++i) {
+                TransformData& transform = transforms[i];
+                glm::mat4 matrix = glm::mat4_cast(transform.rotation);
+                matrix[0] *= transform.scale.x;
+                matrix[1] *= transform.scale.y;
+                matrix[2] *= transform.scale.z;
+                matrix[3] = glm::vec4(transform.position, 1.0f);
+                transform.worldMatrix = matrix;
+            }
+        }
+    };
+
+    class BoundsSystem : public BenchSystem<TransformData, BoundsData> {
+    public:
+        using BenchSystem::BenchSystem;
+
+    protected:
+        void UpdateChunk(float, size_t count, TransformData* transforms, BoundsData* bounds) override {
+            for (size_t i = 0; i < count; ++i) {
+                const glm::vec3 extent = transforms[i].scale * 0.5f;
+                bounds[i].min = transforms[i].position - extent;
+                bounds[i].max = transforms[i].position + extent;
+            }
+        }
+    };
+
+    class ListenerSystem : public BenchSystem<TransformData, ListenerData> {
+    public:
+        using BenchSystem::BenchSystem;
+
+    protected:
+        void UpdateChunk(float, size_t count, TransformData* transforms, ListenerData* listeners) override {
+            const glm::vec3 listener(0.0f, 64.0f, 0.0f);
+            for (size_t i = 0; i < count; ++i) {
+                const glm::vec3 offset = transforms[i].position - listener;
+                listeners[i].distance = std::sqrt(offset.x * offset.x + offset.y * offset.y + offset.z * offset.z);
+                listeners[i].gain = 1.0f / (1.0f + listeners[i].distance * 0.05f);
+            }
+        }
+    };
+
+    class AnimationSystem : public BenchSystem<AnimationData> {
+    public:
+        using BenchSystem::BenchSystem;
+
+    protected:
+        void UpdateChunk(float deltaTime, size_t count, AnimationData* animations) override {
+            for (size_t i = 0; i < count; ++i) {
+                AnimationData& animation = animations[i];
+                animation.phase = std::fmod(animation.phase + animation.speed * deltaTime, 6.2831853f);
+                for (int bone = 0; bone < 8; ++bone) {
+                    const float b = static_cast<float>(bone);
+                    animation.pose[bone] = std::sin(animation.phase + b * 0.7f) * std::cos(animation.phase * 0.5f - b);
+                }
+            }
+        }
+    };
+
+    class HealthSystem : public BenchSystem<HealthData> {
+    public:
+        using BenchSystem::BenchSystem;
+
+    protected:
+        void UpdateChunk(float deltaTime, size_t count, HealthData* healths) override {
+            for (size_t i = 0; i < count; ++i) {
+                healths[i].health = std::min(20.0f, healths[i].health + healths[i].regen * deltaTime);
+            }
+        }
+    };
+
+    struct Scene {
+        ArchetypeStorage storage;
+        std::vector<ArchetypeStorage::EntityHandle> entities;
+    };
+
+    void Populate(Scene& world, size_t count) {
+        std::mt19937 rng(99);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::uniform_real_distribution<float> spread(-300.0f, 300.0f);
+
+        for (size_t i = 0; i < count; ++i) {
+            const ArchetypeStorage::EntityHandle entity = world.storage.Create();
+
+            TransformData transform;
+            transform.position = glm::vec3(spread(rng), 64.0f + unit(rng) * 32.0f, spread(rng));
+            transform.scale = glm::vec3(0.5f + unit(rng));
+            world.storage.Add<TransformData>(entity, transform);
+            world.storage.Add<BoundsData>(entity);
+
+            // Mobs move, animate and have health; the rest are static props
+            if (unit(rng) < 0.75f) {
+                PhysicsData body;
+                body.velocity = glm::vec3(spread(rng), 0.0f, spread(rng)) * 0.01f;
+                body.drag = unit(rng) * 0.5f;
+                body.groundHeight = 60.0f;
+                world.storage.Add<PhysicsData>(entity, body);
+
+                AnimationData animation;
+                animation.speed = 0.5f + unit(rng) * 2.0f;
+                world.storage.Add<AnimationData>(entity, animation);
+                world.storage.Add<HealthData>(entity, HealthData{unit(rng) * 20.0f, 0.1f});
+            }
+            if (unit(rng) < 0.3f) {
+                world.storage.Add<ListenerData>(entity);
+            }
+
+            world.entities.push_back(entity);
+        }
+    }
+
+    SystemScheduler::SystemList MakeSystems(Scene& world, SystemScheduler& scheduler, bool parallelChunks) {
+        SystemScheduler::SystemList systems;
+
+        auto integrate = std::make_unique<IntegrateSystem>("Integrate", world.storage, scheduler, parallelChunks);
+        integrate->DeclareWrite<TransformData>();
+        integrate->DeclareWrite<PhysicsData>();
+        systems.push_back(std::move(integrate));
+
+        auto matrices = std::make_unique<MatrixSystem>("Matrices", world.storage, scheduler, parallelChunks);
+        matrices->DeclareWrite<TransformData>();
+        systems.push_back(std::move(matrices));
+
+        auto bounds = std::make_unique<BoundsSystem>("Bounds", world.storage, scheduler, parallelChunks);
+        bounds->DeclareRead<TransformData>();
+        bounds->DeclareWrite<BoundsData>();
+        systems.push_back(std::move(bounds));
+
+        auto listener = std::make_unique<ListenerSystem>("Listener", world.storage, scheduler, parallelChunks);
+        listener->DeclareRead<TransformData>();
+        listener->DeclareWrite<ListenerData>();
+        systems.push_back(std::move(listener));
+
+        auto animation = std::make_unique<AnimationSystem>("Animation", world.storage, scheduler, parallelChunks);
+        animation->DeclareWrite<AnimationData>();
+        systems.push_back(std::move(animation));
+
+        auto health = std::make_unique<HealthSystem>("Health", world.storage, scheduler, parallelChunks);
+        health->DeclareWrite<HealthData>();
+        systems.push_back(std::move(health));
+
+        return systems;
+    }
+
+    struct ModeResult {
+        std::vector<double> frameTimes;
+        double parallelism = 0.0;           // Mean busy / wall
+        std::string lastTrace;
+    };
+
+    ModeResult RunMode(Scene& world, WorkStealingPool* pool, bool parallelChunks, int frames) {
+        SystemScheduler scheduler;
+        scheduler.SetPool(pool);
+        SystemScheduler::SystemList systems = MakeSystems(world, scheduler, parallelChunks);
+
+        ModeResult result;
+        for (int frame = 0; frame < frames; ++frame) {
+            result.frameTimes.push_back(MeasureSeconds([&]() {
+                scheduler.Run(systems, SystemPhase::UPDATE, DELTA_TIME);
+            }));
+            const FrameTrace& trace = scheduler.GetLastTrace(SystemPhase::UPDATE);
+            result.parallelism += trace.wallMs > 0.0 ? trace.busyMs / trace.wallMs : 0.0;
+        }
+        result.parallelism /= std::max(1, frames);
+        result.lastTrace = scheduler.GetLastTrace(SystemPhase::UPDATE).ToString();
+        return result;
+    }
+
+    template<typename T>
+    bool Equal(const T& left, const T& right) {
+        return std::memcmp(&left, &right, sizeof(T)) == 0;
+    }
+
+    // PhysicsData ends in padding after its bools
+    bool Equal(const PhysicsData& left, const PhysicsData& right) {
+        return left.velocity == right.velocity && left.grounded == right.grounded;
+    }
+
+    template<typename T>
+    bool SameData(const Scene& a, const Scene& b, ArchetypeStorage::EntityHandle entity) {
+        const T* left = a.storage.Get<T>(entity);
+        const T* right = b.storage.Get<T>(entity);
+        if (!left || !right) {
+            return left == right;
+        }
+        return Equal(*left, *right);
+    }
+
+    size_t CountMismatches(const Scene& reference, const Scene& other) {
+        size_t mismatches = 0;
+        for (ArchetypeStorage::EntityHandle entity : reference.entities) {
+            const bool same = SameData<TransformData>(reference, other, entity) &&
+                              SameData<PhysicsData>(reference, other, entity) &&
+                              SameData<BoundsData>(reference, other, entity) &&
+                              SameData<ListenerData>(reference, other, entity) &&
+                              SameData<AnimationData>(reference, other, entity) &&
+                              SameData<HealthData>(reference, other, entity);
+            mismatches += same ? 0 : 1;
+        }
+        return mismatches;
+    }
+
+}
+
+int main(int argc, char** argv) {
+    const size_t entityCount = argc > 1 ? static_cast<size_t>(std::atoi(argv[1])) : 100000;
+    const int frames = argc > 2 ? std::atoi(argv[2]) : 120;
+    const size_t threads = argc > 3 ? static_cast<size_t>(std::atoi(argv[3])) : 0;
+
+    WorkStealingPool pool(threads);
+    pool.Initialize();
+
+    Scene serialWorld;
+    Scene dagWorld;
+    Scene chunkWorld;
+    Populate(serialWorld, entityCount);
+    Populate(dagWorld, entityCount);
+    Populate(chunkWorld, entityCount);
+
+    const ModeResult serial = RunMode(serialWorld, nullptr, false, frames);
+    const ModeResult dag = RunMode(dagWorld, &pool, false, frames);
+    const ModeResult chunks = RunMode(chunkWorld, &pool, true, frames);
+
+    pool.Shutdown();
+
+    const size_t dagMismatches = CountMismatches(serialWorld, dagWorld);
+    const size_t chunkMismatches = CountMismatches(serialWorld, chunkWorld);
+
+    PrintHeader("System scheduler: " + std::to_string(entityCount) + " entities, " + std::to_string(frames) +
+                " frames, " + std::to_string(pool.GetThreadCount()) + " workers");
+    PrintRow("serial p50", Percentile(serial.frameTimes, 50.0) * 1e3, "ms");
+    PrintRow("dag p50", Percentile(dag.frameTimes, 50.0) * 1e3, "ms");
+    PrintRow("dag+chunks p50", Percentile(chunks.frameTimes, 50.0) * 1e3, "ms");
+    PrintRow("dag+chunks p99", Percentile(chunks.frameTimes, 99.0) * 1e3, "ms");
+    PrintRow("dag system parallelism", dag.parallelism, "x");
+    PrintRow("dag+chunks speedup vs serial",
+             Percentile(serial.frameTimes, 50.0) / Percentile(chunks.frameTimes, 50.0), "x");
+
+    PrintHeader("Last dag frame");
+    std::printf("%s", dag.lastTrace.c_str());
+    PrintHeader("Last dag+chunks frame");
+    std::printf("%s", chunks.lastTrace.c_str());
+
+    if (dagMismatches != 0 || chunkMismatches != 0) {
+        std::printf("\nFAILED: %zu (dag) and %zu (dag+chunks) entities differ from the serial run\n",
+                    dagMismatches, chunkMismatches);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,427 @@
+/**
+ * @file TerrainBenchmark.cpp
+ * @brief Terrain generation: per-voxel noise vs. coarse-lattice density field
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * Generates the base terrain and caves of a square area of chunks
+ * (32x32 by default, 16x256x16 each) two ways:
+ *
+ *   per-voxel  TerrainGenerator's original path: climate noise read per
+ *              column (five generators, four times per column: twice in
+ *              GenerateHeight, then GetBiome in GenerateBaseTerrain and
+ *              ApplyBiomeModifications) and cave noise read for every voxel
+ *   density    ColumnClimateCache + ChunkDensityField: climate computed
+ *              once per 4x4 lattice column and shared with the neighbor
+ *              chunks, detail and cave noise sampled on a 4x8x4 lattice
+ *              and trilinearly interpolated
+ *
+ * Both paths are reproduced here with the same noise setup as
+ * TerrainGenerator::InitializeNoiseGenerators and FillClimateTile, since
+ * the generator itself needs the full world. Reported per path: average
+ * milliseconds per chunk (what TerrainStats::averageGenerationTime
+ * tracks), p95, noise samples per chunk, and how far the two surfaces
+ * are apart.
+ *
+ * Determinism check: the density area is generated again in reverse
+ * order with a fresh cache small enough to evict and rebuild tiles, and
+ * every chunk must match the first run byte for byte.
+ *
+ * Usage: TerrainBenchmark [area chunks per side] [seed]
+ */
+
+#include "BenchmarkCommon.hpp"
+
+#include "world/NoiseGenerator.hpp"
+#include "world/TerrainDensity.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace VoxelCraft;
+using namespace VoxelCraft::Benchmark;
+
+namespace {
+
+    constexpr int CHUNK_SIZE = 16;
+    constexpr int CHUNK_HEIGHT = 256;
+    constexpr size_t CHUNK_VOXELS = static_cast<size_t>(CHUNK_SIZE * CHUNK_SIZE * CHUNK_HEIGHT);
+
+    // TerrainParams defaults
+    constexpr float BASE_HEIGHT = 64.0f;
+    constexpr float HEIGHT_VARIATION = 32.0f;
+    constexpr float RIDGE_WEIGHT = 0.5f;
+
+    // TerrainGenerator::InitializeBiomes
+    struct BiomeEntry {
+        float temperature;
+        float humidity;
+        float heightVariation;
+    };
+
+    constexpr BiomeEntry BIOMES[] = {
+        {0.8f, 0.4f, 1.0f},     // plains
+        {2.0f, 0.0f, 0.8f},     // desert
+        {0.7f, 0.8f, 1.2f},     // forest
+        {0.2f, 0.3f, 2.5f},     // mountain
+        {0.5f, 1.0f, 0.1f},     // ocean
+        {0.8f, 1.0f, 0.9f},     // swamp
+        {-0.5f, 0.2f, 1.5f}     // snow
+    };
+
+    uint8_t FindClosestBiome(float temperature, float humidity) {
+        uint8_t best = 0;
+        float bestScore = std::numeric_limits<float>::max();
+        for (size_t i = 0; i < sizeof(BIOMES) / sizeof(BIOMES[0]); ++i) {
+            float tempDiff = std::abs(BIOMES[i].temperature - temperature);
+            float humidDiff = std::abs(BIOMES[i].humidity - humidity);
+            float score = tempDiff * tempDiff + humidDiff * humidDiff;
+            if (score < bestScore) {
+                bestScore = score;
+                best = static_cast<uint8_t>(i);
+            }
+        }
+        return best;
+    }
+
+    std::unique_ptr<NoiseGenerator> MakeNoise(uint64_t seed, int octaves, float persistence,
+                                              float lacunarity, float scale) {
+        NoiseConfig config = NoiseGeneratorFactory::GetDefaultConfig(NoiseType::Fractal,
+            static_cast<int>(static_cast<uint32_t>(seed ^ (seed >> 32))));
+        config.octaves = octaves;
+        config.persistence = persistence;
+        config.lacunarity = lacunarity;
+        config.frequency = scale;
+        return std::make_unique<NoiseGenerator>(config);
+    }
+
+    /**
+     * @brief The seven generators TerrainGenerator creates, with TerrainParams defaults
+     */
+    struct TerrainNoise {
+        std::unique_ptr<NoiseGenerator> terrain;
+        std::unique_ptr<NoiseGenerator> biome;
+        std::unique_ptr<NoiseGenerator> cave;
+        std::unique_ptr<NoiseGenerator> structure;
+        std::unique_ptr<NoiseGenerator> ridge;
+        std::unique_ptr<NoiseGenerator> temperature;
+        std::unique_ptr<NoiseGenerator> humidity;
+
+        explicit TerrainNoise(uint64_t master) {
+            // WorldSeed derivation
+            std::mt19937_64 gen(master);
+            uint64_t terrainSeed = gen();
+            uint64_t biomeSeed = gen();
+            uint64_t structureSeed = gen();
+            uint64_t caveSeed = gen();
+
+            terrain = MakeNoise(terrainSeed, 6, 0.5f, 2.0f, 0.01f);
+            biome = MakeNoise(biomeSeed, 4, 0.6f, 2.2f, 0.005f);
+            cave = MakeNoise(caveSeed, 3, 0.7f, 2.0f, 0.02f);
+            structure = MakeNoise(structureSeed, 2, 0.8f, 1.8f, 0.1f);
+            ridge = MakeNoise(terrainSeed + 1, 6, 0.5f, 2.0f, 0.005f);
+            temperature = MakeNoise(biomeSeed + 1, 4, 0.6f, 2.2f, 0.005f);
+            humidity = MakeNoise(biomeSeed + 2, 4, 0.6f, 2.2f, 0.005f);
+        }
+    };
+
+    float DepthAt(int64_t worldX, int64_t worldZ) {
+        return (static_cast<float>(worldX * worldZ % 100) / 100.0f + 1.0f) * 0.5f;
+    }
+
+    // ---------------------------------------------------------------------
+    // Per-voxel path (TerrainGenerator without useDensityField)
+    // ---------------------------------------------------------------------
+
+    ColumnClimate LegacyClimate(TerrainNoise& noise, int32_t worldX, int32_t worldZ) {
+        float x = static_cast<float>(worldX);
+        float z = static_cast<float>(worldZ);
+
+        ColumnClimate climate;
+        climate.temperature = (noise.temperature->GetNoise(x, 0.0f, z) + 1.0f) * 0.5f;
+        climate.humidity = (noise.humidity->GetNoise(x, 0.0f, z) + 1.0f) * 0.5f;
+        climate.continentalness = (noise.biome->GetNoise(x, 0.0f, z) + 1.0f) * 0.5f;
+        climate.erosion = (noise.structure->GetNoise(x, 100.0f, z) + 1.0f) * 0.5f;
+        climate.depth = DepthAt(worldX, worldZ);
+        climate.weirdness = (noise.ridge->GetNoise(x, 200.0f, z) + 1.0f) * 0.5f;
+        climate.biome = FindClosestBiome(climate.temperature, climate.humidity);
+        return climate;
+    }
+
+    float LegacyHeight(TerrainNoise& noise, int32_t worldX, int32_t worldZ) {
+        ColumnClimate region = LegacyClimate(noise, worldX, worldZ);
+
+        float x = static_cast<float>(worldX);
+        float z = static_cast<float>(worldZ);
+        float combined = noise.terrain->GetNoise(x, 0.0f, z) * (1.0f - RIDGE_WEIGHT) +
+                         noise.ridge->GetNoise(x, 0.0f, z) * RIDGE_WEIGHT;
+        combined *= BIOMES[region.biome].heightVariation;
+
+        // ApplyHeightModifications reads the region again
+        ColumnClimate modifiers = LegacyClimate(noise, worldX, worldZ);
+        combined *= (1.0f - modifiers.erosion * 0.5f) * (1.0f + modifiers.continentalness * 0.3f);
+        return BASE_HEIGHT + combined * HEIGHT_VARIATION;
+    }
+
+    void GenerateLegacyChunk(TerrainNoise& noise, int32_t chunkX, int32_t chunkZ, uint8_t* blocks) {
+        const int32_t originX = chunkX * CHUNK_SIZE;
+        const int32_t originZ = chunkZ * CHUNK_SIZE;
+
+        // GenerateHeightMap + GenerateBaseTerrain
+        for (int x = 0; x < CHUNK_SIZE; ++x) {
+            for (int z = 0; z < CHUNK_SIZE; ++z) {
+                float height = LegacyHeight(noise, originX + x, originZ + z);
+                int surface = static_cast<int>(std::min(std::max(height, 0.0f), 255.0f));
+
+                ColumnClimate biome = LegacyClimate(noise, originX + x, originZ + z);
+                DoNotOptimize(biome);
+
+                uint8_t* column = blocks + static_cast<size_t>((z * CHUNK_SIZE + x) * CHUNK_HEIGHT);
+                for (int y = 0; y < CHUNK_HEIGHT; ++y) {
+                    column[y] = y < surface - 3 ? 1 : (y < surface ? 2 : (y == surface ? 3 : 0));
+                }
+            }
+        }
+
+        // ApplyBiomeModifications
+        for (int x = 0; x < CHUNK_SIZE; ++x) {
+            for (int z = 0; z < CHUNK_SIZE; ++z) {
+                ColumnClimate biome = LegacyClimate(noise, originX + x, originZ + z);
+                DoNotOptimize(biome);
+            }
+        }
+
+        // GenerateCaveSystems
+        for (int x = 0; x < CHUNK_SIZE; ++x) {
+            for (int y = 0; y < CHUNK_HEIGHT; ++y) {
+                for (int z = 0; z < CHUNK_SIZE; ++z) {
+                    float cave = noise.cave->GetNoise(static_cast<float>(originX + x), static_cast<float>(y),
+                                                      static_cast<float>(originZ + z));
+                    float threshold = 0.8f - (static_cast<float>(y) / CHUNK_HEIGHT) * 0.3f;
+                    if (cave > threshold) {
+                        blocks[static_cast<size_t>((z * CHUNK_SIZE + x) * CHUNK_HEIGHT + y)] = 0;
+                    }
+                }
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------
+    // Density path (TerrainGenerator with useDensityField)
+    // ---------------------------------------------------------------------
+
+    void FillClimateTile(TerrainNoise& noise, int32_t worldX, int32_t worldZ, int spacing, int columns,
+                         ColumnClimate* out) {
+        const size_t count = static_cast<size_t>(columns * columns);
+        std::vector<float> temperature(count), humidity(count), continentalness(count);
+        std::vector<float> erosion(count), weirdness(count), base(count), ridge(count);
+
+        const float x = static_cast<float>(worldX);
+        const float z = static_cast<float>(worldZ);
+        const float step = static_cast<float>(spacing);
+        noise.temperature->FillGrid3D(temperature.data(), x, 0.0f, z, step, columns, 1, columns);
+        noise.humidity->FillGrid3D(humidity.data(), x, 0.0f, z, step, columns, 1, columns);
+        noise.biome->FillGrid3D(continentalness.data(), x, 0.0f, z, step, columns, 1, columns);
+        noise.structure->FillGrid3D(erosion.data(), x, 100.0f, z, step, columns, 1, columns);
+        noise.ridge->FillGrid3D(weirdness.data(), x, 200.0f, z, step, columns, 1, columns);
+        noise.terrain->FillGrid3D(base.data(), x, 0.0f, z, step, columns, 1, columns);
+        noise.ridge->FillGrid3D(ridge.data(), x, 0.0f, z, step, columns, 1, columns);
+
+        for (size_t i = 0; i < count; ++i) {
+            const int64_t columnX = worldX + static_cast<int32_t>(i % static_cast<size_t>(columns)) * spacing;
+            const int64_t columnZ = worldZ + static_cast<int32_t>(i / static_cast<size_t>(columns)) * spacing;
+
+            ColumnClimate& climate = out[i];
+            climate.temperature = (temperature[i] + 1.0f) * 0.5f;
+            climate.humidity = (humidity[i] + 1.0f) * 0.5f;
+            climate.continentalness = (continentalness[i] + 1.0f) * 0.5f;
+            climate.erosion = (erosion[i] + 1.0f) * 0.5f;
+            climate.depth = DepthAt(columnX, columnZ);
+            climate.weirdness = (weirdness[i] + 1.0f) * 0.5f;
+            climate.biome = FindClosestBiome(climate.temperature, climate.humidity);
+
+            float combined = base[i] * (1.0f - RIDGE_WEIGHT) + ridge[i] * RIDGE_WEIGHT;
+            combined *= BIOMES[climate.biome].heightVariation;
+            combined *= (1.0f - climate.erosion * 0.5f) * (1.0f + climate.continentalness * 0.3f);
+            climate.surfaceHeight = BASE_HEIGHT + combined * HEIGHT_VARIATION;
+        }
+    }
+
+    std::unique_ptr<ColumnClimateCache> MakeCache(TerrainNoise& noise, const DensityLatticeSettings& settings,
+                                                  size_t capacity) {
+        return std::make_unique<ColumnClimateCache>(settings, capacity,
+            [&noise](int32_t worldX, int32_t worldZ, int spacing, int columns, ColumnClimate* out) {
+                FillClimateTile(noise, worldX, worldZ, spacing, columns, out);
+            });
+    }
+
+    void GenerateDensityChunk(TerrainNoise& noise, ColumnClimateCache& cache, const DensityLatticeSettings& settings,
+                              int32_t chunkX, int32_t chunkZ, uint8_t* blocks) {
+        ChunkDensityField field(settings);
+
+        const int latticeColumns = field.GetLatticeColumns();
+        std::vector<ColumnClimate> columns(static_cast<size_t>(latticeColumns * latticeColumns));
+        cache.GetChunkColumns(chunkX, chunkZ, columns.data());
+
+        field.Sample(chunkX, chunkZ, columns.data(), noise.terrain.get(), noise.cave.get());
+        field.Rasterize(blocks);
+
+        for (int x = 0; x < CHUNK_SIZE; ++x) {
+            for (int z = 0; z < CHUNK_SIZE; ++z) {
+                uint8_t* column = blocks + static_cast<size_t>((z * CHUNK_SIZE + x) * CHUNK_HEIGHT);
+
+                int surface = CHUNK_HEIGHT - 1;
+                while (surface > 0 && !column[surface]) {
+                    --surface;
+                }
+                for (int y = 0; y <= surface; ++y) {
+                    if (column[y]) {
+                        column[y] = y == surface ? 3 : (y >= surface - 3 ? 2 : 1);
+                    }
+                }
+
+                // ApplyBiomeModifications reads the interpolated climate
+                ColumnClimate biome = cache.Sample(chunkX * CHUNK_SIZE + x, chunkZ * CHUNK_SIZE + z);
+                DoNotOptimize(biome);
+            }
+        }
+    }
+
+    // ---------------------------------------------------------------------
+
+    uint64_t HashChunk(const uint8_t* blocks) {
+        uint64_t hash = 1469598103934665603ull;
+        for (size_t i = 0; i < CHUNK_VOXELS; ++i) {
+            hash = (hash ^ blocks[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    int SurfaceAt(const uint8_t* blocks, int x, int z) {
+        const uint8_t* column = blocks + static_cast<size_t>((z * CHUNK_SIZE + x) * CHUNK_HEIGHT);
+        int surface = CHUNK_HEIGHT - 1;
+        while (surface > 0 && !column[surface]) {
+            --surface;
+        }
+        return surface;
+    }
+
+    struct AreaResult {
+        std::vector<double> chunkMs;
+        std::vector<uint64_t> hashes;
+        std::vector<int> surfaces;          // Top solid block per column of the whole area
+    };
+
+    template<typename Generate>
+    AreaResult RunArea(int area, bool reverse, Generate&& generate) {
+        AreaResult result;
+        const size_t chunkCount = static_cast<size_t>(area * area);
+        result.chunkMs.reserve(chunkCount);
+        result.hashes.assign(chunkCount, 0);
+        result.surfaces.assign(chunkCount * CHUNK_SIZE * CHUNK_SIZE, 0);
+
+        std::vector<uint8_t> blocks(CHUNK_VOXELS);
+        for (size_t step = 0; step < chunkCount; ++step) {
+            size_t index = reverse ? chunkCount - 1 - step : step;
+            int32_t chunkX = static_cast<int32_t>(index % static_cast<size_t>(area)) - area / 2;
+            int32_t chunkZ = static_cast<int32_t>(index / static_cast<size_t>(area)) - area / 2;
+
+            double seconds = MeasureSeconds([&]() { generate(chunkX, chunkZ, blocks.data()); });
+            result.chunkMs.push_back(seconds * 1000.0);
+            result.hashes[index] = HashChunk(blocks.data());
+
+            for (int z = 0; z < CHUNK_SIZE; ++z) {
+                for (int x = 0; x < CHUNK_SIZE; ++x) {
+                    result.surfaces[index * CHUNK_SIZE * CHUNK_SIZE + static_cast<size_t>(z * CHUNK_SIZE + x)] =
+                        SurfaceAt(blocks.data(), x, z);
+                }
+            }
+        }
+        return result;
+    }
+
+    double Average(const std::vector<double>& values) {
+        double sum = 0.0;
+        for (double value : values) {
+            sum += value;
+        }
+        return values.empty() ? 0.0 : sum / static_cast<double>(values.size());
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int area = argc > 1 ? std::max(1, std::atoi(argv[1])) : 32;
+    const uint64_t seed = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 12345;
+    const size_t chunkCount = static_cast<size_t>(area * area);
+
+    TerrainNoise noise(seed);
+    DensityLatticeSettings settings;
+
+    std::printf("Terrain generation, %dx%d chunks of %dx%dx%d, seed %llu\n", area, area,
+                CHUNK_SIZE, CHUNK_HEIGHT, CHUNK_SIZE, static_cast<unsigned long long>(seed));
+
+    AreaResult legacy = RunArea(area, false, [&](int32_t chunkX, int32_t chunkZ, uint8_t* blocks) {
+        GenerateLegacyChunk(noise, chunkX, chunkZ, blocks);
+    });
+
+    auto cache = MakeCache(noise, settings, 4096);
+    AreaResult density = RunArea(area, false, [&](int32_t chunkX, int32_t chunkZ, uint8_t* blocks) {
+        GenerateDensityChunk(noise, *cache, settings, chunkX, chunkZ, blocks);
+    });
+    const uint64_t tilesBuilt = cache->GetTilesBuilt();
+
+    // Same area backwards through a cache that has to evict and rebuild tiles
+    auto smallCache = MakeCache(noise, settings, 16);
+    AreaResult reversed = RunArea(area, true, [&](int32_t chunkX, int32_t chunkZ, uint8_t* blocks) {
+        GenerateDensityChunk(noise, *smallCache, settings, chunkX, chunkZ, blocks);
+    });
+    for (size_t i = 0; i < chunkCount; ++i) {
+        if (density.hashes[i] != reversed.hashes[i]) {
+            std::printf("FAILED: chunk %zu differs when generated in reverse order with tile eviction\n", i);
+            return 1;
+        }
+    }
+
+    ChunkDensityField field(settings);
+    const double legacyMs = Average(legacy.chunkMs);
+    const double densityMs = Average(density.chunkMs);
+
+    PrintHeader("Per-voxel noise");
+    PrintRow("average per chunk", legacyMs, "ms");
+    PrintRow("p95 per chunk", Percentile(legacy.chunkMs, 95.0), "ms");
+    PrintRow("area total", legacyMs * static_cast<double>(chunkCount) / 1000.0, "s");
+    PrintRow("noise samples per chunk", static_cast<double>(CHUNK_SIZE * CHUNK_SIZE * 22 + CHUNK_VOXELS), "samples");
+
+    PrintHeader("Density field, 4x8x4 lattice");
+    PrintRow("average per chunk", densityMs, "ms");
+    PrintRow("p95 per chunk", Percentile(density.chunkMs, 95.0), "ms");
+    PrintRow("area total", densityMs * static_cast<double>(chunkCount) / 1000.0, "s");
+    PrintRow("noise samples per chunk",
+             static_cast<double>(field.GetSampleCount() * 2) +
+             static_cast<double>(tilesBuilt * 7 * 16) / static_cast<double>(chunkCount), "samples");
+    PrintRow("climate tiles built per chunk", static_cast<double>(tilesBuilt) / static_cast<double>(chunkCount), "tiles");
+
+    double surfaceDiff = 0.0;
+    double legacySurface = 0.0;
+    double densitySurface = 0.0;
+    for (size_t i = 0; i < legacy.surfaces.size(); ++i) {
+        surfaceDiff += std::abs(legacy.surfaces[i] - density.surfaces[i]);
+        legacySurface += legacy.surfaces[i];
+        densitySurface += density.surfaces[i];
+    }
+    const double columns = static_cast<double>(legacy.surfaces.size());
+
+    PrintHeader("Comparison");
+    PrintRow("averageGenerationTime speedup", legacyMs / densityMs, "x");
+    PrintRow("mean surface, per-voxel", legacySurface / columns, "blocks");
+    PrintRow("mean surface, density", densitySurface / columns, "blocks");
+    PrintRow("mean surface difference", surfaceDiff / columns, "blocks");
+    std::printf("\nDeterministic across generation order and tile eviction: yes\n");
+    return 0;
+}
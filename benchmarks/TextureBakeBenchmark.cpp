@@ -0,0 +1,391 @@
+/**
+ * @file TextureBakeBenchmark.cpp
+ * @brief Texture atlas baking: serial generation vs. parallel bake with a disk cache
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * Bakes a block atlas of procedural tiles (256 by default, 64x64 RGBA8
+ * with a full mip chain) three ways:
+ *
+ *   serial     what startup did before: every tile composed pixel by
+ *              pixel on the calling thread, every run
+ *   cold       TextureGenerator::BakeAtlas with an empty disk cache: one
+ *              ThreadPool task per tile, each tile stored under the hash
+ *              of its definition
+ *   warm       the same bake again, every tile loaded from the cache
+ *
+ * Tiles are composed by a local stand-in for GenerateLayerTexture and
+ * BlendTextures (fBm value noise per layer, two colors, normal and
+ * multiply blends), since the generator itself needs the renderer's
+ * math and image utilities. Cache keys come from TextureHasher over the
+ * same kind of fields TextureGenerator::HashTextureDefinition covers.
+ *
+ * Mip chains are timed separately: the scalar reference box filter vs.
+ * TextureMipmaps::DownsampleRGBA8 on a 2048x2048 atlas.
+ *
+ * Correctness checks: warm tiles must equal cold tiles byte for byte, the
+ * SIMD mip chain must equal the scalar one, and a truncated cache entry
+ * must be rejected. Any failure prints FAILED and exits with 1.
+ *
+ * Usage: TextureBakeBenchmark [tile count] [tile size] [threads]
+ */
+
+#include "BenchmarkCommon.hpp"
+
+#include "core/ThreadPool.hpp"
+#include "textures/TextureDiskCache.hpp"
+#include "textures/TextureMipmaps.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace VoxelCraft;
+using namespace VoxelCraft::Benchmark;
+
+namespace {
+
+    constexpr uint32_t GENERATOR_VERSION = 1;
+
+    struct LayerDef {
+        float frequency = 4.0f;
+        int octaves = 4;
+        float persistence = 0.5f;
+        uint32_t seed = 0;
+        float baseColor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+        float secondaryColor[4] = { 0.5f, 0.5f, 0.5f, 1.0f };
+        bool multiply = false;
+        float opacity = 1.0f;
+    };
+
+    struct TileDef {
+        int size = 64;
+        std::vector<LayerDef> layers;
+    };
+
+    std::vector<TileDef> MakeDefinitions(int count, int size) {
+        std::mt19937 rng(4242);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::vector<TileDef> definitions(static_cast<size_t>(count));
+        for (auto& definition : definitions) {
+            definition.size = size;
+            definition.layers.resize(2 + rng() % 3);
+            for (size_t i = 0; i < definition.layers.size(); ++i) {
+                auto& layer = definition.layers[i];
+                layer.frequency = 2.0f + unit(rng) * 14.0f;
+                layer.octaves = 3 + static_cast<int>(rng() % 4);
+                layer.persistence = 0.35f + unit(rng) * 0.3f;
+                layer.seed = static_cast<uint32_t>(rng());
+                for (int c = 0; c < 3; ++c) {
+                    layer.baseColor[c] = unit(rng);
+                    layer.secondaryColor[c] = unit(rng);
+                }
+                layer.multiply = i > 0 && (rng() & 1) != 0;
+                layer.opacity = i == 0 ? 1.0f : 0.4f + unit(rng) * 0.6f;
+            }
+        }
+        return definitions;
+    }
+
+    uint64_t HashDefinition(const TileDef& definition, uint32_t seed) {
+        TextureHasher hasher;
+        hasher.Add(GENERATOR_VERSION).Add(TextureDiskCache::FORMAT_VERSION).Add(seed);
+        hasher.Add(static_cast<int32_t>(definition.size)).Add(true);
+        hasher.Add(static_cast<uint64_t>(definition.layers.size()));
+        for (const auto& layer : definition.layers) {
+            hasher.Add(layer.frequency).Add(static_cast<int32_t>(layer.octaves)).Add(layer.persistence).Add(layer.seed);
+            for (int c = 0; c < 4; ++c) {
+                hasher.Add(layer.baseColor[c]).Add(layer.secondaryColor[c]);
+            }
+            hasher.Add(layer.multiply).Add(layer.opacity);
+        }
+        return hasher.Get();
+    }
+
+    uint32_t HashLattice(int x, int y, uint32_t seed) {
+        uint32_t h = seed ^ (static_cast<uint32_t>(x) * 0x27d4eb2du) ^ (static_cast<uint32_t>(y) * 0x165667b1u);
+        h ^= h >> 15;
+        h *= 0x85ebca6bu;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35u;
+        h ^= h >> 16;
+        return h;
+    }
+
+    // Tileable value noise: the lattice wraps every period cells
+    float ValueNoise(float x, float y, int period, uint32_t seed) {
+        int x0 = static_cast<int>(std::floor(x));
+        int y0 = static_cast<int>(std::floor(y));
+        float fx = x - static_cast<float>(x0);
+        float fy = y - static_cast<float>(y0);
+        fx = fx * fx * (3.0f - 2.0f * fx);
+        fy = fy * fy * (3.0f - 2.0f * fy);
+
+        auto corner = [&](int cx, int cy) {
+            cx = ((cx % period) + period) % period;
+            cy = ((cy % period) + period) % period;
+            return static_cast<float>(HashLattice(cx, cy, seed) & 0xffffu) / 65535.0f;
+        };
+        float a = corner(x0, y0);
+        float b = corner(x0 + 1, y0);
+        float c = corner(x0, y0 + 1);
+        float d = corner(x0 + 1, y0 + 1);
+        float top = a + (b - a) * fx;
+        float bottom = c + (d - c) * fx;
+        return top + (bottom - top) * fy;
+    }
+
+    std::vector<uint8_t> ComposeTile(const TileDef& definition, uint32_t seed) {
+        const int size = definition.size;
+        std::vector<float> color(static_cast<size_t>(size) * static_cast<size_t>(size) * 4, 0.0f);
+
+        for (const auto& layer : definition.layers) {
+            for (int y = 0; y < size; ++y) {
+                for (int x = 0; x < size; ++x) {
+                    float value = 0.0f;
+                    float amplitude = 1.0f;
+                    float total = 0.0f;
+                    int period = std::max(1, static_cast<int>(layer.frequency));
+                    for (int octave = 0; octave < layer.octaves; ++octave) {
+                        float u = static_cast<float>(x) / static_cast<float>(size) * static_cast<float>(period);
+                        float v = static_cast<float>(y) / static_cast<float>(size) * static_cast<float>(period);
+                        value += ValueNoise(u, v, period, layer.seed ^ seed ^ static_cast<uint32_t>(octave)) * amplitude;
+                        total += amplitude;
+                        amplitude *= layer.persistence;
+                        period *= 2;
+                    }
+                    value /= total;
+
+                    float* out = &color[(static_cast<size_t>(y) * static_cast<size_t>(size) + static_cast<size_t>(x)) * 4];
+                    for (int c = 0; c < 4; ++c) {
+                        float layerColor = layer.baseColor[c] + (layer.secondaryColor[c] - layer.baseColor[c]) * value;
+                        float blended = layer.multiply ? out[c] * layerColor : layerColor;
+                        out[c] += (blended - out[c]) * layer.opacity;
+                    }
+                }
+            }
+        }
+
+        std::vector<uint8_t> pixels(color.size());
+        for (size_t i = 0; i < color.size(); ++i) {
+            float clamped = std::min(1.0f, std::max(0.0f, color[i]));
+            pixels[i] = static_cast<uint8_t>(clamped * 255.0f + 0.5f);
+        }
+        TextureMipmaps::BuildChainRGBA8(pixels, size, size);
+        return pixels;
+    }
+
+    struct BakeResult {
+        std::vector<std::vector<uint8_t>> tiles;
+        int loaded = 0;
+        int generated = 0;
+    };
+
+    // Mirrors TextureGenerator::BakeAtlas/ProduceTexture: one task per tile,
+    // each writing only its own slot
+    BakeResult Bake(const std::vector<TileDef>& definitions, uint32_t seed, ThreadPool* pool, TextureDiskCache* cache) {
+        BakeResult result;
+        result.tiles.resize(definitions.size());
+        std::vector<uint8_t> fromDisk(definitions.size(), 0);
+
+        auto bakeTile = [&](size_t index) {
+            const TileDef& definition = definitions[index];
+            const size_t baseSize = static_cast<size_t>(definition.size) * static_cast<size_t>(definition.size) * 4;
+            const uint64_t key = cache ? HashDefinition(definition, seed) : 0;
+
+            if (cache) {
+                TextureDiskCache::Image image;
+                if (cache->Load(key, image) && image.width == definition.size &&
+                    image.height == definition.size && image.pixels.size() >= baseSize) {
+                    result.tiles[index] = std::move(image.pixels);
+                    fromDisk[index] = 1;
+                    return;
+                }
+            }
+
+            result.tiles[index] = ComposeTile(definition, seed);
+
+            if (cache) {
+                TextureDiskCache::Image image;
+                image.width = definition.size;
+                image.height = definition.size;
+                image.mipLevels = TextureMipmaps::LevelCount(definition.size, definition.size);
+                image.pixels = result.tiles[index];
+                cache->Store(key, image);
+            }
+        };
+
+        if (pool && pool->IsRunning()) {
+            std::vector<std::future<void>> futures;
+            futures.reserve(definitions.size());
+            for (size_t i = 0; i < definitions.size(); ++i) {
+                futures.push_back(pool->SubmitTask([&bakeTile, i]() { bakeTile(i); },
+                    ThreadPool::TaskPriority::HIGH, "BakeAtlasTile"));
+            }
+            for (auto& future : futures) {
+                future.get();
+            }
+        } else {
+            for (size_t i = 0; i < definitions.size(); ++i) {
+                bakeTile(i);
+            }
+        }
+
+        for (uint8_t loaded : fromDisk) {
+            if (loaded) {
+                result.loaded++;
+            } else {
+                result.generated++;
+            }
+        }
+        return result;
+    }
+
+    void BuildChainScalar(std::vector<uint8_t>& pixels, int width, int height) {
+        pixels.resize(TextureMipmaps::ChainSize(width, height));
+        size_t offset = 0;
+        while (width > 1 || height > 1) {
+            const size_t levelSize = static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+            TextureMipmaps::DownsampleRGBA8Scalar(pixels.data() + offset, width, height,
+                                                  pixels.data() + offset + levelSize);
+            offset += levelSize;
+            width = std::max(1, width / 2);
+            height = std::max(1, height / 2);
+        }
+    }
+
+    bool CheckOddSizes() {
+        std::mt19937 rng(99);
+        const int sizes[][2] = { { 1, 1 }, { 3, 5 }, { 17, 9 }, { 33, 2 }, { 1, 40 }, { 61, 61 } };
+        for (const auto& size : sizes) {
+            std::vector<uint8_t> base(static_cast<size_t>(size[0]) * static_cast<size_t>(size[1]) * 4);
+            for (auto& byte : base) {
+                byte = static_cast<uint8_t>(rng());
+            }
+            std::vector<uint8_t> simd = base;
+            std::vector<uint8_t> scalar = base;
+            TextureMipmaps::BuildChainRGBA8(simd, size[0], size[1]);
+            BuildChainScalar(scalar, size[0], size[1]);
+            if (simd != scalar) {
+                std::printf("  mip chain mismatch at %dx%d\n", size[0], size[1]);
+                return false;
+            }
+        }
+        return true;
+    }
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int tileCount = argc > 1 ? std::max(1, std::atoi(argv[1])) : 256;
+    const int tileSize = argc > 2 ? std::max(1, std::atoi(argv[2])) : 64;
+    const size_t threads = argc > 3 ? static_cast<size_t>(std::max(0, std::atoi(argv[3]))) : 0;
+    const uint32_t seed = 12345;
+
+    const auto definitions = MakeDefinitions(tileCount, tileSize);
+
+    const auto directory = std::filesystem::temp_directory_path() /
+        ("voxelcraft_texture_bench_" + std::to_string(Clock::now().time_since_epoch().count()));
+    bool ok = true;
+
+    std::printf("Texture bake: %d tiles of %dx%d RGBA8, mip chain %zu bytes per tile, SIMD mips: %s\n",
+                tileCount, tileSize, tileSize, TextureMipmaps::ChainSize(tileSize, tileSize),
+                TextureMipmaps::IsVectorized() ? "SSE2" : "scalar");
+
+    PrintHeader("Atlas bake");
+
+    BakeResult serial;
+    double serialSeconds = MeasureSeconds([&]() { serial = Bake(definitions, seed, nullptr, nullptr); });
+    PrintRow("serial, no cache (previous startup)", serialSeconds * 1e3, "ms");
+
+    ThreadPool pool(threads);
+    pool.Initialize();
+    std::printf("  (thread pool: %zu workers)\n", pool.GetThreadCount());
+
+    BakeResult parallel;
+    double parallelSeconds = MeasureSeconds([&]() { parallel = Bake(definitions, seed, &pool, nullptr); });
+    PrintRow("parallel, no cache", parallelSeconds * 1e3, "ms");
+
+    TextureDiskCache cache(directory.string());
+    BakeResult cold;
+    double coldSeconds = MeasureSeconds([&]() { cold = Bake(definitions, seed, &pool, &cache); });
+    PrintRow("cold start (parallel, cache empty)", coldSeconds * 1e3, "ms");
+
+    // A fresh cache object, as on the next launch
+    TextureDiskCache warmCache(directory.string());
+    BakeResult warm;
+    double warmSeconds = MeasureSeconds([&]() { warm = Bake(definitions, seed, &pool, &warmCache); });
+    PrintRow("warm start (parallel, all tiles cached)", warmSeconds * 1e3, "ms");
+
+    PrintRow("cold tiles generated", cold.generated, "tiles");
+    PrintRow("warm tiles loaded", warm.loaded, "tiles");
+    PrintRow("parallel speedup vs serial", serialSeconds / parallelSeconds, "x");
+    PrintRow("warm speedup vs serial", serialSeconds / warmSeconds, "x");
+
+    if (parallel.tiles != serial.tiles || cold.tiles != serial.tiles || warm.tiles != serial.tiles) {
+        std::printf("  tiles differ between serial, parallel, cold and warm bakes\n");
+        ok = false;
+    }
+    if (cold.generated != tileCount || warm.loaded != tileCount) {
+        std::printf("  expected %d generated cold and %d loaded warm\n", tileCount, tileCount);
+        ok = false;
+    }
+
+    // A truncated entry must miss and be regenerated
+    {
+        const std::string path = warmCache.GetPath(HashDefinition(definitions[0], seed));
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+        TextureDiskCache damaged(directory.string());
+        BakeResult repaired = Bake(definitions, seed, nullptr, &damaged);
+        if (damaged.GetStats().rejected != 1 || repaired.generated != 1 || repaired.tiles != serial.tiles) {
+            std::printf("  truncated cache entry was not rejected and regenerated\n");
+            ok = false;
+        }
+    }
+
+    pool.Shutdown();
+
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+
+    PrintHeader("Mip chain (2048x2048 atlas)");
+
+    std::vector<uint8_t> atlas(static_cast<size_t>(2048) * 2048 * 4);
+    std::mt19937 rng(7);
+    for (auto& byte : atlas) {
+        byte = static_cast<uint8_t>(rng());
+    }
+
+    std::vector<uint8_t> scalarChain;
+    std::vector<uint8_t> simdChain;
+    double scalarSeconds = MeasureBestSeconds(5, [&]() {
+        scalarChain = atlas;
+        BuildChainScalar(scalarChain, 2048, 2048);
+        DoNotOptimize(scalarChain.data());
+    });
+    double simdSeconds = MeasureBestSeconds(5, [&]() {
+        simdChain = atlas;
+        TextureMipmaps::BuildChainRGBA8(simdChain, 2048, 2048);
+        DoNotOptimize(simdChain.data());
+    });
+    PrintRow("scalar box filter", scalarSeconds * 1e3, "ms");
+    PrintRow("DownsampleRGBA8", simdSeconds * 1e3, "ms");
+    PrintRow("speedup", scalarSeconds / simdSeconds, "x");
+
+    if (simdChain != scalarChain || !CheckOddSizes()) {
+        std::printf("  SIMD mip chain differs from the scalar reference\n");
+        ok = false;
+    }
+
+    if (!ok) {
+        std::printf("\nFAILED\n");
+        return 1;
+    }
+    return 0;
+}
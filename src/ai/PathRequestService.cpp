@@ -0,0 +1,575 @@
+/**
+ * @file PathRequestService.cpp
+ * @brief VoxelCraft Shared Path Requests Implementation
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#include "PathRequestService.hpp"
+#include "../core/WorkStealingPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace VoxelCraft {
+
+    namespace {
+
+        // A block change this close to a cell can change the moves out of it
+        const glm::ivec3 CHANGE_MARGIN_LOW(2, 2, 2);
+        const glm::ivec3 CHANGE_MARGIN_HIGH(2, PathfindingGrid::MAX_DROP, 2);
+
+        // Block changes remembered for running searches; past this, every
+        // running search is treated as stale
+        constexpr size_t MAX_TRACKED_CHANGES = 4096;
+
+        // Ticks between sweeps of the path cache
+        constexpr uint32_t CACHE_SWEEP_TICKS = 16;
+
+        int FloorDiv(int value, int divisor) {
+            return value >= 0 ? value / divisor : (value - divisor + 1) / divisor;
+        }
+
+        bool InBounds(const glm::ivec3& position, const glm::ivec3& low, const glm::ivec3& high) {
+            return position.x >= low.x && position.x <= high.x &&
+                   position.y >= low.y && position.y <= high.y &&
+                   position.z >= low.z && position.z <= high.z;
+        }
+
+        void PathBounds(const std::vector<glm::ivec3>& path, glm::ivec3& low, glm::ivec3& high) {
+            low = high = path.front();
+            for (const glm::ivec3& position : path) {
+                low = glm::min(low, position);
+                high = glm::max(high, position);
+            }
+            low -= CHANGE_MARGIN_LOW;
+            high += CHANGE_MARGIN_HIGH;
+        }
+
+    } // namespace
+
+    // FlowField implementation
+    FlowField::FlowField(const PathfindingGrid& grid, const glm::ivec3& goal, int radius, int maxNodes)
+        : m_goal(goal), m_boundsMin(goal), m_boundsMax(goal) {
+        glm::ivec3 predecessors[PathfindingGrid::MAX_PREDECESSORS];
+
+        // Dijkstra from the goal over reversed moves; parent is the next step
+        bool created;
+        const int32_t goalIndex = m_arena.GetOrCreate(goal, created);
+        m_arena.GetNode(goalIndex).gCost = 0.0f;
+        m_arena.GetNode(goalIndex).fCost = 0.0f;
+        m_arena.PushOrDecrease(goalIndex);
+
+        int settled = 0;
+        while (!m_arena.IsOpenEmpty() && settled < maxNodes) {
+            const int32_t current = m_arena.PopMin();
+            PathSearchArena::Node& node = m_arena.GetNode(current);
+            node.closed = true;
+            settled++;
+
+            const glm::ivec3 position = node.position;
+            const float gCost = node.gCost;
+
+            const int count = grid.GetPredecessors(position, predecessors);
+            for (int i = 0; i < count; ++i) {
+                const glm::ivec3& from = predecessors[i];
+                if (std::abs(from.x - goal.x) > radius || std::abs(from.z - goal.z) > radius) {
+                    continue;
+                }
+
+                bool isNew;
+                const int32_t index = m_arena.GetOrCreate(from, isNew);
+                PathSearchArena::Node& neighbor = m_arena.GetNode(index);
+                const float tentative = gCost + grid.GetMovementCost(from, position);
+                if (isNew || (!neighbor.closed && tentative < neighbor.gCost)) {
+                    neighbor.gCost = tentative;
+                    neighbor.fCost = tentative;
+                    neighbor.parent = current;
+                    m_arena.PushOrDecrease(index);
+                }
+            }
+        }
+
+        for (size_t i = 0; i < m_arena.GetNodeCount(); ++i) {
+            const glm::ivec3& position = m_arena.GetNode(static_cast<int32_t>(i)).position;
+            m_boundsMin = glm::min(m_boundsMin, position);
+            m_boundsMax = glm::max(m_boundsMax, position);
+        }
+        m_boundsMin -= CHANGE_MARGIN_LOW;
+        m_boundsMax += CHANGE_MARGIN_HIGH;
+    }
+
+    bool FlowField::GetPath(const glm::ivec3& start, std::vector<glm::ivec3>& path) const {
+        path.clear();
+        const int32_t index = m_arena.Find(start);
+        if (index < 0) {
+            return false;
+        }
+
+        for (int32_t i = index; i >= 0; i = m_arena.GetNode(i).parent) {
+            path.push_back(m_arena.GetNode(i).position);
+        }
+        return true;
+    }
+
+    bool FlowField::IsAffectedBy(const glm::ivec3& position) const {
+        return InBounds(position, m_boundsMin, m_boundsMax);
+    }
+
+    // PathRequestService implementation
+    size_t PathRequestService::SearchKeyHash::operator()(const SearchKey& key) const {
+        uint64_t h = static_cast<uint64_t>(static_cast<uint32_t>(key.start.x)) * 0x9E3779B97F4A7C15ull;
+        h ^= static_cast<uint64_t>(static_cast<uint32_t>(key.start.z)) * 0xC2B2AE3D27D4EB4Full;
+        h ^= static_cast<uint64_t>(static_cast<uint32_t>(key.start.y)) * 0x165667B19E3779F9ull;
+        h ^= key.region * 0xD6E8FEB86659FD93ull;
+        return static_cast<size_t>(h ^ (h >> 29));
+    }
+
+    PathRequestService::PathRequestService(World* world, WorkStealingPool* pool, const PathRequestConfig& config)
+        : m_config(config), m_world(world), m_pool(pool),
+          m_grid(std::make_unique<PathfindingGrid>(world)),
+          m_tick(0), m_blockEpoch(0), m_staleBeforeEpoch(0), m_jobsOutstanding(0), m_stats{},
+          m_nextId(1), m_jobsRunning(0) {
+        m_portalGraph = std::make_shared<ChunkPortalGraph>(*m_grid);
+    }
+
+    PathRequestService::PathRequestService(PathfindingGrid::BlockQuery blockQuery, WorkStealingPool* pool,
+                                           const PathRequestConfig& config)
+        : m_config(config), m_world(nullptr), m_blockQuery(blockQuery), m_pool(pool),
+          m_grid(std::make_unique<PathfindingGrid>(std::move(blockQuery))),
+          m_tick(0), m_blockEpoch(0), m_staleBeforeEpoch(0), m_jobsOutstanding(0), m_stats{},
+          m_nextId(1), m_jobsRunning(0) {
+        m_portalGraph = std::make_shared<ChunkPortalGraph>(*m_grid);
+    }
+
+    PathRequestService::~PathRequestService() {
+        // Running jobs point back at this service
+        std::unique_lock<std::mutex> lock(m_completedMutex);
+        m_completedCondition.wait(lock, [this]() { return m_jobsRunning == 0; });
+    }
+
+    PathRequestService::RequestId PathRequestService::RequestPath(const glm::vec3& start, const glm::vec3& goal,
+                                                                  PathCallback callback) {
+        Request request;
+        request.start = start;
+        request.goal = goal;
+        request.callback = std::move(callback);
+
+        std::lock_guard<std::mutex> lock(m_incomingMutex);
+        const RequestId id = m_nextId++;
+        m_incoming.emplace_back(id, std::move(request));
+        return id;
+    }
+
+    void PathRequestService::CancelRequest(RequestId id) {
+        std::lock_guard<std::mutex> lock(m_incomingMutex);
+        m_cancelled.push_back(id);
+    }
+
+    void PathRequestService::OnBlockChanged(int x, int y, int z) {
+        std::lock_guard<std::mutex> lock(m_incomingMutex);
+        m_changes.emplace_back(x, y, z);
+    }
+
+    void PathRequestService::Tick() {
+        m_tick++;
+
+        TakeIncoming();
+        ApplyBlockChanges();
+        CollectResults();
+        ScheduleRequests();
+
+        // Searches that finished meanwhile (all of them without a pool)
+        CollectResults();
+        EvictExpired();
+
+        if (m_jobsOutstanding == 0) {
+            m_recentChanges.clear();
+        }
+    }
+
+    PathRequestService::Stats PathRequestService::GetStats() const {
+        Stats stats = m_stats;
+        stats.pending = m_requests.size();
+        return stats;
+    }
+
+    uint64_t PathRequestService::RegionKey(const glm::ivec3& goal) const {
+        const int size = std::max(1, m_config.goalRegionSize);
+        return (static_cast<uint64_t>(static_cast<uint32_t>(FloorDiv(goal.x, size)) & 0x1FFFFF) << 42) |
+               (static_cast<uint64_t>(static_cast<uint32_t>(FloorDiv(goal.z, size)) & 0x1FFFFF) << 21) |
+               (static_cast<uint64_t>(static_cast<uint32_t>(FloorDiv(goal.y, size)) & 0x1FFFFF));
+    }
+
+    void PathRequestService::ResolveRequest(Request& request) const {
+        request.startCell = glm::round(request.start);
+        request.goalCell = glm::round(request.goal);
+        request.startCell.y = m_grid->FindGroundLevel(request.startCell);
+        request.goalCell.y = m_grid->FindGroundLevel(request.goalCell);
+        request.region = RegionKey(request.goalCell);
+        request.resolved = true;
+    }
+
+    void PathRequestService::TakeIncoming() {
+        std::vector<std::pair<RequestId, Request>> incoming;
+        std::vector<RequestId> cancelled;
+        {
+            std::lock_guard<std::mutex> lock(m_incomingMutex);
+            incoming.swap(m_incoming);
+            cancelled.swap(m_cancelled);
+        }
+
+        for (auto& entry : incoming) {
+            m_requests.emplace(entry.first, std::move(entry.second));
+            m_pending.push_back(entry.first);
+        }
+        m_stats.requests += incoming.size();
+
+        // Queued IDs of cancelled requests are skipped when reached
+        for (RequestId id : cancelled) {
+            m_requests.erase(id);
+        }
+    }
+
+    void PathRequestService::ApplyBlockChanges() {
+        std::vector<glm::ivec3> changes;
+        {
+            std::lock_guard<std::mutex> lock(m_incomingMutex);
+            changes.swap(m_changes);
+        }
+
+        for (const glm::ivec3& position : changes) {
+            m_blockEpoch++;
+            if (m_jobsOutstanding > 0) {
+                m_recentChanges.push_back({m_blockEpoch, position});
+            }
+
+            m_portalGraph->InvalidateChunk(position.x >> 4, position.z >> 4);
+
+            for (auto& entry : m_regions) {
+                GoalRegion& region = entry.second;
+                if (region.field && region.field->IsAffectedBy(position)) {
+                    region.field.reset();
+                    m_stats.invalidated++;
+                }
+            }
+
+            for (auto it = m_pathCache.begin(); it != m_pathCache.end();) {
+                if (InBounds(position, it->second.boundsMin, it->second.boundsMax)) {
+                    it = m_pathCache.erase(it);
+                    m_stats.invalidated++;
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        if (m_recentChanges.size() > MAX_TRACKED_CHANGES) {
+            m_staleBeforeEpoch = m_blockEpoch;
+            m_recentChanges.clear();
+        }
+    }
+
+    void PathRequestService::ScheduleRequests() {
+        using Clock = std::chrono::steady_clock;
+        const Clock::time_point begin = Clock::now();
+        const auto budget = std::chrono::duration<float, std::milli>(m_config.tickBudgetMs);
+
+        int started = 0;
+        size_t examined = 0;
+        std::vector<RequestId> deferred;
+
+        while (!m_pending.empty()) {
+            // Checking the clock every request would cost more than most hits
+            if ((examined++ & 7) == 0 && Clock::now() - begin > budget) {
+                break;
+            }
+
+            const RequestId id = m_pending.front();
+            m_pending.pop_front();
+
+            auto found = m_requests.find(id);
+            if (found == m_requests.end()) {
+                continue;
+            }
+            Request& request = found->second;
+
+            const bool isNew = !request.resolved;
+            if (isNew) {
+                ResolveRequest(request);
+            }
+
+            // The first goal seen in a region is where its paths lead
+            auto inserted = m_regions.try_emplace(request.region);
+            GoalRegion& region = inserted.first->second;
+            if (inserted.second) {
+                region.goal = request.goalCell;
+            }
+            if (isNew) {
+                region.demand += 1.0f;
+            }
+            region.lastUsed = m_tick;
+
+            if (!request.skipField) {
+                if (region.field) {
+                    if (ServeFromField(id, request, *region.field)) {
+                        continue;
+                    }
+                    request.skipField = true;
+                } else if (region.fieldJob) {
+                    region.fieldJob->waiting.push_back(id);
+                    continue;
+                } else if (region.demand >= m_config.flowFieldDemand) {
+                    if (started >= m_config.maxSearchesPerTick) {
+                        deferred.push_back(id);
+                        continue;
+                    }
+
+                    auto job = std::make_shared<Job>();
+                    job->flowField = true;
+                    job->key = {region.goal, request.region};
+                    job->start = region.goal;
+                    job->goal = region.goal;
+                    job->waiting.push_back(id);
+                    region.fieldJob = job;
+                    m_stats.flowFields++;
+                    started++;
+                    StartJob(job);
+                    continue;
+                }
+            }
+
+            const SearchKey key{request.startCell, request.region};
+
+            auto cached = m_pathCache.find(key);
+            if (cached != m_pathCache.end() && m_tick - cached->second.tick <= m_config.pathCacheTicks) {
+                m_stats.cacheHits++;
+                Deliver(id, cached->second.path);
+                continue;
+            }
+
+            auto running = m_searches.find(key);
+            if (running != m_searches.end()) {
+                running->second->waiting.push_back(id);
+                m_stats.coalesced++;
+                continue;
+            }
+
+            if (started >= m_config.maxSearchesPerTick) {
+                deferred.push_back(id);
+                continue;
+            }
+
+            auto job = std::make_shared<Job>();
+            job->flowField = false;
+            job->key = key;
+            job->start = request.startCell;
+            job->goal = region.goal;
+            job->waiting.push_back(id);
+            m_searches.emplace(key, job);
+            m_stats.searches++;
+            started++;
+            StartJob(job);
+        }
+
+        // Deferred requests were queued before the ones not reached yet
+        m_stats.deferred += deferred.size();
+        for (auto it = deferred.rbegin(); it != deferred.rend(); ++it) {
+            m_pending.push_front(*it);
+        }
+    }
+
+    void PathRequestService::CollectResults() {
+        std::vector<std::shared_ptr<Job>> done;
+        {
+            std::lock_guard<std::mutex> lock(m_completedMutex);
+            done.swap(m_completed);
+        }
+
+        for (const std::shared_ptr<Job>& job : done) {
+            m_jobsOutstanding--;
+            const bool stale = IsStale(*job);
+
+            if (job->flowField) {
+                auto region = m_regions.find(job->key.region);
+                if (region != m_regions.end() && region->second.fieldJob == job) {
+                    region->second.fieldJob.reset();
+                    if (!stale) {
+                        region->second.field = job->field;
+                    }
+                }
+            } else {
+                auto running = m_searches.find(job->key);
+                if (running != m_searches.end() && running->second == job) {
+                    m_searches.erase(running);
+                }
+            }
+
+            if (stale) {
+                // Start over with the changed blocks
+                m_stats.invalidated++;
+                for (auto it = job->waiting.rbegin(); it != job->waiting.rend(); ++it) {
+                    m_pending.push_front(*it);
+                }
+                continue;
+            }
+
+            if (job->flowField) {
+                for (RequestId id : job->waiting) {
+                    auto found = m_requests.find(id);
+                    if (found != m_requests.end() && !ServeFromField(id, found->second, *job->field)) {
+                        found->second.skipField = true;
+                        m_pending.push_front(id);
+                    }
+                }
+                continue;
+            }
+
+            if (!job->path.empty()) {
+                CachedPath& cached = m_pathCache[job->key];
+                cached.path = job->path;
+                cached.tick = m_tick;
+                PathBounds(cached.path, cached.boundsMin, cached.boundsMax);
+            }
+            for (RequestId id : job->waiting) {
+                Deliver(id, job->path);
+            }
+        }
+    }
+
+    void PathRequestService::EvictExpired() {
+        for (auto it = m_regions.begin(); it != m_regions.end();) {
+            GoalRegion& region = it->second;
+            region.demand *= m_config.demandDecay;
+            if (!region.fieldJob && m_tick - region.lastUsed > m_config.regionLifetimeTicks) {
+                it = m_regions.erase(it);
+            } else {
+                ++it;
+            }
+        }
+
+        if (m_tick % CACHE_SWEEP_TICKS == 0) {
+            for (auto it = m_pathCache.begin(); it != m_pathCache.end();) {
+                if (m_tick - it->second.tick > m_config.pathCacheTicks) {
+                    it = m_pathCache.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+    }
+
+    void PathRequestService::StartJob(const std::shared_ptr<Job>& job) {
+        job->blockEpoch = m_blockEpoch;
+        m_jobsOutstanding++;
+
+        if (!m_pool || !m_pool->IsRunning()) {
+            RunJob(*job);
+            std::lock_guard<std::mutex> lock(m_completedMutex);
+            m_completed.push_back(job);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_completedMutex);
+            m_jobsRunning++;
+        }
+        m_pool->Submit([this, job]() {
+            RunJob(*job);
+            std::lock_guard<std::mutex> lock(m_completedMutex);
+            m_completed.push_back(job);
+            m_jobsRunning--;
+            m_completedCondition.notify_all();
+        });
+    }
+
+    void PathRequestService::RunJob(Job& job) {
+        if (job.flowField) {
+            job.field = std::make_shared<FlowField>(*m_grid, job.goal, m_config.flowFieldRadius,
+                                                    m_config.flowFieldMaxNodes);
+            return;
+        }
+
+        std::unique_ptr<Pathfinding> finder = AcquireFinder();
+        job.path = finder->FindPath(glm::vec3(job.start), glm::vec3(job.goal));
+        ReleaseFinder(std::move(finder));
+    }
+
+    bool PathRequestService::IsStale(const Job& job) const {
+        if (job.blockEpoch < m_staleBeforeEpoch) {
+            return true;
+        }
+
+        // A failed search stays failed for its callers; it is not cached
+        if (!job.flowField && job.path.empty()) {
+            return false;
+        }
+
+        glm::ivec3 low;
+        glm::ivec3 high;
+        if (!job.flowField) {
+            PathBounds(job.path, low, high);
+        }
+
+        for (const BlockChange& change : m_recentChanges) {
+            if (change.epoch <= job.blockEpoch) {
+                continue;
+            }
+            const bool affected = job.flowField ? job.field->IsAffectedBy(change.position)
+                                                : InBounds(change.position, low, high);
+            if (affected) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void PathRequestService::Deliver(RequestId id, const std::vector<glm::ivec3>& path) {
+        auto found = m_requests.find(id);
+        if (found == m_requests.end()) {
+            return;
+        }
+
+        // The callback may queue a new request
+        PathCallback callback = std::move(found->second.callback);
+        m_requests.erase(found);
+        m_stats.delivered++;
+
+        if (callback) {
+            callback(id, path);
+        }
+    }
+
+    bool PathRequestService::ServeFromField(RequestId id, Request& request, const FlowField& field) {
+        std::vector<glm::ivec3> path;
+        if (!field.GetPath(request.startCell, path)) {
+            return false;
+        }
+        m_stats.flowFieldHits++;
+        Deliver(id, path);
+        return true;
+    }
+
+    std::unique_ptr<Pathfinding> PathRequestService::AcquireFinder() {
+        {
+            std::lock_guard<std::mutex> lock(m_finderMutex);
+            if (!m_finders.empty()) {
+                std::unique_ptr<Pathfinding> finder = std::move(m_finders.back());
+                m_finders.pop_back();
+                return finder;
+            }
+        }
+
+        auto finder = m_blockQuery ? std::make_unique<Pathfinding>(m_blockQuery)
+                                   : std::make_unique<Pathfinding>(m_world);
+        finder->SetMaxSearchDistance(m_config.maxSearchDistance);
+        finder->SetPortalGraph(m_portalGraph);
+        return finder;
+    }
+
+    void PathRequestService::ReleaseFinder(std::unique_ptr<Pathfinding> finder) {
+        std::lock_guard<std::mutex> lock(m_finderMutex);
+        m_finders.push_back(std::move(finder));
+    }
+
+} // namespace VoxelCraft
@@ -0,0 +1,336 @@
+/**
+ * @file PathRequestService.hpp
+ * @brief VoxelCraft Shared Path Requests with Per-Tick Budget and Flow Fields
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#ifndef VOXELCRAFT_AI_PATH_REQUEST_SERVICE_HPP
+#define VOXELCRAFT_AI_PATH_REQUEST_SERVICE_HPP
+
+#include "Pathfinding.hpp"
+
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
+#include <memory>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace VoxelCraft {
+
+    class World;
+    class WorkStealingPool;
+
+    /**
+     * @class FlowField
+     * @brief Next step toward one goal for every cell around it
+     *
+     * Built by a single Dijkstra search that starts at the goal and follows
+     * moves backwards (PathfindingGrid::GetPredecessors), limited to a
+     * horizontal radius. Each reached cell keeps the cell it moves to next, so
+     * the cheapest path from any of them is read by following those links,
+     * with no search. Immutable once built and shared between threads.
+     */
+    class FlowField {
+    public:
+        /**
+         * @brief Build the field
+         * @param grid Movement rules and block lookup
+         * @param goal Goal position (standing cell)
+         * @param radius Horizontal distance from the goal covered, in blocks
+         * @param maxNodes Cells the search may settle
+         */
+        FlowField(const PathfindingGrid& grid, const glm::ivec3& goal, int radius, int maxNodes);
+
+        /**
+         * @brief Read the path from a cell to the goal
+         * @param start Start position (standing cell)
+         * @param path Receives the path, start and goal included
+         * @return false if the field does not reach start
+         */
+        bool GetPath(const glm::ivec3& start, std::vector<glm::ivec3>& path) const;
+
+        /**
+         * @brief Check if a block change at a position can affect the field
+         * @param position Changed block
+         * @return true if the field has to be rebuilt
+         */
+        bool IsAffectedBy(const glm::ivec3& position) const;
+
+        const glm::ivec3& GetGoal() const { return m_goal; }
+        size_t GetCellCount() const { return m_arena.GetNodeCount(); }
+
+    private:
+        glm::ivec3 m_goal;
+        glm::ivec3 m_boundsMin;
+        glm::ivec3 m_boundsMax;
+        PathSearchArena m_arena;    // Node parent is the next step toward the goal
+    };
+
+    /**
+     * @struct PathRequestConfig
+     * @brief Budget and sharing settings for PathRequestService
+     */
+    struct PathRequestConfig {
+        int maxSearchesPerTick = 16;        ///< A* searches and flow fields started per Tick
+        float tickBudgetMs = 1.0f;          ///< Time a Tick spends on queued requests
+        int goalRegionSize = 4;             ///< Goals in the same cube of this size share results
+        float flowFieldDemand = 12.0f;      ///< Region demand at which a flow field is built
+        float demandDecay = 0.9f;           ///< Per-tick decay of region demand
+        int flowFieldRadius = 40;           ///< Horizontal reach of a flow field
+        int flowFieldMaxNodes = 40000;      ///< Cells a flow field may cover
+        int maxSearchDistance = 64;         ///< See Pathfinding::SetMaxSearchDistance
+        uint32_t pathCacheTicks = 20;       ///< Ticks a found path is reused
+        uint32_t regionLifetimeTicks = 100; ///< Ticks an unused region keeps its flow field
+    };
+
+    /**
+     * @class PathRequestService
+     * @brief Queues path requests and answers them with as few searches as possible
+     *
+     * Mobs ask for paths with RequestPath and get the result through a
+     * callback on a later Tick. Each Tick works through the queue within a
+     * time budget and starts at most maxSearchesPerTick searches; the rest
+     * wait for the next tick, so a burst of requests is spread over several
+     * ticks instead of stalling one.
+     *
+     * Goals are grouped into goal regions (cubes of goalRegionSize blocks),
+     * and requests are answered, cheapest first, by:
+     *   - the region's flow field, if it has one covering the start
+     *   - a path found earlier for the same start cell and region
+     *   - a search already running for the same start cell and region
+     *   - a new A* search on a worker thread
+     * Every region keeps a decaying count of requests. Once it passes
+     * flowFieldDemand (a horde chasing one player), a flow field is built for
+     * it on a worker and answers every later request for that region, so 300
+     * mobs chasing one player cost one search instead of 300. Paths end at
+     * the goal of the region's first request, which lies within one goal
+     * region of the goal asked for.
+     *
+     * OnBlockChanged (wired to ChunkSystem::SetBlock) drops cached paths and
+     * flow fields near the change, results of searches that were running
+     * when it happened, and the chunk's portals in the shared portal graph.
+     *
+     * RequestPath, CancelRequest and OnBlockChanged may be called from any
+     * thread. Tick and the callbacks run on the thread that calls Tick.
+     */
+    class PathRequestService {
+    public:
+        using RequestId = uint64_t;
+
+        /**
+         * @brief Receives a path; empty if there is none
+         */
+        using PathCallback = std::function<void(RequestId id, const std::vector<glm::ivec3>& path)>;
+
+        /**
+         * @struct Stats
+         * @brief Cumulative request counters
+         */
+        struct Stats {
+            uint64_t requests;          ///< Paths requested
+            uint64_t delivered;         ///< Callbacks run
+            uint64_t flowFieldHits;     ///< Answered from a flow field
+            uint64_t cacheHits;         ///< Answered from a cached path
+            uint64_t coalesced;         ///< Joined a search already running
+            uint64_t searches;          ///< A* searches started
+            uint64_t flowFields;        ///< Flow fields built
+            uint64_t invalidated;       ///< Paths, fields and results dropped after block changes
+            uint64_t deferred;          ///< Times a request waited a tick for budget
+            uint64_t pending;           ///< Requests not answered yet
+        };
+
+        /**
+         * @brief Constructor
+         * @param world World to search
+         * @param pool Worker pool, or nullptr to search inside Tick
+         * @param config Budget and sharing settings
+         */
+        PathRequestService(World* world, WorkStealingPool* pool = nullptr,
+                           const PathRequestConfig& config = PathRequestConfig());
+
+        /**
+         * @brief Constructor
+         * @param blockQuery Block lookup used instead of a World
+         * @param pool Worker pool, or nullptr to search inside Tick
+         * @param config Budget and sharing settings
+         */
+        PathRequestService(PathfindingGrid::BlockQuery blockQuery, WorkStealingPool* pool = nullptr,
+                           const PathRequestConfig& config = PathRequestConfig());
+
+        /**
+         * @brief Destructor, waits for running searches
+         */
+        ~PathRequestService();
+
+        PathRequestService(const PathRequestService&) = delete;
+        PathRequestService& operator=(const PathRequestService&) = delete;
+
+        /**
+         * @brief Queue a path request
+         * @param start Start position
+         * @param goal Goal position
+         * @param callback Called from a later Tick with the path
+         * @return Request ID
+         */
+        RequestId RequestPath(const glm::vec3& start, const glm::vec3& goal, PathCallback callback);
+
+        /**
+         * @brief Drop a request; its callback will not run
+         * @param id Request ID
+         */
+        void CancelRequest(RequestId id);
+
+        /**
+         * @brief Answer queued requests, start searches and deliver results
+         */
+        void Tick();
+
+        /**
+         * @brief Report a changed block
+         * @param x Block X coordinate
+         * @param y Block Y coordinate
+         * @param z Block Z coordinate
+         */
+        void OnBlockChanged(int x, int y, int z);
+
+        /**
+         * @brief Get cumulative counters
+         * @return Stats
+         */
+        Stats GetStats() const;
+
+        /**
+         * @brief Get the configuration
+         * @return Config
+         */
+        const PathRequestConfig& GetConfig() const { return m_config; }
+
+        /**
+         * @brief Get the portal graph shared by all searches
+         * @return Portal graph
+         */
+        ChunkPortalGraph* GetPortalGraph() const { return m_portalGraph.get(); }
+
+    private:
+        struct Request {
+            glm::vec3 start;
+            glm::vec3 goal;
+            PathCallback callback;
+            glm::ivec3 startCell;
+            glm::ivec3 goalCell;
+            uint64_t region;
+            bool resolved = false;          // Cells and region filled in
+            bool skipField = false;         // Start lies outside the region's flow field
+        };
+
+        struct SearchKey {
+            glm::ivec3 start;
+            uint64_t region;
+
+            bool operator==(const SearchKey& other) const {
+                return start == other.start && region == other.region;
+            }
+        };
+
+        struct SearchKeyHash {
+            size_t operator()(const SearchKey& key) const;
+        };
+
+        struct Job {
+            bool flowField;
+            SearchKey key;
+            glm::ivec3 start;
+            glm::ivec3 goal;
+            uint64_t blockEpoch;                    // Block changes seen when it started
+            std::vector<RequestId> waiting;         // Tick thread only
+
+            // Written by the worker
+            std::vector<glm::ivec3> path;
+            std::shared_ptr<const FlowField> field;
+        };
+
+        struct CachedPath {
+            std::vector<glm::ivec3> path;
+            glm::ivec3 boundsMin;
+            glm::ivec3 boundsMax;
+            uint32_t tick;
+        };
+
+        struct GoalRegion {
+            glm::ivec3 goal;
+            float demand = 0.0f;
+            uint32_t lastUsed = 0;
+            std::shared_ptr<const FlowField> field;
+            std::shared_ptr<Job> fieldJob;
+        };
+
+        struct BlockChange {
+            uint64_t epoch;
+            glm::ivec3 position;
+        };
+
+        PathRequestConfig m_config;
+        World* m_world;
+        PathfindingGrid::BlockQuery m_blockQuery;
+        WorkStealingPool* m_pool;
+        std::unique_ptr<PathfindingGrid> m_grid;
+        std::shared_ptr<ChunkPortalGraph> m_portalGraph;
+
+        // Tick thread state
+        uint32_t m_tick;
+        uint64_t m_blockEpoch;
+        uint64_t m_staleBeforeEpoch;                // Results started before this are dropped
+        std::unordered_map<RequestId, Request> m_requests;
+        std::deque<RequestId> m_pending;
+        std::unordered_map<uint64_t, GoalRegion> m_regions;
+        std::unordered_map<SearchKey, std::shared_ptr<Job>, SearchKeyHash> m_searches;
+        std::unordered_map<SearchKey, CachedPath, SearchKeyHash> m_pathCache;
+        std::vector<BlockChange> m_recentChanges;   // Kept while jobs are running
+        size_t m_jobsOutstanding;
+        Stats m_stats;
+
+        // Shared with callers
+        mutable std::mutex m_incomingMutex;
+        RequestId m_nextId;
+        std::vector<std::pair<RequestId, Request>> m_incoming;
+        std::vector<RequestId> m_cancelled;
+        std::vector<glm::ivec3> m_changes;
+
+        // Shared with workers
+        std::mutex m_completedMutex;
+        std::condition_variable m_completedCondition;
+        std::vector<std::shared_ptr<Job>> m_completed;
+        size_t m_jobsRunning;
+
+        std::mutex m_finderMutex;
+        std::vector<std::unique_ptr<Pathfinding>> m_finders;
+
+        uint64_t RegionKey(const glm::ivec3& goal) const;
+        void ResolveRequest(Request& request) const;
+
+        void TakeIncoming();
+        void ApplyBlockChanges();
+        void ScheduleRequests();
+        void CollectResults();
+        void EvictExpired();
+
+        void StartJob(const std::shared_ptr<Job>& job);
+        void RunJob(Job& job);
+        bool IsStale(const Job& job) const;
+
+        void Deliver(RequestId id, const std::vector<glm::ivec3>& path);
+        bool ServeFromField(RequestId id, Request& request, const FlowField& field);
+
+        std::unique_ptr<Pathfinding> AcquireFinder();
+        void ReleaseFinder(std::unique_ptr<Pathfinding> finder);
+    };
+
+} // namespace VoxelCraft
+
+#endif // VOXELCRAFT_AI_PATH_REQUEST_SERVICE_HPP
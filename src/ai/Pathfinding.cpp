@@ -10,55 +10,260 @@
 #include "../entities/Entity.hpp"
 #include <algorithm>
 #include <cmath>
+#include <limits>
+#include <mutex>
 #include <queue>
 #include <unordered_set>
 
 namespace VoxelCraft {
 
+    namespace {
+
+        // One arena for block-level searches and one for the portal-level
+        // search, which builds chunk graphs (block searches) while it runs
+        thread_local PathSearchArena t_gridArena;
+        thread_local PathSearchArena t_portalArena;
+
+        constexpr float INFINITE_COST = std::numeric_limits<float>::infinity();
+
+        // Block-level search limit inside one chunk column
+        constexpr int CHUNK_SEARCH_NODES = 4096;
+
+        uint64_t PositionKey(const glm::ivec3& position) {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(position.x) & 0xFFFFFF) << 40) |
+                   (static_cast<uint64_t>(static_cast<uint32_t>(position.z) & 0xFFFFFF) << 16) |
+                   (static_cast<uint64_t>(static_cast<uint32_t>(position.y) & 0xFFFF));
+        }
+
+        uint64_t ChunkKey(int chunkX, int chunkZ) {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(chunkX)) << 32) |
+                   static_cast<uint64_t>(static_cast<uint32_t>(chunkZ));
+        }
+
+        uint64_t BorderKey(int chunkX, int chunkZ, bool alongX) {
+            return (static_cast<uint64_t>(static_cast<uint32_t>(chunkX)) << 33) |
+                   (static_cast<uint64_t>(static_cast<uint32_t>(chunkZ)) << 1) |
+                   (alongX ? 0u : 1u);
+        }
+
+        int ChunkOf(int block) {
+            return block >> 4;
+        }
+
+        float OctileDistance(const glm::ivec3& from, const glm::ivec3& to) {
+            float dx = static_cast<float>(std::abs(from.x - to.x));
+            float dy = static_cast<float>(std::abs(from.y - to.y));
+            float dz = static_cast<float>(std::abs(from.z - to.z));
+            return std::max(dx, dz) + std::min(dx, dz) * 0.414f + dy;
+        }
+
+        /**
+         * @brief A* over an arena; expand(position, emit) reports neighbours
+         *        through emit(neighbor, stepCost)
+         * @return Index of the first node isGoal accepts when it is closed,
+         *         or -1 if the search ran dry or hit maxNodes
+         */
+        template<typename IsGoal, typename Expand, typename Heuristic>
+        int32_t RunSearch(PathSearchArena& arena, const glm::ivec3& start, IsGoal&& isGoal,
+                          int maxNodes, const bool* cancelled, Expand&& expand, Heuristic&& heuristic,
+                          int& nodesExplored) {
+            arena.Reset();
+            nodesExplored = 0;
+
+            bool created;
+            int32_t startIndex = arena.GetOrCreate(start, created);
+            PathSearchArena::Node& startNode = arena.GetNode(startIndex);
+            startNode.gCost = 0.0f;
+            startNode.fCost = heuristic(start);
+            arena.PushOrDecrease(startIndex);
+
+            while (!arena.IsOpenEmpty()) {
+                if (cancelled && *cancelled) {
+                    return -1;
+                }
+
+                const int32_t current = arena.PopMin();
+                PathSearchArena::Node& node = arena.GetNode(current);
+                node.closed = true;
+
+                if (isGoal(node.position)) {
+                    return current;
+                }
+                if (++nodesExplored > maxNodes) {
+                    return -1;
+                }
+
+                const glm::ivec3 position = node.position;
+                const float gCost = node.gCost;
+
+                expand(position, [&](const glm::ivec3& neighborPos, float stepCost) {
+                    bool isNew;
+                    const int32_t index = arena.GetOrCreate(neighborPos, isNew);
+                    PathSearchArena::Node& neighbor = arena.GetNode(index);
+                    const float tentative = gCost + stepCost;
+
+                    if (isNew || (!neighbor.closed && tentative < neighbor.gCost)) {
+                        const float h = isNew ? heuristic(neighborPos) : neighbor.fCost - neighbor.gCost;
+                        neighbor.gCost = tentative;
+                        neighbor.fCost = tentative + h;
+                        neighbor.parent = current;
+                        arena.PushOrDecrease(index);
+                    }
+                });
+            }
+
+            return -1;
+        }
+
+        void ReconstructPath(const PathSearchArena& arena, int32_t index, std::vector<glm::ivec3>& path) {
+            path.clear();
+            for (int32_t i = index; i >= 0; i = arena.GetNode(i).parent) {
+                path.push_back(arena.GetNode(i).position);
+            }
+            std::reverse(path.begin(), path.end());
+        }
+
+    } // namespace
+
     // PathfindingGrid implementation
     PathfindingGrid::PathfindingGrid(World* world, int chunkRadius)
         : m_world(world), m_chunkRadius(chunkRadius) {
     }
 
+    PathfindingGrid::PathfindingGrid(BlockQuery blockQuery)
+        : m_world(nullptr), m_chunkRadius(0), m_blockQuery(std::move(blockQuery)) {
+    }
+
+    int PathfindingGrid::GetBlockID(const glm::ivec3& position) const {
+        if (m_blockQuery) {
+            return m_blockQuery(position.x, position.y, position.z);
+        }
+        return m_world ? static_cast<int>(m_world->GetBlock(position.x, position.y, position.z)) : 0;
+    }
+
     bool PathfindingGrid::IsWalkable(const glm::ivec3& position) const {
-        if (!m_world) return false;
+        if (!m_world && !m_blockQuery) return false;
 
         // Check if the block at position is air or walkable
-        int blockID = m_world->GetBlock(position.x, position.y, position.z);
-        bool isAirOrWalkable = (blockID == 0); // Air block
+        bool isAirOrWalkable = (GetBlockID(position) == 0); // Air block
+        if (!isAirOrWalkable) return false;
 
         // Check if there's solid ground below
-        int blockBelow = m_world->GetBlock(position.x, position.y - 1, position.z);
-        bool hasGround = (blockBelow != 0); // Not air
+        bool hasGround = (GetBlockID(position - glm::ivec3(0, 1, 0)) != 0); // Not air
+        if (!hasGround) return false;
 
         // Check if there's enough space above (head room)
-        int blockAbove = m_world->GetBlock(position.x, position.y + 1, position.z);
-        bool hasHeadRoom = (blockAbove == 0); // Air above
-
-        return isAirOrWalkable && hasGround && hasHeadRoom;
+        return GetBlockID(position + glm::ivec3(0, 1, 0)) == 0; // Air above
     }
 
     std::vector<glm::ivec3> PathfindingGrid::GetNeighbors(const glm::ivec3& position) const {
-        std::vector<glm::ivec3> neighbors;
-
-        // 6 main directions (up, down, north, south, east, west)
-        const glm::ivec3 directions[] = {
-            glm::ivec3(1, 0, 0),   // East
-            glm::ivec3(-1, 0, 0),  // West
-            glm::ivec3(0, 0, 1),   // North
-            glm::ivec3(0, 0, -1),  // South
-            glm::ivec3(0, 1, 0),   // Up
-            glm::ivec3(0, -1, 0)   // Down
+        glm::ivec3 buffer[MAX_NEIGHBORS];
+        int count = GetNeighbors(position, buffer);
+        return std::vector<glm::ivec3>(buffer, buffer + count);
+    }
+
+    int PathfindingGrid::GetNeighbors(const glm::ivec3& position, glm::ivec3* neighbors) const {
+        // East, West, North, South
+        static const glm::ivec3 directions[4] = {
+            glm::ivec3(1, 0, 0),
+            glm::ivec3(-1, 0, 0),
+            glm::ivec3(0, 0, 1),
+            glm::ivec3(0, 0, -1)
         };
+        const glm::ivec3 up(0, 1, 0);
+
+        int count = 0;
+        bool level[4];
+        const bool canJump = GetBlockID(position + up * 2) == 0;
+
+        for (int i = 0; i < 4; ++i) {
+            const glm::ivec3 next = position + directions[i];
+            level[i] = IsWalkable(next);
+            if (level[i]) {
+                neighbors[count++] = next;
+                continue;
+            }
 
-        for (const auto& dir : directions) {
-            glm::ivec3 neighbor = position + dir;
-            if (IsWalkable(neighbor)) {
-                neighbors.push_back(neighbor);
+            if (GetBlockID(next) != 0) {
+                // Blocked; step up onto it if there is room to jump
+                if (canJump && IsWalkable(next + up * MAX_STEP_UP)) {
+                    neighbors[count++] = next + up * MAX_STEP_UP;
+                }
+                continue;
+            }
+
+            // Open but no floor; drop down if the head fits through
+            if (GetBlockID(next + up) != 0) {
+                continue;
+            }
+            for (int drop = 1; drop <= MAX_DROP; ++drop) {
+                const glm::ivec3 below = next - up * drop;
+                if (IsWalkable(below)) {
+                    neighbors[count++] = below;
+                    break;
+                }
+                if (GetBlockID(below) != 0) {
+                    break;
+                }
             }
         }
 
-        return neighbors;
+        if (m_allowDiagonal) {
+            // Only when both sides are open, so corners are never cut
+            static const int pairs[4][2] = { {0, 2}, {0, 3}, {1, 2}, {1, 3} };
+            for (const auto& pair : pairs) {
+                if (level[pair[0]] && level[pair[1]]) {
+                    const glm::ivec3 next = position + directions[pair[0]] + directions[pair[1]];
+                    if (IsWalkable(next)) {
+                        neighbors[count++] = next;
+                    }
+                }
+            }
+        }
+
+        return count;
+    }
+
+    int PathfindingGrid::GetPredecessors(const glm::ivec3& position, glm::ivec3* predecessors) const {
+        static const glm::ivec3 offsets[8] = {
+            glm::ivec3(1, 0, 0),
+            glm::ivec3(-1, 0, 0),
+            glm::ivec3(0, 0, 1),
+            glm::ivec3(0, 0, -1),
+            glm::ivec3(1, 0, 1),
+            glm::ivec3(1, 0, -1),
+            glm::ivec3(-1, 0, 1),
+            glm::ivec3(-1, 0, -1)
+        };
+
+        glm::ivec3 neighbors[MAX_NEIGHBORS];
+        int count = 0;
+
+        // A cardinal move can come from one block lower (step up) or from up
+        // to MAX_DROP higher (drop); diagonal moves stay level
+        for (int i = 0; i < 8; ++i) {
+            const int lowest = i < 4 ? -MAX_STEP_UP : 0;
+            const int highest = i < 4 ? MAX_DROP : 0;
+            if (i >= 4 && !m_allowDiagonal) {
+                break;
+            }
+
+            for (int dy = lowest; dy <= highest; ++dy) {
+                const glm::ivec3 from = position + offsets[i] + glm::ivec3(0, dy, 0);
+                if (!IsWalkable(from)) {
+                    continue;
+                }
+                const int neighborCount = GetNeighbors(from, neighbors);
+                for (int n = 0; n < neighborCount; ++n) {
+                    if (neighbors[n] == position) {
+                        predecessors[count++] = from;
+                        break;
+                    }
+                }
+            }
+        }
+
+        return count;
     }
 
     float PathfindingGrid::GetMovementCost(const glm::ivec3& from, const glm::ivec3& to) const {
@@ -116,125 +321,662 @@ namespace VoxelCraft {
     }
 
     bool PathfindingGrid::IsInWater(const glm::ivec3& position) const {
-        int blockID = m_world->GetBlock(position.x, position.y, position.z);
+        int blockID = GetBlockID(position);
         return blockID == 9 || blockID == 8; // Water blocks
     }
 
     bool PathfindingGrid::IsInLava(const glm::ivec3& position) const {
-        int blockID = m_world->GetBlock(position.x, position.y, position.z);
+        int blockID = GetBlockID(position);
         return blockID == 11 || blockID == 10; // Lava blocks
     }
 
     bool PathfindingGrid::IsSolidBlock(const glm::ivec3& position) const {
-        int blockID = m_world->GetBlock(position.x, position.y, position.z);
+        int blockID = GetBlockID(position);
         return blockID != 0 && blockID != 8 && blockID != 9 && blockID != 10 && blockID != 11;
     }
 
     bool PathfindingGrid::IsLiquidBlock(const glm::ivec3& position) const {
-        int blockID = m_world->GetBlock(position.x, position.y, position.z);
+        int blockID = GetBlockID(position);
         return blockID == 8 || blockID == 9 || blockID == 10 || blockID == 11;
     }
 
-    // Pathfinding implementation
-    Pathfinding::Pathfinding(World* world)
-        : m_world(world), m_grid(std::make_unique<PathfindingGrid>(world)) {
+    // PathSearchArena implementation
+    PathSearchArena::PathSearchArena()
+        : m_generation(1), m_slotMask(0) {
+        Rehash(1024);
     }
 
-    std::vector<glm::ivec3> Pathfinding::FindPath(const glm::vec3& start,
-                                                 const glm::vec3& goal,
-                                                 Entity* entity) {
-        auto startTime = std::chrono::high_resolution_clock::now();
+    void PathSearchArena::Reset() {
+        m_nodes.clear();
+        m_heap.clear();
 
-        // Convert to integer coordinates
-        glm::ivec3 startPos = glm::round(start);
-        glm::ivec3 goalPos = glm::round(goal);
+        if (++m_generation == 0) {
+            std::fill(m_slotGeneration.begin(), m_slotGeneration.end(), 0u);
+            m_generation = 1;
+        }
+    }
 
-        // Adjust to ground level
-        startPos.y = m_grid->FindGroundLevel(startPos);
-        goalPos.y = m_grid->FindGroundLevel(goalPos);
+    size_t PathSearchArena::HashPosition(const glm::ivec3& position) const {
+        uint64_t h = static_cast<uint64_t>(static_cast<uint32_t>(position.x)) * 0x9E3779B97F4A7C15ull;
+        h ^= static_cast<uint64_t>(static_cast<uint32_t>(position.z)) * 0xC2B2AE3D27D4EB4Full;
+        h ^= static_cast<uint64_t>(static_cast<uint32_t>(position.y)) * 0x165667B19E3779F9ull;
+        return static_cast<size_t>(h ^ (h >> 29));
+    }
 
-        // Early exit if start and goal are the same
-        if (startPos == goalPos) {
-            return {startPos};
+    int32_t PathSearchArena::Find(const glm::ivec3& position) const {
+        size_t slot = HashPosition(position) & m_slotMask;
+        while (m_slotGeneration[slot] == m_generation) {
+            const int32_t index = m_slots[slot];
+            if (GetNode(index).position == position) {
+                return index;
+            }
+            slot = (slot + 1) & m_slotMask;
         }
+        return -1;
+    }
 
-        // Initialize A* algorithm
-        ClearData();
-        m_cancelled = false;
+    int32_t PathSearchArena::GetOrCreate(const glm::ivec3& position, bool& created) {
+        // Keep the table at most half full
+        if ((m_nodes.size() + 1) * 2 > m_slots.size()) {
+            Rehash(m_slots.size() * 2);
+        }
 
-        // Create start and goal nodes
-        PathNode startNode(startPos);
-        startNode.gCost = 0.0f;
-        startNode.hCost = CalculateHeuristic(startPos, goalPos);
-        startNode.fCost = startNode.GetFCost();
+        size_t slot = HashPosition(position) & m_slotMask;
+        while (m_slotGeneration[slot] == m_generation) {
+            const int32_t index = m_slots[slot];
+            if (GetNode(index).position == position) {
+                created = false;
+                return index;
+            }
+            slot = (slot + 1) & m_slotMask;
+        }
 
-        PathNode goalNode(goalPos);
+        const int32_t index = static_cast<int32_t>(m_nodes.size());
+        m_nodes.push_back({position, INFINITE_COST, INFINITE_COST, -1, -1, false});
+        m_slots[slot] = index;
+        m_slotGeneration[slot] = m_generation;
+        created = true;
+        return index;
+    }
 
-        // Add start node to open set
-        AddToOpenSet(startNode);
+    void PathSearchArena::Rehash(size_t slotCount) {
+        m_slots.assign(slotCount, -1);
+        m_slotGeneration.assign(slotCount, 0u);
+        m_slotMask = static_cast<uint32_t>(slotCount - 1);
 
-        int nodesExplored = 0;
+        for (size_t i = 0; i < m_nodes.size(); ++i) {
+            size_t slot = HashPosition(m_nodes[i].position) & m_slotMask;
+            while (m_slotGeneration[slot] == m_generation) {
+                slot = (slot + 1) & m_slotMask;
+            }
+            m_slots[slot] = static_cast<int32_t>(i);
+            m_slotGeneration[slot] = m_generation;
+        }
+    }
 
-        while (!m_openSet.empty() && !m_cancelled) {
-            // Get node with lowest F cost
-            PathNode current = GetLowestCostNode();
+    bool PathSearchArena::Less(int32_t a, int32_t b) const {
+        const Node& na = GetNode(a);
+        const Node& nb = GetNode(b);
+        if (na.fCost != nb.fCost) {
+            return na.fCost < nb.fCost;
+        }
+        // On ties prefer the node further from the start; it is closer to the goal
+        return na.gCost > nb.gCost;
+    }
 
-            // Check if we've reached the goal
-            if (current.position == goalPos) {
-                auto endTime = std::chrono::high_resolution_clock::now();
-                float searchTime = std::chrono::duration<float>(endTime - startTime).count();
+    void PathSearchArena::SiftUp(size_t slot) {
+        const int32_t index = m_heap[slot];
+        while (slot > 0) {
+            const size_t parent = (slot - 1) / 2;
+            if (!Less(index, m_heap[parent])) {
+                break;
+            }
+            m_heap[slot] = m_heap[parent];
+            GetNode(m_heap[slot]).heapIndex = static_cast<int32_t>(slot);
+            slot = parent;
+        }
+        m_heap[slot] = index;
+        GetNode(index).heapIndex = static_cast<int32_t>(slot);
+    }
 
-                UpdateStats(true, searchTime, nodesExplored, 0);
-                return ReconstructPath(current);
+    void PathSearchArena::SiftDown(size_t slot) {
+        const int32_t index = m_heap[slot];
+        const size_t size = m_heap.size();
+        while (true) {
+            size_t child = slot * 2 + 1;
+            if (child >= size) {
+                break;
             }
+            if (child + 1 < size && Less(m_heap[child + 1], m_heap[child])) {
+                child++;
+            }
+            if (!Less(m_heap[child], index)) {
+                break;
+            }
+            m_heap[slot] = m_heap[child];
+            GetNode(m_heap[slot]).heapIndex = static_cast<int32_t>(slot);
+            slot = child;
+        }
+        m_heap[slot] = index;
+        GetNode(index).heapIndex = static_cast<int32_t>(slot);
+    }
 
-            // Move current node to closed set
-            RemoveFromOpenSet(current);
-            AddToClosedSet(current);
+    void PathSearchArena::PushOrDecrease(int32_t index) {
+        Node& node = GetNode(index);
+        if (node.heapIndex < 0) {
+            m_heap.push_back(index);
+            SiftUp(m_heap.size() - 1);
+        } else {
+            SiftUp(static_cast<size_t>(node.heapIndex));
+        }
+    }
 
-            // Explore neighbors
-            auto neighbors = m_grid->GetNeighbors(current.position);
+    int32_t PathSearchArena::PopMin() {
+        const int32_t top = m_heap.front();
+        GetNode(top).heapIndex = -1;
 
-            for (const auto& neighborPos : neighbors) {
-                // Skip if in closed set
-                PathNode neighborNode(neighborPos);
-                if (IsInClosedSet(neighborNode)) {
-                    continue;
+        const int32_t last = m_heap.back();
+        m_heap.pop_back();
+        if (!m_heap.empty()) {
+            m_heap[0] = last;
+            SiftDown(0);
+        }
+        return top;
+    }
+
+    // ChunkPortalGraph implementation
+    ChunkPortalGraph::ChunkPortalGraph(const PathfindingGrid& grid, int minY, int maxY)
+        : m_grid(grid), m_minY(minY), m_maxY(maxY), m_epoch(0) {
+    }
+
+    std::shared_ptr<const ChunkPortalGraph::Border> ChunkPortalGraph::GetBorder(int chunkX, int chunkZ, bool alongX) {
+        const uint64_t key = BorderKey(chunkX, chunkZ, alongX);
+        uint64_t epoch;
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            auto it = m_borders.find(key);
+            if (it != m_borders.end()) {
+                return it->second;
+            }
+            epoch = m_epoch;
+        }
+
+        auto border = BuildBorder(chunkX, chunkZ, alongX);
+
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        if (m_epoch != epoch) {
+            return border; // Invalidated while building; use it once, do not cache
+        }
+        return m_borders.emplace(key, border).first->second;
+    }
+
+    std::shared_ptr<const ChunkPortalGraph::Border> ChunkPortalGraph::BuildBorder(int chunkX, int chunkZ, bool alongX) const {
+        auto border = std::make_shared<Border>();
+
+        // Side A is chunk (chunkX, chunkZ), side B its +X or +Z neighbour
+        const glm::ivec3 step = alongX ? glm::ivec3(1, 0, 0) : glm::ivec3(0, 0, 1);
+        const glm::ivec3 along = alongX ? glm::ivec3(0, 0, 1) : glm::ivec3(1, 0, 0);
+        const glm::ivec3 origin = alongX
+            ? glm::ivec3(chunkX * CHUNK_SIZE + CHUNK_SIZE - 1, 0, chunkZ * CHUNK_SIZE)
+            : glm::ivec3(chunkX * CHUNK_SIZE, 0, chunkZ * CHUNK_SIZE + CHUNK_SIZE - 1);
+
+        // Every cardinal move across the border
+        struct Candidate {
+            int offset;             // Position along the border
+            int yA;                 // Side-A cell height
+            int yB;                 // Side-B cell height
+            Crossing crossing;
+            bool forward;           // A to B
+        };
+        std::vector<Candidate> candidates;
+        glm::ivec3 neighbors[PathfindingGrid::MAX_NEIGHBORS];
+
+        for (int offset = 0; offset < CHUNK_SIZE; ++offset) {
+            for (int y = m_minY; y <= m_maxY; ++y) {
+                const glm::ivec3 a = origin + along * offset + glm::ivec3(0, y, 0);
+                const glm::ivec3 b = a + step;
+
+                if (m_grid.IsWalkable(a)) {
+                    const int count = m_grid.GetNeighbors(a, neighbors);
+                    for (int i = 0; i < count; ++i) {
+                        const glm::ivec3 delta = neighbors[i] - a;
+                        if (delta.x == step.x && delta.z == step.z) {
+                            candidates.push_back({offset, y, neighbors[i].y, {a, neighbors[i], m_grid.GetMovementCost(a, neighbors[i])}, true});
+                        }
+                    }
                 }
 
-                // Calculate costs
-                float movementCost = m_grid->GetMovementCost(current.position, neighborPos);
-                float tentativeGCost = current.gCost + movementCost;
+                if (m_grid.IsWalkable(b)) {
+                    const int count = m_grid.GetNeighbors(b, neighbors);
+                    for (int i = 0; i < count; ++i) {
+                        const glm::ivec3 delta = neighbors[i] - b;
+                        if (delta.x == -step.x && delta.z == -step.z) {
+                            candidates.push_back({offset, neighbors[i].y, y, {b, neighbors[i], m_grid.GetMovementCost(b, neighbors[i])}, false});
+                        }
+                    }
+                }
+            }
+        }
 
-                // Check if this path is better than any previous one
-                bool inOpenSet = IsInOpenSet(neighborNode);
+        if (candidates.empty()) {
+            return border;
+        }
 
-                if (!inOpenSet || tentativeGCost < neighborNode.gCost) {
-                    neighborNode.parent = new PathNode(current);
-                    neighborNode.gCost = tentativeGCost;
-                    neighborNode.hCost = CalculateHeuristic(neighborPos, goalPos);
-                    neighborNode.fCost = neighborNode.GetFCost();
+        // Group crossings in the same direction whose cells touch on both
+        // sides, then cut groups into runs of PORTAL_SPAN along the border.
+        // Keying on one side only would let a drop off a wall stand in for
+        // the doorway next to it.
+        std::sort(candidates.begin(), candidates.end(), [](const Candidate& l, const Candidate& r) {
+            return l.offset != r.offset ? l.offset < r.offset : l.yA < r.yA;
+        });
+
+        std::vector<int> group(candidates.size(), -1);
+        int groupCount = 0;
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            if (group[i] >= 0) {
+                continue;
+            }
+            std::vector<size_t> stack{i};
+            group[i] = groupCount;
+            while (!stack.empty()) {
+                const size_t c = stack.back();
+                stack.pop_back();
+                for (size_t j = 0; j < candidates.size(); ++j) {
+                    if (group[j] < 0 && candidates[j].forward == candidates[c].forward &&
+                        std::abs(candidates[j].offset - candidates[c].offset) <= 1 &&
+                        std::abs(candidates[j].yA - candidates[c].yA) <= 1 &&
+                        std::abs(candidates[j].yB - candidates[c].yB) <= 1) {
+                        group[j] = groupCount;
+                        stack.push_back(j);
+                    }
+                }
+            }
+            groupCount++;
+        }
+
+        for (int g = 0; g < groupCount; ++g) {
+            int minOffset = CHUNK_SIZE;
+            int maxOffset = -1;
+            for (size_t i = 0; i < candidates.size(); ++i) {
+                if (group[i] == g) {
+                    minOffset = std::min(minOffset, candidates[i].offset);
+                    maxOffset = std::max(maxOffset, candidates[i].offset);
+                }
+            }
+
+            for (int runStart = minOffset; runStart <= maxOffset; runStart += PORTAL_SPAN) {
+                const int runEnd = std::min(runStart + PORTAL_SPAN - 1, maxOffset);
+                const float middle = static_cast<float>(runStart + runEnd) * 0.5f;
 
-                    if (!inOpenSet) {
-                        AddToOpenSet(neighborNode);
+                // The crossing nearest the middle of the run
+                const Candidate* best = nullptr;
+                for (size_t i = 0; i < candidates.size(); ++i) {
+                    const Candidate& c = candidates[i];
+                    if (group[i] != g || c.offset < runStart || c.offset > runEnd) {
+                        continue;
                     }
+                    if (!best || std::abs(static_cast<float>(c.offset) - middle) < std::abs(static_cast<float>(best->offset) - middle)) {
+                        best = &c;
+                    }
+                }
+                if (best) {
+                    border->crossings.push_back(best->crossing);
                 }
             }
+        }
 
-            nodesExplored++;
+        return border;
+    }
 
-            // Check limits
-            if (nodesExplored > m_maxSearchDistance * m_maxSearchDistance) {
-                break;
+    std::shared_ptr<const ChunkPortalGraph::ChunkGraph> ChunkPortalGraph::GetChunkGraph(int chunkX, int chunkZ) {
+        const uint64_t key = ChunkKey(chunkX, chunkZ);
+        uint64_t epoch;
+        {
+            std::shared_lock<std::shared_mutex> lock(m_mutex);
+            auto it = m_chunks.find(key);
+            if (it != m_chunks.end()) {
+                return it->second;
+            }
+            epoch = m_epoch;
+        }
+
+        auto graph = BuildChunkGraph(chunkX, chunkZ);
+
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        if (m_epoch != epoch) {
+            return graph;
+        }
+        return m_chunks.emplace(key, graph).first->second;
+    }
+
+    std::shared_ptr<const ChunkPortalGraph::ChunkGraph> ChunkPortalGraph::BuildChunkGraph(int chunkX, int chunkZ) {
+        auto graph = std::make_shared<ChunkGraph>();
+
+        auto addPortal = [&](const glm::ivec3& position) {
+            auto inserted = graph->portalIndex.emplace(PositionKey(position), static_cast<int32_t>(graph->portals.size()));
+            if (inserted.second) {
+                graph->portals.push_back(position);
+                graph->exits.emplace_back();
+            }
+            return inserted.first->second;
+        };
+
+        const std::shared_ptr<const Border> borders[4] = {
+            GetBorder(chunkX, chunkZ, true),
+            GetBorder(chunkX - 1, chunkZ, true),
+            GetBorder(chunkX, chunkZ, false),
+            GetBorder(chunkX, chunkZ - 1, false)
+        };
+
+        for (const auto& border : borders) {
+            for (const Crossing& crossing : border->crossings) {
+                if (ChunkOf(crossing.from.x) == chunkX && ChunkOf(crossing.from.z) == chunkZ) {
+                    graph->exits[static_cast<size_t>(addPortal(crossing.from))].push_back(crossing);
+                } else {
+                    addPortal(crossing.to);
+                }
+            }
+        }
+
+        // One Dijkstra per portal gives its cost to every other portal
+        graph->edges.resize(graph->portals.size());
+        for (size_t p = 0; p < graph->portals.size(); ++p) {
+            CostsInChunk(graph->portals[p], chunkX, chunkZ, graph->portals, graph->edges[p]);
+        }
+
+        return graph;
+    }
+
+    void ChunkPortalGraph::CostsInChunk(const glm::ivec3& from, int chunkX, int chunkZ,
+                                        const std::vector<glm::ivec3>& targets, std::vector<Edge>& edges) const {
+        const int minX = chunkX * CHUNK_SIZE;
+        const int minZ = chunkZ * CHUNK_SIZE;
+        glm::ivec3 neighbors[PathfindingGrid::MAX_NEIGHBORS];
+        int nodesExplored;
+
+        // Dijkstra that stops once every target is settled
+        size_t remaining = 0;
+        for (const glm::ivec3& target : targets) {
+            remaining += target != from ? 1u : 0u;
+        }
+        auto allSettled = [&](const glm::ivec3& position) {
+            if (position != from && std::find(targets.begin(), targets.end(), position) != targets.end()) {
+                remaining--;
+            }
+            return remaining == 0;
+        };
+
+        RunSearch(t_gridArena, from, allSettled, CHUNK_SEARCH_NODES, nullptr,
+            [&](const glm::ivec3& position, auto&& emit) {
+                const int count = m_grid.GetNeighbors(position, neighbors);
+                for (int i = 0; i < count; ++i) {
+                    const glm::ivec3& n = neighbors[i];
+                    if (n.x >= minX && n.x < minX + CHUNK_SIZE && n.z >= minZ && n.z < minZ + CHUNK_SIZE) {
+                        emit(n, m_grid.GetMovementCost(position, n));
+                    }
+                }
+            },
+            [](const glm::ivec3&) { return 0.0f; },
+            nodesExplored);
+
+        edges.clear();
+        for (size_t t = 0; t < targets.size(); ++t) {
+            if (targets[t] == from) {
+                continue;
+            }
+            const int32_t index = t_gridArena.Find(targets[t]);
+            if (index >= 0 && t_gridArena.GetNode(index).closed) {
+                edges.push_back({static_cast<int32_t>(t), t_gridArena.GetNode(index).gCost});
+            }
+        }
+    }
+
+    bool ChunkPortalGraph::SearchInChunk(const glm::ivec3& from, const glm::ivec3& to, int chunkX, int chunkZ,
+                                         std::vector<glm::ivec3>* path, float* cost) const {
+        const int minX = chunkX * CHUNK_SIZE;
+        const int minZ = chunkZ * CHUNK_SIZE;
+        glm::ivec3 neighbors[PathfindingGrid::MAX_NEIGHBORS];
+        int nodesExplored;
+
+        const int32_t goal = RunSearch(t_gridArena, from,
+            [&](const glm::ivec3& position) { return position == to; },
+            CHUNK_SEARCH_NODES, nullptr,
+            [&](const glm::ivec3& position, auto&& emit) {
+                const int count = m_grid.GetNeighbors(position, neighbors);
+                for (int i = 0; i < count; ++i) {
+                    const glm::ivec3& n = neighbors[i];
+                    if (n.x >= minX && n.x < minX + CHUNK_SIZE && n.z >= minZ && n.z < minZ + CHUNK_SIZE) {
+                        emit(n, m_grid.GetMovementCost(position, n));
+                    }
+                }
+            },
+            [&](const glm::ivec3& position) { return OctileDistance(position, to); },
+            nodesExplored);
+
+        if (goal < 0) {
+            return false;
+        }
+        if (cost) {
+            *cost = t_gridArena.GetNode(goal).gCost;
+        }
+        if (path) {
+            ReconstructPath(t_gridArena, goal, *path);
+        }
+        return true;
+    }
+
+    bool ChunkPortalGraph::FindPath(const glm::ivec3& start, const glm::ivec3& goal,
+                                    std::vector<glm::ivec3>& path, int maxPortalNodes) {
+        path.clear();
+
+        const int startChunkX = ChunkOf(start.x);
+        const int startChunkZ = ChunkOf(start.z);
+        const int goalChunkX = ChunkOf(goal.x);
+        const int goalChunkZ = ChunkOf(goal.z);
+
+        if (startChunkX == goalChunkX && startChunkZ == goalChunkZ &&
+            SearchInChunk(start, goal, startChunkX, startChunkZ, &path, nullptr)) {
+            return true;
+        }
+
+        // Chunk graphs touched by this search stay alive until it is done
+        std::unordered_map<uint64_t, std::shared_ptr<const ChunkGraph>> touched;
+        auto chunkGraph = [&](int chunkX, int chunkZ) -> const ChunkGraph& {
+            auto& slot = touched[ChunkKey(chunkX, chunkZ)];
+            if (!slot) {
+                slot = GetChunkGraph(chunkX, chunkZ);
             }
+            return *slot;
+        };
+
+        // Start to the portals of its chunk
+        const ChunkGraph& startGraph = chunkGraph(startChunkX, startChunkZ);
+        std::vector<Edge> startEdges;
+        CostsInChunk(start, startChunkX, startChunkZ, startGraph.portals, startEdges);
+
+        // Portals of the goal chunk to the goal
+        const ChunkGraph& goalGraph = chunkGraph(goalChunkX, goalChunkZ);
+        std::vector<float> goalCosts(goalGraph.portals.size(), INFINITE_COST);
+        bool goalReachable = false;
+        for (size_t p = 0; p < goalGraph.portals.size(); ++p) {
+            if (SearchInChunk(goalGraph.portals[p], goal, goalChunkX, goalChunkZ, nullptr, &goalCosts[p])) {
+                goalReachable = true;
+            }
+        }
+
+        if (startEdges.empty() || !goalReachable) {
+            return false;
+        }
+
+        int nodesExplored;
+        const int32_t goalNode = RunSearch(t_portalArena, start,
+            [&](const glm::ivec3& position) { return position == goal; },
+            maxPortalNodes, nullptr,
+            [&](const glm::ivec3& position, auto&& emit) {
+                if (position == start) {
+                    for (const Edge& edge : startEdges) {
+                        emit(startGraph.portals[static_cast<size_t>(edge.target)], edge.cost);
+                    }
+                }
+
+                const int chunkX = ChunkOf(position.x);
+                const int chunkZ = ChunkOf(position.z);
+                const ChunkGraph& graph = chunkGraph(chunkX, chunkZ);
+                auto it = graph.portalIndex.find(PositionKey(position));
+                if (it == graph.portalIndex.end()) {
+                    return;
+                }
+
+                const size_t portal = static_cast<size_t>(it->second);
+                for (const Edge& edge : graph.edges[portal]) {
+                    emit(graph.portals[static_cast<size_t>(edge.target)], edge.cost);
+                }
+                for (const Crossing& crossing : graph.exits[portal]) {
+                    emit(crossing.to, crossing.cost);
+                }
+                if (chunkX == goalChunkX && chunkZ == goalChunkZ && goalCosts[portal] < INFINITE_COST) {
+                    emit(goal, goalCosts[portal]);
+                }
+            },
+            [&](const glm::ivec3& position) { return OctileDistance(position, goal); },
+            nodesExplored);
+
+        if (goalNode < 0) {
+            return false;
+        }
+
+        std::vector<glm::ivec3> waypoints;
+        ReconstructPath(t_portalArena, goalNode, waypoints);
+
+        // Refine with one A* limited to the chunks the plan passes through.
+        // Following the portal cells themselves would zig-zag through each
+        // portal's middle; the corridor search straightens that out.
+        std::unordered_set<uint64_t> corridor;
+        for (const glm::ivec3& waypoint : waypoints) {
+            corridor.insert(ChunkKey(ChunkOf(waypoint.x), ChunkOf(waypoint.z)));
+        }
+
+        glm::ivec3 neighbors[PathfindingGrid::MAX_NEIGHBORS];
+        const int32_t refined = RunSearch(t_gridArena, start,
+            [&](const glm::ivec3& position) { return position == goal; },
+            CHUNK_SEARCH_NODES * static_cast<int>(corridor.size()), nullptr,
+            [&](const glm::ivec3& position, auto&& emit) {
+                const int count = m_grid.GetNeighbors(position, neighbors);
+                for (int i = 0; i < count; ++i) {
+                    const glm::ivec3& n = neighbors[i];
+                    if (corridor.count(ChunkKey(ChunkOf(n.x), ChunkOf(n.z)))) {
+                        emit(n, m_grid.GetMovementCost(position, n));
+                    }
+                }
+            },
+            [&](const glm::ivec3& position) { return OctileDistance(position, goal); },
+            nodesExplored);
+
+        if (refined < 0) {
+            return false;
+        }
+        ReconstructPath(t_gridArena, refined, path);
+        return true;
+    }
+
+    void ChunkPortalGraph::InvalidateChunk(int chunkX, int chunkZ) {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        m_epoch++;
+
+        m_borders.erase(BorderKey(chunkX, chunkZ, true));
+        m_borders.erase(BorderKey(chunkX - 1, chunkZ, true));
+        m_borders.erase(BorderKey(chunkX, chunkZ, false));
+        m_borders.erase(BorderKey(chunkX, chunkZ - 1, false));
+
+        m_chunks.erase(ChunkKey(chunkX, chunkZ));
+        m_chunks.erase(ChunkKey(chunkX + 1, chunkZ));
+        m_chunks.erase(ChunkKey(chunkX - 1, chunkZ));
+        m_chunks.erase(ChunkKey(chunkX, chunkZ + 1));
+        m_chunks.erase(ChunkKey(chunkX, chunkZ - 1));
+    }
+
+    void ChunkPortalGraph::Clear() {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        m_epoch++;
+        m_borders.clear();
+        m_chunks.clear();
+    }
+
+    size_t ChunkPortalGraph::GetCachedChunkCount() const {
+        std::shared_lock<std::shared_mutex> lock(m_mutex);
+        return m_chunks.size();
+    }
+
+    // Pathfinding implementation
+    Pathfinding::Pathfinding(World* world)
+        : m_world(world), m_grid(std::make_unique<PathfindingGrid>(world)) {
+    }
+
+    Pathfinding::Pathfinding(PathfindingGrid::BlockQuery blockQuery)
+        : m_world(nullptr), m_grid(std::make_unique<PathfindingGrid>(std::move(blockQuery))) {
+    }
+
+    std::vector<glm::ivec3> Pathfinding::FindPath(const glm::vec3& start,
+                                                 const glm::vec3& goal,
+                                                 Entity* entity) {
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        // Convert to integer coordinates
+        glm::ivec3 startPos = glm::round(start);
+        glm::ivec3 goalPos = glm::round(goal);
+
+        // Adjust to ground level
+        startPos.y = m_grid->FindGroundLevel(startPos);
+        goalPos.y = m_grid->FindGroundLevel(goalPos);
+
+        // Early exit if start and goal are the same
+        if (startPos == goalPos) {
+            return {startPos};
+        }
+
+        m_cancelled = false;
+
+        std::vector<glm::ivec3> path;
+        int nodesExplored = 0;
+
+        // Long paths are planned chunk by chunk first
+        const int horizontalDistance = std::max(std::abs(goalPos.x - startPos.x), std::abs(goalPos.z - startPos.z));
+        if (m_portalGraph && horizontalDistance >= m_hierarchicalThreshold &&
+            m_portalGraph->FindPath(startPos, goalPos, path, m_maxSearchDistance * m_maxSearchDistance)) {
+            m_stats.hierarchicalSearches++;
+        } else {
+            nodesExplored = SearchGrid(startPos, goalPos, path);
         }
 
-        // No path found
         auto endTime = std::chrono::high_resolution_clock::now();
         float searchTime = std::chrono::duration<float>(endTime - startTime).count();
 
-        UpdateStats(false, searchTime, nodesExplored, 0);
-        return {};
+        UpdateStats(!path.empty(), searchTime, nodesExplored, static_cast<int>(path.size()));
+        return path;
+    }
+
+    int Pathfinding::SearchGrid(const glm::ivec3& startPos, const glm::ivec3& goalPos, std::vector<glm::ivec3>& path) {
+        glm::ivec3 neighbors[PathfindingGrid::MAX_NEIGHBORS];
+        int nodesExplored = 0;
+
+        const int32_t goalNode = RunSearch(t_gridArena, startPos,
+            [&](const glm::ivec3& position) { return position == goalPos; },
+            m_maxSearchDistance * m_maxSearchDistance, &m_cancelled,
+            [&](const glm::ivec3& position, auto&& emit) {
+                const int count = m_grid->GetNeighbors(position, neighbors);
+                for (int i = 0; i < count; ++i) {
+                    emit(neighbors[i], m_grid->GetMovementCost(position, neighbors[i]));
+                }
+            },
+            [&](const glm::ivec3& position) { return CalculateHeuristic(position, goalPos); },
+            nodesExplored);
+
+        if (goalNode >= 0) {
+            ReconstructPath(t_gridArena, goalNode, path);
+        } else {
+            path.clear();
+        }
+        return nodesExplored;
     }
 
     std::vector<glm::ivec3> Pathfinding::FindPathAsync(const glm::vec3& start,
@@ -250,6 +992,23 @@ namespace VoxelCraft {
         m_cancelled = true;
     }
 
+    void Pathfinding::EnableDiagonalMovement(bool enable) {
+        m_allowDiagonal = enable;
+        m_grid->SetAllowDiagonal(enable);
+    }
+
+    void Pathfinding::EnableHierarchical(bool enable) {
+        if (!enable) {
+            m_portalGraph.reset();
+        } else if (!m_portalGraph) {
+            m_portalGraph = std::make_shared<ChunkPortalGraph>(*m_grid);
+        }
+    }
+
+    void Pathfinding::SetPortalGraph(std::shared_ptr<ChunkPortalGraph> graph) {
+        m_portalGraph = std::move(graph);
+    }
+
     std::vector<glm::ivec3> Pathfinding::SimplifyPath(const std::vector<glm::ivec3>& path) const {
         if (path.size() <= 2) {
             return path;
@@ -302,56 +1061,6 @@ namespace VoxelCraft {
         }
     }
 
-    std::vector<glm::ivec3> Pathfinding::ReconstructPath(const PathNode& goalNode) const {
-        std::vector<glm::ivec3> path;
-        const PathNode* current = &goalNode;
-
-        while (current != nullptr) {
-            path.push_back(current->position);
-            current = current->parent;
-        }
-
-        std::reverse(path.begin(), path.end());
-        return path;
-    }
-
-    PathNode Pathfinding::GetLowestCostNode() {
-        auto it = std::min_element(m_openSet.begin(), m_openSet.end(),
-            [](const auto& a, const auto& b) {
-                return a.second.GetFCost() < b.second.GetFCost();
-            });
-
-        PathNode node = it->second;
-        m_openSet.erase(it);
-        return node;
-    }
-
-    bool Pathfinding::IsInOpenSet(const PathNode& node) const {
-        return m_openSet.find(node) != m_openSet.end();
-    }
-
-    bool Pathfinding::IsInClosedSet(const PathNode& node) const {
-        return m_closedSet.find(node) != m_closedSet.end();
-    }
-
-    void Pathfinding::AddToOpenSet(const PathNode& node) {
-        m_openSet[node] = node;
-    }
-
-    void Pathfinding::AddToClosedSet(const PathNode& node) {
-        m_closedSet[node] = node;
-    }
-
-    void Pathfinding::RemoveFromOpenSet(const PathNode& node) {
-        m_openSet.erase(node);
-    }
-
-    void Pathfinding::ClearData() {
-        m_openSet.clear();
-        m_closedSet.clear();
-        m_cancelled = false;
-    }
-
     void Pathfinding::UpdateStats(bool success, float searchTime, int nodesExplored, int pathLength) {
         m_stats.totalSearches++;
         if (success) {
@@ -15,6 +15,8 @@
 #include <memory>
 #include <functional>
 #include <chrono>
+#include <cstdint>
+#include <shared_mutex>
 #include <glm/glm.hpp>
 
 namespace VoxelCraft {
@@ -64,9 +66,24 @@ namespace VoxelCraft {
     /**
      * @class PathfindingGrid
      * @brief Grid representation for pathfinding
+     *
+     * Moves are one block sideways, optionally diagonal, stepping up at most
+     * one block or dropping up to three. A diagonal is only allowed when both
+     * cardinal blocks next to it are walkable at the same level, so paths
+     * never cut corners.
      */
     class PathfindingGrid {
     public:
+        /**
+         * @brief Block lookup returning the block ID at world coordinates
+         */
+        using BlockQuery = std::function<int(int, int, int)>;
+
+        static constexpr int MAX_NEIGHBORS = 8;
+        static constexpr int MAX_STEP_UP = 1;
+        static constexpr int MAX_DROP = 3;
+        static constexpr int MAX_PREDECESSORS = 4 * (MAX_STEP_UP + MAX_DROP + 1) + 4;
+
         /**
          * @brief Constructor
          * @param world World reference
@@ -74,6 +91,12 @@ namespace VoxelCraft {
          */
         PathfindingGrid(World* world, int chunkRadius = 3);
 
+        /**
+         * @brief Constructor
+         * @param blockQuery Block lookup used instead of a World
+         */
+        explicit PathfindingGrid(BlockQuery blockQuery);
+
         /**
          * @brief Check if a position is walkable
          * @param position Position to check
@@ -88,6 +111,24 @@ namespace VoxelCraft {
          */
         std::vector<glm::ivec3> GetNeighbors(const glm::ivec3& position) const;
 
+        /**
+         * @brief Get neighbors of a position without allocating
+         * @param position Current position
+         * @param neighbors Receives up to MAX_NEIGHBORS positions
+         * @return Number of neighbors written
+         */
+        int GetNeighbors(const glm::ivec3& position, glm::ivec3* neighbors) const;
+
+        /**
+         * @brief Get positions that reach a position in one move
+         * @param position Target position
+         * @param predecessors Receives up to MAX_PREDECESSORS positions
+         * @return Number of predecessors written
+         *
+         * The reverse of GetNeighbors, used to search outward from a goal.
+         */
+        int GetPredecessors(const glm::ivec3& position, glm::ivec3* predecessors) const;
+
         /**
          * @brief Get movement cost between two positions
          * @param from From position
@@ -132,9 +173,24 @@ namespace VoxelCraft {
          */
         bool IsInLava(const glm::ivec3& position) const;
 
+        /**
+         * @brief Enable diagonal moves
+         * @param enable Whether to enable diagonal moves
+         */
+        void SetAllowDiagonal(bool enable) { m_allowDiagonal = enable; }
+
     private:
         World* m_world;
         int m_chunkRadius;
+        BlockQuery m_blockQuery;
+        bool m_allowDiagonal = true;
+
+        /**
+         * @brief Get block ID at position
+         * @param position Position to check
+         * @return Block ID
+         */
+        int GetBlockID(const glm::ivec3& position) const;
 
         /**
          * @brief Check if block at position is solid
@@ -151,9 +207,217 @@ namespace VoxelCraft {
         bool IsLiquidBlock(const glm::ivec3& position) const;
     };
 
+    /**
+     * @class PathSearchArena
+     * @brief Reusable node storage and open list for one A* search at a time
+     *
+     * Nodes live in a flat vector and are found by position through an
+     * open-addressing table. The open list is a binary heap of node indices;
+     * each node remembers its heap slot, so a cheaper route found later is a
+     * decrease-key instead of a duplicate entry. Reset() keeps all capacity
+     * and clears the table by bumping a generation stamp, so a warmed-up
+     * arena searches without allocating. Each thread keeps its own arenas.
+     */
+    class PathSearchArena {
+    public:
+        /**
+         * @struct Node
+         * @brief Search state of one position
+         */
+        struct Node {
+            glm::ivec3 position;
+            float gCost;            // Cost from start
+            float fCost;            // gCost plus heuristic
+            int32_t parent;         // Node index, -1 for the start
+            int32_t heapIndex;      // Slot in the open list, -1 when not open
+            bool closed;
+        };
+
+        PathSearchArena();
+
+        /**
+         * @brief Forget all nodes, keeping the memory
+         */
+        void Reset();
+
+        /**
+         * @brief Find the node for a position, creating it if needed
+         * @param position Position
+         * @param created Set to true if the node is new
+         * @return Node index
+         */
+        int32_t GetOrCreate(const glm::ivec3& position, bool& created);
+
+        /**
+         * @brief Find the node for a position
+         * @param position Position
+         * @return Node index or -1
+         */
+        int32_t Find(const glm::ivec3& position) const;
+
+        Node& GetNode(int32_t index) { return m_nodes[static_cast<size_t>(index)]; }
+        const Node& GetNode(int32_t index) const { return m_nodes[static_cast<size_t>(index)]; }
+        size_t GetNodeCount() const { return m_nodes.size(); }
+
+        /**
+         * @brief Add a node to the open list, or move it up after its cost dropped
+         * @param index Node index
+         */
+        void PushOrDecrease(int32_t index);
+
+        /**
+         * @brief Remove the open node with the lowest F cost
+         * @return Node index
+         */
+        int32_t PopMin();
+
+        bool IsOpenEmpty() const { return m_heap.empty(); }
+
+    private:
+        std::vector<Node> m_nodes;
+        std::vector<int32_t> m_heap;
+        std::vector<int32_t> m_slots;
+        std::vector<uint32_t> m_slotGeneration;
+        uint32_t m_generation;
+        uint32_t m_slotMask;
+
+        size_t HashPosition(const glm::ivec3& position) const;
+        void Rehash(size_t slotCount);
+        bool Less(int32_t a, int32_t b) const;
+        void SiftUp(size_t slot);
+        void SiftDown(size_t slot);
+    };
+
+    /**
+     * @struct PathfindingStats
+     * @brief Statistics for pathfinding operations
+     */
+    struct PathfindingStats {
+        int totalSearches = 0;
+        int successfulSearches = 0;
+        int failedSearches = 0;
+        float averageSearchTime = 0.0f;
+        float minSearchTime = 999999.0f;
+        float maxSearchTime = 0.0f;
+        int totalNodesExplored = 0;
+        int averagePathLength = 0;
+        int longestPathFound = 0;
+        int shortestPathFound = 999999;
+        int hierarchicalSearches = 0;
+    };
+
+    /**
+     * @class ChunkPortalGraph
+     * @brief Chunk-level graph of border crossings for long paths
+     *
+     * Every pair of neighbouring chunk columns is scanned once for cells where
+     * a mob can step from one to the other. Touching crossings are grouped and
+     * each group of up to PORTAL_SPAN cells becomes one portal: a node on each
+     * side. Inside a chunk, one Dijkstra per portal node, limited to that
+     * chunk, gives the cost to every other portal of the chunk.
+     *
+     * A long path is planned over these portals first and then refined with
+     * short A* searches that never leave one chunk, so the work grows with the
+     * number of chunks crossed instead of with the area around the route.
+     * Chunks are built on first use and cached until InvalidateChunk.
+     *
+     * Safe to share between threads; cached chunks are immutable and replaced
+     * as a whole.
+     */
+    class ChunkPortalGraph {
+    public:
+        static constexpr int CHUNK_SIZE = 16;
+        static constexpr int PORTAL_SPAN = 8;
+
+        /**
+         * @brief Constructor
+         * @param grid Movement rules and block lookup (copied)
+         * @param minY Lowest Y scanned for portals
+         * @param maxY Highest Y scanned for portals
+         */
+        ChunkPortalGraph(const PathfindingGrid& grid, int minY = 0, int maxY = 255);
+
+        /**
+         * @brief Plan over portals, then refine into a block path
+         * @param start Start position (standing cell)
+         * @param goal Goal position (standing cell)
+         * @param path Receives the block path, start and goal included
+         * @param maxPortalNodes Portal nodes the coarse search may expand
+         * @return true if a path was found
+         */
+        bool FindPath(const glm::ivec3& start, const glm::ivec3& goal,
+                      std::vector<glm::ivec3>& path, int maxPortalNodes = 4096);
+
+        /**
+         * @brief Drop cached data for a chunk after its blocks changed
+         * @param chunkX Chunk X coordinate
+         * @param chunkZ Chunk Z coordinate
+         *
+         * The four neighbouring chunks share its borders, so they are rebuilt too.
+         */
+        void InvalidateChunk(int chunkX, int chunkZ);
+
+        /**
+         * @brief Drop all cached chunks
+         */
+        void Clear();
+
+        /**
+         * @brief Get number of chunks with a built portal graph
+         * @return Chunk count
+         */
+        size_t GetCachedChunkCount() const;
+
+    private:
+        struct Crossing {
+            glm::ivec3 from;
+            glm::ivec3 to;
+            float cost;
+        };
+
+        struct Border {
+            std::vector<Crossing> crossings;    // Both directions
+        };
+
+        struct Edge {
+            int32_t target;                     // Portal index in the same chunk
+            float cost;
+        };
+
+        struct ChunkGraph {
+            std::vector<glm::ivec3> portals;
+            std::vector<std::vector<Edge>> edges;       // Inside the chunk
+            std::vector<std::vector<Crossing>> exits;   // Into neighbouring chunks
+            std::unordered_map<uint64_t, int32_t> portalIndex;
+        };
+
+        PathfindingGrid m_grid;
+        int m_minY;
+        int m_maxY;
+
+        mutable std::shared_mutex m_mutex;
+        uint64_t m_epoch;                       // Bumped on invalidation; builds started earlier are not cached
+        std::unordered_map<uint64_t, std::shared_ptr<const Border>> m_borders;
+        std::unordered_map<uint64_t, std::shared_ptr<const ChunkGraph>> m_chunks;
+
+        std::shared_ptr<const ChunkGraph> GetChunkGraph(int chunkX, int chunkZ);
+        std::shared_ptr<const Border> GetBorder(int chunkX, int chunkZ, bool alongX);
+        std::shared_ptr<const Border> BuildBorder(int chunkX, int chunkZ, bool alongX) const;
+        std::shared_ptr<const ChunkGraph> BuildChunkGraph(int chunkX, int chunkZ);
+
+        void CostsInChunk(const glm::ivec3& from, int chunkX, int chunkZ,
+                          const std::vector<glm::ivec3>& targets, std::vector<Edge>& edges) const;
+        bool SearchInChunk(const glm::ivec3& from, const glm::ivec3& to, int chunkX, int chunkZ,
+                           std::vector<glm::ivec3>* path, float* cost) const;
+    };
+
     /**
      * @class Pathfinding
      * @brief A* pathfinding implementation
+     *
+     * Searches run on the calling thread's PathSearchArena. Paths longer than
+     * the hierarchical threshold are planned over a ChunkPortalGraph when one
+     * is enabled, falling back to a plain search if that fails.
      */
     class Pathfinding {
     public:
@@ -163,6 +427,12 @@ namespace VoxelCraft {
          */
         Pathfinding(World* world);
 
+        /**
+         * @brief Constructor
+         * @param blockQuery Block lookup used instead of a World
+         */
+        explicit Pathfinding(PathfindingGrid::BlockQuery blockQuery);
+
         /**
          * @brief Find path between two points
          * @param start Start position
@@ -228,7 +498,7 @@ namespace VoxelCraft {
          * @brief Enable diagonal movement
          * @param enable Whether to enable diagonal movement
          */
-        void EnableDiagonalMovement(bool enable) { m_allowDiagonal = enable; }
+        void EnableDiagonalMovement(bool enable);
 
         /**
          * @brief Enable jumping
@@ -242,9 +512,35 @@ namespace VoxelCraft {
          */
         void SetHeuristicWeight(float weight) { m_heuristicWeight = weight; }
 
+        /**
+         * @brief Enable chunk-level planning for long paths
+         * @param enable Whether to plan over a portal graph; creates a private
+         *        graph if none was set with SetPortalGraph
+         */
+        void EnableHierarchical(bool enable);
+
+        /**
+         * @brief Share a portal graph between pathfinders of the same world
+         * @param graph Portal graph, or nullptr to disable hierarchical search
+         */
+        void SetPortalGraph(std::shared_ptr<ChunkPortalGraph> graph);
+
+        /**
+         * @brief Get the portal graph in use
+         * @return Portal graph or nullptr
+         */
+        ChunkPortalGraph* GetPortalGraph() const { return m_portalGraph.get(); }
+
+        /**
+         * @brief Set the horizontal distance from which paths are planned over portals
+         * @param blocks Distance in blocks
+         */
+        void SetHierarchicalThreshold(int blocks) { m_hierarchicalThreshold = blocks; }
+
     private:
         World* m_world;
         std::unique_ptr<PathfindingGrid> m_grid;
+        std::shared_ptr<ChunkPortalGraph> m_portalGraph;
         PathfindingStats m_stats;
 
         // Configuration
@@ -253,17 +549,17 @@ namespace VoxelCraft {
         bool m_allowDiagonal = true;
         bool m_allowJumping = true;
         float m_heuristicWeight = 1.0f;
+        int m_hierarchicalThreshold = 96;
         bool m_cancelled = false;
 
-        // A* data structures
-        std::unordered_map<PathNode, PathNode, PathNodeHash> m_openSet;
-        std::unordered_map<PathNode, PathNode, PathNodeHash> m_closedSet;
-
-        struct NodeCompare {
-            bool operator()(const PathNode& a, const PathNode& b) const {
-                return a.GetFCost() > b.GetFCost();
-            }
-        };
+        /**
+         * @brief Plain A* over blocks
+         * @param startPos Start position
+         * @param goalPos Goal position
+         * @param path Receives the path
+         * @return Number of nodes explored
+         */
+        int SearchGrid(const glm::ivec3& startPos, const glm::ivec3& goalPos, std::vector<glm::ivec3>& path);
 
         /**
          * @brief Calculate heuristic cost (Manhattan distance)
@@ -274,71 +570,13 @@ namespace VoxelCraft {
         float CalculateHeuristic(const glm::ivec3& from, const glm::ivec3& to) const;
 
         /**
-         * @brief Reconstruct path from goal to start
-         * @param goalNode Goal node
-         * @return Vector of positions
-         */
-        std::vector<glm::ivec3> ReconstructPath(const PathNode& goalNode) const;
-
-        /**
-         * @brief Get node with lowest F cost from open set
-         * @return Lowest cost node
-         */
-        PathNode GetLowestCostNode();
-
-        /**
-         * @brief Check if node is in open set
-         * @param node Node to check
-         * @return true if in open set
-         */
-        bool IsInOpenSet(const PathNode& node) const;
-
-        /**
-         * @brief Check if node is in closed set
-         * @param node Node to check
-         * @return true if in closed set
-         */
-        bool IsInClosedSet(const PathNode& node) const;
-
-        /**
-         * @brief Add node to open set
-         * @param node Node to add
-         */
-        void AddToOpenSet(const PathNode& node);
-
-        /**
-         * @brief Add node to closed set
-         * @param node Node to add
-         */
-        void AddToClosedSet(const PathNode& node);
-
-        /**
-         * @brief Remove node from open set
-         * @param node Node to remove
+         * @brief Update search statistics
+         * @param success Whether a path was found
+         * @param searchTime Search time in seconds
+         * @param nodesExplored Nodes expanded
+         * @param pathLength Path length in waypoints
          */
-        void RemoveFromOpenSet(const PathNode& node);
-
-        /**
-         * @brief Clear pathfinding data
-         */
-        void ClearData();
-    };
-
-    /**
-     * @struct PathfindingStats
-     * @brief Statistics for pathfinding operations
-     */
-    struct PathfindingStats {
-        int totalSearches = 0;
-        int successfulSearches = 0;
-        int failedSearches = 0;
-        float averageSearchTime = 0.0f;
-        float minSearchTime = 999999.0f;
-        float maxSearchTime = 0.0f;
-        int totalNodesExplored = 0;
-        int averagePathLength = 0;
-        int longestPathFound = 0;
-        int shortestPathFound = 999999;
+        void UpdateStats(bool success, float searchTime, int nodesExplored, int pathLength);
     };
 
     /**
@@ -320,6 +320,18 @@ namespace VoxelCraft {
                 props.canHarvest = false;
                 break;
 
+            case BlockType::TORCH:
+                props.name = "Torch";
+                props.textureName = "torch";
+                props.hardness = BlockHardness::INSTANT;
+                props.isSolid = false;
+                props.isTransparent = true;
+                props.lightOpacity = 0.0f;
+                props.lightLevel = 14.0f;
+                props.dropItems = {BlockType::TORCH};
+                props.dropQuantities = {1};
+                break;
+
             case BlockType::SPAWNER:
                 props.name = "Spawner";
                 props.textureName = "spawner";
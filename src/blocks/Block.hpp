@@ -105,6 +105,9 @@ namespace VoxelCraft {
         WATER,
         LAVA,
 
+        // Light sources
+        TORCH,
+
         // Total block types
         BLOCK_TYPE_COUNT
     };
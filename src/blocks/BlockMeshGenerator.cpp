@@ -0,0 +1,483 @@
+/**
+ * @file BlockMeshGenerator.cpp
+ * @brief VoxelCraft Block Mesh Generator Implementation
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#include "BlockMeshGenerator.hpp"
+#include "Block.hpp"
+#include "BlockPropertyTable.hpp"
+#include "../world/Chunk.hpp"
+#include "../world/SectionCulling.hpp"
+
+#include <algorithm>
+
+namespace VoxelCraft {
+
+    namespace {
+
+        // Chunk plus a one-block border on every side (y = -1 and y = 256 included)
+        constexpr int PAD_X = 18;
+        constexpr int PAD_Y = 258;
+        constexpr int PAD_Z = 18;
+        constexpr int PAD_VOLUME = PAD_X * PAD_Y * PAD_Z;
+
+        constexpr int CHUNK_DIMS[3] = { 16, 256, 16 };
+        constexpr int PAD_STRIDE[3] = { 1, PAD_X * PAD_Z, PAD_X };
+
+        // BlockFace order: BOTTOM, TOP, NORTH (-Z), SOUTH (+Z), WEST (-X), EAST (+X)
+        constexpr int FACE_AXIS[6] = { 1, 1, 2, 2, 0, 0 };
+        constexpr int FACE_DIR[6] = { -1, 1, -1, 1, -1, 1 };
+
+        constexpr uint8_t OUTSIDE_LIGHT = 0xF0; // Full sky, no block light
+
+        constexpr uint64_t KEY_PRESENT = 1ull << 63;
+        constexpr uint64_t KEY_TRANSPARENT = 1ull << 62;
+
+        inline int PadIndex(int px, int py, int pz) {
+            return (py * PAD_Z + pz) * PAD_X + px;
+        }
+
+        inline int FaceIndex(int axis, int dir) {
+            static constexpr int faces[3][2] = { { 4, 5 }, { 0, 1 }, { 2, 3 } };
+            return faces[axis][dir > 0 ? 1 : 0];
+        }
+
+        inline bool IsOpaque(uint16_t id) {
+            const auto& props = BlockPropertyTable::Get(id);
+            return !props.isAir && !props.isTransparent;
+        }
+
+        /**
+         * @brief Per-thread scratch so concurrent meshing never allocates
+         */
+        struct MeshScratch {
+            std::vector<uint16_t> ids;      ///< Padded block IDs
+            std::vector<uint8_t> light;     ///< Padded light (sky << 4 | block)
+            std::vector<uint64_t> mask;     ///< Face keys of one slice
+            std::vector<uint16_t> section;  ///< Unpacked section
+
+            MeshScratch()
+                : ids(PAD_VOLUME)
+                , light(PAD_VOLUME)
+                , mask(16 * 256)
+                , section(ChunkSection::SECTION_VOLUME)
+            {}
+        };
+
+        MeshScratch& GetThreadScratch() {
+            thread_local MeshScratch scratch;
+            return scratch;
+        }
+
+        /**
+         * @brief Face-to-face connectivity of one section of the padded volume
+         */
+        uint16_t ComputeSectionConnectivity(const MeshScratch& scratch, int baseY) {
+            uint16_t opaqueRows[16 * 16];
+            for (int y = 0; y < 16; ++y) {
+                for (int z = 0; z < 16; ++z) {
+                    const uint16_t* row = &scratch.ids[static_cast<size_t>(PadIndex(1, baseY + y + 1, z + 1))];
+                    uint16_t bits = 0;
+                    for (int x = 0; x < 16; ++x) {
+                        bits |= static_cast<uint16_t>(IsOpaque(row[x]) ? 1u << x : 0u);
+                    }
+                    opaqueRows[y * 16 + z] = bits;
+                }
+            }
+            return SectionCulling::ComputeConnectivity(opaqueRows);
+        }
+
+        /**
+         * @brief Copy a chunk and the facing strips of its neighbors into the padded volume
+         */
+        void FillPaddedVolume(const Chunk* chunk, const ChunkMeshNeighbors& neighbors, MeshScratch& scratch) {
+            const uint16_t air = static_cast<uint16_t>(BlockType::AIR);
+            const uint16_t floor = static_cast<uint16_t>(BlockType::BEDROCK);
+
+            std::fill(scratch.ids.begin(), scratch.ids.end(), air);
+            std::fill(scratch.light.begin(), scratch.light.end(), OUTSIDE_LIGHT);
+
+            // Nothing is visible from below the world
+            for (int pz = 0; pz < PAD_Z; ++pz) {
+                for (int px = 0; px < PAD_X; ++px) {
+                    scratch.ids[static_cast<size_t>(PadIndex(px, 0, pz))] = floor;
+                    scratch.light[static_cast<size_t>(PadIndex(px, 0, pz))] = 0;
+                }
+            }
+
+            // Center: whole sections at a time
+            const auto& blocks = chunk->GetBlockStorage();
+            const auto& light = chunk->GetLightStorage();
+            for (uint32_t s = 0; s < ChunkBlockStorage::SECTION_COUNT; ++s) {
+                const ChunkSection& section = blocks.GetSection(s);
+                const int baseY = static_cast<int>(s * ChunkSection::SECTION_SIZE);
+
+                if (section.IsUniform()) {
+                    const uint16_t id = section.GetUniformId();
+                    if (id != air) {
+                        for (int y = 0; y < 16; ++y) {
+                            for (int z = 0; z < 16; ++z) {
+                                uint16_t* row = &scratch.ids[static_cast<size_t>(PadIndex(1, baseY + y + 1, z + 1))];
+                                std::fill(row, row + 16, id);
+                            }
+                        }
+                    }
+                } else {
+                    section.Unpack(scratch.section.data());
+                    for (int y = 0; y < 16; ++y) {
+                        for (int z = 0; z < 16; ++z) {
+                            const uint16_t* src = &scratch.section[static_cast<size_t>((y << 8) | (z << 4))];
+                            std::copy(src, src + 16, &scratch.ids[static_cast<size_t>(PadIndex(1, baseY + y + 1, z + 1))]);
+                        }
+                    }
+                }
+            }
+
+            for (uint32_t y = 0; y < 256; ++y) {
+                for (uint32_t z = 0; z < 16; ++z) {
+                    for (uint32_t x = 0; x < 16; ++x) {
+                        const uint32_t index = ChunkLightStorage::GetIndex(x, y, z);
+                        scratch.light[static_cast<size_t>(PadIndex(static_cast<int>(x) + 1, static_cast<int>(y) + 1, static_cast<int>(z) + 1))] =
+                            static_cast<uint8_t>((light.GetSky(index) << 4) | light.GetBlock(index));
+                    }
+                }
+            }
+
+            // Neighbors: only the strip touching this chunk
+            for (int dz = -1; dz <= 1; ++dz) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    const Chunk* neighbor = neighbors.chunks[ChunkMeshNeighbors::Index(dx, dz)];
+                    if ((dx == 0 && dz == 0) || !neighbor) {
+                        continue;
+                    }
+
+                    const int x0 = dx < 0 ? 15 : 0;
+                    const int x1 = dx == 0 ? 15 : x0;
+                    const int z0 = dz < 0 ? 15 : 0;
+                    const int z1 = dz == 0 ? 15 : z0;
+                    const int offX = dx < 0 ? -15 : (dx > 0 ? 17 : 1);
+                    const int offZ = dz < 0 ? -15 : (dz > 0 ? 17 : 1);
+
+                    const auto& nBlocks = neighbor->GetBlockStorage();
+                    const auto& nLight = neighbor->GetLightStorage();
+                    for (int y = 0; y < 256; ++y) {
+                        for (int z = z0; z <= z1; ++z) {
+                            for (int x = x0; x <= x1; ++x) {
+                                const size_t pad = static_cast<size_t>(PadIndex(x + offX, y + 1, z + offZ));
+                                const uint32_t index = ChunkLightStorage::GetIndex(static_cast<uint32_t>(x),
+                                    static_cast<uint32_t>(y), static_cast<uint32_t>(z));
+                                scratch.ids[pad] = nBlocks.Get(static_cast<uint8_t>(x), static_cast<uint8_t>(y), static_cast<uint8_t>(z));
+                                scratch.light[pad] = static_cast<uint8_t>((nLight.GetSky(index) << 4) | nLight.GetBlock(index));
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Face visibility: neighbor must not be opaque, and equal
+         *        transparent blocks (water next to water) hide each other
+         */
+        inline bool IsFaceVisible(uint16_t id, uint16_t neighborId) {
+            return neighborId != id && !IsOpaque(neighborId);
+        }
+
+        /**
+         * @brief Vertex AO for the four face corners, packed 2 bits each
+         *
+         * Corner k is (u, v) = (0,0), (1,0), (1,1), (0,1) on the face plane.
+         */
+        inline uint32_t ComputeFaceAO(const MeshScratch& scratch, int front, int strideU, int strideV) {
+            static constexpr int cornerU[4] = { -1, 1, 1, -1 };
+            static constexpr int cornerV[4] = { -1, -1, 1, 1 };
+
+            uint32_t packed = 0;
+            for (int k = 0; k < 4; ++k) {
+                const int du = cornerU[k] * strideU;
+                const int dv = cornerV[k] * strideV;
+                const bool side1 = IsOpaque(scratch.ids[static_cast<size_t>(front + du)]);
+                const bool side2 = IsOpaque(scratch.ids[static_cast<size_t>(front + dv)]);
+                const bool corner = IsOpaque(scratch.ids[static_cast<size_t>(front + du + dv)]);
+                const uint32_t ao = (side1 && side2) ? 0u : 3u - static_cast<uint32_t>(side1 + side2 + corner);
+                packed |= ao << (2 * k);
+            }
+            return packed;
+        }
+
+    } // namespace
+
+    BlockMeshGenerator::BlockMeshGenerator()
+        : m_initialized(false)
+    {
+        BuildTextureLayers();
+    }
+
+    BlockMeshGenerator::~BlockMeshGenerator() = default;
+
+    bool BlockMeshGenerator::Initialize() {
+        m_initialized = true;
+        return true;
+    }
+
+    void BlockMeshGenerator::Shutdown() {
+        ClearCache();
+        m_initialized = false;
+    }
+
+    void BlockMeshGenerator::ClearCache() {
+        m_meshCache.clear();
+    }
+
+    uint16_t BlockMeshGenerator::GetTextureLayer(uint16_t blockId, int face) const {
+        if (blockId >= m_faceLayers.size() || face < 0 || face >= 6) {
+            return 0;
+        }
+        return m_faceLayers[blockId][static_cast<size_t>(face)];
+    }
+
+    std::vector<uint32_t> BlockMeshGenerator::BuildQuadIndices(size_t quadCount) {
+        std::vector<uint32_t> indices;
+        indices.reserve(quadCount * 6);
+        for (size_t quad = 0; quad < quadCount; ++quad) {
+            const uint32_t base = static_cast<uint32_t>(quad * 4);
+            indices.insert(indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+        }
+        return indices;
+    }
+
+    BlockMesh BlockMeshGenerator::GenerateChunkMesh(const Chunk* chunk, const ChunkMeshNeighbors& neighbors) {
+        BlockMesh mesh;
+        if (!chunk) {
+            return mesh;
+        }
+
+        MeshScratch& scratch = GetThreadScratch();
+        FillPaddedVolume(chunk, neighbors, scratch);
+
+        for (int y = 0; y < 256; ++y) {
+            for (int z = 0; z < 16; ++z) {
+                for (int x = 0; x < 16; ++x) {
+                    const int index = PadIndex(x + 1, y + 1, z + 1);
+                    const uint16_t id = scratch.ids[static_cast<size_t>(index)];
+                    if (BlockPropertyTable::IsAir(id)) {
+                        continue;
+                    }
+
+                    for (int face = 0; face < 6; ++face) {
+                        const int front = index + FACE_DIR[face] * PAD_STRIDE[FACE_AXIS[face]];
+                        if (!IsFaceVisible(id, scratch.ids[static_cast<size_t>(front)])) {
+                            continue;
+                        }
+
+                        const uint8_t light = scratch.light[static_cast<size_t>(front)];
+                        AddFaceToMesh(mesh, face, x, y, z, GetTextureLayer(id, face),
+                            std::max<uint8_t>(static_cast<uint8_t>(light >> 4), static_cast<uint8_t>(light & 0x0F)));
+                        mesh.isTransparent |= !IsOpaque(id);
+                    }
+                }
+            }
+        }
+
+        mesh.needsUpdate = false;
+        return mesh;
+    }
+
+    void BlockMeshGenerator::GenerateChunkMesh(const Chunk* chunk, MeshingMode mode,
+                                               const ChunkMeshNeighbors& neighbors, PackedChunkMesh& mesh) const {
+        mesh.Clear();
+        if (!chunk) {
+            return;
+        }
+
+        MeshScratch& scratch = GetThreadScratch();
+        FillPaddedVolume(chunk, neighbors, scratch);
+
+        // Faces only come from non-air blocks: stop scanning above the top
+        // non-empty section
+        int top = 0;
+        const auto& blocks = chunk->GetBlockStorage();
+        for (uint32_t s = 0; s < ChunkBlockStorage::SECTION_COUNT; ++s) {
+            const ChunkSection& section = blocks.GetSection(s);
+            if (!section.IsUniform() || !BlockPropertyTable::IsAir(section.GetUniformId())) {
+                top = static_cast<int>((s + 1) * ChunkSection::SECTION_SIZE);
+            }
+
+            // Section visibility graph for cave culling; uniform sections need no flood fill
+            if (section.IsUniform()) {
+                mesh.sectionConnectivity[s] = IsOpaque(section.GetUniformId())
+                    ? SectionCulling::CONNECT_NONE : SectionCulling::CONNECT_ALL;
+            } else {
+                mesh.sectionConnectivity[s] = ComputeSectionConnectivity(
+                    scratch, static_cast<int>(s * ChunkSection::SECTION_SIZE));
+            }
+        }
+        const int dims[3] = { CHUNK_DIMS[0], top, CHUNK_DIMS[2] };
+
+        for (int axis = 0; axis < 3; ++axis) {
+            const int axisU = (axis + 1) % 3;
+            const int axisV = (axis + 2) % 3;
+            const int sizeU = dims[axisU];
+            const int sizeV = dims[axisV];
+
+            for (int dir = -1; dir <= 1; dir += 2) {
+                const int face = FaceIndex(axis, dir);
+                const int frontOffset = dir * PAD_STRIDE[axis];
+
+                for (int slice = 0; slice < dims[axis]; ++slice) {
+                    // Build the face mask of this slice; equal keys may merge
+                    for (int v = 0; v < sizeV; ++v) {
+                        for (int u = 0; u < sizeU; ++u) {
+                            int pos[3];
+                            pos[axis] = slice;
+                            pos[axisU] = u;
+                            pos[axisV] = v;
+
+                            const int index = PadIndex(pos[0] + 1, pos[1] + 1, pos[2] + 1);
+                            const uint16_t id = scratch.ids[static_cast<size_t>(index)];
+                            uint64_t& key = scratch.mask[static_cast<size_t>(v * sizeU + u)];
+
+                            const int front = index + frontOffset;
+                            if (BlockPropertyTable::IsAir(id) || !IsFaceVisible(id, scratch.ids[static_cast<size_t>(front)])) {
+                                key = 0;
+                                continue;
+                            }
+
+                            key = KEY_PRESENT |
+                                  (IsOpaque(id) ? 0 : KEY_TRANSPARENT) |
+                                  (static_cast<uint64_t>(GetTextureLayer(id, face)) << 16) |
+                                  (static_cast<uint64_t>(scratch.light[static_cast<size_t>(front)]) << 8) |
+                                  ComputeFaceAO(scratch, front, PAD_STRIDE[axisU], PAD_STRIDE[axisV]);
+                        }
+                    }
+
+                    const uint32_t plane = static_cast<uint32_t>(slice + (dir > 0 ? 1 : 0));
+
+                    for (int v = 0; v < sizeV; ++v) {
+                        for (int u = 0; u < sizeU; ) {
+                            const uint64_t key = scratch.mask[static_cast<size_t>(v * sizeU + u)];
+                            if (key == 0) {
+                                ++u;
+                                continue;
+                            }
+
+                            int width = 1;
+                            int height = 1;
+
+                            if (mode == MeshingMode::GREEDY) {
+                                while (u + width < sizeU && scratch.mask[static_cast<size_t>(v * sizeU + u + width)] == key) {
+                                    ++width;
+                                }
+
+                                bool grow = true;
+                                while (v + height < sizeV && grow) {
+                                    const uint64_t* row = &scratch.mask[static_cast<size_t>((v + height) * sizeU + u)];
+                                    grow = std::all_of(row, row + width, [key](uint64_t other) { return other == key; });
+                                    if (grow) {
+                                        ++height;
+                                    }
+                                }
+                            }
+
+                            for (int dv = 0; dv < height; ++dv) {
+                                uint64_t* row = &scratch.mask[static_cast<size_t>((v + dv) * sizeU + u)];
+                                std::fill(row, row + width, 0);
+                            }
+
+                            // Emit the quad, counter-clockwise seen from outside
+                            static constexpr int cornerU[4] = { 0, 1, 1, 0 };
+                            static constexpr int cornerV[4] = { 0, 0, 1, 1 };
+                            static constexpr int positiveOrder[4] = { 0, 1, 2, 3 };
+                            static constexpr int negativeOrder[4] = { 0, 3, 2, 1 };
+                            const int* order = dir > 0 ? positiveOrder : negativeOrder;
+
+                            const uint32_t layer = static_cast<uint32_t>((key >> 16) & 0xFFFF);
+                            const uint32_t light = static_cast<uint32_t>((key >> 8) & 0xFF);
+                            auto& out = (key & KEY_TRANSPARENT) ? mesh.transparentVertices : mesh.opaqueVertices;
+
+                            for (int i = 0; i < 4; ++i) {
+                                const int corner = order[i];
+                                uint32_t pos[3];
+                                pos[axis] = plane;
+                                pos[axisU] = static_cast<uint32_t>(u + cornerU[corner] * width);
+                                pos[axisV] = static_cast<uint32_t>(v + cornerV[corner] * height);
+
+                                const uint32_t ao = static_cast<uint32_t>((key >> (2 * corner)) & 0x3);
+                                out.push_back(PackedVertex::Pack(pos[0], pos[1], pos[2], static_cast<uint32_t>(face), ao,
+                                    layer, light >> 4, light & 0x0F));
+                            }
+
+                            u += width;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    void BlockMeshGenerator::AddFaceToMesh(BlockMesh& mesh, int face, int x, int y, int z,
+                                           uint16_t textureLayer, uint8_t light) const {
+        const int axis = FACE_AXIS[face];
+        const int dir = FACE_DIR[face];
+        const int axisU = (axis + 1) % 3;
+        const int axisV = (axis + 2) % 3;
+
+        static constexpr int cornerU[4] = { 0, 1, 1, 0 };
+        static constexpr int cornerV[4] = { 0, 0, 1, 1 };
+        static constexpr int positiveOrder[4] = { 0, 1, 2, 3 };
+        static constexpr int negativeOrder[4] = { 0, 3, 2, 1 };
+        const int* order = dir > 0 ? positiveOrder : negativeOrder;
+
+        float normal[3] = { 0.0f, 0.0f, 0.0f };
+        normal[axis] = static_cast<float>(dir);
+        const float shade = static_cast<float>(light) / 15.0f;
+
+        const unsigned int base = static_cast<unsigned int>(mesh.vertices.size());
+        const int origin[3] = { x, y, z };
+
+        for (int i = 0; i < 4; ++i) {
+            const int corner = order[i];
+            float pos[3];
+            pos[axis] = static_cast<float>(origin[axis] + (dir > 0 ? 1 : 0));
+            pos[axisU] = static_cast<float>(origin[axisU] + cornerU[corner]);
+            pos[axisV] = static_cast<float>(origin[axisV] + cornerV[corner]);
+
+            // Array layer travels in the integer part of u
+            mesh.vertices.emplace_back(pos[0], pos[1], pos[2],
+                static_cast<float>(textureLayer) + static_cast<float>(cornerU[corner]), static_cast<float>(cornerV[corner]),
+                normal[0], normal[1], normal[2], shade, shade, shade, 1.0f);
+        }
+
+        mesh.indices.insert(mesh.indices.end(), { base, base + 1, base + 2, base, base + 2, base + 3 });
+    }
+
+    void BlockMeshGenerator::BuildTextureLayers() {
+        std::unordered_map<std::string, uint16_t> layerByName;
+        m_textureLayers.clear();
+        m_textureLayers.push_back("unknown");
+        layerByName["unknown"] = 0;
+
+        const size_t blockCount = static_cast<size_t>(BlockType::BLOCK_TYPE_COUNT);
+        m_faceLayers.assign(blockCount, std::array<uint16_t, 6>{});
+
+        for (size_t id = 0; id < blockCount; ++id) {
+            auto block = Block::CreateBlock(static_cast<BlockType>(id));
+            if (!block) {
+                continue;
+            }
+
+            for (int face = 0; face < 6; ++face) {
+                const std::string name = block->GetTextureName(static_cast<BlockFace>(face));
+                auto it = layerByName.find(name);
+                if (it == layerByName.end()) {
+                    it = layerByName.emplace(name, static_cast<uint16_t>(m_textureLayers.size())).first;
+                    m_textureLayers.push_back(name);
+                }
+                m_faceLayers[id][static_cast<size_t>(face)] = it->second;
+            }
+        }
+    }
+
+} // namespace VoxelCraft
@@ -11,6 +11,9 @@
 #include <memory>
 #include <vector>
 #include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
 
 namespace VoxelCraft {
 
@@ -30,7 +33,94 @@ namespace VoxelCraft {
 
         Vertex() = default;
         Vertex(float x, float y, float z, float u, float v, float nx, float ny, float nz, float r, float g, float b, float a)
-            : x(x), y(y), z(z), u(u), v(v), nx(nx), ny(nz), nz(nz), r(r), g(g), b(b), a(a) {}
+            : x(x), y(y), z(z), u(u), v(v), nx(nx), ny(ny), nz(nz), r(r), g(g), b(b), a(a) {}
+    };
+
+    /**
+     * @struct PackedVertex
+     * @brief 8-byte chunk vertex
+     *
+     * Layout:
+     * - data0: x (5) | y (9) | z (5) | face (3) | AO (2) | sky light (4) | block light (4)
+     * - data1: texture layer (16) | reserved (16)
+     *
+     * Positions are chunk-local corner coordinates (0-16, 0-256). Texture
+     * coordinates are derived in the shader from position and face, so
+     * merged quads tile their texture instead of stretching it.
+     */
+    struct PackedVertex {
+        uint32_t data0;
+        uint32_t data1;
+
+        static PackedVertex Pack(uint32_t x, uint32_t y, uint32_t z, uint32_t face, uint32_t ao,
+                                 uint32_t textureLayer, uint32_t skyLight, uint32_t blockLight) {
+            PackedVertex vertex;
+            vertex.data0 = (x & 0x1F) | ((y & 0x1FF) << 5) | ((z & 0x1F) << 14) | ((face & 0x7) << 19) |
+                           ((ao & 0x3) << 22) | ((skyLight & 0xF) << 24) | ((blockLight & 0xF) << 28);
+            vertex.data1 = textureLayer & 0xFFFF;
+            return vertex;
+        }
+
+        uint32_t GetX() const { return data0 & 0x1F; }
+        uint32_t GetY() const { return (data0 >> 5) & 0x1FF; }
+        uint32_t GetZ() const { return (data0 >> 14) & 0x1F; }
+        uint32_t GetFace() const { return (data0 >> 19) & 0x7; }
+        uint32_t GetAO() const { return (data0 >> 22) & 0x3; }
+        uint32_t GetSkyLight() const { return (data0 >> 24) & 0xF; }
+        uint32_t GetBlockLight() const { return (data0 >> 28) & 0xF; }
+        uint32_t GetTextureLayer() const { return data1 & 0xFFFF; }
+    };
+
+    static_assert(sizeof(PackedVertex) == 8, "PackedVertex must stay 8 bytes");
+
+    /**
+     * @enum MeshingMode
+     * @brief Face emission strategy for packed chunk meshes
+     */
+    enum class MeshingMode {
+        NAIVE,      ///< One quad per visible face
+        GREEDY      ///< Merge coplanar faces with equal texture, light and AO
+    };
+
+    /**
+     * @struct PackedChunkMesh
+     * @brief Packed chunk mesh, 4 vertices per quad
+     *
+     * Quads share one index pattern, so no per-mesh index buffer is stored;
+     * see BlockMeshGenerator::BuildQuadIndices.
+     */
+    struct PackedChunkMesh {
+        std::vector<PackedVertex> opaqueVertices;       ///< Opaque quads
+        std::vector<PackedVertex> transparentVertices;  ///< Transparent quads (glass, water, ...)
+
+        /// Face-to-face connectivity of each 16x16x16 section, bottom to top,
+        /// for cave culling (see SectionCulling::ComputeConnectivity)
+        std::array<uint16_t, 16> sectionConnectivity;
+
+        PackedChunkMesh() { sectionConnectivity.fill(0x7FFF); }
+
+        size_t GetQuadCount() const { return (opaqueVertices.size() + transparentVertices.size()) / 4; }
+        size_t GetVertexCount() const { return opaqueVertices.size() + transparentVertices.size(); }
+        size_t GetMemoryUsage() const { return GetVertexCount() * sizeof(PackedVertex); }
+
+        void Clear() {
+            opaqueVertices.clear();
+            transparentVertices.clear();
+            sectionConnectivity.fill(0x7FFF);   // Unknown: every face sees every other
+        }
+    };
+
+    /**
+     * @struct ChunkMeshNeighbors
+     * @brief Chunks around the one being meshed, for border culling and AO
+     *
+     * Indexed by (dx + 1) + 3 * (dz + 1); the center entry is ignored.
+     * Missing neighbors read as air with full sky light.
+     */
+    struct ChunkMeshNeighbors {
+        std::array<const Chunk*, 9> chunks{};
+
+        static size_t Index(int dx, int dz) { return static_cast<size_t>((dx + 1) + 3 * (dz + 1)); }
     };
 
     /**
@@ -80,9 +170,41 @@ namespace VoxelCraft {
         /**
          * @brief Generate mesh for a chunk
          * @param chunk Chunk to generate mesh for
-         * @return Generated mesh
+         * @param neighbors Surrounding chunks (optional)
+         * @return Generated mesh (one float quad per visible face)
+         */
+        BlockMesh GenerateChunkMesh(const Chunk* chunk, const ChunkMeshNeighbors& neighbors = ChunkMeshNeighbors());
+
+        /**
+         * @brief Generate packed mesh for a chunk
+         * @param chunk Chunk to generate mesh for
+         * @param mode Naive or greedy face emission
+         * @param neighbors Surrounding chunks (optional)
+         * @param mesh Output mesh, cleared first (reuse it to avoid reallocation)
+         */
+        void GenerateChunkMesh(const Chunk* chunk, MeshingMode mode, const ChunkMeshNeighbors& neighbors,
+                               PackedChunkMesh& mesh) const;
+
+        /**
+         * @brief Get atlas layer of a block face
+         * @param blockId Raw block ID
+         * @param face Face index (BlockFace order)
+         * @return Texture layer resolved at construction
+         */
+        uint16_t GetTextureLayer(uint16_t blockId, int face) const;
+
+        /**
+         * @brief Get texture names in atlas layer order
+         * @return Layer index -> texture name
+         */
+        const std::vector<std::string>& GetTextureLayers() const { return m_textureLayers; }
+
+        /**
+         * @brief Build index buffer for packed quads
+         * @param quadCount Number of quads
+         * @return Indices (two triangles per quad)
          */
-        BlockMesh GenerateChunkMesh(const Chunk* chunk);
+        static std::vector<uint32_t> BuildQuadIndices(size_t quadCount);
 
         /**
          * @brief Optimize mesh for rendering
@@ -126,12 +248,20 @@ namespace VoxelCraft {
          * @param x X position
          * @param y Y position
          * @param z Z position
-         * @param textureName Texture name
+         * @param textureLayer Atlas layer from GetTextureLayer
+         * @param light Light level (0-15)
+         */
+        void AddFaceToMesh(BlockMesh& mesh, int face, int x, int y, int z, uint16_t textureLayer, uint8_t light) const;
+
+        /**
+         * @brief Resolve every block face texture name to an atlas layer
          */
-        void AddFaceToMesh(BlockMesh& mesh, int face, int x, int y, int z, const std::string& textureName);
+        void BuildTextureLayers();
 
         bool m_initialized;                                    ///< Initialization flag
         std::unordered_map<uint32_t, BlockMesh> m_meshCache;  ///< Mesh cache
+        std::vector<std::array<uint16_t, 6>> m_faceLayers;    ///< Block ID -> per-face atlas layer
+        std::vector<std::string> m_textureLayers;              ///< Atlas layer -> texture name
     };
 
 } // namespace VoxelCraft
@@ -0,0 +1,38 @@
+/**
+ * @file BlockPropertyTable.cpp
+ * @brief VoxelCraft Block System - Block Property Table Implementation
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#include "BlockPropertyTable.hpp"
+
+#include <algorithm>
+
+namespace VoxelCraft {
+
+    BlockPropertyTable::BlockPropertyTable() {
+        for (size_t id = 0; id < TABLE_SIZE; ++id) {
+            auto block = Block::CreateBlock(static_cast<BlockType>(id));
+            Entry& entry = m_entries[id];
+
+            if (!block) {
+                continue;
+            }
+
+            const BlockProperties& props = block->GetProperties();
+            entry.isSolid = props.isSolid;
+            entry.isTransparent = props.isTransparent;
+            entry.isAir = static_cast<BlockType>(id) == BlockType::AIR;
+            entry.lightEmission = static_cast<uint8_t>(std::clamp(props.lightLevel, 0.0f, 15.0f));
+            entry.lightOpacity = static_cast<uint8_t>(std::clamp(props.lightOpacity, 0.0f, 15.0f));
+        }
+    }
+
+    const BlockPropertyTable& BlockPropertyTable::Instance() {
+        // Magic static: initialization is thread-safe and happens once
+        static const BlockPropertyTable s_table;
+        return s_table;
+    }
+
+} // namespace VoxelCraft
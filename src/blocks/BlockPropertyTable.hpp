@@ -0,0 +1,74 @@
+/**
+ * @file BlockPropertyTable.hpp
+ * @brief VoxelCraft Block System - Flat per-ID block property lookup
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * Hot loops (chunk storage, lighting, meshing) only need a handful of
+ * properties per block ID. Building a full Block through Block::CreateBlock
+ * for each voxel heap-allocates, so those properties are flattened once into
+ * a table indexed by the raw block ID.
+ */
+
+#ifndef VOXELCRAFT_BLOCKS_BLOCK_PROPERTY_TABLE_HPP
+#define VOXELCRAFT_BLOCKS_BLOCK_PROPERTY_TABLE_HPP
+
+#include <array>
+#include <cstdint>
+
+#include "Block.hpp"
+
+namespace VoxelCraft {
+
+    /**
+     * @class BlockPropertyTable
+     * @brief Static, read-only table of per-block-ID properties
+     *
+     * The table is built on first use from Block::CreateBlock, so it always
+     * agrees with the block definitions. After construction it is immutable
+     * and safe to read from any thread without locking.
+     */
+    class BlockPropertyTable {
+    public:
+        /**
+         * @struct Entry
+         * @brief Compact properties of one block ID
+         */
+        struct Entry {
+            bool isSolid = false;           ///< Blocks movement
+            bool isTransparent = true;      ///< Allows light through
+            bool isAir = true;              ///< Empty space
+            uint8_t lightEmission = 0;      ///< Light emitted (0-15)
+            uint8_t lightOpacity = 0;       ///< Light blocked (0-15)
+        };
+
+        static constexpr size_t TABLE_SIZE = static_cast<size_t>(BlockType::BLOCK_TYPE_COUNT);
+
+        /**
+         * @brief Get properties for a block ID
+         * @param id Raw block ID
+         * @return Entry; IDs outside the table read as air
+         */
+        static const Entry& Get(uint16_t id) {
+            const auto& table = Instance();
+            return id < TABLE_SIZE ? table.m_entries[id] : table.m_airEntry;
+        }
+
+        static bool IsSolid(uint16_t id) { return Get(id).isSolid; }
+        static bool IsTransparent(uint16_t id) { return Get(id).isTransparent; }
+        static bool IsAir(uint16_t id) { return Get(id).isAir; }
+        static uint8_t GetLightEmission(uint16_t id) { return Get(id).lightEmission; }
+        static uint8_t GetLightOpacity(uint16_t id) { return Get(id).lightOpacity; }
+
+    private:
+        BlockPropertyTable();
+
+        static const BlockPropertyTable& Instance();
+
+        std::array<Entry, TABLE_SIZE> m_entries;
+        Entry m_airEntry;
+    };
+
+} // namespace VoxelCraft
+
+#endif // VOXELCRAFT_BLOCKS_BLOCK_PROPERTY_TABLE_HPP
@@ -264,9 +264,6 @@ namespace VoxelCraft {
     TextureAtlas::TextureAtlas() = default;
     TextureAtlas::~TextureAtlas() = default;
 
-    BlockMeshGenerator::BlockMeshGenerator() = default;
-    BlockMeshGenerator::~BlockMeshGenerator() = default;
-
     BlockBehaviorManager::BlockBehaviorManager() = default;
     BlockBehaviorManager::~BlockBehaviorManager() = default;
 
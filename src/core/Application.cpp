@@ -13,10 +13,12 @@
 #include "Logger.hpp"
 #include "Config.hpp"
 #include "EventSystem.hpp"
+#include "Profiler.hpp"
 #include "../window/Window.hpp"
 #include "../graphics/Renderer.hpp"
 #include "../input/InputManager.hpp"
 #include "../world/World.hpp"
+#include "../world/SectionCulling.hpp"
 #include "../player/Player.hpp"
 #include "../ui/UIManager.hpp"
 #include "../audio/AudioManager.hpp"
@@ -572,14 +574,29 @@ namespace VoxelCraft {
     }
 
     void Application::ProcessFrame(double deltaTime) {
+        VOXELCRAFT_PROFILE_ZONE("Application::ProcessFrame");
+
         // Handle events
-        HandleEvents();
+        {
+            VOXELCRAFT_PROFILE_ZONE("Application::HandleEvents");
+            HandleEvents();
+        }
 
         // Update game logic
-        Update(deltaTime);
+        {
+            VOXELCRAFT_PROFILE_ZONE("Application::Update");
+            Update(deltaTime);
+        }
 
         // Render frame
-        Render();
+        {
+            VOXELCRAFT_PROFILE_ZONE("Application::Render");
+            Render();
+        }
+
+        if (m_profiler) {
+            m_profiler->Update(deltaTime);
+        }
 
         // Update game state based on current state
         switch (m_gameState) {
@@ -693,7 +710,23 @@ namespace VoxelCraft {
         // Render world with camera position
         if (m_world && m_camera) {
             Vec3 cameraPos = m_camera->GetPosition();
-            m_world->Render(cameraPos);
+            const Vec3 forward = m_camera->GetForward();
+            const Vec3 up = m_camera->GetUp();
+            const float position[3] = { cameraPos.x, cameraPos.y, cameraPos.z };
+            const float direction[3] = { forward.x, forward.y, forward.z };
+            const float upDirection[3] = { up.x, up.y, up.z };
+            const float aspect = m_window ? m_window->GetAspectRatio() : 16.0f / 9.0f;
+
+            // Camera has no projection settings yet: 70 degree vertical FOV
+            const ViewFrustum frustum = ViewFrustum::FromCamera(position, direction, upDirection,
+                                                                1.2217305f, aspect, 0.1f, 1000.0f);
+            m_world->Render(cameraPos, frustum);
+
+            if (m_renderer) {
+                const WorldStats& worldStats = m_world->GetStats();
+                m_renderer->RecordCulling(static_cast<uint32_t>(worldStats.cullingTests),
+                                          static_cast<uint32_t>(worldStats.cullingPassed), 0, 0);
+            }
         } else if (m_world) {
             // Default camera position if no camera
             Vec3 defaultPos(0, 2, 5);
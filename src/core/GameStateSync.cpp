@@ -26,6 +26,9 @@ GameStateSync::GameStateSync()
     , m_isServer(false)
 {
     std::memset(&m_metrics, 0, sizeof(SyncMetrics));
+    m_currentSnapshot.timestamp = 0;
+    m_currentSnapshot.sequenceNumber = 0;
+    m_currentSnapshot.baselineSequence = 0;
 }
 
 GameStateSync::~GameStateSync() {
@@ -75,6 +78,12 @@ void GameStateSync::Shutdown() {
 
     m_predictionHistory.clear();
 
+    {
+        std::lock_guard<std::mutex> lock(m_snapshotMutex);
+        m_baselineTracker.Clear();
+        m_baselineStore.Clear();
+    }
+
     m_initialized = false;
     VOXELCRAFT_INFO("Game State Sync shutdown complete");
 }
@@ -117,6 +126,7 @@ void GameStateSync::CreateSnapshot(World* world, const std::vector<Player*>& pla
     GameStateSnapshot snapshot;
     snapshot.timestamp = GetCurrentTimestamp();
     snapshot.sequenceNumber = m_currentSnapshot.sequenceNumber + 1;
+    snapshot.baselineSequence = 0;
 
     // Serialize world state
     if (world) {
@@ -143,15 +153,10 @@ void GameStateSync::CreateSnapshot(World* world, const std::vector<Player*>& pla
         }
     }
 
-    // Apply compression if enabled
-    if (m_compressionEnabled) {
-        if (m_deltaCompressionEnabled && m_currentSnapshot.timestamp > 0) {
-            snapshot.worldData = CreateDeltaCompressedData(snapshot.worldData, m_currentSnapshot.worldData);
-            snapshot.playerData = CreateDeltaCompressedData(snapshot.playerData, m_currentSnapshot.playerData);
-        } else {
-            snapshot.worldData = CompressData(snapshot.worldData);
-            snapshot.playerData = CompressData(snapshot.playerData);
-        }
+    // Snapshots are kept raw; each client gets its own delta when sent
+    {
+        std::lock_guard<std::mutex> lock(m_snapshotMutex);
+        m_baselineTracker.PushSnapshot(snapshot.sequenceNumber, SerializeSnapshot(snapshot));
     }
 
     // Update current snapshot
@@ -167,18 +172,23 @@ void GameStateSync::SendSnapshotToPlayer(uint32_t playerId) {
         return;
     }
 
-    auto serializedSnapshot = SerializeSnapshot(m_currentSnapshot);
-
     NetworkPacket packet;
     packet.packetId = 0;
-    packet.type = PacketType::WORLD_TIME; // Using existing packet type, would need custom type
+    packet.type = PacketType::GAME_STATE_SNAPSHOT;
     packet.senderId = 0;
-    packet.sequenceNumber = m_currentSnapshot.sequenceNumber;
-    packet.data = serializedSnapshot;
+    packet.sequenceNumber = static_cast<uint32_t>(m_currentSnapshot.sequenceNumber);
+    packet.data = CreateSnapshotPacketData(playerId);
     packet.reliable = false;
 
+    if (packet.data.empty()) {
+        return;
+    }
+
     m_networkManager->SendPacket(playerId, packet);
+
+    std::lock_guard<std::mutex> lock(m_metricsMutex);
     m_metrics.totalSnapshotsSent++;
+    m_metrics.bytesSent += packet.data.size();
 }
 
 void GameStateSync::BroadcastSnapshot() {
@@ -186,18 +196,38 @@ void GameStateSync::BroadcastSnapshot() {
         return;
     }
 
-    auto serializedSnapshot = SerializeSnapshot(m_currentSnapshot);
+    std::vector<uint32_t> clients;
+    {
+        std::lock_guard<std::mutex> lock(m_snapshotMutex);
+        clients = m_baselineTracker.GetClients();
+    }
 
-    NetworkPacket packet;
-    packet.packetId = 0;
-    packet.type = PacketType::WORLD_TIME; // Using existing packet type
-    packet.senderId = 0;
-    packet.sequenceNumber = m_currentSnapshot.sequenceNumber;
-    packet.data = serializedSnapshot;
-    packet.reliable = false;
+    // Every client has its own baseline, so each gets its own packet
+    for (uint32_t playerId : clients) {
+        SendSnapshotToPlayer(playerId);
+    }
+}
 
-    m_networkManager->BroadcastPacket(packet);
-    m_metrics.totalSnapshotsSent++;
+void GameStateSync::RegisterClient(uint32_t playerId) {
+    std::lock_guard<std::mutex> lock(m_snapshotMutex);
+    m_baselineTracker.AddClient(playerId);
+}
+
+void GameStateSync::UnregisterClient(uint32_t playerId) {
+    std::lock_guard<std::mutex> lock(m_snapshotMutex);
+    m_baselineTracker.RemoveClient(playerId);
+}
+
+void GameStateSync::AcknowledgeSnapshot(uint32_t playerId, const std::vector<uint8_t>& ackData) {
+    if (ackData.size() < sizeof(uint64_t)) {
+        return;
+    }
+
+    uint64_t sequence;
+    std::memcpy(&sequence, ackData.data(), sizeof(uint64_t));
+
+    std::lock_guard<std::mutex> lock(m_snapshotMutex);
+    m_baselineTracker.Acknowledge(playerId, sequence);
 }
 
 void GameStateSync::ReceiveSnapshot(const std::vector<uint8_t>& snapshotData) {
@@ -205,24 +235,54 @@ void GameStateSync::ReceiveSnapshot(const std::vector<uint8_t>& snapshotData) {
         return;
     }
 
+    if (snapshotData.size() < sizeof(uint64_t) * 2) {
+        m_metrics.droppedPackets++;
+        return;
+    }
+
     try {
-        GameStateSnapshot snapshot = DeserializeSnapshot(snapshotData);
+        // Header: sequence, baseline sequence; the rest is the encoded snapshot
+        uint64_t sequence;
+        uint64_t baselineSequence;
+        std::memcpy(&sequence, snapshotData.data(), sizeof(uint64_t));
+        std::memcpy(&baselineSequence, snapshotData.data() + sizeof(uint64_t), sizeof(uint64_t));
 
-        // Decompress if needed
+        std::vector<uint8_t> payload(snapshotData.begin() + sizeof(uint64_t) * 2, snapshotData.end());
         if (m_compressionEnabled) {
-            if (m_deltaCompressionEnabled && !m_snapshotBuffer.empty()) {
-                const auto& baseSnapshot = m_snapshotBuffer.back();
-                snapshot.worldData = ApplyDeltaDecompression(snapshot.worldData, baseSnapshot.worldData);
-                snapshot.playerData = ApplyDeltaDecompression(snapshot.playerData, baseSnapshot.playerData);
-            } else {
-                snapshot.worldData = DecompressData(snapshot.worldData);
-                snapshot.playerData = DecompressData(snapshot.playerData);
+            payload = DecompressData(payload);
+        }
+
+        std::vector<uint8_t> serializedSnapshot;
+        bool decoded;
+        {
+            std::lock_guard<std::mutex> lock(m_snapshotMutex);
+            decoded = m_baselineStore.Decode(sequence, baselineSequence, payload.data(), payload.size(),
+                                             serializedSnapshot);
+        }
+
+        if (!decoded) {
+            // Baseline is gone (or the packet is bad); ask the server for a full snapshot
+            VOXELCRAFT_DEBUG("Snapshot {} references unknown baseline {}", sequence, baselineSequence);
+            {
+                std::lock_guard<std::mutex> lock(m_metricsMutex);
+                m_metrics.baselineMisses++;
+                m_metrics.droppedPackets++;
             }
+            SendSnapshotAck(0);
+            return;
         }
 
+        SendSnapshotAck(sequence);
+
+        GameStateSnapshot snapshot = DeserializeSnapshot(serializedSnapshot);
+        snapshot.baselineSequence = baselineSequence;
+
         // Add to snapshot buffer
         {
             std::lock_guard<std::mutex> lock(m_snapshotMutex);
+            if (!m_snapshotBuffer.empty() && snapshot.sequenceNumber < m_snapshotBuffer.back().sequenceNumber) {
+                m_metrics.outOfOrderPackets++;
+            }
             m_snapshotBuffer.push(snapshot);
             m_metrics.totalSnapshotsReceived++;
 
@@ -457,17 +517,64 @@ std::vector<uint8_t> GameStateSync::DecompressData(const std::vector<uint8_t>& d
     return data;
 }
 
-std::vector<uint8_t> GameStateSync::CreateDeltaCompressedData(const std::vector<uint8_t>& current,
-                                                            const std::vector<uint8_t>& previous) {
-    // Simple delta compression placeholder
-    // In a real implementation, this would compute differences
-    return current;
+std::vector<uint8_t> GameStateSync::CreateSnapshotPacketData(uint32_t playerId) {
+    std::vector<uint8_t> payload;
+    uint64_t sequence;
+    uint64_t baselineSequence;
+
+    {
+        std::lock_guard<std::mutex> lock(m_snapshotMutex);
+        sequence = m_baselineTracker.GetLatestSequence();
+        if (sequence == 0) {
+            return {};
+        }
+
+        // Clients are normally registered on connect; late ones start from a full snapshot
+        if (!m_baselineTracker.HasClient(playerId)) {
+            m_baselineTracker.AddClient(playerId);
+        }
+        if (!m_deltaCompressionEnabled) {
+            m_baselineTracker.Acknowledge(playerId, 0);
+        }
+
+        baselineSequence = m_baselineTracker.EncodeForClient(playerId, payload);
+
+        const auto& stats = m_baselineTracker.GetStats();
+        std::lock_guard<std::mutex> metricsLock(m_metricsMutex);
+        m_metrics.fullSnapshotsSent = stats.fullSnapshots;
+        m_metrics.deltaSnapshotsSent = stats.deltaSnapshots;
+        m_metrics.baselineMisses = stats.baselineMisses;
+        UpdateCompressionStats(stats.rawBytes, stats.encodedBytes);
+    }
+
+    if (m_compressionEnabled) {
+        payload = CompressData(payload);
+    }
+
+    std::vector<uint8_t> data(sizeof(uint64_t) * 2);
+    std::memcpy(data.data(), &sequence, sizeof(uint64_t));
+    std::memcpy(data.data() + sizeof(uint64_t), &baselineSequence, sizeof(uint64_t));
+    data.insert(data.end(), payload.begin(), payload.end());
+
+    return data;
 }
 
-std::vector<uint8_t> GameStateSync::ApplyDeltaDecompression(const std::vector<uint8_t>& delta,
-                                                          const std::vector<uint8_t>& base) {
-    // Simple delta decompression placeholder
-    return delta;
+void GameStateSync::SendSnapshotAck(uint64_t sequenceNumber) {
+    if (!m_networkManager) {
+        return;
+    }
+
+    NetworkPacket packet;
+    packet.packetId = 0;
+    packet.type = PacketType::GAME_STATE_ACK;
+    packet.senderId = 0;
+    packet.sequenceNumber = static_cast<uint32_t>(sequenceNumber);
+    packet.data.resize(sizeof(uint64_t));
+    std::memcpy(packet.data.data(), &sequenceNumber, sizeof(uint64_t));
+    packet.reliable = false;
+
+    // Clients only talk to the server
+    m_networkManager->BroadcastPacket(packet);
 }
 
 void GameStateSync::ReconcilePlayerState(uint32_t playerId, const PlayerState& serverState) {
@@ -564,8 +671,11 @@ void GameStateSync::CleanupOldSnapshots() {
 void GameStateSync::UpdateMetrics(const GameStateSnapshot& snapshot) {
     std::lock_guard<std::mutex> lock(m_metricsMutex);
 
-    m_metrics.totalSnapshotsSent++;
-    UpdateCompressionStats(1024, snapshot.worldData.size()); // Placeholder sizes
+    // Sends are counted per client in SendSnapshotToPlayer
+    if (m_previousSnapshot.timestamp > 0 && snapshot.timestamp >= m_previousSnapshot.timestamp) {
+        const double interval = static_cast<double>(snapshot.timestamp - m_previousSnapshot.timestamp) / 1000.0;
+        m_metrics.averageUpdateInterval = m_metrics.averageUpdateInterval * 0.9 + interval * 0.1;
+    }
 }
 
 void GameStateSync::CalculateLatency() {
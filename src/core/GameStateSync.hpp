@@ -18,6 +18,7 @@
 #include <functional>
 
 #include "../core/NetworkManager.hpp"
+#include "SnapshotDelta.hpp"
 
 namespace VoxelCraft {
 
@@ -29,6 +30,7 @@ struct Vec3;
 struct GameStateSnapshot {
     uint64_t timestamp;                    ///< Snapshot timestamp
     uint64_t sequenceNumber;               ///< Snapshot sequence number
+    uint64_t baselineSequence;             ///< Snapshot this one was delta encoded against (0 = full)
     std::vector<uint8_t> worldData;        ///< World state data
     std::vector<uint8_t> playerData;       ///< Player state data
     std::vector<uint8_t> entityData;       ///< Entity state data
@@ -63,6 +65,10 @@ struct SyncMetrics {
     uint32_t outOfOrderPackets;            ///< Number of out-of-order packets
     uint32_t droppedPackets;               ///< Number of dropped packets
     double compressionRatio;               ///< Data compression ratio
+    uint64_t fullSnapshotsSent;            ///< Snapshots sent without a baseline
+    uint64_t deltaSnapshotsSent;           ///< Snapshots sent as a delta
+    uint64_t baselineMisses;               ///< Snapshots whose baseline was lost (either side)
+    uint64_t bytesSent;                    ///< Snapshot payload bytes sent
 };
 
 class GameStateSync {
@@ -80,6 +86,9 @@ public:
     void SendSnapshotToPlayer(uint32_t playerId);
     void BroadcastSnapshot();
     void ProcessPlayerInput(uint32_t playerId, const std::vector<uint8_t>& inputData);
+    void RegisterClient(uint32_t playerId);
+    void UnregisterClient(uint32_t playerId);
+    void AcknowledgeSnapshot(uint32_t playerId, const std::vector<uint8_t>& ackData);
 
     // Client-side methods
     void ReceiveSnapshot(const std::vector<uint8_t>& snapshotData);
@@ -109,6 +118,10 @@ private:
     std::queue<GameStateSnapshot> m_snapshotBuffer;
     mutable std::mutex m_snapshotMutex;
 
+    // Delta baselines: per-client acks on the server, decoded snapshots on the client
+    SnapshotBaselineTracker m_baselineTracker;
+    SnapshotBaselineStore m_baselineStore;
+
     // Player state management
     std::unordered_map<uint32_t, PlayerState> m_playerStates;
     mutable std::mutex m_playerStatesMutex;
@@ -151,10 +164,8 @@ private:
     // Compression methods
     std::vector<uint8_t> CompressData(const std::vector<uint8_t>& data);
     std::vector<uint8_t> DecompressData(const std::vector<uint8_t>& data);
-    std::vector<uint8_t> CreateDeltaCompressedData(const std::vector<uint8_t>& current,
-                                                  const std::vector<uint8_t>& previous);
-    std::vector<uint8_t> ApplyDeltaDecompression(const std::vector<uint8_t>& delta,
-                                                const std::vector<uint8_t>& base);
+    std::vector<uint8_t> CreateSnapshotPacketData(uint32_t playerId);
+    void SendSnapshotAck(uint64_t sequenceNumber);
 
     // State reconciliation
     void ReconcilePlayerState(uint32_t playerId, const PlayerState& serverState);
@@ -8,15 +8,42 @@
 #include "NetworkManager.hpp"
 #include "Config.hpp"
 #include "Logger.hpp"
+#include "../network/ServerTransport.hpp"
+#include "../network/NetworkWorker.hpp"
 
 #include <algorithm>
 #include <chrono>
 #include <cstring>
+#include <fstream>
+#include <iterator>
 #include <sstream>
 #include <iomanip>
 
 namespace VoxelCraft {
 
+    namespace {
+
+        // packetId, type, flags, sequenceNumber, timestamp
+        constexpr size_t PACKET_HEADER_SIZE = 4 + 2 + 1 + 4 + 8;
+        constexpr uint8_t PACKET_FLAG_RELIABLE = 0x01;
+        constexpr uint8_t PACKET_FLAG_COMPRESSED = 0x02;     // Payload is a PacketCompression frame
+
+        void StoreLE(uint8_t* out, uint64_t value, size_t bytes) {
+            for (size_t i = 0; i < bytes; ++i) {
+                out[i] = static_cast<uint8_t>(value >> (i * 8));
+            }
+        }
+
+        uint64_t ReadLE(const uint8_t* in, size_t bytes) {
+            uint64_t value = 0;
+            for (size_t i = 0; i < bytes; ++i) {
+                value |= static_cast<uint64_t>(in[i]) << (i * 8);
+            }
+            return value;
+        }
+
+    } // namespace
+
     NetworkManager::NetworkManager()
         : m_mode(NetworkMode::OFFLINE)
         , m_state(NetworkState::DISCONNECTED)
@@ -27,6 +54,7 @@ namespace VoxelCraft {
         , m_running(false)
         , m_networkImpl(nullptr)
     {
+        m_compression.codec = PacketCodec::LZ4;
         // Initialize metrics
         std::memset(&m_metrics, 0, sizeof(NetworkMetrics));
     }
@@ -44,6 +72,29 @@ namespace VoxelCraft {
             m_maxPlayers = config.Get("network.max_players", 10);
             std::string networkMode = config.Get("network.mode", "offline");
 
+            // Compression offered to clients during HANDSHAKE
+            std::string codec = config.Get<std::string>("network.compression_codec", "lz4");
+            m_compression.codec = codec == "zstd" ? PacketCodec::ZSTD
+                : codec == "deflate" ? PacketCodec::DEFLATE
+                : codec == "none" ? PacketCodec::NONE
+                : PacketCodec::LZ4;
+            m_compression.level = config.Get("network.compression_level", 0);
+            m_compression.threshold = static_cast<uint32_t>(
+                std::max(config.Get("network.compression_threshold", 256), 0));
+
+            // Pretrained chunk dictionary, shipped with the server and sent to clients that lack it
+            std::string dictionaryPath = config.Get<std::string>("network.compression_dictionary", "");
+            if (!dictionaryPath.empty()) {
+                std::ifstream file(dictionaryPath, std::ios::binary);
+                std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+                if (!bytes.empty() && bytes.size() <= PacketDictionary::MAX_SIZE) {
+                    m_compression.dictionaryId = PacketCompression::RegisterDictionary(
+                        std::make_shared<const PacketDictionary>(std::move(bytes)));
+                } else {
+                    VOXELCRAFT_WARNING("Ignoring compression dictionary " + dictionaryPath);
+                }
+            }
+
             // Set network mode
             if (networkMode == "client") {
                 m_mode = NetworkMode::CLIENT;
@@ -107,17 +158,26 @@ namespace VoxelCraft {
     }
 
     void NetworkManager::ProcessEvents() {
-        std::lock_guard<std::mutex> lock(m_packetsMutex);
+        // Take the whole batch so the transport thread is never blocked behind packet handlers
+        std::queue<NetworkPacket> incoming;
+        {
+            std::lock_guard<std::mutex> lock(m_packetsMutex);
+            incoming.swap(m_incomingPackets);
+        }
 
         // Process incoming packets
-        while (!m_incomingPackets.empty()) {
-            NetworkPacket packet = m_incomingPackets.front();
-            m_incomingPackets.pop();
+        while (!incoming.empty()) {
+            NetworkPacket packet = std::move(incoming.front());
+            incoming.pop();
 
             // Handle packet based on type
             switch (packet.type) {
                 case PacketType::HANDSHAKE:
-                    HandlePlayerConnected(packet.senderId);
+                    if (m_mode == NetworkMode::CLIENT) {
+                        HandleServerHandshake(packet);
+                    } else {
+                        HandlePlayerConnected(packet.senderId);
+                    }
                     break;
                 case PacketType::LOGOUT:
                     HandlePlayerDisconnected(packet.senderId);
@@ -135,6 +195,7 @@ namespace VoxelCraft {
         }
 
         // Process outgoing packets
+        std::lock_guard<std::mutex> lock(m_packetsMutex);
         while (!m_outgoingPackets.empty()) {
             NetworkPacket packet = m_outgoingPackets.front();
             m_outgoingPackets.pop();
@@ -164,6 +225,12 @@ namespace VoxelCraft {
         m_serverAddress = address;
         m_state = NetworkState::CONNECTING;
 
+        // First packet out: tells the server which codecs and dictionaries we can decompress
+        {
+            std::lock_guard<std::mutex> lock(m_packetsMutex);
+            m_outgoingPackets.push(CreateHandshakePacket());
+        }
+
         // Start network thread
         m_running = true;
         m_networkThread = std::make_unique<std::thread>(&NetworkManager::NetworkThread, this);
@@ -186,11 +253,61 @@ namespace VoxelCraft {
 
         m_serverPort = port;
         m_maxPlayers = maxPlayers;
-        m_state = NetworkState::CONNECTED;
 
-        // Start network thread
+        // One reactor thread serves every connection; no polling loop in server mode
+        ServerTransportConfig transportConfig;
+        transportConfig.port = port;
+        transportConfig.maxConnections = maxPlayers;
+
+        m_transport = std::make_unique<ServerTransport>();
+        m_transport->SetConnectCallback([this](uint32_t connectionId, const std::string&) {
+            {
+                // Uncompressed until the client's HANDSHAKE says what it supports
+                std::lock_guard<std::mutex> lock(m_compressionMutex);
+                m_connectionCompression[connectionId] = PacketCompressionSettings();
+            }
+
+            NetworkPacket packet{};
+            packet.type = PacketType::HANDSHAKE;
+            packet.senderId = connectionId;
+            QueueIncomingPacket(std::move(packet));
+        });
+        m_transport->SetDisconnectCallback([this](uint32_t connectionId) {
+            {
+                std::lock_guard<std::mutex> lock(m_compressionMutex);
+                m_connectionCompression.erase(connectionId);
+            }
+
+            NetworkPacket packet{};
+            packet.type = PacketType::LOGOUT;
+            packet.senderId = connectionId;
+            QueueIncomingPacket(std::move(packet));
+        });
+        m_transport->SetFrameCallback([this](uint32_t connectionId, const uint8_t* data, size_t size) {
+            // The client HANDSHAKE carries its compression offer and is answered right here
+            if (HandleCompressionHandshake(connectionId, data, size)) {
+                return;
+            }
+
+            NetworkPacket packet;
+            if (DecodePacket(connectionId, data, size, packet)) {
+                QueueIncomingPacket(std::move(packet));
+            } else {
+                VOXELCRAFT_WARNING("Dropping malformed packet from connection " + std::to_string(connectionId));
+            }
+        });
+
+        if (!m_transport->Start(transportConfig)) {
+            VOXELCRAFT_ERROR("Failed to start server transport");
+            m_transport.reset();
+            return false;
+        }
+
+        m_worker = std::make_unique<NetworkWorker>();
+        m_worker->Start();
+
+        m_state = NetworkState::CONNECTED;
         m_running = true;
-        m_networkThread = std::make_unique<std::thread>(&NetworkManager::NetworkThread, this);
 
         return true;
     }
@@ -205,6 +322,19 @@ namespace VoxelCraft {
         if (m_networkThread && m_networkThread->joinable()) {
             m_networkThread->join();
         }
+        if (m_worker) {
+            // Drains queued sends while the transport is still up
+            m_worker->Stop();
+            m_worker.reset();
+        }
+        if (m_transport) {
+            m_transport->Stop();
+            m_transport.reset();
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_compressionMutex);
+            m_connectionCompression.clear();
+        }
 
         // Disconnect all players
         std::lock_guard<std::mutex> lock(m_playersMutex);
@@ -228,6 +358,27 @@ namespace VoxelCraft {
         NetworkPacket sendPacket = packet;
         sendPacket.packetId = m_nextPacketId++;
 
+        // Server modes write straight into the connection's send queue
+        if (m_transport) {
+            const PacketCompressionSettings compression = GetConnectionCompression(playerId);
+            const bool compress = compression.IsEnabled() && sendPacket.data.size() >= compression.threshold;
+
+            // Large payloads are compressed on the network worker. While it has work queued
+            // everything goes through it, so packets never overtake each other (posts happen
+            // under m_packetsMutex, so the idle check cannot race with another post).
+            if (compress || !m_worker->IsIdle()) {
+                m_worker->Post([this, playerId, compression, sendPacket]() {
+                    PacketBuffer frame = EncodePacket(sendPacket, compression);
+                    std::lock_guard<std::mutex> workerLock(m_packetsMutex);
+                    SendFrame(playerId, frame);
+                });
+                return true;
+            }
+
+            // Client is not keeping up (or gone) on failure; the caller decides whether to resend
+            return SendFrame(playerId, EncodePacket(sendPacket));
+        }
+
         m_outgoingPackets.push(sendPacket);
         return true;
     }
@@ -243,6 +394,55 @@ namespace VoxelCraft {
         NetworkPacket broadcastPacket = packet;
         broadcastPacket.packetId = m_nextPacketId++;
 
+        // Encoded once; every connection's send queue references the same buffer
+        if (m_transport) {
+            std::vector<std::pair<uint32_t, PacketCompressionSettings>> connections;
+            bool compress = false;
+            {
+                std::lock_guard<std::mutex> lock(m_compressionMutex);
+                connections.assign(m_connectionCompression.begin(), m_connectionCompression.end());
+            }
+            for (const auto& connection : connections) {
+                compress = compress || (connection.second.IsEnabled() && broadcastPacket.data.size() >= connection.second.threshold);
+            }
+
+            // Compressed once per distinct negotiated settings, on the network worker
+            if (compress || !m_worker->IsIdle()) {
+                m_worker->Post([this, connections = std::move(connections), broadcastPacket]() {
+                    std::vector<std::pair<PacketCompressionSettings, PacketBuffer>> frames;
+                    std::vector<std::pair<uint32_t, const PacketBuffer*>> sends;
+                    frames.reserve(connections.size());     // sends points into frames
+                    sends.reserve(connections.size());
+
+                    for (const auto& connection : connections) {
+                        const PacketCompressionSettings& settings = connection.second;
+                        auto it = std::find_if(frames.begin(), frames.end(), [&settings](const auto& frame) {
+                            return frame.first.codec == settings.codec && frame.first.level == settings.level
+                                && frame.first.threshold == settings.threshold && frame.first.dictionaryId == settings.dictionaryId;
+                        });
+                        if (it == frames.end()) {
+                            frames.emplace_back(settings, EncodePacket(broadcastPacket, settings));
+                            it = frames.end() - 1;
+                        }
+                        sends.emplace_back(connection.first, &it->second);
+                    }
+
+                    std::lock_guard<std::mutex> workerLock(m_packetsMutex);
+                    for (const auto& send : sends) {
+                        SendFrame(send.first, *send.second);
+                    }
+                });
+                return true;
+            }
+
+            PacketBuffer frame = EncodePacket(broadcastPacket);
+            size_t queued = m_transport->Broadcast(frame);
+            m_metrics.packetsSent += queued;
+            m_metrics.bytesSent += queued * frame.Size();
+            m_metrics.packetsLost += m_players.size() > queued ? m_players.size() - queued : 0;
+            return true;
+        }
+
         // Send to all connected players
         for (const auto& pair : m_players) {
             if (pair.second.state == NetworkState::CONNECTED) {
@@ -280,6 +480,10 @@ namespace VoxelCraft {
 
         VOXELCRAFT_INFO("Kicking player {} ({}) - Reason: {}", playerId, player->playerName, reason);
 
+        if (m_transport) {
+            m_transport->Disconnect(playerId);
+        }
+
         std::lock_guard<std::mutex> lock(m_playersMutex);
         m_players.erase(playerId);
 
@@ -372,7 +576,7 @@ namespace VoxelCraft {
         PlayerConnection connection;
         connection.playerId = playerId;
         connection.playerName = "Player_" + std::to_string(playerId);
-        connection.address = "127.0.0.1"; // Placeholder
+        connection.address = m_transport ? m_transport->GetAddress(playerId) : "127.0.0.1";
         connection.state = NetworkState::CONNECTED;
         connection.lastActivity = std::chrono::steady_clock::now();
         connection.ping = 0;
@@ -455,6 +659,145 @@ namespace VoxelCraft {
         }
     }
 
+    void NetworkManager::QueueIncomingPacket(NetworkPacket&& packet) {
+        std::lock_guard<std::mutex> lock(m_packetsMutex);
+        m_incomingPackets.push(std::move(packet));
+    }
+
+    void NetworkManager::SetCompression(const PacketCompressionSettings& settings) {
+        std::lock_guard<std::mutex> lock(m_compressionMutex);
+        m_compression = settings;
+    }
+
+    PacketCompressionSettings NetworkManager::GetCompression() const {
+        std::lock_guard<std::mutex> lock(m_compressionMutex);
+        return m_compression;
+    }
+
+    PacketCompressionSettings NetworkManager::GetConnectionCompression(uint32_t playerId) const {
+        std::lock_guard<std::mutex> lock(m_compressionMutex);
+        auto it = m_connectionCompression.find(playerId);
+        return it != m_connectionCompression.end() ? it->second : PacketCompressionSettings();
+    }
+
+    bool NetworkManager::SendFrame(uint32_t playerId, const PacketBuffer& frame) {
+        if (m_transport->Send(playerId, frame) != ServerTransport::SendResult::QUEUED) {
+            m_metrics.packetsLost++;
+            return false;
+        }
+        m_metrics.packetsSent++;
+        m_metrics.bytesSent += frame.Size();
+        return true;
+    }
+
+    bool NetworkManager::HandleCompressionHandshake(uint32_t connectionId, const uint8_t* data, size_t size) {
+        if (size < PACKET_HEADER_SIZE || static_cast<PacketType>(ReadLE(data + 4, 2)) != PacketType::HANDSHAKE) {
+            return false;
+        }
+
+        PacketReader reader(std::span<const uint8_t>(data + PACKET_HEADER_SIZE, size - PACKET_HEADER_SIZE));
+        PacketCompressionOffer offer;
+        if (!PacketCompression::ReadOffer(reader, offer)) {
+            return false;
+        }
+
+        PacketCompressionSettings settings = PacketCompression::Negotiate(offer, GetCompression());
+
+        PacketBuffer reply = PacketBuffer::Allocate(64);
+        const bool sendDictionary = settings.dictionaryId != 0 && !offer.HasDictionary(settings.dictionaryId);
+        PacketCompression::WriteSettings(settings, sendDictionary, reply);
+
+        NetworkPacket packet{};
+        packet.type = PacketType::HANDSHAKE;
+        packet.senderId = connectionId;         // Tells the client its id
+        packet.timestamp = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        packet.reliable = true;
+        packet.data.assign(reply.Data(), reply.Data() + reply.Size());
+
+        // Reply queued before the settings take effect, so it arrives ahead of any compressed packet
+        if (m_transport->Send(connectionId, EncodePacket(packet)) != ServerTransport::SendResult::QUEUED) {
+            return true;
+        }
+
+        std::lock_guard<std::mutex> lock(m_compressionMutex);
+        auto it = m_connectionCompression.find(connectionId);
+        if (it != m_connectionCompression.end()) {
+            it->second = settings;
+        }
+        return true;
+    }
+
+    void NetworkManager::HandleServerHandshake(const NetworkPacket& packet) {
+        PacketReader reader(std::span<const uint8_t>(packet.data.data(), packet.data.size()));
+        PacketCompressionSettings settings;
+        if (!PacketCompression::ReadSettings(reader, settings)) {
+            VOXELCRAFT_ERROR("Server requested a compression codec or dictionary this client does not have");
+            return;
+        }
+
+        m_localPlayerId = packet.senderId;
+        m_state = NetworkState::CONNECTED;
+        VOXELCRAFT_INFO("Server compression: " + std::string(PacketCompression::GetName(settings.codec))
+            + (settings.dictionaryId != 0 ? " with dictionary" : ""));
+    }
+
+    PacketBuffer NetworkManager::EncodePacket(const NetworkPacket& packet, const PacketCompressionSettings& compression) {
+        const uint8_t reliable = packet.reliable ? PACKET_FLAG_RELIABLE : 0;
+        auto writeHeader = [&packet](uint8_t* header, uint8_t flags) {
+            StoreLE(header, packet.packetId, 4);
+            StoreLE(header + 4, static_cast<uint16_t>(packet.type), 2);
+            StoreLE(header + 6, flags, 1);
+            StoreLE(header + 7, packet.sequenceNumber, 4);
+            StoreLE(header + 11, packet.timestamp, 8);
+        };
+
+        // The pretrained dictionary models chunk payloads; other packets use the codec alone
+        PacketCompressionSettings settings = compression;
+        if (packet.type != PacketType::CHUNK_DATA) {
+            settings.dictionaryId = 0;
+        }
+
+        // Compressed frames get their header in the buffer's reserved zone, without moving the data
+        PacketBuffer frame;
+        if (PacketCompression::Compress(settings, std::span<const uint8_t>(packet.data.data(), packet.data.size()), frame)) {
+            writeHeader(frame.Prepend(PACKET_HEADER_SIZE), reliable | PACKET_FLAG_COMPRESSED);
+            return frame;
+        }
+
+        frame = PacketBuffer::Allocate(PACKET_HEADER_SIZE + packet.data.size());
+        writeHeader(frame.Append(PACKET_HEADER_SIZE), reliable);
+        frame.Append(packet.data.data(), packet.data.size());
+        return frame;
+    }
+
+    bool NetworkManager::DecodePacket(uint32_t senderId, const uint8_t* data, size_t size, NetworkPacket& packet) {
+        if (size < PACKET_HEADER_SIZE) {
+            return false;
+        }
+
+        packet.packetId = static_cast<uint32_t>(ReadLE(data, 4));
+        packet.type = static_cast<PacketType>(ReadLE(data + 4, 2));
+        packet.reliable = (data[6] & PACKET_FLAG_RELIABLE) != 0;
+        packet.sequenceNumber = static_cast<uint32_t>(ReadLE(data + 7, 4));
+        packet.timestamp = ReadLE(data + 11, 8);
+        packet.senderId = senderId;     // Never trust the id a client claims
+
+        std::span<const uint8_t> payload(data + PACKET_HEADER_SIZE, size - PACKET_HEADER_SIZE);
+        if (data[6] & PACKET_FLAG_COMPRESSED) {
+            PacketBuffer decompressed;
+            if (!PacketCompression::Decompress(payload, decompressed)) {
+                return false;
+            }
+            packet.data.assign(decompressed.Data(), decompressed.Data() + decompressed.Size());
+        } else {
+            packet.data.assign(payload.begin(), payload.end());
+        }
+
+        // Connection events are raised by the transport, not by clients
+        return packet.type != PacketType::HANDSHAKE && packet.type != PacketType::LOGOUT;
+    }
+
     // Static helper methods
 
     std::vector<uint8_t> NetworkManager::SerializeVec3(const Vec3& vec) {
@@ -505,4 +848,22 @@ namespace VoxelCraft {
         return packet;
     }
 
+    NetworkPacket NetworkManager::CreateHandshakePacket() {
+        PacketBuffer offer = PacketBuffer::Allocate(64);
+        PacketCompression::WriteOffer(offer);
+
+        NetworkPacket packet;
+        packet.packetId = 0; // Will be set by sender
+        packet.type = PacketType::HANDSHAKE;
+        packet.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()
+        ).count();
+        packet.senderId = 0; // Assigned by the server
+        packet.sequenceNumber = 0;
+        packet.data.assign(offer.Data(), offer.Data() + offer.Size());
+        packet.reliable = true;
+
+        return packet;
+    }
+
 } // namespace VoxelCraft
@@ -19,10 +19,14 @@
 #include <functional>
 #include <chrono>
 
+#include "../network/PacketCompression.hpp"
+
 namespace VoxelCraft {
 
 // Forward declarations
 class Config;
+class ServerTransport;
+class NetworkWorker;
 struct Vec3;
 
 /**
@@ -79,6 +83,10 @@ enum class PacketType {
     // Chat packets
     CHAT_MESSAGE,
 
+    // Game state sync packets
+    GAME_STATE_SNAPSHOT,
+    GAME_STATE_ACK,
+
     // Custom packets
     CUSTOM_START = 1000
 };
@@ -236,6 +244,31 @@ public:
      */
     bool BroadcastPacket(const NetworkPacket& packet);
 
+    /**
+     * @brief Set the compression offered to clients during HANDSHAKE
+     *
+     * Payloads of at least settings.threshold bytes are compressed on the
+     * network worker for clients that support the codec. The dictionary
+     * (if any) must be registered with PacketCompression and is only used
+     * for CHUNK_DATA; clients that lack it receive it in the HANDSHAKE reply.
+     * Applies to connections that handshake afterwards.
+     * @param settings Preferred codec, level, size threshold and dictionary
+     */
+    void SetCompression(const PacketCompressionSettings& settings);
+
+    /**
+     * @brief Get the compression offered to clients
+     * @return Preferred compression settings
+     */
+    PacketCompressionSettings GetCompression() const;
+
+    /**
+     * @brief Get the compression negotiated with a connection
+     * @param playerId Player ID
+     * @return Negotiated settings (codec NONE before the HANDSHAKE)
+     */
+    PacketCompressionSettings GetConnectionCompression(uint32_t playerId) const;
+
     /**
      * @brief Get player connection info
      * @param playerId Player ID
@@ -338,6 +371,12 @@ public:
      */
     static NetworkPacket CreateChatMessagePacket(uint32_t playerId, const std::string& message);
 
+    /**
+     * @brief Create the client HANDSHAKE packet
+     * @return Network packet carrying the client's compression offer
+     */
+    static NetworkPacket CreateHandshakePacket();
+
 private:
     // Network configuration
     NetworkMode m_mode;                    ///< Current network mode
@@ -358,13 +397,20 @@ private:
     uint32_t m_nextPacketId;              ///< Next packet ID counter
 
     // Threading
-    std::unique_ptr<std::thread> m_networkThread; ///< Network processing thread
+    std::unique_ptr<std::thread> m_networkThread; ///< Network processing thread (client mode)
+    std::unique_ptr<ServerTransport> m_transport; ///< epoll reactor serving every connection (server modes)
+    std::unique_ptr<NetworkWorker> m_worker;      ///< Compresses and sends large packets off the game thread (server modes)
     std::atomic<bool> m_running;          ///< Network thread running flag
 
     // Metrics
     NetworkMetrics m_metrics;             ///< Performance metrics
     mutable std::mutex m_metricsMutex;    ///< Metrics synchronization
 
+    // Compression
+    PacketCompressionSettings m_compression;      ///< Offered to clients during HANDSHAKE
+    std::unordered_map<uint32_t, PacketCompressionSettings> m_connectionCompression; ///< Negotiated per connection
+    mutable std::mutex m_compressionMutex;        ///< Compression synchronization
+
     // Security
     std::vector<std::string> m_bannedAddresses; ///< Banned IP addresses
     mutable std::mutex m_banListMutex;    ///< Ban list synchronization
@@ -431,6 +477,55 @@ private:
      */
     void UpdateMetrics();
 
+    /**
+     * @brief Encode a packet as a transport frame payload
+     * @param packet Packet to encode
+     * @param compression Compression negotiated with the recipient(s)
+     * @return Pooled frame payload (fixed header followed by packet data, compressed
+     *         when above the threshold), shareable across recipients
+     */
+    static PacketBuffer EncodePacket(const NetworkPacket& packet, const PacketCompressionSettings& compression = {});
+
+    /**
+     * @brief Queue an encoded frame on a connection and account for it
+     * @param playerId Target connection
+     * @param frame Encoded frame
+     * @return true if queued
+     * @note Caller holds m_packetsMutex
+     */
+    bool SendFrame(uint32_t playerId, const PacketBuffer& frame);
+
+    /**
+     * @brief Answer a client HANDSHAKE with the negotiated compression (reactor thread)
+     * @param connectionId Connection the frame arrived on
+     * @param data Frame payload
+     * @param size Payload size
+     * @return true if the frame was a well-formed HANDSHAKE and was answered
+     */
+    bool HandleCompressionHandshake(uint32_t connectionId, const uint8_t* data, size_t size);
+
+    /**
+     * @brief Apply the server's HANDSHAKE reply (client mode)
+     * @param packet HANDSHAKE packet from the server
+     */
+    void HandleServerHandshake(const NetworkPacket& packet);
+
+    /**
+     * @brief Decode a transport frame payload
+     * @param senderId Connection the frame arrived on
+     * @param data Frame payload
+     * @param size Payload size
+     * @param packet Decoded packet
+     * @return true if the payload is a well-formed packet
+     */
+    static bool DecodePacket(uint32_t senderId, const uint8_t* data, size_t size, NetworkPacket& packet);
+
+    /**
+     * @brief Hand a packet from the transport thread to ProcessEvents
+     * @param packet Packet to queue
+     */
+    void QueueIncomingPacket(NetworkPacket&& packet);
+
     /**
      * @brief Clean up disconnected players
      */
@@ -130,8 +130,8 @@ namespace VoxelCraft {
 
         // Optimization settings
         bool enableLOD = true;
-        bool enableFrustumCulling = true;
-        bool enableOcclusionCulling = false;
+        bool enableFrustumCulling = true;     // Applied per section by ChunkSystemConfig
+        bool enableOcclusionCulling = true;   // Cave culling, see SectionOcclusionCuller
         bool enableDistanceCulling = true;
         float cullingDistance = 1000.0f;
         int maxVisibleChunks = 1000;
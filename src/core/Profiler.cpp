@@ -8,11 +8,192 @@
 #include "Profiler.hpp"
 #include "Logger.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
 namespace VoxelCraft {
 
+struct Profiler::ThreadBuffer {
+    struct Slot {
+        std::atomic<uint64_t> start;
+        std::atomic<uint64_t> end;
+        std::atomic<uint32_t> zone;
+        std::atomic<uint32_t> depth;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    alignas(64) std::atomic<uint64_t> head{0};      ///< Next index; written only by the owner
+    std::atomic<uint64_t> clearedAt{0};             ///< Indices below this were cleared
+    std::atomic<bool> owned{true};                  ///< False once the thread has exited
+    uint32_t threadId = 0;
+    std::string name;                               ///< Guarded by the thread registry mutex
+};
+
+namespace {
+
+    using SteadyClock = std::chrono::steady_clock;
+
+    constexpr Profiler::ZoneID FRAME_ZONE = 0;
+    constexpr Profiler::ZoneID OVERFLOW_ZONE = 1;
+
+    struct ZoneRegistry {
+        std::array<Profiler::ZoneInfo, Profiler::MAX_ZONES> zones;
+        std::atomic<size_t> count{0};
+        std::mutex mutex;
+        std::deque<std::string> dynamicNames;
+        std::unordered_map<std::string, Profiler::ZoneID> dynamicZones;
+
+        ZoneRegistry() {
+            zones[FRAME_ZONE] = {"Frame", "", 0};
+            zones[OVERFLOW_ZONE] = {"(zone limit reached)", "", 0};
+            count.store(2, std::memory_order_release);
+        }
+    };
+
+    struct ThreadRegistry {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Profiler::ThreadBuffer>> buffers;
+        uint32_t nextThreadId = 1;
+    };
+
+    // Tick epoch for exports, taken the first time the profiler is touched
+    struct TickEpoch {
+        uint64_t ticks;
+        SteadyClock::time_point time;
+
+        TickEpoch() : ticks(Profiler::Now()), time(SteadyClock::now()) {}
+    };
+
+    struct EventCopy {
+        uint64_t start;
+        uint64_t end;
+        Profiler::ZoneID zone;
+        uint32_t depth;
+        uint32_t threadId;
+    };
+
+    ZoneRegistry& Zones() {
+        static ZoneRegistry registry;
+        return registry;
+    }
+
+    ThreadRegistry& Threads() {
+        static ThreadRegistry registry;
+        return registry;
+    }
+
+    const TickEpoch& Epoch() {
+        static TickEpoch epoch;
+        return epoch;
+    }
+
+    // Marks the thread's ring reusable when the thread exits
+    struct ThreadExitHook {
+        Profiler::ThreadBuffer* buffer = nullptr;
+
+        ~ThreadExitHook() {
+            if (buffer) {
+                t_profilerThread.buffer = nullptr;
+                buffer->owned.store(false, std::memory_order_release);
+            }
+        }
+    };
+
+    thread_local ThreadExitHook t_exitHook;
+
+    double TicksPerNanosecond() {
+#if defined(VOXELCRAFT_PROFILER_USE_TSC)
+        // Needs a few milliseconds between the two samples to be accurate
+        const TickEpoch& epoch = Epoch();
+        auto elapsed = SteadyClock::now() - epoch.time;
+        if (elapsed < std::chrono::milliseconds(20)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20) - elapsed);
+        }
+        const uint64_t ticks = Profiler::Now();
+        const double nanoseconds = std::chrono::duration<double, std::nano>(SteadyClock::now() - epoch.time).count();
+        return static_cast<double>(ticks - epoch.ticks) / nanoseconds;
+#else
+        return 1.0;
+#endif
+    }
+
+    // Copy every event still valid in the rings
+    std::vector<EventCopy> Snapshot(std::vector<std::pair<uint32_t, std::string>>* threadNames = nullptr) {
+        ThreadRegistry& registry = Threads();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        std::vector<EventCopy> events;
+        for (const auto& buffer : registry.buffers) {
+            if (threadNames) {
+                threadNames->emplace_back(buffer->threadId, buffer->name);
+            }
+
+            const uint64_t head = buffer->head.load(std::memory_order_acquire);
+            const uint64_t cleared = buffer->clearedAt.load(std::memory_order_relaxed);
+            uint64_t first = head > Profiler::EVENTS_PER_THREAD ? head - Profiler::EVENTS_PER_THREAD : 0;
+            first = std::max(first, cleared);
+
+            const size_t base = events.size();
+            for (uint64_t index = first; index < head; ++index) {
+                const auto& slot = buffer->slots[index & (Profiler::EVENTS_PER_THREAD - 1)];
+                events.push_back({slot.start.load(std::memory_order_relaxed),
+                                  slot.end.load(std::memory_order_relaxed),
+                                  slot.zone.load(std::memory_order_relaxed),
+                                  slot.depth.load(std::memory_order_relaxed),
+                                  buffer->threadId});
+            }
+
+            // Slots the owner may have started overwriting while we copied are dropped
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const uint64_t headAfter = buffer->head.load(std::memory_order_relaxed);
+            if (headAfter + 1 > first + Profiler::EVENTS_PER_THREAD) {
+                const uint64_t firstValid = headAfter + 1 - Profiler::EVENTS_PER_THREAD;
+                const size_t stale = static_cast<size_t>(std::min(head, firstValid) - first);
+                const auto from = events.begin() + static_cast<std::ptrdiff_t>(base);
+                events.erase(from, from + static_cast<std::ptrdiff_t>(stale));
+            }
+        }
+        return events;
+    }
+
+    void AppendJsonString(std::string& out, const char* text) {
+        out += '"';
+        for (const char* c = text; *c; ++c) {
+            switch (*c) {
+                case '"': out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '\n': out += "\\n"; break;
+                case '\t': out += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(*c) < 0x20) {
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(*c));
+                        out += escaped;
+                    } else {
+                        out += *c;
+                    }
+            }
+        }
+        out += '"';
+    }
+
+} // namespace
+
+std::atomic<bool> Profiler::s_capturing{true};
+
 Profiler::Profiler()
     : m_initialized(false)
+    , m_frame(0)
 {
+    Epoch();
 }
 
 Profiler::~Profiler() {
@@ -25,6 +206,8 @@ bool Profiler::Initialize() {
     }
 
     VOXELCRAFT_INFO("Initializing Profiler");
+    SetThreadName("Main");
+    SetCapturing(true);
     m_initialized = true;
 
     VOXELCRAFT_INFO("Profiler initialized successfully");
@@ -37,6 +220,7 @@ void Profiler::Shutdown() {
     }
 
     VOXELCRAFT_INFO("Shutting down Profiler");
+    SetCapturing(false);
     m_initialized = false;
     VOXELCRAFT_INFO("Profiler shutdown complete");
 }
@@ -46,7 +230,244 @@ void Profiler::Update(double deltaTime) {
         return;
     }
 
-    // Update profiling data here
+    m_frame++;
+    MarkFrame();
+}
+
+Profiler::ZoneID Profiler::RegisterZone(const char* name, const char* file, uint32_t line) {
+    Epoch();
+    ZoneRegistry& registry = Zones();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    const size_t id = registry.count.load(std::memory_order_relaxed);
+    if (id >= MAX_ZONES) {
+        return OVERFLOW_ZONE;
+    }
+
+    registry.zones[id] = {name, file, line};
+    registry.count.store(id + 1, std::memory_order_release);
+    return static_cast<ZoneID>(id);
+}
+
+Profiler::ZoneID Profiler::RegisterDynamicZone(const std::string& name) {
+    ZoneRegistry& registry = Zones();
+    const char* stored = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto it = registry.dynamicZones.find(name);
+        if (it != registry.dynamicZones.end()) {
+            return it->second;
+        }
+        // The deque never moves its strings, so the pointer stays valid
+        registry.dynamicNames.push_back(name);
+        stored = registry.dynamicNames.back().c_str();
+    }
+
+    const ZoneID zone = RegisterZone(stored, "", 0);
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    return registry.dynamicZones.emplace(name, zone).first->second;
+}
+
+const Profiler::ZoneInfo& Profiler::GetZoneInfo(ZoneID zone) {
+    return Zones().zones[zone];
+}
+
+size_t Profiler::GetZoneCount() {
+    return Zones().count.load(std::memory_order_acquire);
+}
+
+void Profiler::SetThreadName(const std::string& name) {
+    ThreadBuffer* buffer = t_profilerThread.buffer ? t_profilerThread.buffer : RegisterThread();
+    std::lock_guard<std::mutex> lock(Threads().mutex);
+    buffer->name = name;
+}
+
+void Profiler::MarkFrame() {
+    if (!IsCapturing()) {
+        return;
+    }
+
+    const uint64_t now = Now();
+    RecordZone(FRAME_ZONE, now, now, t_profilerThread.depth);
+}
+
+void Profiler::Clear() {
+    ThreadRegistry& registry = Threads();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (const auto& buffer : registry.buffers) {
+        buffer->clearedAt.store(buffer->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+void Profiler::RecordZone(ZoneID zone, uint64_t start, uint64_t end, uint32_t depth) {
+    ThreadBuffer* buffer = t_profilerThread.buffer;
+    if (!buffer) {
+        buffer = RegisterThread();
+    }
+
+    const uint64_t index = buffer->head.load(std::memory_order_relaxed);
+    ThreadBuffer::Slot& slot = buffer->slots[index & (EVENTS_PER_THREAD - 1)];
+
+    // Orders the previous head store before this overwrite (see Snapshot)
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.start.store(start, std::memory_order_relaxed);
+    slot.end.store(end, std::memory_order_relaxed);
+    slot.zone.store(zone, std::memory_order_relaxed);
+    slot.depth.store(depth, std::memory_order_relaxed);
+    buffer->head.store(index + 1, std::memory_order_release);
+}
+
+Profiler::ThreadBuffer* Profiler::RegisterThread() {
+    ThreadRegistry& registry = Threads();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    // Reuse the ring of a thread that has exited before allocating a new one
+    ThreadBuffer* buffer = nullptr;
+    for (const auto& candidate : registry.buffers) {
+        if (!candidate->owned.load(std::memory_order_acquire)) {
+            buffer = candidate.get();
+            buffer->owned.store(true, std::memory_order_relaxed);
+            break;
+        }
+    }
+
+    if (!buffer) {
+        auto created = std::make_unique<ThreadBuffer>();
+        created->slots = std::make_unique<ThreadBuffer::Slot[]>(EVENTS_PER_THREAD);
+        created->threadId = registry.nextThreadId++;
+        created->name = "Thread " + std::to_string(created->threadId);
+        buffer = created.get();
+        registry.buffers.push_back(std::move(created));
+    }
+
+    t_profilerThread.buffer = buffer;
+    t_exitHook.buffer = buffer;
+    return buffer;
+}
+
+std::vector<Profiler::ZoneStats> Profiler::GetZoneStats() {
+    const std::vector<EventCopy> events = Snapshot();
+    const double ticksPerNs = TicksPerNanosecond();
+
+    std::vector<ZoneStats> stats(GetZoneCount());
+    for (size_t zone = 0; zone < stats.size(); ++zone) {
+        stats[zone] = {static_cast<ZoneID>(zone), GetZoneInfo(static_cast<ZoneID>(zone)).name, 0, 0.0, 0.0};
+    }
+
+    for (const EventCopy& event : events) {
+        if (event.zone == FRAME_ZONE || event.zone >= stats.size()) {
+            continue;
+        }
+        const double milliseconds = static_cast<double>(event.end - event.start) / ticksPerNs * 1e-6;
+        ZoneStats& zone = stats[event.zone];
+        zone.count++;
+        zone.totalMs += milliseconds;
+        zone.maxMs = std::max(zone.maxMs, milliseconds);
+    }
+
+    stats.erase(std::remove_if(stats.begin(), stats.end(), [](const ZoneStats& zone) { return zone.count == 0; }),
+                stats.end());
+    std::sort(stats.begin(), stats.end(), [](const ZoneStats& a, const ZoneStats& b) {
+        return a.totalMs > b.totalMs;
+    });
+    return stats;
+}
+
+uint64_t Profiler::GetRecordedCount() {
+    ThreadRegistry& registry = Threads();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    uint64_t count = 0;
+    for (const auto& buffer : registry.buffers) {
+        count += buffer->head.load(std::memory_order_acquire) - buffer->clearedAt.load(std::memory_order_relaxed);
+    }
+    return count;
+}
+
+std::string Profiler::ToChromeTrace() {
+    std::vector<std::pair<uint32_t, std::string>> threadNames;
+    std::vector<EventCopy> events = Snapshot(&threadNames);
+    const double ticksPerUs = TicksPerNanosecond() * 1000.0;
+    const uint64_t epoch = Epoch().ticks;
+
+    // Parents before children so viewers nest zones that start on the same tick
+    std::sort(events.begin(), events.end(), [](const EventCopy& a, const EventCopy& b) {
+        if (a.threadId != b.threadId) return a.threadId < b.threadId;
+        if (a.start != b.start) return a.start < b.start;
+        return a.depth < b.depth;
+    });
+
+    std::string out;
+    out.reserve(256 + events.size() * 128);
+    out += "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+    bool first = true;
+    char number[64];
+    for (const auto& thread : threadNames) {
+        out += first ? "\n" : ",\n";
+        first = false;
+        std::snprintf(number, sizeof(number), "%u", thread.first);
+        out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+        out += number;
+        out += ",\"args\":{\"name\":";
+        AppendJsonString(out, thread.second.c_str());
+        out += "}}";
+    }
+
+    for (const EventCopy& event : events) {
+        const ZoneInfo& info = GetZoneInfo(event.zone);
+        const double ts = static_cast<double>(static_cast<int64_t>(event.start - epoch)) / ticksPerUs;
+
+        out += first ? "\n" : ",\n";
+        first = false;
+        out += "{\"name\":";
+        AppendJsonString(out, info.name);
+
+        if (event.zone == FRAME_ZONE) {
+            std::snprintf(number, sizeof(number), ",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f", ts);
+            out += number;
+        } else {
+            const double dur = static_cast<double>(event.end - event.start) / ticksPerUs;
+            std::snprintf(number, sizeof(number), ",\"cat\":\"zone\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f", ts, dur);
+            out += number;
+        }
+
+        std::snprintf(number, sizeof(number), ",\"pid\":1,\"tid\":%u", event.threadId);
+        out += number;
+
+        if (event.zone != FRAME_ZONE) {
+            out += ",\"args\":{\"file\":";
+            AppendJsonString(out, info.file);
+            std::snprintf(number, sizeof(number), ",\"line\":%u,\"depth\":%u}", info.line, event.depth);
+            out += number;
+        }
+        out += "}";
+    }
+
+    out += "\n]}\n";
+    return out;
+}
+
+bool Profiler::ExportChromeTrace(const std::string& path) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        VOXELCRAFT_ERROR("Failed to open profiler trace file: {}", path);
+        return false;
+    }
+
+    const std::string json = ToChromeTrace();
+    file.write(json.data(), static_cast<std::streamsize>(json.size()));
+    if (!file) {
+        VOXELCRAFT_ERROR("Failed to write profiler trace file: {}", path);
+        return false;
+    }
+
+    VOXELCRAFT_INFO("Profiler trace written to {} ({} bytes)", path, json.size());
+    return true;
+}
+
+double Profiler::TicksToNanoseconds(uint64_t ticks) {
+    return static_cast<double>(ticks) / TicksPerNanosecond();
 }
 
 } // namespace VoxelCraft
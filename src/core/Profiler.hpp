@@ -3,33 +3,300 @@
  * @brief VoxelCraft Performance Profiler
  * @version 1.0.0
  * @author VoxelCraft Team
+ *
+ * Instrument code with the scope macros:
+ *
+ *   void ChunkMesher::Build() {
+ *       VOXELCRAFT_PROFILE_ZONE("ChunkMesher::Build");
+ *       ...
+ *   }
+ *
+ * The macros expand to nothing unless VOXELCRAFT_ENABLE_PROFILING is defined.
+ * When enabled, each call site registers its zone once (a function-local
+ * static) and afterwards costs two timestamp reads and one store into the
+ * calling thread's ring buffer. Nothing is locked or hashed per zone.
  */
 
 #ifndef VOXELCRAFT_CORE_PROFILER_HPP
 #define VOXELCRAFT_CORE_PROFILER_HPP
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
-#include <unordered_map>
-#include <chrono>
-#include <mutex>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #else
+        #include <x86intrin.h>
+    #endif
+    #define VOXELCRAFT_PROFILER_USE_TSC 1
+#endif
 
 namespace VoxelCraft {
 
+/**
+ * @class Profiler
+ * @brief Hierarchical zone profiler with per-thread lock-free ring buffers
+ *
+ * Every thread that records a zone gets its own ring of
+ * EVENTS_PER_THREAD completed zones. Only the owning thread writes it; the
+ * exporter reads it concurrently and drops events that may have been
+ * overwritten while it was copying. When a ring wraps, the oldest zones are
+ * lost, never the newest.
+ *
+ * Timestamps are raw TSC ticks on x86 (steady_clock nanoseconds elsewhere)
+ * and are converted against steady_clock only when exporting.
+ *
+ * Capture is on by default once profiling is compiled in. The static API
+ * works without an instance; the instance ties capture to the application
+ * lifecycle and marks frames in Update().
+ */
 class Profiler {
 public:
+    using ZoneID = uint32_t;
+
+    static constexpr size_t EVENTS_PER_THREAD = 1 << 15;    ///< Ring size, power of two (768 KiB per thread)
+    static constexpr size_t MAX_ZONES = 4096;               ///< Distinct call sites
+
+    /**
+     * @struct ZoneInfo
+     * @brief Static description of a call site
+     */
+    struct ZoneInfo {
+        const char* name;               ///< Zone name (string literal or interned copy)
+        const char* file;               ///< Source file
+        uint32_t line;                  ///< Source line
+    };
+
+    /**
+     * @struct ZoneStats
+     * @brief Aggregate of the zones currently held in the rings
+     */
+    struct ZoneStats {
+        ZoneID zone;                    ///< Zone ID
+        const char* name;               ///< Zone name
+        uint64_t count;                 ///< Completed zones
+        double totalMs;                 ///< Summed duration
+        double maxMs;                   ///< Longest single zone
+    };
+
+    /**
+     * @brief Ring buffer of one thread (owned by the profiler, never freed while running)
+     */
+    struct ThreadBuffer;
+
     Profiler();
     ~Profiler();
 
+    /**
+     * @brief Start capturing
+     */
     bool Initialize();
+
+    /**
+     * @brief Stop capturing; recorded zones stay available for export
+     */
     void Shutdown();
+
+    /**
+     * @brief Mark a frame boundary
+     */
     void Update(double deltaTime);
 
+    // Zone registration
+
+    /**
+     * @brief Register a call site; the name is not copied
+     * @return Zone ID, stable for the whole run
+     */
+    static ZoneID RegisterZone(const char* name, const char* file, uint32_t line);
+
+    /**
+     * @brief Register a zone for a runtime name (copied and interned)
+     *
+     * Registering the same name twice returns the same ID. Intended for
+     * names built once, e.g. per system, not per call.
+     */
+    static ZoneID RegisterDynamicZone(const std::string& name);
+
+    static const ZoneInfo& GetZoneInfo(ZoneID zone);
+    static size_t GetZoneCount();
+
+    // Capture control
+
+    static void SetCapturing(bool capturing) { s_capturing.store(capturing, std::memory_order_relaxed); }
+    static bool IsCapturing() { return s_capturing.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Name the calling thread in exported traces
+     */
+    static void SetThreadName(const std::string& name);
+
+    /**
+     * @brief Record a frame marker (instant event) on the calling thread
+     */
+    static void MarkFrame();
+
+    /**
+     * @brief Drop all recorded zones (rings stay allocated)
+     */
+    static void Clear();
+
+    // Recording
+
+    /**
+     * @brief Current timestamp in profiler ticks
+     */
+    static uint64_t Now() {
+#if defined(VOXELCRAFT_PROFILER_USE_TSC)
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    /**
+     * @brief Append a completed zone to the calling thread's ring
+     */
+    static void RecordZone(ZoneID zone, uint64_t start, uint64_t end, uint32_t depth);
+
+    // Output
+
+    /**
+     * @brief Aggregate per zone over the events still in the rings, longest total first
+     */
+    static std::vector<ZoneStats> GetZoneStats();
+
+    /**
+     * @brief Number of zones recorded since the last Clear (including overwritten ones)
+     */
+    static uint64_t GetRecordedCount();
+
+    /**
+     * @brief Chrome trace JSON (chrome://tracing, Perfetto) of everything in the rings
+     */
+    static std::string ToChromeTrace();
+
+    /**
+     * @brief Write ToChromeTrace() to a file
+     * @return false if the file could not be written
+     */
+    static bool ExportChromeTrace(const std::string& path);
+
+    /**
+     * @brief Convert a tick delta to nanoseconds
+     */
+    static double TicksToNanoseconds(uint64_t ticks);
+
 private:
     bool m_initialized;
+    uint64_t m_frame;
+
+    static std::atomic<bool> s_capturing;
+
+    static ThreadBuffer* RegisterThread();
+};
+
+/**
+ * @brief Per-thread recording state; the buffer is created on first use
+ */
+struct ProfilerThreadState {
+    Profiler::ThreadBuffer* buffer = nullptr;
+    uint32_t depth = 0;
+};
+
+inline thread_local ProfilerThreadState t_profilerThread;
+
+/**
+ * @class ProfileScope
+ * @brief RAII zone; records [construction, destruction) if capture was on at construction
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(Profiler::ZoneID zone)
+        : m_zone(zone)
+        , m_start(0)
+    {
+        if (Profiler::IsCapturing()) {
+            m_depth = t_profilerThread.depth++;
+            m_start = Profiler::Now();
+        }
+    }
+
+    ~ProfileScope() {
+        if (m_start != 0) {
+            const uint64_t end = Profiler::Now();
+            t_profilerThread.depth--;
+            Profiler::RecordZone(m_zone, m_start, end, m_depth);
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    Profiler::ZoneID m_zone;
+    uint64_t m_start;
+    uint32_t m_depth = 0;
 };
 
 } // namespace VoxelCraft
 
+// Scope macros
+
+#define VOXELCRAFT_PROFILE_CONCAT_INNER(a, b) a##b
+#define VOXELCRAFT_PROFILE_CONCAT(a, b) VOXELCRAFT_PROFILE_CONCAT_INNER(a, b)
+
+#if defined(VOXELCRAFT_ENABLE_PROFILING)
+
+/**
+ * @def VOXELCRAFT_PROFILE_ZONE(name)
+ * @brief Profile the rest of the enclosing scope; name must be a string literal
+ */
+#define VOXELCRAFT_PROFILE_ZONE(name) \
+    static const ::VoxelCraft::Profiler::ZoneID VOXELCRAFT_PROFILE_CONCAT(voxelcraftZone_, __LINE__) = \
+        ::VoxelCraft::Profiler::RegisterZone(name, __FILE__, __LINE__); \
+    ::VoxelCraft::ProfileScope VOXELCRAFT_PROFILE_CONCAT(voxelcraftScope_, __LINE__)( \
+        VOXELCRAFT_PROFILE_CONCAT(voxelcraftZone_, __LINE__))
+
+/**
+ * @def VOXELCRAFT_PROFILE_ZONE_ID(zoneId)
+ * @brief Profile the rest of the scope under a zone registered at runtime
+ */
+#define VOXELCRAFT_PROFILE_ZONE_ID(zoneId) \
+    ::VoxelCraft::ProfileScope VOXELCRAFT_PROFILE_CONCAT(voxelcraftScope_, __LINE__)(zoneId)
+
+/**
+ * @def VOXELCRAFT_PROFILE_ZONE_FUNCTION()
+ * @brief Profile the enclosing function under its own name
+ */
+#define VOXELCRAFT_PROFILE_ZONE_FUNCTION() VOXELCRAFT_PROFILE_ZONE(__func__)
+
+/**
+ * @def VOXELCRAFT_PROFILE_FRAME()
+ * @brief Mark a frame boundary
+ */
+#define VOXELCRAFT_PROFILE_FRAME() ::VoxelCraft::Profiler::MarkFrame()
+
+/**
+ * @def VOXELCRAFT_PROFILE_THREAD(name)
+ * @brief Name the calling thread in traces
+ */
+#define VOXELCRAFT_PROFILE_THREAD(name) ::VoxelCraft::Profiler::SetThreadName(name)
+
+#else
+
+#define VOXELCRAFT_PROFILE_ZONE(name) ((void)0)
+#define VOXELCRAFT_PROFILE_ZONE_ID(zoneId) ((void)0)
+#define VOXELCRAFT_PROFILE_ZONE_FUNCTION() ((void)0)
+#define VOXELCRAFT_PROFILE_FRAME() ((void)0)
+#define VOXELCRAFT_PROFILE_THREAD(name) ((void)0)
+
+#endif
+
 #endif // VOXELCRAFT_CORE_PROFILER_HPP
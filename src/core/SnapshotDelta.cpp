@@ -0,0 +1,292 @@
+/**
+ * @file SnapshotDelta.cpp
+ * @brief VoxelCraft Snapshot Delta Encoding Implementation
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#include "SnapshotDelta.hpp"
+
+#include <algorithm>
+
+namespace VoxelCraft {
+
+namespace {
+
+// Zero runs shorter than this are cheaper to keep inside a literal
+constexpr size_t MIN_ZERO_RUN = 4;
+
+void WriteVarint(std::vector<uint8_t>& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+bool ReadVarint(const uint8_t* data, size_t size, size_t& offset, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (offset >= size) {
+            return false;
+        }
+        const uint8_t byte = data[offset++];
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+inline uint8_t XorAt(const std::vector<uint8_t>& current, const std::vector<uint8_t>& baseline, size_t i) {
+    return i < baseline.size() ? static_cast<uint8_t>(current[i] ^ baseline[i]) : current[i];
+}
+
+} // namespace
+
+void SnapshotDeltaCodec::Encode(const std::vector<uint8_t>& current,
+                                const std::vector<uint8_t>& baseline,
+                                std::vector<uint8_t>& delta) {
+    delta.clear();
+    WriteVarint(delta, current.size());
+
+    const size_t size = current.size();
+    size_t pos = 0;
+
+    while (pos < size) {
+        // Leading zero run
+        size_t runStart = pos;
+        while (pos < size && XorAt(current, baseline, pos) == 0) {
+            pos++;
+        }
+        if (pos == size) {
+            break; // Trailing zeros are implied by the size
+        }
+        const size_t zeroRun = pos - runStart;
+
+        // Literal up to the next zero run worth a segment of its own
+        const size_t literalStart = pos;
+        size_t literalEnd = pos;
+        size_t zeros = 0;
+        while (pos < size) {
+            if (XorAt(current, baseline, pos) == 0) {
+                if (++zeros >= MIN_ZERO_RUN) {
+                    break;
+                }
+            } else {
+                zeros = 0;
+                literalEnd = pos + 1;
+            }
+            pos++;
+        }
+        pos = literalEnd;
+
+        WriteVarint(delta, zeroRun);
+        WriteVarint(delta, literalEnd - literalStart);
+        for (size_t i = literalStart; i < literalEnd; ++i) {
+            delta.push_back(XorAt(current, baseline, i));
+        }
+    }
+}
+
+bool SnapshotDeltaCodec::Decode(const uint8_t* delta, size_t deltaSize,
+                                const std::vector<uint8_t>& baseline,
+                                std::vector<uint8_t>& current) {
+    size_t offset = 0;
+    uint64_t size = 0;
+    if (!ReadVarint(delta, deltaSize, offset, size)) {
+        return false;
+    }
+
+    // Anything larger than the delta could describe is corrupt
+    const uint64_t maxSize = static_cast<uint64_t>(baseline.size()) + deltaSize * 128;
+    if (size > maxSize) {
+        return false;
+    }
+
+    // Start from the baseline; zero runs leave it untouched
+    current.assign(static_cast<size_t>(size), 0);
+    std::copy_n(baseline.begin(), std::min<size_t>(baseline.size(), current.size()), current.begin());
+
+    size_t pos = 0;
+    while (offset < deltaSize) {
+        uint64_t zeroRun = 0;
+        uint64_t literalLength = 0;
+        if (!ReadVarint(delta, deltaSize, offset, zeroRun) ||
+            !ReadVarint(delta, deltaSize, offset, literalLength)) {
+            return false;
+        }
+        if (zeroRun > size - pos || literalLength > size - pos - zeroRun ||
+            literalLength > deltaSize - offset) {
+            return false;
+        }
+
+        pos += static_cast<size_t>(zeroRun);
+        for (uint64_t i = 0; i < literalLength; ++i, ++pos) {
+            current[pos] ^= delta[offset++];
+        }
+    }
+
+    return true;
+}
+
+// SnapshotBaselineTracker
+
+SnapshotBaselineTracker::SnapshotBaselineTracker(size_t historySize)
+    : m_historySize(std::max<size_t>(historySize, 1))
+    , m_stats{}
+{
+}
+
+void SnapshotBaselineTracker::PushSnapshot(uint64_t sequence, const std::vector<uint8_t>& data) {
+    m_history.push_back({sequence, data});
+    while (m_history.size() > m_historySize) {
+        m_history.pop_front();
+    }
+    m_encodedLatest.clear();
+}
+
+void SnapshotBaselineTracker::AddClient(uint32_t clientId) {
+    m_clientBaselines.emplace(clientId, 0);
+}
+
+void SnapshotBaselineTracker::RemoveClient(uint32_t clientId) {
+    m_clientBaselines.erase(clientId);
+}
+
+bool SnapshotBaselineTracker::HasClient(uint32_t clientId) const {
+    return m_clientBaselines.count(clientId) != 0;
+}
+
+std::vector<uint32_t> SnapshotBaselineTracker::GetClients() const {
+    std::vector<uint32_t> clients;
+    clients.reserve(m_clientBaselines.size());
+    for (const auto& pair : m_clientBaselines) {
+        clients.push_back(pair.first);
+    }
+    return clients;
+}
+
+void SnapshotBaselineTracker::Acknowledge(uint32_t clientId, uint64_t sequence) {
+    auto it = m_clientBaselines.find(clientId);
+    if (it == m_clientBaselines.end()) {
+        return;
+    }
+
+    if (sequence == 0 || sequence > it->second) {
+        it->second = sequence;
+    }
+}
+
+uint64_t SnapshotBaselineTracker::EncodeForClient(uint32_t clientId, std::vector<uint8_t>& payload) {
+    payload.clear();
+    if (m_history.empty()) {
+        return 0;
+    }
+
+    const Entry& latest = m_history.back();
+    uint64_t baselineSequence = 0;
+
+    auto client = m_clientBaselines.find(clientId);
+    if (client != m_clientBaselines.end() && client->second != 0) {
+        if (FindSnapshot(client->second)) {
+            baselineSequence = client->second;
+        } else {
+            // Client fell too far behind; restart it from a full snapshot
+            m_stats.baselineMisses++;
+            client->second = 0;
+        }
+    }
+
+    auto cached = m_encodedLatest.find(baselineSequence);
+    if (cached == m_encodedLatest.end()) {
+        static const std::vector<uint8_t> emptyBaseline;
+        const Entry* baseline = baselineSequence != 0 ? FindSnapshot(baselineSequence) : nullptr;
+
+        std::vector<uint8_t> encoded;
+        SnapshotDeltaCodec::Encode(latest.data, baseline ? baseline->data : emptyBaseline, encoded);
+        cached = m_encodedLatest.emplace(baselineSequence, std::move(encoded)).first;
+    }
+
+    payload = cached->second;
+
+    if (baselineSequence == 0) {
+        m_stats.fullSnapshots++;
+    } else {
+        m_stats.deltaSnapshots++;
+    }
+    m_stats.rawBytes += latest.data.size();
+    m_stats.encodedBytes += payload.size();
+
+    return baselineSequence;
+}
+
+uint64_t SnapshotBaselineTracker::GetLatestSequence() const {
+    return m_history.empty() ? 0 : m_history.back().sequence;
+}
+
+void SnapshotBaselineTracker::Clear() {
+    m_history.clear();
+    m_clientBaselines.clear();
+    m_encodedLatest.clear();
+    m_stats = Stats{};
+}
+
+const SnapshotBaselineTracker::Entry* SnapshotBaselineTracker::FindSnapshot(uint64_t sequence) const {
+    // History is sorted by sequence; it is short, so search from the newest end
+    for (auto it = m_history.rbegin(); it != m_history.rend(); ++it) {
+        if (it->sequence == sequence) {
+            return &*it;
+        }
+        if (it->sequence < sequence) {
+            break;
+        }
+    }
+    return nullptr;
+}
+
+// SnapshotBaselineStore
+
+SnapshotBaselineStore::SnapshotBaselineStore(size_t historySize)
+    : m_historySize(std::max<size_t>(historySize, 1))
+{
+}
+
+bool SnapshotBaselineStore::Decode(uint64_t sequence, uint64_t baselineSequence,
+                                   const uint8_t* payload, size_t payloadSize,
+                                   std::vector<uint8_t>& data) {
+    static const std::vector<uint8_t> emptyBaseline;
+    const std::vector<uint8_t>* baseline = &emptyBaseline;
+
+    if (baselineSequence != 0) {
+        auto it = std::find_if(m_history.begin(), m_history.end(),
+                               [baselineSequence](const Entry& entry) { return entry.sequence == baselineSequence; });
+        if (it == m_history.end()) {
+            return false;
+        }
+        baseline = &it->data;
+    }
+
+    if (!SnapshotDeltaCodec::Decode(payload, payloadSize, *baseline, data)) {
+        return false;
+    }
+
+    // Keep sorted by sequence; late packets are still valid baselines
+    auto insertAt = std::find_if(m_history.begin(), m_history.end(),
+                                 [sequence](const Entry& entry) { return entry.sequence >= sequence; });
+    if (insertAt == m_history.end() || insertAt->sequence != sequence) {
+        m_history.insert(insertAt, {sequence, data});
+    }
+    while (m_history.size() > m_historySize) {
+        m_history.pop_front();
+    }
+
+    return true;
+}
+
+void SnapshotBaselineStore::Clear() {
+    m_history.clear();
+}
+
+} // namespace VoxelCraft
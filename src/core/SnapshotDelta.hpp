@@ -0,0 +1,168 @@
+/**
+ * @file SnapshotDelta.hpp
+ * @brief VoxelCraft Snapshot Delta Encoding and Baseline Tracking
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#ifndef VOXELCRAFT_CORE_SNAPSHOT_DELTA_HPP
+#define VOXELCRAFT_CORE_SNAPSHOT_DELTA_HPP
+
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+namespace VoxelCraft {
+
+/**
+ * @class SnapshotDeltaCodec
+ * @brief XOR delta of a serialized snapshot against a baseline
+ *
+ * The snapshot is XORed byte by byte with the baseline (bytes past the end of
+ * the baseline are XORed with zero), so fields that did not change become
+ * zero runs. The result is stored as:
+ *
+ *   varint size, then repeated [varint zeroRun][varint literalLength][literal]
+ *
+ * Short zero runs inside changed data stay in the literal, since a new
+ * segment header costs more than a couple of zero bytes. A float that moved
+ * a little usually changes its low mantissa bytes only, so a walking player
+ * costs a few bytes per field instead of the full record.
+ */
+class SnapshotDeltaCodec {
+public:
+    /**
+     * @brief Encode current against baseline
+     * @param current Snapshot to send
+     * @param baseline Snapshot both sides have (may be empty for a full snapshot)
+     * @param delta Receives the encoded delta (cleared first)
+     */
+    static void Encode(const std::vector<uint8_t>& current,
+                       const std::vector<uint8_t>& baseline,
+                       std::vector<uint8_t>& delta);
+
+    /**
+     * @brief Rebuild a snapshot from a delta and the same baseline
+     * @return false if the delta is truncated or malformed
+     */
+    static bool Decode(const uint8_t* delta, size_t deltaSize,
+                       const std::vector<uint8_t>& baseline,
+                       std::vector<uint8_t>& current);
+};
+
+/**
+ * @class SnapshotBaselineTracker
+ * @brief Server side: recent snapshots and the last one each client acked
+ *
+ * Every snapshot is pushed once; each client is then sent the newest snapshot
+ * encoded against the newest snapshot it has acknowledged. If that baseline
+ * already fell out of the history (or the client never acked one, or asked
+ * for a reset by acking sequence 0), the client gets a full snapshot, which
+ * is simply a delta against the empty baseline.
+ *
+ * Clients acking the same baseline share one encoding per snapshot. The
+ * tracker is not thread-safe; GameStateSync calls it under its snapshot lock.
+ */
+class SnapshotBaselineTracker {
+public:
+    /**
+     * @struct Stats
+     * @brief Cumulative encoding counters
+     */
+    struct Stats {
+        uint64_t fullSnapshots;         ///< Snapshots sent without a baseline
+        uint64_t deltaSnapshots;        ///< Snapshots sent as a delta
+        uint64_t baselineMisses;        ///< Acked baselines no longer in history
+        uint64_t rawBytes;              ///< Bytes the snapshots would have taken in full
+        uint64_t encodedBytes;          ///< Bytes actually produced
+    };
+
+    static constexpr size_t DEFAULT_HISTORY = 32;
+
+    /**
+     * @brief Constructor
+     * @param historySize Snapshots kept as potential baselines
+     */
+    explicit SnapshotBaselineTracker(size_t historySize = DEFAULT_HISTORY);
+
+    /**
+     * @brief Add the newest snapshot
+     * @param sequence Snapshot sequence number (non-zero, increasing)
+     */
+    void PushSnapshot(uint64_t sequence, const std::vector<uint8_t>& data);
+
+    void AddClient(uint32_t clientId);
+    void RemoveClient(uint32_t clientId);
+    bool HasClient(uint32_t clientId) const;
+    std::vector<uint32_t> GetClients() const;
+
+    /**
+     * @brief Record a client ack
+     * @param sequence Snapshot the client decoded; 0 drops its baseline
+     *
+     * Stale acks (older than the current baseline) are ignored, since packets
+     * can arrive out of order.
+     */
+    void Acknowledge(uint32_t clientId, uint64_t sequence);
+
+    /**
+     * @brief Encode the newest snapshot for a client
+     * @param payload Receives the encoded snapshot
+     * @return Baseline sequence used, 0 for a full snapshot
+     */
+    uint64_t EncodeForClient(uint32_t clientId, std::vector<uint8_t>& payload);
+
+    uint64_t GetLatestSequence() const;
+    const Stats& GetStats() const { return m_stats; }
+    void Clear();
+
+private:
+    struct Entry {
+        uint64_t sequence;
+        std::vector<uint8_t> data;
+    };
+
+    const Entry* FindSnapshot(uint64_t sequence) const;
+
+    size_t m_historySize;
+    std::deque<Entry> m_history;                            ///< Oldest first
+    std::unordered_map<uint32_t, uint64_t> m_clientBaselines; ///< Last acked sequence, 0 = none
+    std::unordered_map<uint64_t, std::vector<uint8_t>> m_encodedLatest; ///< Newest snapshot by baseline
+    Stats m_stats;
+};
+
+/**
+ * @class SnapshotBaselineStore
+ * @brief Client side: decoded snapshots that may be used as baselines
+ */
+class SnapshotBaselineStore {
+public:
+    explicit SnapshotBaselineStore(size_t historySize = SnapshotBaselineTracker::DEFAULT_HISTORY);
+
+    /**
+     * @brief Decode a snapshot and keep it as a future baseline
+     * @param baselineSequence Baseline the server used, 0 for a full snapshot
+     * @return false if the baseline is unknown or the payload is malformed;
+     *         the caller should then ask for a full snapshot
+     */
+    bool Decode(uint64_t sequence, uint64_t baselineSequence,
+                const uint8_t* payload, size_t payloadSize,
+                std::vector<uint8_t>& data);
+
+    void Clear();
+
+private:
+    struct Entry {
+        uint64_t sequence;
+        std::vector<uint8_t> data;
+    };
+
+    size_t m_historySize;
+    std::deque<Entry> m_history;
+};
+
+} // namespace VoxelCraft
+
+#endif // VOXELCRAFT_CORE_SNAPSHOT_DELTA_HPP
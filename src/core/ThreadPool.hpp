@@ -261,7 +261,8 @@ auto ThreadPool::SubmitTask(F&& function, TaskPriority priority, const std::stri
 
     std::future<ReturnType> result = task->get_future();
 
-    SubmitTask([task]() { (*task)(); }, priority, name);
+    // Wrap explicitly so overload resolution picks the non-template overload
+    SubmitTask(std::function<void()>([task]() { (*task)(); }), priority, name);
 
     return result;
 }
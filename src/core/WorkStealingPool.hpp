@@ -0,0 +1,141 @@
+/**
+ * @file WorkStealingPool.hpp
+ * @brief VoxelCraft Work-Stealing Thread Pool
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#ifndef VOXELCRAFT_CORE_WORK_STEALING_POOL_HPP
+#define VOXELCRAFT_CORE_WORK_STEALING_POOL_HPP
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <cstdint>
+
+namespace VoxelCraft {
+
+/**
+ * @class WorkStealingPool
+ * @brief Fire-and-forget task pool with one deque per worker
+ *
+ * Tasks submitted from a worker go to the back of that worker's deque and are
+ * popped LIFO, so follow-up work stays on the core that produced its data.
+ * Tasks submitted from other threads are spread round-robin. An idle worker
+ * steals from the front of the other deques before going to sleep.
+ *
+ * Unlike ThreadPool there are no priorities or futures; callers that need
+ * ordering (e.g. ChunkPipeline) keep their own ready queue and only hand
+ * runnable work to the pool.
+ */
+class WorkStealingPool {
+public:
+    /**
+     * @struct Stats
+     * @brief Cumulative pool counters
+     */
+    struct Stats {
+        uint64_t tasksExecuted;     ///< Tasks run to completion
+        uint64_t tasksStolen;       ///< Tasks taken from another worker's deque
+        uint64_t tasksSubmitted;    ///< Tasks submitted
+        uint32_t threadCount;       ///< Worker threads
+    };
+
+    /**
+     * @brief Constructor
+     * @param numThreads Number of worker threads (0 = hardware concurrency)
+     */
+    explicit WorkStealingPool(size_t numThreads = 0);
+
+    /**
+     * @brief Destructor
+     */
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * @brief Start the worker threads
+     * @return true if successful
+     */
+    bool Initialize();
+
+    /**
+     * @brief Stop the workers; queued tasks that have not started are dropped
+     */
+    void Shutdown();
+
+    /**
+     * @brief Queue a task
+     * @param task Task to run; exceptions are caught and logged
+     */
+    void Submit(std::function<void()> task);
+
+    /**
+     * @brief Block until every submitted task has finished
+     */
+    void WaitIdle();
+
+    /**
+     * @brief Get number of worker threads
+     */
+    size_t GetThreadCount() const { return m_queues.size(); }
+
+    /**
+     * @brief Check if the pool is running
+     */
+    bool IsRunning() const { return m_running.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Get cumulative counters
+     */
+    Stats GetStats() const;
+
+    /**
+     * @brief Index of the calling worker in this pool, or -1 for other threads
+     */
+    int GetCurrentWorkerIndex() const;
+
+private:
+    struct alignas(64) WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    std::vector<std::thread> m_threads;
+    std::atomic<bool> m_running;
+
+    // Queued but not yet taken, and taken but not yet finished
+    std::atomic<size_t> m_queued;
+    std::atomic<size_t> m_active;
+    std::atomic<uint32_t> m_nextQueue;
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCondition;
+    std::condition_variable m_idleCondition;
+
+    std::atomic<uint64_t> m_tasksExecuted;
+    std::atomic<uint64_t> m_tasksStolen;
+    std::atomic<uint64_t> m_tasksSubmitted;
+
+    /**
+     * @brief Worker thread function
+     */
+    void WorkerThread(size_t index);
+
+    /**
+     * @brief Pop from own deque, then try to steal
+     */
+    bool TryTake(size_t index, std::function<void()>& task);
+};
+
+} // namespace VoxelCraft
+
+#endif // VOXELCRAFT_CORE_WORK_STEALING_POOL_HPP
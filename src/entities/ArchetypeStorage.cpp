@@ -0,0 +1,302 @@
+#include "ArchetypeStorage.hpp"
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <mutex>
+
+namespace VoxelCraft {
+
+    namespace {
+
+        constexpr size_t CHUNK_ALIGNMENT = 64;
+
+        // Array fijo: GetInfo se lee sin lock mientras otro hilo registra
+        std::array<ComponentTypeInfo, MAX_COMPONENT_TYPES> s_TypeInfos;
+        std::atomic<size_t> s_TypeCount{0};
+        std::mutex s_RegistryMutex;
+
+        size_t AlignUp(size_t value, size_t alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+
+    }
+
+    // Implementación de ComponentTypeRegistry
+    ComponentTypeID ComponentTypeRegistry::Register(const ComponentTypeInfo& info) {
+        std::lock_guard<std::mutex> lock(s_RegistryMutex);
+
+        const size_t id = s_TypeCount.load(std::memory_order_relaxed);
+        assert(id < MAX_COMPONENT_TYPES && "Demasiados tipos de datos de componente");
+        s_TypeInfos[id] = info;
+        s_TypeCount.store(id + 1, std::memory_order_release);
+        return static_cast<ComponentTypeID>(id);
+    }
+
+    const ComponentTypeInfo& ComponentTypeRegistry::GetInfo(ComponentTypeID id) {
+        return s_TypeInfos[id];
+    }
+
+    size_t ComponentTypeRegistry::GetCount() {
+        return s_TypeCount.load(std::memory_order_acquire);
+    }
+
+    // Implementación de Archetype
+    Archetype::Archetype(const std::vector<ComponentTypeID>& types)
+        : m_Types(types)
+        , m_ColumnOf(MAX_COMPONENT_TYPES, -1)
+        , m_EntityOffset(0)
+        , m_ChunkBytes(CHUNK_BYTES)
+        , m_Capacity(1)
+        , m_Count(0)
+    {
+        std::sort(m_Types.begin(), m_Types.end());
+
+        size_t rowBytes = sizeof(uint64_t);
+        for (size_t i = 0; i < m_Types.size(); ++i) {
+            const ComponentTypeInfo& info = ComponentTypeRegistry::GetInfo(m_Types[i]);
+            m_Mask.set(m_Types[i]);
+            m_ColumnOf[m_Types[i]] = static_cast<int8_t>(i);
+            m_ColumnSizes.push_back(info.size);
+            rowBytes += info.size;
+        }
+
+        // Columnas alineadas una detrás de otra, los handles al final
+        auto layout = [this](uint32_t capacity) {
+            size_t offset = 0;
+            m_ColumnOffsets.clear();
+            for (size_t i = 0; i < m_Types.size(); ++i) {
+                const ComponentTypeInfo& info = ComponentTypeRegistry::GetInfo(m_Types[i]);
+                offset = AlignUp(offset, std::max(info.alignment, alignof(std::max_align_t)));
+                m_ColumnOffsets.push_back(offset);
+                offset += info.size * capacity;
+            }
+            offset = AlignUp(offset, alignof(uint64_t));
+            m_EntityOffset = offset;
+            return offset + sizeof(uint64_t) * capacity;
+        };
+
+        m_Capacity = static_cast<uint32_t>(std::max<size_t>(1, CHUNK_BYTES / rowBytes));
+        while (m_Capacity > 1 && layout(m_Capacity) > CHUNK_BYTES) {
+            m_Capacity--;
+        }
+        m_ChunkBytes = AlignUp(std::max(CHUNK_BYTES, layout(m_Capacity)), CHUNK_ALIGNMENT);
+    }
+
+    Archetype::~Archetype() {
+        while (m_Count > 0) {
+            RemoveRow(static_cast<uint32_t>(m_Count - 1));
+        }
+        for (std::byte* chunk : m_Chunks) {
+            ::operator delete(chunk, std::align_val_t(CHUNK_ALIGNMENT));
+        }
+    }
+
+    uint32_t Archetype::AllocateRow(uint64_t entity) {
+        if (m_Count == m_Chunks.size() * m_Capacity) {
+            m_Chunks.push_back(static_cast<std::byte*>(::operator new(m_ChunkBytes, std::align_val_t(CHUNK_ALIGNMENT))));
+        }
+
+        const uint32_t row = static_cast<uint32_t>(m_Count++);
+        EntityAt(row) = entity;
+        return row;
+    }
+
+    uint64_t Archetype::RemoveRow(uint32_t row) {
+        const uint32_t last = static_cast<uint32_t>(m_Count - 1);
+
+        for (size_t column = 0; column < m_Types.size(); ++column) {
+            const ComponentTypeInfo& info = ComponentTypeRegistry::GetInfo(m_Types[column]);
+            void* data = GetData(row, static_cast<int>(column));
+            info.destroy(data);
+            if (row != last) {
+                void* source = GetData(last, static_cast<int>(column));
+                info.moveConstruct(data, source);
+                info.destroy(source);
+            }
+        }
+
+        uint64_t moved = 0;
+        if (row != last) {
+            moved = EntityAt(last);
+            EntityAt(row) = moved;
+        }
+        m_Count--;
+
+        // Deja un chunk vacío de reserva para no liberar y pedir en cada frontera
+        while (m_Chunks.size() > 1 && m_Count + 2 * static_cast<size_t>(m_Capacity) <= m_Chunks.size() * m_Capacity) {
+            ::operator delete(m_Chunks.back(), std::align_val_t(CHUNK_ALIGNMENT));
+            m_Chunks.pop_back();
+        }
+
+        return moved;
+    }
+
+    // Implementación de ArchetypeStorage
+    ArchetypeStorage::ArchetypeStorage()
+        : m_AliveCount(0)
+        , m_EmptyArchetype(nullptr)
+    {
+        m_EmptyArchetype = GetOrCreateArchetype({});
+    }
+
+    ArchetypeStorage::~ArchetypeStorage() = default;
+
+    ArchetypeStorage::EntityHandle ArchetypeStorage::Create() {
+        uint32_t index;
+        if (!m_FreeRecords.empty()) {
+            index = m_FreeRecords.back();
+            m_FreeRecords.pop_back();
+        } else {
+            index = static_cast<uint32_t>(m_Records.size());
+            m_Records.emplace_back();
+        }
+
+        EntityRecord& record = m_Records[index];
+        const EntityHandle entity = (static_cast<EntityHandle>(record.generation) << 32) | index;
+        record.archetype = m_EmptyArchetype;
+        record.row = m_EmptyArchetype->AllocateRow(entity);
+        m_AliveCount++;
+        return entity;
+    }
+
+    bool ArchetypeStorage::Destroy(EntityHandle entity) {
+        if (!FindRecord(entity)) {
+            return false;
+        }
+
+        EntityRecord& record = m_Records[IndexOf(entity)];
+        const EntityHandle moved = record.archetype->RemoveRow(record.row);
+        if (moved != INVALID_ENTITY) {
+            m_Records[IndexOf(moved)].row = record.row;
+        }
+
+        record.archetype = nullptr;
+        record.generation++;
+        m_FreeRecords.push_back(IndexOf(entity));
+        m_AliveCount--;
+        return true;
+    }
+
+    bool ArchetypeStorage::IsAlive(EntityHandle entity) const {
+        return FindRecord(entity) != nullptr;
+    }
+
+    void ArchetypeStorage::Clear() {
+        for (size_t index = 0; index < m_Records.size(); ++index) {
+            EntityRecord& record = m_Records[index];
+            if (record.archetype) {
+                Destroy((static_cast<EntityHandle>(record.generation) << 32) | index);
+            }
+        }
+    }
+
+    const ArchetypeStorage::EntityRecord* ArchetypeStorage::FindRecord(EntityHandle entity) const {
+        const uint32_t index = IndexOf(entity);
+        if (index >= m_Records.size()) {
+            return nullptr;
+        }
+
+        const EntityRecord& record = m_Records[index];
+        return record.archetype && record.generation == GenerationOf(entity) ? &record : nullptr;
+    }
+
+    Archetype* ArchetypeStorage::GetOrCreateArchetype(const std::vector<ComponentTypeID>& types) {
+        ComponentMask mask;
+        for (ComponentTypeID type : types) {
+            mask.set(type);
+        }
+
+        auto it = m_Archetypes.find(mask);
+        if (it != m_Archetypes.end()) {
+            return it->second.get();
+        }
+
+        auto archetype = std::make_unique<Archetype>(types);
+        Archetype* rawPtr = archetype.get();
+        m_Archetypes.emplace(mask, std::move(archetype));
+
+        // Las consultas guardadas que lo cubren lo incorporan ya
+        for (auto& pair : m_Queries) {
+            if ((mask & pair.first) == pair.first) {
+                pair.second->archetypes.push_back(rawPtr);
+            }
+        }
+
+        return rawPtr;
+    }
+
+    Archetype* ArchetypeStorage::GetAddTarget(Archetype* source, ComponentTypeID type) {
+        auto it = source->m_AddEdges.find(type);
+        if (it != source->m_AddEdges.end()) {
+            return it->second;
+        }
+
+        std::vector<ComponentTypeID> types = source->GetTypes();
+        types.push_back(type);
+        Archetype* target = GetOrCreateArchetype(types);
+
+        source->m_AddEdges[type] = target;
+        target->m_RemoveEdges[type] = source;
+        return target;
+    }
+
+    Archetype* ArchetypeStorage::GetRemoveTarget(Archetype* source, ComponentTypeID type) {
+        auto it = source->m_RemoveEdges.find(type);
+        if (it != source->m_RemoveEdges.end()) {
+            return it->second;
+        }
+
+        std::vector<ComponentTypeID> types = source->GetTypes();
+        types.erase(std::remove(types.begin(), types.end(), type), types.end());
+        Archetype* target = GetOrCreateArchetype(types);
+
+        source->m_RemoveEdges[type] = target;
+        target->m_AddEdges[type] = source;
+        return target;
+    }
+
+    void ArchetypeStorage::MoveEntity(EntityHandle entity, Archetype* target) {
+        EntityRecord& record = m_Records[IndexOf(entity)];
+        Archetype* source = record.archetype;
+        const uint32_t sourceRow = record.row;
+        const uint32_t targetRow = target->AllocateRow(entity);
+
+        // Los tipos compartidos se mueven; los que sobran los destruye RemoveRow
+        for (size_t column = 0; column < source->GetTypes().size(); ++column) {
+            const ComponentTypeID type = source->GetTypes()[column];
+            const int targetColumn = target->GetColumn(type);
+            if (targetColumn >= 0) {
+                ComponentTypeRegistry::GetInfo(type).moveConstruct(target->GetData(targetRow, targetColumn),
+                                                                   source->GetData(sourceRow, static_cast<int>(column)));
+            }
+        }
+
+        const EntityHandle moved = source->RemoveRow(sourceRow);
+        if (moved != INVALID_ENTITY) {
+            m_Records[IndexOf(moved)].row = sourceRow;
+        }
+
+        record.archetype = target;
+        record.row = targetRow;
+    }
+
+    const ArchetypeQueryCache* ArchetypeStorage::GetQueryCache(const ComponentMask& mask) {
+        auto it = m_Queries.find(mask);
+        if (it != m_Queries.end()) {
+            return it->second.get();
+        }
+
+        auto cache = std::make_unique<ArchetypeQueryCache>();
+        cache->mask = mask;
+        for (const auto& pair : m_Archetypes) {
+            if ((pair.first & mask) == mask) {
+                cache->archetypes.push_back(pair.second.get());
+            }
+        }
+
+        const ArchetypeQueryCache* rawPtr = cache.get();
+        m_Queries.emplace(mask, std::move(cache));
+        return rawPtr;
+    }
+
+}
@@ -0,0 +1,404 @@
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace VoxelCraft {
+
+    using ComponentTypeID = uint32_t;
+
+    /// Límite de tipos de datos distintos; las firmas son bitsets de este tamaño
+    constexpr size_t MAX_COMPONENT_TYPES = 128;
+    using ComponentMask = std::bitset<MAX_COMPONENT_TYPES>;
+
+    /**
+     * @brief Operaciones de un tipo de dato de componente sin conocer el tipo
+     */
+    struct ComponentTypeInfo {
+        size_t size;
+        size_t alignment;
+        void (*moveConstruct)(void* destination, void* source);
+        void (*destroy)(void* object);
+    };
+
+    /**
+     * @brief Asigna un ID secuencial a cada tipo de dato de componente
+     *
+     * Los IDs se asignan la primera vez que se usa el tipo y son válidos
+     * durante toda la ejecución.
+     */
+    class ComponentTypeRegistry {
+    public:
+        template<typename T>
+        static ComponentTypeID GetID() {
+            static const ComponentTypeID id = Register(MakeInfo<T>());
+            return id;
+        }
+
+        static const ComponentTypeInfo& GetInfo(ComponentTypeID id);
+        static size_t GetCount();
+
+    private:
+        static ComponentTypeID Register(const ComponentTypeInfo& info);
+
+        template<typename T>
+        static ComponentTypeInfo MakeInfo() {
+            static_assert(std::is_move_constructible_v<T>, "Los datos de componente deben poder moverse");
+            ComponentTypeInfo info;
+            info.size = sizeof(T);
+            info.alignment = alignof(T);
+            info.moveConstruct = [](void* destination, void* source) {
+                new (destination) T(std::move(*static_cast<T*>(source)));
+            };
+            info.destroy = [](void* object) {
+                static_cast<T*>(object)->~T();
+            };
+            return info;
+        }
+    };
+
+    /**
+     * @brief Grupo de entidades con exactamente el mismo conjunto de datos
+     *
+     * Las entidades se guardan en chunks de CHUNK_BYTES; dentro de cada chunk
+     * cada tipo ocupa un array contiguo (SoA), seguido del array de handles.
+     * Las filas están siempre compactas: al quitar una entidad la última
+     * ocupa su hueco, así que todos los chunks salvo el último están llenos.
+     */
+    class Archetype {
+    public:
+        static constexpr size_t CHUNK_BYTES = 16 * 1024;
+
+        Archetype(const std::vector<ComponentTypeID>& types);
+        ~Archetype();
+
+        Archetype(const Archetype&) = delete;
+        Archetype& operator=(const Archetype&) = delete;
+
+        const ComponentMask& GetMask() const { return m_Mask; }
+        const std::vector<ComponentTypeID>& GetTypes() const { return m_Types; }
+        size_t GetEntityCount() const { return m_Count; }
+        /// Chunks con entidades; el chunk vacío de reserva no cuenta
+        size_t GetChunkCount() const { return (m_Count + m_Capacity - 1) / m_Capacity; }
+        uint32_t GetChunkCapacity() const { return m_Capacity; }
+
+        /// Entidades en un chunk (todos llenos salvo el último)
+        uint32_t GetChunkSize(size_t chunk) const {
+            return chunk + 1 < GetChunkCount() ? m_Capacity : static_cast<uint32_t>(m_Count - chunk * m_Capacity);
+        }
+
+        /// Columna de un tipo, -1 si el arquetipo no lo tiene
+        int GetColumn(ComponentTypeID type) const { return m_ColumnOf[type]; }
+
+        /// Primer elemento de una columna dentro de un chunk
+        void* GetColumnData(size_t chunk, int column) const {
+            return m_Chunks[chunk] + m_ColumnOffsets[static_cast<size_t>(column)];
+        }
+
+        template<typename T>
+        T* GetColumnData(size_t chunk, int column) const {
+            return static_cast<T*>(GetColumnData(chunk, column));
+        }
+
+        /// Handles de las entidades de un chunk
+        const uint64_t* GetEntities(size_t chunk) const {
+            return reinterpret_cast<const uint64_t*>(m_Chunks[chunk] + m_EntityOffset);
+        }
+
+        /// Dirección del dato de una columna en una fila
+        void* GetData(uint32_t row, int column) const {
+            const size_t index = static_cast<size_t>(column);
+            return m_Chunks[row / m_Capacity] + m_ColumnOffsets[index] +
+                   static_cast<size_t>(row % m_Capacity) * m_ColumnSizes[index];
+        }
+
+    private:
+        friend class ArchetypeStorage;
+
+        std::vector<ComponentTypeID> m_Types;       // Ordenados por ID
+        ComponentMask m_Mask;
+        std::vector<int8_t> m_ColumnOf;             // Tipo -> columna
+        std::vector<size_t> m_ColumnOffsets;        // Columna -> offset en el chunk
+        std::vector<size_t> m_ColumnSizes;
+        size_t m_EntityOffset;
+        size_t m_ChunkBytes;
+        uint32_t m_Capacity;
+
+        std::vector<std::byte*> m_Chunks;
+        size_t m_Count;
+
+        std::unordered_map<ComponentTypeID, Archetype*> m_AddEdges;
+        std::unordered_map<ComponentTypeID, Archetype*> m_RemoveEdges;
+
+        /// Reserva una fila al final y guarda el handle; los datos quedan sin construir
+        uint32_t AllocateRow(uint64_t entity);
+
+        /// Destruye los datos de una fila y mueve la última a su lugar
+        /// @return Handle de la entidad movida, 0 si no se movió ninguna
+        uint64_t RemoveRow(uint32_t row);
+
+        uint64_t& EntityAt(uint32_t row) {
+            return reinterpret_cast<uint64_t*>(m_Chunks[row / m_Capacity] + m_EntityOffset)[row % m_Capacity];
+        }
+    };
+
+    /**
+     * @brief Lista de arquetipos que contienen un conjunto de tipos
+     *
+     * ArchetypeStorage la mantiene al día cuando crea arquetipos nuevos, así
+     * que una consulta no vuelve a buscar nada al iterar.
+     */
+    struct ArchetypeQueryCache {
+        ComponentMask mask;
+        std::vector<Archetype*> archetypes;
+    };
+
+    /**
+     * @brief Vista tipada sobre las entidades que tienen Ts...
+     *
+     * Itera chunk a chunk sobre arrays contiguos, sin llamadas virtuales ni
+     * locks. No se deben añadir ni quitar datos del mismo ArchetypeStorage
+     * mientras se itera; chunks distintos pueden procesarse en hilos
+     * distintos.
+     */
+    template<typename... Ts>
+    class ArchetypeQuery {
+    public:
+        explicit ArchetypeQuery(const ArchetypeQueryCache* cache = nullptr) : m_Cache(cache) {}
+
+        /// fn(size_t count, Ts*... columnas) una vez por chunk
+        template<typename Func>
+        void ForEachChunk(Func&& func) const {
+            for (Archetype* archetype : m_Cache->archetypes) {
+                const int columns[] = {archetype->GetColumn(ComponentTypeRegistry::GetID<Ts>())...};
+                for (size_t chunk = 0; chunk < archetype->GetChunkCount(); ++chunk) {
+                    CallChunk(func, *archetype, chunk, columns, std::index_sequence_for<Ts...>());
+                }
+            }
+        }
+
+        /// fn(Ts&... datos) por entidad
+        template<typename Func>
+        void ForEach(Func&& func) const {
+            ForEachChunk([&func](size_t count, Ts*... columns) {
+                for (size_t i = 0; i < count; ++i) {
+                    func(columns[i]...);
+                }
+            });
+        }
+
+        /// fn(uint64_t entidad, Ts&... datos) por entidad
+        template<typename Func>
+        void ForEachEntity(Func&& func) const {
+            for (Archetype* archetype : m_Cache->archetypes) {
+                const int columns[] = {archetype->GetColumn(ComponentTypeRegistry::GetID<Ts>())...};
+                for (size_t chunk = 0; chunk < archetype->GetChunkCount(); ++chunk) {
+                    const uint64_t* entities = archetype->GetEntities(chunk);
+                    const uint32_t count = archetype->GetChunkSize(chunk);
+                    for (uint32_t i = 0; i < count; ++i) {
+                        CallEntity(func, entities[i], *archetype, chunk, i, columns, std::index_sequence_for<Ts...>());
+                    }
+                }
+            }
+        }
+
+        /// Como ForEachChunk, pero solo los chunks [begin, end) numerados
+        /// de forma global entre todos los arquetipos
+        template<typename Func>
+        void ForEachChunkInRange(size_t begin, size_t end, Func&& func) const {
+            size_t base = 0;
+            for (Archetype* archetype : m_Cache->archetypes) {
+                if (base >= end) {
+                    break;
+                }
+
+                const size_t chunks = archetype->GetChunkCount();
+                if (base + chunks > begin) {
+                    const int columns[] = {archetype->GetColumn(ComponentTypeRegistry::GetID<Ts>())...};
+                    const size_t last = std::min(chunks, end - base);
+                    for (size_t chunk = begin > base ? begin - base : 0; chunk < last; ++chunk) {
+                        CallChunk(func, *archetype, chunk, columns, std::index_sequence_for<Ts...>());
+                    }
+                }
+                base += chunks;
+            }
+        }
+
+        size_t GetChunkCount() const {
+            size_t count = 0;
+            for (const Archetype* archetype : m_Cache->archetypes) {
+                count += archetype->GetChunkCount();
+            }
+            return count;
+        }
+
+        size_t Count() const {
+            size_t count = 0;
+            for (const Archetype* archetype : m_Cache->archetypes) {
+                count += archetype->GetEntityCount();
+            }
+            return count;
+        }
+
+        const std::vector<Archetype*>& GetArchetypes() const { return m_Cache->archetypes; }
+        bool IsValid() const { return m_Cache != nullptr; }
+
+    private:
+        const ArchetypeQueryCache* m_Cache;
+
+        template<typename Func, size_t... I>
+        static void CallChunk(Func& func, const Archetype& archetype, size_t chunk, const int* columns,
+                              std::index_sequence<I...>) {
+            func(static_cast<size_t>(archetype.GetChunkSize(chunk)),
+                 archetype.template GetColumnData<Ts>(chunk, columns[I])...);
+        }
+
+        template<typename Func, size_t... I>
+        static void CallEntity(Func& func, uint64_t entity, const Archetype& archetype, size_t chunk, uint32_t row,
+                               const int* columns, std::index_sequence<I...>) {
+            func(entity, archetype.template GetColumnData<Ts>(chunk, columns[I])[row]...);
+        }
+    };
+
+    /**
+     * @brief Almacenamiento de datos de entidades por arquetipos
+     *
+     * Cada entidad vive en el arquetipo de su conjunto de tipos. Añadir o
+     * quitar un tipo la mueve a otro arquetipo; los saltos entre arquetipos
+     * se recuerdan como aristas para no volver a buscarlos. Las consultas se
+     * guardan por firma y se actualizan al aparecer arquetipos nuevos.
+     *
+     * Los tipos de datos son structs normales (sin herencia ni virtuales).
+     * No es thread-safe: los cambios estructurales se hacen desde un hilo, y
+     * las consultas iteran sin locks.
+     */
+    class ArchetypeStorage {
+    public:
+        using EntityHandle = uint64_t;
+        static constexpr EntityHandle INVALID_ENTITY = 0;
+
+        ArchetypeStorage();
+        ~ArchetypeStorage();
+
+        ArchetypeStorage(const ArchetypeStorage&) = delete;
+        ArchetypeStorage& operator=(const ArchetypeStorage&) = delete;
+
+        // Entidades
+        EntityHandle Create();
+        bool Destroy(EntityHandle entity);
+        bool IsAlive(EntityHandle entity) const;
+        void Clear();
+        size_t GetEntityCount() const { return m_AliveCount; }
+        size_t GetArchetypeCount() const { return m_Archetypes.size(); }
+
+        // Datos
+        template<typename T, typename... Args>
+        T* Add(EntityHandle entity, Args&&... args);
+
+        template<typename T>
+        bool Remove(EntityHandle entity);
+
+        template<typename T>
+        T* Get(EntityHandle entity) const;
+
+        template<typename T>
+        bool Has(EntityHandle entity) const;
+
+        // Consultas
+        template<typename... Ts>
+        ArchetypeQuery<Ts...> Query();
+
+    private:
+        struct EntityRecord {
+            Archetype* archetype = nullptr;
+            uint32_t row = 0;
+            uint32_t generation = 1;
+        };
+
+        std::vector<EntityRecord> m_Records;
+        std::vector<uint32_t> m_FreeRecords;
+        size_t m_AliveCount;
+
+        std::unordered_map<ComponentMask, std::unique_ptr<Archetype>> m_Archetypes;
+        Archetype* m_EmptyArchetype;
+        std::unordered_map<ComponentMask, std::unique_ptr<ArchetypeQueryCache>> m_Queries;
+
+        const EntityRecord* FindRecord(EntityHandle entity) const;
+        Archetype* GetOrCreateArchetype(const std::vector<ComponentTypeID>& types);
+        Archetype* GetAddTarget(Archetype* source, ComponentTypeID type);
+        Archetype* GetRemoveTarget(Archetype* source, ComponentTypeID type);
+        void MoveEntity(EntityHandle entity, Archetype* target);
+        const ArchetypeQueryCache* GetQueryCache(const ComponentMask& mask);
+
+        static uint32_t IndexOf(EntityHandle entity) { return static_cast<uint32_t>(entity & 0xFFFFFFFFu); }
+        static uint32_t GenerationOf(EntityHandle entity) { return static_cast<uint32_t>(entity >> 32); }
+    };
+
+    // Template implementations
+    template<typename T, typename... Args>
+    T* ArchetypeStorage::Add(EntityHandle entity, Args&&... args) {
+        const EntityRecord* record = FindRecord(entity);
+        if (!record) {
+            return nullptr;
+        }
+
+        const ComponentTypeID type = ComponentTypeRegistry::GetID<T>();
+        const int existing = record->archetype->GetColumn(type);
+        if (existing >= 0) {
+            T* data = static_cast<T*>(record->archetype->GetData(record->row, existing));
+            *data = T(std::forward<Args>(args)...);
+            return data;
+        }
+
+        MoveEntity(entity, GetAddTarget(record->archetype, type));
+        record = FindRecord(entity);
+        void* data = record->archetype->GetData(record->row, record->archetype->GetColumn(type));
+        return new (data) T(std::forward<Args>(args)...);
+    }
+
+    template<typename T>
+    bool ArchetypeStorage::Remove(EntityHandle entity) {
+        const EntityRecord* record = FindRecord(entity);
+        const ComponentTypeID type = ComponentTypeRegistry::GetID<T>();
+        if (!record || record->archetype->GetColumn(type) < 0) {
+            return false;
+        }
+
+        MoveEntity(entity, GetRemoveTarget(record->archetype, type));
+        return true;
+    }
+
+    template<typename T>
+    T* ArchetypeStorage::Get(EntityHandle entity) const {
+        const EntityRecord* record = FindRecord(entity);
+        if (!record) {
+            return nullptr;
+        }
+
+        const int column = record->archetype->GetColumn(ComponentTypeRegistry::GetID<T>());
+        return column >= 0 ? static_cast<T*>(record->archetype->GetData(record->row, column)) : nullptr;
+    }
+
+    template<typename T>
+    bool ArchetypeStorage::Has(EntityHandle entity) const {
+        const EntityRecord* record = FindRecord(entity);
+        return record && record->archetype->GetColumn(ComponentTypeRegistry::GetID<T>()) >= 0;
+    }
+
+    template<typename... Ts>
+    ArchetypeQuery<Ts...> ArchetypeStorage::Query() {
+        ComponentMask mask;
+        (mask.set(ComponentTypeRegistry::GetID<Ts>()), ...);
+        return ArchetypeQuery<Ts...>(GetQueryCache(mask));
+    }
+
+}
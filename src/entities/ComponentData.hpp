@@ -0,0 +1,33 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace VoxelCraft {
+
+    /**
+     * @brief Datos de transformación guardados en ArchetypeStorage
+     *
+     * Equivale a TransformComponent sin herencia; TransformSystem rellena
+     * worldMatrix cada frame.
+     */
+    struct TransformData {
+        glm::vec3 position{0.0f};
+        glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
+        glm::vec3 scale{1.0f};
+        glm::mat4 worldMatrix{1.0f};
+    };
+
+    /**
+     * @brief Datos de movimiento para PhysicsSystem
+     */
+    struct PhysicsData {
+        glm::vec3 velocity{0.0f};
+        glm::vec3 acceleration{0.0f};   ///< Aceleración propia, además de la gravedad
+        float drag = 0.0f;              ///< Fracción de velocidad perdida por segundo
+        float groundHeight = 0.0f;      ///< Altura del suelo bajo la entidad
+        bool useGravity = true;
+        bool grounded = false;
+    };
+
+}
@@ -24,6 +24,7 @@ namespace VoxelCraft {
         , m_State(other.m_State)
         , m_Manager(other.m_Manager)
         , m_Components(std::move(other.m_Components))
+        , m_DataHandle(other.m_DataHandle)
     {
         other.m_State = EntityState::DESTROYED;
         other.m_Manager = nullptr;
@@ -43,6 +44,7 @@ namespace VoxelCraft {
             m_State = other.m_State;
             m_Manager = other.m_Manager;
             m_Components = std::move(other.m_Components);
+            m_DataHandle = other.m_DataHandle;
 
             other.m_State = EntityState::DESTROYED;
             other.m_Manager = nullptr;
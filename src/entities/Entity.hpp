@@ -10,6 +10,8 @@
 #include <mutex>
 #include <shared_mutex>
 
+#include "ArchetypeStorage.hpp"
+
 namespace VoxelCraft {
 
     class Component;
@@ -77,6 +79,10 @@ namespace VoxelCraft {
         EntityManager* GetManager() const { return m_Manager; }
         void SetManager(EntityManager* manager) { m_Manager = manager; }
 
+        // Fila de la entidad en el ArchetypeStorage del EntityManager
+        ArchetypeStorage::EntityHandle GetDataHandle() const { return m_DataHandle; }
+        void SetDataHandle(ArchetypeStorage::EntityHandle handle) { m_DataHandle = handle; }
+
         // Métodos de actualización
         virtual void Update(float deltaTime);
         virtual void FixedUpdate(float fixedDeltaTime);
@@ -98,6 +104,7 @@ namespace VoxelCraft {
         EntityState m_State;
         EntityManager* m_Manager;
         ComponentMap m_Components;
+        ArchetypeStorage::EntityHandle m_DataHandle = ArchetypeStorage::INVALID_ENTITY;
         mutable std::shared_mutex m_ComponentMutex;
 
         // Métodos auxiliares
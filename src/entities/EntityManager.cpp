@@ -22,6 +22,10 @@ namespace VoxelCraft {
         EntityID id = GenerateEntityID();
         auto entity = std::make_unique<Entity>(id, name, this);
         Entity* rawPtr = entity.get();
+        {
+            std::unique_lock componentLock(m_ComponentMutex);
+            rawPtr->SetDataHandle(m_Archetypes.Create());
+        }
 
         m_Entities[id] = std::move(entity);
         AddEntityToActive(rawPtr);
@@ -125,6 +129,10 @@ namespace VoxelCraft {
             if (entity) {
                 RemoveEntityFromActive(entity);
                 RemoveEntityFromInactive(entity);
+                {
+                    std::unique_lock componentLock(m_ComponentMutex);
+                    m_Archetypes.Destroy(entity->GetDataHandle());
+                }
                 m_Entities.erase(entity->GetID());
             }
         }
@@ -138,6 +146,8 @@ namespace VoxelCraft {
         // Limpiar entidades marcadas como destruidas
         for (auto it = m_Entities.begin(); it != m_Entities.end();) {
             if (it->second->IsDestroyed()) {
+                std::unique_lock componentLock(m_ComponentMutex);
+                m_Archetypes.Destroy(it->second->GetDataHandle());
                 it = m_Entities.erase(it);
             } else {
                 ++it;
@@ -245,32 +255,17 @@ namespace VoxelCraft {
 
     void EntityManager::UpdateSystems(float deltaTime) {
         std::shared_lock lock(m_SystemMutex);
-
-        for (const auto& system : m_Systems) {
-            if (system) {
-                system->Update(deltaTime);
-            }
-        }
+        m_Scheduler.Run(m_Systems, SystemPhase::UPDATE, deltaTime);
     }
 
     void EntityManager::FixedUpdateSystems(float fixedDeltaTime) {
         std::shared_lock lock(m_SystemMutex);
-
-        for (const auto& system : m_Systems) {
-            if (system) {
-                system->FixedUpdate(fixedDeltaTime);
-            }
-        }
+        m_Scheduler.Run(m_Systems, SystemPhase::FIXED_UPDATE, fixedDeltaTime);
     }
 
     void EntityManager::LateUpdateSystems(float deltaTime) {
         std::shared_lock lock(m_SystemMutex);
-
-        for (const auto& system : m_Systems) {
-            if (system) {
-                system->LateUpdate(deltaTime);
-            }
-        }
+        m_Scheduler.Run(m_Systems, SystemPhase::LATE_UPDATE, deltaTime);
     }
 
 }
\ No newline at end of file
@@ -10,6 +10,9 @@
 #include <atomic>
 #include <chrono>
 
+#include "ArchetypeStorage.hpp"
+#include "SystemScheduler.hpp"
+
 namespace VoxelCraft {
 
     class Entity;
@@ -53,6 +56,23 @@ namespace VoxelCraft {
         template<typename T>
         size_t GetComponentCount();
 
+        // Datos por arquetipos: structs planos en chunks contiguos. Query<Ts...>
+        // itera sin locks ni llamadas virtuales; los cambios estructurales
+        // (AddData/RemoveData/crear/destruir) se hacen fuera de esa iteración
+        ArchetypeStorage& GetArchetypes() { return m_Archetypes; }
+
+        template<typename T, typename... Args>
+        T* AddData(Entity* entity, Args&&... args);
+
+        template<typename T>
+        T* GetData(Entity* entity) const;
+
+        template<typename T>
+        bool RemoveData(Entity* entity);
+
+        template<typename... Ts>
+        ArchetypeQuery<Ts...> Query();
+
         // Gestión de sistemas
         template<typename T, typename... Args>
         T* AddSystem(Args&&... args);
@@ -66,6 +86,13 @@ namespace VoxelCraft {
         template<typename T>
         void RemoveSystem();
 
+        // Planificación: sin pool los sistemas corren en serie en el hilo que llama
+        void SetWorkerPool(WorkStealingPool* pool) { m_Scheduler.SetPool(pool); }
+        SystemScheduler& GetScheduler() { return m_Scheduler; }
+        const FrameTrace& GetLastFrameTrace(SystemPhase phase = SystemPhase::UPDATE) const {
+            return m_Scheduler.GetLastTrace(phase);
+        }
+
         // Actualización
         void Update(float deltaTime);
         void FixedUpdate(float fixedDeltaTime);
@@ -113,7 +140,9 @@ namespace VoxelCraft {
         EntityVector m_InactiveEntities;
         EntityVector m_PendingDestroyEntities;
         ComponentMap m_ComponentsByType;
+        ArchetypeStorage m_Archetypes;
         SystemVector m_Systems;
+        SystemScheduler m_Scheduler;
 
         // Thread safety
         mutable std::shared_mutex m_EntityMutex;
@@ -168,6 +197,29 @@ namespace VoxelCraft {
         return (it != m_ComponentsByType.end()) ? it->second.size() : 0;
     }
 
+    template<typename T, typename... Args>
+    T* EntityManager::AddData(Entity* entity, Args&&... args) {
+        std::unique_lock lock(m_ComponentMutex);
+        return m_Archetypes.Add<T>(entity->GetDataHandle(), std::forward<Args>(args)...);
+    }
+
+    template<typename T>
+    T* EntityManager::GetData(Entity* entity) const {
+        return m_Archetypes.Get<T>(entity->GetDataHandle());
+    }
+
+    template<typename T>
+    bool EntityManager::RemoveData(Entity* entity) {
+        std::unique_lock lock(m_ComponentMutex);
+        return m_Archetypes.Remove<T>(entity->GetDataHandle());
+    }
+
+    template<typename... Ts>
+    ArchetypeQuery<Ts...> EntityManager::Query() {
+        std::unique_lock lock(m_ComponentMutex);
+        return m_Archetypes.Query<Ts...>();
+    }
+
     template<typename T, typename... Args>
     T* EntityManager::AddSystem(Args&&... args) {
         std::unique_lock lock(m_SystemMutex);
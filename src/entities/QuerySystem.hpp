@@ -0,0 +1,80 @@
+#pragma once
+
+#include "System.hpp"
+#include "EntityManager.hpp"
+
+namespace VoxelCraft {
+
+    /**
+     * @brief Adaptador de System para consultas de ArchetypeStorage
+     *
+     * Se registra con EntityManager::AddSystem y recibe Update/FixedUpdate
+     * como cualquier otro sistema; cada llamada recorre los chunks que
+     * tienen Ts... y llama a UpdateChunk/FixedUpdateChunk una vez por chunk
+     * con punteros a las columnas. La llamada virtual es por chunk, no por
+     * entidad, y no se toma ningún lock durante la iteración.
+     *
+     * Por defecto declara escritura de todos los Ts; una subclase que solo
+     * lee alguno puede rehacer m_Access en su constructor. Con
+     * SetParallelChunks los chunks se reparten entre los workers del
+     * SystemScheduler, así que UpdateChunk debe poder ejecutarse a la vez
+     * sobre chunks distintos.
+     *
+     * Ejemplo:
+     *   class SpinSystem : public QuerySystem<TransformData> {
+     *       void UpdateChunk(float dt, size_t count, TransformData* transforms) override { ... }
+     *   };
+     */
+    template<typename... Ts>
+    class QuerySystem : public System {
+    public:
+        QuerySystem() {
+            (Writes<Ts>(), ...);
+        }
+
+        void Update(float deltaTime) override {
+            ForEachChunk([this, deltaTime](size_t count, Ts*... columns) {
+                UpdateChunk(deltaTime, count, columns...);
+            });
+        }
+
+        void FixedUpdate(float fixedDeltaTime) override {
+            ForEachChunk([this, fixedDeltaTime](size_t count, Ts*... columns) {
+                FixedUpdateChunk(fixedDeltaTime, count, columns...);
+            });
+        }
+
+        /// Reparte los chunks en tareas de chunksPerTask chunks
+        void SetParallelChunks(bool enabled, size_t chunksPerTask = 1) {
+            m_ParallelChunks = enabled;
+            m_ChunksPerTask = chunksPerTask;
+        }
+
+    protected:
+        virtual void UpdateChunk(float deltaTime, size_t count, Ts*... columns) {}
+        virtual void FixedUpdateChunk(float fixedDeltaTime, size_t count, Ts*... columns) {}
+
+        /// Consulta cacheada; se resuelve la primera vez que se usa
+        const ArchetypeQuery<Ts...>& GetQuery() {
+            if (!m_Query.IsValid()) {
+                m_Query = m_Manager->template Query<Ts...>();
+            }
+            return m_Query;
+        }
+
+    private:
+        ArchetypeQuery<Ts...> m_Query;
+        bool m_ParallelChunks = false;
+        size_t m_ChunksPerTask = 1;
+
+        template<typename Func>
+        void ForEachChunk(Func&& func) {
+            if (m_ParallelChunks) {
+                m_Manager->GetScheduler().ParallelForEachChunk(GetQuery(), func, m_ChunksPerTask);
+            } else {
+                GetQuery().ForEachChunk(func);
+            }
+        }
+    };
+
+}
@@ -1,5 +1,9 @@
 #include "System.hpp"
 #include "EntityManager.hpp"
+#include "ComponentData.hpp"
+#include "TransformComponent.hpp"
+#include "RenderComponent.hpp"
+#include <algorithm>
 #include <atomic>
 #include <sstream>
 
@@ -25,6 +29,7 @@ namespace VoxelCraft {
         , m_Name(std::move(other.m_Name))
         , m_Manager(other.m_Manager)
         , m_State(other.m_State)
+        , m_Access(std::move(other.m_Access))
     {
         other.m_State = SystemState::DESTROYED;
         other.m_Manager = nullptr;
@@ -38,6 +43,7 @@ namespace VoxelCraft {
             m_Name = std::move(other.m_Name);
             m_Manager = other.m_Manager;
             m_State = other.m_State;
+            m_Access = std::move(other.m_Access);
 
             other.m_State = SystemState::DESTROYED;
             other.m_Manager = nullptr;
@@ -90,9 +96,36 @@ namespace VoxelCraft {
         return s_NextID.fetch_add(1, std::memory_order_relaxed);
     }
 
+    void System::AddAccess(std::vector<std::type_index>& list, std::type_index type) {
+        m_Access.exclusive = false;
+        if (std::find(list.begin(), list.end(), type) == list.end()) {
+            list.push_back(type);
+        }
+    }
+
+    // Implementación de SystemAccess
+    bool SystemAccess::ConflictsWith(const SystemAccess& other) const {
+        if (exclusive || other.exclusive) {
+            return true;
+        }
+
+        auto overlaps = [](const std::vector<std::type_index>& a, const std::vector<std::type_index>& b) {
+            for (const std::type_index& type : a) {
+                if (std::find(b.begin(), b.end(), type) != b.end()) {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        return overlaps(writes, other.writes) || overlaps(writes, other.reads) || overlaps(reads, other.writes);
+    }
+
     // Implementación de TransformSystem
     TransformSystem::TransformSystem() {
         m_Name = "TransformSystem";
+        Writes<TransformData>();
+        Writes<TransformComponent>();
     }
 
     void TransformSystem::Update(float deltaTime) {
@@ -110,8 +143,23 @@ namespace VoxelCraft {
     }
 
     void TransformSystem::UpdateTransformMatrices() {
-        // Implementation for updating local transform matrices
-        // This would iterate through all entities with TransformComponent
+        if (!m_Manager) {
+            return;
+        }
+
+        // escala -> rotación -> traslación, igual que TransformComponent::GetModelMatrix
+        const auto query = m_Manager->Query<TransformData>();
+        m_Manager->GetScheduler().ParallelForEachChunk(query, [](size_t count, TransformData* transforms) {
+            for (size_t i = 0; i < count; ++i) {
+                TransformData& transform = transforms[i];
+                glm::mat4 matrix = glm::mat4_cast(transform.rotation);
+                matrix[0] *= transform.scale.x;
+                matrix[1] *= transform.scale.y;
+                matrix[2] *= transform.scale.z;
+                matrix[3] = glm::vec4(transform.position, 1.0f);
+                transform.worldMatrix = matrix;
+            }
+        });
     }
 
     void TransformSystem::HandleParenting() {
@@ -127,11 +175,13 @@ namespace VoxelCraft {
     // Implementación de PhysicsSystem
     PhysicsSystem::PhysicsSystem() {
         m_Name = "PhysicsSystem";
+        Writes<TransformData>();
+        Writes<PhysicsData>();
     }
 
     void PhysicsSystem::Update(float deltaTime) {
         // Handle physics updates
-        IntegrateVelocities();
+        IntegrateVelocities(deltaTime);
     }
 
     void PhysicsSystem::FixedUpdate(float fixedDeltaTime) {
@@ -145,9 +195,31 @@ namespace VoxelCraft {
                            m_Gravity.x, m_Gravity.y, m_Gravity.z);
     }
 
-    void PhysicsSystem::IntegrateVelocities() {
-        // Implementation for velocity integration
-        // Apply forces, update velocities and positions
+    void PhysicsSystem::IntegrateVelocities(float deltaTime) {
+        if (!m_Manager) {
+            return;
+        }
+
+        const glm::vec3 gravity = m_Gravity;
+        const auto query = m_Manager->Query<TransformData, PhysicsData>();
+        m_Manager->GetScheduler().ParallelForEachChunk(query,
+            [gravity, deltaTime](size_t count, TransformData* transforms, PhysicsData* bodies) {
+                for (size_t i = 0; i < count; ++i) {
+                    PhysicsData& body = bodies[i];
+                    glm::vec3& position = transforms[i].position;
+
+                    const glm::vec3 acceleration = body.useGravity ? body.acceleration + gravity : body.acceleration;
+                    body.velocity += acceleration * deltaTime;
+                    body.velocity *= std::max(0.0f, 1.0f - body.drag * deltaTime);
+                    position += body.velocity * deltaTime;
+
+                    body.grounded = position.y <= body.groundHeight;
+                    if (body.grounded) {
+                        position.y = body.groundHeight;
+                        body.velocity.y = std::max(body.velocity.y, 0.0f);
+                    }
+                }
+            });
     }
 
     void PhysicsSystem::ResolveCollisions() {
@@ -163,6 +235,9 @@ namespace VoxelCraft {
     // Implementación de RenderSystem
     RenderSystem::RenderSystem() {
         m_Name = "RenderSystem";
+        Reads<TransformData>();
+        Reads<TransformComponent>();
+        Reads<RenderComponent>();
     }
 
     void RenderSystem::Update(float deltaTime) {
@@ -203,6 +278,8 @@ namespace VoxelCraft {
     // Implementación de AISystem
     AISystem::AISystem() {
         m_Name = "AISystem";
+        Reads<TransformData>();
+        Writes<PhysicsData>();
     }
 
     void AISystem::Update(float deltaTime) {
@@ -247,6 +324,8 @@ namespace VoxelCraft {
     // Implementación de AudioSystem
     AudioSystem::AudioSystem() {
         m_Name = "AudioSystem";
+        Reads<TransformData>();
+        Reads<TransformComponent>();
     }
 
     void AudioSystem::Update(float deltaTime) {
@@ -287,6 +366,8 @@ namespace VoxelCraft {
     // Implementación de ParticleSystem
     ParticleSystem::ParticleSystem() {
         m_Name = "ParticleSystem";
+        // Solo toca sus propios pools de partículas
+        SetExclusive(false);
     }
 
     void ParticleSystem::Update(float deltaTime) {
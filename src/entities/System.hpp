@@ -5,11 +5,28 @@
 #include <vector>
 #include <chrono>
 #include <shared_mutex>
+#include <typeindex>
 
 namespace VoxelCraft {
 
     class EntityManager;
 
+    /**
+     * @brief Tipos de componente que un sistema lee y escribe
+     *
+     * SystemScheduler ordena dos sistemas solo si sus accesos chocan
+     * (escritura/escritura o lectura/escritura del mismo tipo). Un sistema
+     * sin declarar nada es exclusivo: no se solapa con ningún otro, que es
+     * como se ejecutaban todos antes del planificador.
+     */
+    struct SystemAccess {
+        std::vector<std::type_index> reads;
+        std::vector<std::type_index> writes;
+        bool exclusive = true;
+
+        bool ConflictsWith(const SystemAccess& other) const;
+    };
+
     /**
      * @brief Clase base para todos los sistemas del ECS
      */
@@ -42,6 +59,10 @@ namespace VoxelCraft {
         // Gestión del EntityManager
         void SetManager(EntityManager* manager) { m_Manager = manager; }
 
+        // Acceso declarado para el planificador
+        const SystemAccess& GetAccess() const { return m_Access; }
+        void SetExclusive(bool exclusive) { m_Access.exclusive = exclusive; }
+
         // Métodos de actualización
         virtual void Update(float deltaTime) {}
         virtual void FixedUpdate(float fixedDeltaTime) {}
@@ -63,9 +84,20 @@ namespace VoxelCraft {
         std::string m_Name;
         EntityManager* m_Manager;
         SystemState m_State;
+        SystemAccess m_Access;
+
+        // Declaran el acceso (normalmente en el constructor); quitan la exclusividad
+        template<typename T>
+        void Reads() { AddAccess(m_Access.reads, typeid(T)); }
+
+        template<typename T>
+        void Writes() { AddAccess(m_Access.writes, typeid(T)); }
 
         static SystemID GenerateID();
         static SystemID s_NextID;
+
+    private:
+        void AddAccess(std::vector<std::type_index>& list, std::type_index type);
     };
 
     // Sistemas específicos del juego
@@ -110,7 +142,7 @@ namespace VoxelCraft {
         glm::vec3 m_Gravity{0.0f, -9.81f, 0.0f};
         float m_FixedTimeStep{1.0f / 60.0f};
 
-        void IntegrateVelocities();
+        void IntegrateVelocities(float deltaTime);
         void ResolveCollisions();
         void ApplyConstraints();
     };
@@ -0,0 +1,387 @@
+#include "SystemScheduler.hpp"
+#include "System.hpp"
+#include "../core/WorkStealingPool.hpp"
+#include "../core/Profiler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+
+namespace VoxelCraft {
+
+    namespace {
+
+        using Clock = std::chrono::steady_clock;
+
+        // Contador de rangos del sistema que se está ejecutando en este hilo
+        thread_local uint32_t* t_RangeCounter = nullptr;
+
+        double MillisecondsSince(Clock::time_point start) {
+            return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+
+        const char* PhaseName(SystemPhase phase) {
+            switch (phase) {
+                case SystemPhase::UPDATE: return "UPDATE";
+                case SystemPhase::FIXED_UPDATE: return "FIXED_UPDATE";
+                case SystemPhase::LATE_UPDATE: return "LATE_UPDATE";
+            }
+            return "UNKNOWN";
+        }
+
+    }
+
+    struct SystemScheduler::RunState {
+        struct Node {
+            System* system = nullptr;
+            Profiler::ZoneID zone = 0;      // Zona del profiler con el nombre del sistema
+            std::vector<uint32_t> dependents;
+            uint32_t pending = 0;           // Dependencias aún sin terminar
+        };
+
+        std::vector<Node> nodes;
+        std::vector<SystemTraceEvent> events;
+        WorkStealingPool* pool = nullptr;   // nullptr: todo en el hilo que llama a Run
+        SystemPhase phase = SystemPhase::UPDATE;
+        float deltaTime = 0.0f;
+        Clock::time_point start;
+
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::deque<uint32_t> ready;
+        size_t completed = 0;
+        std::exception_ptr error;
+    };
+
+    struct SystemScheduler::ParallelForState {
+        const std::function<void(size_t, size_t)>* body = nullptr;
+        size_t count = 0;
+        size_t grain = 1;
+        size_t ranges = 0;
+        std::atomic<size_t> nextRange{0};
+        std::atomic<size_t> doneRanges{0};
+
+        std::mutex mutex;
+        std::condition_variable done;
+        std::exception_ptr error;
+    };
+
+    // Implementación de FrameTrace
+    std::vector<std::pair<uint32_t, uint32_t>> FrameTrace::GetConcurrentPairs() const {
+        std::vector<std::pair<uint32_t, uint32_t>> pairs;
+        for (uint32_t i = 0; i < events.size(); ++i) {
+            for (uint32_t j = i + 1; j < events.size(); ++j) {
+                if (events[i].startMs < events[j].endMs && events[j].startMs < events[i].endMs) {
+                    pairs.emplace_back(i, j);
+                }
+            }
+        }
+        return pairs;
+    }
+
+    std::string FrameTrace::ToString() const {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(3);
+        ss << "Frame " << frame << " " << PhaseName(phase) << ": wall " << wallMs << " ms, busy " << busyMs
+           << " ms (" << (wallMs > 0.0 ? busyMs / wallMs : 0.0) << "x), critical path " << criticalPathMs << " ms\n";
+
+        ss << "    " << std::left << std::setw(24) << "system" << std::right << std::setw(8) << "thread"
+           << std::setw(10) << "start" << std::setw(10) << "end" << std::setw(8) << "ranges" << "\n";
+        for (const SystemTraceEvent& event : events) {
+            ss << (event.onCriticalPath ? "  * " : "    ") << std::left << std::setw(24) << event.name
+               << std::right << std::setw(8) << (event.thread < 0 ? std::string("main") : std::to_string(event.thread))
+               << std::setw(10) << event.startMs << std::setw(10) << event.endMs
+               << std::setw(8) << event.parallelRanges << "\n";
+        }
+
+        const auto pairs = GetConcurrentPairs();
+        ss << "  concurrent:";
+        if (pairs.empty()) {
+            ss << " none";
+        }
+        for (const auto& pair : pairs) {
+            ss << " [" << events[pair.first].name << " || " << events[pair.second].name << "]";
+        }
+
+        ss << "\n  critical path:";
+        for (size_t i = 0; i < criticalPath.size(); ++i) {
+            ss << (i == 0 ? " " : " -> ") << events[criticalPath[i]].name;
+        }
+        ss << "\n";
+        return ss.str();
+    }
+
+    // Implementación de SystemScheduler
+    SystemScheduler::SystemScheduler()
+        : m_Pool(nullptr)
+        , m_Parallel(true)
+        , m_FrameCounter(0)
+    {
+    }
+
+    SystemScheduler::~SystemScheduler() = default;
+
+    void SystemScheduler::Run(const SystemList& systems, SystemPhase phase, float deltaTime) {
+        VOXELCRAFT_PROFILE_ZONE("SystemScheduler::Run");
+
+        auto state = std::make_shared<RunState>();
+        state->pool = IsParallel() ? m_Pool : nullptr;
+        state->phase = phase;
+        state->deltaTime = deltaTime;
+        BuildGraph(systems, *state);
+        m_FrameCounter++;
+
+        const size_t total = state->nodes.size();
+        size_t roots = 0;
+        for (uint32_t i = 0; i < total; ++i) {
+            if (state->nodes[i].pending == 0) {
+                state->ready.push_back(i);
+                roots++;
+            }
+        }
+
+        state->start = Clock::now();
+        if (state->pool) {
+            for (size_t i = 1; i < roots; ++i) {
+                state->pool->Submit([state]() { Drain(state); });
+            }
+        }
+
+        // El hilo que llama también ejecuta sistemas mientras espera
+        Drain(state);
+        {
+            std::unique_lock lock(state->mutex);
+            while (state->completed < total) {
+                state->wake.wait(lock, [&state, total]() {
+                    return !state->ready.empty() || state->completed == total;
+                });
+                if (!state->ready.empty()) {
+                    lock.unlock();
+                    Drain(state);
+                    lock.lock();
+                }
+            }
+        }
+
+        FinishTrace(*state, phase, MillisecondsSince(state->start));
+
+        if (state->error) {
+            std::rethrow_exception(state->error);
+        }
+    }
+
+    void SystemScheduler::ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body) {
+        if (count == 0) {
+            return;
+        }
+
+        grain = std::max<size_t>(1, grain);
+        const size_t ranges = (count + grain - 1) / grain;
+        if (!IsParallel() || ranges == 1) {
+            if (t_RangeCounter) {
+                (*t_RangeCounter)++;
+            }
+            body(0, count);
+            return;
+        }
+
+        if (t_RangeCounter) {
+            *t_RangeCounter += static_cast<uint32_t>(ranges);
+        }
+
+        VOXELCRAFT_PROFILE_ZONE("SystemScheduler::ParallelFor");
+
+        auto state = std::make_shared<ParallelForState>();
+        state->body = &body;
+        state->count = count;
+        state->grain = grain;
+        state->ranges = ranges;
+
+        // Los ayudantes que arrancan tarde no encuentran rangos y salen sin tocar body
+        const size_t helpers = std::min(m_Pool->GetThreadCount(), ranges - 1);
+        for (size_t i = 0; i < helpers; ++i) {
+            m_Pool->Submit([state]() { RunRanges(*state); });
+        }
+
+        RunRanges(*state);
+        {
+            std::unique_lock lock(state->mutex);
+            state->done.wait(lock, [&state]() {
+                return state->doneRanges.load(std::memory_order_acquire) == state->ranges;
+            });
+        }
+
+        if (state->error) {
+            std::rethrow_exception(state->error);
+        }
+    }
+
+    void SystemScheduler::BuildGraph(const SystemList& systems, RunState& state) {
+        const size_t count = systems.size();
+        state.nodes.resize(count);
+        state.events.resize(count);
+        m_Edges.clear();
+
+        // El registrado antes va primero en cada par que choca
+        for (uint32_t later = 0; later < count; ++later) {
+            System* system = systems[later].get();
+            state.nodes[later].system = system;
+            if (!system) {
+                continue;
+            }
+
+            state.events[later].name = system->GetName();
+            state.events[later].systemID = system->GetID();
+#if defined(VOXELCRAFT_ENABLE_PROFILING)
+            state.nodes[later].zone = Profiler::RegisterDynamicZone(system->GetName());
+#endif
+
+            for (uint32_t earlier = 0; earlier < later; ++earlier) {
+                const System* other = state.nodes[earlier].system;
+                if (other && other->GetAccess().ConflictsWith(system->GetAccess())) {
+                    state.nodes[earlier].dependents.push_back(later);
+                    state.nodes[later].pending++;
+                    state.events[later].dependencies.push_back(earlier);
+                    m_Edges.emplace_back(earlier, later);
+                }
+            }
+        }
+    }
+
+    void SystemScheduler::FinishTrace(RunState& state, SystemPhase phase, double wallMs) {
+        FrameTrace& trace = m_Traces[static_cast<size_t>(phase)];
+        trace.phase = phase;
+        trace.frame = m_FrameCounter;
+        trace.wallMs = wallMs;
+        trace.busyMs = 0.0;
+        trace.events = std::move(state.events);
+
+        // Camino más largo del DAG; las aristas van siempre de índice menor a mayor
+        const size_t count = trace.events.size();
+        constexpr size_t NONE = static_cast<size_t>(-1);
+        std::vector<double> finish(count, 0.0);
+        std::vector<size_t> previous(count, NONE);
+        size_t last = NONE;
+        for (size_t i = 0; i < count; ++i) {
+            const SystemTraceEvent& event = trace.events[i];
+            const double duration = event.endMs - event.startMs;
+            trace.busyMs += duration;
+
+            for (uint32_t dependency : event.dependencies) {
+                if (finish[dependency] > finish[i]) {
+                    finish[i] = finish[dependency];
+                    previous[i] = dependency;
+                }
+            }
+            finish[i] += duration;
+
+            if (last == NONE || finish[i] > finish[last]) {
+                last = i;
+            }
+        }
+
+        trace.criticalPath.clear();
+        trace.criticalPathMs = last != NONE ? finish[last] : 0.0;
+        for (size_t node = last; node != NONE; node = previous[node]) {
+            trace.events[node].onCriticalPath = true;
+            trace.criticalPath.push_back(static_cast<uint32_t>(node));
+        }
+        std::reverse(trace.criticalPath.begin(), trace.criticalPath.end());
+    }
+
+    void SystemScheduler::Drain(const std::shared_ptr<RunState>& state) {
+        for (;;) {
+            uint32_t index;
+            {
+                std::lock_guard lock(state->mutex);
+                if (state->ready.empty()) {
+                    return;
+                }
+                index = state->ready.front();
+                state->ready.pop_front();
+            }
+
+            RunNode(*state, index);
+
+            size_t released = 0;
+            {
+                std::lock_guard lock(state->mutex);
+                for (uint32_t dependent : state->nodes[index].dependents) {
+                    if (--state->nodes[dependent].pending == 0) {
+                        state->ready.push_back(dependent);
+                        released++;
+                    }
+                }
+                state->completed++;
+            }
+            state->wake.notify_all();
+
+            // Este hilo sigue con uno de los liberados; los demás van al pool
+            if (state->pool) {
+                for (size_t i = 1; i < released; ++i) {
+                    state->pool->Submit([state]() { Drain(state); });
+                }
+            }
+        }
+    }
+
+    void SystemScheduler::RunNode(RunState& state, uint32_t index) {
+        System* system = state.nodes[index].system;
+        SystemTraceEvent& event = state.events[index];
+        event.thread = state.pool ? state.pool->GetCurrentWorkerIndex() : -1;
+
+        uint32_t* previousCounter = t_RangeCounter;
+        t_RangeCounter = &event.parallelRanges;
+        event.startMs = MillisecondsSince(state.start);
+
+        if (system) {
+            VOXELCRAFT_PROFILE_ZONE_ID(state.nodes[index].zone);
+            try {
+                switch (state.phase) {
+                    case SystemPhase::UPDATE: system->Update(state.deltaTime); break;
+                    case SystemPhase::FIXED_UPDATE: system->FixedUpdate(state.deltaTime); break;
+                    case SystemPhase::LATE_UPDATE: system->LateUpdate(state.deltaTime); break;
+                }
+            } catch (...) {
+                // Se relanza en Run cuando el frame termina; los dependientes se ejecutan igual
+                std::lock_guard lock(state.mutex);
+                if (!state.error) {
+                    state.error = std::current_exception();
+                }
+            }
+        }
+
+        event.endMs = MillisecondsSince(state.start);
+        t_RangeCounter = previousCounter;
+    }
+
+    void SystemScheduler::RunRanges(ParallelForState& state) {
+        for (;;) {
+            const size_t range = state.nextRange.fetch_add(1, std::memory_order_relaxed);
+            if (range >= state.ranges) {
+                return;
+            }
+
+            const size_t begin = range * state.grain;
+            try {
+                (*state.body)(begin, std::min(state.count, begin + state.grain));
+            } catch (...) {
+                std::lock_guard lock(state.mutex);
+                if (!state.error) {
+                    state.error = std::current_exception();
+                }
+            }
+
+            if (state.doneRanges.fetch_add(1, std::memory_order_acq_rel) + 1 == state.ranges) {
+                std::lock_guard lock(state.mutex);
+                state.done.notify_all();
+            }
+        }
+    }
+
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ArchetypeStorage.hpp"
+
+namespace VoxelCraft {
+
+    class System;
+    class WorkStealingPool;
+
+    enum class SystemPhase {
+        UPDATE,
+        FIXED_UPDATE,
+        LATE_UPDATE
+    };
+
+    /**
+     * @brief Ejecución de un sistema dentro de un frame
+     */
+    struct SystemTraceEvent {
+        std::string name;
+        uint32_t systemID = 0;
+        int thread = -1;                    ///< Worker del pool, -1 si fue el hilo que llamó a Run
+        double startMs = 0.0;               ///< Relativo al inicio del frame
+        double endMs = 0.0;
+        uint32_t parallelRanges = 0;        ///< Rangos de ParallelFor lanzados desde el sistema
+        bool onCriticalPath = false;
+        std::vector<uint32_t> dependencies; ///< Eventos que tenían que terminar antes
+    };
+
+    /**
+     * @brief Traza de una fase: qué sistemas corrieron, dónde y en paralelo con quién
+     *
+     * El camino crítico es la cadena de dependencias con mayor suma de
+     * duraciones; ningún número de hilos baja el frame de criticalPathMs.
+     */
+    struct FrameTrace {
+        SystemPhase phase = SystemPhase::UPDATE;
+        uint64_t frame = 0;
+        double wallMs = 0.0;
+        double busyMs = 0.0;                ///< Suma de las duraciones de los sistemas
+        double criticalPathMs = 0.0;
+        std::vector<uint32_t> criticalPath; ///< Índices en events, en orden de ejecución
+        std::vector<SystemTraceEvent> events; ///< En orden de registro de los sistemas
+
+        /// Pares de eventos cuyos intervalos se solaparon
+        std::vector<std::pair<uint32_t, uint32_t>> GetConcurrentPairs() const;
+
+        /// Tabla legible con el timeline y el camino crítico
+        std::string ToString() const;
+    };
+
+    /**
+     * @brief Ejecuta los sistemas de una fase como un grafo de dependencias
+     *
+     * Cada frame se construye el DAG a partir de SystemAccess: si dos
+     * sistemas chocan, el registrado antes va primero; si no chocan pueden
+     * correr a la vez en el WorkStealingPool. Sin pool (o con SetParallel
+     * false) todo corre en el hilo que llama, en un orden topológico.
+     *
+     * Dentro de un sistema, ParallelFor/ParallelForEachChunk reparten trabajo
+     * en el mismo pool; el hilo que llama también ejecuta rangos, así que no
+     * se bloquea aunque todos los workers estén ocupados con sistemas.
+     *
+     * Durante Run no se deben hacer cambios estructurales (crear/destruir
+     * entidades, AddData/RemoveData); ArchetypeStorage no los sincroniza.
+     */
+    class SystemScheduler {
+    public:
+        using SystemList = std::vector<std::unique_ptr<System>>;
+
+        SystemScheduler();
+        ~SystemScheduler();
+
+        SystemScheduler(const SystemScheduler&) = delete;
+        SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+        // Configuración
+        void SetPool(WorkStealingPool* pool) { m_Pool = pool; }
+        WorkStealingPool* GetPool() const { return m_Pool; }
+        void SetParallel(bool enabled) { m_Parallel = enabled; }
+        bool IsParallel() const { return m_Parallel && m_Pool != nullptr; }
+
+        /// Llama a Update/FixedUpdate/LateUpdate de cada sistema respetando el DAG
+        void Run(const SystemList& systems, SystemPhase phase, float deltaTime);
+
+        /// body(begin, end) sobre [0, count) en rangos de grain elementos
+        void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+        /// func(size_t count, Ts*... columnas) por chunk, repartiendo chunksPerTask chunks por tarea
+        template<typename... Ts, typename Func>
+        void ParallelForEachChunk(const ArchetypeQuery<Ts...>& query, Func&& func, size_t chunksPerTask = 1);
+
+        // Inspección
+        const FrameTrace& GetLastTrace(SystemPhase phase) const { return m_Traces[static_cast<size_t>(phase)]; }
+
+        /// Aristas (antes, después) del último grafo, por posición en la lista de sistemas
+        const std::vector<std::pair<uint32_t, uint32_t>>& GetEdges() const { return m_Edges; }
+
+    private:
+        struct RunState;
+        struct ParallelForState;
+
+        WorkStealingPool* m_Pool;
+        bool m_Parallel;
+        uint64_t m_FrameCounter;
+
+        std::vector<std::pair<uint32_t, uint32_t>> m_Edges;
+        std::array<FrameTrace, 3> m_Traces;
+
+        void BuildGraph(const SystemList& systems, RunState& state);
+        void FinishTrace(RunState& state, SystemPhase phase, double wallMs);
+
+        static void Drain(const std::shared_ptr<RunState>& state);
+        static void RunNode(RunState& state, uint32_t index);
+        static void RunRanges(ParallelForState& state);
+    };
+
+    // Template implementations
+    template<typename... Ts, typename Func>
+    void SystemScheduler::ParallelForEachChunk(const ArchetypeQuery<Ts...>& query, Func&& func, size_t chunksPerTask) {
+        ParallelFor(query.GetChunkCount(), chunksPerTask, [&query, &func](size_t begin, size_t end) {
+            query.ForEachChunkInRange(begin, end, func);
+        });
+    }
+
+}
@@ -41,6 +41,10 @@ namespace VoxelCraft {
 		}
 
 		m_frameActive = true;
+		m_stats.cullingTests = 0;
+		m_stats.cullingPassed = 0;
+		m_stats.occlusionTests = 0;
+		m_stats.occlusionPassed = 0;
 		return true;
 	}
 
@@ -65,6 +69,14 @@ namespace VoxelCraft {
 		ExecuteRenderCommands();
 	}
 
+	void Renderer::RecordCulling(uint32_t tests, uint32_t passed, uint32_t occlusionTests, uint32_t occlusionPassed)
+	{
+		m_stats.cullingTests += tests;
+		m_stats.cullingPassed += passed;
+		m_stats.occlusionTests += occlusionTests;
+		m_stats.occlusionPassed += occlusionPassed;
+	}
+
 	size_t Renderer::GetMemoryUsage() const
 	{
 		return sizeof(Renderer);
@@ -312,6 +312,13 @@ namespace VoxelCraft {
 		 */
 		const RendererStats& GetStats() const { return m_stats; }
 
+		/**
+		 * @brief Add CPU culling results of this frame (e.g. ChunkSystemStats culling counters)
+		 *
+		 * The culling and occlusion counters are reset by BeginFrame.
+		 */
+		void RecordCulling(uint32_t tests, uint32_t passed, uint32_t occlusionTests, uint32_t occlusionPassed);
+
 		/**
 		 * @brief Get renderer configuration
 		 */
@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <random>
 #include <cmath>
+#include <limits>
 
 namespace VoxelCraft {
 
@@ -43,6 +44,7 @@ bool MobManager::Initialize(World* world) {
 void MobManager::Shutdown() {
     ClearAllMobs();
     ClearAllMobSpawners();
+    m_playerIndex.Clear();
     m_spawnRules.clear();
     m_mobPacks.clear();
     m_mobFactories.clear();
@@ -53,12 +55,14 @@ void MobManager::Shutdown() {
 void MobManager::Update(float deltaTime) {
     if (!m_initialized || !m_world) return;
 
-    // Update all mobs
+    // Update all mobs and re-index the ones that moved
     for (auto it = m_mobs.begin(); it != m_mobs.end();) {
         if (it->second) {
             it->second->Update(deltaTime);
+            m_mobIndex.Update(it->first, it->second->GetPosition());
             ++it;
         } else {
+            m_mobIndex.Remove(it->first);
             it = m_mobs.erase(it);
         }
     }
@@ -114,6 +118,7 @@ std::shared_ptr<Mob> MobManager::SpawnMob(MobType type, const glm::vec3& positio
 
     // Add to active mobs
     m_mobs[mobId] = mob;
+    m_mobIndex.Insert(mobId, mob->GetPosition());
 
     // Update statistics
     m_stats.totalMobsSpawned++;
@@ -140,6 +145,7 @@ bool MobManager::RemoveMob(uint32_t mobId) {
     }
 
     m_mobs.erase(it);
+    m_mobIndex.Remove(mobId);
     return true;
 }
 
@@ -160,18 +166,20 @@ std::vector<std::shared_ptr<Mob>> MobManager::GetAllMobs() const {
 }
 
 std::vector<std::shared_ptr<Mob>> MobManager::GetMobsInArea(const glm::vec3& center, float radius) const {
-    std::vector<std::shared_ptr<Mob>> mobsInArea;
+    std::vector<uint32_t> mobIds;
+    m_mobIndex.QueryRadius(center, radius, mobIds);
+    return ResolveMobs(mobIds);
+}
 
-    for (const auto& pair : m_mobs) {
-        if (pair.second) {
-            float distance = glm::distance(center, pair.second->GetPosition());
-            if (distance <= radius) {
-                mobsInArea.push_back(pair.second);
-            }
-        }
-    }
+std::vector<std::shared_ptr<Mob>> MobManager::GetMobsInBox(const glm::vec3& min, const glm::vec3& max) const {
+    std::vector<uint32_t> mobIds;
+    m_mobIndex.QueryAABB(min, max, mobIds);
+    return ResolveMobs(mobIds);
+}
 
-    return mobsInArea;
+void MobManager::GetMobsInAreas(const std::vector<glm::vec3>& centers, float radius,
+                                MobSpatialIndex::BatchResult& result) const {
+    m_mobIndex.QueryRadiusBatch(centers, radius, result);
 }
 
 std::vector<std::shared_ptr<Mob>> MobManager::GetMobsByType(MobType type) const {
@@ -187,20 +195,30 @@ std::vector<std::shared_ptr<Mob>> MobManager::GetMobsByType(MobType type) const
 }
 
 std::shared_ptr<Mob> MobManager::GetNearestMob(const glm::vec3& position, float maxDistance) const {
-    std::shared_ptr<Mob> nearest = nullptr;
-    float nearestDistance = maxDistance * maxDistance;
+    const uint32_t mobId = m_mobIndex.FindNearest(position, maxDistance);
+    return mobId != MobSpatialIndex::INVALID_ID ? GetMob(mobId) : nullptr;
+}
 
-    for (const auto& pair : m_mobs) {
-        if (pair.second) {
-            float distanceSquared = glm::distance2(position, pair.second->GetPosition());
-            if (distanceSquared < nearestDistance) {
-                nearestDistance = distanceSquared;
-                nearest = pair.second;
-            }
-        }
+std::vector<std::shared_ptr<Mob>> MobManager::GetNearestMobs(const glm::vec3& position, size_t count,
+                                                           float maxDistance) const {
+    std::vector<uint32_t> mobIds;
+    m_mobIndex.FindKNearest(position, count, maxDistance, mobIds);
+    return ResolveMobs(mobIds);
+}
+
+void MobManager::RefreshMobPosition(uint32_t mobId) {
+    auto it = m_mobs.find(mobId);
+    if (it != m_mobs.end() && it->second) {
+        m_mobIndex.Update(mobId, it->second->GetPosition());
     }
+}
+
+void MobManager::UpdatePlayerPosition(uint32_t playerId, const glm::vec3& position) {
+    m_playerIndex.Update(playerId, position);
+}
 
-    return nearest;
+void MobManager::RemovePlayer(uint32_t playerId) {
+    m_playerIndex.Remove(playerId);
 }
 
 size_t MobManager::GetMobCount(MobType type) const {
@@ -348,6 +366,7 @@ std::vector<std::shared_ptr<Mob>> MobManager::SpawnMobPack(size_t packType, cons
 
 void MobManager::ClearAllMobs() {
     m_mobs.clear();
+    m_mobIndex.Clear();
 }
 
 void MobManager::ClearAllMobSpawners() {
@@ -487,9 +506,9 @@ bool MobManager::ShouldSpawnerActivate(const MobSpawner& spawner) const {
     float distanceToPlayer = GetDistanceToNearestPlayer(glm::vec3(spawner.position));
     if (distanceToPlayer > spawner.requiredPlayerRange) return false;
 
-    // Check how many entities are nearby
-    auto nearbyMobs = GetMobsInArea(glm::vec3(spawner.position), 8.0f);
-    if (nearbyMobs.size() >= static_cast<size_t>(spawner.maxNearbyEntities)) return false;
+    // Check how many entities are nearby (stops counting at the limit)
+    const size_t limit = static_cast<size_t>(std::max(spawner.maxNearbyEntities, 0));
+    if (m_mobIndex.CountInRadius(glm::vec3(spawner.position), 8.0f, limit) >= limit) return false;
 
     return true;
 }
@@ -536,14 +555,31 @@ bool MobManager::IsPositionValid(const glm::vec3& position) const {
 
 bool MobManager::IsAreaClear(const glm::vec3& position, float radius) const {
     // Check if the area around the position is clear of other mobs
-    auto nearbyMobs = GetMobsInArea(position, radius);
-    return nearbyMobs.empty();
+    return m_mobIndex.CountInRadius(position, radius, 1) == 0;
 }
 
 float MobManager::GetDistanceToNearestPlayer(const glm::vec3& position) const {
-    // This would calculate distance to the nearest player
-    // For now, return a default distance
-    return 50.0f;
+    // No tracked player: infinitely far, so nothing passes a max distance check
+    float distanceSquared = 0.0f;
+    if (m_playerIndex.FindNearest(position, std::numeric_limits<float>::infinity(), &distanceSquared) ==
+        MobSpatialIndex::INVALID_ID) {
+        return std::numeric_limits<float>::infinity();
+    }
+    return std::sqrt(distanceSquared);
+}
+
+std::vector<std::shared_ptr<Mob>> MobManager::ResolveMobs(const std::vector<uint32_t>& mobIds) const {
+    std::vector<std::shared_ptr<Mob>> mobs;
+    mobs.reserve(mobIds.size());
+
+    for (uint32_t mobId : mobIds) {
+        auto it = m_mobs.find(mobId);
+        if (it != m_mobs.end() && it->second) {
+            mobs.push_back(it->second);
+        }
+    }
+
+    return mobs;
 }
 
 void MobManager::RegisterMobFactories() {
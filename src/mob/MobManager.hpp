@@ -17,6 +17,7 @@
 #include <glm/glm.hpp>
 
 #include "Mob.hpp"
+#include "MobSpatialIndex.hpp"
 
 namespace VoxelCraft {
 
@@ -183,6 +184,23 @@ namespace VoxelCraft {
          */
         std::vector<std::shared_ptr<Mob>> GetMobsInArea(const glm::vec3& center, float radius) const;
 
+        /**
+         * @brief Get mobs inside an axis-aligned box
+         * @param min Box minimum corner
+         * @param max Box maximum corner
+         * @return Vector of mobs in the box
+         */
+        std::vector<std::shared_ptr<Mob>> GetMobsInBox(const glm::vec3& min, const glm::vec3& max) const;
+
+        /**
+         * @brief Get mobs in area around many centers at once
+         * @param centers Query centers
+         * @param radius Search radius shared by all queries
+         * @param result Mob IDs per center, in the order of centers
+         */
+        void GetMobsInAreas(const std::vector<glm::vec3>& centers, float radius,
+                            MobSpatialIndex::BatchResult& result) const;
+
         /**
          * @brief Get mobs by type
          * @param type Mob type
@@ -198,6 +216,41 @@ namespace VoxelCraft {
          */
         std::shared_ptr<Mob> GetNearestMob(const glm::vec3& position, float maxDistance = 32.0f) const;
 
+        /**
+         * @brief Get the nearest mobs to position
+         * @param position Search position
+         * @param count Maximum number of mobs
+         * @param maxDistance Maximum search distance
+         * @return Mobs sorted by distance, nearest first
+         */
+        std::vector<std::shared_ptr<Mob>> GetNearestMobs(const glm::vec3& position, size_t count,
+                                                       float maxDistance = 32.0f) const;
+
+        /**
+         * @brief Re-index a mob moved outside of Update (teleport, knockback from another system)
+         * @param mobId Mob ID
+         */
+        void RefreshMobPosition(uint32_t mobId);
+
+        /**
+         * @brief Set the position of a player for spawn distance checks
+         * @param playerId Player ID
+         * @param position Player position
+         */
+        void UpdatePlayerPosition(uint32_t playerId, const glm::vec3& position);
+
+        /**
+         * @brief Stop tracking a player
+         * @param playerId Player ID
+         */
+        void RemovePlayer(uint32_t playerId);
+
+        /**
+         * @brief Get the spatial index of mob positions
+         * @return Index as of the last Update or spawn
+         */
+        const MobSpatialIndex& GetMobIndex() const { return m_mobIndex; }
+
         /**
          * @brief Get mob count by type
          * @param type Mob type
@@ -325,6 +378,8 @@ namespace VoxelCraft {
 
         World* m_world;
         std::unordered_map<uint32_t, std::shared_ptr<Mob>> m_mobs;
+        MobSpatialIndex m_mobIndex;     ///< Mob positions, refreshed after each mob update
+        MobSpatialIndex m_playerIndex;  ///< Player positions fed by UpdatePlayerPosition
         std::unordered_map<glm::ivec3, MobSpawner> m_spawners;
         std::unordered_map<MobType, MobSpawnRules> m_spawnRules;
         std::vector<MobPack> m_mobPacks;
@@ -360,6 +415,7 @@ namespace VoxelCraft {
         bool IsPositionValid(const glm::vec3& position) const;
         bool IsAreaClear(const glm::vec3& position, float radius) const;
         float GetDistanceToNearestPlayer(const glm::vec3& position) const;
+        std::vector<std::shared_ptr<Mob>> ResolveMobs(const std::vector<uint32_t>& mobIds) const;
 
         // Factory functions for creating specific mobs
         static std::shared_ptr<Mob> CreateCreeper(const glm::vec3& position, World* world);
@@ -0,0 +1,292 @@
+/**
+ * @file MobSpatialIndex.cpp
+ * @brief VoxelCraft Mob Spatial Index Implementation
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#include "MobSpatialIndex.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+
+namespace VoxelCraft {
+
+MobSpatialIndex::MobSpatialIndex(float cellSize)
+    : m_cellSize(cellSize > 0.0f ? cellSize : 16.0f)
+    , m_invCellSize(1.0f / m_cellSize)
+    , m_minCell(0)
+    , m_maxCell(-1)
+{
+}
+
+void MobSpatialIndex::Insert(uint32_t id, const glm::vec3& position) {
+    Update(id, position);
+}
+
+void MobSpatialIndex::Update(uint32_t id, const glm::vec3& position) {
+    const glm::ivec2 cell = CellOf(position);
+    const uint64_t key = KeyOf(cell);
+
+    auto it = m_locations.find(id);
+    if (it != m_locations.end()) {
+        if (it->second.cell == key) {
+            m_cells[key].items[it->second.index].position = position;
+            return;
+        }
+        RemoveFromCell(it->second);
+    } else {
+        it = m_locations.emplace(id, Location{}).first;
+    }
+
+    if (m_cells.empty()) {
+        m_minCell = cell;
+        m_maxCell = cell;
+    } else {
+        m_minCell = glm::min(m_minCell, cell);
+        m_maxCell = glm::max(m_maxCell, cell);
+    }
+
+    std::vector<Item>& items = m_cells[key].items;
+    it->second.cell = key;
+    it->second.index = static_cast<uint32_t>(items.size());
+    items.push_back({position, id});
+}
+
+bool MobSpatialIndex::Remove(uint32_t id) {
+    auto it = m_locations.find(id);
+    if (it == m_locations.end()) {
+        return false;
+    }
+
+    RemoveFromCell(it->second);
+    m_locations.erase(it);
+    return true;
+}
+
+void MobSpatialIndex::Clear() {
+    m_cells.clear();
+    m_locations.clear();
+    m_minCell = glm::ivec2(0);
+    m_maxCell = glm::ivec2(-1);
+}
+
+void MobSpatialIndex::QueryRadius(const glm::vec3& center, float radius, std::vector<uint32_t>& out) const {
+    ForEachInRadius(center, radius, [&out](uint32_t id, const glm::vec3&) {
+        out.push_back(id);
+    });
+}
+
+void MobSpatialIndex::QueryAABB(const glm::vec3& min, const glm::vec3& max, std::vector<uint32_t>& out) const {
+    ForEachCell(CellOf(min), CellOf(max), [&](const glm::ivec2&, const Cell& data) {
+        for (const Item& item : data.items) {
+            const glm::vec3& p = item.position;
+            if (p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y && p.z >= min.z && p.z <= max.z) {
+                out.push_back(item.id);
+            }
+        }
+        return true;
+    });
+}
+
+void MobSpatialIndex::FindKNearest(const glm::vec3& center, size_t k, float maxDistance,
+                                   std::vector<uint32_t>& out) const {
+    if (k == 0 || !(maxDistance > 0.0f)) {
+        return;
+    }
+
+    // Max-heap of the k best (distance², id) so far; reused to keep queries allocation-free
+    thread_local std::vector<std::pair<float, uint32_t>> best;
+    best.clear();
+    const float limitSquared = maxDistance * maxDistance;
+
+    ForEachRingCell(center, [&](const Cell& data) {
+        for (const Item& item : data.items) {
+            const glm::vec3 delta = item.position - center;
+            const float distanceSquared = glm::dot(delta, delta);
+            if (distanceSquared >= limitSquared) {
+                continue;
+            }
+            const std::pair<float, uint32_t> candidate(distanceSquared, item.id);
+            if (best.size() < k) {
+                best.push_back(candidate);
+                std::push_heap(best.begin(), best.end());
+            } else if (candidate < best.front()) {
+                std::pop_heap(best.begin(), best.end());
+                best.back() = candidate;
+                std::push_heap(best.begin(), best.end());
+            }
+        }
+    }, [&](float gapSquared) {
+        return gapSquared >= limitSquared || (best.size() == k && gapSquared > best.front().first);
+    });
+
+    std::sort_heap(best.begin(), best.end());
+    for (const auto& entry : best) {
+        out.push_back(entry.second);
+    }
+}
+
+uint32_t MobSpatialIndex::FindNearest(const glm::vec3& center, float maxDistance, float* distanceSquared) const {
+    if (!(maxDistance > 0.0f)) {
+        return INVALID_ID;
+    }
+
+    const float limitSquared = maxDistance * maxDistance;
+    std::pair<float, uint32_t> best(limitSquared, INVALID_ID);
+
+    ForEachRingCell(center, [&](const Cell& data) {
+        for (const Item& item : data.items) {
+            const glm::vec3 delta = item.position - center;
+            const std::pair<float, uint32_t> candidate(glm::dot(delta, delta), item.id);
+            if (candidate.first < limitSquared && candidate < best) {
+                best = candidate;
+            }
+        }
+    }, [&](float gapSquared) {
+        return gapSquared >= limitSquared || (best.second != INVALID_ID && gapSquared > best.first);
+    });
+
+    if (best.second != INVALID_ID && distanceSquared) {
+        *distanceSquared = best.first;
+    }
+    return best.second;
+}
+
+size_t MobSpatialIndex::CountInRadius(const glm::vec3& center, float radius, size_t limit) const {
+    size_t count = 0;
+    if (radius < 0.0f || limit == 0) {
+        return count;
+    }
+
+    const float radiusSquared = radius * radius;
+    const glm::vec3 extent(radius);
+    ForEachCell(CellOf(center - extent), CellOf(center + extent), [&](const glm::ivec2& cell, const Cell& data) {
+        if (CellDistanceSquared(cell, center) > radiusSquared) {
+            return true;
+        }
+        for (const Item& item : data.items) {
+            const glm::vec3 delta = item.position - center;
+            if (glm::dot(delta, delta) <= radiusSquared && ++count >= limit) {
+                return false;
+            }
+        }
+        return true;
+    });
+    return count;
+}
+
+void MobSpatialIndex::QueryRadiusBatch(const std::vector<glm::vec3>& centers, float radius,
+                                       BatchResult& result) const {
+    result.offsets.assign(centers.size() + 1, 0);
+    result.ids.clear();
+    if (centers.empty() || radius < 0.0f) {
+        return;
+    }
+
+    // Group queries by cell
+    std::vector<std::pair<uint64_t, uint32_t>> order(centers.size());
+    for (uint32_t i = 0; i < centers.size(); ++i) {
+        order[i] = {KeyOf(CellOf(centers[i])), i};
+    }
+    std::sort(order.begin(), order.end());
+
+    const float radiusSquared = radius * radius;
+    const int reach = static_cast<int>(std::ceil(radius * m_invCellSize));
+
+    // Results in grouped order first, then scattered back to query order
+    std::vector<uint32_t> groupedIds;
+    std::vector<uint32_t> counts(centers.size(), 0);
+    std::vector<std::pair<glm::ivec2, const Cell*>> neighbours;
+
+    for (size_t begin = 0; begin < order.size();) {
+        size_t end = begin + 1;
+        while (end < order.size() && order[end].first == order[begin].first) {
+            end++;
+        }
+
+        // Every cell any center of this cell can reach, looked up once
+        const glm::ivec2 origin = CellOf(centers[order[begin].second]);
+        neighbours.clear();
+        ForEachCell(origin - glm::ivec2(reach), origin + glm::ivec2(reach), [&neighbours](const glm::ivec2& cell, const Cell& data) {
+            neighbours.emplace_back(cell, &data);
+            return true;
+        });
+
+        for (size_t q = begin; q < end; ++q) {
+            const uint32_t query = order[q].second;
+            const glm::vec3& center = centers[query];
+            const size_t before = groupedIds.size();
+            for (const auto& neighbour : neighbours) {
+                if (CellDistanceSquared(neighbour.first, center) > radiusSquared) {
+                    continue;
+                }
+                for (const Item& item : neighbour.second->items) {
+                    const glm::vec3 delta = item.position - center;
+                    if (glm::dot(delta, delta) <= radiusSquared) {
+                        groupedIds.push_back(item.id);
+                    }
+                }
+            }
+            counts[query] = static_cast<uint32_t>(groupedIds.size() - before);
+        }
+        begin = end;
+    }
+
+    for (size_t i = 0; i < centers.size(); ++i) {
+        result.offsets[i + 1] = result.offsets[i] + counts[i];
+    }
+    result.ids.resize(groupedIds.size());
+
+    size_t read = 0;
+    for (const auto& entry : order) {
+        const uint32_t query = entry.second;
+        std::copy_n(groupedIds.begin() + static_cast<std::ptrdiff_t>(read), counts[query],
+                    result.ids.begin() + result.offsets[query]);
+        read += counts[query];
+    }
+}
+
+glm::ivec2 MobSpatialIndex::CellOf(const glm::vec3& position) const {
+    return glm::ivec2(static_cast<int>(std::floor(position.x * m_invCellSize)),
+                      static_cast<int>(std::floor(position.z * m_invCellSize)));
+}
+
+uint64_t MobSpatialIndex::KeyOf(const glm::ivec2& cell) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(cell.x)) << 32) | static_cast<uint32_t>(cell.y);
+}
+
+const MobSpatialIndex::Cell* MobSpatialIndex::FindCell(const glm::ivec2& cell) const {
+    auto it = m_cells.find(KeyOf(cell));
+    return it != m_cells.end() ? &it->second : nullptr;
+}
+
+void MobSpatialIndex::RemoveFromCell(const Location& location) {
+    auto cellIt = m_cells.find(location.cell);
+    std::vector<Item>& items = cellIt->second.items;
+
+    if (location.index + 1 != items.size()) {
+        items[location.index] = items.back();
+        m_locations[items[location.index].id].index = location.index;
+    }
+    items.pop_back();
+
+    if (items.empty()) {
+        m_cells.erase(cellIt);
+        if (m_cells.empty()) {
+            m_minCell = glm::ivec2(0);
+            m_maxCell = glm::ivec2(-1);
+        }
+    }
+}
+
+float MobSpatialIndex::CellDistanceSquared(const glm::ivec2& cell, const glm::vec3& point) const {
+    const float minX = static_cast<float>(cell.x) * m_cellSize;
+    const float minZ = static_cast<float>(cell.y) * m_cellSize;
+    const float dx = std::max(std::max(minX - point.x, point.x - (minX + m_cellSize)), 0.0f);
+    const float dz = std::max(std::max(minZ - point.z, point.z - (minZ + m_cellSize)), 0.0f);
+    return dx * dx + dz * dz;
+}
+
+} // namespace VoxelCraft
@@ -0,0 +1,277 @@
+/**
+ * @file MobSpatialIndex.hpp
+ * @brief VoxelCraft Mob Spatial Index - Chunk-aligned hash grid for proximity queries
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#ifndef VOXELCRAFT_MOB_MOB_SPATIAL_INDEX_HPP
+#define VOXELCRAFT_MOB_MOB_SPATIAL_INDEX_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace VoxelCraft {
+
+    /**
+     * @class MobSpatialIndex
+     * @brief Uniform grid of chunk columns mapping IDs to positions
+     *
+     * Cells are cellSize x cellSize columns in X/Z (16 = one chunk) hashed by
+     * their coordinates; Y only enters the distance tests, since mobs spread
+     * horizontally. Each cell stores positions inline, so a query touches
+     * only the cells overlapping its shape and reads them sequentially.
+     *
+     * Update() is O(1): moving within a cell rewrites the position, crossing
+     * a cell boundary is a swap-remove plus an append. The index does not
+     * track the objects itself; the owner calls Update() after moving them.
+     *
+     * Distances are 3D. Radius and box queries are inclusive; FindNearest and
+     * FindKNearest only return IDs strictly closer than maxDistance.
+     */
+    class MobSpatialIndex {
+    public:
+        static constexpr uint32_t INVALID_ID = std::numeric_limits<uint32_t>::max();
+
+        /**
+         * @struct BatchResult
+         * @brief Results of QueryRadiusBatch: IDs of query i are ids[offsets[i], offsets[i + 1])
+         */
+        struct BatchResult {
+            std::vector<uint32_t> offsets;
+            std::vector<uint32_t> ids;
+
+            size_t GetQueryCount() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+            const uint32_t* Begin(size_t query) const { return ids.data() + offsets[query]; }
+            const uint32_t* End(size_t query) const { return ids.data() + offsets[query + 1]; }
+            size_t GetCount(size_t query) const { return offsets[query + 1] - offsets[query]; }
+        };
+
+        /**
+         * @brief Constructor
+         * @param cellSize Cell edge in blocks (16 aligns cells with chunks)
+         */
+        explicit MobSpatialIndex(float cellSize = 16.0f);
+
+        // Maintenance
+
+        /**
+         * @brief Insert an ID, or move it if already present
+         */
+        void Insert(uint32_t id, const glm::vec3& position);
+
+        /**
+         * @brief Move an ID; inserts it if missing
+         */
+        void Update(uint32_t id, const glm::vec3& position);
+
+        /**
+         * @brief Remove an ID
+         * @return true if it was indexed
+         */
+        bool Remove(uint32_t id);
+
+        /**
+         * @brief Remove everything
+         */
+        void Clear();
+
+        bool Contains(uint32_t id) const { return m_locations.find(id) != m_locations.end(); }
+        size_t GetSize() const { return m_locations.size(); }
+        size_t GetCellCount() const { return m_cells.size(); }
+        float GetCellSize() const { return m_cellSize; }
+
+        // Queries (append to the output vector)
+
+        /**
+         * @brief IDs within radius of center
+         */
+        void QueryRadius(const glm::vec3& center, float radius, std::vector<uint32_t>& out) const;
+
+        /**
+         * @brief IDs inside [min, max]
+         */
+        void QueryAABB(const glm::vec3& min, const glm::vec3& max, std::vector<uint32_t>& out) const;
+
+        /**
+         * @brief Up to k IDs closer than maxDistance, nearest first (ties by ID)
+         */
+        void FindKNearest(const glm::vec3& center, size_t k, float maxDistance, std::vector<uint32_t>& out) const;
+
+        /**
+         * @brief Nearest ID closer than maxDistance
+         * @param distanceSquared Receives the squared distance if found
+         * @return The ID, or INVALID_ID
+         */
+        uint32_t FindNearest(const glm::vec3& center, float maxDistance = std::numeric_limits<float>::infinity(),
+                             float* distanceSquared = nullptr) const;
+
+        /**
+         * @brief Number of IDs within radius, stopping once limit is reached
+         */
+        size_t CountInRadius(const glm::vec3& center, float radius,
+                             size_t limit = std::numeric_limits<size_t>::max()) const;
+
+        /**
+         * @brief One radius query per center
+         *
+         * Centers are grouped by cell so the neighbouring cells are looked
+         * up once per group instead of once per query. The output is in the
+         * order of centers.
+         */
+        void QueryRadiusBatch(const std::vector<glm::vec3>& centers, float radius, BatchResult& result) const;
+
+        /**
+         * @brief Call func(id, position) for every ID within radius
+         */
+        template<typename Func>
+        void ForEachInRadius(const glm::vec3& center, float radius, Func&& func) const;
+
+    private:
+        struct Item {
+            glm::vec3 position;
+            uint32_t id;
+        };
+
+        struct Cell {
+            std::vector<Item> items;
+        };
+
+        struct Location {
+            uint64_t cell;
+            uint32_t index;             ///< Position in Cell::items
+        };
+
+        float m_cellSize;
+        float m_invCellSize;
+        std::unordered_map<uint64_t, Cell> m_cells;
+        std::unordered_map<uint32_t, Location> m_locations;
+
+        // Occupied cell range; only grows until Clear()
+        glm::ivec2 m_minCell;
+        glm::ivec2 m_maxCell;
+
+        glm::ivec2 CellOf(const glm::vec3& position) const;
+        static uint64_t KeyOf(const glm::ivec2& cell);
+        const Cell* FindCell(const glm::ivec2& cell) const;
+        void RemoveFromCell(const Location& location);
+
+        /// Squared horizontal distance from point to the cell's column (0 inside)
+        float CellDistanceSquared(const glm::ivec2& cell, const glm::vec3& point) const;
+
+        /// Call func(cell, data) for every non-empty cell overlapping [min, max] in X/Z until it returns false
+        template<typename Func>
+        void ForEachCell(const glm::ivec2& minCell, const glm::ivec2& maxCell, Func&& func) const;
+
+        /// Call visit(data) ring by ring outwards from center's cell until done(gap²) is true,
+        /// where gap is the smallest horizontal distance from center to the next ring
+        template<typename Visit, typename Done>
+        void ForEachRingCell(const glm::vec3& center, Visit&& visit, Done&& done) const;
+    };
+
+    // Template implementations
+
+    template<typename Func>
+    void MobSpatialIndex::ForEachCell(const glm::ivec2& minCell, const glm::ivec2& maxCell, Func&& func) const {
+        if (m_cells.empty()) {
+            return;
+        }
+
+        const glm::ivec2 lo = glm::max(minCell, m_minCell);
+        const glm::ivec2 hi = glm::min(maxCell, m_maxCell);
+        if (lo.x > hi.x || lo.y > hi.y) {
+            return;
+        }
+
+        // Large shapes over a sparse grid: walking the occupied cells is cheaper
+        const uint64_t area = static_cast<uint64_t>(hi.x - lo.x + 1) * static_cast<uint64_t>(hi.y - lo.y + 1);
+        if (area > m_cells.size()) {
+            for (const auto& pair : m_cells) {
+                const glm::ivec2 cell(static_cast<int32_t>(pair.first >> 32), static_cast<int32_t>(pair.first & 0xFFFFFFFFu));
+                if (cell.x >= lo.x && cell.x <= hi.x && cell.y >= lo.y && cell.y <= hi.y && !func(cell, pair.second)) {
+                    return;
+                }
+            }
+            return;
+        }
+
+        for (int x = lo.x; x <= hi.x; ++x) {
+            for (int z = lo.y; z <= hi.y; ++z) {
+                const glm::ivec2 cell(x, z);
+                const Cell* found = FindCell(cell);
+                if (found && !func(cell, *found)) {
+                    return;
+                }
+            }
+        }
+    }
+
+    template<typename Visit, typename Done>
+    void MobSpatialIndex::ForEachRingCell(const glm::vec3& center, Visit&& visit, Done&& done) const {
+        if (m_cells.empty()) {
+            return;
+        }
+
+        const glm::ivec2 origin = CellOf(center);
+        const float inCellX = center.x - static_cast<float>(origin.x) * m_cellSize;
+        const float inCellZ = center.z - static_cast<float>(origin.y) * m_cellSize;
+        const float edgeGap = std::max(0.0f, std::min(std::min(inCellX, m_cellSize - inCellX),
+                                                      std::min(inCellZ, m_cellSize - inCellZ)));
+        const int maxRing = std::max(std::max(origin.x - m_minCell.x, m_maxCell.x - origin.x),
+                                     std::max(origin.y - m_minCell.y, m_maxCell.y - origin.y));
+
+        auto visitCell = [this, &visit](int x, int z) {
+            if (x >= m_minCell.x && x <= m_maxCell.x && z >= m_minCell.y && z <= m_maxCell.y) {
+                if (const Cell* cell = FindCell(glm::ivec2(x, z))) {
+                    visit(*cell);
+                }
+            }
+        };
+
+        visitCell(origin.x, origin.y);
+        for (int ring = 1; ring <= maxRing; ++ring) {
+            const float gap = static_cast<float>(ring - 1) * m_cellSize + edgeGap;
+            if (done(gap * gap)) {
+                return;
+            }
+
+            // Top and bottom rows, then the columns between them
+            for (int x = origin.x - ring; x <= origin.x + ring; ++x) {
+                visitCell(x, origin.y - ring);
+                visitCell(x, origin.y + ring);
+            }
+            for (int z = origin.y - ring + 1; z <= origin.y + ring - 1; ++z) {
+                visitCell(origin.x - ring, z);
+                visitCell(origin.x + ring, z);
+            }
+        }
+    }
+
+    template<typename Func>
+    void MobSpatialIndex::ForEachInRadius(const glm::vec3& center, float radius, Func&& func) const {
+        if (radius < 0.0f) {
+            return;
+        }
+
+        const float radiusSquared = radius * radius;
+        const glm::vec3 extent(radius);
+        ForEachCell(CellOf(center - extent), CellOf(center + extent), [&](const glm::ivec2& cell, const Cell& data) {
+            if (CellDistanceSquared(cell, center) <= radiusSquared) {
+                for (const Item& item : data.items) {
+                    const glm::vec3 delta = item.position - center;
+                    if (glm::dot(delta, delta) <= radiusSquared) {
+                        func(item.id, item.position);
+                    }
+                }
+            }
+            return true;
+        });
+    }
+
+} // namespace VoxelCraft
+
+#endif // VOXELCRAFT_MOB_MOB_SPATIAL_INDEX_HPP
@@ -0,0 +1,95 @@
+/**
+ * @file ByteRing.cpp
+ * @brief VoxelCraft Network Byte Ring Implementation
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#include "ByteRing.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace VoxelCraft {
+
+    void ByteRing::Allocate(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        m_buffer.assign(size, 0);
+        m_mask = size - 1;
+        m_head = m_tail = 0;
+    }
+
+    int ByteRing::ReadableSpans(Span spans[2]) {
+        const size_t size = Size();
+        if (size == 0) {
+            return 0;
+        }
+
+        const size_t start = static_cast<size_t>(m_head) & m_mask;
+        const size_t first = std::min(size, Capacity() - start);
+        spans[0].data = m_buffer.data() + start;
+        spans[0].size = first;
+        if (first == size) {
+            return 1;
+        }
+        spans[1].data = m_buffer.data();
+        spans[1].size = size - first;
+        return 2;
+    }
+
+    int ByteRing::WritableSpans(Span spans[2]) {
+        const size_t free = Free();
+        if (free == 0) {
+            return 0;
+        }
+
+        const size_t start = static_cast<size_t>(m_tail) & m_mask;
+        const size_t first = std::min(free, Capacity() - start);
+        spans[0].data = m_buffer.data() + start;
+        spans[0].size = first;
+        if (first == free) {
+            return 1;
+        }
+        spans[1].data = m_buffer.data();
+        spans[1].size = free - first;
+        return 2;
+    }
+
+    bool ByteRing::Write(const void* data, size_t size) {
+        if (size > Free()) {
+            return false;
+        }
+
+        const size_t start = static_cast<size_t>(m_tail) & m_mask;
+        const size_t first = std::min(size, Capacity() - start);
+        std::memcpy(m_buffer.data() + start, data, first);
+        std::memcpy(m_buffer.data(), static_cast<const uint8_t*>(data) + first, size - first);
+        m_tail += size;
+        return true;
+    }
+
+    bool ByteRing::Peek(void* out, size_t size, size_t offset) const {
+        if (offset + size > Size()) {
+            return false;
+        }
+
+        const size_t start = static_cast<size_t>(m_head + offset) & m_mask;
+        const size_t first = std::min(size, Capacity() - start);
+        std::memcpy(out, m_buffer.data() + start, first);
+        std::memcpy(static_cast<uint8_t*>(out) + first, m_buffer.data(), size - first);
+        return true;
+    }
+
+    const uint8_t* ByteRing::Contiguous(size_t offset, size_t size) const {
+        if (offset + size > Size()) {
+            return nullptr;
+        }
+
+        const size_t start = static_cast<size_t>(m_head + offset) & m_mask;
+        return start + size <= Capacity() ? m_buffer.data() + start : nullptr;
+    }
+
+} // namespace VoxelCraft
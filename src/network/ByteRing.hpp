@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace VoxelCraft {
+
+    /**
+     * @class ByteRing
+     * @brief Buffer circular de bytes con capacidad fija (potencia de dos)
+     *
+     * Se reserva una sola vez y nunca crece: un cliente lento llena su
+     * buffer en lugar de hacer crecer la memoria del servidor. Los datos
+     * legibles y el espacio libre se exponen como como mucho dos tramos
+     * contiguos, para leer y escribir el socket con readv/writev sin copias
+     * intermedias.
+     *
+     * No es thread-safe; quien lo comparte debe sincronizarlo.
+     */
+    class ByteRing {
+    public:
+        /**
+         * @struct Span
+         * @brief Tramo contiguo dentro del buffer
+         */
+        struct Span {
+            uint8_t* data = nullptr;
+            size_t size = 0;
+        };
+
+        ByteRing() = default;
+
+        /**
+         * @brief Reservar el buffer
+         * @param capacity Capacidad mínima; se redondea a potencia de dos
+         */
+        void Allocate(size_t capacity);
+
+        bool IsAllocated() const { return !m_buffer.empty(); }
+        size_t Capacity() const { return m_buffer.size(); }
+        size_t Size() const { return static_cast<size_t>(m_tail - m_head); }
+        size_t Free() const { return Capacity() - Size(); }
+        bool Empty() const { return m_head == m_tail; }
+
+        /**
+         * @brief Vaciar sin liberar memoria
+         */
+        void Clear() { m_head = m_tail = 0; }
+
+        /**
+         * @brief Tramos con datos legibles, en orden
+         * @return Número de tramos no vacíos (0, 1 o 2)
+         */
+        int ReadableSpans(Span spans[2]);
+
+        /**
+         * @brief Tramos libres donde escribir, en orden
+         * @return Número de tramos no vacíos (0, 1 o 2)
+         */
+        int WritableSpans(Span spans[2]);
+
+        /**
+         * @brief Marcar como escritos bytes copiados en WritableSpans
+         */
+        void Commit(size_t size) { m_tail += size; }
+
+        /**
+         * @brief Descartar bytes ya leídos del principio
+         */
+        void Consume(size_t size) { m_head += size; }
+
+        /**
+         * @brief Copiar datos al final
+         * @return false si no caben (no se escribe nada)
+         */
+        bool Write(const void* data, size_t size);
+
+        /**
+         * @brief Copiar bytes del principio sin consumirlos
+         * @return false si hay menos de size bytes
+         */
+        bool Peek(void* out, size_t size, size_t offset = 0) const;
+
+        /**
+         * @brief Puntero a size bytes desde offset si son contiguos, nullptr si no
+         */
+        const uint8_t* Contiguous(size_t offset, size_t size) const;
+
+    private:
+        std::vector<uint8_t> m_buffer;
+        size_t m_mask = 0;
+        uint64_t m_head = 0;    ///< Posición lógica de lectura
+        uint64_t m_tail = 0;    ///< Posición lógica de escritura
+    };
+
+} // namespace VoxelCraft
@@ -0,0 +1,403 @@
+/**
+ * @file InterestManager.cpp
+ * @brief VoxelCraft Server Interest Management Implementation
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#include "InterestManager.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace VoxelCraft {
+
+    namespace {
+
+        constexpr float CHUNK_WIDTH = static_cast<float>(ChunkSystemConfig::CHUNK_SIZE);
+
+        // Girar más de 45° desde la última ordenación reordena la cola
+        constexpr float REORDER_DOT = 0.70710678f;
+
+        void Normalize(float& dirX, float& dirZ) {
+            const float length = std::sqrt(dirX * dirX + dirZ * dirZ);
+            if (length > 1e-6f) {
+                dirX /= length;
+                dirZ /= length;
+            } else {
+                dirX = 0.0f;
+                dirZ = 1.0f;
+            }
+        }
+
+        bool InRadius(const ChunkCoord& coord, const ChunkCoord& center, int radius) {
+            const int64_t dx = coord.x - center.x;
+            const int64_t dz = coord.z - center.z;
+            return dx * dx + dz * dz <= static_cast<int64_t>(radius) * radius;
+        }
+
+    } // namespace
+
+    InterestManager::InterestManager(const InterestConfig& config)
+        : m_config(config)
+        , m_roundRobin(0)
+    {
+    }
+
+    void InterestManager::SetConfig(const InterestConfig& config) {
+        m_config = config;
+        for (ClientState& client : m_clients) {
+            client.queueDirty = true;
+        }
+    }
+
+    void InterestManager::AddClient(uint32_t clientId, int viewDistance) {
+        if (HasClient(clientId)) {
+            SetClientViewDistance(clientId, viewDistance);
+            return;
+        }
+        ClientState client;
+        client.id = clientId;
+        client.viewDistance = viewDistance > 0 ? viewDistance : m_config.viewDistance;
+        m_clientIndex[clientId] = m_clients.size();
+        m_clients.push_back(std::move(client));
+
+        ClientView view;
+        view.id = clientId;
+        m_views.push_back(view);
+    }
+
+    void InterestManager::RemoveClient(uint32_t clientId) {
+        auto it = m_clientIndex.find(clientId);
+        if (it == m_clientIndex.end()) {
+            return;
+        }
+        const size_t index = it->second;
+        m_clientIndex.erase(it);
+        if (index + 1 != m_clients.size()) {
+            m_clients[index] = std::move(m_clients.back());
+            m_views[index] = m_views.back();
+            m_clientIndex[m_clients[index].id] = index;
+        }
+        m_clients.pop_back();
+        m_views.pop_back();
+    }
+
+    void InterestManager::SetClientViewDistance(uint32_t clientId, int viewDistance) {
+        ClientState* client = Find(clientId);
+        if (!client) {
+            return;
+        }
+        const int distance = viewDistance > 0 ? viewDistance : m_config.viewDistance;
+        if (distance != client->viewDistance) {
+            client->viewDistance = distance;
+            client->queueDirty = true;
+            UpdateView(*client);
+        }
+    }
+
+    void InterestManager::UpdateClient(uint32_t clientId, float x, float y, float z, float dirX, float dirZ) {
+        ClientState* client = Find(clientId);
+        if (!client) {
+            return;
+        }
+        Normalize(dirX, dirZ);
+        client->x = x;
+        client->y = y;
+        client->z = z;
+        client->dirX = dirX;
+        client->dirZ = dirZ;
+
+        const ChunkCoord center = ToChunkCoord(x, z);
+        if (!client->hasPosition || center != client->center) {
+            client->center = center;
+            client->hasPosition = true;
+            client->queueDirty = true;
+        } else if (dirX * client->queueDirX + dirZ * client->queueDirZ < REORDER_DOT) {
+            client->queueDirty = true;
+        }
+        UpdateView(*client);
+    }
+
+    void InterestManager::MarkChunkSent(uint32_t clientId, const ChunkCoord& coord) {
+        if (ClientState* client = Find(clientId)) {
+            client->sent.insert(coord);
+        }
+    }
+
+    void InterestManager::ForgetChunk(uint32_t clientId, const ChunkCoord& coord) {
+        ClientState* client = Find(clientId);
+        if (client && client->sent.erase(coord) != 0) {
+            client->queueDirty = true;              // Si sigue en vista hay que reenviarlo
+        }
+    }
+
+    bool InterestManager::HasChunk(uint32_t clientId, const ChunkCoord& coord) const {
+        const ClientState* client = Find(clientId);
+        return client && client->sent.count(coord) != 0;
+    }
+
+    size_t InterestManager::GetQueuedChunkCount(uint32_t clientId) const {
+        const ClientState* client = Find(clientId);
+        return client ? client->queue.size() : 0;
+    }
+
+    size_t InterestManager::GetSentChunkCount(uint32_t clientId) const {
+        const ClientState* client = Find(clientId);
+        return client ? client->sent.size() : 0;
+    }
+
+    size_t InterestManager::ScheduleChunks(const ChunkSendCallback& send, const ChunkUnloadCallback& unload) {
+        const size_t clientCount = m_clients.size();
+        if (clientCount == 0) {
+            return 0;
+        }
+
+        size_t remaining = m_config.totalChunkBytesPerTick;
+        const size_t first = m_roundRobin++ % clientCount;
+
+        for (size_t n = 0; n < clientCount; ++n) {
+            ClientState& client = m_clients[(first + n) % clientCount];
+            if (!client.hasPosition) {
+                continue;
+            }
+
+            if (client.queueDirty) {
+                UnloadOutOfView(client, unload);
+                RebuildQueue(client);
+            }
+
+            // Cubo de fichas: como mucho un tick de presupuesto acumulado, la deuda se arrastra
+            const int64_t budget = static_cast<int64_t>(m_config.clientChunkBytesPerTick);
+            client.credit = std::min(client.credit + budget, budget);
+
+            if (client.queue.empty() || client.credit <= 0) {
+                if (!client.queue.empty()) {
+                    m_stats.clientBudgetStalls++;
+                }
+                continue;
+            }
+            if (remaining == 0) {
+                m_stats.totalBudgetStalls++;
+                continue;
+            }
+
+            const size_t bytes = SendQueued(client, remaining, send);
+            remaining -= std::min(bytes, remaining);
+        }
+
+        return m_config.totalChunkBytesPerTick - remaining;
+    }
+
+    size_t InterestManager::SendQueued(ClientState& client, size_t totalBudget, const ChunkSendCallback& send) {
+        size_t bytesSent = 0;
+        size_t attempts = 0;
+        m_retryScratch.clear();
+
+        while (!client.queue.empty() && client.credit > 0 && bytesSent < totalBudget &&
+               attempts < m_config.maxChunkAttemptsPerTick) {
+            const ChunkCoord coord = client.queue.back();
+            client.queue.pop_back();
+            if (client.sent.count(coord) != 0) {
+                continue;                           // Enviado por otro camino (MarkChunkSent)
+            }
+
+            attempts++;
+            const size_t bytes = send(client.id, coord);
+            if (bytes == 0) {
+                m_stats.chunksNotReady++;
+                m_retryScratch.push_back(coord);
+                continue;
+            }
+
+            client.sent.insert(coord);
+            client.credit -= static_cast<int64_t>(bytes);
+            bytesSent += bytes;
+            m_stats.chunksSent++;
+            m_stats.chunkBytesSent += bytes;
+        }
+
+        // Los no disponibles vuelven delante, en su orden
+        for (auto it = m_retryScratch.rbegin(); it != m_retryScratch.rend(); ++it) {
+            client.queue.push_back(*it);
+        }
+
+        if (!client.queue.empty() && client.credit <= 0) {
+            m_stats.clientBudgetStalls++;
+        } else if (!client.queue.empty() && bytesSent >= totalBudget) {
+            m_stats.totalBudgetStalls++;
+        }
+        return bytesSent;
+    }
+
+    void InterestManager::UnloadOutOfView(ClientState& client, const ChunkUnloadCallback& unload) {
+        const int keepRadius = client.viewDistance + std::max(0, m_config.unloadMargin);
+        m_unloadScratch.clear();
+        for (const ChunkCoord& coord : client.sent) {
+            if (!InRadius(coord, client.center, keepRadius)) {
+                m_unloadScratch.push_back(coord);
+            }
+        }
+        for (const ChunkCoord& coord : m_unloadScratch) {
+            client.sent.erase(coord);
+            if (unload) {
+                unload(client.id, coord);
+            }
+        }
+        m_stats.chunksUnloaded += m_unloadScratch.size();
+    }
+
+    void InterestManager::RebuildQueue(ClientState& client) {
+        const int radius = client.viewDistance;
+        const float facingWeight = std::clamp(m_config.facingWeight, 0.0f, 1.0f);
+
+        m_sortScratch.clear();
+        for (int dz = -radius; dz <= radius; ++dz) {
+            for (int dx = -radius; dx <= radius; ++dx) {
+                if (dx * dx + dz * dz > radius * radius) {
+                    continue;
+                }
+                const ChunkCoord coord(client.center.x + dx, client.center.z + dz);
+                if (client.sent.count(coord) != 0) {
+                    continue;
+                }
+
+                // Distancia al centro del chunk, alargada hasta (1 + 2w) veces a la espalda
+                const float cx = (static_cast<float>(coord.x) + 0.5f) * CHUNK_WIDTH - client.x;
+                const float cz = (static_cast<float>(coord.z) + 0.5f) * CHUNK_WIDTH - client.z;
+                const float distance = std::sqrt(cx * cx + cz * cz);
+                float key = distance;
+                if (distance > CHUNK_WIDTH) {
+                    const float facing = (cx * client.dirX + cz * client.dirZ) / distance;
+                    key *= 1.0f + facingWeight * (1.0f - facing);
+                }
+                m_sortScratch.emplace_back(key, coord);
+            }
+        }
+
+        // Mayor clave primero: se saca por el final
+        std::sort(m_sortScratch.begin(), m_sortScratch.end(), [](const auto& a, const auto& b) {
+            return a.first > b.first;
+        });
+
+        client.queue.clear();
+        client.queue.reserve(m_sortScratch.size());
+        for (const auto& entry : m_sortScratch) {
+            client.queue.push_back(entry.second);
+        }
+
+        client.queueDirX = client.dirX;
+        client.queueDirZ = client.dirZ;
+        client.queueDirty = false;
+        m_stats.queueRebuilds++;
+    }
+
+    uint32_t InterestManager::GetEntityUpdateInterval(float distance, int viewDistance) const {
+        if (distance > static_cast<float>(viewDistance) * CHUNK_WIDTH) {
+            return 0;
+        }
+        const float fullRate = std::max(m_config.fullRateDistance, 1.0f);
+        const uint32_t maxInterval = std::max<uint32_t>(m_config.maxEntityInterval, 1);
+
+        // 1 tick hasta fullRate, y el doble por cada vez que se duplica la distancia
+        uint32_t interval = 1;
+        const float ratio = distance / fullRate;
+        while (static_cast<float>(interval) < ratio && interval < maxInterval) {
+            interval <<= 1;
+        }
+        return std::min(interval, maxInterval);
+    }
+
+    size_t InterestManager::CollectEntityRecipients(uint32_t entityId, float x, float y, float z, uint64_t tick,
+                                                    std::vector<uint32_t>& recipients, uint32_t excludeClientId) {
+        const float fullRate = std::max(m_config.fullRateDistance, 1.0f);
+        const uint32_t maxInterval = std::max<uint32_t>(m_config.maxEntityInterval, 1);
+
+        // Se recorren todos los clientes: datos compactos, contadores locales y sin raíces cuadradas
+        uint64_t culled = 0;
+        uint64_t throttled = 0;
+        size_t added = 0;
+        for (const ClientView& view : m_views) {
+            if (view.id == excludeClientId || view.rangeSq < 0.0f) {
+                continue;
+            }
+
+            const float dx = x - view.x;
+            const float dy = y - view.y;
+            const float dz = z - view.z;
+            const float horizontal = dx * dx + dz * dz;
+            const float distanceSq = horizontal + dy * dy;
+            if (distanceSq > view.rangeSq) {
+                culled++;
+                continue;
+            }
+
+            // Mismo resultado que GetEntityUpdateInterval
+            uint32_t interval = 1;
+            float limit = fullRate;
+            while (distanceSq > limit * limit && interval < maxInterval) {
+                interval <<= 1;
+                limit *= 2.0f;
+            }
+            if ((tick + entityId) % interval != 0) {
+                throttled++;
+                continue;
+            }
+
+            recipients.push_back(view.id);
+            added++;
+        }
+
+        m_stats.entityUpdatesCulled += culled;
+        m_stats.entityUpdatesThrottled += throttled;
+        m_stats.entityUpdatesSent += added;
+        return added;
+    }
+
+    size_t InterestManager::CollectChunkRecipients(const ChunkCoord& coord, std::vector<uint32_t>& recipients,
+                                                   uint32_t excludeClientId) const {
+        size_t added = 0;
+        for (const ClientState& client : m_clients) {
+            if (client.id != excludeClientId && client.sent.count(coord) != 0) {
+                recipients.push_back(client.id);
+                added++;
+            }
+        }
+        return added;
+    }
+
+    void InterestManager::UpdateView(const ClientState& client) {
+        ClientView& view = m_views[m_clientIndex.at(client.id)];
+        const float range = static_cast<float>(client.viewDistance) * CHUNK_WIDTH;
+        view.x = client.x;
+        view.y = client.y;
+        view.z = client.z;
+        view.rangeSq = client.hasPosition ? range * range : -1.0f;
+    }
+
+    InterestStats InterestManager::GetStats() const {
+        InterestStats stats = m_stats;
+        stats.clients = m_clients.size();
+        return stats;
+    }
+
+    void InterestManager::ResetStats() {
+        m_stats = InterestStats();
+    }
+
+    ChunkCoord InterestManager::ToChunkCoord(float x, float z) {
+        return ChunkCoord(static_cast<int32_t>(std::floor(x / CHUNK_WIDTH)),
+                          static_cast<int32_t>(std::floor(z / CHUNK_WIDTH)));
+    }
+
+    InterestManager::ClientState* InterestManager::Find(uint32_t clientId) {
+        auto it = m_clientIndex.find(clientId);
+        return it != m_clientIndex.end() ? &m_clients[it->second] : nullptr;
+    }
+
+    const InterestManager::ClientState* InterestManager::Find(uint32_t clientId) const {
+        auto it = m_clientIndex.find(clientId);
+        return it != m_clientIndex.end() ? &m_clients[it->second] : nullptr;
+    }
+
+} // namespace VoxelCraft
@@ -0,0 +1,201 @@
+#pragma once
+
+#include "../world/ChunkSystem.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace VoxelCraft {
+
+    /**
+     * @struct InterestConfig
+     * @brief Configuración de la gestión de interés del servidor
+     */
+    struct InterestConfig {
+        int viewDistance = 10;                    ///< Radio de chunks por defecto de cada cliente
+        int unloadMargin = 1;                     ///< Chunks extra antes de descargar (histéresis)
+        float fullRateDistance = 32.0f;           ///< Bloques dentro de los que una entidad se envía cada tick
+        uint32_t maxEntityInterval = 8;           ///< Ticks entre actualizaciones en el borde de la vista
+        float facingWeight = 0.5f;                ///< Cuánto adelanta la cola los chunks hacia donde se mira (0-1)
+        size_t clientChunkBytesPerTick = 48 * 1024;   ///< Presupuesto de chunks por cliente y tick
+        size_t totalChunkBytesPerTick = 1024 * 1024;  ///< Presupuesto de chunks de todo el servidor por tick
+        size_t maxChunkAttemptsPerTick = 32;      ///< Chunks consultados como máximo por cliente y tick
+    };
+
+    /**
+     * @struct InterestStats
+     * @brief Contadores de la gestión de interés desde el arranque
+     */
+    struct InterestStats {
+        size_t clients = 0;
+        uint64_t queueRebuilds = 0;               ///< Colas recalculadas (cambio de chunk, giro o distancia)
+        uint64_t chunksSent = 0;
+        uint64_t chunkBytesSent = 0;
+        uint64_t chunksNotReady = 0;              ///< El proveedor aún no tenía el chunk
+        uint64_t chunksUnloaded = 0;
+        uint64_t clientBudgetStalls = 0;          ///< Ticks en que un cliente agotó su presupuesto con cola
+        uint64_t totalBudgetStalls = 0;           ///< Ticks en que se agotó el presupuesto del servidor
+        uint64_t entityUpdatesSent = 0;           ///< Pares (entidad, cliente) aceptados
+        uint64_t entityUpdatesThrottled = 0;      ///< Dentro de la vista, pero no les tocaba este tick
+        uint64_t entityUpdatesCulled = 0;         ///< Fuera de la vista del cliente
+    };
+
+    /**
+     * @class InterestManager
+     * @brief Decide qué chunks y qué actualizaciones necesita cada cliente
+     *
+     * Cada cliente tiene un conjunto de vista (chunks dentro de su radio)
+     * y el conjunto de chunks que ya se le enviaron:
+     *
+     * - Chunks: los que faltan van a una cola ordenada por distancia y
+     *   penalizada según lo lejos que queden de la dirección de la mirada.
+     *   La cola solo se recalcula al cambiar de chunk, girar más de 45° o
+     *   cambiar la distancia de vista. ScheduleChunks la vacía con un
+     *   presupuesto de bytes por cliente (cubo de fichas: lo que sobra o
+     *   falta pasa al tick siguiente) y otro global, repartido empezando
+     *   cada tick por un cliente distinto.
+     * - Entidades: solo se envían a clientes en cuyo radio están, cada
+     *   tick cerca del jugador y cada 2, 4, ... maxEntityInterval ticks
+     *   según se alejan. La fase depende del id de la entidad para que
+     *   las lejanas no coincidan todas en el mismo tick.
+     * - Cambios de bloque: solo a los clientes que tienen el chunk.
+     *
+     * No es thread-safe: se usa desde el hilo de tick del servidor.
+     */
+    class InterestManager {
+    public:
+        /**
+         * @brief Enviar un chunk a un cliente
+         * @return Bytes encolados; 0 si el chunk aún no está disponible (se reintenta)
+         */
+        using ChunkSendCallback = std::function<size_t(uint32_t clientId, const ChunkCoord& coord)>;
+
+        /**
+         * @brief Avisar a un cliente de que descargue un chunk que salió de su vista
+         */
+        using ChunkUnloadCallback = std::function<void(uint32_t clientId, const ChunkCoord& coord)>;
+
+        explicit InterestManager(const InterestConfig& config = InterestConfig());
+
+        void SetConfig(const InterestConfig& config);
+        const InterestConfig& GetConfig() const { return m_config; }
+
+        // Clientes
+
+        /**
+         * @brief Registrar un cliente
+         * @param viewDistance Radio en chunks (0 = el de la configuración)
+         */
+        void AddClient(uint32_t clientId, int viewDistance = 0);
+        void RemoveClient(uint32_t clientId);
+        bool HasClient(uint32_t clientId) const { return m_clientIndex.count(clientId) != 0; }
+        size_t GetClientCount() const { return m_clients.size(); }
+
+        void SetClientViewDistance(uint32_t clientId, int viewDistance);
+
+        /**
+         * @brief Actualizar posición y dirección de la mirada de un cliente
+         * @param dirX, dirZ Dirección horizontal de la mirada (no hace falta normalizarla)
+         */
+        void UpdateClient(uint32_t clientId, float x, float y, float z, float dirX, float dirZ);
+
+        /**
+         * @brief Marcar que el cliente ya tiene (o ha perdido) un chunk sin pasar por la cola
+         */
+        void MarkChunkSent(uint32_t clientId, const ChunkCoord& coord);
+        void ForgetChunk(uint32_t clientId, const ChunkCoord& coord);
+
+        bool HasChunk(uint32_t clientId, const ChunkCoord& coord) const;
+        size_t GetQueuedChunkCount(uint32_t clientId) const;
+        size_t GetSentChunkCount(uint32_t clientId) const;
+
+        // Chunks
+
+        /**
+         * @brief Descargar lo que salió de la vista y enviar chunks de las colas
+         *
+         * Llamar una vez por tick.
+         * @return Bytes de chunks enviados en este tick
+         */
+        size_t ScheduleChunks(const ChunkSendCallback& send, const ChunkUnloadCallback& unload);
+
+        // Actualizaciones
+
+        /**
+         * @brief Cada cuántos ticks se envía una entidad a esta distancia (0 = nunca)
+         * @param distance Distancia en bloques
+         * @param viewDistance Radio de vista en chunks
+         */
+        uint32_t GetEntityUpdateInterval(float distance, int viewDistance) const;
+
+        /**
+         * @brief Clientes a los que enviar la actualización de una entidad en este tick
+         * @param excludeClientId Cliente que no la recibe (p. ej. el propio jugador; 0 = ninguno)
+         * @return Número de clientes añadidos a recipients
+         */
+        size_t CollectEntityRecipients(uint32_t entityId, float x, float y, float z, uint64_t tick,
+                                       std::vector<uint32_t>& recipients, uint32_t excludeClientId = 0);
+
+        /**
+         * @brief Clientes que tienen el chunk (destinatarios de cambios de bloque)
+         * @return Número de clientes añadidos a recipients
+         */
+        size_t CollectChunkRecipients(const ChunkCoord& coord, std::vector<uint32_t>& recipients,
+                                      uint32_t excludeClientId = 0) const;
+
+        InterestStats GetStats() const;
+        void ResetStats();
+
+        /**
+         * @brief Chunk que contiene una posición en bloques
+         */
+        static ChunkCoord ToChunkCoord(float x, float z);
+
+    private:
+        struct ClientState {
+            uint32_t id = 0;
+            int viewDistance = 0;
+            float x = 0.0f, y = 0.0f, z = 0.0f;
+            float dirX = 0.0f, dirZ = 1.0f;         ///< Mirada normalizada
+            ChunkCoord center;
+            bool hasPosition = false;
+            bool queueDirty = true;
+            float queueDirX = 0.0f, queueDirZ = 1.0f;   ///< Mirada con la que se ordenó la cola
+            int64_t credit = 0;                     ///< Bytes que aún puede recibir (cubo de fichas)
+            std::unordered_set<ChunkCoord> sent;
+            std::vector<ChunkCoord> queue;          ///< Mayor prioridad al final
+        };
+
+        /**
+         * @brief Lo que el bucle de entidades lee de cada cliente, compacto
+         */
+        struct ClientView {
+            float x = 0.0f, y = 0.0f, z = 0.0f;
+            float rangeSq = -1.0f;                  ///< Radio de vista en bloques al cuadrado; < 0 sin posición
+            uint32_t id = 0;
+        };
+
+        InterestConfig m_config;
+        std::vector<ClientState> m_clients;
+        std::vector<ClientView> m_views;        ///< Paralelo a m_clients
+        std::unordered_map<uint32_t, size_t> m_clientIndex;
+        size_t m_roundRobin;
+
+        std::vector<ChunkCoord> m_retryScratch;
+        std::vector<ChunkCoord> m_unloadScratch;
+        std::vector<std::pair<float, ChunkCoord>> m_sortScratch;
+
+        InterestStats m_stats;
+
+        ClientState* Find(uint32_t clientId);
+        const ClientState* Find(uint32_t clientId) const;
+        void UpdateView(const ClientState& client);
+        void RebuildQueue(ClientState& client);
+        void UnloadOutOfView(ClientState& client, const ChunkUnloadCallback& unload);
+        size_t SendQueued(ClientState& client, size_t totalBudget, const ChunkSendCallback& send);
+    };
+
+} // namespace VoxelCraft
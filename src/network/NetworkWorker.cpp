@@ -0,0 +1,114 @@
+/**
+ * @file NetworkWorker.cpp
+ * @brief VoxelCraft Network Worker Thread Implementation
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#include "NetworkWorker.hpp"
+
+#include <chrono>
+
+namespace VoxelCraft {
+
+    NetworkWorker::NetworkWorker()
+        : m_running(false)
+        , m_stopping(false)
+        , m_pending(0)
+        , m_tasksPosted(0)
+        , m_tasksExecuted(0)
+        , m_busyNanoseconds(0)
+        , m_maxPending(0)
+    {
+    }
+
+    NetworkWorker::~NetworkWorker() {
+        Stop();
+    }
+
+    void NetworkWorker::Start() {
+        if (m_running) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = false;
+        }
+        m_running = true;
+        m_thread = std::thread(&NetworkWorker::WorkerThread, this);
+    }
+
+    void NetworkWorker::Stop() {
+        if (!m_running) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopping = true;
+        }
+        m_condition.notify_one();
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        m_running = false;
+    }
+
+    bool NetworkWorker::Post(Task task) {
+        uint64_t pending;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_running || m_stopping) {
+                return false;
+            }
+            // Contada antes de que el hilo pueda sacarla
+            pending = m_pending.fetch_add(1, std::memory_order_acq_rel) + 1;
+            m_tasks.push_back(std::move(task));
+        }
+
+        m_tasksPosted.fetch_add(1, std::memory_order_relaxed);
+        uint64_t peak = m_maxPending.load(std::memory_order_relaxed);
+        while (pending > peak && !m_maxPending.compare_exchange_weak(peak, pending, std::memory_order_relaxed)) {
+        }
+
+        m_condition.notify_one();
+        return true;
+    }
+
+    NetworkWorkerStats NetworkWorker::GetStats() const {
+        NetworkWorkerStats stats;
+        stats.tasksPosted = m_tasksPosted.load(std::memory_order_relaxed);
+        stats.tasksExecuted = m_tasksExecuted.load(std::memory_order_relaxed);
+        stats.busyNanoseconds = m_busyNanoseconds.load(std::memory_order_relaxed);
+        stats.maxPending = m_maxPending.load(std::memory_order_relaxed);
+        stats.pending = m_pending.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void NetworkWorker::WorkerThread() {
+        std::deque<Task> batch;
+
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_condition.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+                if (m_tasks.empty()) {
+                    return;                     // Parando y sin nada pendiente
+                }
+                batch.swap(m_tasks);
+            }
+
+            while (!batch.empty()) {
+                const auto start = std::chrono::steady_clock::now();
+                batch.front()();
+                batch.pop_front();
+                m_busyNanoseconds.fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count()), std::memory_order_relaxed);
+                m_tasksExecuted.fetch_add(1, std::memory_order_relaxed);
+
+                // Después de ejecutarla: IsIdle garantiza que no queda nada por enviar antes
+                m_pending.fetch_sub(1, std::memory_order_acq_rel);
+            }
+        }
+    }
+
+} // namespace VoxelCraft
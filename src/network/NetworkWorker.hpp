@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace VoxelCraft {
+
+    /**
+     * @struct NetworkWorkerStats
+     * @brief Contadores del hilo de red desde Start
+     */
+    struct NetworkWorkerStats {
+        uint64_t tasksPosted = 0;
+        uint64_t tasksExecuted = 0;
+        uint64_t busyNanoseconds = 0;       ///< Tiempo ejecutando tareas
+        uint64_t maxPending = 0;            ///< Mayor número de tareas pendientes
+        uint64_t pending = 0;               ///< Encoladas o ejecutándose ahora
+    };
+
+    /**
+     * @class NetworkWorker
+     * @brief Hilo de red que ejecuta tareas de una en una, en orden de Post
+     *
+     * Saca del hilo de juego el trabajo caro de preparar envíos (comprimir
+     * chunks). Al ser un solo hilo FIFO, los paquetes que pasan por aquí
+     * salen en el mismo orden en que se encolaron. Stop termina las tareas
+     * pendientes antes de parar el hilo.
+     */
+    class NetworkWorker {
+    public:
+        using Task = std::function<void()>;
+
+        NetworkWorker();
+        ~NetworkWorker();
+
+        NetworkWorker(const NetworkWorker&) = delete;
+        NetworkWorker& operator=(const NetworkWorker&) = delete;
+
+        void Start();
+        void Stop();
+
+        bool IsRunning() const { return m_running; }
+
+        /**
+         * @brief Encolar una tarea
+         * @return false si el hilo no está en marcha
+         */
+        bool Post(Task task);
+
+        /**
+         * @brief Tareas encoladas o ejecutándose
+         */
+        size_t GetPendingCount() const { return m_pending.load(std::memory_order_acquire); }
+        bool IsIdle() const { return GetPendingCount() == 0; }
+
+        NetworkWorkerStats GetStats() const;
+
+    private:
+        std::thread m_thread;
+        std::atomic<bool> m_running;
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::deque<Task> m_tasks;
+        bool m_stopping;
+
+        std::atomic<size_t> m_pending;
+        std::atomic<uint64_t> m_tasksPosted;
+        std::atomic<uint64_t> m_tasksExecuted;
+        std::atomic<uint64_t> m_busyNanoseconds;
+        std::atomic<uint64_t> m_maxPending;
+
+        void WorkerThread();
+    };
+
+} // namespace VoxelCraft
@@ -15,51 +15,59 @@ namespace VoxelCraft {
     }
 
     bool Packet::Serialize() {
-        m_data.clear();
-        m_readPosition = 0;
+        // Un bloque nuevo: el anterior puede seguir en colas de envío
+        m_buffer = PacketBuffer::Allocate(GetSizeHint());
+
+        // El flag de compresión marcado antes de serializar pide comprimir el resultado
+        const bool compress = m_header.IsCompressed();
+        m_header.SetCompressed(false);
+        m_header.SetEncrypted(false);
 
         WriteData();
         UpdateHeader();
 
+        if (compress) {
+            Compress();
+        }
         return true;
     }
 
-    bool Packet::Deserialize(const std::vector<uint8_t>& data) {
-        m_data = data;
-        m_originalData = data;
-        m_readPosition = sizeof(PacketHeader);
-
-        if (!ValidateHeader()) {
+    bool Packet::Deserialize(std::span<const uint8_t> data) {
+        PacketReader reader(data);
+        if (!ReadHeader(reader, m_header) || m_header.packetSize != data.size()) {
             return false;
         }
 
+        // Sin comprimir se lee directamente de los bytes recibidos
+        std::span<const uint8_t> payload = data.subspan(PacketHeader::WIRE_SIZE);
+        if (m_header.IsCompressed()) {
+            // Se descomprime directamente desde los bytes recibidos
+            if (!PacketCompression::Decompress(payload, m_buffer)) {
+                return false;
+            }
+            m_header.SetCompressed(false);
+            UpdateHeader();
+            payload = GetPayload();
+        } else {
+            m_buffer.Reset();
+        }
+
+        m_reader = PacketReader(payload);
         ReadData();
-        return true;
+        const bool valid = !m_reader.HasError();
+        m_reader = PacketReader();
+        return valid;
     }
 
     std::vector<uint8_t> Packet::ToBytes() const {
-        std::vector<uint8_t> bytes;
-
-        // Serializar header
-        const uint8_t* headerBytes = reinterpret_cast<const uint8_t*>(&m_header);
-        bytes.insert(bytes.end(), headerBytes, headerBytes + sizeof(PacketHeader));
-
-        // Serializar data
-        bytes.insert(bytes.end(), m_data.begin(), m_data.end());
-
-        return bytes;
+        std::span<const uint8_t> frame = m_buffer.Span();
+        return std::vector<uint8_t>(frame.begin(), frame.end());
     }
 
-    std::shared_ptr<Packet> Packet::FromBytes(const std::vector<uint8_t>& data) {
-        if (data.size() < sizeof(PacketHeader)) {
-            return nullptr;
-        }
-
-        // Deserializar header
+    std::shared_ptr<Packet> Packet::FromBytes(std::span<const uint8_t> data) {
+        PacketReader reader(data);
         PacketHeader header;
-        std::memcpy(&header, data.data(), sizeof(PacketHeader));
-
-        if (!header.magic == 0xDEADBEEF) {
+        if (!ReadHeader(reader, header)) {
             return nullptr;
         }
 
@@ -144,37 +152,26 @@ namespace VoxelCraft {
     }
 
     bool Packet::Compress() {
+        PacketCompressionSettings settings;
+        settings.codec = PacketCodec::LZ4;
+        return Compress(settings);
+    }
+
+    bool Packet::Compress(const PacketCompressionSettings& settings) {
         if (m_header.IsCompressed()) {
             return true; // Already compressed
         }
 
-        // Simple RLE compression for demo purposes
-        // In real implementation, use zlib or similar
-        std::vector<uint8_t> compressedData;
-        size_t i = 0;
-
-        while (i < m_data.size()) {
-            uint8_t current = m_data[i];
-            size_t count = 1;
-
-            while (i + count < m_data.size() && m_data[i + count] == current && count < 255) {
-                count++;
-            }
-
-            compressedData.push_back(current);
-            compressedData.push_back(static_cast<uint8_t>(count));
-            i += count;
-        }
-
-        if (compressedData.size() < m_data.size()) {
-            m_originalData = m_data;
-            m_data = compressedData;
-            m_header.SetCompressed(true);
-            UpdateHeader();
-            return true;
+        // Frame de PacketCompression; bajo el umbral o sin ganancia se queda como está
+        PacketBuffer compressed;
+        if (!PacketCompression::Compress(settings, GetPayload(), compressed)) {
+            return false;
         }
 
-        return false;
+        m_buffer = std::move(compressed);
+        m_header.SetCompressed(true);
+        UpdateHeader();
+        return true;
     }
 
     bool Packet::Decompress() {
@@ -182,21 +179,12 @@ namespace VoxelCraft {
             return true; // Not compressed
         }
 
-        // Simple RLE decompression
-        std::vector<uint8_t> decompressedData;
-
-        for (size_t i = 0; i < m_data.size(); i += 2) {
-            if (i + 1 < m_data.size()) {
-                uint8_t value = m_data[i];
-                uint8_t count = m_data[i + 1];
-
-                for (uint8_t j = 0; j < count; ++j) {
-                    decompressedData.push_back(value);
-                }
-            }
+        PacketBuffer decompressed;
+        if (!PacketCompression::Decompress(GetPayload(), decompressed)) {
+            return false;
         }
 
-        m_data = decompressedData;
+        m_buffer = std::move(decompressed);
         m_header.SetCompressed(false);
         UpdateHeader();
         return true;
@@ -210,8 +198,11 @@ namespace VoxelCraft {
         // Simple XOR encryption for demo purposes
         // In real implementation, use AES or similar
         if (!key.empty()) {
-            for (size_t i = 0; i < m_data.size(); ++i) {
-                m_data[i] ^= key[i % key.size()];
+            const size_t offset = m_buffer.PrependedSize();
+            const size_t size = GetSize();
+            uint8_t* data = m_buffer.MutableData() + offset;
+            for (size_t i = 0; i < size; ++i) {
+                data[i] ^= static_cast<uint8_t>(key[i % key.size()]);
             }
             m_header.SetEncrypted(true);
             UpdateHeader();
@@ -228,8 +219,11 @@ namespace VoxelCraft {
 
         // XOR decryption (same as encryption)
         if (!key.empty()) {
-            for (size_t i = 0; i < m_data.size(); ++i) {
-                m_data[i] ^= key[i % key.size()];
+            const size_t offset = m_buffer.PrependedSize();
+            const size_t size = GetSize();
+            uint8_t* data = m_buffer.MutableData() + offset;
+            for (size_t i = 0; i < size; ++i) {
+                data[i] ^= static_cast<uint8_t>(key[i % key.size()]);
             }
             m_header.SetEncrypted(false);
             UpdateHeader();
@@ -241,47 +235,35 @@ namespace VoxelCraft {
 
     // Write methods
     void Packet::WriteInt8(int8_t value) {
-        m_data.push_back(static_cast<uint8_t>(value));
+        m_buffer.WriteUInt8(static_cast<uint8_t>(value));
     }
 
     void Packet::WriteInt16(int16_t value) {
-        uint16_t networkValue = htons(static_cast<uint16_t>(value));
-        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&networkValue);
-        m_data.insert(m_data.end(), bytes, bytes + sizeof(uint16_t));
+        m_buffer.WriteUInt16(static_cast<uint16_t>(value));
     }
 
     void Packet::WriteInt32(int32_t value) {
-        uint32_t networkValue = htonl(static_cast<uint32_t>(value));
-        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&networkValue);
-        m_data.insert(m_data.end(), bytes, bytes + sizeof(uint32_t));
+        m_buffer.WriteUInt32(static_cast<uint32_t>(value));
     }
 
     void Packet::WriteInt64(int64_t value) {
-        uint64_t networkValue = htobe64(static_cast<uint64_t>(value));
-        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&networkValue);
-        m_data.insert(m_data.end(), bytes, bytes + sizeof(uint64_t));
+        m_buffer.WriteUInt64(static_cast<uint64_t>(value));
     }
 
     void Packet::WriteUInt8(uint8_t value) {
-        m_data.push_back(value);
+        m_buffer.WriteUInt8(value);
     }
 
     void Packet::WriteUInt16(uint16_t value) {
-        uint16_t networkValue = htons(value);
-        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&networkValue);
-        m_data.insert(m_data.end(), bytes, bytes + sizeof(uint16_t));
+        m_buffer.WriteUInt16(value);
     }
 
     void Packet::WriteUInt32(uint32_t value) {
-        uint32_t networkValue = htonl(value);
-        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&networkValue);
-        m_data.insert(m_data.end(), bytes, bytes + sizeof(uint32_t));
+        m_buffer.WriteUInt32(value);
     }
 
     void Packet::WriteUInt64(uint64_t value) {
-        uint64_t networkValue = htobe64(value);
-        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&networkValue);
-        m_data.insert(m_data.end(), bytes, bytes + sizeof(uint64_t));
+        m_buffer.WriteUInt64(value);
     }
 
     void Packet::WriteFloat(float value) {
@@ -298,75 +280,49 @@ namespace VoxelCraft {
 
     void Packet::WriteString(const std::string& value) {
         WriteUInt16(static_cast<uint16_t>(value.length()));
-        m_data.insert(m_data.end(), value.begin(), value.end());
+        m_buffer.Append(value.data(), value.size());
     }
 
-    void Packet::WriteBytes(const std::vector<uint8_t>& value) {
+    void Packet::WriteBytes(std::span<const uint8_t> value) {
         WriteUInt32(static_cast<uint32_t>(value.size()));
-        m_data.insert(m_data.end(), value.begin(), value.end());
+        m_buffer.Append(value.data(), value.size());
     }
 
     void Packet::WriteBool(bool value) {
-        m_data.push_back(value ? 1 : 0);
+        m_buffer.WriteUInt8(value ? 1 : 0);
     }
 
     // Read methods
     int8_t Packet::ReadInt8() {
-        if (m_readPosition >= m_data.size()) return 0;
-        return static_cast<int8_t>(m_data[m_readPosition++]);
+        return static_cast<int8_t>(m_reader.ReadUInt8());
     }
 
     int16_t Packet::ReadInt16() {
-        if (m_readPosition + sizeof(int16_t) > m_data.size()) return 0;
-        uint16_t networkValue;
-        std::memcpy(&networkValue, &m_data[m_readPosition], sizeof(uint16_t));
-        m_readPosition += sizeof(uint16_t);
-        return static_cast<int16_t>(ntohs(networkValue));
+        return static_cast<int16_t>(m_reader.ReadUInt16());
     }
 
     int32_t Packet::ReadInt32() {
-        if (m_readPosition + sizeof(int32_t) > m_data.size()) return 0;
-        uint32_t networkValue;
-        std::memcpy(&networkValue, &m_data[m_readPosition], sizeof(uint32_t));
-        m_readPosition += sizeof(uint32_t);
-        return static_cast<int32_t>(ntohl(networkValue));
+        return static_cast<int32_t>(m_reader.ReadUInt32());
     }
 
     int64_t Packet::ReadInt64() {
-        if (m_readPosition + sizeof(int64_t) > m_data.size()) return 0;
-        uint64_t networkValue;
-        std::memcpy(&networkValue, &m_data[m_readPosition], sizeof(uint64_t));
-        m_readPosition += sizeof(uint64_t);
-        return static_cast<int64_t>(be64toh(networkValue));
+        return static_cast<int64_t>(m_reader.ReadUInt64());
     }
 
     uint8_t Packet::ReadUInt8() {
-        if (m_readPosition >= m_data.size()) return 0;
-        return m_data[m_readPosition++];
+        return m_reader.ReadUInt8();
     }
 
     uint16_t Packet::ReadUInt16() {
-        if (m_readPosition + sizeof(uint16_t) > m_data.size()) return 0;
-        uint16_t networkValue;
-        std::memcpy(&networkValue, &m_data[m_readPosition], sizeof(uint16_t));
-        m_readPosition += sizeof(uint16_t);
-        return ntohs(networkValue);
+        return m_reader.ReadUInt16();
     }
 
     uint32_t Packet::ReadUInt32() {
-        if (m_readPosition + sizeof(uint32_t) > m_data.size()) return 0;
-        uint32_t networkValue;
-        std::memcpy(&networkValue, &m_data[m_readPosition], sizeof(uint32_t));
-        m_readPosition += sizeof(uint32_t);
-        return ntohl(networkValue);
+        return m_reader.ReadUInt32();
     }
 
     uint64_t Packet::ReadUInt64() {
-        if (m_readPosition + sizeof(uint64_t) > m_data.size()) return 0;
-        uint64_t networkValue;
-        std::memcpy(&networkValue, &m_data[m_readPosition], sizeof(uint64_t));
-        m_readPosition += sizeof(uint64_t);
-        return be64toh(networkValue);
+        return m_reader.ReadUInt64();
     }
 
     float Packet::ReadFloat() {
@@ -384,27 +340,11 @@ namespace VoxelCraft {
     }
 
     std::string Packet::ReadString() {
-        uint16_t length = ReadUInt16();
-        if (m_readPosition + length > m_data.size()) {
-            m_readPosition += length;
-            return "";
-        }
-
-        std::string result(m_data.begin() + m_readPosition,
-                          m_data.begin() + m_readPosition + length);
-        m_readPosition += length;
-        return result;
+        return std::string(m_reader.ReadStringView());
     }
 
-    std::vector<uint8_t> Packet::ReadBytes(size_t length) {
-        if (m_readPosition + length > m_data.size()) {
-            length = m_data.size() - m_readPosition;
-        }
-
-        std::vector<uint8_t> result(m_data.begin() + m_readPosition,
-                                   m_data.begin() + m_readPosition + length);
-        m_readPosition += length;
-        return result;
+    std::span<const uint8_t> Packet::ReadBytes(size_t length) {
+        return m_reader.ReadSpan(length);
     }
 
     bool Packet::ReadBool() {
@@ -412,18 +352,45 @@ namespace VoxelCraft {
     }
 
     bool Packet::ValidateHeader() const {
-        if (m_data.size() < sizeof(PacketHeader)) {
-            return false;
-        }
-
         return m_header.magic == 0xDEADBEEF &&
                m_header.packetType < static_cast<uint16_t>(PacketType::MAX_PACKET_TYPES) &&
-               m_header.packetSize == m_data.size();
+               (!m_buffer || m_header.packetSize == PacketHeader::WIRE_SIZE + GetSize());
     }
 
     void Packet::UpdateHeader() {
-        m_header.packetSize = static_cast<uint32_t>(m_data.size() + sizeof(PacketHeader));
+        m_header.packetSize = static_cast<uint32_t>(PacketHeader::WIRE_SIZE + GetSize());
         m_header.timestamp = std::chrono::steady_clock::now();
+
+        // La cabecera va en la zona reservada del buffer: primera vez se antepone, luego se reescribe
+        uint8_t* out = m_buffer.PrependedSize() == PacketHeader::WIRE_SIZE
+            ? m_buffer.MutableData()
+            : m_buffer.Prepend(PacketHeader::WIRE_SIZE);
+        WriteHeader(out);
+    }
+
+    void Packet::WriteHeader(uint8_t* out) const {
+        PacketBuffer::StoreBE(out, m_header.magic, 4);
+        PacketBuffer::StoreBE(out + 4, m_header.packetType, 2);
+        PacketBuffer::StoreBE(out + 6, m_header.flags, 2);
+        PacketBuffer::StoreBE(out + 8, m_header.packetSize, 4);
+        PacketBuffer::StoreBE(out + 12, m_header.sequenceNumber, 4);
+        PacketBuffer::StoreBE(out + 16, m_header.ackNumber, 4);
+        PacketBuffer::StoreBE(out + 20, m_header.connectionId, 4);
+    }
+
+    bool Packet::ReadHeader(PacketReader& reader, PacketHeader& header) {
+        header.magic = reader.ReadUInt32();
+        header.packetType = reader.ReadUInt16();
+        header.flags = reader.ReadUInt16();
+        header.packetSize = reader.ReadUInt32();
+        header.sequenceNumber = reader.ReadUInt32();
+        header.ackNumber = reader.ReadUInt32();
+        header.connectionId = reader.ReadUInt32();
+        header.timestamp = std::chrono::steady_clock::now();
+
+        return !reader.HasError() &&
+               header.magic == 0xDEADBEEF &&
+               header.packetType < static_cast<uint16_t>(PacketType::MAX_PACKET_TYPES);
     }
 
     // Specific packet implementations
@@ -582,7 +549,8 @@ namespace VoxelCraft {
         m_chunkZ = ReadInt32();
         m_fullChunk = ReadBool();
         m_primaryBitMask = ReadUInt16();
-        m_data = ReadBytes(ReadUInt32());
+        std::span<const uint8_t> bytes = ReadBytes(ReadUInt32());
+        m_data.assign(bytes.begin(), bytes.end());
     }
 
     // PacketFactory implementation
@@ -1,11 +1,16 @@
 #pragma once
 
+#include "PacketBuffer.hpp"
+#include "PacketCompression.hpp"
+
 #include <vector>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <functional>
 #include <chrono>
 #include <cstdint>
+#include <span>
 
 namespace VoxelCraft {
 
@@ -106,15 +111,21 @@ namespace VoxelCraft {
     /**
      * @struct PacketHeader
      * @brief Cabecera de paquete
+     *
+     * En el cable ocupa WIRE_SIZE bytes big-endian (magic, packetType, flags,
+     * packetSize, sequenceNumber, ackNumber, connectionId); el timestamp es
+     * local y no se envía.
      */
     struct PacketHeader {
+        static constexpr size_t WIRE_SIZE = 24;
+
         uint32_t magic = 0xDEADBEEF;           ///< Número mágico para validación
-        uint16_t packetType;                   ///< Tipo de paquete
-        uint32_t packetSize;                   ///< Tamaño total del paquete
-        uint32_t sequenceNumber;               ///< Número de secuencia
-        uint32_t ackNumber;                    ///< Número de ACK
-        uint16_t flags;                        ///< Flags del paquete
-        uint32_t connectionId;                 ///< ID de conexión
+        uint16_t packetType = 0;               ///< Tipo de paquete
+        uint32_t packetSize = 0;               ///< Tamaño total del paquete (cabecera incluida)
+        uint32_t sequenceNumber = 0;           ///< Número de secuencia
+        uint32_t ackNumber = 0;                ///< Número de ACK
+        uint16_t flags = 0;                    ///< Flags del paquete
+        uint32_t connectionId = 0;             ///< ID de conexión
         std::chrono::steady_clock::time_point timestamp; ///< Timestamp
 
         // Flags
@@ -166,6 +177,12 @@ namespace VoxelCraft {
     /**
      * @class Packet
      * @brief Clase base para todos los paquetes de red
+     *
+     * Serialize escribe los datos directamente en un PacketBuffer del pool y
+     * antepone la cabecera en su zona reservada: GetBuffer es el frame
+     * completo, listo para compartirse entre todos los destinatarios de un
+     * broadcast sin volver a serializar ni copiar. Deserialize lee con un
+     * PacketReader sobre los bytes recibidos, sin copiarlos.
      */
     class Packet {
     public:
@@ -180,12 +197,13 @@ namespace VoxelCraft {
         virtual ~Packet() = default;
 
         // Getters
-        PacketType GetType() const { return m_header.packetType; }
+        PacketType GetType() const { return static_cast<PacketType>(m_header.packetType); }
         PacketPriority GetPriority() const { return m_priority; }
         const PacketHeader& GetHeader() const { return m_header; }
         PacketHeader& GetHeader() { return m_header; }
-        size_t GetSize() const { return m_data.size(); }
-        const std::vector<uint8_t>& GetData() const { return m_data; }
+        size_t GetSize() const { return m_buffer.Size() - m_buffer.PrependedSize(); }  ///< Bytes de datos
+        std::span<const uint8_t> GetPayload() const { return m_buffer.Span().subspan(m_buffer.PrependedSize()); }
+        const PacketBuffer& GetBuffer() const { return m_buffer; }      ///< Frame serializado (cabecera + datos)
         bool IsReliable() const { return m_header.IsReliable(); }
         bool IsOrdered() const { return m_header.IsOrdered(); }
         uint32_t GetSequenceNumber() const { return m_header.sequenceNumber; }
@@ -204,9 +222,9 @@ namespace VoxelCraft {
 
         // Serialización
         virtual bool Serialize();
-        virtual bool Deserialize(const std::vector<uint8_t>& data);
+        virtual bool Deserialize(std::span<const uint8_t> data);
         virtual std::vector<uint8_t> ToBytes() const;
-        static std::shared_ptr<Packet> FromBytes(const std::vector<uint8_t>& data);
+        static std::shared_ptr<Packet> FromBytes(std::span<const uint8_t> data);
 
         // Utilidades
         virtual std::string GetName() const;
@@ -214,7 +232,13 @@ namespace VoxelCraft {
         bool IsValid() const;
 
         // Compresión y encriptación
-        bool Compress();
+
+        /**
+         * @brief Comprimir los datos serializados con PacketCompression
+         * @return true si quedaron comprimidos; bajo el umbral o sin ganancia se dejan tal cual
+         */
+        bool Compress(const PacketCompressionSettings& settings);
+        bool Compress();                    ///< LZ4 sin diccionario, umbral por defecto
         bool Decompress();
         bool Encrypt(const std::string& key);
         bool Decrypt(const std::string& key);
@@ -222,13 +246,17 @@ namespace VoxelCraft {
     protected:
         PacketHeader m_header;
         PacketPriority m_priority;
-        std::vector<uint8_t> m_data;
-        std::vector<uint8_t> m_originalData; // Para descompresión/desencriptación
+        PacketBuffer m_buffer;              ///< Cabecera en la zona reservada + datos
 
         // Métodos virtuales para subclases
         virtual void WriteData() = 0;
         virtual void ReadData() = 0;
 
+        /**
+         * @brief Tamaño previsto de los datos, para reservar el bloque adecuado del pool
+         */
+        virtual size_t GetSizeHint() const { return 64; }
+
         // Utilidades de serialización
         void WriteInt8(int8_t value);
         void WriteInt16(int16_t value);
@@ -241,7 +269,7 @@ namespace VoxelCraft {
         void WriteFloat(float value);
         void WriteDouble(double value);
         void WriteString(const std::string& value);
-        void WriteBytes(const std::vector<uint8_t>& value);
+        void WriteBytes(std::span<const uint8_t> value);
         void WriteBool(bool value);
 
         int8_t ReadInt8();
@@ -255,15 +283,17 @@ namespace VoxelCraft {
         float ReadFloat();
         double ReadDouble();
         std::string ReadString();
-        std::vector<uint8_t> ReadBytes(size_t length);
+        std::span<const uint8_t> ReadBytes(size_t length);   ///< Válido mientras dure ReadData
         bool ReadBool();
 
     private:
-        size_t m_readPosition = 0;
+        PacketReader m_reader;
 
         // Utilidades internas
         bool ValidateHeader() const;
         void UpdateHeader();
+        void WriteHeader(uint8_t* out) const;
+        static bool ReadHeader(PacketReader& reader, PacketHeader& header);
         static PacketType GetPacketTypeFromId(uint16_t id);
         static uint16_t GetPacketIdFromType(PacketType type);
     };
@@ -405,6 +435,7 @@ namespace VoxelCraft {
     protected:
         void WriteData() override;
         void ReadData() override;
+        size_t GetSizeHint() const override { return 16 + m_data.size(); }
 
     private:
         int32_t m_chunkX, m_chunkZ;
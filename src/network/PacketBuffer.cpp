@@ -0,0 +1,243 @@
+/**
+ * @file PacketBuffer.cpp
+ * @brief VoxelCraft Pooled Packet Buffer Implementation
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#include "PacketBuffer.hpp"
+
+#include <algorithm>
+#include <new>
+
+namespace VoxelCraft {
+
+    // PacketBuffer implementation
+    PacketBuffer::PacketBuffer(const PacketBuffer& other)
+        : m_block(other.m_block) {
+        if (m_block) {
+            m_block->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    PacketBuffer& PacketBuffer::operator=(const PacketBuffer& other) {
+        if (m_block != other.m_block) {
+            if (other.m_block) {
+                other.m_block->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+            Reset();
+            m_block = other.m_block;
+        }
+        return *this;
+    }
+
+    PacketBuffer& PacketBuffer::operator=(PacketBuffer&& other) noexcept {
+        if (this != &other) {
+            Reset();
+            m_block = other.m_block;
+            other.m_block = nullptr;
+        }
+        return *this;
+    }
+
+    PacketBuffer PacketBuffer::Allocate(size_t capacity) {
+        return PacketBufferPool::Default().Acquire(capacity);
+    }
+
+    void PacketBuffer::Reset() {
+        if (!m_block) {
+            return;
+        }
+        if (m_block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            m_block->pool->ReleaseBlock(m_block);
+        }
+        m_block = nullptr;
+    }
+
+    uint8_t* PacketBuffer::Prepend(size_t size) {
+        if (!m_block) {
+            *this = Allocate(0);
+        }
+        MakeUnique();
+        if (size > m_block->begin) {
+            return nullptr;
+        }
+        m_block->begin -= size;
+        return Storage(m_block) + m_block->begin;
+    }
+
+    void PacketBuffer::Clear() {
+        if (!m_block) {
+            return;
+        }
+        if (IsShared()) {
+            Reset();
+            return;
+        }
+        m_block->begin = HEADER_RESERVE;
+        m_block->end = HEADER_RESERVE;
+    }
+
+    void PacketBuffer::MakeUnique() {
+        if (!m_block || !IsShared()) {
+            return;
+        }
+
+        Block* block = m_block->pool->AcquireBlock(m_block->end);
+        block->begin = m_block->begin;
+        block->end = m_block->end;
+        std::memcpy(Storage(block) + block->begin, Storage(m_block) + m_block->begin, m_block->end - m_block->begin);
+        Reset();
+        m_block = block;
+    }
+
+    void PacketBuffer::Grow(size_t extra) {
+        PacketBufferPool& pool = m_block ? *m_block->pool : PacketBufferPool::Default();
+        if (!m_block) {
+            m_block = pool.AcquireBlock(HEADER_RESERVE + extra);
+            return;
+        }
+
+        // Un bloque compartido en el que aún cabe solo se copia; si no cabe, se dobla
+        const size_t required = m_block->end + extra;
+        const bool grows = required > m_block->capacity;
+        Block* block = pool.AcquireBlock(grows ? std::max(required, m_block->capacity * 2) : m_block->capacity);
+
+        // Mantener los mismos desplazamientos para que la zona de Prepend siga igual
+        block->begin = m_block->begin;
+        block->end = m_block->end;
+        std::memcpy(Storage(block) + block->begin, Storage(m_block) + m_block->begin, m_block->end - m_block->begin);
+        if (grows) {
+            pool.m_growths.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Reset();
+        m_block = block;
+    }
+
+    // PacketBufferPool implementation
+    PacketBufferPool::PacketBufferPool(size_t maxCachedPerClass)
+        : m_maxCachedPerClass(maxCachedPerClass)
+        , m_acquires(0)
+        , m_reuses(0)
+        , m_heapAllocations(0)
+        , m_heapFrees(0)
+        , m_oversizeAllocations(0)
+        , m_growths(0)
+    {
+    }
+
+    PacketBufferPool::~PacketBufferPool() {
+        Trim();
+    }
+
+    PacketBufferPool& PacketBufferPool::Default() {
+        // Sin destructor: los buffers pueden soltarse durante la destrucción estática
+        static PacketBufferPool* pool = new PacketBufferPool();
+        return *pool;
+    }
+
+    PacketBuffer PacketBufferPool::Acquire(size_t capacity) {
+        return PacketBuffer(AcquireBlock(PacketBuffer::HEADER_RESERVE + capacity));
+    }
+
+    PacketBuffer::Block* PacketBufferPool::AcquireBlock(size_t storage) {
+        m_acquires.fetch_add(1, std::memory_order_relaxed);
+
+        uint32_t sizeClass = 0;
+        while (sizeClass < SIZE_CLASS_COUNT && SIZE_CLASSES[sizeClass] < storage) {
+            sizeClass++;
+        }
+
+        PacketBuffer::Block* block = nullptr;
+        if (sizeClass < SIZE_CLASS_COUNT) {
+            FreeList& list = m_freeLists[sizeClass];
+            std::lock_guard<std::mutex> lock(list.mutex);
+            if (list.head) {
+                block = list.head;
+                list.head = block->next;
+                list.count--;
+            }
+        }
+
+        if (block) {
+            m_reuses.fetch_add(1, std::memory_order_relaxed);
+            block->refs.store(1, std::memory_order_relaxed);
+            block->begin = PacketBuffer::HEADER_RESERVE;
+            block->end = PacketBuffer::HEADER_RESERVE;
+            block->next = nullptr;
+            return block;
+        }
+
+        const size_t capacity = sizeClass < SIZE_CLASS_COUNT ? SIZE_CLASSES[sizeClass] : storage;
+        void* memory = ::operator new(sizeof(PacketBuffer::Block) + capacity);
+        block = new (memory) PacketBuffer::Block();
+        block->sizeClass = sizeClass;
+        block->capacity = capacity;
+        block->pool = this;
+
+        m_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+        if (sizeClass == OVERSIZE) {
+            m_oversizeAllocations.fetch_add(1, std::memory_order_relaxed);
+        }
+        return block;
+    }
+
+    void PacketBufferPool::ReleaseBlock(PacketBuffer::Block* block) {
+        if (block->sizeClass < SIZE_CLASS_COUNT) {
+            FreeList& list = m_freeLists[block->sizeClass];
+            std::lock_guard<std::mutex> lock(list.mutex);
+            if (list.count < m_maxCachedPerClass) {
+                block->next = list.head;
+                list.head = block;
+                list.count++;
+                return;
+            }
+        }
+
+        m_heapFrees.fetch_add(1, std::memory_order_relaxed);
+        FreeBlock(block);
+    }
+
+    void PacketBufferPool::FreeBlock(PacketBuffer::Block* block) {
+        block->~Block();
+        ::operator delete(static_cast<void*>(block));
+    }
+
+    void PacketBufferPool::Trim() {
+        for (FreeList& list : m_freeLists) {
+            PacketBuffer::Block* head;
+            {
+                std::lock_guard<std::mutex> lock(list.mutex);
+                head = list.head;
+                list.head = nullptr;
+                list.count = 0;
+            }
+            while (head) {
+                PacketBuffer::Block* next = head->next;
+                m_heapFrees.fetch_add(1, std::memory_order_relaxed);
+                FreeBlock(head);
+                head = next;
+            }
+        }
+    }
+
+    PacketBufferPoolStats PacketBufferPool::GetStats() const {
+        PacketBufferPoolStats stats;
+        stats.acquires = m_acquires.load(std::memory_order_relaxed);
+        stats.reuses = m_reuses.load(std::memory_order_relaxed);
+        stats.heapAllocations = m_heapAllocations.load(std::memory_order_relaxed);
+        stats.heapFrees = m_heapFrees.load(std::memory_order_relaxed);
+        stats.oversizeAllocations = m_oversizeAllocations.load(std::memory_order_relaxed);
+        stats.growths = m_growths.load(std::memory_order_relaxed);
+
+        for (size_t i = 0; i < SIZE_CLASS_COUNT; ++i) {
+            const FreeList& list = m_freeLists[i];
+            std::lock_guard<std::mutex> lock(list.mutex);
+            stats.cachedBlocks += list.count;
+            stats.cachedBytes += list.count * SIZE_CLASSES[i];
+        }
+        return stats;
+    }
+
+} // namespace VoxelCraft
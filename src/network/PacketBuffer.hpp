@@ -0,0 +1,306 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <span>
+#include <string_view>
+
+namespace VoxelCraft {
+
+    class PacketBufferPool;
+
+    /**
+     * @class PacketBuffer
+     * @brief Buffer de paquete con conteo de referencias y memoria de un pool
+     *
+     * Un paquete se escribe una sola vez, en su sitio: los datos se añaden al
+     * final con Append y las cabeceras se anteponen con Prepend en una zona
+     * reservada al principio, sin mover el contenido. Copiar un PacketBuffer
+     * solo incrementa la referencia, de modo que el mismo frame se comparte
+     * en solo lectura entre las colas de envío de todos los destinatarios.
+     * Al soltar la última referencia el bloque vuelve a su pool.
+     *
+     * Escribir (Append, Write*, Truncate, Prepend, MutableData) nunca toca
+     * un bloque compartido: antes se copia, igual que MakeUnique, así que
+     * los frames ya encolados en otras conexiones no cambian. El conteo es
+     * atómico, así que las referencias pueden soltarse desde cualquier hilo.
+     */
+    class PacketBuffer {
+    public:
+        static constexpr size_t HEADER_RESERVE = 32;    ///< Bytes reservados para Prepend
+
+        PacketBuffer() = default;
+        PacketBuffer(const PacketBuffer& other);
+        PacketBuffer(PacketBuffer&& other) noexcept : m_block(other.m_block) { other.m_block = nullptr; }
+        PacketBuffer& operator=(const PacketBuffer& other);
+        PacketBuffer& operator=(PacketBuffer&& other) noexcept;
+        ~PacketBuffer() { Reset(); }
+
+        /**
+         * @brief Reservar un buffer del pool por defecto
+         * @param capacity Bytes de datos previstos (sin contar HEADER_RESERVE)
+         */
+        static PacketBuffer Allocate(size_t capacity);
+
+        explicit operator bool() const { return m_block != nullptr; }
+
+        /**
+         * @brief Soltar la referencia
+         */
+        void Reset();
+
+        // Contenido: cabeceras antepuestas + datos
+        const uint8_t* Data() const { return m_block ? Storage(m_block) + m_block->begin : nullptr; }
+        size_t Size() const { return m_block ? m_block->end - m_block->begin : 0; }
+        std::span<const uint8_t> Span() const { return { Data(), Size() }; }
+
+        /**
+         * @brief Bytes añadidos con Prepend
+         */
+        size_t PrependedSize() const { return m_block ? HEADER_RESERVE - m_block->begin : 0; }
+
+        size_t Capacity() const { return m_block ? m_block->capacity - HEADER_RESERVE : 0; }
+        uint32_t UseCount() const { return m_block ? m_block->refs.load(std::memory_order_acquire) : 0; }
+        bool IsShared() const { return UseCount() > 1; }
+
+        /**
+         * @brief Hueco de size bytes al final; crece a un bloque mayor si no cabe
+         * @return Puntero donde escribir
+         */
+        uint8_t* Append(size_t size) {
+            if (!m_block || m_block->end + size > m_block->capacity || IsShared()) {
+                Grow(size);
+            }
+            uint8_t* out = Storage(m_block) + m_block->end;
+            m_block->end += size;
+            return out;
+        }
+
+        void Append(const void* data, size_t size) {
+            if (size > 0) {
+                std::memcpy(Append(size), data, size);
+            }
+        }
+
+        // Escritores big-endian (orden de red)
+        void WriteUInt8(uint8_t value) { *Append(1) = value; }
+        void WriteUInt16(uint16_t value) { StoreBE(Append(2), value, 2); }
+        void WriteUInt32(uint32_t value) { StoreBE(Append(4), value, 4); }
+        void WriteUInt64(uint64_t value) { StoreBE(Append(8), value, 8); }
+
+        /**
+         * @brief Recortar los datos a size bytes (tras reservar de más con Append)
+         */
+        void Truncate(size_t size) {
+            if (m_block && size < Size()) {
+                MakeUnique();
+                m_block->end = m_block->begin + size;
+            }
+        }
+
+        /**
+         * @brief Anteponer size bytes usando la zona reservada
+         * @return Puntero donde escribir, o nullptr si la reserva no alcanza
+         */
+        uint8_t* Prepend(size_t size);
+
+        /**
+         * @brief Descartar los datos (conserva el bloque si no está compartido)
+         */
+        void Clear();
+
+        /**
+         * @brief Copiar el bloque si está compartido
+         */
+        void MakeUnique();
+
+        /**
+         * @brief Contenido modificable; copia antes si estaba compartido
+         */
+        uint8_t* MutableData() {
+            MakeUnique();
+            return m_block ? Storage(m_block) + m_block->begin : nullptr;
+        }
+
+        static void StoreBE(uint8_t* out, uint64_t value, size_t bytes) {
+            for (size_t i = 0; i < bytes; ++i) {
+                out[i] = static_cast<uint8_t>(value >> ((bytes - 1 - i) * 8));
+            }
+        }
+
+    private:
+        friend class PacketBufferPool;
+
+        /**
+         * @struct Block
+         * @brief Cabecera del bloque; los datos van a continuación
+         */
+        struct Block {
+            std::atomic<uint32_t> refs{1};
+            uint32_t sizeClass = 0;         ///< Índice de clase en el pool (o OVERSIZE)
+            size_t capacity = 0;            ///< Bytes de almacenamiento tras la cabecera
+            size_t begin = HEADER_RESERVE;  ///< Inicio del contenido
+            size_t end = HEADER_RESERVE;    ///< Fin del contenido
+            PacketBufferPool* pool = nullptr;
+            Block* next = nullptr;          ///< Lista libre del pool
+        };
+
+        explicit PacketBuffer(Block* block) : m_block(block) {}
+
+        static uint8_t* Storage(Block* block) { return reinterpret_cast<uint8_t*>(block + 1); }
+        static const uint8_t* Storage(const Block* block) { return reinterpret_cast<const uint8_t*>(block + 1); }
+
+        /**
+         * @brief Pasar a un bloque propio con sitio para extra bytes más
+         */
+        void Grow(size_t extra);
+
+        Block* m_block = nullptr;
+    };
+
+    /**
+     * @struct PacketBufferPoolStats
+     * @brief Contadores del pool desde su creación
+     */
+    struct PacketBufferPoolStats {
+        uint64_t acquires = 0;              ///< Bloques entregados
+        uint64_t reuses = 0;                ///< ...de ellos, sacados de una lista libre
+        uint64_t heapAllocations = 0;       ///< Bloques pedidos al sistema
+        uint64_t heapFrees = 0;
+        uint64_t oversizeAllocations = 0;   ///< Mayores que la clase más grande (no se reciclan)
+        uint64_t growths = 0;               ///< Append que tuvo que pasar a un bloque mayor
+        uint64_t cachedBlocks = 0;          ///< En listas libres ahora mismo
+        uint64_t cachedBytes = 0;
+    };
+
+    /**
+     * @class PacketBufferPool
+     * @brief Listas libres de bloques por clases de tamaño
+     *
+     * Clases de 256 B a 64 KiB (incluida la zona reservada de cabecera).
+     * Cada clase guarda como mucho maxCachedPerClass bloques libres; los
+     * bloques de más vuelven al sistema. Thread-safe.
+     */
+    class PacketBufferPool {
+    public:
+        static constexpr size_t SIZE_CLASS_COUNT = 5;
+        static constexpr size_t SIZE_CLASSES[SIZE_CLASS_COUNT] = { 256, 1024, 4096, 16384, 65536 };
+
+        explicit PacketBufferPool(size_t maxCachedPerClass = 1024);
+        ~PacketBufferPool();
+
+        PacketBufferPool(const PacketBufferPool&) = delete;
+        PacketBufferPool& operator=(const PacketBufferPool&) = delete;
+
+        /**
+         * @brief Pool del proceso (nunca se destruye)
+         */
+        static PacketBufferPool& Default();
+
+        /**
+         * @brief Buffer vacío con al menos capacity bytes de datos
+         */
+        PacketBuffer Acquire(size_t capacity);
+
+        /**
+         * @brief Devolver al sistema todos los bloques libres
+         */
+        void Trim();
+
+        PacketBufferPoolStats GetStats() const;
+
+    private:
+        friend class PacketBuffer;
+
+        static constexpr uint32_t OVERSIZE = static_cast<uint32_t>(SIZE_CLASS_COUNT);
+
+        struct FreeList {
+            mutable std::mutex mutex;
+            PacketBuffer::Block* head = nullptr;
+            size_t count = 0;
+        };
+
+        PacketBuffer::Block* AcquireBlock(size_t storage);
+        void ReleaseBlock(PacketBuffer::Block* block);
+        static void FreeBlock(PacketBuffer::Block* block);
+
+        size_t m_maxCachedPerClass;
+        FreeList m_freeLists[SIZE_CLASS_COUNT];
+
+        std::atomic<uint64_t> m_acquires;
+        std::atomic<uint64_t> m_reuses;
+        std::atomic<uint64_t> m_heapAllocations;
+        std::atomic<uint64_t> m_heapFrees;
+        std::atomic<uint64_t> m_oversizeAllocations;
+        std::atomic<uint64_t> m_growths;
+    };
+
+    /**
+     * @class PacketReader
+     * @brief Cursor de lectura big-endian sobre un tramo de bytes
+     *
+     * No copia ni posee los datos: el tramo debe seguir vivo mientras se
+     * lee. Leer más allá del final devuelve ceros (o tramos vacíos) y deja
+     * HasError activo.
+     */
+    class PacketReader {
+    public:
+        PacketReader() = default;
+        explicit PacketReader(std::span<const uint8_t> data) : m_data(data) {}
+
+        uint8_t ReadUInt8() { return static_cast<uint8_t>(ReadBE(1)); }
+        uint16_t ReadUInt16() { return static_cast<uint16_t>(ReadBE(2)); }
+        uint32_t ReadUInt32() { return static_cast<uint32_t>(ReadBE(4)); }
+        uint64_t ReadUInt64() { return ReadBE(8); }
+
+        /**
+         * @brief Siguientes size bytes sin copiarlos
+         */
+        std::span<const uint8_t> ReadSpan(size_t size) {
+            if (size > Remaining()) {
+                m_error = true;
+                m_position = m_data.size();
+                return {};
+            }
+            std::span<const uint8_t> result = m_data.subspan(m_position, size);
+            m_position += size;
+            return result;
+        }
+
+        /**
+         * @brief Cadena con prefijo de longitud u16, sin copiarla
+         */
+        std::string_view ReadStringView() {
+            const uint16_t length = ReadUInt16();
+            std::span<const uint8_t> bytes = ReadSpan(length);
+            return { reinterpret_cast<const char*>(bytes.data()), bytes.size() };
+        }
+
+        size_t Position() const { return m_position; }
+        size_t Remaining() const { return m_data.size() - m_position; }
+        bool HasError() const { return m_error; }
+
+    private:
+        uint64_t ReadBE(size_t bytes) {
+            if (bytes > Remaining()) {
+                m_error = true;
+                m_position = m_data.size();
+                return 0;
+            }
+            uint64_t value = 0;
+            for (size_t i = 0; i < bytes; ++i) {
+                value = (value << 8) | m_data[m_position + i];
+            }
+            m_position += bytes;
+            return value;
+        }
+
+        std::span<const uint8_t> m_data;
+        size_t m_position = 0;
+        bool m_error = false;
+    };
+
+} // namespace VoxelCraft
@@ -0,0 +1,428 @@
+/**
+ * @file PacketCompression.cpp
+ * @brief VoxelCraft Packet Compression Implementation
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#include "PacketCompression.hpp"
+#include "../world/ChunkCodec.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+
+namespace VoxelCraft {
+
+    namespace {
+
+        // Entrenamiento: k-gramas de TRAIN_KMER bytes, segmentos de TRAIN_SEGMENT
+        constexpr size_t TRAIN_KMER = 6;
+        constexpr size_t TRAIN_SEGMENT = 48;
+        constexpr uint32_t TRAIN_HASH_BITS = 20;
+
+        struct CompressionCounters {
+            std::atomic<uint64_t> compressions{0};
+            std::atomic<uint64_t> skippedBelowThreshold{0};
+            std::atomic<uint64_t> skippedNoGain{0};
+            std::atomic<uint64_t> rawBytes{0};
+            std::atomic<uint64_t> compressedBytes{0};
+            std::atomic<uint64_t> compressNanoseconds{0};
+            std::atomic<uint64_t> decompressions{0};
+            std::atomic<uint64_t> decompressNanoseconds{0};
+            std::atomic<uint64_t> failures{0};
+        };
+
+        CompressionCounters g_counters;
+
+        struct DictionaryRegistry {
+            std::mutex mutex;
+            std::unordered_map<uint32_t, std::shared_ptr<const PacketDictionary>> dictionaries;
+        };
+
+        DictionaryRegistry& GetRegistry() {
+            // Sin destructor: los codecs guardan por hilo punteros a los bytes
+            static DictionaryRegistry* registry = new DictionaryRegistry();
+            return *registry;
+        }
+
+        uint64_t ElapsedNanoseconds(std::chrono::steady_clock::time_point start) {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count());
+        }
+
+        uint32_t HashKmer(const uint8_t* p) {
+            uint64_t value = 0;
+            std::memcpy(&value, p, TRAIN_KMER);
+            return static_cast<uint32_t>((value * 0x9E3779B97F4A7C15ull) >> (64 - TRAIN_HASH_BITS));
+        }
+
+    } // namespace
+
+    // PacketCompressionOffer implementation
+    bool PacketCompressionOffer::HasDictionary(uint32_t id) const {
+        return std::find(dictionaryIds.begin(), dictionaryIds.end(), id) != dictionaryIds.end();
+    }
+
+    // PacketDictionary implementation
+    PacketDictionary::PacketDictionary(std::vector<uint8_t> bytes)
+        : m_id(ComputeId(bytes))
+        , m_bytes(std::move(bytes))
+    {
+    }
+
+    uint32_t PacketDictionary::ComputeId(std::span<const uint8_t> bytes) {
+        uint32_t hash = 2166136261u;
+        for (uint8_t byte : bytes) {
+            hash = (hash ^ byte) * 16777619u;
+        }
+        return hash != 0 ? hash : 1;
+    }
+
+    PacketDictionary PacketDictionary::Train(std::span<const std::span<const uint8_t>> samples, size_t maxSize) {
+        maxSize = std::min(maxSize, MAX_SIZE);
+
+        // Frecuencia de cada k-grama = muestras distintas que lo contienen.
+        // Tabla hash sin resolver colisiones: es una heurística y así cabe en 8 MiB.
+        std::vector<uint32_t> frequency(size_t(1) << TRAIN_HASH_BITS, 0);
+        std::vector<uint32_t> lastSample(frequency.size(), UINT32_MAX);
+        for (size_t s = 0; s < samples.size(); ++s) {
+            const std::span<const uint8_t> sample = samples[s];
+            for (size_t i = 0; i + TRAIN_KMER <= sample.size(); ++i) {
+                const uint32_t hash = HashKmer(sample.data() + i);
+                if (lastSample[hash] != s) {
+                    lastSample[hash] = static_cast<uint32_t>(s);
+                    frequency[hash]++;
+                }
+            }
+        }
+
+        struct Segment {
+            uint64_t score;
+            const uint8_t* data;
+        };
+        std::vector<Segment> chosen;
+
+        // Las muestras se reparten en épocas; cada época aporta sus mejores segmentos
+        const size_t segmentCount = std::max<size_t>(1, maxSize / TRAIN_SEGMENT);
+        const size_t epochs = std::min(segmentCount, samples.size());
+        const size_t picksPerEpoch = epochs > 0 ? (segmentCount + epochs - 1) / epochs : 0;
+        std::vector<uint32_t> scores;
+
+        for (size_t epoch = 0; epoch < epochs; ++epoch) {
+            const size_t first = epoch * samples.size() / epochs;
+            const size_t last = (epoch + 1) * samples.size() / epochs;
+
+            for (size_t pick = 0; pick < picksPerEpoch && chosen.size() < segmentCount; ++pick) {
+                Segment best{ 0, nullptr };
+
+                for (size_t s = first; s < last; ++s) {
+                    const std::span<const uint8_t> sample = samples[s];
+                    if (sample.size() < TRAIN_SEGMENT) {
+                        continue;
+                    }
+
+                    // Un k-grama que solo está en una muestra no ayuda a las demás
+                    const size_t positions = sample.size() - TRAIN_KMER + 1;
+                    scores.resize(positions);
+                    for (size_t i = 0; i < positions; ++i) {
+                        const uint32_t count = frequency[HashKmer(sample.data() + i)];
+                        scores[i] = count > 1 ? count - 1 : 0;
+                    }
+
+                    // Ventana deslizante sobre los k-gramas que caben en un segmento
+                    constexpr size_t window = TRAIN_SEGMENT - TRAIN_KMER + 1;
+                    uint64_t score = 0;
+                    for (size_t i = 0; i < window; ++i) {
+                        score += scores[i];
+                    }
+                    for (size_t start = 0;; ++start) {
+                        if (score > best.score) {
+                            best = { score, sample.data() + start };
+                        }
+                        if (start + window >= positions) {
+                            break;
+                        }
+                        score += scores[start + window];
+                        score -= scores[start];
+                    }
+                }
+
+                if (!best.data) {
+                    break;
+                }
+
+                // Cubrir: lo ya incluido no vuelve a puntuar
+                for (size_t i = 0; i + TRAIN_KMER <= TRAIN_SEGMENT; ++i) {
+                    frequency[HashKmer(best.data + i)] = 0;
+                }
+                chosen.push_back(best);
+            }
+        }
+
+        // Los más valiosos al final: quedan a menor distancia de los datos
+        std::stable_sort(chosen.begin(), chosen.end(), [](const Segment& a, const Segment& b) {
+            return a.score < b.score;
+        });
+
+        std::vector<uint8_t> bytes;
+        bytes.reserve(chosen.size() * TRAIN_SEGMENT);
+        for (const Segment& segment : chosen) {
+            bytes.insert(bytes.end(), segment.data, segment.data + TRAIN_SEGMENT);
+        }
+        return PacketDictionary(std::move(bytes));
+    }
+
+    // PacketCompression implementation
+    uint8_t PacketCompression::GetAvailableCodecs() {
+        uint8_t codecs = 0;
+        for (PacketCodec codec : { PacketCodec::LZ4, PacketCodec::DEFLATE, PacketCodec::ZSTD }) {
+            if (IsAvailable(codec)) {
+                codecs |= static_cast<uint8_t>(1u << static_cast<uint8_t>(codec));
+            }
+        }
+        return codecs;
+    }
+
+    bool PacketCompression::IsAvailable(PacketCodec codec) {
+        return ChunkCompression::GetCodec(static_cast<ChunkCodecType>(codec)) != nullptr;
+    }
+
+    const char* PacketCompression::GetName(PacketCodec codec) {
+        return ChunkCompression::GetName(static_cast<ChunkCodecType>(codec));
+    }
+
+    uint32_t PacketCompression::RegisterDictionary(std::shared_ptr<const PacketDictionary> dictionary) {
+        DictionaryRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        const uint32_t id = dictionary->GetId();
+        registry.dictionaries.emplace(id, std::move(dictionary));
+        return id;
+    }
+
+    std::shared_ptr<const PacketDictionary> PacketCompression::FindDictionary(uint32_t id) {
+        DictionaryRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto it = registry.dictionaries.find(id);
+        return it != registry.dictionaries.end() ? it->second : nullptr;
+    }
+
+    std::vector<uint32_t> PacketCompression::GetDictionaryIds() {
+        DictionaryRegistry& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        std::vector<uint32_t> ids;
+        ids.reserve(registry.dictionaries.size());
+        for (const auto& pair : registry.dictionaries) {
+            ids.push_back(pair.first);
+        }
+        return ids;
+    }
+
+    bool PacketCompression::Compress(const PacketCompressionSettings& settings, std::span<const uint8_t> data, PacketBuffer& out) {
+        if (!settings.IsEnabled()) {
+            return false;
+        }
+        if (data.size() < settings.threshold || data.size() <= FRAME_HEADER_SIZE + 1) {
+            g_counters.skippedBelowThreshold.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        if (data.size() > MAX_RAW_SIZE) {
+            return false;
+        }
+
+        const ChunkCodec* codec = ChunkCompression::GetCodec(static_cast<ChunkCodecType>(settings.codec));
+        std::shared_ptr<const PacketDictionary> dictionary;
+        if (settings.dictionaryId != 0) {
+            dictionary = FindDictionary(settings.dictionaryId);
+        }
+        if (!codec || (settings.dictionaryId != 0 && !dictionary)) {
+            g_counters.failures.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const int level = settings.level != 0 ? settings.level : codec->GetFastLevel();
+
+        // Solo sirve si ocupa menos; con ese límite el codec se rinde en cuanto no cabe
+        const size_t capacity = data.size() - FRAME_HEADER_SIZE - 1;
+        PacketBuffer frame = PacketBuffer::Allocate(FRAME_HEADER_SIZE + capacity);
+        uint8_t* header = frame.Append(FRAME_HEADER_SIZE + capacity);
+
+        size_t written;
+        if (dictionary) {
+            std::span<const uint8_t> bytes = dictionary->GetBytes();
+            written = codec->CompressWithDictionary(data.data(), data.size(), header + FRAME_HEADER_SIZE, capacity, level,
+                bytes.data(), bytes.size());
+        } else {
+            written = codec->Compress(data.data(), data.size(), header + FRAME_HEADER_SIZE, capacity, level);
+        }
+
+        if (written == 0) {
+            g_counters.skippedNoGain.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        frame.Truncate(FRAME_HEADER_SIZE + written);
+        header[0] = static_cast<uint8_t>(settings.codec);
+        PacketBuffer::StoreBE(header + 1, settings.dictionaryId, 4);
+        PacketBuffer::StoreBE(header + 5, data.size(), 4);
+
+        g_counters.compressions.fetch_add(1, std::memory_order_relaxed);
+        g_counters.rawBytes.fetch_add(data.size(), std::memory_order_relaxed);
+        g_counters.compressedBytes.fetch_add(frame.Size(), std::memory_order_relaxed);
+        g_counters.compressNanoseconds.fetch_add(ElapsedNanoseconds(start), std::memory_order_relaxed);
+
+        out = std::move(frame);
+        return true;
+    }
+
+    bool PacketCompression::Decompress(std::span<const uint8_t> frame, PacketBuffer& out) {
+        const auto start = std::chrono::steady_clock::now();
+
+        PacketReader reader(frame);
+        const uint8_t codecId = reader.ReadUInt8();
+        const uint32_t dictionaryId = reader.ReadUInt32();
+        const uint32_t rawSize = reader.ReadUInt32();
+
+        const ChunkCodec* codec = ChunkCompression::GetCodec(static_cast<ChunkCodecType>(codecId));
+        std::shared_ptr<const PacketDictionary> dictionary;
+        if (dictionaryId != 0) {
+            dictionary = FindDictionary(dictionaryId);
+        }
+        if (reader.HasError() || !codec || rawSize == 0 || rawSize > MAX_RAW_SIZE || (dictionaryId != 0 && !dictionary)) {
+            g_counters.failures.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        const std::span<const uint8_t> payload = frame.subspan(FRAME_HEADER_SIZE);
+        PacketBuffer result = PacketBuffer::Allocate(rawSize);
+        uint8_t* dst = result.Append(rawSize);
+
+        bool decoded;
+        if (dictionary) {
+            std::span<const uint8_t> bytes = dictionary->GetBytes();
+            decoded = codec->DecompressWithDictionary(payload.data(), payload.size(), dst, rawSize, bytes.data(), bytes.size());
+        } else {
+            decoded = codec->Decompress(payload.data(), payload.size(), dst, rawSize);
+        }
+
+        if (!decoded) {
+            g_counters.failures.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        g_counters.decompressions.fetch_add(1, std::memory_order_relaxed);
+        g_counters.decompressNanoseconds.fetch_add(ElapsedNanoseconds(start), std::memory_order_relaxed);
+
+        out = std::move(result);
+        return true;
+    }
+
+    void PacketCompression::WriteOffer(PacketBuffer& out) {
+        std::vector<uint32_t> ids = GetDictionaryIds();
+        ids.resize(std::min<size_t>(ids.size(), UINT8_MAX));
+
+        out.WriteUInt8(GetAvailableCodecs());
+        out.WriteUInt8(static_cast<uint8_t>(ids.size()));
+        for (uint32_t id : ids) {
+            out.WriteUInt32(id);
+        }
+    }
+
+    bool PacketCompression::ReadOffer(PacketReader& reader, PacketCompressionOffer& offer) {
+        offer.codecs = reader.ReadUInt8();
+        const uint8_t count = reader.ReadUInt8();
+        offer.dictionaryIds.clear();
+        for (uint8_t i = 0; i < count && !reader.HasError(); ++i) {
+            offer.dictionaryIds.push_back(reader.ReadUInt32());
+        }
+        return !reader.HasError();
+    }
+
+    PacketCompressionSettings PacketCompression::Negotiate(const PacketCompressionOffer& offer,
+                                                           const PacketCompressionSettings& preferred) {
+        auto usable = [&offer](PacketCodec codec) {
+            return codec != PacketCodec::NONE && offer.Supports(codec) && IsAvailable(codec);
+        };
+
+        PacketCompressionSettings settings = preferred;
+        if (!usable(settings.codec)) {
+            settings.codec = PacketCodec::NONE;
+            settings.level = 0;
+            for (PacketCodec codec : { PacketCodec::LZ4, PacketCodec::ZSTD, PacketCodec::DEFLATE }) {
+                if (usable(codec)) {
+                    settings.codec = codec;
+                    break;
+                }
+            }
+        }
+
+        if (!settings.IsEnabled() || (settings.dictionaryId != 0 && !FindDictionary(settings.dictionaryId))) {
+            settings.dictionaryId = 0;
+        }
+        return settings;
+    }
+
+    void PacketCompression::WriteSettings(const PacketCompressionSettings& settings, bool includeDictionary, PacketBuffer& out) {
+        out.WriteUInt8(static_cast<uint8_t>(settings.codec));
+        out.WriteUInt32(settings.threshold);
+        out.WriteUInt32(settings.dictionaryId);
+
+        std::shared_ptr<const PacketDictionary> dictionary;
+        if (includeDictionary && settings.dictionaryId != 0) {
+            dictionary = FindDictionary(settings.dictionaryId);
+        }
+        if (dictionary) {
+            std::span<const uint8_t> bytes = dictionary->GetBytes();
+            out.WriteUInt32(static_cast<uint32_t>(bytes.size()));
+            out.Append(bytes.data(), bytes.size());
+        } else {
+            out.WriteUInt32(0);
+        }
+    }
+
+    bool PacketCompression::ReadSettings(PacketReader& reader, PacketCompressionSettings& settings) {
+        settings = PacketCompressionSettings();
+        settings.codec = static_cast<PacketCodec>(reader.ReadUInt8());
+        settings.threshold = reader.ReadUInt32();
+        settings.dictionaryId = reader.ReadUInt32();
+
+        const uint32_t dictionarySize = reader.ReadUInt32();
+        if (dictionarySize > PacketDictionary::MAX_SIZE) {
+            return false;
+        }
+        std::span<const uint8_t> bytes = reader.ReadSpan(dictionarySize);
+        if (reader.HasError()) {
+            return false;
+        }
+
+        if (!bytes.empty()) {
+            auto dictionary = std::make_shared<const PacketDictionary>(std::vector<uint8_t>(bytes.begin(), bytes.end()));
+            if (dictionary->GetId() != settings.dictionaryId) {
+                return false;
+            }
+            RegisterDictionary(std::move(dictionary));
+        }
+
+        // Hay que poder descomprimir lo que el otro lado vaya a mandar
+        return (!settings.IsEnabled() || IsAvailable(settings.codec))
+            && (settings.dictionaryId == 0 || FindDictionary(settings.dictionaryId) != nullptr);
+    }
+
+    PacketCompressionStats PacketCompression::GetStats() {
+        PacketCompressionStats stats;
+        stats.compressions = g_counters.compressions.load(std::memory_order_relaxed);
+        stats.skippedBelowThreshold = g_counters.skippedBelowThreshold.load(std::memory_order_relaxed);
+        stats.skippedNoGain = g_counters.skippedNoGain.load(std::memory_order_relaxed);
+        stats.rawBytes = g_counters.rawBytes.load(std::memory_order_relaxed);
+        stats.compressedBytes = g_counters.compressedBytes.load(std::memory_order_relaxed);
+        stats.compressNanoseconds = g_counters.compressNanoseconds.load(std::memory_order_relaxed);
+        stats.decompressions = g_counters.decompressions.load(std::memory_order_relaxed);
+        stats.decompressNanoseconds = g_counters.decompressNanoseconds.load(std::memory_order_relaxed);
+        stats.failures = g_counters.failures.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+} // namespace VoxelCraft
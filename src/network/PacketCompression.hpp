@@ -0,0 +1,196 @@
+#pragma once
+
+#include "PacketBuffer.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace VoxelCraft {
+
+    /**
+     * @enum PacketCodec
+     * @brief Algoritmo de compresión de paquetes (mismos valores que ChunkCodecType)
+     */
+    enum class PacketCodec : uint8_t {
+        NONE = 0,
+        LZ4 = 1,        ///< Rápido; siempre disponible (liblz4 o implementación propia)
+        DEFLATE = 2,    ///< Necesita zlib
+        ZSTD = 3        ///< Necesita libzstd
+    };
+
+    /**
+     * @struct PacketCompressionSettings
+     * @brief Compresión acordada con un cliente en el HANDSHAKE
+     */
+    struct PacketCompressionSettings {
+        PacketCodec codec = PacketCodec::NONE;
+        int level = 0;                      ///< 0 = nivel rápido del codec
+        uint32_t threshold = 256;           ///< Los datos más pequeños se envían sin comprimir
+        uint32_t dictionaryId = 0;          ///< Diccionario preentrenado (0 = ninguno)
+
+        bool IsEnabled() const { return codec != PacketCodec::NONE; }
+    };
+
+    /**
+     * @struct PacketCompressionOffer
+     * @brief Lo que un cliente sabe descomprimir, enviado en su HANDSHAKE
+     */
+    struct PacketCompressionOffer {
+        uint8_t codecs = 0;                     ///< Máscara de bits (1 << PacketCodec)
+        std::vector<uint32_t> dictionaryIds;    ///< Diccionarios que ya tiene
+
+        bool Supports(PacketCodec codec) const { return (codecs >> static_cast<uint8_t>(codec)) & 1; }
+        bool HasDictionary(uint32_t id) const;
+    };
+
+    /**
+     * @struct PacketCompressionStats
+     * @brief Contadores de compresión de paquetes desde el arranque
+     */
+    struct PacketCompressionStats {
+        uint64_t compressions = 0;
+        uint64_t skippedBelowThreshold = 0;     ///< Datos menores que threshold
+        uint64_t skippedNoGain = 0;             ///< Comprimidos no ocupaban menos
+        uint64_t rawBytes = 0;                  ///< Entrada de las compresiones
+        uint64_t compressedBytes = 0;           ///< Salida, con la cabecera de frame
+        uint64_t compressNanoseconds = 0;
+        uint64_t decompressions = 0;
+        uint64_t decompressNanoseconds = 0;
+        uint64_t failures = 0;                  ///< Frames corruptos o diccionario desconocido
+    };
+
+    /**
+     * @class PacketDictionary
+     * @brief Diccionario preentrenado que servidor y cliente comparten
+     *
+     * Los datos de un chunk son pequeños y muy parecidos entre sí (paletas,
+     * secciones uniformes, patrones de bits de piedra y aire), así que un
+     * diccionario con los fragmentos más comunes da al codec referencias
+     * desde el primer byte. El id es un hash del contenido: si dos lados
+     * tienen el mismo id, tienen los mismos bytes.
+     */
+    class PacketDictionary {
+    public:
+        static constexpr size_t DEFAULT_SIZE = 16 * 1024;
+        static constexpr size_t MAX_SIZE = 32 * 1024;           ///< Cabe en un frame de HANDSHAKE
+
+        explicit PacketDictionary(std::vector<uint8_t> bytes);
+
+        /**
+         * @brief Entrenar un diccionario con muestras de datos reales
+         *
+         * Elige los segmentos cuyos k-gramas aparecen en más muestras
+         * distintas, cubriendo cada k-grama una sola vez, y coloca los más
+         * valiosos al final, donde las referencias son más cortas.
+         * @param samples Muestras (p. ej. chunks serializados)
+         * @param maxSize Tamaño máximo del diccionario
+         */
+        static PacketDictionary Train(std::span<const std::span<const uint8_t>> samples, size_t maxSize = DEFAULT_SIZE);
+
+        /**
+         * @brief Id de unos bytes (FNV-1a, nunca 0)
+         */
+        static uint32_t ComputeId(std::span<const uint8_t> bytes);
+
+        uint32_t GetId() const { return m_id; }
+        std::span<const uint8_t> GetBytes() const { return m_bytes; }
+        size_t GetSize() const { return m_bytes.size(); }
+
+    private:
+        uint32_t m_id;
+        std::vector<uint8_t> m_bytes;
+    };
+
+    /**
+     * @class PacketCompression
+     * @brief Compresión de paquetes por encima de un umbral, con diccionario
+     *
+     * Usa los codecs de ChunkCompression. Cada paquete comprimido es un
+     * frame autodescriptivo: codec (1 byte), id del diccionario (u32) y
+     * tamaño original (u32), big-endian, seguidos de la salida del codec.
+     *
+     * Los diccionarios se registran por id y no se liberan nunca: los
+     * codecs guardan por hilo estado derivado de sus bytes.
+     *
+     * Negociación: el cliente manda en su HANDSHAKE una oferta (codecs que
+     * sabe descomprimir y diccionarios que ya tiene); el servidor elige con
+     * Negotiate y contesta con la configuración, incluyendo los bytes del
+     * diccionario si el cliente no lo tenía. Thread-safe.
+     */
+    class PacketCompression {
+    public:
+        static constexpr size_t FRAME_HEADER_SIZE = 9;
+        static constexpr size_t MAX_RAW_SIZE = 1u << 20;
+
+        /**
+         * @brief Codecs compilados en este binario, como máscara de bits
+         */
+        static uint8_t GetAvailableCodecs();
+
+        static bool IsAvailable(PacketCodec codec);
+        static const char* GetName(PacketCodec codec);
+
+        /**
+         * @brief Registrar un diccionario (si el id ya existe se conserva el registrado)
+         * @return Id del diccionario
+         */
+        static uint32_t RegisterDictionary(std::shared_ptr<const PacketDictionary> dictionary);
+
+        /**
+         * @brief Diccionario registrado con ese id, nullptr si no se conoce
+         */
+        static std::shared_ptr<const PacketDictionary> FindDictionary(uint32_t id);
+
+        static std::vector<uint32_t> GetDictionaryIds();
+
+        /**
+         * @brief Comprimir data en un frame nuevo
+         * @param out Frame comprimido (con HEADER_RESERVE libre delante para cabeceras)
+         * @return false si no se comprimió: compresión desactivada, datos menores que
+         *         threshold, sin ganancia, codec no disponible o diccionario desconocido.
+         *         En ese caso out no se toca y los datos deben enviarse tal cual.
+         */
+        static bool Compress(const PacketCompressionSettings& settings, std::span<const uint8_t> data, PacketBuffer& out);
+
+        /**
+         * @brief Descomprimir un frame de Compress
+         * @param out Datos originales
+         * @return false si el frame está corrupto o su diccionario no está registrado
+         */
+        static bool Decompress(std::span<const uint8_t> frame, PacketBuffer& out);
+
+        // Negociación en el HANDSHAKE
+
+        /**
+         * @brief Escribir la oferta de este lado (codecs disponibles y diccionarios registrados)
+         */
+        static void WriteOffer(PacketBuffer& out);
+        static bool ReadOffer(PacketReader& reader, PacketCompressionOffer& offer);
+
+        /**
+         * @brief Elegir la configuración para un cliente
+         *
+         * Se queda con el codec preferido si el cliente lo ofrece; si no,
+         * con el primero de LZ4, ZSTD y DEFLATE que ambos tengan. Sin codec
+         * común la compresión queda desactivada.
+         */
+        static PacketCompressionSettings Negotiate(const PacketCompressionOffer& offer, const PacketCompressionSettings& preferred);
+
+        /**
+         * @brief Escribir la configuración acordada
+         * @param includeDictionary Incluir los bytes del diccionario (el cliente no lo tiene)
+         */
+        static void WriteSettings(const PacketCompressionSettings& settings, bool includeDictionary, PacketBuffer& out);
+
+        /**
+         * @brief Leer la configuración acordada; registra el diccionario si viene incluido
+         * @return false si los datos están mal formados o el diccionario no coincide con su id
+         */
+        static bool ReadSettings(PacketReader& reader, PacketCompressionSettings& settings);
+
+        static PacketCompressionStats GetStats();
+    };
+
+} // namespace VoxelCraft
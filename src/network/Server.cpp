@@ -6,6 +6,7 @@
  */
 
 #include "Server.hpp"
+#include "Packet.hpp"
 #include "Logger.hpp"
 
 #include <iostream>
@@ -20,6 +21,7 @@ Server::Server()
     , m_serverMotd("Welcome to VoxelCraft!")
     , m_running(false)
     , m_initialized(false)
+    , m_tick(0)
 {
     std::memset(&m_metrics, 0, sizeof(ServerMetrics));
 }
@@ -42,6 +44,13 @@ bool Server::Initialize(const Config& config) {
         m_serverName = config.Get("server.name", "VoxelCraft Server");
         m_serverMotd = config.Get("server.motd", "Welcome to VoxelCraft!");
 
+        // Interest management
+        InterestConfig interestConfig;
+        interestConfig.viewDistance = config.Get("server.view_distance", 10);
+        interestConfig.clientChunkBytesPerTick = static_cast<size_t>(config.Get("server.chunk_bytes_per_client_tick", 48 * 1024));
+        interestConfig.totalChunkBytesPerTick = static_cast<size_t>(config.Get("server.chunk_bytes_per_tick", 1024 * 1024));
+        m_interest.SetConfig(interestConfig);
+
         // Create network manager
         m_networkManager = std::make_unique<NetworkManager>();
         if (!m_networkManager->Initialize(config)) {
@@ -285,6 +294,9 @@ void Server::WorldUpdateLoop() {
             // Broadcast world state to players
             BroadcastWorldState();
 
+            // Stream the chunks each player still needs
+            UpdateInterest();
+
             lastUpdate = currentTime;
         }
 
@@ -295,6 +307,56 @@ void Server::WorldUpdateLoop() {
     VOXELCRAFT_INFO("World update loop ended");
 }
 
+void Server::UpdateInterest() {
+    m_tick++;
+    if (!m_chunkPacketProvider) {
+        return;
+    }
+
+    m_interest.ScheduleChunks(
+        [this](uint32_t connectionId, const ChunkCoord& coord) -> size_t {
+            auto packet = m_chunkPacketProvider(coord);
+            if (!packet || !packet->Serialize()) {
+                return 0;                           // Not generated yet, retried next tick
+            }
+            const size_t bytes = packet->GetBuffer().Size();
+            return SendPacketTo(packet, connectionId) ? bytes : 0;
+        },
+        [this](uint32_t connectionId, const ChunkCoord& coord) {
+            // An empty full chunk tells the client to drop it
+            auto packet = std::make_shared<ChunkDataPacket>(coord.x, coord.z, true, 0, std::vector<uint8_t>());
+            SendPacketTo(packet, connectionId);
+        });
+}
+
+void Server::UpdateClientView(uint32_t connectionId, float x, float y, float z, float dirX, float dirZ) {
+    std::lock_guard<std::mutex> lock(m_worldMutex);
+    m_interest.UpdateClient(connectionId, x, y, z, dirX, dirZ);
+}
+
+bool Server::BroadcastEntityPacket(std::shared_ptr<Packet> packet, uint32_t entityId, float x, float y, float z,
+                                   uint32_t excludeConnectionId) {
+    m_recipientScratch.clear();
+    m_interest.CollectEntityRecipients(entityId, x, y, z, m_tick, m_recipientScratch, excludeConnectionId);
+
+    bool success = true;
+    for (uint32_t connectionId : m_recipientScratch) {
+        success &= SendPacketTo(packet, connectionId);
+    }
+    return success;
+}
+
+bool Server::BroadcastChunkPacket(std::shared_ptr<Packet> packet, const ChunkCoord& coord, uint32_t excludeConnectionId) {
+    m_recipientScratch.clear();
+    m_interest.CollectChunkRecipients(coord, m_recipientScratch, excludeConnectionId);
+
+    bool success = true;
+    for (uint32_t connectionId : m_recipientScratch) {
+        success &= SendPacketTo(packet, connectionId);
+    }
+    return success;
+}
+
 void Server::ProcessNetworkEvents() {
     if (m_networkManager) {
         m_networkManager->Update(0.05); // 20 TPS = 0.05 seconds per tick
@@ -332,6 +394,10 @@ void Server::UpdateServerMetrics() {
 
 void Server::OnPlayerConnected(uint32_t playerId) {
     m_metrics.totalConnections++;
+    {
+        std::lock_guard<std::mutex> lock(m_worldMutex);
+        m_interest.AddClient(playerId);
+    }
 
     auto player = m_networkManager->GetPlayerConnection(playerId);
     if (player) {
@@ -350,6 +416,10 @@ void Server::OnPlayerConnected(uint32_t playerId) {
 
 void Server::OnPlayerDisconnected(uint32_t playerId) {
     m_metrics.totalDisconnections++;
+    {
+        std::lock_guard<std::mutex> lock(m_worldMutex);
+        m_interest.RemoveClient(playerId);
+    }
 
     auto player = m_networkManager->GetPlayerConnection(playerId);
     if (player) {
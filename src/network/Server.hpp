@@ -24,6 +24,8 @@
 #include <fcntl.h>
 #endif
 
+#include "InterestManager.hpp"
+
 namespace VoxelCraft {
 
     class Packet;
@@ -98,6 +100,8 @@ namespace VoxelCraft {
         std::string serverName = "VoxelCraft Server"; ///< Nombre del servidor
         std::string serverMotd = "A VoxelCraft Server"; ///< MOTD del servidor
         int maxViewDistance = 10;                 ///< Distancia máxima de vista
+        size_t chunkBytesPerClientTick = 48 * 1024;   ///< Presupuesto de chunks por cliente y tick
+        size_t chunkBytesPerTick = 1024 * 1024;       ///< Presupuesto de chunks del servidor por tick
         bool enableCompression = true;            ///< Habilitar compresión
         int compressionThreshold = 256;           ///< Umbral de compresión
         std::string encryptionKey = "";           ///< Clave de encriptación
@@ -181,6 +185,38 @@ namespace VoxelCraft {
         bool BroadcastPacket(std::shared_ptr<Packet> packet);
         bool BroadcastPacketExcept(std::shared_ptr<Packet> packet, uint32_t excludeConnectionId);
 
+        // Gestión de interés
+
+        /**
+         * @brief Crea el paquete CHUNK_DATA de un chunk; nullptr si aún no está generado
+         */
+        using ChunkPacketProvider = std::function<std::shared_ptr<Packet>(const ChunkCoord& coord)>;
+
+        void SetChunkPacketProvider(const ChunkPacketProvider& provider) { m_chunkPacketProvider = provider; }
+
+        /**
+         * @brief Posición y mirada del jugador de una conexión (decide qué chunks necesita)
+         *
+         * Thread-safe. Los Broadcast de interés se llaman desde el hilo de actualización del mundo.
+         */
+        void UpdateClientView(uint32_t connectionId, float x, float y, float z, float dirX, float dirZ);
+
+        /**
+         * @brief Enviar la actualización de una entidad solo a quien la ve, con frecuencia según la distancia
+         * @return true si se envió a todos los destinatarios de este tick
+         */
+        bool BroadcastEntityPacket(std::shared_ptr<Packet> packet, uint32_t entityId, float x, float y, float z,
+                                   uint32_t excludeConnectionId = 0);
+
+        /**
+         * @brief Enviar un cambio de bloque solo a las conexiones que tienen el chunk
+         * @return true si se envió a todos los destinatarios
+         */
+        bool BroadcastChunkPacket(std::shared_ptr<Packet> packet, const ChunkCoord& coord, uint32_t excludeConnectionId = 0);
+
+        InterestManager& GetInterestManager() { return m_interest; }
+        const InterestManager& GetInterestManager() const { return m_interest; }
+
         // Ping y latencia
         std::chrono::milliseconds GetPing(uint32_t connectionId) const;
         std::chrono::milliseconds GetAverageLatency() const;
@@ -256,6 +292,12 @@ namespace VoxelCraft {
         std::condition_variable m_packetQueueCV;
         std::condition_variable m_disconnectQueueCV;
 
+        // Gestión de interés (bajo el mutex del mundo)
+        InterestManager m_interest;
+        ChunkPacketProvider m_chunkPacketProvider;
+        std::vector<uint32_t> m_recipientScratch;
+        uint64_t m_tick;
+
         // Callbacks
         ConnectionCallback m_connectionCallback;
         PacketCallback m_packetCallback;
@@ -286,6 +328,7 @@ namespace VoxelCraft {
         bool AuthenticateClient(uint32_t connectionId, const std::string& playerName);
         void HandleTimeoutConnections();
         void SendHeartbeat();
+        void UpdateInterest();
     };
 
 } // namespace VoxelCraft
\ No newline at end of file
@@ -0,0 +1,879 @@
+/**
+ * @file ServerTransport.cpp
+ * @brief VoxelCraft Server Transport Implementation
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#include "ServerTransport.hpp"
+#include "../core/Logger.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <cerrno>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+namespace VoxelCraft {
+
+    namespace {
+
+        constexpr uint32_t FRAME_HEADER_SIZE = 4;
+        constexpr uint32_t SLOT_BITS = 16;
+        constexpr uint32_t SLOT_MASK = (1u << SLOT_BITS) - 1;
+        constexpr std::chrono::milliseconds SWEEP_INTERVAL(250);
+        constexpr int MAX_WRITE_VECTORS = 64;   // Dos por frame: longitud y datos
+
+        // Los ids de conexión caben en 32 bits; estas etiquetas de epoll no
+        constexpr uint64_t LISTEN_TAG = 1ull << 32;
+        constexpr uint64_t WAKE_TAG = 2ull << 32;
+
+        // Evita escribir el eventfd cuando quien encola es el propio reactor
+        thread_local const ServerTransport* t_reactorOwner = nullptr;
+
+        void WriteFrameHeader(uint8_t* out, uint32_t size) {
+            for (uint32_t i = 0; i < FRAME_HEADER_SIZE; ++i) {
+                out[i] = static_cast<uint8_t>(size >> (i * 8));
+            }
+        }
+
+        uint32_t ReadFrameHeader(const uint8_t* in) {
+            uint32_t size = 0;
+            for (uint32_t i = 0; i < FRAME_HEADER_SIZE; ++i) {
+                size |= static_cast<uint32_t>(in[i]) << (i * 8);
+            }
+            return size;
+        }
+
+        /**
+         * @struct OutgoingFrame
+         * @brief Frame en la cola de envío: la longitud va aparte para no tocar el buffer compartido
+         */
+        struct OutgoingFrame {
+            PacketBuffer buffer;
+            uint8_t header[FRAME_HEADER_SIZE] = {};
+        };
+
+    } // namespace
+
+    struct ServerTransport::Connection {
+        mutable std::mutex mutex;       ///< Protege id, address, la cola de envío, pending y closeRequested
+        uint32_t id = 0;                ///< 0 = hueco libre; solo el reactor lo cambia
+        uint16_t generation = 0;
+        std::string address;
+        bool pending = false;           ///< Ya está en m_pendingSlots
+        bool closeRequested = false;
+
+        // Cola de envío circular; los emisores solo escriben en writeTail
+        std::vector<OutgoingFrame> writeQueue;
+        uint64_t writeHead = 0;
+        uint64_t writeTail = 0;
+        size_t headOffset = 0;          ///< Bytes ya enviados del primer frame (longitud incluida)
+        size_t queuedBytes = 0;         ///< Pendientes de enviar, longitudes incluidas
+
+        void ClearWriteQueue() {
+            for (; writeHead != writeTail; ++writeHead) {
+                writeQueue[writeHead & (writeQueue.size() - 1)].buffer.Reset();
+            }
+            writeHead = writeTail = 0;
+            headOffset = 0;
+            queuedBytes = 0;
+        }
+
+        // Solo el reactor
+        int fd = -1;
+        ByteRing readRing;
+        bool readPaused = false;        ///< Backpressure: no se lee hasta vaciar la cola de envío
+        bool writeBlocked = false;      ///< El socket devolvió EAGAIN; se espera EPOLLOUT
+        bool stalled = false;           ///< Por encima del high water mark
+        std::chrono::steady_clock::time_point stalledSince;
+        std::chrono::steady_clock::time_point lastActivity;
+    };
+
+    ServerTransport::ServerTransport()
+        : m_running(false)
+        , m_boundPort(0)
+        , m_epollFd(-1)
+        , m_listenFd(-1)
+        , m_wakeFd(-1)
+        , m_activeConnections(0)
+        , m_connectionsAccepted(0)
+        , m_connectionsRejected(0)
+        , m_connectionsClosed(0)
+        , m_framesReceived(0)
+        , m_framesSent(0)
+        , m_bytesReceived(0)
+        , m_bytesSent(0)
+        , m_readCalls(0)
+        , m_writevCalls(0)
+        , m_wakeups(0)
+        , m_backpressureRejects(0)
+        , m_readPauses(0)
+        , m_slowClientDisconnects(0)
+        , m_idleDisconnects(0)
+        , m_protocolErrors(0)
+    {
+    }
+
+    ServerTransport::~ServerTransport() {
+        Stop();
+    }
+
+    ServerTransportStats ServerTransport::GetStats() const {
+        ServerTransportStats stats;
+        stats.connectionsAccepted = m_connectionsAccepted.load(std::memory_order_relaxed);
+        stats.connectionsRejected = m_connectionsRejected.load(std::memory_order_relaxed);
+        stats.connectionsClosed = m_connectionsClosed.load(std::memory_order_relaxed);
+        stats.activeConnections = m_activeConnections.load(std::memory_order_relaxed);
+        stats.framesReceived = m_framesReceived.load(std::memory_order_relaxed);
+        stats.framesSent = m_framesSent.load(std::memory_order_relaxed);
+        stats.bytesReceived = m_bytesReceived.load(std::memory_order_relaxed);
+        stats.bytesSent = m_bytesSent.load(std::memory_order_relaxed);
+        stats.readCalls = m_readCalls.load(std::memory_order_relaxed);
+        stats.writevCalls = m_writevCalls.load(std::memory_order_relaxed);
+        stats.wakeups = m_wakeups.load(std::memory_order_relaxed);
+        stats.backpressureRejects = m_backpressureRejects.load(std::memory_order_relaxed);
+        stats.readPauses = m_readPauses.load(std::memory_order_relaxed);
+        stats.slowClientDisconnects = m_slowClientDisconnects.load(std::memory_order_relaxed);
+        stats.idleDisconnects = m_idleDisconnects.load(std::memory_order_relaxed);
+        stats.protocolErrors = m_protocolErrors.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    ServerTransport::Connection* ServerTransport::Lookup(uint32_t connectionId) const {
+        const uint32_t slot = connectionId & SLOT_MASK;
+        if (connectionId == 0 || slot >= m_connections.size()) {
+            return nullptr;
+        }
+        return m_connections[slot].get();
+    }
+
+    ServerTransport::SendResult ServerTransport::Send(uint32_t connectionId, const void* data, size_t size) {
+        if (size + FRAME_HEADER_SIZE > m_config.writeBufferSize) {
+            return SendResult::TOO_LARGE;
+        }
+
+        PacketBuffer frame = PacketBuffer::Allocate(size);
+        frame.Append(data, size);
+        return Send(connectionId, frame);
+    }
+
+    ServerTransport::SendResult ServerTransport::Send(uint32_t connectionId, const PacketBuffer& frame) {
+        Connection* connection = m_running ? Lookup(connectionId) : nullptr;
+        if (!connection) {
+            return SendResult::NOT_CONNECTED;
+        }
+
+        const size_t size = frame.Size() + FRAME_HEADER_SIZE;
+        if (size > m_config.writeBufferSize) {
+            return SendResult::TOO_LARGE;
+        }
+
+        bool wasPending;
+        {
+            std::lock_guard<std::mutex> lock(connection->mutex);
+            if (connection->id != connectionId || connection->closeRequested) {
+                return SendResult::NOT_CONNECTED;
+            }
+            if (connection->queuedBytes + size > m_config.writeBufferSize ||
+                connection->writeTail - connection->writeHead == connection->writeQueue.size()) {
+                m_backpressureRejects.fetch_add(1, std::memory_order_relaxed);
+                return SendResult::BACKPRESSURE;
+            }
+
+            OutgoingFrame& outgoing = connection->writeQueue[connection->writeTail & (connection->writeQueue.size() - 1)];
+            outgoing.buffer = frame;
+            WriteFrameHeader(outgoing.header, static_cast<uint32_t>(frame.Size()));
+            connection->writeTail++;
+            connection->queuedBytes += size;
+
+            wasPending = connection->pending;
+            connection->pending = true;
+        }
+
+        m_framesSent.fetch_add(1, std::memory_order_relaxed);
+        if (!wasPending) {
+            MarkPending(connectionId & SLOT_MASK);
+        }
+        return SendResult::QUEUED;
+    }
+
+    size_t ServerTransport::Broadcast(const void* data, size_t size) {
+        if (!m_running || size + FRAME_HEADER_SIZE > m_config.writeBufferSize) {
+            return 0;
+        }
+
+        // Una sola copia compartida por todas las conexiones
+        PacketBuffer frame = PacketBuffer::Allocate(size);
+        frame.Append(data, size);
+        return Broadcast(frame);
+    }
+
+    size_t ServerTransport::Broadcast(const PacketBuffer& frame) {
+        size_t queued = 0;
+        if (!m_running) {
+            return queued;
+        }
+
+        for (const auto& connection : m_connections) {
+            uint32_t connectionId;
+            {
+                std::lock_guard<std::mutex> lock(connection->mutex);
+                connectionId = connection->id;
+            }
+            if (connectionId != 0 && Send(connectionId, frame) == SendResult::QUEUED) {
+                queued++;
+            }
+        }
+        return queued;
+    }
+
+    void ServerTransport::Disconnect(uint32_t connectionId) {
+        Connection* connection = m_running ? Lookup(connectionId) : nullptr;
+        if (!connection) {
+            return;
+        }
+
+        bool wasPending;
+        {
+            std::lock_guard<std::mutex> lock(connection->mutex);
+            if (connection->id != connectionId) {
+                return;
+            }
+            connection->closeRequested = true;
+            wasPending = connection->pending;
+            connection->pending = true;
+        }
+
+        if (!wasPending) {
+            MarkPending(connectionId & SLOT_MASK);
+        }
+    }
+
+    size_t ServerTransport::GetQueuedBytes(uint32_t connectionId) const {
+        Connection* connection = Lookup(connectionId);
+        if (!connection) {
+            return 0;
+        }
+
+        std::lock_guard<std::mutex> lock(connection->mutex);
+        return connection->id == connectionId ? connection->queuedBytes : 0;
+    }
+
+    std::string ServerTransport::GetAddress(uint32_t connectionId) const {
+        Connection* connection = Lookup(connectionId);
+        if (!connection) {
+            return std::string();
+        }
+
+        std::lock_guard<std::mutex> lock(connection->mutex);
+        return connection->id == connectionId ? connection->address : std::string();
+    }
+
+#if defined(__linux__)
+
+    bool ServerTransport::Start(const ServerTransportConfig& config) {
+        if (m_running) {
+            VOXELCRAFT_WARNING("Server transport already running");
+            return false;
+        }
+
+        m_config = config;
+        m_config.maxConnections = std::clamp<size_t>(m_config.maxConnections, 1, SLOT_MASK);
+        m_config.readBufferSize = std::max<size_t>(m_config.readBufferSize, 64);
+        m_config.writeBufferSize = std::max<size_t>(m_config.writeBufferSize, 64);
+        m_config.maxQueuedFrames = std::max<size_t>(m_config.maxQueuedFrames, 1);
+        m_config.lowWaterMark = std::clamp(m_config.lowWaterMark, 0.0f, 1.0f);
+        m_config.highWaterMark = std::clamp(m_config.highWaterMark, m_config.lowWaterMark, 1.0f);
+
+        // Un frame completo siempre debe caber en el ring de lectura
+        ByteRing probe;
+        probe.Allocate(m_config.readBufferSize);
+        m_config.readBufferSize = probe.Capacity();
+        m_config.maxFrameSize = std::min(m_config.maxFrameSize, m_config.readBufferSize - FRAME_HEADER_SIZE);
+
+        m_listenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (m_listenFd < 0) {
+            VOXELCRAFT_ERROR("Server transport: socket() failed: " + std::string(std::strerror(errno)));
+            return false;
+        }
+
+        int reuse = 1;
+        setsockopt(m_listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(m_config.port);
+        if (inet_pton(AF_INET, m_config.bindAddress.c_str(), &address.sin_addr) != 1 ||
+            bind(m_listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            listen(m_listenFd, SOMAXCONN) != 0) {
+            VOXELCRAFT_ERROR("Server transport: cannot listen on " + m_config.bindAddress + ":" +
+                             std::to_string(m_config.port) + ": " + std::strerror(errno));
+            CloseSockets();
+            return false;
+        }
+
+        socklen_t addressLength = sizeof(address);
+        getsockname(m_listenFd, reinterpret_cast<sockaddr*>(&address), &addressLength);
+        m_boundPort = ntohs(address.sin_port);
+
+        m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+        m_wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (m_epollFd < 0 || m_wakeFd < 0) {
+            VOXELCRAFT_ERROR("Server transport: epoll/eventfd creation failed: " + std::string(std::strerror(errno)));
+            CloseSockets();
+            return false;
+        }
+
+        epoll_event listenEvent{};
+        listenEvent.events = EPOLLIN | EPOLLET;
+        listenEvent.data.u64 = LISTEN_TAG;
+        epoll_event wakeEvent{};
+        wakeEvent.events = EPOLLIN | EPOLLET;
+        wakeEvent.data.u64 = WAKE_TAG;
+        if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_listenFd, &listenEvent) != 0 ||
+            epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeFd, &wakeEvent) != 0) {
+            VOXELCRAFT_ERROR("Server transport: epoll_ctl failed: " + std::string(std::strerror(errno)));
+            CloseSockets();
+            return false;
+        }
+
+        // Los rings y colas se reservan la primera vez que se usa cada hueco y se reutilizan
+        m_connections.clear();
+        m_freeSlots.clear();
+        for (size_t i = 0; i < m_config.maxConnections; ++i) {
+            m_connections.push_back(std::make_unique<Connection>());
+        }
+        for (size_t i = m_config.maxConnections; i > 0; --i) {
+            m_freeSlots.push_back(static_cast<uint32_t>(i - 1));
+        }
+        m_pendingSlots.clear();
+        m_pendingSlots.reserve(m_config.maxConnections);
+        m_pendingScratch.reserve(m_config.maxConnections);
+        m_frameScratch.reserve(m_config.maxFrameSize);
+        m_activeConnections = 0;
+
+        m_running = true;
+        m_reactorThread = std::thread(&ServerTransport::ReactorThread, this);
+
+        VOXELCRAFT_INFO("Server transport listening on " + m_config.bindAddress + ":" + std::to_string(m_boundPort));
+        return true;
+    }
+
+    void ServerTransport::Stop() {
+        if (!m_running.exchange(false)) {
+            return;
+        }
+
+        uint64_t one = 1;
+        ssize_t written = write(m_wakeFd, &one, sizeof(one));
+        (void)written;
+        if (m_reactorThread.joinable()) {
+            m_reactorThread.join();
+        }
+
+        for (uint32_t slot = 0; slot < m_connections.size(); ++slot) {
+            CloseConnection(slot, false);
+        }
+        CloseSockets();
+
+        VOXELCRAFT_INFO("Server transport stopped");
+    }
+
+    void ServerTransport::CloseSockets() {
+        for (int* fd : { &m_listenFd, &m_wakeFd, &m_epollFd }) {
+            if (*fd >= 0) {
+                close(*fd);
+                *fd = -1;
+            }
+        }
+    }
+
+    void ServerTransport::MarkPending(uint32_t slot) {
+        bool wasEmpty;
+        {
+            std::lock_guard<std::mutex> lock(m_pendingMutex);
+            wasEmpty = m_pendingSlots.empty();
+            m_pendingSlots.push_back(slot);
+        }
+
+        // El reactor procesa la lista al final de cada vuelta; los demás hilos lo despiertan
+        if (wasEmpty && t_reactorOwner != this) {
+            uint64_t one = 1;
+            ssize_t written = write(m_wakeFd, &one, sizeof(one));
+            (void)written;
+        }
+    }
+
+    void ServerTransport::ReactorThread() {
+        t_reactorOwner = this;
+        std::vector<epoll_event> events(static_cast<size_t>(std::max(1, m_config.maxEventsPerWait)));
+        auto nextSweep = std::chrono::steady_clock::now() + SWEEP_INTERVAL;
+        bool morePending = false;
+
+        while (m_running) {
+            // Lo encolado por el propio reactor no escribe el eventfd: no dormir si quedó algo
+            auto now = std::chrono::steady_clock::now();
+            int timeout = morePending ? 0 : static_cast<int>(std::max<int64_t>(0,
+                std::chrono::duration_cast<std::chrono::milliseconds>(nextSweep - now).count()));
+
+            int count = epoll_wait(m_epollFd, events.data(), static_cast<int>(events.size()), timeout);
+            if (count < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                VOXELCRAFT_ERROR("Server transport: epoll_wait failed: " + std::string(std::strerror(errno)));
+                break;
+            }
+            m_wakeups.fetch_add(1, std::memory_order_relaxed);
+
+            for (int i = 0; i < count; ++i) {
+                const uint64_t tag = events[static_cast<size_t>(i)].data.u64;
+                const uint32_t flags = events[static_cast<size_t>(i)].events;
+
+                if (tag == LISTEN_TAG) {
+                    AcceptConnections();
+                    continue;
+                }
+                if (tag == WAKE_TAG) {
+                    uint64_t value;
+                    while (read(m_wakeFd, &value, sizeof(value)) > 0) {
+                    }
+                    continue;
+                }
+
+                // Un evento puede referirse a una conexión cerrada antes en este mismo lote
+                const uint32_t connectionId = static_cast<uint32_t>(tag);
+                const uint32_t slot = connectionId & SLOT_MASK;
+                Connection* connection = Lookup(connectionId);
+                if (!connection || connection->id != connectionId) {
+                    continue;
+                }
+
+                if (flags & EPOLLOUT) {
+                    connection->writeBlocked = false;
+                    FlushConnection(slot);
+                }
+                if ((flags & (EPOLLIN | EPOLLRDHUP)) && connection->id == connectionId) {
+                    HandleReadable(slot);
+                }
+                if ((flags & (EPOLLERR | EPOLLHUP)) && connection->id == connectionId) {
+                    CloseConnection(slot, true);
+                }
+            }
+
+            morePending = ProcessPending();
+
+            now = std::chrono::steady_clock::now();
+            if (now >= nextSweep) {
+                CheckTimeouts();
+                nextSweep = now + SWEEP_INTERVAL;
+            }
+        }
+
+        t_reactorOwner = nullptr;
+    }
+
+    void ServerTransport::AcceptConnections() {
+        // Edge-triggered: aceptar hasta agotar la cola
+        while (true) {
+            sockaddr_in peer{};
+            socklen_t peerLength = sizeof(peer);
+            int fd = accept4(m_listenFd, reinterpret_cast<sockaddr*>(&peer), &peerLength, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                if (errno == EINTR || errno == ECONNABORTED) {
+                    continue;
+                }
+                if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                    VOXELCRAFT_WARNING("Server transport: accept failed: " + std::string(std::strerror(errno)));
+                }
+                return;
+            }
+
+            if (m_freeSlots.empty()) {
+                close(fd);
+                m_connectionsRejected.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            int noDelay = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+            const uint32_t slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+            Connection& connection = *m_connections[slot];
+
+            if (!connection.readRing.IsAllocated()) {
+                size_t queueSize = 1;
+                while (queueSize < m_config.maxQueuedFrames) {
+                    queueSize <<= 1;
+                }
+                connection.readRing.Allocate(m_config.readBufferSize);
+                std::lock_guard<std::mutex> lock(connection.mutex);
+                connection.writeQueue.resize(queueSize);
+            }
+
+            connection.generation = static_cast<uint16_t>(connection.generation + 1);
+            if (connection.generation == 0) {
+                connection.generation = 1;
+            }
+            const uint32_t connectionId = (static_cast<uint32_t>(connection.generation) << SLOT_BITS) | slot;
+
+            char host[INET_ADDRSTRLEN] = {};
+            inet_ntop(AF_INET, &peer.sin_addr, host, sizeof(host));
+
+            connection.fd = fd;
+            connection.readRing.Clear();
+            connection.readPaused = false;
+            connection.writeBlocked = false;
+            connection.stalled = false;
+            connection.lastActivity = std::chrono::steady_clock::now();
+            {
+                std::lock_guard<std::mutex> lock(connection.mutex);
+                connection.id = connectionId;
+                connection.address = std::string(host) + ":" + std::to_string(ntohs(peer.sin_port));
+                connection.ClearWriteQueue();
+                connection.closeRequested = false;
+            }
+
+            epoll_event event{};
+            event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+            event.data.u64 = connectionId;
+            if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+                VOXELCRAFT_WARNING("Server transport: epoll_ctl failed for new connection: " +
+                                   std::string(std::strerror(errno)));
+                close(fd);
+                connection.fd = -1;
+                {
+                    std::lock_guard<std::mutex> lock(connection.mutex);
+                    connection.id = 0;
+                    connection.address.clear();
+                }
+                m_freeSlots.push_back(slot);
+                continue;
+            }
+
+            m_activeConnections.fetch_add(1, std::memory_order_relaxed);
+            m_connectionsAccepted.fetch_add(1, std::memory_order_relaxed);
+
+            if (m_connectCallback) {
+                m_connectCallback(connectionId, GetAddress(connectionId));
+            }
+        }
+    }
+
+    void ServerTransport::HandleReadable(uint32_t slot) {
+        Connection& connection = *m_connections[slot];
+        if (connection.readPaused) {
+            return;
+        }
+
+        // Edge-triggered: leer hasta EAGAIN o el próximo aviso no llega
+        bool closed = false;
+        while (true) {
+            ByteRing::Span spans[2];
+            int spanCount = connection.readRing.WritableSpans(spans);
+            if (spanCount == 0) {
+                // Ring lleno sin un frame completo: el frame no cabe nunca
+                m_protocolErrors.fetch_add(1, std::memory_order_relaxed);
+                closed = true;
+                break;
+            }
+
+            iovec vectors[2];
+            for (int i = 0; i < spanCount; ++i) {
+                vectors[i].iov_base = spans[i].data;
+                vectors[i].iov_len = spans[i].size;
+            }
+
+            ssize_t received = readv(connection.fd, vectors, spanCount);
+            m_readCalls.fetch_add(1, std::memory_order_relaxed);
+
+            if (received > 0) {
+                connection.readRing.Commit(static_cast<size_t>(received));
+                connection.lastActivity = std::chrono::steady_clock::now();
+                m_bytesReceived.fetch_add(static_cast<uint64_t>(received), std::memory_order_relaxed);
+
+                if (!ParseFrames(connection)) {
+                    closed = true;
+                    break;
+                }
+
+                // Backpressure: el cliente no consume lo que le enviamos, dejar de leerle
+                size_t backlog;
+                {
+                    std::lock_guard<std::mutex> lock(connection.mutex);
+                    backlog = connection.queuedBytes;
+                }
+                if (static_cast<float>(backlog) > m_config.highWaterMark * static_cast<float>(m_config.writeBufferSize)) {
+                    connection.readPaused = true;
+                    m_readPauses.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+                continue;
+            }
+
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            }
+            closed = true;      // EOF o error
+            break;
+        }
+
+        if (closed) {
+            CloseConnection(slot, true);
+        }
+    }
+
+    bool ServerTransport::ParseFrames(Connection& connection) {
+        ByteRing& ring = connection.readRing;
+        while (ring.Size() >= FRAME_HEADER_SIZE) {
+            uint8_t header[FRAME_HEADER_SIZE];
+            ring.Peek(header, FRAME_HEADER_SIZE);
+            const uint32_t size = ReadFrameHeader(header);
+
+            if (size > m_config.maxFrameSize) {
+                m_protocolErrors.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            if (ring.Size() < FRAME_HEADER_SIZE + size) {
+                break;
+            }
+
+            const uint8_t* data = ring.Contiguous(FRAME_HEADER_SIZE, size);
+            if (!data) {
+                m_frameScratch.resize(size);
+                ring.Peek(m_frameScratch.data(), size, FRAME_HEADER_SIZE);
+                data = m_frameScratch.data();
+            }
+
+            m_framesReceived.fetch_add(1, std::memory_order_relaxed);
+            if (m_frameCallback) {
+                m_frameCallback(connection.id, data, size);
+            }
+            ring.Consume(FRAME_HEADER_SIZE + size);
+        }
+        return true;
+    }
+
+    void ServerTransport::FlushConnection(uint32_t slot) {
+        Connection& connection = *m_connections[slot];
+        if (connection.fd < 0) {
+            return;
+        }
+
+        // Cada writev recoge hasta MAX_WRITE_VECTORS / 2 frames de la cola
+        while (!connection.writeBlocked) {
+            iovec vectors[MAX_WRITE_VECTORS];
+            int vectorCount = 0;
+            size_t total = 0;
+            {
+                std::lock_guard<std::mutex> lock(connection.mutex);
+                const size_t mask = connection.writeQueue.size() - 1;
+                size_t skip = connection.headOffset;
+                for (uint64_t i = connection.writeHead;
+                     i != connection.writeTail && vectorCount + 2 <= MAX_WRITE_VECTORS; ++i) {
+                    OutgoingFrame& outgoing = connection.writeQueue[i & mask];
+                    if (skip < FRAME_HEADER_SIZE) {
+                        vectors[vectorCount].iov_base = outgoing.header + skip;
+                        vectors[vectorCount].iov_len = FRAME_HEADER_SIZE - skip;
+                        total += vectors[vectorCount++].iov_len;
+                        skip = 0;
+                    } else {
+                        skip -= FRAME_HEADER_SIZE;
+                    }
+                    if (outgoing.buffer.Size() > skip) {
+                        vectors[vectorCount].iov_base = const_cast<uint8_t*>(outgoing.buffer.Data()) + skip;
+                        vectors[vectorCount].iov_len = outgoing.buffer.Size() - skip;
+                        total += vectors[vectorCount++].iov_len;
+                    }
+                    skip = 0;
+                }
+            }
+            if (vectorCount == 0) {
+                break;
+            }
+
+            // Los emisores solo escriben más allá de writeTail, así que los frames siguen válidos sin el lock
+            ssize_t sent = writev(connection.fd, vectors, vectorCount);
+            m_writevCalls.fetch_add(1, std::memory_order_relaxed);
+
+            if (sent > 0) {
+                {
+                    std::lock_guard<std::mutex> lock(connection.mutex);
+                    const size_t mask = connection.writeQueue.size() - 1;
+                    size_t remaining = static_cast<size_t>(sent);
+                    connection.queuedBytes -= remaining;
+                    while (remaining > 0) {
+                        OutgoingFrame& outgoing = connection.writeQueue[connection.writeHead & mask];
+                        const size_t left = FRAME_HEADER_SIZE + outgoing.buffer.Size() - connection.headOffset;
+                        if (remaining < left) {
+                            connection.headOffset += remaining;
+                            break;
+                        }
+                        remaining -= left;
+                        outgoing.buffer.Reset();
+                        connection.headOffset = 0;
+                        connection.writeHead++;
+                    }
+                }
+                m_bytesSent.fetch_add(static_cast<uint64_t>(sent), std::memory_order_relaxed);
+
+                // Envío parcial: el buffer del socket está lleno, EPOLLOUT avisará
+                if (static_cast<size_t>(sent) < total) {
+                    connection.writeBlocked = true;
+                }
+                continue;
+            }
+
+            if (sent < 0 && errno == EINTR) {
+                continue;
+            }
+            if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                connection.writeBlocked = true;
+                break;
+            }
+            CloseConnection(slot, true);
+            return;
+        }
+
+        size_t backlog;
+        {
+            std::lock_guard<std::mutex> lock(connection.mutex);
+            backlog = connection.queuedBytes;
+        }
+
+        const float capacity = static_cast<float>(m_config.writeBufferSize);
+        if (static_cast<float>(backlog) > m_config.highWaterMark * capacity) {
+            if (!connection.stalled) {
+                connection.stalled = true;
+                connection.stalledSince = std::chrono::steady_clock::now();
+            }
+        } else {
+            connection.stalled = false;
+        }
+
+        // Reanudar la lectura: con edge-triggered hay que vaciar lo que llegó mientras tanto
+        if (connection.readPaused && static_cast<float>(backlog) <= m_config.lowWaterMark * capacity) {
+            connection.readPaused = false;
+            HandleReadable(slot);
+        }
+    }
+
+    bool ServerTransport::ProcessPending() {
+        m_pendingScratch.clear();
+        {
+            std::lock_guard<std::mutex> lock(m_pendingMutex);
+            m_pendingScratch.swap(m_pendingSlots);
+        }
+
+        for (uint32_t slot : m_pendingScratch) {
+            Connection& connection = *m_connections[slot];
+            bool closeRequested;
+            {
+                std::lock_guard<std::mutex> lock(connection.mutex);
+                connection.pending = false;
+                closeRequested = connection.closeRequested;
+            }
+
+            FlushConnection(slot);
+            if (closeRequested && connection.fd >= 0) {
+                CloseConnection(slot, true);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        return !m_pendingSlots.empty();
+    }
+
+    void ServerTransport::CheckTimeouts() {
+        const auto now = std::chrono::steady_clock::now();
+        for (uint32_t slot = 0; slot < m_connections.size(); ++slot) {
+            Connection& connection = *m_connections[slot];
+            if (connection.fd < 0) {
+                continue;
+            }
+
+            if (connection.stalled && now - connection.stalledSince > m_config.slowClientTimeout) {
+                m_slowClientDisconnects.fetch_add(1, std::memory_order_relaxed);
+                VOXELCRAFT_WARNING("Server transport: disconnecting slow client " + GetAddress(connection.id));
+                CloseConnection(slot, true);
+            } else if (m_config.idleTimeout.count() > 0 && now - connection.lastActivity > m_config.idleTimeout) {
+                m_idleDisconnects.fetch_add(1, std::memory_order_relaxed);
+                CloseConnection(slot, true);
+            }
+        }
+    }
+
+    void ServerTransport::CloseConnection(uint32_t slot, bool notify) {
+        Connection& connection = *m_connections[slot];
+        if (connection.fd < 0) {
+            return;
+        }
+
+        epoll_ctl(m_epollFd, EPOLL_CTL_DEL, connection.fd, nullptr);
+        close(connection.fd);
+        connection.fd = -1;
+
+        uint32_t connectionId;
+        {
+            std::lock_guard<std::mutex> lock(connection.mutex);
+            connectionId = connection.id;
+            connection.id = 0;
+            connection.address.clear();
+            connection.ClearWriteQueue();
+            connection.closeRequested = false;
+        }
+        connection.readRing.Clear();
+        connection.readPaused = false;
+        connection.writeBlocked = false;
+        connection.stalled = false;
+
+        m_freeSlots.push_back(slot);
+        m_activeConnections.fetch_sub(1, std::memory_order_relaxed);
+        m_connectionsClosed.fetch_add(1, std::memory_order_relaxed);
+
+        if (notify && m_disconnectCallback) {
+            m_disconnectCallback(connectionId);
+        }
+    }
+
+#else
+
+    bool ServerTransport::Start(const ServerTransportConfig& config) {
+        m_config = config;
+        VOXELCRAFT_ERROR("Server transport requires epoll and is only available on Linux");
+        return false;
+    }
+
+    void ServerTransport::Stop() {
+        m_running = false;
+    }
+
+    void ServerTransport::CloseSockets() {}
+    void ServerTransport::MarkPending(uint32_t) {}
+    void ServerTransport::ReactorThread() {}
+    void ServerTransport::AcceptConnections() {}
+    void ServerTransport::HandleReadable(uint32_t) {}
+    bool ServerTransport::ParseFrames(Connection&) { return false; }
+    void ServerTransport::FlushConnection(uint32_t) {}
+    bool ServerTransport::ProcessPending() { return false; }
+    void ServerTransport::CheckTimeouts() {}
+    void ServerTransport::CloseConnection(uint32_t, bool) {}
+
+#endif
+
+} // namespace VoxelCraft
@@ -0,0 +1,222 @@
+#pragma once
+
+#include "ByteRing.hpp"
+#include "PacketBuffer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace VoxelCraft {
+
+    /**
+     * @struct ServerTransportConfig
+     * @brief Configuración del transporte TCP del servidor
+     */
+    struct ServerTransportConfig {
+        std::string bindAddress = "0.0.0.0";      ///< Dirección de escucha
+        uint16_t port = 25565;                    ///< Puerto (0 = elegido por el sistema)
+        size_t maxConnections = 1024;             ///< Conexiones simultáneas (máx. 65535)
+        size_t readBufferSize = 64 * 1024;        ///< Ring de lectura por conexión
+        size_t writeBufferSize = 256 * 1024;      ///< Bytes encolados como máximo por conexión
+        size_t maxQueuedFrames = 1024;            ///< Frames encolados como máximo por conexión
+        size_t maxFrameSize = 60 * 1024;          ///< Tamaño máximo de un frame recibido
+        float highWaterMark = 0.75f;              ///< Fracción de writeBufferSize encolada que pausa las lecturas
+        float lowWaterMark = 0.25f;               ///< Fracción por debajo de la cual se reanudan
+        std::chrono::milliseconds slowClientTimeout = std::chrono::milliseconds(5000); ///< Tiempo máximo por encima del high water mark
+        std::chrono::milliseconds idleTimeout = std::chrono::milliseconds(30000);      ///< Sin datos recibidos
+        int maxEventsPerWait = 256;               ///< Eventos por llamada a epoll_wait
+    };
+
+    /**
+     * @struct ServerTransportStats
+     * @brief Contadores del transporte desde Start
+     */
+    struct ServerTransportStats {
+        uint64_t connectionsAccepted = 0;
+        uint64_t connectionsRejected = 0;         ///< Sin hueco libre al aceptar
+        uint64_t connectionsClosed = 0;
+        uint64_t activeConnections = 0;
+        uint64_t framesReceived = 0;
+        uint64_t framesSent = 0;                  ///< Frames encolados para enviar
+        uint64_t bytesReceived = 0;
+        uint64_t bytesSent = 0;
+        uint64_t readCalls = 0;                   ///< Llamadas a readv
+        uint64_t writevCalls = 0;
+        uint64_t wakeups = 0;                     ///< Retornos de epoll_wait
+        uint64_t backpressureRejects = 0;         ///< Send rechazados por cola de envío llena
+        uint64_t readPauses = 0;                  ///< Veces que se pausó la lectura de un cliente
+        uint64_t slowClientDisconnects = 0;
+        uint64_t idleDisconnects = 0;
+        uint64_t protocolErrors = 0;              ///< Frames mayores que maxFrameSize
+    };
+
+    /**
+     * @class ServerTransport
+     * @brief Reactor epoll edge-triggered para las conexiones TCP del servidor
+     *
+     * Un solo hilo acepta, lee y escribe todas las conexiones. Cada conexión
+     * tiene un ring de lectura y una cola de envío reservados al aceptarla;
+     * los frames (longitud u32 little-endian + datos) se leen con readv y
+     * lo encolado se envía con writev, varios frames por llamada.
+     *
+     * La cola de envío guarda referencias a PacketBuffer, no copias: un
+     * broadcast comparte el mismo bloque entre todas las conexiones.
+     *
+     * Backpressure: Send falla con BACKPRESSURE si el frame supera los
+     * bytes o frames máximos encolados para el cliente. Mientras lo
+     * encolado supera highWaterMark no se leen más datos de ese cliente,
+     * y si sigue así más de slowClientTimeout se le desconecta.
+     *
+     * Los callbacks se ejecutan en el hilo del reactor y pueden llamar a
+     * Send y Disconnect. Send, Broadcast y Disconnect son thread-safe.
+     * Solo disponible en Linux; en otras plataformas Start devuelve false.
+     */
+    class ServerTransport {
+    public:
+        /**
+         * @enum SendResult
+         * @brief Resultado de encolar un frame
+         */
+        enum class SendResult {
+            QUEUED = 0,         ///< Encolado; se enviará en la próxima vuelta del reactor
+            BACKPRESSURE,       ///< La cola de envío del cliente está llena
+            TOO_LARGE,          ///< Mayor que writeBufferSize
+            NOT_CONNECTED       ///< Conexión inexistente o cerrándose
+        };
+
+        using ConnectCallback = std::function<void(uint32_t connectionId, const std::string& address)>;
+        using DisconnectCallback = std::function<void(uint32_t connectionId)>;
+        using FrameCallback = std::function<void(uint32_t connectionId, const uint8_t* data, size_t size)>;
+
+        ServerTransport();
+        ~ServerTransport();
+
+        ServerTransport(const ServerTransport&) = delete;
+        ServerTransport& operator=(const ServerTransport&) = delete;
+
+        /**
+         * @brief Abrir el socket de escucha y arrancar el hilo del reactor
+         * @return true si el servidor escucha
+         */
+        bool Start(const ServerTransportConfig& config);
+
+        /**
+         * @brief Detener el reactor y cerrar todas las conexiones
+         */
+        void Stop();
+
+        bool IsRunning() const { return m_running; }
+
+        /**
+         * @brief Puerto real de escucha (útil con port = 0)
+         */
+        uint16_t GetPort() const { return m_boundPort; }
+
+        // Callbacks (configurar antes de Start)
+        void SetConnectCallback(const ConnectCallback& callback) { m_connectCallback = callback; }
+        void SetDisconnectCallback(const DisconnectCallback& callback) { m_disconnectCallback = callback; }
+        void SetFrameCallback(const FrameCallback& callback) { m_frameCallback = callback; }
+
+        /**
+         * @brief Encolar un frame para una conexión (copia los datos a un PacketBuffer)
+         */
+        SendResult Send(uint32_t connectionId, const void* data, size_t size);
+
+        /**
+         * @brief Encolar un frame ya serializado, sin copiarlo
+         */
+        SendResult Send(uint32_t connectionId, const PacketBuffer& frame);
+
+        /**
+         * @brief Encolar un frame para todas las conexiones
+         * @return Número de conexiones en las que se encoló
+         */
+        size_t Broadcast(const void* data, size_t size);
+
+        /**
+         * @brief Encolar el mismo PacketBuffer en todas las conexiones
+         * @return Número de conexiones en las que se encoló
+         */
+        size_t Broadcast(const PacketBuffer& frame);
+
+        /**
+         * @brief Cerrar una conexión tras enviar lo ya encolado
+         */
+        void Disconnect(uint32_t connectionId);
+
+        /**
+         * @brief Bytes pendientes de enviar a una conexión
+         */
+        size_t GetQueuedBytes(uint32_t connectionId) const;
+
+        std::string GetAddress(uint32_t connectionId) const;
+        size_t GetConnectionCount() const { return m_activeConnections.load(std::memory_order_relaxed); }
+        ServerTransportStats GetStats() const;
+
+    private:
+        struct Connection;
+
+        ServerTransportConfig m_config;
+        std::atomic<bool> m_running;
+        std::thread m_reactorThread;
+        uint16_t m_boundPort;
+
+        int m_epollFd;
+        int m_listenFd;
+        int m_wakeFd;                                   ///< eventfd para despertar al reactor
+
+        // Huecos fijos desde Start: los ids codifican hueco + generación
+        std::vector<std::unique_ptr<Connection>> m_connections;
+        std::vector<uint32_t> m_freeSlots;              ///< Solo el reactor
+        std::atomic<size_t> m_activeConnections;
+
+        // Conexiones con datos nuevos que enviar o cierre pedido
+        std::mutex m_pendingMutex;
+        std::vector<uint32_t> m_pendingSlots;
+        std::vector<uint32_t> m_pendingScratch;         ///< Solo el reactor
+
+        std::vector<uint8_t> m_frameScratch;            ///< Frames partidos por el final del ring
+
+        ConnectCallback m_connectCallback;
+        DisconnectCallback m_disconnectCallback;
+        FrameCallback m_frameCallback;
+
+        // Estadísticas
+        std::atomic<uint64_t> m_connectionsAccepted;
+        std::atomic<uint64_t> m_connectionsRejected;
+        std::atomic<uint64_t> m_connectionsClosed;
+        std::atomic<uint64_t> m_framesReceived;
+        std::atomic<uint64_t> m_framesSent;
+        std::atomic<uint64_t> m_bytesReceived;
+        std::atomic<uint64_t> m_bytesSent;
+        std::atomic<uint64_t> m_readCalls;
+        std::atomic<uint64_t> m_writevCalls;
+        std::atomic<uint64_t> m_wakeups;
+        std::atomic<uint64_t> m_backpressureRejects;
+        std::atomic<uint64_t> m_readPauses;
+        std::atomic<uint64_t> m_slowClientDisconnects;
+        std::atomic<uint64_t> m_idleDisconnects;
+        std::atomic<uint64_t> m_protocolErrors;
+
+        // Métodos privados
+        void ReactorThread();
+        void AcceptConnections();
+        void HandleReadable(uint32_t slot);
+        bool ParseFrames(Connection& connection);
+        void FlushConnection(uint32_t slot);
+        bool ProcessPending();
+        void CloseConnection(uint32_t slot, bool notify);
+        void CheckTimeouts();
+        void MarkPending(uint32_t slot);
+        Connection* Lookup(uint32_t connectionId) const;
+        void CloseSockets();
+    };
+
+} // namespace VoxelCraft
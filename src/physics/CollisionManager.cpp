@@ -10,6 +10,15 @@
 
 namespace VoxelCraft {
 
+	namespace {
+
+		TreeBounds ToTreeBounds(const glm::vec3& min, const glm::vec3& max)
+		{
+			return TreeBounds{ { min.x, min.y, min.z }, { max.x, max.y, max.z } };
+		}
+
+	} // namespace
+
 	CollisionManager::CollisionManager()
 		: m_initialized(false)
 		, m_detectingCollisions(false)
@@ -78,6 +87,13 @@ namespace VoxelCraft {
 		// Clear all collision data
 		Clear();
 
+		{
+			std::unique_lock<std::mutex> lock(m_collisionMutex);
+			m_colliderTree.Clear();
+			m_colliderProxies.clear();
+			m_colliders.clear();
+		}
+
 		// Shutdown collision phases
 		m_broadPhase.reset();
 		m_narrowPhase.reset();
@@ -126,6 +142,11 @@ namespace VoxelCraft {
 				m_spatialPartition->AddCollider(collider);
 			}
 
+			auto bounds = collider->GetWorldBounds();
+			ColliderProxy& proxy = m_colliderProxies[collider.get()];
+			proxy.collider = collider;
+			proxy.proxyId = m_colliderTree.CreateProxy(ToTreeBounds(bounds.min, bounds.max), &proxy);
+
 			VOXELCRAFT_LOG_DEBUG("Added collider to collision manager");
 		}
 	}
@@ -148,6 +169,12 @@ namespace VoxelCraft {
 				m_spatialPartition->RemoveCollider(collider);
 			}
 
+			auto proxyIt = m_colliderProxies.find(collider.get());
+			if (proxyIt != m_colliderProxies.end()) {
+				m_colliderTree.DestroyProxy(proxyIt->second.proxyId);
+				m_colliderProxies.erase(proxyIt);
+			}
+
 			// Remove associated contacts
 			std::vector<size_t> contactsToRemove;
 			for (size_t i = 0; i < m_contacts.size(); ++i) {
@@ -168,11 +195,17 @@ namespace VoxelCraft {
 
 	void CollisionManager::UpdateCollider(std::shared_ptr<Collider> collider)
 	{
-		if (!collider || !m_initialized || !m_spatialPartition) {
+		if (!collider || !m_initialized) {
 			return;
 		}
 
-		m_spatialPartition->UpdateCollider(collider);
+		std::unique_lock<std::mutex> lock(m_collisionMutex);
+
+		UpdateColliderProxy(collider);
+
+		if (m_spatialPartition) {
+			m_spatialPartition->UpdateCollider(collider);
+		}
 	}
 
 	void CollisionManager::BroadPhase()
@@ -337,32 +370,10 @@ namespace VoxelCraft {
 
 		m_stats.rayCastCount++;
 
-		bool hitFound = false;
-		float closestDistance = std::numeric_limits<float>::max();
-
 		std::unique_lock<std::mutex> lock(m_collisionMutex);
 
-		for (auto& collider : m_colliders) {
-			if (!collider || !collider->IsEnabled()) {
-				continue;
-			}
-
-			// Check layer mask
-			if ((collider->GetLayerMask() & layerMask) == 0) {
-				continue;
-			}
-
-			RayCastHit currentHit;
-			if (RayCastAgainstCollider(from, to, collider, currentHit)) {
-				if (currentHit.distance < closestDistance) {
-					hit = currentHit;
-					closestDistance = currentHit.distance;
-					hitFound = true;
-				}
-			}
-		}
-
-		return hitFound;
+		VoxelGridQuery terrain(m_chunkProvider, false);
+		return RayCastInternal(from, to, layerMask, terrain, hit);
 	}
 
 	bool CollisionManager::SphereCast(const glm::vec3& from, const glm::vec3& to, float radius, RayCastHit& hit, uint32_t layerMask)
@@ -373,68 +384,114 @@ namespace VoxelCraft {
 
 		m_stats.sphereCastCount++;
 
-		bool hitFound = false;
-		float closestDistance = std::numeric_limits<float>::max();
+		std::unique_lock<std::mutex> lock(m_collisionMutex);
+
+		// Swept as its bounding cube, against terrain and collider boxes alike
+		return ShapeCastInternal(from, to, glm::vec3(radius), layerMask, hit);
+	}
+
+	bool CollisionManager::BoxCast(const glm::vec3& from, const glm::vec3& to, const glm::vec3& halfExtents, RayCastHit& hit, uint32_t layerMask)
+	{
+		if (!m_initialized) {
+			return false;
+		}
+
+		m_stats.boxCastCount++;
 
 		std::unique_lock<std::mutex> lock(m_collisionMutex);
 
-		for (auto& collider : m_colliders) {
-			if (!collider || !collider->IsEnabled()) {
-				continue;
-			}
+		return ShapeCastInternal(from, to, halfExtents, layerMask, hit);
+	}
 
-			// Check layer mask
-			if ((collider->GetLayerMask() & layerMask) == 0) {
-				continue;
-			}
+	int CollisionManager::RayCastBatch(const std::vector<RayCastQuery>& queries, std::vector<RayCastHit>& hits)
+	{
+		hits.assign(queries.size(), RayCastHit());
+		if (!m_initialized || queries.empty()) {
+			return 0;
+		}
 
-			RayCastHit currentHit;
-			if (SphereCastAgainstCollider(from, to, radius, collider, currentHit)) {
-				if (currentHit.distance < closestDistance) {
-					hit = currentHit;
-					closestDistance = currentHit.distance;
-					hitFound = true;
-				}
+		m_stats.rayCastCount += static_cast<int>(queries.size());
+
+		// Rays from the same chunk run back to back so they share its lookup
+		std::vector<uint32_t> order(queries.size());
+		for (uint32_t i = 0; i < order.size(); ++i) {
+			order[i] = i;
+		}
+		auto chunkOf = [&queries](uint32_t i) {
+			const glm::vec3& from = queries[i].from;
+			return std::make_pair(static_cast<int32_t>(std::floor(from.x)) >> 4,
+				static_cast<int32_t>(std::floor(from.z)) >> 4);
+		};
+		std::sort(order.begin(), order.end(), [&chunkOf](uint32_t a, uint32_t b) {
+			return chunkOf(a) < chunkOf(b);
+		});
+
+		std::unique_lock<std::mutex> lock(m_collisionMutex);
+
+		VoxelGridQuery terrain(m_chunkProvider, false);
+		int hitCount = 0;
+		for (uint32_t index : order) {
+			const RayCastQuery& query = queries[index];
+			if (RayCastInternal(query.from, query.to, query.layerMask, terrain, hits[index])) {
+				++hitCount;
 			}
 		}
 
-		return hitFound;
+		return hitCount;
 	}
 
-	bool CollisionManager::BoxCast(const glm::vec3& from, const glm::vec3& to, const glm::vec3& halfExtents, RayCastHit& hit, uint32_t layerMask)
+	bool CollisionManager::SweepAABB(const glm::vec3& min, const glm::vec3& max, const glm::vec3& displacement, VoxelSweepHit& hit)
 	{
 		if (!m_initialized) {
 			return false;
 		}
 
-		m_stats.boxCastCount++;
+		m_stats.sweepTestCount++;
 
-		bool hitFound = false;
-		float closestDistance = std::numeric_limits<float>::max();
+		std::unique_lock<std::mutex> lock(m_collisionMutex);
+
+		VoxelGridQuery terrain(m_chunkProvider, true);
+		return terrain.SweepAABB(min, max, displacement, hit);
+	}
+
+	glm::vec3 CollisionManager::MoveAABB(const glm::vec3& min, const glm::vec3& max, const glm::vec3& displacement)
+	{
+		if (!m_initialized) {
+			return displacement;
+		}
+
+		m_stats.sweepTestCount++;
 
 		std::unique_lock<std::mutex> lock(m_collisionMutex);
 
-		for (auto& collider : m_colliders) {
-			if (!collider || !collider->IsEnabled()) {
-				continue;
-			}
+		VoxelGridQuery terrain(m_chunkProvider, true);
+		return terrain.MoveAABB(min, max, displacement);
+	}
 
-			// Check layer mask
-			if ((collider->GetLayerMask() & layerMask) == 0) {
-				continue;
+	void CollisionManager::MoveAABBBatch(const std::vector<BoxMoveQuery>& queries, std::vector<glm::vec3>& moved)
+	{
+		moved.resize(queries.size());
+		if (!m_initialized) {
+			for (size_t i = 0; i < queries.size(); ++i) {
+				moved[i] = queries[i].displacement;
 			}
+			return;
+		}
 
-			RayCastHit currentHit;
-			if (BoxCastAgainstCollider(from, to, halfExtents, collider, currentHit)) {
-				if (currentHit.distance < closestDistance) {
-					hit = currentHit;
-					closestDistance = currentHit.distance;
-					hitFound = true;
-				}
-			}
+		m_stats.sweepTestCount += static_cast<int>(queries.size());
+
+		std::unique_lock<std::mutex> lock(m_collisionMutex);
+
+		VoxelGridQuery terrain(m_chunkProvider, true);
+		for (size_t i = 0; i < queries.size(); ++i) {
+			moved[i] = terrain.MoveAABB(queries[i].min, queries[i].max, queries[i].displacement);
 		}
+	}
 
-		return hitFound;
+	void CollisionManager::SetChunkProvider(VoxelGridQuery::ChunkProvider chunkProvider)
+	{
+		std::unique_lock<std::mutex> lock(m_collisionMutex);
+		m_chunkProvider = std::move(chunkProvider);
 	}
 
 	bool CollisionManager::OverlapSphere(const glm::vec3& center, float radius, std::vector<OverlapResult>& results, uint32_t layerMask)
@@ -449,14 +506,11 @@ namespace VoxelCraft {
 
 		std::unique_lock<std::mutex> lock(m_collisionMutex);
 
-		for (auto& collider : m_colliders) {
-			if (!collider || !collider->IsEnabled()) {
-				continue;
-			}
-
-			// Check layer mask
-			if ((collider->GetLayerMask() & layerMask) == 0) {
-				continue;
+		const TreeBounds queryBounds = ToTreeBounds(center - glm::vec3(radius), center + glm::vec3(radius));
+		m_colliderTree.Query(queryBounds, [&](int32_t proxyId) {
+			const auto& collider = static_cast<ColliderProxy*>(m_colliderTree.GetUserData(proxyId))->collider;
+			if (!collider->IsEnabled() || (collider->GetLayerMask() & layerMask) == 0) {
+				return true;
 			}
 
 			// Simple sphere overlap check
@@ -474,7 +528,8 @@ namespace VoxelCraft {
 				result.layerMask = collider->GetLayerMask();
 				results.push_back(result);
 			}
-		}
+			return true;
+		});
 
 		return !results.empty();
 	}
@@ -491,14 +546,11 @@ namespace VoxelCraft {
 
 		std::unique_lock<std::mutex> lock(m_collisionMutex);
 
-		for (auto& collider : m_colliders) {
-			if (!collider || !collider->IsEnabled()) {
-				continue;
-			}
-
-			// Check layer mask
-			if ((collider->GetLayerMask() & layerMask) == 0) {
-				continue;
+		const TreeBounds queryBounds = ToTreeBounds(center - halfExtents, center + halfExtents);
+		m_colliderTree.Query(queryBounds, [&](int32_t proxyId) {
+			const auto& collider = static_cast<ColliderProxy*>(m_colliderTree.GetUserData(proxyId))->collider;
+			if (!collider->IsEnabled() || (collider->GetLayerMask() & layerMask) == 0) {
+				return true;
 			}
 
 			// Simple AABB overlap check
@@ -515,7 +567,8 @@ namespace VoxelCraft {
 				result.layerMask = collider->GetLayerMask();
 				results.push_back(result);
 			}
-		}
+			return true;
+		});
 
 		return !results.empty();
 	}
@@ -657,13 +710,29 @@ namespace VoxelCraft {
 
 	void CollisionManager::UpdateSpatialPartition()
 	{
-		if (m_spatialPartition) {
-			for (auto& collider : m_colliders) {
-				if (collider) {
-					m_spatialPartition->UpdateCollider(collider);
-				}
+		for (auto& collider : m_colliders) {
+			if (!collider) {
+				continue;
 			}
+
+			UpdateColliderProxy(collider);
+
+			if (m_spatialPartition) {
+				m_spatialPartition->UpdateCollider(collider);
+			}
+		}
+	}
+
+	void CollisionManager::UpdateColliderProxy(const std::shared_ptr<Collider>& collider)
+	{
+		auto proxyIt = m_colliderProxies.find(collider.get());
+		if (proxyIt == m_colliderProxies.end()) {
+			return;
 		}
+
+		// Only colliders that left their fat box are reinserted
+		auto bounds = collider->GetWorldBounds();
+		m_colliderTree.MoveProxy(proxyIt->second.proxyId, ToTreeBounds(bounds.min, bounds.max), nullptr);
 	}
 
 	void CollisionManager::CollectCollisionPairs()
@@ -848,14 +917,114 @@ namespace VoxelCraft {
 		return std::max(restitutionA, restitutionB);
 	}
 
-	bool CollisionManager::RayCastAgainstCollider(const glm::vec3& from, const glm::vec3& to, std::shared_ptr<Collider> collider, RayCastHit& hit)
+	bool CollisionManager::RayCastInternal(const glm::vec3& from, const glm::vec3& to, uint32_t layerMask, VoxelGridQuery& terrain, RayCastHit& hit)
 	{
-		// Simple ray cast implementation
-		// In a full implementation, this would use proper ray-shape intersection tests
+		const glm::vec3 delta = to - from;
+		const float length = glm::length(delta);
+		if (length < 0.001f) {
+			return false;
+		}
 
-		auto bounds = collider->GetWorldBounds();
+		const glm::vec3 dir = delta / length;
+		bool hitFound = false;
+		glm::vec3 end = to;
+
+		// Terrain first: its hit bounds how far colliders need to be searched
+		VoxelRayHit terrainHit;
+		if (m_chunkProvider && terrain.RayCast(from, dir, length, terrainHit)) {
+			hit = RayCastHit();
+			hit.point = terrainHit.point;
+			hit.normal = glm::vec3(terrainHit.normal);
+			hit.distance = terrainHit.distance;
+			hit.hitTerrain = true;
+			hit.block = terrainHit.block;
+			hit.blockId = terrainHit.blockId;
+			hitFound = true;
+			end = terrainHit.point;
+		}
 
-		// Simple AABB ray intersection
+		if (CastAgainstColliders(from, end, glm::vec3(0.0f), layerMask, hit)) {
+			hitFound = true;
+		}
+
+		return hitFound;
+	}
+
+	bool CollisionManager::ShapeCastInternal(const glm::vec3& from, const glm::vec3& to, const glm::vec3& halfExtents, uint32_t layerMask, RayCastHit& hit)
+	{
+		const glm::vec3 delta = to - from;
+		const float length = glm::length(delta);
+		if (length < 0.001f) {
+			return false;
+		}
+
+		bool hitFound = false;
+		glm::vec3 end = to;
+
+		if (m_chunkProvider) {
+			VoxelGridQuery terrain(m_chunkProvider, false);
+			VoxelSweepHit terrainHit;
+			if (terrain.SweepAABB(from - halfExtents, from + halfExtents, delta, terrainHit)) {
+				const glm::vec3 normal(terrainHit.normal);
+				end = from + delta * terrainHit.fraction;
+
+				hit = RayCastHit();
+				hit.normal = normal;
+				hit.point = end - normal * halfExtents;
+				hit.distance = length * terrainHit.fraction;
+				hit.hitTerrain = true;
+				hit.block = terrainHit.block;
+				hit.blockId = terrainHit.blockId;
+				hitFound = true;
+			}
+		}
+
+		if (CastAgainstColliders(from, end, halfExtents, layerMask, hit)) {
+			hitFound = true;
+		}
+
+		return hitFound;
+	}
+
+	bool CollisionManager::CastAgainstColliders(const glm::vec3& from, const glm::vec3& to, const glm::vec3& halfExtents, uint32_t layerMask, RayCastHit& hit)
+	{
+		const float length = glm::length(to - from);
+		if (length <= 0.0f) {
+			return false;
+		}
+
+		const float start[3] = { from.x, from.y, from.z };
+		const float end[3] = { to.x, to.y, to.z };
+		const float extension[3] = { halfExtents.x, halfExtents.y, halfExtents.z };
+		bool hitFound = false;
+
+		// The tree prunes by fat boxes; each candidate is then cast exactly
+		m_colliderTree.RayCast(start, end, extension, [&](int32_t proxyId, float maxFraction) {
+			const auto& collider = static_cast<ColliderProxy*>(m_colliderTree.GetUserData(proxyId))->collider;
+			if (!collider->IsEnabled() || (collider->GetLayerMask() & layerMask) == 0) {
+				return maxFraction;
+			}
+
+			auto bounds = collider->GetWorldBounds();
+			RayCastHit currentHit;
+			if (!RayCastAgainstBounds(from, to, bounds.min - halfExtents, bounds.max + halfExtents, collider, currentHit) ||
+				currentHit.distance >= maxFraction * length) {
+				return maxFraction;
+			}
+
+			if (halfExtents != glm::vec3(0.0f)) {
+				currentHit.point -= currentHit.normal * halfExtents;
+			}
+			hit = currentHit;
+			hitFound = true;
+			return currentHit.distance / length;
+		});
+
+		return hitFound;
+	}
+
+	bool CollisionManager::RayCastAgainstBounds(const glm::vec3& from, const glm::vec3& to, const glm::vec3& boundsMin, const glm::vec3& boundsMax, std::shared_ptr<Collider> collider, RayCastHit& hit)
+	{
 		glm::vec3 dir = to - from;
 		float length = glm::length(dir);
 
@@ -863,68 +1032,75 @@ namespace VoxelCraft {
 			return false;
 		}
 
-		dir = glm::normalize(dir);
+		dir /= length;
 
-		// Calculate intersection with AABB
+		// Slab method; the last slab entered gives the face
 		float tmin = 0.0f;
 		float tmax = length;
+		int hitAxis = -1;
 
 		for (int i = 0; i < 3; ++i) {
+			if (std::abs(dir[i]) < 1e-8f) {
+				if (from[i] < boundsMin[i] || from[i] > boundsMax[i]) {
+					return false;
+				}
+				continue;
+			}
+
 			float invD = 1.0f / dir[i];
-			float t0 = (bounds.min[i] - from[i]) * invD;
-			float t1 = (bounds.max[i] - from[i]) * invD;
+			float t0 = (boundsMin[i] - from[i]) * invD;
+			float t1 = (boundsMax[i] - from[i]) * invD;
 
 			if (invD < 0.0f) {
 				std::swap(t0, t1);
 			}
 
-			tmin = std::max(tmin, t0);
+			if (t0 > tmin) {
+				tmin = t0;
+				hitAxis = i;
+			}
 			tmax = std::min(tmax, t1);
 
-			if (tmax <= tmin) {
+			if (tmax < tmin) {
 				return false;
 			}
 		}
 
-		if (tmin > length) {
-			return false;
-		}
-
-		// We have a hit
 		hit.collider = collider;
 		hit.rigidBody = collider->GetRigidBody();
 		hit.point = from + dir * tmin;
-		hit.normal = -dir; // Simple normal calculation
+		hit.normal = glm::vec3(0.0f);
+		if (hitAxis >= 0) {
+			hit.normal[hitAxis] = dir[hitAxis] > 0.0f ? -1.0f : 1.0f;
+		} else {
+			// Started inside
+			hit.normal = -dir;
+		}
 		hit.distance = tmin;
 		hit.layerMask = collider->GetLayerMask();
+		hit.hitTerrain = false;
 
 		return true;
 	}
 
-	bool CollisionManager::SphereCastAgainstCollider(const glm::vec3& from, const glm::vec3& to, float radius, std::shared_ptr<Collider> collider, RayCastHit& hit)
+	bool CollisionManager::RayCastAgainstCollider(const glm::vec3& from, const glm::vec3& to, std::shared_ptr<Collider> collider, RayCastHit& hit)
 	{
-		// Sphere cast implementation
 		auto bounds = collider->GetWorldBounds();
+		return RayCastAgainstBounds(from, to, bounds.min, bounds.max, collider, hit);
+	}
 
+	bool CollisionManager::SphereCastAgainstCollider(const glm::vec3& from, const glm::vec3& to, float radius, std::shared_ptr<Collider> collider, RayCastHit& hit)
+	{
 		// Expand bounds by sphere radius
-		bounds.min -= glm::vec3(radius);
-		bounds.max += glm::vec3(radius);
-
-		// Use ray cast against expanded bounds
-		return RayCastAgainstCollider(from, to, collider, hit);
+		auto bounds = collider->GetWorldBounds();
+		return RayCastAgainstBounds(from, to, bounds.min - glm::vec3(radius), bounds.max + glm::vec3(radius), collider, hit);
 	}
 
 	bool CollisionManager::BoxCastAgainstCollider(const glm::vec3& from, const glm::vec3& to, const glm::vec3& halfExtents, std::shared_ptr<Collider> collider, RayCastHit& hit)
 	{
-		// Box cast implementation
-		auto bounds = collider->GetWorldBounds();
-
 		// Expand bounds by box half extents
-		bounds.min -= halfExtents;
-		bounds.max += halfExtents;
-
-		// Use ray cast against expanded bounds
-		return RayCastAgainstCollider(from, to, collider, hit);
+		auto bounds = collider->GetWorldBounds();
+		return RayCastAgainstBounds(from, to, bounds.min - halfExtents, bounds.max + halfExtents, collider, hit);
 	}
 
 	bool CollisionManager::CheckOverlap(std::shared_ptr<Collider> colliderA, std::shared_ptr<Collider> colliderB, Contact& contact)
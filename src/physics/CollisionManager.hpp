@@ -10,6 +10,8 @@
 #include <functional>
 #include <cstdint>
 #include "core/Logger.hpp"
+#include "DynamicAABBTree.hpp"
+#include "VoxelGridQuery.hpp"
 
 namespace VoxelCraft {
 
@@ -23,6 +25,9 @@ namespace VoxelCraft {
 
 	/**
 	 * @brief Ray cast hit result
+	 *
+	 * Terrain hits have no collider; they carry the block instead. A miss
+	 * keeps the default distance.
 	 */
 	struct RayCastHit
 	{
@@ -32,13 +37,39 @@ namespace VoxelCraft {
 		glm::vec3 normal;
 		float distance;
 		uint32_t layerMask;
+		bool hitTerrain;
+		glm::ivec3 block;
+		uint16_t blockId;
 
 		RayCastHit()
 			: distance(std::numeric_limits<float>::max())
 			, layerMask(0xFFFFFFFF)
+			, hitTerrain(false)
+			, block(0)
+			, blockId(0)
 		{}
 	};
 
+	/**
+	 * @brief One ray of a batched ray cast
+	 */
+	struct RayCastQuery
+	{
+		glm::vec3 from;
+		glm::vec3 to;
+		uint32_t layerMask = 0xFFFFFFFF;
+	};
+
+	/**
+	 * @brief One box of a batched terrain move
+	 */
+	struct BoxMoveQuery
+	{
+		glm::vec3 min;
+		glm::vec3 max;
+		glm::vec3 displacement;
+	};
+
 	/**
 	 * @brief Overlap result
 	 */
@@ -268,6 +299,35 @@ namespace VoxelCraft {
 		 */
 		bool BoxCast(const glm::vec3& from, const glm::vec3& to, const glm::vec3& halfExtents, RayCastHit& hit, uint32_t layerMask = 0xFFFFFFFF);
 
+		/**
+		 * @brief Cast many rays under one lock, sharing chunk lookups
+		 * @param hits Resized to queries.size(); misses keep the default distance
+		 * @return Number of rays that hit
+		 */
+		int RayCastBatch(const std::vector<RayCastQuery>& queries, std::vector<RayCastHit>& hits);
+
+		/**
+		 * @brief Sweep a box against terrain
+		 */
+		bool SweepAABB(const glm::vec3& min, const glm::vec3& max, const glm::vec3& displacement, VoxelSweepHit& hit);
+
+		/**
+		 * @brief Move a box as far as terrain allows, sliding along what it hits
+		 * @return Displacement actually applied
+		 */
+		glm::vec3 MoveAABB(const glm::vec3& min, const glm::vec3& max, const glm::vec3& displacement);
+
+		/**
+		 * @brief Move many boxes against terrain, sharing chunk lookups
+		 * @param moved Resized to queries.size(); displacement applied to each box
+		 */
+		void MoveAABBBatch(const std::vector<BoxMoveQuery>& queries, std::vector<glm::vec3>& moved);
+
+		/**
+		 * @brief Set the chunk lookup used by terrain queries (ChunkSystem::GetChunk in game)
+		 */
+		void SetChunkProvider(VoxelGridQuery::ChunkProvider chunkProvider);
+
 		/**
 		 * @brief Overlap sphere
 		 */
@@ -361,6 +421,18 @@ namespace VoxelCraft {
 		// Spatial partitioning
 		std::unique_ptr<SpatialPartition> m_spatialPartition;
 
+		// Collider bounds for queries; proxy user data points at the entry
+		struct ColliderProxy
+		{
+			std::shared_ptr<Collider> collider;
+			int32_t proxyId;
+		};
+		DynamicAABBTree m_colliderTree;
+		std::unordered_map<Collider*, ColliderProxy> m_colliderProxies;
+
+		// Terrain for ray and box queries
+		VoxelGridQuery::ChunkProvider m_chunkProvider;
+
 		// Collision detection phases
 		std::unique_ptr<BroadPhase> m_broadPhase;
 		std::unique_ptr<NarrowPhase> m_narrowPhase;
@@ -451,6 +523,32 @@ namespace VoxelCraft {
 		 */
 		float CalculateContactRestitution(std::shared_ptr<Collider> colliderA, std::shared_ptr<Collider> colliderB) const;
 
+		/**
+		 * @brief Refresh a collider's proxy after it moved
+		 */
+		void UpdateColliderProxy(const std::shared_ptr<Collider>& collider);
+
+		/**
+		 * @brief Ray cast against terrain, then against colliders nearer than the terrain hit
+		 */
+		bool RayCastInternal(const glm::vec3& from, const glm::vec3& to, uint32_t layerMask, VoxelGridQuery& terrain, RayCastHit& hit);
+
+		/**
+		 * @brief Box sweep against terrain, then against colliders nearer than the terrain hit
+		 */
+		bool ShapeCastInternal(const glm::vec3& from, const glm::vec3& to, const glm::vec3& halfExtents, uint32_t layerMask, RayCastHit& hit);
+
+		/**
+		 * @brief Cast a segment through the collider tree, keeping the nearest hit
+		 * @param halfExtents Grows every collider, for swept shapes
+		 */
+		bool CastAgainstColliders(const glm::vec3& from, const glm::vec3& to, const glm::vec3& halfExtents, uint32_t layerMask, RayCastHit& hit);
+
+		/**
+		 * @brief Ray against a box, reporting the face entered
+		 */
+		bool RayCastAgainstBounds(const glm::vec3& from, const glm::vec3& to, const glm::vec3& boundsMin, const glm::vec3& boundsMax, std::shared_ptr<Collider> collider, RayCastHit& hit);
+
 		/**
 		 * @brief Perform ray cast against single collider
 		 */
@@ -6,6 +6,7 @@
  */
 
 #include "CollisionSystem.hpp"
+#include "DynamicAABBTree.hpp"
 
 #include <algorithm>
 #include <cmath>
@@ -38,23 +39,19 @@ namespace VoxelCraft {
         std::unordered_map<uint64_t, std::vector<CollisionObject*>> spatialHash;
         float cellSize = 10.0f;
 
-        // For BVH
-        struct BVHNode {
-            AABB bounds;
-            int left = -1;
-            int right = -1;
-            int objectIndex = -1;
-            bool isLeaf = false;
-        };
-        std::vector<BVHNode> bvhNodes;
-        int rootNode = -1;
-
-        // For sweep and prune
+        // For BVH: one proxy per object, kept across frames
+        DynamicAABBTree tree;
+        std::unordered_map<CollisionObject*, int32_t> proxies;
+
+        // For sweep and prune: kept sorted by min.x between frames
         std::vector<CollisionObject*> sortedX;
-        std::vector<CollisionObject*> sortedY;
-        std::vector<CollisionObject*> sortedZ;
     };
 
+    static TreeBounds ToTreeBounds(const AABB& aabb) {
+        return TreeBounds{ { aabb.min.x, aabb.min.y, aabb.min.z },
+                           { aabb.max.x, aabb.max.y, aabb.max.z } };
+    }
+
     // CollisionObject implementation
     CollisionObject::CollisionObject() = default;
     CollisionObject::~CollisionObject() = default;
@@ -169,6 +166,7 @@ namespace VoxelCraft {
         // Initialize broadphase data
         m_broadphaseData = std::make_unique<BroadphaseData>();
         m_broadphaseData->cellSize = config.cellSize;
+        m_broadphaseData->tree = DynamicAABBTree(config.proxyMargin);
 
         Logger::Info("CollisionSystem initialized with {} collision objects",
                     m_objects.size());
@@ -192,10 +190,9 @@ namespace VoxelCraft {
             m_broadphaseData->aabbs.clear();
             m_broadphaseData->indices.clear();
             m_broadphaseData->spatialHash.clear();
-            m_broadphaseData->bvhNodes.clear();
+            m_broadphaseData->tree.Clear();
+            m_broadphaseData->proxies.clear();
             m_broadphaseData->sortedX.clear();
-            m_broadphaseData->sortedY.clear();
-            m_broadphaseData->sortedZ.clear();
         }
 
         // Clear manifolds and pairs
@@ -266,6 +263,9 @@ namespace VoxelCraft {
             m_broadphaseData->objects.push_back(object);
             m_broadphaseData->aabbs.push_back(object->GetWorldAABB());
             m_broadphaseData->indices.push_back(static_cast<int>(m_broadphaseData->objects.size() - 1));
+            m_broadphaseData->proxies[object] =
+                m_broadphaseData->tree.CreateProxy(ToTreeBounds(object->GetWorldAABB()), object);
+            m_broadphaseData->sortedX.push_back(object);
         }
 
         m_stats.totalObjects++;
@@ -312,6 +312,18 @@ namespace VoxelCraft {
                 m_broadphaseData->aabbs.erase(m_broadphaseData->aabbs.begin() + index);
                 m_broadphaseData->indices.erase(m_broadphaseData->indices.begin() + index);
             }
+
+            auto proxyIt = m_broadphaseData->proxies.find(object);
+            if (proxyIt != m_broadphaseData->proxies.end()) {
+                m_broadphaseData->tree.DestroyProxy(proxyIt->second);
+                m_broadphaseData->proxies.erase(proxyIt);
+            }
+
+            auto sortedIt = std::find(m_broadphaseData->sortedX.begin(),
+                                      m_broadphaseData->sortedX.end(), object);
+            if (sortedIt != m_broadphaseData->sortedX.end()) {
+                m_broadphaseData->sortedX.erase(sortedIt);
+            }
         }
 
         // Remove from cache
@@ -581,12 +593,18 @@ namespace VoxelCraft {
 
         std::shared_lock<std::shared_mutex> lock(m_collisionMutex);
 
-        for (CollisionObject* object : m_objects) {
+        if (!m_broadphaseData) {
+            return 0;
+        }
+
+        m_broadphaseData->tree.Query(ToTreeBounds(aabb), [&](int32_t proxyId) {
+            CollisionObject* object = static_cast<CollisionObject*>(m_broadphaseData->tree.GetUserData(proxyId));
             if (IsObjectInLayer(object, collisionMask) &&
                 object->GetWorldAABB().Intersects(aabb)) {
                 objects.push_back(object);
             }
-        }
+            return true;
+        });
 
         return static_cast<int>(objects.size());
     }
@@ -836,25 +854,19 @@ namespace VoxelCraft {
             return;
         }
 
-        // Sort objects by x, y, z coordinates
-        m_broadphaseData->sortedX = m_broadphaseData->objects;
-        m_broadphaseData->sortedY = m_broadphaseData->objects;
-        m_broadphaseData->sortedZ = m_broadphaseData->objects;
-
-        std::sort(m_broadphaseData->sortedX.begin(), m_broadphaseData->sortedX.end(),
-                 [](CollisionObject* a, CollisionObject* b) {
-                     return a->GetWorldAABB().min.x < b->GetWorldAABB().min.x;
-                 });
-
-        std::sort(m_broadphaseData->sortedY.begin(), m_broadphaseData->sortedY.end(),
-                 [](CollisionObject* a, CollisionObject* b) {
-                     return a->GetWorldAABB().min.y < b->GetWorldAABB().min.y;
-                 });
-
-        std::sort(m_broadphaseData->sortedZ.begin(), m_broadphaseData->sortedZ.end(),
-                 [](CollisionObject* a, CollisionObject* b) {
-                     return a->GetWorldAABB().min.z < b->GetWorldAABB().min.z;
-                 });
+        // Objects move little between frames, so the previous order is nearly
+        // sorted and insertion sort is close to linear
+        std::vector<CollisionObject*>& sorted = m_broadphaseData->sortedX;
+        for (size_t i = 1; i < sorted.size(); ++i) {
+            CollisionObject* object = sorted[i];
+            const float key = object->GetWorldAABB().min.x;
+            size_t j = i;
+            while (j > 0 && sorted[j - 1]->GetWorldAABB().min.x > key) {
+                sorted[j] = sorted[j - 1];
+                --j;
+            }
+            sorted[j] = object;
+        }
     }
 
     void CollisionSystem::BuildDynamicBVH() {
@@ -862,43 +874,30 @@ namespace VoxelCraft {
             return;
         }
 
-        // Simple BVH construction
-        m_broadphaseData->bvhNodes.clear();
-        if (m_broadphaseData->objects.empty()) {
-            return;
-        }
-
-        // Create leaf nodes
-        for (size_t i = 0; i < m_broadphaseData->objects.size(); ++i) {
-            BroadphaseData::BVHNode node;
-            node.bounds = m_broadphaseData->objects[i]->GetWorldAABB();
-            node.objectIndex = static_cast<int>(i);
-            node.isLeaf = true;
-            m_broadphaseData->bvhNodes.push_back(node);
-        }
-
-        // Build hierarchy (simplified)
-        if (m_broadphaseData->bvhNodes.size() > 1) {
-            // Create root node
-            BroadphaseData::BVHNode root;
-            root.left = 0;
-            root.right = 1;
-            root.isLeaf = false;
+        // Static objects never move; dynamic ones are only reinserted once
+        // they leave their fat AABB
+        for (CollisionObject* object : m_dynamicObjects) {
+            auto proxyIt = m_broadphaseData->proxies.find(object);
+            if (proxyIt == m_broadphaseData->proxies.end()) {
+                continue;
+            }
 
-            // Calculate bounds
-            root.bounds = m_broadphaseData->bvhNodes[0].bounds;
-            root.bounds.Expand(m_broadphaseData->bvhNodes[1].bounds);
+            float displacement[3] = { 0.0f, 0.0f, 0.0f };
+            if (object->GetOwner()) {
+                Vec3 velocity = object->GetOwner()->GetVelocity() * m_config.fixedTimeStep;
+                displacement[0] = velocity.x;
+                displacement[1] = velocity.y;
+                displacement[2] = velocity.z;
+            }
 
-            m_broadphaseData->bvhNodes.push_back(root);
-            m_broadphaseData->rootNode = static_cast<int>(m_broadphaseData->bvhNodes.size() - 1);
-        } else if (!m_broadphaseData->bvhNodes.empty()) {
-            m_broadphaseData->rootNode = 0;
+            m_broadphaseData->tree.MoveProxy(proxyIt->second,
+                                             ToTreeBounds(object->GetWorldAABB()), displacement);
         }
     }
 
     // Broadphase pair finding methods
     void CollisionSystem::FindSpatialHashPairs(std::vector<std::pair<CollisionObject*, CollisionObject*>>& pairs) {
-        std::unordered_set<uint64_t> processed;
+        const float cellSize = m_broadphaseData->cellSize;
 
         for (const auto& bucket : m_broadphaseData->spatialHash) {
             const auto& objects = bucket.second;
@@ -912,8 +911,20 @@ namespace VoxelCraft {
                     CollisionObject* a = objects[i];
                     CollisionObject* b = objects[j];
 
-                    if (CheckCollisionMask(a, b) &&
-                        a->GetWorldAABB().Intersects(b->GetWorldAABB())) {
+                    if (!CheckCollisionMask(a, b) ||
+                        !a->GetWorldAABB().Intersects(b->GetWorldAABB())) {
+                        continue;
+                    }
+
+                    // Objects spanning several cells share more than one bucket;
+                    // report the pair only from the cell holding the overlap's min corner
+                    const AABB& boundsA = a->GetWorldAABB();
+                    const AABB& boundsB = b->GetWorldAABB();
+                    const uint64_t ownerKey = GetSpatialHashKey(
+                        static_cast<int>(std::floor(std::max(boundsA.min.x, boundsB.min.x) / cellSize)),
+                        static_cast<int>(std::floor(std::max(boundsA.min.y, boundsB.min.y) / cellSize)),
+                        static_cast<int>(std::floor(std::max(boundsA.min.z, boundsB.min.z) / cellSize)));
+                    if (ownerKey == bucket.first) {
                         pairs.emplace_back(a, b);
                     }
                 }
@@ -922,14 +933,20 @@ namespace VoxelCraft {
     }
 
     void CollisionSystem::FindSweepAndPrunePairs(std::vector<std::pair<CollisionObject*, CollisionObject*>>& pairs) {
-        // Simple sweep and prune implementation
-        for (size_t i = 0; i < m_broadphaseData->sortedX.size(); ++i) {
-            for (size_t j = i + 1; j < m_broadphaseData->sortedX.size(); ++j) {
-                CollisionObject* a = m_broadphaseData->sortedX[i];
-                CollisionObject* b = m_broadphaseData->sortedX[j];
-
-                if (CheckCollisionMask(a, b) &&
-                    a->GetWorldAABB().Intersects(b->GetWorldAABB())) {
+        // Sweep along x: once an object starts past a's max.x, no later one can overlap a
+        const std::vector<CollisionObject*>& sorted = m_broadphaseData->sortedX;
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            CollisionObject* a = sorted[i];
+            const AABB& boundsA = a->GetWorldAABB();
+
+            for (size_t j = i + 1; j < sorted.size(); ++j) {
+                CollisionObject* b = sorted[j];
+                const AABB& boundsB = b->GetWorldAABB();
+                if (boundsB.min.x > boundsA.max.x) {
+                    break;
+                }
+
+                if (CheckCollisionMask(a, b) && boundsA.Intersects(boundsB)) {
                     pairs.emplace_back(a, b);
                 }
             }
@@ -937,47 +954,18 @@ namespace VoxelCraft {
     }
 
     void CollisionSystem::FindBVHPairs(std::vector<std::pair<CollisionObject*, CollisionObject*>>& pairs) {
-        if (m_broadphaseData->rootNode == -1) {
-            return;
-        }
-
-        // Simple BVH traversal (simplified implementation)
-        std::vector<int> nodesToCheck;
-        nodesToCheck.push_back(m_broadphaseData->rootNode);
-
-        while (!nodesToCheck.empty()) {
-            int nodeIndex = nodesToCheck.back();
-            nodesToCheck.pop_back();
-
-            if (nodeIndex < 0 || nodeIndex >= static_cast<int>(m_broadphaseData->bvhNodes.size())) {
-                continue;
-            }
-
-            const BroadphaseData::BVHNode& node = m_broadphaseData->bvhNodes[nodeIndex];
+        const DynamicAABBTree& tree = m_broadphaseData->tree;
 
-            if (node.isLeaf) {
-                // Check leaf against all other leaves
-                for (size_t i = 0; i < m_broadphaseData->objects.size(); ++i) {
-                    if (static_cast<int>(i) != node.objectIndex) {
-                        CollisionObject* a = m_broadphaseData->objects[node.objectIndex];
-                        CollisionObject* b = m_broadphaseData->objects[i];
+        // Fat boxes overlap first; the tight check drops the margin's false positives
+        tree.QueryAllPairs([&](int32_t proxyA, int32_t proxyB) {
+            CollisionObject* a = static_cast<CollisionObject*>(tree.GetUserData(proxyA));
+            CollisionObject* b = static_cast<CollisionObject*>(tree.GetUserData(proxyB));
 
-                        if (CheckCollisionMask(a, b) &&
-                            a->GetWorldAABB().Intersects(b->GetWorldAABB())) {
-                            pairs.emplace_back(a, b);
-                        }
-                    }
-                }
-            } else {
-                // Add children to check
-                if (node.left != -1) {
-                    nodesToCheck.push_back(node.left);
-                }
-                if (node.right != -1) {
-                    nodesToCheck.push_back(node.right);
-                }
+            if (CheckCollisionMask(a, b) &&
+                a->GetWorldAABB().Intersects(b->GetWorldAABB())) {
+                pairs.emplace_back(a, b);
             }
-        }
+        });
     }
 
     // Raycast implementations
@@ -1168,10 +1156,12 @@ namespace VoxelCraft {
     // Utility methods
     uint64_t CollisionSystem::GetSpatialHashKey(int x, int y, int z) const {
         // Simple hash function for spatial hashing
+        // 21 bits per axis; masking keeps negative cells from smearing into the other axes
+        const uint64_t mask = (1ull << 21) - 1;
         uint64_t key = 0;
-        key = static_cast<uint64_t>(x) << 42;
-        key |= static_cast<uint64_t>(y) << 21;
-        key |= static_cast<uint64_t>(z);
+        key = (static_cast<uint64_t>(x) & mask) << 42;
+        key |= (static_cast<uint64_t>(y) & mask) << 21;
+        key |= static_cast<uint64_t>(z) & mask;
         return key;
     }
 
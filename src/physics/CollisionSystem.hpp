@@ -390,6 +390,7 @@ namespace VoxelCraft {
         int maxObjectsPerNode = 16;  ///< Max objects per BVH node
         float worldSize = 10000.0f;  ///< World size for spatial hashing
         float cellSize = 10.0f;      ///< Cell size for spatial hashing
+        float proxyMargin = 0.1f;    ///< Fat AABB margin for the dynamic BVH
 
         // Physics settings
         float gravity = -9.81f;      ///< Gravity acceleration
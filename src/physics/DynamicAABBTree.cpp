@@ -0,0 +1,381 @@
+/**
+ * @file DynamicAABBTree.cpp
+ * @brief VoxelCraft incremental bounding volume tree implementation
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#include "DynamicAABBTree.hpp"
+
+#include <cmath>
+
+namespace VoxelCraft {
+
+    DynamicAABBTree::DynamicAABBTree(float margin, float predictionMultiplier)
+        : m_margin(margin)
+        , m_predictionMultiplier(predictionMultiplier) {
+    }
+
+    int32_t DynamicAABBTree::CreateProxy(const TreeBounds& bounds, void* userData) {
+        const int32_t proxyId = AllocateNode();
+
+        Node& node = NodeAt(proxyId);
+        node.bounds = bounds;
+        FattenBounds(node.bounds, nullptr);
+        node.userData = userData;
+        node.height = 0;
+
+        InsertLeaf(proxyId);
+        ++m_proxyCount;
+        return proxyId;
+    }
+
+    void DynamicAABBTree::DestroyProxy(int32_t proxyId) {
+        RemoveLeaf(proxyId);
+        FreeNode(proxyId);
+        --m_proxyCount;
+    }
+
+    bool DynamicAABBTree::MoveProxy(int32_t proxyId, const TreeBounds& bounds, const float* displacement) {
+        TreeBounds fat = bounds;
+        FattenBounds(fat, displacement);
+
+        const TreeBounds& current = NodeAt(proxyId).bounds;
+        if (current.Contains(bounds)) {
+            // Still inside; keep it unless the old box has grown far too big
+            // (e.g. a fast object that stopped), which would bloat queries
+            TreeBounds huge = fat;
+            for (int axis = 0; axis < 3; ++axis) {
+                huge.min[axis] -= 4.0f * m_margin;
+                huge.max[axis] += 4.0f * m_margin;
+            }
+            if (huge.Contains(current)) {
+                return false;
+            }
+        }
+
+        RemoveLeaf(proxyId);
+        NodeAt(proxyId).bounds = fat;
+        InsertLeaf(proxyId);
+        ++m_reinsertions;
+        return true;
+    }
+
+    void DynamicAABBTree::Clear() {
+        m_nodes.clear();
+        m_root = NULL_NODE;
+        m_freeList = NULL_NODE;
+        m_proxyCount = 0;
+    }
+
+    DynamicAABBTree::Stats DynamicAABBTree::GetStats() const {
+        Stats stats;
+        stats.proxyCount = m_proxyCount;
+        stats.reinsertions = m_reinsertions;
+        stats.rotations = m_rotations;
+        if (m_root == NULL_NODE) {
+            return stats;
+        }
+
+        stats.height = NodeAt(m_root).height;
+        float internalCost = 0.0f;
+        for (const Node& node : m_nodes) {
+            if (node.height < 0) {
+                continue;
+            }
+            ++stats.nodeCount;
+            if (!node.IsLeaf()) {
+                internalCost += node.bounds.GetCost();
+            }
+        }
+
+        const float rootCost = NodeAt(m_root).bounds.GetCost();
+        stats.areaRatio = rootCost > 0.0f ? internalCost / rootCost : 0.0f;
+        return stats;
+    }
+
+    bool DynamicAABBTree::Validate() const {
+        if (m_root == NULL_NODE) {
+            return m_proxyCount == 0;
+        }
+        if (NodeAt(m_root).parent != NULL_NODE) {
+            return false;
+        }
+
+        int32_t leaves = 0;
+        return ValidateNode(m_root, leaves) >= 0 && leaves == m_proxyCount;
+    }
+
+    int32_t DynamicAABBTree::ValidateNode(int32_t nodeId, int32_t& leaves) const {
+        const Node& node = NodeAt(nodeId);
+        if (node.IsLeaf()) {
+            ++leaves;
+            return node.height == 0 && node.child2 == NULL_NODE ? 0 : -1;
+        }
+
+        const Node& child1 = NodeAt(node.child1);
+        const Node& child2 = NodeAt(node.child2);
+        if (child1.parent != nodeId || child2.parent != nodeId ||
+            !node.bounds.Contains(child1.bounds) || !node.bounds.Contains(child2.bounds)) {
+            return -1;
+        }
+
+        const int32_t height1 = ValidateNode(node.child1, leaves);
+        const int32_t height2 = ValidateNode(node.child2, leaves);
+        if (height1 < 0 || height2 < 0 || node.height != 1 + std::max(height1, height2)) {
+            return -1;
+        }
+        return node.height;
+    }
+
+    int32_t DynamicAABBTree::AllocateNode() {
+        if (m_freeList == NULL_NODE) {
+            m_nodes.emplace_back();
+            return static_cast<int32_t>(m_nodes.size() - 1);
+        }
+
+        const int32_t nodeId = m_freeList;
+        m_freeList = NodeAt(nodeId).parent;
+        NodeAt(nodeId) = Node();
+        return nodeId;
+    }
+
+    void DynamicAABBTree::FreeNode(int32_t nodeId) {
+        Node& node = NodeAt(nodeId);
+        node.parent = m_freeList;
+        node.child1 = NULL_NODE;
+        node.child2 = NULL_NODE;
+        node.userData = nullptr;
+        node.height = -1;
+        m_freeList = nodeId;
+    }
+
+    void DynamicAABBTree::FattenBounds(TreeBounds& bounds, const float* displacement) const {
+        for (int axis = 0; axis < 3; ++axis) {
+            bounds.min[axis] -= m_margin;
+            bounds.max[axis] += m_margin;
+
+            if (displacement) {
+                const float d = m_predictionMultiplier * displacement[axis];
+                if (d < 0.0f) {
+                    bounds.min[axis] += d;
+                } else {
+                    bounds.max[axis] += d;
+                }
+            }
+        }
+    }
+
+    int32_t DynamicAABBTree::FindBestSibling(const TreeBounds& bounds) const {
+        // Branch and bound over the SAH cost of inserting next to each node:
+        // the new parent's cost plus the growth of every ancestor. Descends
+        // towards the cheaper child and stops once no deeper node can beat
+        // the best found so far.
+        const float leafCost = bounds.GetCost();
+
+        int32_t best = m_root;
+        float bestCost = TreeBounds::Union(NodeAt(m_root).bounds, bounds).GetCost();
+        float inheritedCost = 0.0f;
+        int32_t index = m_root;
+
+        while (!NodeAt(index).IsLeaf()) {
+            const Node& node = NodeAt(index);
+
+            const float directCost = TreeBounds::Union(node.bounds, bounds).GetCost();
+            const float cost = directCost + inheritedCost;
+            if (cost < bestCost) {
+                best = index;
+                bestCost = cost;
+            }
+
+            // Every node below grows its ancestors at least this much
+            inheritedCost += directCost - node.bounds.GetCost();
+
+            float lowerBound[2];
+            int32_t children[2] = { node.child1, node.child2 };
+            for (int i = 0; i < 2; ++i) {
+                const Node& child = NodeAt(children[i]);
+                const float childDirect = TreeBounds::Union(child.bounds, bounds).GetCost();
+                const float childCost = childDirect + inheritedCost;
+                if (childCost < bestCost) {
+                    best = children[i];
+                    bestCost = childCost;
+                }
+
+                // Going below the child also grows the child itself
+                lowerBound[i] = child.IsLeaf()
+                    ? bestCost
+                    : inheritedCost + (childDirect - child.bounds.GetCost()) + leafCost;
+            }
+
+            const int next = lowerBound[0] <= lowerBound[1] ? 0 : 1;
+            if (lowerBound[next] >= bestCost) {
+                break;
+            }
+            index = children[next];
+        }
+
+        return best;
+    }
+
+    void DynamicAABBTree::InsertLeaf(int32_t leaf) {
+        if (m_root == NULL_NODE) {
+            m_root = leaf;
+            NodeAt(leaf).parent = NULL_NODE;
+            return;
+        }
+
+        const TreeBounds leafBounds = NodeAt(leaf).bounds;
+        const int32_t sibling = FindBestSibling(leafBounds);
+
+        const int32_t oldParent = NodeAt(sibling).parent;
+        const int32_t newParent = AllocateNode();
+
+        Node& parent = NodeAt(newParent);
+        parent.parent = oldParent;
+        parent.bounds = TreeBounds::Union(leafBounds, NodeAt(sibling).bounds);
+        parent.height = NodeAt(sibling).height + 1;
+        parent.child1 = sibling;
+        parent.child2 = leaf;
+
+        if (oldParent != NULL_NODE) {
+            Node& grandParent = NodeAt(oldParent);
+            if (grandParent.child1 == sibling) {
+                grandParent.child1 = newParent;
+            } else {
+                grandParent.child2 = newParent;
+            }
+        } else {
+            m_root = newParent;
+        }
+
+        NodeAt(sibling).parent = newParent;
+        NodeAt(leaf).parent = newParent;
+
+        for (int32_t index = oldParent; index != NULL_NODE; index = NodeAt(index).parent) {
+            Refit(index);
+            Rotate(index);
+        }
+    }
+
+    void DynamicAABBTree::RemoveLeaf(int32_t leaf) {
+        if (leaf == m_root) {
+            m_root = NULL_NODE;
+            return;
+        }
+
+        const int32_t parent = NodeAt(leaf).parent;
+        const int32_t grandParent = NodeAt(parent).parent;
+        const int32_t sibling = NodeAt(parent).child1 == leaf ? NodeAt(parent).child2 : NodeAt(parent).child1;
+
+        if (grandParent == NULL_NODE) {
+            m_root = sibling;
+            NodeAt(sibling).parent = NULL_NODE;
+            FreeNode(parent);
+            return;
+        }
+
+        // Splice the sibling into the parent's place
+        Node& grand = NodeAt(grandParent);
+        if (grand.child1 == parent) {
+            grand.child1 = sibling;
+        } else {
+            grand.child2 = sibling;
+        }
+        NodeAt(sibling).parent = grandParent;
+        FreeNode(parent);
+
+        for (int32_t index = grandParent; index != NULL_NODE; index = NodeAt(index).parent) {
+            Refit(index);
+            Rotate(index);
+        }
+    }
+
+    void DynamicAABBTree::Refit(int32_t nodeId) {
+        Node& node = NodeAt(nodeId);
+        const Node& child1 = NodeAt(node.child1);
+        const Node& child2 = NodeAt(node.child2);
+        node.bounds = TreeBounds::Union(child1.bounds, child2.bounds);
+        node.height = 1 + std::max(child1.height, child2.height);
+    }
+
+    void DynamicAABBTree::Rotate(int32_t nodeId) {
+        /*
+         * Swap one of A's children with one of its grandchildren if that
+         * lowers the summed cost of A's children (A's own box is unchanged)
+         *
+         *        A                A
+         *      /   \            /   \
+         *     B     C   ->     F     C'      C' = union(B, G)
+         *    / \   / \        / \   / \
+         *   D   E F   G      D   E B   G
+         */
+        const int32_t b = NodeAt(nodeId).child1;
+        const int32_t c = NodeAt(nodeId).child2;
+        const Node& nodeB = NodeAt(b);
+        const Node& nodeC = NodeAt(c);
+        if (nodeB.height < 1 && nodeC.height < 1) {
+            return;
+        }
+
+        enum Swap { NONE, B_F, B_G, C_D, C_E, D_F, D_G };
+        Swap bestSwap = NONE;
+        float bestDelta = 0.0f;
+
+        const float costB = nodeB.bounds.GetCost();
+        const float costC = nodeC.bounds.GetCost();
+
+        auto consider = [&](Swap swap, float delta) {
+            if (delta < bestDelta) {
+                bestDelta = delta;
+                bestSwap = swap;
+            }
+        };
+
+        if (!nodeC.IsLeaf()) {
+            const TreeBounds& f = NodeAt(nodeC.child1).bounds;
+            const TreeBounds& g = NodeAt(nodeC.child2).bounds;
+            consider(B_F, TreeBounds::Union(nodeB.bounds, g).GetCost() - costC);
+            consider(B_G, TreeBounds::Union(nodeB.bounds, f).GetCost() - costC);
+        }
+        if (!nodeB.IsLeaf()) {
+            const TreeBounds& d = NodeAt(nodeB.child1).bounds;
+            const TreeBounds& e = NodeAt(nodeB.child2).bounds;
+            consider(C_D, TreeBounds::Union(nodeC.bounds, e).GetCost() - costB);
+            consider(C_E, TreeBounds::Union(nodeC.bounds, d).GetCost() - costB);
+
+            if (!nodeC.IsLeaf()) {
+                const TreeBounds& f = NodeAt(nodeC.child1).bounds;
+                const TreeBounds& g = NodeAt(nodeC.child2).bounds;
+                consider(D_F, TreeBounds::Union(f, e).GetCost() + TreeBounds::Union(d, g).GetCost() - costB - costC);
+                consider(D_G, TreeBounds::Union(g, e).GetCost() + TreeBounds::Union(f, d).GetCost() - costB - costC);
+            }
+        }
+
+        if (bestSwap == NONE) {
+            return;
+        }
+
+        // Exchange the subtree in slot (parentX, firstX) with (parentY, firstY)
+        auto exchange = [this](int32_t parentX, bool firstX, int32_t parentY, bool firstY) {
+            int32_t& slotX = firstX ? NodeAt(parentX).child1 : NodeAt(parentX).child2;
+            int32_t& slotY = firstY ? NodeAt(parentY).child1 : NodeAt(parentY).child2;
+            std::swap(slotX, slotY);
+            NodeAt(slotX).parent = parentX;
+            NodeAt(slotY).parent = parentY;
+        };
+
+        switch (bestSwap) {
+            case B_F: exchange(nodeId, true, c, true); Refit(c); break;
+            case B_G: exchange(nodeId, true, c, false); Refit(c); break;
+            case C_D: exchange(nodeId, false, b, true); Refit(b); break;
+            case C_E: exchange(nodeId, false, b, false); Refit(b); break;
+            case D_F: exchange(b, true, c, true); Refit(b); Refit(c); break;
+            case D_G: exchange(b, true, c, false); Refit(b); Refit(c); break;
+            default: break;
+        }
+        Refit(nodeId);
+        ++m_rotations;
+    }
+
+} // namespace VoxelCraft
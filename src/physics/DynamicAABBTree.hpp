@@ -0,0 +1,401 @@
+/**
+ * @file DynamicAABBTree.hpp
+ * @brief VoxelCraft incremental bounding volume tree for the collision broadphase
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#ifndef VOXELCRAFT_PHYSICS_DYNAMIC_AABB_TREE_HPP
+#define VOXELCRAFT_PHYSICS_DYNAMIC_AABB_TREE_HPP
+
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+namespace VoxelCraft {
+
+    /**
+     * @struct TreeBounds
+     * @brief Plain axis-aligned box stored in DynamicAABBTree nodes
+     */
+    struct TreeBounds {
+        float min[3];           ///< Minimum corner
+        float max[3];           ///< Maximum corner
+
+        /**
+         * @brief Check if two boxes overlap (touching counts)
+         */
+        bool Overlaps(const TreeBounds& other) const {
+            return min[0] <= other.max[0] && max[0] >= other.min[0] &&
+                   min[1] <= other.max[1] && max[1] >= other.min[1] &&
+                   min[2] <= other.max[2] && max[2] >= other.min[2];
+        }
+
+        /**
+         * @brief Check if this box fully contains another
+         */
+        bool Contains(const TreeBounds& other) const {
+            return min[0] <= other.min[0] && max[0] >= other.max[0] &&
+                   min[1] <= other.min[1] && max[1] >= other.max[1] &&
+                   min[2] <= other.min[2] && max[2] >= other.max[2];
+        }
+
+        /**
+         * @brief Half the surface area; the SAH cost of a node
+         */
+        float GetCost() const {
+            const float x = max[0] - min[0];
+            const float y = max[1] - min[1];
+            const float z = max[2] - min[2];
+            return x * y + y * z + z * x;
+        }
+
+        /**
+         * @brief Smallest box containing both
+         */
+        static TreeBounds Union(const TreeBounds& a, const TreeBounds& b) {
+            TreeBounds result;
+            for (int axis = 0; axis < 3; ++axis) {
+                result.min[axis] = std::min(a.min[axis], b.min[axis]);
+                result.max[axis] = std::max(a.max[axis], b.max[axis]);
+            }
+            return result;
+        }
+    };
+
+    /**
+     * @class DynamicAABBTree
+     * @brief Incrementally updated binary tree of fat bounding boxes
+     *
+     * Every proxy is a leaf holding a "fat" box: the object's box grown by a
+     * margin and stretched along its predicted displacement. MoveProxy does
+     * nothing while the object stays inside its fat box, so only proxies that
+     * actually left theirs are removed and reinserted.
+     *
+     * Insertion picks the sibling that adds the least surface area to the tree
+     * (surface area heuristic, branch and bound). On the way back to the root
+     * each ancestor tries swapping a child with a grandchild when that shrinks
+     * the tree, which keeps it balanced without a full rebuild.
+     *
+     * Queries walk the tree with a fixed-size stack and allocate nothing.
+     * Not thread-safe; queries may run concurrently with each other only.
+     */
+    class DynamicAABBTree {
+    public:
+        static constexpr int32_t NULL_NODE = -1;
+        static constexpr int STACK_CAPACITY = 256;
+
+        /**
+         * @struct Stats
+         * @brief Tree shape and maintenance counters
+         */
+        struct Stats {
+            int32_t proxyCount = 0;         ///< Leaves
+            int32_t nodeCount = 0;          ///< Leaves and internal nodes
+            int32_t height = 0;             ///< Root height (leaf = 0)
+            float areaRatio = 0.0f;         ///< Sum of internal node costs over root cost
+            uint64_t reinsertions = 0;      ///< Moves that left the fat box
+            uint64_t rotations = 0;         ///< Child/grandchild swaps applied
+        };
+
+        /**
+         * @brief Constructor
+         * @param margin Added to every side of a proxy's box
+         * @param predictionMultiplier Fat boxes extend by this times the displacement
+         */
+        explicit DynamicAABBTree(float margin = 0.1f, float predictionMultiplier = 2.0f);
+
+        /**
+         * @brief Add a proxy
+         * @return Proxy ID, stable until DestroyProxy
+         */
+        int32_t CreateProxy(const TreeBounds& bounds, void* userData);
+
+        /**
+         * @brief Remove a proxy
+         */
+        void DestroyProxy(int32_t proxyId);
+
+        /**
+         * @brief Update a proxy's box
+         * @param displacement Expected movement until the next update (may be null)
+         * @return true if the proxy left its fat box and was reinserted
+         */
+        bool MoveProxy(int32_t proxyId, const TreeBounds& bounds, const float* displacement);
+
+        /**
+         * @brief Get the user data passed to CreateProxy
+         */
+        void* GetUserData(int32_t proxyId) const { return NodeAt(proxyId).userData; }
+
+        /**
+         * @brief Get a proxy's fat box
+         */
+        const TreeBounds& GetFatBounds(int32_t proxyId) const { return NodeAt(proxyId).bounds; }
+
+        /**
+         * @brief Visit proxies whose fat box overlaps bounds
+         * @param callback bool(int32_t proxyId), return false to stop
+         */
+        template<typename Callback>
+        void Query(const TreeBounds& bounds, Callback&& callback) const;
+
+        /**
+         * @brief Visit every pair of proxies whose fat boxes overlap, once
+         * @param callback void(int32_t proxyA, int32_t proxyB) with proxyA < proxyB
+         */
+        template<typename Callback>
+        void QueryAllPairs(Callback&& callback) const;
+
+        /**
+         * @brief Visit proxies whose fat box the segment from start to end crosses
+         * @param extension Half extents added to every box, for swept boxes (may be null)
+         * @param callback float(int32_t proxyId, float maxFraction) returning the new
+         *        max fraction along the segment: unchanged to ignore the proxy, lower
+         *        to clip the rest of the cast, 0 to stop
+         */
+        template<typename Callback>
+        void RayCast(const float start[3], const float end[3], const float* extension, Callback&& callback) const;
+
+        /**
+         * @brief Remove every proxy
+         */
+        void Clear();
+
+        /**
+         * @brief Get tree statistics
+         */
+        Stats GetStats() const;
+
+        /**
+         * @brief Check structure, heights and bounds; for tests and debugging
+         */
+        bool Validate() const;
+
+    private:
+        struct Node {
+            TreeBounds bounds;
+            void* userData = nullptr;
+            int32_t parent = NULL_NODE;     ///< Next free node while on the free list
+            int32_t child1 = NULL_NODE;
+            int32_t child2 = NULL_NODE;
+            int32_t height = -1;            ///< 0 for leaves, -1 while free
+
+            bool IsLeaf() const { return child1 == NULL_NODE; }
+        };
+
+        // Node IDs stay int32_t so NULL_NODE can be -1; index only valid ones
+        Node& NodeAt(int32_t nodeId) { return m_nodes[static_cast<size_t>(nodeId)]; }
+        const Node& NodeAt(int32_t nodeId) const { return m_nodes[static_cast<size_t>(nodeId)]; }
+
+        int32_t AllocateNode();
+        void FreeNode(int32_t nodeId);
+
+        void InsertLeaf(int32_t leaf);
+        void RemoveLeaf(int32_t leaf);
+        int32_t FindBestSibling(const TreeBounds& bounds) const;
+        void Refit(int32_t nodeId);
+        void Rotate(int32_t nodeId);
+        void FattenBounds(TreeBounds& bounds, const float* displacement) const;
+
+        int32_t ValidateNode(int32_t nodeId, int32_t& leaves) const;
+
+        std::vector<Node> m_nodes;
+        int32_t m_root = NULL_NODE;
+        int32_t m_freeList = NULL_NODE;
+        int32_t m_proxyCount = 0;
+
+        float m_margin;
+        float m_predictionMultiplier;
+
+        uint64_t m_reinsertions = 0;
+        uint64_t m_rotations = 0;
+    };
+
+    template<typename Callback>
+    void DynamicAABBTree::Query(const TreeBounds& bounds, Callback&& callback) const {
+        if (m_root == NULL_NODE) {
+            return;
+        }
+
+        // Spills to the heap only if the tree is far deeper than rotations allow
+        int32_t stack[STACK_CAPACITY];
+        std::vector<int32_t> overflow;
+        int count = 0;
+        stack[count++] = m_root;
+
+        while (count > 0 || !overflow.empty()) {
+            int32_t nodeId;
+            if (!overflow.empty()) {
+                nodeId = overflow.back();
+                overflow.pop_back();
+            } else {
+                nodeId = stack[--count];
+            }
+
+            const Node& node = NodeAt(nodeId);
+            if (!node.bounds.Overlaps(bounds)) {
+                continue;
+            }
+
+            if (node.IsLeaf()) {
+                if (!callback(nodeId)) {
+                    return;
+                }
+                continue;
+            }
+
+            for (int32_t child : { node.child1, node.child2 }) {
+                if (count < STACK_CAPACITY) {
+                    stack[count++] = child;
+                } else {
+                    overflow.push_back(child);
+                }
+            }
+        }
+    }
+
+    template<typename Callback>
+    void DynamicAABBTree::RayCast(const float start[3], const float end[3], const float* extension,
+                                  Callback&& callback) const {
+        if (m_root == NULL_NODE) {
+            return;
+        }
+
+        float delta[3];
+        float inverse[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            delta[axis] = end[axis] - start[axis];
+            inverse[axis] = delta[axis] != 0.0f ? 1.0f / delta[axis] : 0.0f;
+        }
+
+        // Slab test against the segment clipped to maxFraction
+        auto hitsSegment = [&](const TreeBounds& bounds, float maxFraction) {
+            float tMin = 0.0f;
+            float tMax = maxFraction;
+            for (int axis = 0; axis < 3; ++axis) {
+                const float grow = extension ? extension[axis] : 0.0f;
+                const float lo = bounds.min[axis] - grow;
+                const float hi = bounds.max[axis] + grow;
+                if (delta[axis] == 0.0f) {
+                    if (start[axis] < lo || start[axis] > hi) {
+                        return false;
+                    }
+                    continue;
+                }
+
+                float t0 = (lo - start[axis]) * inverse[axis];
+                float t1 = (hi - start[axis]) * inverse[axis];
+                if (t0 > t1) {
+                    std::swap(t0, t1);
+                }
+                tMin = std::max(tMin, t0);
+                tMax = std::min(tMax, t1);
+                if (tMin > tMax) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        float maxFraction = 1.0f;
+        int32_t stack[STACK_CAPACITY];
+        std::vector<int32_t> overflow;
+        int count = 0;
+        stack[count++] = m_root;
+
+        while (count > 0 || !overflow.empty()) {
+            int32_t nodeId;
+            if (!overflow.empty()) {
+                nodeId = overflow.back();
+                overflow.pop_back();
+            } else {
+                nodeId = stack[--count];
+            }
+
+            const Node& node = NodeAt(nodeId);
+            if (!hitsSegment(node.bounds, maxFraction)) {
+                continue;
+            }
+
+            if (node.IsLeaf()) {
+                maxFraction = std::min(maxFraction, static_cast<float>(callback(nodeId, maxFraction)));
+                if (maxFraction <= 0.0f) {
+                    return;
+                }
+                continue;
+            }
+
+            for (int32_t child : { node.child1, node.child2 }) {
+                if (count < STACK_CAPACITY) {
+                    stack[count++] = child;
+                } else {
+                    overflow.push_back(child);
+                }
+            }
+        }
+    }
+
+    template<typename Callback>
+    void DynamicAABBTree::QueryAllPairs(Callback&& callback) const {
+        if (m_root == NULL_NODE) {
+            return;
+        }
+
+        // Descends the tree against itself: a node paired with itself splits
+        // into its children's self pairs and their cross pair, so every leaf
+        // pair is reached once and disjoint subtrees are pruned together
+        struct NodePair { int32_t a, b; };
+        NodePair stack[STACK_CAPACITY];
+        std::vector<NodePair> overflow;
+        int count = 0;
+        stack[count++] = { m_root, m_root };
+
+        auto push = [&](int32_t a, int32_t b) {
+            if (count < STACK_CAPACITY) {
+                stack[count++] = { a, b };
+            } else {
+                overflow.push_back({ a, b });
+            }
+        };
+
+        while (count > 0 || !overflow.empty()) {
+            NodePair pair;
+            if (!overflow.empty()) {
+                pair = overflow.back();
+                overflow.pop_back();
+            } else {
+                pair = stack[--count];
+            }
+
+            const Node& nodeA = NodeAt(pair.a);
+            if (pair.a == pair.b) {
+                if (!nodeA.IsLeaf()) {
+                    push(nodeA.child1, nodeA.child1);
+                    push(nodeA.child2, nodeA.child2);
+                    push(nodeA.child1, nodeA.child2);
+                }
+                continue;
+            }
+
+            const Node& nodeB = NodeAt(pair.b);
+            if (!nodeA.bounds.Overlaps(nodeB.bounds)) {
+                continue;
+            }
+
+            if (nodeA.IsLeaf() && nodeB.IsLeaf()) {
+                callback(std::min(pair.a, pair.b), std::max(pair.a, pair.b));
+            } else if (nodeB.IsLeaf() || (!nodeA.IsLeaf() && nodeA.height >= nodeB.height)) {
+                // Split the taller side to keep the two boxes comparable in size
+                push(nodeA.child1, pair.b);
+                push(nodeA.child2, pair.b);
+            } else {
+                push(pair.a, nodeB.child1);
+                push(pair.a, nodeB.child2);
+            }
+        }
+    }
+
+} // namespace VoxelCraft
+
+#endif // VOXELCRAFT_PHYSICS_DYNAMIC_AABB_TREE_HPP
@@ -388,6 +388,36 @@ namespace VoxelCraft {
 		return m_collisionManager->BoxCast(from, to, halfExtents, hit, layerMask);
 	}
 
+	int PhysicsEngine::RayCastBatch(const std::vector<RayCastQuery>& queries, std::vector<RayCastHit>& hits)
+	{
+		if (!m_initialized || !m_collisionManager) {
+			hits.assign(queries.size(), RayCastHit());
+			return 0;
+		}
+
+		return m_collisionManager->RayCastBatch(queries, hits);
+	}
+
+	void PhysicsEngine::MoveAABBBatch(const std::vector<BoxMoveQuery>& queries, std::vector<glm::vec3>& moved)
+	{
+		if (!m_initialized || !m_collisionManager) {
+			moved.resize(queries.size());
+			for (size_t i = 0; i < queries.size(); ++i) {
+				moved[i] = queries[i].displacement;
+			}
+			return;
+		}
+
+		m_collisionManager->MoveAABBBatch(queries, moved);
+	}
+
+	void PhysicsEngine::SetChunkProvider(VoxelGridQuery::ChunkProvider chunkProvider)
+	{
+		if (m_collisionManager) {
+			m_collisionManager->SetChunkProvider(std::move(chunkProvider));
+		}
+	}
+
 	bool PhysicsEngine::OverlapSphere(const glm::vec3& center, float radius, std::vector<OverlapResult>& results, uint32_t layerMask)
 	{
 		if (!m_initialized || !m_collisionManager) {
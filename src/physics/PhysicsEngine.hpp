@@ -7,6 +7,7 @@
 #include <mutex>
 #include <cstdint>
 #include "core/Logger.hpp"
+#include "VoxelGridQuery.hpp"
 
 namespace VoxelCraft {
 
@@ -252,6 +253,22 @@ namespace VoxelCraft {
 		 */
 		bool BoxCast(const glm::vec3& from, const glm::vec3& to, const glm::vec3& halfExtents, RayCastHit& hit, uint32_t layerMask = 0xFFFFFFFF);
 
+		/**
+		 * @brief Cast many rays at once (AI line of sight, projectiles)
+		 * @return Number of rays that hit
+		 */
+		int RayCastBatch(const std::vector<RayCastQuery>& queries, std::vector<RayCastHit>& hits);
+
+		/**
+		 * @brief Move many entity boxes against terrain at once
+		 */
+		void MoveAABBBatch(const std::vector<BoxMoveQuery>& queries, std::vector<glm::vec3>& moved);
+
+		/**
+		 * @brief Set the chunk lookup used by terrain queries (ChunkSystem::GetChunk in game)
+		 */
+		void SetChunkProvider(VoxelGridQuery::ChunkProvider chunkProvider);
+
 		/**
 		 * @brief Overlap sphere
 		 */
@@ -0,0 +1,244 @@
+#include "VoxelGridQuery.hpp"
+#include "world/Chunk.hpp"
+#include "blocks/BlockPropertyTable.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace VoxelCraft {
+
+	namespace {
+
+		// Faces closer than this to a block boundary count as touching it
+		constexpr float FACE_EPSILON = 1e-4f;
+
+		constexpr int32_t COLUMN_HEIGHT = static_cast<int32_t>(ChunkBlockStorage::COLUMN_HEIGHT);
+
+		int FloorToInt(float value)
+		{
+			return static_cast<int>(std::floor(value));
+		}
+
+		int MinAxis(const glm::vec3& values)
+		{
+			if (values.x <= values.y && values.x <= values.z) {
+				return 0;
+			}
+			return values.y <= values.z ? 1 : 2;
+		}
+
+	} // namespace
+
+	VoxelGridQuery::VoxelGridQuery(const ChunkProvider& chunkProvider, bool unloadedIsSolid)
+		: m_chunkProvider(chunkProvider)
+		, m_unloadedIsSolid(unloadedIsSolid)
+		, m_chunkX(0)
+		, m_chunkZ(0)
+		, m_chunkValid(false)
+		, m_chunkLookups(0)
+	{
+	}
+
+	const Chunk* VoxelGridQuery::GetChunk(int32_t chunkX, int32_t chunkZ)
+	{
+		if (!m_chunkValid || chunkX != m_chunkX || chunkZ != m_chunkZ) {
+			m_chunk = m_chunkProvider ? m_chunkProvider(ChunkCoord(chunkX, chunkZ)) : nullptr;
+			m_chunkX = chunkX;
+			m_chunkZ = chunkZ;
+			m_chunkValid = true;
+			++m_chunkLookups;
+		}
+		return m_chunk.get();
+	}
+
+	uint16_t VoxelGridQuery::GetBlockId(int32_t x, int32_t y, int32_t z)
+	{
+		if (y < 0 || y >= COLUMN_HEIGHT) {
+			return 0;
+		}
+
+		const Chunk* chunk = GetChunk(x >> 4, z >> 4);
+		if (!chunk) {
+			return 0;
+		}
+		return chunk->GetBlockStorage().Get(static_cast<uint8_t>(x & 15), static_cast<uint8_t>(y),
+			static_cast<uint8_t>(z & 15));
+	}
+
+	bool VoxelGridQuery::IsSolid(int32_t x, int32_t y, int32_t z)
+	{
+		if (y < 0 || y >= COLUMN_HEIGHT) {
+			return false;
+		}
+
+		const Chunk* chunk = GetChunk(x >> 4, z >> 4);
+		if (!chunk) {
+			return m_unloadedIsSolid;
+		}
+		return BlockPropertyTable::IsSolid(chunk->GetBlockStorage().Get(static_cast<uint8_t>(x & 15),
+			static_cast<uint8_t>(y), static_cast<uint8_t>(z & 15)));
+	}
+
+	bool VoxelGridQuery::RayCast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, VoxelRayHit& hit)
+	{
+		const float infinity = std::numeric_limits<float>::infinity();
+
+		glm::ivec3 cell(FloorToInt(origin.x), FloorToInt(origin.y), FloorToInt(origin.z));
+		glm::ivec3 step(0);
+		glm::vec3 tDelta(infinity);
+		glm::vec3 tNext(infinity);
+
+		// Distance along the ray to the next boundary on each axis
+		for (int axis = 0; axis < 3; ++axis) {
+			if (direction[axis] > 0.0f) {
+				step[axis] = 1;
+				tDelta[axis] = 1.0f / direction[axis];
+				tNext[axis] = (static_cast<float>(cell[axis] + 1) - origin[axis]) * tDelta[axis];
+			} else if (direction[axis] < 0.0f) {
+				step[axis] = -1;
+				tDelta[axis] = -1.0f / direction[axis];
+				tNext[axis] = (origin[axis] - static_cast<float>(cell[axis])) * tDelta[axis];
+			}
+		}
+
+		glm::ivec3 normal(0);
+		float distance = 0.0f;
+
+		while (true) {
+			if (IsSolid(cell.x, cell.y, cell.z)) {
+				hit.block = cell;
+				hit.normal = normal;
+				hit.point = origin + direction * distance;
+				hit.distance = distance;
+				hit.blockId = GetBlockId(cell.x, cell.y, cell.z);
+				return true;
+			}
+
+			const int axis = MinAxis(tNext);
+			distance = tNext[axis];
+			if (distance > maxDistance) {
+				return false;
+			}
+
+			cell[axis] += step[axis];
+			tNext[axis] += tDelta[axis];
+			normal = glm::ivec3(0);
+			normal[axis] = -step[axis];
+
+			// Nothing above or below the column can stop the ray
+			if ((cell.y < 0 && step.y <= 0) || (cell.y >= COLUMN_HEIGHT && step.y >= 0)) {
+				return false;
+			}
+		}
+	}
+
+	bool VoxelGridQuery::SweepAABB(const glm::vec3& min, const glm::vec3& max, const glm::vec3& displacement, VoxelSweepHit& hit)
+	{
+		const float infinity = std::numeric_limits<float>::infinity();
+
+		glm::ivec3 step(0);
+		glm::ivec3 leadCell(0);
+		glm::vec3 tDelta(infinity);
+		glm::vec3 tNext(infinity);
+
+		// Leading face per axis, in displacement fractions (0-1)
+		for (int axis = 0; axis < 3; ++axis) {
+			if (displacement[axis] > 0.0f) {
+				step[axis] = 1;
+				leadCell[axis] = FloorToInt(max[axis] - FACE_EPSILON);
+				tDelta[axis] = 1.0f / displacement[axis];
+				tNext[axis] = std::max(0.0f, static_cast<float>(leadCell[axis] + 1) - max[axis]) * tDelta[axis];
+			} else if (displacement[axis] < 0.0f) {
+				step[axis] = -1;
+				leadCell[axis] = FloorToInt(min[axis] + FACE_EPSILON);
+				tDelta[axis] = -1.0f / displacement[axis];
+				tNext[axis] = std::max(0.0f, min[axis] - static_cast<float>(leadCell[axis])) * tDelta[axis];
+			}
+		}
+
+		while (true) {
+			const int axis = MinAxis(tNext);
+			const float t = tNext[axis];
+			if (t > 1.0f) {
+				return false;
+			}
+
+			// The box enters one new layer of blocks on this axis; test the
+			// part of that layer under the box at time t
+			leadCell[axis] += step[axis];
+			tNext[axis] += tDelta[axis];
+
+			const glm::vec3 boxMin = min + displacement * t;
+			const glm::vec3 boxMax = max + displacement * t;
+
+			glm::ivec3 lo;
+			glm::ivec3 hi;
+			for (int i = 0; i < 3; ++i) {
+				lo[i] = FloorToInt(boxMin[i] + FACE_EPSILON);
+				hi[i] = FloorToInt(boxMax[i] - FACE_EPSILON);
+			}
+			lo[axis] = leadCell[axis];
+			hi[axis] = leadCell[axis];
+
+			if (lo.y >= COLUMN_HEIGHT || hi.y < 0) {
+				// Outside the column; done unless the box is heading back into it
+				const bool above = lo.y >= COLUMN_HEIGHT;
+				if (above ? step.y >= 0 : step.y <= 0) {
+					return false;
+				}
+				continue;
+			}
+
+			for (int32_t x = lo.x; x <= hi.x; ++x) {
+				for (int32_t y = std::max(lo.y, 0); y <= std::min(hi.y, COLUMN_HEIGHT - 1); ++y) {
+					for (int32_t z = lo.z; z <= hi.z; ++z) {
+						if (IsSolid(x, y, z)) {
+							hit.block = glm::ivec3(x, y, z);
+							hit.normal = glm::ivec3(0);
+							hit.normal[axis] = -step[axis];
+							hit.fraction = t;
+							hit.blockId = GetBlockId(x, y, z);
+							return true;
+						}
+					}
+				}
+			}
+		}
+	}
+
+	glm::vec3 VoxelGridQuery::MoveAABB(const glm::vec3& min, const glm::vec3& max, const glm::vec3& displacement)
+	{
+		glm::vec3 moved(0.0f);
+		glm::vec3 remaining = displacement;
+		glm::vec3 boxMin = min;
+		glm::vec3 boxMax = max;
+
+		// Each contact removes one axis from the motion, so three sweeps suffice
+		for (int iteration = 0; iteration < 3; ++iteration) {
+			if (remaining.x == 0.0f && remaining.y == 0.0f && remaining.z == 0.0f) {
+				break;
+			}
+
+			VoxelSweepHit hit;
+			if (!SweepAABB(boxMin, boxMax, remaining, hit)) {
+				moved += remaining;
+				break;
+			}
+
+			const glm::vec3 travelled = remaining * hit.fraction;
+			moved += travelled;
+			boxMin += travelled;
+			boxMax += travelled;
+
+			remaining -= travelled;
+			for (int axis = 0; axis < 3; ++axis) {
+				if (hit.normal[axis] != 0) {
+					remaining[axis] = 0.0f;
+				}
+			}
+		}
+
+		return moved;
+	}
+
+} // namespace VoxelCraft
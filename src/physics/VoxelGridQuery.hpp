@@ -0,0 +1,126 @@
+#pragma once
+#include <memory>
+#include <functional>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include "world/ChunkSystem.hpp"
+
+namespace VoxelCraft {
+
+	class Chunk;
+
+	/**
+	 * @brief Terrain ray cast result
+	 */
+	struct VoxelRayHit
+	{
+		glm::ivec3 block;           // Solid block that was hit
+		glm::ivec3 normal;          // Face entered, pointing back at the ray
+		glm::vec3 point;
+		float distance;
+		uint16_t blockId;
+
+		VoxelRayHit()
+			: block(0)
+			, normal(0)
+			, point(0.0f)
+			, distance(0.0f)
+			, blockId(0)
+		{}
+	};
+
+	/**
+	 * @brief Swept box result
+	 */
+	struct VoxelSweepHit
+	{
+		glm::ivec3 block;           // First solid block touched
+		glm::ivec3 normal;          // Face touched, opposing the motion
+		float fraction;             // Part of the displacement travelled before contact (0-1)
+		uint16_t blockId;
+
+		VoxelSweepHit()
+			: block(0)
+			, normal(0)
+			, fraction(1.0f)
+			, blockId(0)
+		{}
+	};
+
+	/**
+	 * @brief Ray and box queries straight against chunk block data
+	 *
+	 * Rays march voxel by voxel (Amanatides-Woo DDA), touching only the
+	 * blocks on the ray. Boxes march the same way along their leading faces:
+	 * each step enters one new layer of blocks on one axis, and only that
+	 * layer under the box is tested, so a sweep never scans the whole volume
+	 * it passes through.
+	 *
+	 * Blocks are read lock-free through Chunk::GetBlockStorage and classified
+	 * with BlockPropertyTable; the last chunk is kept, so the chunk provider
+	 * is called once per chunk crossed. A query object is meant to be used by
+	 * one thread for a batch of queries and then dropped.
+	 */
+	class VoxelGridQuery
+	{
+	public:
+		using ChunkProvider = std::function<std::shared_ptr<Chunk>(const ChunkCoord&)>;
+
+		/**
+		 * @brief Constructor
+		 * @param chunkProvider Chunk lookup (ChunkSystem::GetChunk in game)
+		 * @param unloadedIsSolid Treat missing chunks as solid; movement uses this
+		 *        so entities cannot fall into terrain that has not loaded yet
+		 */
+		VoxelGridQuery(const ChunkProvider& chunkProvider, bool unloadedIsSolid);
+
+		/**
+		 * @brief Get block ID at world coordinates; air outside the column
+		 */
+		uint16_t GetBlockId(int32_t x, int32_t y, int32_t z);
+
+		/**
+		 * @brief Check if the block at world coordinates blocks movement
+		 */
+		bool IsSolid(int32_t x, int32_t y, int32_t z);
+
+		/**
+		 * @brief Cast a ray against solid blocks
+		 * @param direction Normalized direction
+		 */
+		bool RayCast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, VoxelRayHit& hit);
+
+		/**
+		 * @brief Sweep a box against solid blocks
+		 *
+		 * Blocks the box already overlaps at the start are ignored, so a box
+		 * pushed into terrain can still move out of it.
+		 */
+		bool SweepAABB(const glm::vec3& min, const glm::vec3& max, const glm::vec3& displacement, VoxelSweepHit& hit);
+
+		/**
+		 * @brief Move a box as far as terrain allows, sliding along what it hits
+		 * @return Displacement actually applied
+		 */
+		glm::vec3 MoveAABB(const glm::vec3& min, const glm::vec3& max, const glm::vec3& displacement);
+
+		/**
+		 * @brief Number of chunk lookups made so far
+		 */
+		uint32_t GetChunkLookups() const { return m_chunkLookups; }
+
+	private:
+		const Chunk* GetChunk(int32_t chunkX, int32_t chunkZ);
+
+		const ChunkProvider& m_chunkProvider;
+		bool m_unloadedIsSolid;
+
+		// Last chunk used; rays and boxes stay in one chunk for many steps
+		std::shared_ptr<Chunk> m_chunk;
+		int32_t m_chunkX;
+		int32_t m_chunkZ;
+		bool m_chunkValid;
+		uint32_t m_chunkLookups;
+	};
+
+} // namespace VoxelCraft
@@ -41,6 +41,16 @@ void RedstoneComponent::SetPowerLevel(int power) {
     }
 }
 
+void RedstoneComponent::ApplySimulatedPower(int power) {
+    power = std::max(0, std::min(15, power));
+
+    if (power != m_powerLevel) {
+        m_powerLevel = power;
+        m_lastUpdateTime = std::chrono::steady_clock::now();
+        UpdatePowerState();
+    }
+}
+
 std::vector<glm::ivec3> RedstoneComponent::GetConnectedComponents() const {
     std::vector<glm::ivec3> connections;
 
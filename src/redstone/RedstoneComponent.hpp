@@ -162,6 +162,16 @@ namespace VoxelCraft {
          */
         virtual void SetPowerLevel(int power);
 
+        /**
+         * @brief Take a power level computed by RedstoneGraph
+         * @param power Output level (0-15)
+         *
+         * Unlike SetPowerLevel this skips the component's own logic (torch
+         * inversion, repeater delay) and neighbour notification; the graph
+         * has already done both.
+         */
+        void ApplySimulatedPower(int power);
+
         /**
          * @brief Get component state
          * @return Redstone state
@@ -223,7 +233,7 @@ namespace VoxelCraft {
          * @brief Get component facing direction
          * @return Facing direction
          */
-        virtual glm::ivec3 GetFacingDirection() const { return glm::ivec3(0, 0, 1); }
+        virtual glm::ivec3 GetFacingDirection() const { return m_facingDirection; }
 
         /**
          * @brief Set component facing direction
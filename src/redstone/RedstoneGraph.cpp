@@ -0,0 +1,654 @@
+/**
+ * @file RedstoneGraph.cpp
+ * @brief VoxelCraft Redstone System - Compiled Redstone Graph Implementation
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#include "RedstoneGraph.hpp"
+#include <algorithm>
+
+namespace VoxelCraft {
+
+namespace {
+
+const glm::ivec3 kDirections[6] = {
+    glm::ivec3(1, 0, 0), glm::ivec3(-1, 0, 0),
+    glm::ivec3(0, 0, 1), glm::ivec3(0, 0, -1),
+    glm::ivec3(0, 1, 0), glm::ivec3(0, -1, 0)
+};
+
+constexpr uint64_t kRetireNever = ~0ull;
+
+int GateDelay(RedstoneNodeKind kind, uint8_t delay) {
+    return kind == RedstoneNodeKind::REPEATER ? delay : 1;
+}
+
+} // namespace
+
+RedstoneGraph::RedstoneGraph()
+    : m_tick(0)
+    , m_stamp(0)
+{
+}
+
+uint64_t RedstoneGraph::PositionKey(const glm::ivec3& position) {
+    // 26 bits for X and Z, 12 for Y
+    const uint64_t x = static_cast<uint64_t>(position.x + (1 << 25)) & 0x3FFFFFFull;
+    const uint64_t z = static_cast<uint64_t>(position.z + (1 << 25)) & 0x3FFFFFFull;
+    const uint64_t y = static_cast<uint64_t>(position.y + (1 << 11)) & 0xFFFull;
+    return (x << 38) | (z << 12) | y;
+}
+
+int32_t RedstoneGraph::FindNode(const glm::ivec3& position) const {
+    auto it = m_nodeAt.find(PositionKey(position));
+    return it != m_nodeAt.end() ? it->second : INVALID;
+}
+
+bool RedstoneGraph::HasComponent(const glm::ivec3& position) const {
+    return FindNode(position) != INVALID;
+}
+
+int RedstoneGraph::GetPowerLevel(const glm::ivec3& position) const {
+    const int32_t id = FindNode(position);
+    return id != INVALID ? NodeAt(id).output : 0;
+}
+
+void RedstoneGraph::SetComponent(const glm::ivec3& position, const RedstoneNodeDesc& desc) {
+    int32_t id = FindNode(position);
+    if (id == INVALID) {
+        if (!m_freeNodes.empty()) {
+            id = m_freeNodes.back();
+            m_freeNodes.pop_back();
+        } else {
+            id = static_cast<int32_t>(m_nodes.size());
+            m_nodes.emplace_back();
+        }
+
+        Node& node = NodeAt(id);
+        node.position = position;
+        node.output = 0;
+        node.alive = true;
+        node.scheduled = false;
+        node.inputCount = 0;
+        node.dependentCount = 0;
+        node.sideMask = 0;
+        node.network = INVALID;
+        node.networkSlot = INVALID;
+        node.changedTick = kRetireNever;
+        m_nodeAt[PositionKey(position)] = id;
+    }
+
+    Node& node = NodeAt(id);
+    node.kind = desc.kind;
+    node.facing = desc.facing;
+    node.delay = static_cast<uint8_t>(std::clamp<int>(desc.delay, 1, 4));
+    node.sourcePower = static_cast<uint8_t>(std::clamp<int>(desc.power, 0, MAX_POWER));
+    node.subtract = desc.subtract;
+
+    m_dirtyPositions.push_back(position);
+}
+
+bool RedstoneGraph::RemoveComponent(const glm::ivec3& position) {
+    auto it = m_nodeAt.find(PositionKey(position));
+    if (it == m_nodeAt.end()) {
+        return false;
+    }
+
+    const int32_t id = it->second;
+    m_nodeAt.erase(it);
+
+    Node& node = NodeAt(id);
+    node.alive = false;
+    node.output = 0;
+    node.inputCount = 0;
+    node.dependentCount = 0;
+    if (node.network != INVALID) {
+        m_dirtyNetworks.push_back(node.network);
+    }
+
+    // The ID may still sit on the wheel; reuse it once that has come round
+    m_retiredNodes.emplace_back(m_tick + WHEEL_SIZE, id);
+    m_dirtyPositions.push_back(position);
+    return true;
+}
+
+void RedstoneGraph::SetSourcePower(const glm::ivec3& position, int power) {
+    const int32_t id = FindNode(position);
+    if (id == INVALID || NodeAt(id).kind != RedstoneNodeKind::SOURCE) {
+        return;
+    }
+
+    NodeAt(id).sourcePower = static_cast<uint8_t>(std::clamp(power, 0, MAX_POWER));
+    m_dirtySources.push_back(id);
+}
+
+void RedstoneGraph::Clear() {
+    m_nodes.clear();
+    m_freeNodes.clear();
+    m_retiredNodes.clear();
+    m_nodeAt.clear();
+    m_networks.clear();
+    m_freeNetworks.clear();
+    for (auto& bucket : m_wheel) {
+        bucket.clear();
+    }
+    m_dirtyPositions.clear();
+    m_dirtyNetworks.clear();
+    m_dirtySources.clear();
+    m_evaluateQueue.clear();
+    m_changedPositions.clear();
+    m_visitStamp.clear();
+    m_tick = 0;
+    m_stats = RedstoneGraphStats();
+}
+
+void RedstoneGraph::Tick() {
+    m_changedPositions.clear();
+    m_tick++;
+    m_stats.ticks++;
+
+    // Block changes and lever flips count as inputs changing this tick
+    Recompile();
+
+    for (int32_t id : m_dirtySources) {
+        const Node& node = NodeAt(id);
+        if (node.alive && node.kind == RedstoneNodeKind::SOURCE && node.output != node.sourcePower) {
+            SetOutput(id, node.sourcePower);
+        }
+    }
+    m_dirtySources.clear();
+    Drain();
+
+    // Gates whose delay ends now
+    m_firing.clear();
+    std::swap(m_firing, m_wheel[m_tick & (WHEEL_SIZE - 1)]);
+    for (int32_t id : m_firing) {
+        Node& node = NodeAt(id);
+        node.scheduled = false;
+        if (!node.alive) {
+            continue;
+        }
+
+        m_stats.firedEvents++;
+        const int power = EvaluateGate(node);
+        if (power != node.output) {
+            SetOutput(id, power);
+        }
+    }
+    Drain();
+
+    // IDs removed a full wheel turn ago can be handed out again
+    size_t kept = 0;
+    for (const auto& retired : m_retiredNodes) {
+        if (retired.first <= m_tick) {
+            m_freeNodes.push_back(retired.second);
+        } else {
+            m_retiredNodes[kept++] = retired;
+        }
+    }
+    m_retiredNodes.resize(kept);
+}
+
+void RedstoneGraph::Recompile() {
+    if (m_dirtyPositions.empty() && m_dirtyNetworks.empty()) {
+        return;
+    }
+    m_stats.recompiles++;
+
+    m_visitStamp.resize(m_nodes.size(), 0);
+    const uint32_t stamp = ++m_stamp;
+
+    // Nodes at and next to each change get new inputs
+    std::vector<int32_t> relink;
+    for (const glm::ivec3& position : m_dirtyPositions) {
+        for (int d = -1; d < 6; ++d) {
+            const int32_t id = FindNode(d < 0 ? position : position + kDirections[d]);
+            if (id != INVALID && m_visitStamp[Index(id)] != stamp) {
+                m_visitStamp[Index(id)] = stamp;
+                relink.push_back(id);
+            }
+        }
+    }
+    m_dirtyPositions.clear();
+
+    // Wire networks touching a change are rebuilt from their dust
+    std::vector<int32_t> seeds;
+    auto dissolve = [this, &seeds](int32_t networkId) {
+        if (networkId == INVALID || !NetworkAt(networkId).alive) {
+            return;
+        }
+        for (int32_t dust : NetworkAt(networkId).dust) {
+            if (NodeAt(dust).network == networkId) {
+                NodeAt(dust).network = INVALID;
+                if (NodeAt(dust).alive) {
+                    seeds.push_back(dust);
+                }
+            }
+        }
+        FreeNetwork(networkId);
+    };
+
+    for (int32_t networkId : m_dirtyNetworks) {
+        dissolve(networkId);
+    }
+    m_dirtyNetworks.clear();
+
+    for (int32_t id : relink) {
+        dissolve(NodeAt(id).network);
+        if (NodeAt(id).kind == RedstoneNodeKind::WIRE) {
+            seeds.push_back(id);
+        }
+    }
+
+    for (int32_t id : relink) {
+        RelinkInputs(id);
+    }
+
+    // Dependents are the reverse of inputs, so the neighbours of every
+    // relinked node need theirs rebuilt as well
+    const uint32_t dependentStamp = ++m_stamp;
+    for (int32_t id : relink) {
+        for (int d = -1; d < 6; ++d) {
+            const int32_t other = d < 0 ? id : FindNode(NodeAt(id).position + kDirections[d]);
+            if (other != INVALID && m_visitStamp[Index(other)] != dependentStamp) {
+                m_visitStamp[Index(other)] = dependentStamp;
+                RebuildDependents(other);
+            }
+        }
+    }
+
+    for (int32_t seed : seeds) {
+        if (NodeAt(seed).alive && NodeAt(seed).kind == RedstoneNodeKind::WIRE &&
+            NodeAt(seed).network == INVALID) {
+            BuildNetwork(seed);
+        }
+    }
+
+    for (int32_t id : relink) {
+        const Node& node = NodeAt(id);
+        if (node.kind == RedstoneNodeKind::SOURCE) {
+            if (node.output != node.sourcePower) {
+                SetOutput(id, node.sourcePower);
+            }
+        } else if (node.kind != RedstoneNodeKind::WIRE) {
+            m_evaluateQueue.push_back(id);
+        }
+    }
+}
+
+bool RedstoneGraph::Delivers(const Node& emitter, const glm::ivec3& target) const {
+    switch (emitter.kind) {
+        case RedstoneNodeKind::WIRE:
+        case RedstoneNodeKind::SOURCE:
+            return true;
+        case RedstoneNodeKind::TORCH:
+            return target != emitter.position - emitter.facing;
+        case RedstoneNodeKind::REPEATER:
+        case RedstoneNodeKind::COMPARATOR:
+            return target == emitter.position + emitter.facing;
+        default:
+            return false;
+    }
+}
+
+bool RedstoneGraph::Reads(const Node& reader, const Node& emitter, bool& side) const {
+    side = false;
+    const glm::ivec3 offset = emitter.position - reader.position;
+
+    switch (reader.kind) {
+        case RedstoneNodeKind::WIRE:
+        case RedstoneNodeKind::CONSUMER:
+            return true;
+        case RedstoneNodeKind::TORCH:
+            return offset == -reader.facing;
+        case RedstoneNodeKind::REPEATER:
+        case RedstoneNodeKind::COMPARATOR: {
+            if (offset == -reader.facing) {
+                return true;
+            }
+            const bool beside = offset.y == 0 && glm::dot(glm::vec3(offset), glm::vec3(reader.facing)) == 0.0f;
+            if (!beside) {
+                return false;
+            }
+            // Repeaters are only locked by other diodes
+            if (reader.kind == RedstoneNodeKind::REPEATER &&
+                emitter.kind != RedstoneNodeKind::REPEATER && emitter.kind != RedstoneNodeKind::COMPARATOR) {
+                return false;
+            }
+            side = true;
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+void RedstoneGraph::RelinkInputs(int32_t id) {
+    Node& node = NodeAt(id);
+    node.inputCount = 0;
+    node.sideMask = 0;
+    m_stats.nodesRelinked++;
+
+    if (!node.alive || node.kind == RedstoneNodeKind::SOURCE) {
+        return;
+    }
+
+    for (const glm::ivec3& direction : kDirections) {
+        const int32_t other = FindNode(node.position + direction);
+        if (other == INVALID) {
+            continue;
+        }
+
+        const Node& emitter = NodeAt(other);
+        // Dust to dust goes through the wire network
+        if (node.kind == RedstoneNodeKind::WIRE && emitter.kind == RedstoneNodeKind::WIRE) {
+            continue;
+        }
+
+        bool side = false;
+        if (!Reads(node, emitter, side) || !Delivers(emitter, node.position)) {
+            continue;
+        }
+        if (side) {
+            node.sideMask |= static_cast<uint8_t>(1u << node.inputCount);
+        }
+        node.inputs[node.inputCount++] = other;
+    }
+}
+
+void RedstoneGraph::RebuildDependents(int32_t id) {
+    Node& node = NodeAt(id);
+    node.dependentCount = 0;
+    if (!node.alive) {
+        return;
+    }
+
+    for (const glm::ivec3& direction : kDirections) {
+        const int32_t other = FindNode(node.position + direction);
+        if (other == INVALID) {
+            continue;
+        }
+
+        const Node& reader = NodeAt(other);
+        for (uint8_t i = 0; i < reader.inputCount; ++i) {
+            if (reader.inputs[i] == id) {
+                node.dependents[node.dependentCount++] = other;
+                break;
+            }
+        }
+    }
+}
+
+void RedstoneGraph::FreeNetwork(int32_t networkId) {
+    Network& network = NetworkAt(networkId);
+    network.alive = false;
+    network.dust.clear();
+    network.ports.clear();
+    network.portReachStart.clear();
+    network.portReach.clear();
+    network.dustPortStart.clear();
+    network.dustPorts.clear();
+    m_freeNetworks.push_back(networkId);
+}
+
+void RedstoneGraph::BuildNetwork(int32_t seed) {
+    int32_t networkId;
+    if (!m_freeNetworks.empty()) {
+        networkId = m_freeNetworks.back();
+        m_freeNetworks.pop_back();
+    } else {
+        networkId = static_cast<int32_t>(m_networks.size());
+        m_networks.emplace_back();
+    }
+
+    Network& network = NetworkAt(networkId);
+    network.alive = true;
+    m_stats.networksBuilt++;
+
+    // Flood the connected dust
+    NodeAt(seed).network = networkId;
+    NodeAt(seed).networkSlot = 0;
+    network.dust.push_back(seed);
+    for (size_t head = 0; head < network.dust.size(); ++head) {
+        const glm::ivec3 position = NodeAt(network.dust[head]).position;
+        for (const glm::ivec3& direction : kDirections) {
+            const int32_t other = FindNode(position + direction);
+            if (other == INVALID || NodeAt(other).kind != RedstoneNodeKind::WIRE ||
+                NodeAt(other).network != INVALID) {
+                continue;
+            }
+            NodeAt(other).network = networkId;
+            NodeAt(other).networkSlot = static_cast<int32_t>(network.dust.size());
+            network.dust.push_back(other);
+        }
+    }
+
+    const size_t dustCount = network.dust.size();
+
+    // Slot adjacency, six entries per slot
+    std::vector<int32_t> adjacency(dustCount * 6, INVALID);
+    for (size_t slot = 0; slot < dustCount; ++slot) {
+        const glm::ivec3 position = NodeAt(network.dust[slot]).position;
+        for (int d = 0; d < 6; ++d) {
+            const int32_t other = FindNode(position + kDirections[d]);
+            if (other != INVALID && NodeAt(other).network == networkId) {
+                adjacency[slot * 6 + static_cast<size_t>(d)] = NodeAt(other).networkSlot;
+            }
+        }
+    }
+
+    // Every input of every dust is a port
+    for (size_t slot = 0; slot < dustCount; ++slot) {
+        const Node& dust = NodeAt(network.dust[slot]);
+        for (uint8_t i = 0; i < dust.inputCount; ++i) {
+            network.ports.push_back({dust.inputs[i], static_cast<int32_t>(slot), NodeAt(dust.inputs[i]).output});
+        }
+    }
+
+    // Dust within MAX_POWER - 1 blocks of each port
+    m_bfsSeen.assign(dustCount, ~0u);
+    m_bfsDistance.resize(dustCount);
+    network.portReachStart.resize(network.ports.size() + 1);
+    for (size_t p = 0; p < network.ports.size(); ++p) {
+        network.portReachStart[p] = static_cast<uint32_t>(network.portReach.size());
+
+        const uint32_t mark = static_cast<uint32_t>(p);
+        const int32_t start = network.ports[p].dust;
+        m_bfsQueue.clear();
+        m_bfsQueue.push_back(start);
+        m_bfsSeen[Index(start)] = mark;
+        m_bfsDistance[Index(start)] = 0;
+
+        for (size_t head = 0; head < m_bfsQueue.size(); ++head) {
+            const int32_t slot = m_bfsQueue[head];
+            const uint8_t distance = m_bfsDistance[Index(slot)];
+            network.portReach.push_back({slot, distance});
+            if (distance + 1 >= MAX_POWER) {
+                continue;
+            }
+
+            for (int d = 0; d < 6; ++d) {
+                const int32_t next = adjacency[Index(slot) * 6 + static_cast<size_t>(d)];
+                if (next != INVALID && m_bfsSeen[Index(next)] != mark) {
+                    m_bfsSeen[Index(next)] = mark;
+                    m_bfsDistance[Index(next)] = static_cast<uint8_t>(distance + 1);
+                    m_bfsQueue.push_back(next);
+                }
+            }
+        }
+    }
+    network.portReachStart[network.ports.size()] = static_cast<uint32_t>(network.portReach.size());
+
+    // Invert into the ports reaching each dust
+    network.dustPortStart.assign(dustCount + 1, 0);
+    for (const Reach& reach : network.portReach) {
+        network.dustPortStart[Index(reach.index) + 1]++;
+    }
+    for (size_t slot = 0; slot < dustCount; ++slot) {
+        network.dustPortStart[slot + 1] += network.dustPortStart[slot];
+    }
+    network.dustPorts.resize(network.portReach.size());
+    std::vector<uint32_t> fill(network.dustPortStart.begin(), network.dustPortStart.end() - 1);
+    for (size_t p = 0; p < network.ports.size(); ++p) {
+        for (uint32_t r = network.portReachStart[p]; r < network.portReachStart[p + 1]; ++r) {
+            const Reach& reach = network.portReach[r];
+            network.dustPorts[fill[Index(reach.index)]++] = {static_cast<int32_t>(p), reach.distance};
+        }
+    }
+
+    for (size_t slot = 0; slot < dustCount; ++slot) {
+        UpdateDust(network, static_cast<int32_t>(slot));
+    }
+}
+
+int RedstoneGraph::ReadInputs(const Node& node) const {
+    int power = 0;
+    for (uint8_t i = 0; i < node.inputCount; ++i) {
+        power = std::max<int>(power, NodeAt(node.inputs[i]).output);
+    }
+    return power;
+}
+
+int RedstoneGraph::EvaluateGate(const Node& node) const {
+    int back = 0;
+    int side = 0;
+    for (uint8_t i = 0; i < node.inputCount; ++i) {
+        const int power = NodeAt(node.inputs[i]).output;
+        if (node.sideMask & (1u << i)) {
+            side = std::max(side, power);
+        } else {
+            back = std::max(back, power);
+        }
+    }
+
+    switch (node.kind) {
+        case RedstoneNodeKind::TORCH:
+            return back > 0 ? 0 : MAX_POWER;
+        case RedstoneNodeKind::REPEATER:
+            if (side > 0) {
+                return node.output;     // Locked
+            }
+            return back > 0 ? MAX_POWER : 0;
+        case RedstoneNodeKind::COMPARATOR:
+            if (node.subtract) {
+                return std::max(0, back - side);
+            }
+            return back >= side ? back : 0;
+        default:
+            return node.output;
+    }
+}
+
+void RedstoneGraph::Evaluate(int32_t id) {
+    Node& node = NodeAt(id);
+    if (!node.alive) {
+        return;
+    }
+    m_stats.nodeEvaluations++;
+
+    switch (node.kind) {
+        case RedstoneNodeKind::CONSUMER: {
+            const int power = ReadInputs(node);
+            if (power != node.output) {
+                node.output = static_cast<uint8_t>(power);
+                MarkChanged(id);
+            }
+            break;
+        }
+        case RedstoneNodeKind::TORCH:
+        case RedstoneNodeKind::REPEATER:
+        case RedstoneNodeKind::COMPARATOR:
+            // Already pending gates re-read their inputs when they fire
+            if (!node.scheduled && EvaluateGate(node) != node.output) {
+                Schedule(id);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+void RedstoneGraph::Schedule(int32_t id) {
+    Node& node = NodeAt(id);
+    node.scheduled = true;
+    m_wheel[(m_tick + static_cast<uint64_t>(GateDelay(node.kind, node.delay))) & (WHEEL_SIZE - 1)].push_back(id);
+    m_stats.scheduledEvents++;
+}
+
+void RedstoneGraph::SetOutput(int32_t id, int power) {
+    Node& node = NodeAt(id);
+    node.output = static_cast<uint8_t>(power);
+    MarkChanged(id);
+
+    for (uint8_t i = 0; i < node.dependentCount; ++i) {
+        if (NodeAt(node.dependents[i]).kind != RedstoneNodeKind::WIRE) {
+            m_evaluateQueue.push_back(node.dependents[i]);
+        }
+    }
+    UpdatePorts(id);
+}
+
+void RedstoneGraph::UpdatePorts(int32_t emitter) {
+    const Node& node = NodeAt(emitter);
+    for (uint8_t i = 0; i < node.dependentCount; ++i) {
+        const Node& dust = NodeAt(node.dependents[i]);
+        if (dust.kind != RedstoneNodeKind::WIRE || dust.network == INVALID) {
+            continue;
+        }
+
+        Network& network = NetworkAt(dust.network);
+        for (uint32_t r = network.dustPortStart[Index(dust.networkSlot)]; r < network.dustPortStart[Index(dust.networkSlot) + 1]; ++r) {
+            const Reach& reach = network.dustPorts[r];
+            Port& port = network.ports[Index(reach.index)];
+            if (reach.distance != 0 || port.emitter != emitter || port.power == node.output) {
+                continue;
+            }
+
+            port.power = node.output;
+            for (uint32_t k = network.portReachStart[Index(reach.index)]; k < network.portReachStart[Index(reach.index) + 1]; ++k) {
+                UpdateDust(network, network.portReach[k].index);
+            }
+        }
+    }
+}
+
+void RedstoneGraph::UpdateDust(Network& network, int32_t slot) {
+    int power = 0;
+    for (uint32_t r = network.dustPortStart[Index(slot)]; r < network.dustPortStart[Index(slot) + 1]; ++r) {
+        const Reach& reach = network.dustPorts[r];
+        power = std::max(power, static_cast<int>(network.ports[Index(reach.index)].power) - reach.distance);
+    }
+    m_stats.wireUpdates++;
+
+    const int32_t id = network.dust[Index(slot)];
+    Node& node = NodeAt(id);
+    if (node.output == power) {
+        return;
+    }
+
+    node.output = static_cast<uint8_t>(power);
+    MarkChanged(id);
+    for (uint8_t i = 0; i < node.dependentCount; ++i) {
+        m_evaluateQueue.push_back(node.dependents[i]);
+    }
+}
+
+void RedstoneGraph::Drain() {
+    // Gates only schedule, so this settles without loops
+    while (!m_evaluateQueue.empty()) {
+        const int32_t id = m_evaluateQueue.back();
+        m_evaluateQueue.pop_back();
+        Evaluate(id);
+    }
+}
+
+void RedstoneGraph::MarkChanged(int32_t id) {
+    Node& node = NodeAt(id);
+    if (node.changedTick != m_tick) {
+        node.changedTick = m_tick;
+        m_changedPositions.push_back(node.position);
+    }
+}
+
+} // namespace VoxelCraft
@@ -0,0 +1,245 @@
+/**
+ * @file RedstoneGraph.hpp
+ * @brief VoxelCraft Redstone System - Compiled Redstone Graph
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#ifndef VOXELCRAFT_REDSTONE_REDSTONE_GRAPH_HPP
+#define VOXELCRAFT_REDSTONE_REDSTONE_GRAPH_HPP
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace VoxelCraft {
+
+    /**
+     * @enum RedstoneNodeKind
+     * @brief What a compiled node does with its inputs
+     */
+    enum class RedstoneNodeKind : uint8_t {
+        WIRE = 0,           ///< Dust, power = strongest input minus distance
+        SOURCE,             ///< Constant output (block, lever, button, plate)
+        TORCH,              ///< Inverts the block it is attached to, 1 tick
+        REPEATER,           ///< Repeats its back input at 15 after 1-4 ticks, side lock
+        COMPARATOR,         ///< Compare/subtract back and side inputs, 1 tick
+        CONSUMER            ///< Reads the strongest neighbour (lamp, piston, door)
+    };
+
+    /**
+     * @struct RedstoneNodeDesc
+     * @brief Placed redstone element as seen by the graph compiler
+     */
+    struct RedstoneNodeDesc {
+        RedstoneNodeKind kind = RedstoneNodeKind::CONSUMER;
+        glm::ivec3 facing = glm::ivec3(0, 0, 1);    ///< Output side; torches: away from the attached block
+        uint8_t delay = 1;                          ///< Repeater delay in ticks (1-4)
+        uint8_t power = 15;                         ///< SOURCE output
+        bool subtract = false;                      ///< Comparator in subtract mode
+    };
+
+    /**
+     * @struct RedstoneGraphStats
+     * @brief Work counters for RedstoneGraph
+     */
+    struct RedstoneGraphStats {
+        uint64_t ticks = 0;                         ///< Ticks simulated
+        uint64_t scheduledEvents = 0;               ///< Gate changes put on the tick wheel
+        uint64_t firedEvents = 0;                   ///< Gate changes taken off the tick wheel
+        uint64_t nodeEvaluations = 0;               ///< Gate and consumer input evaluations
+        uint64_t wireUpdates = 0;                   ///< Dust power recomputations
+        uint64_t recompiles = 0;                    ///< Ticks that applied block changes
+        uint64_t nodesRelinked = 0;                 ///< Nodes whose inputs were rebuilt
+        uint64_t networksBuilt = 0;                 ///< Wire networks (re)built
+    };
+
+    /**
+     * @class RedstoneGraph
+     * @brief Redstone circuits compiled into a flat graph and simulated on events
+     *
+     * Every placed element becomes a node with an integer ID; nodes keep up
+     * to six input and six dependent IDs, so the tick never looks up
+     * positions. Connected dust forms a wire network: each input feeding the
+     * network (a port) has a precomputed list of the dust within 15 blocks
+     * and their distance, and dust power is the best port power minus
+     * distance. A changed input only recomputes the dust that port reaches.
+     *
+     * Only dirty nodes are evaluated: a node is looked at when one of its
+     * inputs changed. Torches, repeaters and comparators do not change at
+     * once; they are put on a tick wheel (a ring of per-tick buckets) and
+     * take their new output when their bucket comes up, as in vanilla.
+     * Dust and consumers follow their inputs within the same tick.
+     *
+     * SetComponent and RemoveComponent only record the change; the next Tick
+     * relinks the nodes at and around each changed position and rebuilds the
+     * wire networks touching them, leaving the rest of the graph as it is.
+     *
+     * Not thread safe; RedstoneSystem owns it and calls it from its update.
+     */
+    class RedstoneGraph {
+    public:
+        static constexpr int WHEEL_SIZE = 16;       ///< Power of two above the longest delay
+        static constexpr int MAX_POWER = 15;
+
+        RedstoneGraph();
+
+        /**
+         * @brief Place or replace an element
+         * @param position Block position
+         * @param desc Element description
+         */
+        void SetComponent(const glm::ivec3& position, const RedstoneNodeDesc& desc);
+
+        /**
+         * @brief Remove an element
+         * @param position Block position
+         * @return true if there was one
+         */
+        bool RemoveComponent(const glm::ivec3& position);
+
+        /**
+         * @brief Change the output of a SOURCE (lever flipped, button pressed)
+         * @param position Block position
+         * @param power New output (0-15)
+         */
+        void SetSourcePower(const glm::ivec3& position, int power);
+
+        /**
+         * @brief Apply block changes and simulate one redstone tick
+         */
+        void Tick();
+
+        /**
+         * @brief Get the power at an element
+         * @param position Block position
+         * @return Output for dust, sources and gates; input for consumers
+         */
+        int GetPowerLevel(const glm::ivec3& position) const;
+
+        /**
+         * @brief Check if an element exists at a position
+         * @param position Block position
+         * @return true if present
+         */
+        bool HasComponent(const glm::ivec3& position) const;
+
+        /**
+         * @brief Get the elements whose power changed during the last Tick
+         * @return Positions, each listed once
+         */
+        const std::vector<glm::ivec3>& GetChangedPositions() const { return m_changedPositions; }
+
+        /**
+         * @brief Remove every element
+         */
+        void Clear();
+
+        size_t GetNodeCount() const { return m_nodes.size() - m_freeNodes.size() - m_retiredNodes.size(); }
+        size_t GetNetworkCount() const { return m_networks.size() - m_freeNetworks.size(); }
+        uint64_t GetTick() const { return m_tick; }
+        const RedstoneGraphStats& GetStats() const { return m_stats; }
+
+    private:
+        static constexpr int32_t INVALID = -1;
+
+        struct Node {
+            glm::ivec3 position;
+            glm::ivec3 facing;
+            RedstoneNodeKind kind;
+            uint8_t delay;
+            uint8_t sourcePower;
+            uint8_t output;             // Power offered to neighbours (consumers: input)
+            bool subtract;
+            bool alive;
+            bool scheduled;             // On the tick wheel
+            uint8_t inputCount;
+            uint8_t dependentCount;
+            uint8_t sideMask;           // Bit i: inputs[i] is a side input
+            int32_t inputs[6];
+            int32_t dependents[6];
+            int32_t network;            // Wire network, INVALID if not dust
+            int32_t networkSlot;        // Index of the dust inside its network
+            uint64_t changedTick;
+        };
+
+        struct Port {
+            int32_t emitter;            // Node feeding the network
+            int32_t dust;               // Network slot it feeds
+            uint8_t power;
+        };
+
+        struct Reach {
+            int32_t index;              // Network slot (port reach) or port index (dust ports)
+            uint8_t distance;
+        };
+
+        struct Network {
+            bool alive = false;
+            std::vector<int32_t> dust;              // Slot -> node
+            std::vector<Port> ports;
+            std::vector<uint32_t> portReachStart;   // Per port, into portReach
+            std::vector<Reach> portReach;           // Dust a port reaches
+            std::vector<uint32_t> dustPortStart;    // Per slot, into dustPorts
+            std::vector<Reach> dustPorts;           // Ports reaching a dust
+        };
+
+        // IDs and slots stay int32_t so INVALID can be -1; only valid ones index
+        static size_t Index(int32_t id) { return static_cast<size_t>(id); }
+        Node& NodeAt(int32_t id) { return m_nodes[Index(id)]; }
+        const Node& NodeAt(int32_t id) const { return m_nodes[Index(id)]; }
+        Network& NetworkAt(int32_t id) { return m_networks[Index(id)]; }
+
+        std::vector<Node> m_nodes;
+        std::vector<int32_t> m_freeNodes;
+        std::vector<std::pair<uint64_t, int32_t>> m_retiredNodes;   // Removed, may still be on the wheel
+        std::unordered_map<uint64_t, int32_t> m_nodeAt;
+
+        std::vector<Network> m_networks;
+        std::vector<int32_t> m_freeNetworks;
+
+        std::vector<int32_t> m_wheel[WHEEL_SIZE];
+        uint64_t m_tick;
+
+        std::vector<glm::ivec3> m_dirtyPositions;
+        std::vector<int32_t> m_dirtyNetworks;       // Lost dust through removal
+        std::vector<int32_t> m_dirtySources;
+        std::vector<int32_t> m_firing;
+        std::vector<int32_t> m_evaluateQueue;
+        std::vector<glm::ivec3> m_changedPositions;
+
+        // Compile scratch
+        std::vector<uint32_t> m_visitStamp;
+        uint32_t m_stamp;
+        std::vector<int32_t> m_bfsQueue;
+        std::vector<uint8_t> m_bfsDistance;
+        std::vector<uint32_t> m_bfsSeen;
+
+        RedstoneGraphStats m_stats;
+
+        static uint64_t PositionKey(const glm::ivec3& position);
+        int32_t FindNode(const glm::ivec3& position) const;
+
+        void Recompile();
+        void RelinkInputs(int32_t id);
+        void RebuildDependents(int32_t id);
+        void BuildNetwork(int32_t seed);
+        void FreeNetwork(int32_t networkId);
+        bool Delivers(const Node& emitter, const glm::ivec3& target) const;
+        bool Reads(const Node& reader, const Node& emitter, bool& side) const;
+
+        int EvaluateGate(const Node& node) const;
+        int ReadInputs(const Node& node) const;
+        void Evaluate(int32_t id);
+        void Schedule(int32_t id);
+        void SetOutput(int32_t id, int power);
+        void UpdatePorts(int32_t emitter);
+        void UpdateDust(Network& network, int32_t slot);
+        void Drain();
+        void MarkChanged(int32_t id);
+    };
+
+} // namespace VoxelCraft
+
+#endif // VOXELCRAFT_REDSTONE_REDSTONE_GRAPH_HPP
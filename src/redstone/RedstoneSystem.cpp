@@ -53,11 +53,16 @@ void RedstoneSystem::Update(float deltaTime) {
     if (m_updateTimer >= m_config.updateInterval) {
         m_updateTimer = 0.0f;
 
-        // Update components
-        UpdateComponents(m_config.updateInterval);
-
-        // Process power updates
-        ProcessPowerUpdates();
+        if (m_config.enableCompiledGraph) {
+            // Only components whose inputs changed are touched
+            UpdateGraph();
+        } else {
+            // Update components
+            UpdateComponents(m_config.updateInterval);
+
+            // Process power updates
+            ProcessPowerUpdates();
+        }
 
         // Update circuits
         UpdateCircuits(m_config.updateInterval);
@@ -93,6 +98,9 @@ bool RedstoneSystem::AddComponent(std::shared_ptr<RedstoneComponent> component)
     m_components[position] = component;
     m_stats.totalComponents++;
 
+    // Compiled in by the next graph tick
+    m_graph.SetComponent(position, DescribeComponent(*component));
+
     // Trigger event
     TriggerEvent("component_added", position);
 
@@ -113,11 +121,14 @@ bool RedstoneSystem::RemoveComponent(const glm::ivec3& position) {
     // Remove from storage
     m_components.erase(it);
     m_stats.totalComponents--;
+    m_graph.RemoveComponent(position);
 
     // Update power at neighboring positions
-    auto neighbors = component->GetConnectedComponents();
-    for (const auto& neighborPos : neighbors) {
-        UpdatePower(neighborPos, 0, position);
+    if (!m_config.enableCompiledGraph) {
+        auto neighbors = component->GetConnectedComponents();
+        for (const auto& neighborPos : neighbors) {
+            UpdatePower(neighborPos, 0, position);
+        }
     }
 
     // Trigger event
@@ -134,6 +145,11 @@ std::shared_ptr<RedstoneComponent> RedstoneSystem::GetComponent(const glm::ivec3
 }
 
 int RedstoneSystem::GetPowerLevel(const glm::ivec3& position, const glm::ivec3& direction) const {
+    if (m_config.enableCompiledGraph) {
+        std::shared_lock<std::shared_mutex> lock(m_systemMutex);
+        return m_graph.GetPowerLevel(position);
+    }
+
     auto component = GetComponent(position);
     if (component) {
         return component->GetPowerLevel();
@@ -161,6 +177,14 @@ bool RedstoneSystem::ProvidesWeakPower(const glm::ivec3& position, const glm::iv
 }
 
 void RedstoneSystem::UpdatePower(const glm::ivec3& position, int powerLevel, const glm::ivec3& sourcePosition) {
+    if (m_config.enableCompiledGraph) {
+        // Only sources take outside power; the graph derives everything else
+        std::unique_lock<std::shared_mutex> lock(m_systemMutex);
+        m_graph.SetSourcePower(position, powerLevel);
+        m_stats.signalPropagationEvents++;
+        return;
+    }
+
     auto component = GetComponent(position);
     if (component) {
         int oldPower = component->GetPowerLevel();
@@ -294,6 +318,7 @@ void RedstoneSystem::Clear() {
 
     m_components.clear();
     m_circuits.clear();
+    m_graph.Clear();
 
     while (!m_powerUpdateQueue.empty()) {
         m_powerUpdateQueue.pop();
@@ -348,6 +373,77 @@ void RedstoneSystem::UpdateComponents(float deltaTime) {
     }
 }
 
+void RedstoneSystem::UpdateGraph() {
+    std::vector<std::pair<std::shared_ptr<RedstoneComponent>, int>> changed;
+    {
+        std::unique_lock<std::shared_mutex> lock(m_systemMutex);
+
+        m_graph.Tick();
+        for (const glm::ivec3& position : m_graph.GetChangedPositions()) {
+            auto it = m_components.find(position);
+            if (it != m_components.end()) {
+                changed.emplace_back(it->second, m_graph.GetPowerLevel(position));
+            }
+        }
+
+        m_stats.graphNodes = static_cast<int>(m_graph.GetNodeCount());
+        m_stats.graphChangesLastTick = static_cast<int>(m_graph.GetChangedPositions().size());
+        m_stats.powerUpdatesPerSecond = static_cast<int>(static_cast<float>(changed.size()) / m_config.updateInterval);
+    }
+
+    // Mirror the results into the components outside the lock, pistons and
+    // other consumers react through SetPowerLevel
+    for (const auto& [component, power] : changed) {
+        if (DescribeComponent(*component).kind == RedstoneNodeKind::CONSUMER) {
+            component->SetPowerLevel(power);
+        } else {
+            component->ApplySimulatedPower(power);
+        }
+    }
+}
+
+RedstoneNodeDesc RedstoneSystem::DescribeComponent(const RedstoneComponent& component) {
+    RedstoneNodeDesc desc;
+    desc.facing = component.GetFacingDirection();
+
+    switch (component.GetType()) {
+        case RedstoneType::WIRE:
+            desc.kind = RedstoneNodeKind::WIRE;
+            break;
+        case RedstoneType::TORCH:
+            // Standing on the block below
+            desc.kind = RedstoneNodeKind::TORCH;
+            desc.facing = glm::ivec3(0, 1, 0);
+            break;
+        case RedstoneType::REPEATER:
+            desc.kind = RedstoneNodeKind::REPEATER;
+            desc.delay = static_cast<uint8_t>(static_cast<const RedstoneRepeater&>(component).GetDelay());
+            break;
+        case RedstoneType::COMPARATOR:
+            desc.kind = RedstoneNodeKind::COMPARATOR;
+            desc.subtract = static_cast<const RedstoneComparator&>(component).GetMode() ==
+                            RedstoneComparator::ComparatorMode::SUBTRACT;
+            break;
+        case RedstoneType::BLOCK:
+            desc.kind = RedstoneNodeKind::SOURCE;
+            desc.power = 15;
+            break;
+        case RedstoneType::LEVER:
+        case RedstoneType::BUTTON:
+        case RedstoneType::PRESSURE_PLATE:
+        case RedstoneType::TRIPWIRE:
+        case RedstoneType::TARGET:
+            desc.kind = RedstoneNodeKind::SOURCE;
+            desc.power = static_cast<uint8_t>(component.GetPowerLevel());
+            break;
+        default:
+            desc.kind = RedstoneNodeKind::CONSUMER;
+            break;
+    }
+
+    return desc;
+}
+
 void RedstoneSystem::UpdateCircuits(float deltaTime) {
     // Update circuit analysis if needed
     // This would be more complex in a full implementation
@@ -20,6 +20,7 @@
 #include <glm/glm.hpp>
 
 #include "RedstoneComponent.hpp"
+#include "RedstoneGraph.hpp"
 
 namespace VoxelCraft {
 
@@ -43,6 +44,7 @@ namespace VoxelCraft {
         int maxSignalRange = 64;                       ///< Maximum signal transmission range
         bool enableObserverUpdates = true;             ///< Enable observer block updates
         bool enableQuasiConnectivity = true;           ///< Enable quasi-connectivity rules
+        bool enableCompiledGraph = true;               ///< Simulate through RedstoneGraph instead of per-component updates
     };
 
     /**
@@ -58,6 +60,8 @@ namespace VoxelCraft {
         int maxCircuitDepth = 0;                       ///< Maximum circuit depth reached
         int signalPropagationEvents = 0;               ///< Signal propagation events
         int circuitOptimizations = 0;                  ///< Circuit optimizations performed
+        int graphNodes = 0;                            ///< Nodes in the compiled graph
+        int graphChangesLastTick = 0;                  ///< Compiled nodes whose power changed last tick
     };
 
     /**
@@ -185,6 +189,12 @@ namespace VoxelCraft {
          */
         void SetConfig(const RedstoneSystemConfig& config) { m_config = config; }
 
+        /**
+         * @brief Get the compiled graph used when enableCompiledGraph is set
+         * @return Compiled graph
+         */
+        const RedstoneGraph& GetGraph() const { return m_graph; }
+
         /**
          * @brief Get system statistics
          * @return Current statistics
@@ -229,6 +239,10 @@ namespace VoxelCraft {
         void ProcessPowerUpdates();
         void CleanupInactiveComponents();
 
+        // Compiled graph
+        void UpdateGraph();
+        static RedstoneNodeDesc DescribeComponent(const RedstoneComponent& component);
+
         // Power propagation
         void PropagatePowerRecursive(const glm::ivec3& position, int powerLevel,
                                    const glm::ivec3& sourcePosition, int depth);
@@ -254,6 +268,7 @@ namespace VoxelCraft {
         // Component storage
         std::unordered_map<glm::ivec3, std::shared_ptr<RedstoneComponent>, std::hash<glm::ivec3::value_type>> m_components;
         std::vector<RedstoneCircuit> m_circuits;
+        RedstoneGraph m_graph;
 
         // Update queues
         std::queue<std::pair<glm::ivec3, int>> m_powerUpdateQueue;
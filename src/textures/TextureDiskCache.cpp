@@ -0,0 +1,222 @@
+/**
+ * @file TextureDiskCache.cpp
+ * @brief VoxelCraft Texture Disk Cache Implementation
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#include "TextureDiskCache.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <utility>
+
+namespace VoxelCraft {
+
+    namespace {
+
+        constexpr uint32_t FILE_MAGIC = 0x43545856;                  // "VXTC"
+        constexpr size_t HEADER_SIZE = 48;
+        constexpr uint64_t MAX_PAYLOAD = 256ull * 1024 * 1024;
+
+        void WriteLE32(uint8_t* out, uint32_t value) {
+            for (int i = 0; i < 4; ++i) {
+                out[i] = static_cast<uint8_t>(value >> (i * 8));
+            }
+        }
+
+        void WriteLE64(uint8_t* out, uint64_t value) {
+            for (int i = 0; i < 8; ++i) {
+                out[i] = static_cast<uint8_t>(value >> (i * 8));
+            }
+        }
+
+        uint32_t ReadLE32(const uint8_t* in) {
+            uint32_t value = 0;
+            for (int i = 0; i < 4; ++i) {
+                value |= static_cast<uint32_t>(in[i]) << (i * 8);
+            }
+            return value;
+        }
+
+        uint64_t ReadLE64(const uint8_t* in) {
+            uint64_t value = 0;
+            for (int i = 0; i < 8; ++i) {
+                value |= static_cast<uint64_t>(in[i]) << (i * 8);
+            }
+            return value;
+        }
+
+        uint64_t Checksum(const std::vector<uint8_t>& payload) {
+            TextureHasher hasher;
+            hasher.Add(payload.data(), payload.size());
+            return hasher.Get();
+        }
+
+    } // namespace
+
+    TextureHasher& TextureHasher::Add(const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            m_hash = (m_hash ^ bytes[i]) * 1099511628211ull;
+        }
+        return *this;
+    }
+
+    TextureHasher& TextureHasher::Add(uint64_t value) {
+        uint8_t bytes[8];
+        WriteLE64(bytes, value);
+        return Add(bytes, sizeof(bytes));
+    }
+
+    TextureHasher& TextureHasher::Add(uint32_t value) {
+        uint8_t bytes[4];
+        WriteLE32(bytes, value);
+        return Add(bytes, sizeof(bytes));
+    }
+
+    TextureHasher& TextureHasher::Add(int32_t value) {
+        return Add(static_cast<uint32_t>(value));
+    }
+
+    TextureHasher& TextureHasher::Add(bool value) {
+        return Add(static_cast<uint32_t>(value ? 1 : 0));
+    }
+
+    TextureHasher& TextureHasher::Add(float value) {
+        if (value == 0.0f) {
+            value = 0.0f;
+        }
+        uint32_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return Add(bits);
+    }
+
+    TextureHasher& TextureHasher::Add(const std::string& value) {
+        Add(static_cast<uint64_t>(value.size()));
+        return Add(value.data(), value.size());
+    }
+
+    TextureDiskCache::TextureDiskCache(const std::string& directory)
+        : m_directory(directory)
+        , m_hits(0)
+        , m_misses(0)
+        , m_writes(0)
+        , m_rejected(0)
+        , m_tempCounter(0)
+    {
+    }
+
+    std::string TextureDiskCache::GetPath(uint64_t key) const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+        return (std::filesystem::path(m_directory) / std::string(name, 2) / (std::string(name) + ".vxtex")).string();
+    }
+
+    bool TextureDiskCache::Load(uint64_t key, Image& image) {
+        if (!IsEnabled()) {
+            return false;
+        }
+
+        std::ifstream file(GetPath(key), std::ios::binary);
+        if (!file) {
+            m_misses.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        uint8_t header[HEADER_SIZE];
+        bool valid = static_cast<bool>(file.read(reinterpret_cast<char*>(header), HEADER_SIZE));
+
+        const uint64_t payloadSize = valid ? ReadLE64(header + 32) : 0;
+        valid = valid &&
+            ReadLE32(header) == FILE_MAGIC &&
+            ReadLE32(header + 4) == FORMAT_VERSION &&
+            ReadLE64(header + 8) == key &&
+            payloadSize <= MAX_PAYLOAD;
+
+        Image loaded;
+        if (valid) {
+            loaded.width = static_cast<int>(ReadLE32(header + 16));
+            loaded.height = static_cast<int>(ReadLE32(header + 20));
+            loaded.mipLevels = ReadLE32(header + 24);
+            loaded.pixels.resize(static_cast<size_t>(payloadSize));
+            valid = static_cast<bool>(file.read(reinterpret_cast<char*>(loaded.pixels.data()),
+                                                static_cast<std::streamsize>(payloadSize))) &&
+                Checksum(loaded.pixels) == ReadLE64(header + 40);
+        }
+
+        if (!valid) {
+            m_rejected.fetch_add(1, std::memory_order_relaxed);
+            m_misses.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        image = std::move(loaded);
+        m_hits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool TextureDiskCache::Store(uint64_t key, const Image& image) {
+        if (!IsEnabled()) {
+            return false;
+        }
+
+        const std::string path = GetPath(key);
+        std::error_code error;
+        std::filesystem::create_directories(std::filesystem::path(path).parent_path(), error);
+        if (error) {
+            return false;
+        }
+
+        uint8_t header[HEADER_SIZE] = {};
+        WriteLE32(header, FILE_MAGIC);
+        WriteLE32(header + 4, FORMAT_VERSION);
+        WriteLE64(header + 8, key);
+        WriteLE32(header + 16, static_cast<uint32_t>(image.width));
+        WriteLE32(header + 20, static_cast<uint32_t>(image.height));
+        WriteLE32(header + 24, image.mipLevels);
+        WriteLE64(header + 32, static_cast<uint64_t>(image.pixels.size()));
+        WriteLE64(header + 40, Checksum(image.pixels));
+
+        // Unique per writer so concurrent stores of the same key never share a temp file
+        const uint64_t writer = std::hash<std::thread::id>()(std::this_thread::get_id()) ^
+            m_tempCounter.fetch_add(1, std::memory_order_relaxed);
+        const std::string tempPath = path + ".tmp" + std::to_string(writer);
+
+        bool ok;
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            ok = file.write(reinterpret_cast<const char*>(header), HEADER_SIZE) &&
+                file.write(reinterpret_cast<const char*>(image.pixels.data()),
+                           static_cast<std::streamsize>(image.pixels.size()));
+            file.close();
+            ok = ok && !file.fail();
+        }
+
+        if (ok) {
+            std::filesystem::rename(tempPath, path, error);
+            ok = !error;
+        }
+        if (!ok) {
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+
+        m_writes.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    TextureDiskCache::Stats TextureDiskCache::GetStats() const {
+        Stats stats;
+        stats.hits = m_hits.load(std::memory_order_relaxed);
+        stats.misses = m_misses.load(std::memory_order_relaxed);
+        stats.writes = m_writes.load(std::memory_order_relaxed);
+        stats.rejected = m_rejected.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+} // namespace VoxelCraft
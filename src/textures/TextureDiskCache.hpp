@@ -0,0 +1,125 @@
+/**
+ * @file TextureDiskCache.hpp
+ * @brief VoxelCraft Texture Disk Cache - Content-addressed store for generated textures
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * Generated textures are stored under the hash of everything that shaped
+ * them (see TextureHasher), so a definition that has not changed loads
+ * its pixels from disk instead of being generated again, and an edited
+ * definition simply misses. Files are never updated in place: each store
+ * writes a temporary file and renames it over the final name, so readers
+ * see either a complete entry or none.
+ *
+ * Layout: <directory>/<first two hex digits>/<16 hex digits>.vxtex
+ */
+
+#ifndef VOXELCRAFT_TEXTURES_TEXTURE_DISK_CACHE_HPP
+#define VOXELCRAFT_TEXTURES_TEXTURE_DISK_CACHE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace VoxelCraft {
+
+    /**
+     * @class TextureHasher
+     * @brief 64-bit FNV-1a over the fields of a texture definition
+     *
+     * Strings are length-prefixed and floats hashed by bit pattern (with
+     * -0 folded into 0), so distinct field sequences cannot collide by
+     * concatenation.
+     */
+    class TextureHasher {
+    public:
+        TextureHasher& Add(const void* data, size_t size);
+        TextureHasher& Add(uint64_t value);
+        TextureHasher& Add(uint32_t value);
+        TextureHasher& Add(int32_t value);
+        TextureHasher& Add(bool value);
+        TextureHasher& Add(float value);
+        TextureHasher& Add(const std::string& value);
+
+        uint64_t Get() const { return m_hash; }
+
+    private:
+        uint64_t m_hash = 1469598103934665603ull;
+    };
+
+    /**
+     * @class TextureDiskCache
+     * @brief Loads and stores RGBA8 texture images by content hash
+     *
+     * Thread-safe: entries are independent files and the statistics are
+     * atomic, so tiles of an atlas may load and store concurrently.
+     */
+    class TextureDiskCache {
+    public:
+        /**
+         * @struct Image
+         * @brief Pixels of a cached texture, mip chain included if it was built
+         */
+        struct Image {
+            int width = 0;
+            int height = 0;
+            uint32_t mipLevels = 1;
+            std::vector<uint8_t> pixels;
+        };
+
+        /**
+         * @struct Stats
+         * @brief Cache activity since construction
+         */
+        struct Stats {
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+            uint64_t writes = 0;
+            uint64_t rejected = 0;          ///< Entries present but truncated or corrupt
+        };
+
+        /// Bumped whenever the file layout changes; older entries then miss
+        static constexpr uint32_t FORMAT_VERSION = 1;
+
+        /**
+         * @brief Constructor
+         * @param directory Cache root, created on first store; empty disables the cache
+         */
+        explicit TextureDiskCache(const std::string& directory = "");
+
+        bool IsEnabled() const { return !m_directory.empty(); }
+        const std::string& GetDirectory() const { return m_directory; }
+
+        /**
+         * @brief Load an entry
+         * @return true if the entry exists and is intact
+         */
+        bool Load(uint64_t key, Image& image);
+
+        /**
+         * @brief Store an entry, replacing any previous one atomically
+         * @return true if written
+         */
+        bool Store(uint64_t key, const Image& image);
+
+        /**
+         * @brief File that holds an entry
+         */
+        std::string GetPath(uint64_t key) const;
+
+        Stats GetStats() const;
+
+    private:
+        std::string m_directory;
+        std::atomic<uint64_t> m_hits;
+        std::atomic<uint64_t> m_misses;
+        std::atomic<uint64_t> m_writes;
+        std::atomic<uint64_t> m_rejected;
+        std::atomic<uint64_t> m_tempCounter;
+    };
+
+} // namespace VoxelCraft
+
+#endif // VOXELCRAFT_TEXTURES_TEXTURE_DISK_CACHE_HPP
@@ -6,9 +6,11 @@
  */
 
 #include "TextureGenerator.hpp"
+#include "TextureMipmaps.hpp"
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -17,6 +19,7 @@
 #include <queue>
 #include <future>
 
+#include "../core/ThreadPool.hpp"
 #include "../math/MathUtils.hpp"
 #include "../math/Noise.hpp"
 #include "../utils/Logger.hpp"
@@ -28,6 +31,71 @@ namespace VoxelCraft {
     // Static instance
     static TextureGenerator* s_instance = nullptr;
 
+    namespace {
+
+        void AddColor(TextureHasher& hasher, const Color& color) {
+            hasher.Add(color.r).Add(color.g).Add(color.b).Add(color.a);
+        }
+
+        void AddVec3(TextureHasher& hasher, const Vec3& value) {
+            hasher.Add(value.x).Add(value.y).Add(value.z);
+        }
+
+        void AddNoiseConfig(TextureHasher& hasher, const NoiseConfig& config) {
+            hasher.Add(static_cast<int32_t>(config.type))
+                  .Add(config.frequency).Add(config.amplitude).Add(config.lacunarity).Add(config.persistence)
+                  .Add(static_cast<int32_t>(config.octaves))
+                  .Add(config.offsetX).Add(config.offsetY).Add(config.offsetZ).Add(config.seed)
+                  .Add(config.warpStrength).Add(config.warpFrequency).Add(config.useGradient);
+            AddVec3(hasher, config.gradientDirection);
+            hasher.Add(config.animated).Add(config.animationSpeed).Add(config.timeOffset);
+        }
+
+        void AddColorConfig(TextureHasher& hasher, const ColorConfig& config) {
+            AddColor(hasher, config.baseColor);
+            AddColor(hasher, config.secondaryColor);
+            AddColor(hasher, config.accentColor);
+            hasher.Add(config.colorVariation).Add(config.useGradient);
+            AddVec3(hasher, config.gradientStart);
+            AddVec3(hasher, config.gradientEnd);
+            hasher.Add(config.gradientStrength);
+
+            hasher.Add(static_cast<uint64_t>(config.colorPalette.size()));
+            for (const auto& color : config.colorPalette) {
+                AddColor(hasher, color);
+            }
+            hasher.Add(config.useColorMap).Add(config.colorMapScale)
+                  .Add(config.saturation).Add(config.brightness).Add(config.contrast).Add(config.hueShift);
+        }
+
+        void AddPatternConfig(TextureHasher& hasher, const PatternConfig& config) {
+            hasher.Add(config.patternType).Add(config.patternScale).Add(config.patternIntensity)
+                  .Add(config.patternRotation).Add(config.patternOffset.x).Add(config.patternOffset.y)
+                  .Add(config.useVoronoi).Add(config.voronoiScale).Add(config.useWorley).Add(config.worleyScale)
+                  .Add(config.useMarble).Add(config.marbleScale).Add(config.useWood).Add(config.woodScale)
+                  .Add(config.useClouds).Add(config.cloudScale);
+
+            hasher.Add(static_cast<uint64_t>(config.blendPatterns.size()));
+            for (const auto& pattern : config.blendPatterns) {
+                hasher.Add(pattern);
+            }
+            hasher.Add(static_cast<uint64_t>(config.blendWeights.size()));
+            for (float weight : config.blendWeights) {
+                hasher.Add(weight);
+            }
+            hasher.Add(config.blendMode);
+        }
+
+        int NextPowerOfTwo(int value) {
+            int result = 1;
+            while (result < value) {
+                result <<= 1;
+            }
+            return result;
+        }
+
+    } // namespace
+
     TextureGenerator& TextureGenerator::GetInstance() {
         if (!s_instance) {
             s_instance = new TextureGenerator();
@@ -64,6 +132,9 @@ namespace VoxelCraft {
             Logger::Info("Loading texture generator config from: {}", configPath);
         }
 
+        // Generated textures persist across runs, keyed by their definition
+        m_diskCache = std::make_unique<TextureDiskCache>("cache/textures");
+
         // Initialize texture presets
         InitializeTexturePresets();
 
@@ -88,6 +159,7 @@ namespace VoxelCraft {
         // Clear cache
         m_textureCache.clear();
         m_texturePresets.clear();
+        m_diskCache.reset();
 
         // Clear GPU resources
         if (m_computeShaderProgram != 0) {
@@ -125,84 +197,34 @@ namespace VoxelCraft {
         auto startTime = std::chrono::high_resolution_clock::now();
 
         try {
-            // Create texture data
-            auto textureData = std::make_shared<TextureData>();
-            textureData->textureId = textureDef.id;
-            textureData->format = textureDef.format;
-            textureData->width = textureDef.width;
-            textureData->height = textureDef.height;
-            textureData->depth = textureDef.depth;
-            textureData->generatorId = "TextureGenerator";
-            textureData->generationTime = static_cast<uint64_t>(
-                std::chrono::system_clock::now().time_since_epoch().count());
-
-            // Set random seed
+            // Random seeds never repeat, so only explicit seeds go through the disk cache
+            const bool useDiskCache = seed != 0;
             if (seed == 0) {
                 seed = RandomSeed();
             }
 
-            // Calculate data size
-            size_t bytesPerPixel = GetBytesPerPixel(textureDef.format);
-            textureData->dataSize = textureDef.width * textureDef.height * textureDef.depth * bytesPerPixel;
-            textureData->pixelData.resize(textureData->dataSize);
-
-            // Generate texture layers
-            std::vector<std::shared_ptr<TextureData>> layerTextures;
-            for (const auto& layer : textureDef.layers) {
-                if (layer.enabled) {
-                    auto layerTexture = GenerateLayerTexture(layer, textureDef.width, textureDef.height);
-                    if (layerTexture) {
-                        layerTextures.push_back(layerTexture);
-                    }
-                }
-            }
-
-            // Composite layers
-            if (!layerTextures.empty()) {
-                // Start with first layer
-                textureData = layerTextures[0];
-
-                // Blend remaining layers
-                for (size_t i = 1; i < layerTextures.size(); ++i) {
-                    textureData = BlendTextures(textureData, layerTextures[i],
-                                              textureDef.layers[i].blendMode,
-                                              textureDef.layers[i].opacity);
-                }
-            }
-
-            // Apply global effects
-            if (textureDef.globalColorConfig.saturation != 1.0f ||
-                textureDef.globalColorConfig.brightness != 1.0f ||
-                textureDef.globalColorConfig.contrast != 1.0f) {
-                std::unordered_map<std::string, float> effects;
-                effects["saturation"] = textureDef.globalColorConfig.saturation;
-                effects["brightness"] = textureDef.globalColorConfig.brightness;
-                effects["contrast"] = textureDef.globalColorConfig.contrast;
-                textureData = ApplyTextureEffects(textureData, effects);
-            }
-
-            // Generate mipmaps if requested
-            if (textureDef.useMipmaps) {
-                GenerateMipmaps(textureData);
-            }
-
-            // Compress if requested
-            if (textureDef.useCompression) {
-                CompressTexture(textureData);
-            }
+            bool fromDisk = false;
+            auto textureData = ProduceTexture(textureDef, seed, useDiskCache, fromDisk);
 
             // Calculate generation time
             auto endTime = std::chrono::high_resolution_clock::now();
             textureData->loadTime = std::chrono::duration<float>(endTime - startTime).count();
 
             // Update statistics
-            m_stats.totalTexturesGenerated++;
+            if (fromDisk) {
+                m_stats.diskCacheHits++;
+            } else {
+                if (useDiskCache && m_diskCache && m_diskCache->IsEnabled()) {
+                    m_stats.diskCacheMisses++;
+                }
+                m_stats.totalTexturesGenerated++;
+            }
             m_stats.averageGenerationTime = (m_stats.averageGenerationTime + textureData->loadTime) * 0.5f;
             m_stats.totalMemoryUsage += textureData->dataSize;
 
-            Logger::Debug("Generated texture '{}' in {:.3f}s, size: {}x{}, {} bytes",
-                         textureDef.id, textureData->loadTime, textureDef.width, textureDef.height,
-                         textureData->dataSize);
+            Logger::Debug("{} texture '{}' in {:.3f}s, size: {}x{}, {} bytes",
+                         fromDisk ? "Loaded" : "Generated", textureDef.id, textureData->loadTime,
+                         textureDef.width, textureDef.height, textureData->dataSize);
 
             return textureData;
 
@@ -213,6 +235,120 @@ namespace VoxelCraft {
         }
     }
 
+    std::shared_ptr<TextureData> TextureGenerator::ComposeTexture(const ProceduralTexture& textureDef, uint32_t seed) {
+        // Touches no generator state, so atlas tiles can compose concurrently
+        auto textureData = std::make_shared<TextureData>();
+        textureData->width = textureDef.width;
+        textureData->height = textureDef.height;
+        textureData->depth = textureDef.depth;
+
+        // Calculate data size
+        size_t bytesPerPixel = GetBytesPerPixel(textureDef.format);
+        textureData->dataSize = textureDef.width * textureDef.height * textureDef.depth * bytesPerPixel;
+        textureData->pixelData.resize(textureData->dataSize);
+
+        // Generate texture layers
+        std::vector<std::shared_ptr<TextureData>> layerTextures;
+        for (const auto& layer : textureDef.layers) {
+            if (layer.enabled) {
+                auto layerTexture = GenerateLayerTexture(layer, textureDef.width, textureDef.height);
+                if (layerTexture) {
+                    layerTextures.push_back(layerTexture);
+                }
+            }
+        }
+
+        // Composite layers
+        if (!layerTextures.empty()) {
+            // Start with first layer
+            textureData = layerTextures[0];
+
+            // Blend remaining layers
+            for (size_t i = 1; i < layerTextures.size(); ++i) {
+                textureData = BlendTextures(textureData, layerTextures[i],
+                                          textureDef.layers[i].blendMode,
+                                          textureDef.layers[i].opacity);
+            }
+        }
+
+        // Apply global effects
+        if (textureDef.globalColorConfig.saturation != 1.0f ||
+            textureDef.globalColorConfig.brightness != 1.0f ||
+            textureDef.globalColorConfig.contrast != 1.0f) {
+            std::unordered_map<std::string, float> effects;
+            effects["saturation"] = textureDef.globalColorConfig.saturation;
+            effects["brightness"] = textureDef.globalColorConfig.brightness;
+            effects["contrast"] = textureDef.globalColorConfig.contrast;
+            textureData = ApplyTextureEffects(textureData, effects);
+        }
+
+        // Generate mipmaps if requested
+        if (textureDef.useMipmaps) {
+            GenerateMipmaps(textureData);
+        }
+
+        // Compress if requested
+        if (textureDef.useCompression) {
+            CompressTexture(textureData);
+        }
+
+        // Layers replace the texture object, so identify it last
+        textureData->textureId = textureDef.id;
+        textureData->format = textureDef.format;
+        textureData->generatorId = "TextureGenerator";
+        textureData->generationTime = static_cast<uint64_t>(
+            std::chrono::system_clock::now().time_since_epoch().count());
+        textureData->parameters["seed"] = static_cast<float>(seed);
+
+        return textureData;
+    }
+
+    std::shared_ptr<TextureData> TextureGenerator::ProduceTexture(const ProceduralTexture& textureDef, uint32_t seed,
+                                                                bool useDiskCache, bool& fromDisk) {
+        fromDisk = false;
+
+        // Compressed formats are not cached; everything else is plain RGBA8 plus mips
+        const bool cacheable = useDiskCache && m_diskCache && m_diskCache->IsEnabled() &&
+                               textureDef.format == TextureFormat::RGBA8 && !textureDef.useCompression;
+        const uint64_t key = cacheable ? HashTextureDefinition(textureDef, seed) : 0;
+
+        if (cacheable) {
+            TextureDiskCache::Image image;
+            const size_t baseSize = static_cast<size_t>(textureDef.width) * textureDef.height * 4;
+            if (m_diskCache->Load(key, image) && image.width == textureDef.width &&
+                image.height == textureDef.height && image.pixels.size() >= baseSize) {
+                auto textureData = std::make_shared<TextureData>();
+                textureData->textureId = textureDef.id;
+                textureData->format = TextureFormat::RGBA8;
+                textureData->width = image.width;
+                textureData->height = image.height;
+                textureData->depth = textureDef.depth;
+                textureData->generatorId = "TextureDiskCache";
+                textureData->generationTime = static_cast<uint64_t>(
+                    std::chrono::system_clock::now().time_since_epoch().count());
+                textureData->parameters["seed"] = static_cast<float>(seed);
+                textureData->mipmapsGenerated = image.mipLevels > 0 ? image.mipLevels - 1 : 0;
+                textureData->pixelData = std::move(image.pixels);
+                textureData->dataSize = textureData->pixelData.size();
+                fromDisk = true;
+                return textureData;
+            }
+        }
+
+        auto textureData = ComposeTexture(textureDef, seed);
+
+        if (cacheable && textureData) {
+            TextureDiskCache::Image image;
+            image.width = textureData->width;
+            image.height = textureData->height;
+            image.mipLevels = textureData->mipmapsGenerated + 1;
+            image.pixels = textureData->pixelData;
+            m_diskCache->Store(key, image);
+        }
+
+        return textureData;
+    }
+
     uint64_t TextureGenerator::GenerateTextureAsync(const ProceduralTexture& textureDef,
                                                    uint32_t seed,
                                                    std::function<void(std::shared_ptr<TextureData>)> callback) {
@@ -336,6 +472,208 @@ namespace VoxelCraft {
         return GenerateTexture(textureDef);
     }
 
+    std::pair<std::shared_ptr<TextureData>, std::vector<Vec4>> TextureGenerator::GenerateAtlas(
+        const std::vector<std::shared_ptr<TextureData>>& textures, int maxWidth, int maxHeight) {
+        // Shelf packing in input order: tiles fill a row left to right and
+        // the next row starts below the tallest tile of the previous one
+        std::vector<std::pair<int, int>> positions(textures.size(), std::make_pair(-1, -1));
+        int x = 0;
+        int y = 0;
+        int rowHeight = 0;
+        int usedWidth = 1;
+        int usedHeight = 1;
+
+        for (size_t i = 0; i < textures.size(); ++i) {
+            const auto& texture = textures[i];
+            if (!texture || texture->format != TextureFormat::RGBA8 || texture->width > maxWidth) {
+                continue;
+            }
+
+            if (x + texture->width > maxWidth) {
+                x = 0;
+                y += rowHeight;
+                rowHeight = 0;
+            }
+            if (y + texture->height > maxHeight) {
+                Logger::Warning("Texture atlas full at {}x{}, {} of {} tiles placed",
+                               maxWidth, maxHeight, i, textures.size());
+                break;
+            }
+
+            positions[i] = std::make_pair(x, y);
+            x += texture->width;
+            rowHeight = std::max(rowHeight, texture->height);
+            usedWidth = std::max(usedWidth, x);
+            usedHeight = std::max(usedHeight, y + rowHeight);
+        }
+
+        // Power-of-two sides keep power-of-two tiles texel-aligned on every mip level
+        auto atlas = std::make_shared<TextureData>();
+        atlas->textureId = "atlas";
+        atlas->format = TextureFormat::RGBA8;
+        atlas->width = NextPowerOfTwo(usedWidth);
+        atlas->height = NextPowerOfTwo(usedHeight);
+        atlas->depth = 1;
+        atlas->generatorId = "TextureGenerator";
+        atlas->dataSize = static_cast<size_t>(atlas->width) * atlas->height * 4;
+        atlas->pixelData.assign(atlas->dataSize, 0);
+
+        std::vector<Vec4> uvs(textures.size(), Vec4(0.0f, 0.0f, 0.0f, 0.0f));
+        const size_t atlasStride = static_cast<size_t>(atlas->width) * 4;
+        for (size_t i = 0; i < textures.size(); ++i) {
+            if (positions[i].first < 0) {
+                continue;
+            }
+
+            // Only the base level is copied; tile mip chains follow it in pixelData
+            const auto& texture = textures[i];
+            const size_t tileStride = static_cast<size_t>(texture->width) * 4;
+            for (int row = 0; row < texture->height; ++row) {
+                std::memcpy(atlas->pixelData.data() + (positions[i].second + row) * atlasStride + positions[i].first * 4,
+                            texture->pixelData.data() + row * tileStride, tileStride);
+            }
+
+            uvs[i] = Vec4(static_cast<float>(positions[i].first) / atlas->width,
+                          static_cast<float>(positions[i].second) / atlas->height,
+                          static_cast<float>(positions[i].first + texture->width) / atlas->width,
+                          static_cast<float>(positions[i].second + texture->height) / atlas->height);
+        }
+
+        if (GetConfigValue("enableMipmaps") != 0.0f) {
+            GenerateMipmaps(atlas);
+        }
+
+        return std::make_pair(atlas, uvs);
+    }
+
+    std::pair<std::shared_ptr<TextureData>, std::vector<Vec4>> TextureGenerator::BakeAtlas(
+        const std::vector<ProceduralTexture>& definitions, uint32_t seed,
+        ThreadPool* pool, int maxWidth, int maxHeight) {
+        if (!m_initialized) {
+            Logger::Error("TextureGenerator not initialized");
+            return std::make_pair(nullptr, std::vector<Vec4>());
+        }
+
+        auto startTime = std::chrono::high_resolution_clock::now();
+
+        // Random seeds never repeat, so only explicit seeds go through the disk cache;
+        // resolved up front, RandomSeed is not thread-safe
+        const bool useDiskCache = seed != 0;
+        if (seed == 0) {
+            seed = RandomSeed();
+        }
+
+        // One task per tile, each writing only its own slot
+        std::vector<std::shared_ptr<TextureData>> tiles(definitions.size());
+        std::vector<uint8_t> tileFromDisk(definitions.size(), 0);
+        auto bakeTile = [this, &definitions, &tiles, &tileFromDisk, seed, useDiskCache](size_t index) {
+            try {
+                bool fromDisk = false;
+                tiles[index] = ProduceTexture(definitions[index], seed, useDiskCache, fromDisk);
+                tileFromDisk[index] = fromDisk ? 1 : 0;
+            } catch (const std::exception& e) {
+                Logger::Error("Failed to bake atlas tile '{}': {}", definitions[index].id, e.what());
+            }
+        };
+
+        if (pool && pool->IsRunning() && definitions.size() > 1) {
+            std::vector<std::future<void>> futures;
+            futures.reserve(definitions.size());
+            for (size_t i = 0; i < definitions.size(); ++i) {
+                futures.push_back(pool->SubmitTask([&bakeTile, i]() { bakeTile(i); },
+                    ThreadPool::TaskPriority::HIGH, "BakeAtlasTile"));
+            }
+            for (auto& future : futures) {
+                future.get();
+            }
+        } else {
+            for (size_t i = 0; i < definitions.size(); ++i) {
+                bakeTile(i);
+            }
+        }
+
+        int loaded = 0;
+        int generated = 0;
+        int failed = 0;
+        for (size_t i = 0; i < tiles.size(); ++i) {
+            if (!tiles[i]) {
+                failed++;
+            } else if (tileFromDisk[i]) {
+                loaded++;
+            } else {
+                generated++;
+            }
+        }
+
+        auto atlas = GenerateAtlas(tiles, maxWidth, maxHeight);
+
+        auto endTime = std::chrono::high_resolution_clock::now();
+        const float seconds = std::chrono::duration<float>(endTime - startTime).count();
+        const bool warm = generated == 0 && failed == 0;
+
+        // Update statistics
+        m_stats.diskCacheHits += loaded;
+        if (m_diskCache && m_diskCache->IsEnabled()) {
+            m_stats.diskCacheMisses += generated;
+        }
+        m_stats.totalTexturesGenerated += generated;
+        m_stats.failedGenerations += failed;
+        if (warm) {
+            m_stats.warmAtlasBakeTime = seconds;
+        } else {
+            m_stats.coldAtlasBakeTime = seconds;
+        }
+
+        Logger::Info("Baked {}x{} atlas from {} tiles in {:.1f} ms ({}): {} from disk cache, {} generated, {} failed",
+                    atlas.first->width, atlas.first->height, definitions.size(), seconds * 1000.0f,
+                    warm ? "warm" : "cold", loaded, generated, failed);
+
+        return atlas;
+    }
+
+    void TextureGenerator::SetDiskCacheDirectory(const std::string& directory) {
+        m_diskCache = std::make_unique<TextureDiskCache>(directory);
+    }
+
+    uint64_t TextureGenerator::HashTextureDefinition(const ProceduralTexture& textureDef, uint32_t seed) {
+        TextureHasher hasher;
+        hasher.Add(GENERATOR_VERSION).Add(TextureDiskCache::FORMAT_VERSION).Add(seed);
+
+        hasher.Add(static_cast<int32_t>(textureDef.format))
+              .Add(static_cast<int32_t>(textureDef.width))
+              .Add(static_cast<int32_t>(textureDef.height))
+              .Add(static_cast<int32_t>(textureDef.depth))
+              .Add(textureDef.is3D).Add(textureDef.isCubeMap)
+              .Add(textureDef.useMipmaps).Add(textureDef.useCompression)
+              .Add(textureDef.useDithering).Add(static_cast<int32_t>(textureDef.ditherStrength))
+              .Add(static_cast<int32_t>(textureDef.qualityLevel));
+
+        hasher.Add(static_cast<uint64_t>(textureDef.layers.size()));
+        for (const auto& layer : textureDef.layers) {
+            hasher.Add(layer.enabled).Add(layer.opacity).Add(layer.blendMode);
+            AddNoiseConfig(hasher, layer.noiseConfig);
+            AddColorConfig(hasher, layer.colorConfig);
+            AddPatternConfig(hasher, layer.patternConfig);
+            hasher.Add(layer.blurRadius).Add(layer.sharpenStrength)
+                  .Add(layer.normalStrength).Add(layer.displacementStrength)
+                  .Add(layer.useMask).Add(layer.maskThreshold);
+            if (layer.useMask && layer.maskTexture) {
+                hasher.Add(static_cast<uint64_t>(layer.maskTexture->pixelData.size()));
+                hasher.Add(layer.maskTexture->pixelData.data(), layer.maskTexture->pixelData.size());
+            }
+            hasher.Add(layer.animated).Add(layer.animationSpeed);
+            AddVec3(hasher, layer.animationDirection);
+        }
+
+        hasher.Add(static_cast<uint64_t>(textureDef.noiseSources.size()));
+        for (const auto& source : textureDef.noiseSources) {
+            AddNoiseConfig(hasher, source);
+        }
+        AddColorConfig(hasher, textureDef.globalColorConfig);
+
+        return hasher.Get();
+    }
+
     // Block texture generation methods
     void TextureGenerator::GenerateStoneTexture(ProceduralTexture& textureDef) {
         TextureLayer baseLayer;
@@ -1174,10 +1512,20 @@ namespace VoxelCraft {
     }
 
     void TextureGenerator::GenerateMipmaps(std::shared_ptr<TextureData> texture) {
-        // Simple mipmap generation
-        if (texture->width > 1 && texture->height > 1) {
-            texture->pixelData.reserve(texture->pixelData.size() * 2); // Reserve space for mipmaps
+        if (!texture || texture->format != TextureFormat::RGBA8 || texture->depth > 1) {
+            return;
         }
+
+        const size_t baseSize = static_cast<size_t>(texture->width) * texture->height * 4;
+        if (texture->width <= 0 || texture->height <= 0 || texture->pixelData.size() < baseSize) {
+            return;
+        }
+
+        // Levels follow the base in pixelData, each a 2x2 box filter of the one above
+        texture->pixelData.resize(baseSize);
+        uint32_t levels = TextureMipmaps::BuildChainRGBA8(texture->pixelData, texture->width, texture->height);
+        texture->mipmapsGenerated = levels - 1;
+        texture->dataSize = texture->pixelData.size();
     }
 
     void TextureGenerator::CompressTexture(std::shared_ptr<TextureData> texture) {
@@ -1196,6 +1544,10 @@ namespace VoxelCraft {
         ss << "Average generation time: " << m_stats.averageGenerationTime << "s\n";
         ss << "Active generators: " << m_stats.activeGenerators << "\n";
         ss << "Failed generations: " << m_stats.failedGenerations << "\n";
+        ss << "Disk cache hits: " << m_stats.diskCacheHits << "\n";
+        ss << "Disk cache misses: " << m_stats.diskCacheMisses << "\n";
+        ss << "Atlas bake time (cold/warm): " << m_stats.coldAtlasBakeTime << "s / "
+           << m_stats.warmAtlasBakeTime << "s\n";
         return ss.str();
     }
 
@@ -21,12 +21,14 @@
 #include "../math/Vec2.hpp"
 #include "../math/Color.hpp"
 #include "../math/Noise.hpp"
+#include "TextureDiskCache.hpp"
 
 namespace VoxelCraft {
 
     // Forward declarations
     class World;
     class Block;
+    class ThreadPool;
     struct TextureConfig;
     struct TextureData;
     struct NoiseConfig;
@@ -304,6 +306,12 @@ namespace VoxelCraft {
         int activeGenerators = 0;
         int queuedGenerations = 0;
         int failedGenerations = 0;
+
+        // Disk cache and atlas baking
+        int diskCacheHits = 0;
+        int diskCacheMisses = 0;
+        float coldAtlasBakeTime = 0.0f;     ///< Last bake that had to generate tiles (seconds)
+        float warmAtlasBakeTime = 0.0f;     ///< Last bake served entirely from the disk cache (seconds)
     };
 
     /**
@@ -519,6 +527,39 @@ namespace VoxelCraft {
             const std::vector<std::shared_ptr<TextureData>>& textures,
             int maxWidth = 2048, int maxHeight = 2048);
 
+        /**
+         * @brief Generate texture definitions straight into an atlas, one task per tile
+         *
+         * Each task generates (or loads from the disk cache) one tile and
+         * touches nothing else; the atlas and its mip chain are assembled
+         * once every tile is done. Bake time is recorded as cold or warm
+         * in the statistics depending on whether any tile was generated.
+         * @param definitions Tile definitions (RGBA8)
+         * @param seed Seed shared by every tile (0 picks one)
+         * @param pool Worker pool, nullptr bakes on the calling thread
+         * @param maxWidth Maximum atlas width
+         * @param maxHeight Maximum atlas height
+         * @return Atlas texture and UV rectangles (u0, v0, u1, v1) in definition order
+         */
+        std::pair<std::shared_ptr<TextureData>, std::vector<Vec4>> BakeAtlas(
+            const std::vector<ProceduralTexture>& definitions, uint32_t seed,
+            ThreadPool* pool = nullptr, int maxWidth = 2048, int maxHeight = 2048);
+
+        /**
+         * @brief Set the on-disk cache of generated textures
+         * @param directory Cache root; empty disables the cache
+         */
+        void SetDiskCacheDirectory(const std::string& directory);
+
+        /**
+         * @brief Content hash of a definition and seed, used as the disk cache key
+         *
+         * Covers everything that affects the pixels (size, format, layers,
+         * global color settings, mipmaps, seed) and the generator version,
+         * but not ids, names or metadata, so identical textures share an entry.
+         */
+        static uint64_t HashTextureDefinition(const ProceduralTexture& textureDef, uint32_t seed);
+
         /**
          * @brief Generate animated texture
          * @param baseTexture Base texture
@@ -590,7 +631,13 @@ namespace VoxelCraft {
         TextureGenerator(const TextureGenerator&) = delete;
         TextureGenerator& operator=(const TextureGenerator&) = delete;
 
+        /// Bumped whenever generation code changes what a definition produces
+        static constexpr uint32_t GENERATOR_VERSION = 1;
+
         // Core generation methods
+        std::shared_ptr<TextureData> ComposeTexture(const ProceduralTexture& textureDef, uint32_t seed);
+        std::shared_ptr<TextureData> ProduceTexture(const ProceduralTexture& textureDef, uint32_t seed,
+                                                    bool useDiskCache, bool& fromDisk);
         std::shared_ptr<TextureData> GenerateNoiseTexture(const NoiseConfig& config, int width, int height);
         std::shared_ptr<TextureData> GeneratePatternTexture(const PatternConfig& config, int width, int height);
         std::shared_ptr<TextureData> GenerateColorTexture(const ColorConfig& config, int width, int height);
@@ -615,6 +662,7 @@ namespace VoxelCraft {
         std::shared_ptr<TextureData> ApplySharpen(std::shared_ptr<TextureData> texture, float strength);
         std::shared_ptr<TextureData> ApplyNormalMap(std::shared_ptr<TextureData> texture, float strength);
         std::shared_ptr<TextureData> ApplyDisplacement(std::shared_ptr<TextureData> texture, float strength);
+        void GenerateMipmaps(std::shared_ptr<TextureData> texture);
 
         // Utility methods
         Color SampleColor(const ColorConfig& config, float x, float y, float noiseValue) const;
@@ -634,6 +682,7 @@ namespace VoxelCraft {
         // Texture library
         std::unordered_map<std::string, ProceduralTexture> m_texturePresets;
         std::unordered_map<std::string, std::shared_ptr<TextureData>> m_textureCache;
+        std::unique_ptr<TextureDiskCache> m_diskCache;
 
         // Generation state
         std::unordered_map<std::string, float> m_config;
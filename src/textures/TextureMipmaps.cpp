@@ -0,0 +1,155 @@
+/**
+ * @file TextureMipmaps.cpp
+ * @brief VoxelCraft Texture Mipmaps Implementation
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#include "TextureMipmaps.hpp"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define VOXELCRAFT_MIPMAPS_SSE2 1
+#else
+    #define VOXELCRAFT_MIPMAPS_SSE2 0
+#endif
+
+namespace VoxelCraft {
+namespace TextureMipmaps {
+
+    namespace {
+
+        inline void FilterPixel(const uint8_t* row0, const uint8_t* row1, int x0, int x1, uint8_t* out) {
+            const uint8_t* a = row0 + x0 * 4;
+            const uint8_t* b = row0 + x1 * 4;
+            const uint8_t* c = row1 + x0 * 4;
+            const uint8_t* d = row1 + x1 * 4;
+            for (int channel = 0; channel < 4; ++channel) {
+                out[channel] = static_cast<uint8_t>((a[channel] + b[channel] + c[channel] + d[channel] + 2) >> 2);
+            }
+        }
+
+        inline void FilterRowScalar(const uint8_t* row0, const uint8_t* row1, int width,
+                                    int fromX, int dstWidth, uint8_t* dst) {
+            for (int x = fromX; x < dstWidth; ++x) {
+                int x0 = std::min(2 * x, width - 1);
+                int x1 = std::min(2 * x + 1, width - 1);
+                FilterPixel(row0, row1, x0, x1, dst + x * 4);
+            }
+        }
+
+#if VOXELCRAFT_MIPMAPS_SSE2
+        /**
+         * @brief Four output pixels from eight source pixels of two rows
+         */
+        inline void FilterFourSse2(const uint8_t* row0, const uint8_t* row1, uint8_t* dst) {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i bias = _mm_set1_epi16(2);
+
+            __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0));
+            __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + 16));
+            __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1));
+            __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + 16));
+
+            // Vertical sums, two source pixels per register in 16-bit lanes
+            __m128i s01 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(a1, zero));
+            __m128i s23 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(a1, zero));
+            __m128i s45 = _mm_add_epi16(_mm_unpacklo_epi8(b0, zero), _mm_unpacklo_epi8(b1, zero));
+            __m128i s67 = _mm_add_epi16(_mm_unpackhi_epi8(b0, zero), _mm_unpackhi_epi8(b1, zero));
+
+            // Horizontal pairs land in the low half
+            __m128i h01 = _mm_add_epi16(s01, _mm_srli_si128(s01, 8));
+            __m128i h23 = _mm_add_epi16(s23, _mm_srli_si128(s23, 8));
+            __m128i h45 = _mm_add_epi16(s45, _mm_srli_si128(s45, 8));
+            __m128i h67 = _mm_add_epi16(s67, _mm_srli_si128(s67, 8));
+
+            __m128i lo = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(h01, h23), bias), 2);
+            __m128i hi = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(h45, h67), bias), 2);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(lo, hi));
+        }
+#endif
+
+    } // namespace
+
+    uint32_t LevelCount(int width, int height) {
+        uint32_t levels = 1;
+        while (width > 1 || height > 1) {
+            width = std::max(1, width / 2);
+            height = std::max(1, height / 2);
+            ++levels;
+        }
+        return levels;
+    }
+
+    size_t ChainSize(int width, int height) {
+        size_t size = static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+        while (width > 1 || height > 1) {
+            width = std::max(1, width / 2);
+            height = std::max(1, height / 2);
+            size += static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+        }
+        return size;
+    }
+
+    void DownsampleRGBA8Scalar(const uint8_t* src, int width, int height, uint8_t* dst) {
+        const int dstWidth = std::max(1, width / 2);
+        const int dstHeight = std::max(1, height / 2);
+        const size_t stride = static_cast<size_t>(width) * 4;
+
+        for (int y = 0; y < dstHeight; ++y) {
+            const uint8_t* row0 = src + static_cast<size_t>(std::min(2 * y, height - 1)) * stride;
+            const uint8_t* row1 = src + static_cast<size_t>(std::min(2 * y + 1, height - 1)) * stride;
+            FilterRowScalar(row0, row1, width, 0, dstWidth, dst + static_cast<size_t>(y) * static_cast<size_t>(dstWidth) * 4);
+        }
+    }
+
+    void DownsampleRGBA8(const uint8_t* src, int width, int height, uint8_t* dst) {
+#if VOXELCRAFT_MIPMAPS_SSE2
+        const int dstWidth = std::max(1, width / 2);
+        const int dstHeight = std::max(1, height / 2);
+        const size_t stride = static_cast<size_t>(width) * 4;
+
+        // Output pixels whose two source columns are both inside the row
+        const int vectorWidth = (width / 2) & ~3;
+
+        for (int y = 0; y < dstHeight; ++y) {
+            const uint8_t* row0 = src + static_cast<size_t>(std::min(2 * y, height - 1)) * stride;
+            const uint8_t* row1 = src + static_cast<size_t>(std::min(2 * y + 1, height - 1)) * stride;
+            uint8_t* out = dst + static_cast<size_t>(y) * static_cast<size_t>(dstWidth) * 4;
+
+            int x = 0;
+            for (; x < vectorWidth; x += 4) {
+                FilterFourSse2(row0 + x * 8, row1 + x * 8, out + x * 4);
+            }
+            FilterRowScalar(row0, row1, width, x, dstWidth, out);
+        }
+#else
+        DownsampleRGBA8Scalar(src, width, height, dst);
+#endif
+    }
+
+    uint32_t BuildChainRGBA8(std::vector<uint8_t>& pixels, int width, int height) {
+        pixels.resize(ChainSize(width, height));
+
+        uint32_t levels = 1;
+        size_t offset = 0;
+        while (width > 1 || height > 1) {
+            const size_t levelSize = static_cast<size_t>(width) * static_cast<size_t>(height) * 4;
+            DownsampleRGBA8(pixels.data() + offset, width, height, pixels.data() + offset + levelSize);
+
+            offset += levelSize;
+            width = std::max(1, width / 2);
+            height = std::max(1, height / 2);
+            ++levels;
+        }
+        return levels;
+    }
+
+    bool IsVectorized() {
+        return VOXELCRAFT_MIPMAPS_SSE2 != 0;
+    }
+
+} // namespace TextureMipmaps
+} // namespace VoxelCraft
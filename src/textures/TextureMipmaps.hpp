@@ -0,0 +1,58 @@
+/**
+ * @file TextureMipmaps.hpp
+ * @brief VoxelCraft Texture Mipmaps - 2x2 box filter mip chains for RGBA8 images
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * Each level averages 2x2 blocks of the level above with round-to-nearest:
+ * (a + b + c + d + 2) >> 2 per channel. Odd edges reuse the last row or
+ * column. The SSE2 path filters four output pixels per step with 16-bit
+ * lanes and produces exactly the same bytes as the scalar path.
+ */
+
+#ifndef VOXELCRAFT_TEXTURES_TEXTURE_MIPMAPS_HPP
+#define VOXELCRAFT_TEXTURES_TEXTURE_MIPMAPS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace VoxelCraft {
+namespace TextureMipmaps {
+
+    /**
+     * @brief Number of levels down to 1x1, including the base level
+     */
+    uint32_t LevelCount(int width, int height);
+
+    /**
+     * @brief Bytes of a full RGBA8 chain, base level included
+     */
+    size_t ChainSize(int width, int height);
+
+    /**
+     * @brief Halve an RGBA8 image into dst (max(1, width / 2) x max(1, height / 2))
+     */
+    void DownsampleRGBA8(const uint8_t* src, int width, int height, uint8_t* dst);
+
+    /**
+     * @brief Reference implementation of DownsampleRGBA8, one channel at a time
+     */
+    void DownsampleRGBA8Scalar(const uint8_t* src, int width, int height, uint8_t* dst);
+
+    /**
+     * @brief Append every level below the base to an RGBA8 image
+     * @param pixels Base level on input; base followed by each smaller level on output
+     * @return Number of levels, base included
+     */
+    uint32_t BuildChainRGBA8(std::vector<uint8_t>& pixels, int width, int height);
+
+    /**
+     * @brief Whether DownsampleRGBA8 uses the SSE2 path on this build
+     */
+    bool IsVectorized();
+
+} // namespace TextureMipmaps
+} // namespace VoxelCraft
+
+#endif // VOXELCRAFT_TEXTURES_TEXTURE_MIPMAPS_HPP
@@ -7,6 +7,7 @@
 
 #include "Chunk.hpp"
 #include "../blocks/Block.hpp"
+#include "LightPropagator.hpp"
 #include "../entities/RenderComponent.hpp"
 #include "../entities/TransformComponent.hpp"
 #include "../entities/Entity.hpp"
@@ -24,9 +25,8 @@ namespace VoxelCraft {
         , m_isModified(false)
         , m_solidBlockCount(0)
     {
-        // Initialize all blocks to air
-        m_blocks.fill(BlockType::AIR);
-        m_lightLevels.fill(15); // Full sky light initially
+        // Sections start uniformly air and allocate nothing until written;
+        // light storage starts at full sky light
         m_biomes.fill("plains"); // Default biome
 
         VOXELCRAFT_TRACE("Chunk created at position ({}, {})", position.x, position.z);
@@ -41,8 +41,8 @@ namespace VoxelCraft {
             return BlockType::AIR;
         }
 
-        std::lock_guard<std::mutex> lock(m_chunkMutex);
-        return m_blocks[pos.toIndex()];
+        // Lock-free: section storage publishes buffers atomically
+        return static_cast<BlockType>(m_blocks.Get(pos.x, pos.y, pos.z));
     }
 
     bool Chunk::SetBlock(const BlockPosition& pos, BlockType type) {
@@ -50,25 +50,23 @@ namespace VoxelCraft {
             return false;
         }
 
-        std::lock_guard<std::mutex> lock(m_chunkMutex);
-
-        size_t index = pos.toIndex();
-        BlockType oldType = m_blocks[index];
+        // Writers serialize per section; the storage keeps per-section solid
+        // counts from BlockPropertyTable, no Block instances are created
+        m_blocks.Set(pos.x, pos.y, pos.z, static_cast<uint16_t>(type));
+        UpdateSolidBlockCount();
+        m_isModified = true;
 
-        // Update solid block count
-        bool wasSolid = Block::CreateBlock(oldType)->IsSolid();
-        bool isSolid = Block::CreateBlock(type)->IsSolid();
+        return true;
+    }
 
-        if (wasSolid && !isSolid) {
-            m_solidBlockCount--;
-        } else if (!wasSolid && isSolid) {
-            m_solidBlockCount++;
-        }
+    uint16_t Chunk::GetBlockId(uint8_t x, uint8_t y, uint8_t z) const {
+        return m_blocks.Get(x, y, z);
+    }
 
-        m_blocks[index] = type;
+    void Chunk::SetBlockId(uint8_t x, uint8_t y, uint8_t z, uint16_t blockId) {
+        m_blocks.Set(x, y, z, blockId);
+        UpdateSolidBlockCount();
         m_isModified = true;
-
-        return true;
     }
 
     BlockType Chunk::GetBlockAt(int worldX, int worldY, int worldZ) const {
@@ -124,10 +122,14 @@ namespace VoxelCraft {
         PlaceVegetation(seed);
 
         SetState(ChunkState::GENERATED);
+
+        // Nobody reads a generating chunk, so shrink palettes and free the
+        // buffers retired while generation grew them
+        m_blocks.Compact();
         UpdateSolidBlockCount();
 
         VOXELCRAFT_INFO("Terrain generated for chunk ({}, {}), {} solid blocks",
-                       m_position.x, m_position.z, m_solidBlockCount);
+                       m_position.x, m_position.z, m_solidBlockCount.load(std::memory_order_relaxed));
 
         return true;
     }
@@ -157,14 +159,10 @@ namespace VoxelCraft {
 
         SetState(ChunkState::LIGHTING);
 
-        // Calculate sky light
-        CalculateSkyLight();
-
-        // Calculate block light
-        CalculateBlockLight();
-
-        // Propagate light
-        PropagateLight();
+        // Sky column pass plus BFS flood fill; without a ChunkSystem the
+        // chunk is lit in isolation and borders are fixed up on insertion
+        LightPropagator propagator;
+        propagator.RelightChunk(this);
 
         SetState(ChunkState::LIGHTED);
 
@@ -177,8 +175,9 @@ namespace VoxelCraft {
             return 15; // Full light outside chunk
         }
 
-        std::lock_guard<std::mutex> lock(m_chunkMutex);
-        return m_lightLevels[pos.toIndex()];
+        // Lock-free: light nibbles are atomic
+        const uint32_t index = ChunkLightStorage::GetIndex(pos.x, pos.y, pos.z);
+        return std::max(m_lighting.GetSky(index), m_lighting.GetBlock(index));
     }
 
     void Chunk::SetLightLevel(const BlockPosition& pos, uint8_t level) {
@@ -186,8 +185,23 @@ namespace VoxelCraft {
             return;
         }
 
-        std::lock_guard<std::mutex> lock(m_chunkMutex);
-        m_lightLevels[pos.toIndex()] = level;
+        m_lighting.SetBlock(ChunkLightStorage::GetIndex(pos.x, pos.y, pos.z), level);
+    }
+
+    uint8_t Chunk::GetLightLevel(uint8_t x, uint8_t y, uint8_t z) const {
+        return m_lighting.GetBlock(ChunkLightStorage::GetIndex(x, y, z));
+    }
+
+    void Chunk::SetLightLevel(uint8_t x, uint8_t y, uint8_t z, uint8_t level) {
+        m_lighting.SetBlock(ChunkLightStorage::GetIndex(x, y, z), level);
+    }
+
+    uint8_t Chunk::GetSkyLight(uint8_t x, uint8_t y, uint8_t z) const {
+        return m_lighting.GetSky(ChunkLightStorage::GetIndex(x, y, z));
+    }
+
+    void Chunk::SetSkyLight(uint8_t x, uint8_t y, uint8_t z, uint8_t level) {
+        m_lighting.SetSky(ChunkLightStorage::GetIndex(x, y, z), level);
     }
 
     std::string Chunk::GetBiome(const BlockPosition& pos) const {
@@ -210,16 +224,67 @@ namespace VoxelCraft {
 
     void Chunk::Clear() {
         std::lock_guard<std::mutex> lock(m_chunkMutex);
-        m_blocks.fill(BlockType::AIR);
-        m_lightLevels.fill(15);
+        m_blocks.Fill(static_cast<uint16_t>(BlockType::AIR));
+        m_blocks.ReclaimRetired();
+        m_lighting.Fill(ChunkLightStorage::MAX_LIGHT, 0);
+        m_isModified = false;
+        m_solidBlockCount.store(0, std::memory_order_relaxed);
+    }
+
+    namespace {
+
+        constexpr uint32_t CHUNK_DATA_MAGIC = 0x4B434356; // "VCCK"
+        constexpr uint16_t CHUNK_DATA_VERSION = 1;
+
+    } // namespace
+
+    std::vector<uint8_t> Chunk::Serialize() const {
+        // Magic and version, then the palette-compressed sections as stored
+        std::vector<uint8_t> data;
+        data.reserve(4096);
+
+        for (int shift = 0; shift < 32; shift += 8) {
+            data.push_back(static_cast<uint8_t>(CHUNK_DATA_MAGIC >> shift));
+        }
+        data.push_back(static_cast<uint8_t>(CHUNK_DATA_VERSION & 0xFF));
+        data.push_back(static_cast<uint8_t>(CHUNK_DATA_VERSION >> 8));
+
+        m_blocks.Serialize(data);
+        return data;
+    }
+
+    bool Chunk::Deserialize(const std::vector<uint8_t>& data) {
+        return Deserialize(data.data(), data.size());
+    }
+
+    bool Chunk::Deserialize(const uint8_t* data, size_t size) {
+        constexpr size_t HEADER_SIZE = 6;
+
+        if (size < HEADER_SIZE ||
+            (data[0] | (data[1] << 8) | (data[2] << 16) | (static_cast<uint32_t>(data[3]) << 24)) != CHUNK_DATA_MAGIC ||
+            (data[4] | (data[5] << 8)) != CHUNK_DATA_VERSION) {
+            VOXELCRAFT_ERROR("Invalid chunk data header for chunk ({}, {})", m_position.x, m_position.z);
+            return false;
+        }
+
+        if (m_blocks.Deserialize(data + HEADER_SIZE, size - HEADER_SIZE) == 0) {
+            VOXELCRAFT_ERROR("Corrupt block data for chunk ({}, {})", m_position.x, m_position.z);
+            return false;
+        }
+
+        // Light is not stored; the lighting stage rebuilds it
+        std::lock_guard<std::mutex> lock(m_chunkMutex);
+        m_blocks.ReclaimRetired();
+        m_lighting.Fill(ChunkLightStorage::MAX_LIGHT, 0);
+        m_solidBlockCount.store(m_blocks.GetSolidBlockCount(), std::memory_order_relaxed);
         m_isModified = false;
-        m_solidBlockCount = 0;
+        return true;
     }
 
     size_t Chunk::GetMemoryUsage() const {
         return sizeof(Chunk) +
-               m_blocks.size() * sizeof(BlockType) +
-               m_lightLevels.size() * sizeof(uint8_t) +
+               m_blocks.GetMemoryUsage() +
+               m_lighting.GetMemoryUsage() +
                m_biomes.size() * sizeof(std::string);
     }
 
@@ -440,109 +505,8 @@ namespace VoxelCraft {
         }
     }
 
-    void Chunk::CalculateSkyLight() {
-        for (uint8_t x = 0; x < CHUNK_SIZE; ++x) {
-            for (uint8_t z = 0; z < CHUNK_SIZE; ++z) {
-                uint8_t lightLevel = 15; // Full sky light
-
-                // Find first solid block from top
-                for (uint8_t y = CHUNK_HEIGHT - 1; y > 0; --y) {
-                    BlockType block = GetBlock(BlockPosition(x, y, z));
-                    auto blockPtr = Block::CreateBlock(block);
-
-                    if (blockPtr->IsSolid()) {
-                        break; // Block blocks light
-                    }
-
-                    SetLightLevel(BlockPosition(x, y, z), lightLevel);
-                }
-
-                // Set light level for the blocking block (if any)
-                for (uint8_t y = CHUNK_HEIGHT - 1; y > 0; --y) {
-                    BlockType block = GetBlock(BlockPosition(x, y, z));
-                    auto blockPtr = Block::CreateBlock(block);
-
-                    if (blockPtr->IsSolid()) {
-                        SetLightLevel(BlockPosition(x, y, z), 0); // No light inside solid blocks
-                        break;
-                    }
-                }
-            }
-        }
-    }
-
-    void Chunk::CalculateBlockLight() {
-        // Find light sources and set their light levels
-        for (uint8_t x = 0; x < CHUNK_SIZE; ++x) {
-            for (uint8_t y = 0; y < CHUNK_HEIGHT; ++y) {
-                for (uint8_t z = 0; z < CHUNK_SIZE; ++z) {
-                    BlockType block = GetBlock(BlockPosition(x, y, z));
-                    auto blockPtr = Block::CreateBlock(block);
-
-                    if (blockPtr->GetLightLevel() > 0) {
-                        SetLightLevel(BlockPosition(x, y, z), blockPtr->GetLightLevel());
-                    }
-                }
-            }
-        }
-    }
-
-    void Chunk::PropagateLight() {
-        // Simple light propagation (could be optimized with flood fill)
-        bool changed = true;
-        int iterations = 0;
-        const int maxIterations = 15; // Max light level
-
-        while (changed && iterations < maxIterations) {
-            changed = false;
-            iterations++;
-
-            for (uint8_t x = 0; x < CHUNK_SIZE; ++x) {
-                for (uint8_t y = 0; y < CHUNK_HEIGHT; ++y) {
-                    for (uint8_t z = 0; z < CHUNK_SIZE; ++z) {
-                        BlockPosition pos(x, y, z);
-                        uint8_t currentLight = GetLightLevel(pos);
-
-                        if (currentLight <= 1) {
-                            continue; // Can't propagate further
-                        }
-
-                        auto blockPtr = Block::CreateBlock(GetBlock(pos));
-                        uint8_t lightReduction = static_cast<uint8_t>(blockPtr->GetLightOpacity());
-
-                        // Check neighbors
-                        std::vector<BlockPosition> neighbors = {
-                            BlockPosition(std::max(0, x-1), y, z),
-                            BlockPosition(std::min(15, x+1), y, z),
-                            BlockPosition(x, std::max(0, y-1), z),
-                            BlockPosition(x, std::min(15, y+1), z),
-                            BlockPosition(x, y, std::max(0, z-1)),
-                            BlockPosition(x, y, std::min(15, z+1))
-                        };
-
-                        for (const auto& neighbor : neighbors) {
-                            uint8_t neighborLight = GetLightLevel(neighbor);
-                            uint8_t newLight = currentLight - lightReduction;
-
-                            if (newLight > neighborLight) {
-                                SetLightLevel(neighbor, newLight);
-                                changed = true;
-                            }
-                        }
-                    }
-                }
-            }
-        }
-    }
-
     void Chunk::UpdateSolidBlockCount() {
-        m_solidBlockCount = 0;
-        for (const auto& block : m_blocks) {
-            auto blockPtr = Block::CreateBlock(block);
-            if (blockPtr->IsSolid()) {
-                m_solidBlockCount++;
-            }
-        }
+        m_solidBlockCount.store(m_blocks.GetSolidBlockCount(), std::memory_order_relaxed);
     }
 
 } // namespace VoxelCraft
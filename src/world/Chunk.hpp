@@ -7,6 +7,8 @@
 #include <cstdint>
 #include "core/Logger.hpp"
 #include "world/ChunkSystem.hpp"
+#include "world/ChunkSection.hpp"
+#include "world/ChunkLightStorage.hpp"
 
 namespace VoxelCraft {
 
@@ -118,6 +120,21 @@ namespace VoxelCraft {
 		 */
 		void SetSkyLight(uint8_t x, uint8_t y, uint8_t z, uint8_t level);
 
+		/**
+		 * @brief Get block storage (read-only, lock-free)
+		 */
+		const ChunkBlockStorage& GetBlockStorage() const { return m_blocks; }
+
+		/**
+		 * @brief Get light storage, written by LightPropagator
+		 */
+		ChunkLightStorage& GetLightStorage() { return m_lighting; }
+
+		/**
+		 * @brief Get light storage (read-only)
+		 */
+		const ChunkLightStorage& GetLightStorage() const { return m_lighting; }
+
 		/**
 		 * @brief Get biome at coordinates
 		 */
@@ -168,6 +185,13 @@ namespace VoxelCraft {
 		 */
 		bool Deserialize(const std::vector<uint8_t>& data);
 
+		/**
+		 * @brief Deserialize chunk data in place (e.g. from a mapped region file)
+		 *
+		 * Light is reset to full sky light; the chunk must be relit.
+		 */
+		bool Deserialize(const uint8_t* data, size_t size);
+
 		/**
 		 * @brief Render the chunk
 		 */
@@ -227,12 +251,12 @@ namespace VoxelCraft {
 		mutable std::mutex m_dataMutex;
 
 		// Block data storage (16x256x16 = 65,536 blocks)
-		// Using uint16_t for block IDs to support up to 65,536 different block types
-		std::unique_ptr<uint16_t[]> m_blocks;
+		// Sixteen palette-compressed 16x16x16 sections with lock-free reads
+		ChunkBlockStorage m_blocks;
 
 		// Lighting data (4 bits per level, packed as uint8_t)
 		// Lower 4 bits: block light, Upper 4 bits: sky light
-		std::unique_ptr<uint8_t[]> m_lighting;
+		ChunkLightStorage m_lighting;
 
 		// Height map (16x16)
 		std::unique_ptr<uint8_t[]> m_heightMap;
@@ -248,8 +272,9 @@ namespace VoxelCraft {
 		uint32_t m_vertexBufferObject;
 		uint32_t m_indexBufferObject;
 
-		// Statistics
-		uint32_t m_solidBlockCount;
+		// Statistics; the solid count is refreshed by writers in different
+		// sections concurrently
+		std::atomic<uint32_t> m_solidBlockCount;
 		uint32_t m_airBlockCount;
 		uint32_t m_transparentBlockCount;
 
@@ -273,11 +298,6 @@ namespace VoxelCraft {
 		 */
 		void CalculateLighting();
 
-		/**
-		 * @brief Propagate light
-		 */
-		void PropagateLight();
-
 		/**
 		 * @brief Update height map
 		 */
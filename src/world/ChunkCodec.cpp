@@ -0,0 +1,782 @@
+#include "ChunkCodec.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+
+#ifdef VOXELCRAFT_LZ4_ENABLED
+#include <lz4.h>
+#endif
+#ifdef VOXELCRAFT_ZLIB_ENABLED
+#include <zlib.h>
+#endif
+#ifdef VOXELCRAFT_ZSTD_ENABLED
+#include <zstd.h>
+#endif
+
+namespace VoxelCraft {
+
+	namespace {
+
+		// ------------------------------------------------------------------
+		// Statistics
+		// ------------------------------------------------------------------
+
+		struct CodecCounters
+		{
+			std::atomic<uint64_t> compressions{ 0 };
+			std::atomic<uint64_t> decompressions{ 0 };
+			std::atomic<uint64_t> rawBytes{ 0 };
+			std::atomic<uint64_t> compressedBytes{ 0 };
+			std::atomic<uint64_t> compressNanoseconds{ 0 };
+			std::atomic<uint64_t> decompressedBytes{ 0 };
+			std::atomic<uint64_t> decompressNanoseconds{ 0 };
+		};
+
+		std::array<CodecCounters, CHUNK_CODEC_COUNT> g_counters;
+
+		uint64_t ElapsedNanoseconds(std::chrono::steady_clock::time_point start)
+		{
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - start).count());
+		}
+
+		// ------------------------------------------------------------------
+		// NONE
+		// ------------------------------------------------------------------
+
+		class StoredCodec : public ChunkCodec
+		{
+		public:
+			ChunkCodecType GetType() const override { return ChunkCodecType::NONE; }
+			const char* GetName() const override { return "none"; }
+			int GetFastLevel() const override { return 0; }
+			int GetHighRatioLevel() const override { return 0; }
+			size_t GetMaxCompressedSize(size_t size) const override { return size; }
+
+			size_t Compress(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity, int) const override
+			{
+				if (capacity < size) {
+					return 0;
+				}
+				std::memcpy(dst, src, size);
+				return size;
+			}
+
+			bool Decompress(const uint8_t* src, size_t size, uint8_t* dst, size_t rawSize) const override
+			{
+				if (size != rawSize) {
+					return false;
+				}
+				std::memcpy(dst, src, size);
+				return true;
+			}
+		};
+
+		// ------------------------------------------------------------------
+		// LZ4 block format
+		// ------------------------------------------------------------------
+
+#ifndef VOXELCRAFT_LZ4_ENABLED
+		constexpr size_t LZ4_MIN_MATCH = 4;
+		constexpr size_t LZ4_LAST_LITERALS = 5;     // Block must end in literals
+		constexpr size_t LZ4_MATCH_LIMIT = 12;      // Last match starts before this
+		constexpr uint32_t LZ4_HASH_BITS = 14;
+		constexpr size_t LZ4_MAX_OFFSET = 65535;
+
+		uint32_t Read32(const uint8_t* p)
+		{
+			uint32_t value;
+			std::memcpy(&value, p, sizeof(value));
+			return value;
+		}
+
+		uint32_t HashSequence(uint32_t sequence)
+		{
+			return (sequence * 2654435761u) >> (32 - LZ4_HASH_BITS);
+		}
+
+		uint8_t* WriteLength(uint8_t* op, size_t length)
+		{
+			while (length >= 255) {
+				*op++ = 255;
+				length -= 255;
+			}
+			*op++ = static_cast<uint8_t>(length);
+			return op;
+		}
+
+		using Lz4HashTable = std::array<uint32_t, 1u << LZ4_HASH_BITS>;
+
+		/**
+		 * @brief Greedy single-pass LZ4 compressor (hash of 4-byte sequences)
+		 *
+		 * Compresses window[prefixSize, prefixSize + size). The first
+		 * prefixSize bytes are a dictionary that matches may reach back
+		 * into. The table holds window positions and is either cleared or
+		 * seeded with the dictionary by the caller.
+		 */
+		size_t Lz4CompressWindow(const uint8_t* window, size_t prefixSize, size_t size, uint8_t* dst, size_t capacity,
+			Lz4HashTable& table)
+		{
+			// Positions are only hints; every candidate is verified
+			const uint8_t* const src = window + prefixSize;
+			const uint8_t* ip = src;
+			const uint8_t* anchor = src;
+			const uint8_t* const iend = src + size;
+			uint8_t* op = dst;
+			uint8_t* const oend = dst + capacity;
+
+			auto emit = [&](const uint8_t* literalEnd, size_t offset, size_t matchLength) -> bool {
+				const size_t literals = static_cast<size_t>(literalEnd - anchor);
+				const size_t worst = 1 + literals / 255 + 1 + literals + 2 + matchLength / 255 + 1;
+				if (static_cast<size_t>(oend - op) < worst) {
+					return false;
+				}
+
+				uint8_t* token = op++;
+				*token = static_cast<uint8_t>((literals >= 15 ? 15 : literals) << 4);
+				if (literals >= 15) {
+					op = WriteLength(op, literals - 15);
+				}
+				std::memcpy(op, anchor, literals);
+				op += literals;
+
+				if (matchLength == 0) {
+					return true;                        // Final literal run
+				}
+
+				*op++ = static_cast<uint8_t>(offset & 0xFF);
+				*op++ = static_cast<uint8_t>(offset >> 8);
+				const size_t extra = matchLength - LZ4_MIN_MATCH;
+				*token |= static_cast<uint8_t>(extra >= 15 ? 15 : extra);
+				if (extra >= 15) {
+					op = WriteLength(op, extra - 15);
+				}
+				return true;
+			};
+
+			if (size > LZ4_MATCH_LIMIT) {
+				const uint8_t* const mflimit = iend - LZ4_MATCH_LIMIT;
+				const uint8_t* const matchlimit = iend - LZ4_LAST_LITERALS;
+
+				while (ip < mflimit) {
+					const uint32_t sequence = Read32(ip);
+					const uint32_t hash = HashSequence(sequence);
+					const uint8_t* ref = window + table[hash];
+					table[hash] = static_cast<uint32_t>(ip - window);
+
+					if (ref >= ip || static_cast<size_t>(ip - ref) > LZ4_MAX_OFFSET || Read32(ref) != sequence) {
+						// Skip faster through incompressible stretches
+						ip += 1 + (static_cast<size_t>(ip - anchor) >> 6);
+						continue;
+					}
+
+					while (ip > anchor && ref > window && ip[-1] == ref[-1]) {
+						--ip;
+						--ref;
+					}
+
+					size_t matchLength = LZ4_MIN_MATCH;
+					while (ip + matchLength < matchlimit && ip[matchLength] == ref[matchLength]) {
+						++matchLength;
+					}
+
+					if (!emit(ip, static_cast<size_t>(ip - ref), matchLength)) {
+						return 0;
+					}
+
+					ip += matchLength;
+					anchor = ip;
+					if (ip < mflimit) {
+						table[HashSequence(Read32(ip - 2))] = static_cast<uint32_t>(ip - 2 - window);
+					}
+				}
+			}
+
+			if (!emit(iend, 0, 0)) {
+				return 0;
+			}
+			return static_cast<size_t>(op - dst);
+		}
+
+		size_t Lz4Compress(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity)
+		{
+			thread_local Lz4HashTable table;
+			table.fill(0);
+			return Lz4CompressWindow(src, 0, size, dst, capacity, table);
+		}
+
+		/**
+		 * @brief Compress with a dictionary as the window prefix
+		 *
+		 * The thread keeps the last dictionary's bytes and its seeded hash
+		 * table, so a repeated dictionary costs two copies instead of
+		 * rehashing it for every chunk.
+		 */
+		size_t Lz4CompressWithPrefix(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity,
+			const uint8_t* dictionary, size_t dictionarySize)
+		{
+			// Only the last 64 KiB of a dictionary is reachable
+			if (dictionarySize > LZ4_MAX_OFFSET) {
+				dictionary += dictionarySize - LZ4_MAX_OFFSET;
+				dictionarySize = LZ4_MAX_OFFSET;
+			}
+
+			struct PrefixState
+			{
+				const uint8_t* dictionary = nullptr;
+				size_t dictionarySize = 0;
+				std::vector<uint8_t> window;
+				Lz4HashTable seeded;
+				Lz4HashTable table;
+			};
+			thread_local PrefixState state;
+
+			if (state.dictionary != dictionary || state.dictionarySize != dictionarySize) {
+				state.window.assign(dictionary, dictionary + dictionarySize);
+				state.seeded.fill(0);
+				for (size_t i = 0; i + LZ4_MIN_MATCH <= dictionarySize; ++i) {
+					state.seeded[HashSequence(Read32(dictionary + i))] = static_cast<uint32_t>(i);
+				}
+				state.dictionary = dictionary;
+				state.dictionarySize = dictionarySize;
+			}
+
+			state.window.resize(dictionarySize + size);
+			std::memcpy(state.window.data() + dictionarySize, src, size);
+			state.table = state.seeded;
+			return Lz4CompressWindow(state.window.data(), dictionarySize, size, dst, capacity, state.table);
+		}
+
+		/**
+		 * @brief Decode a block; offsets past the start of dst reach into dictionary
+		 */
+		bool Lz4Decompress(const uint8_t* src, size_t size, uint8_t* dst, size_t rawSize,
+			const uint8_t* dictionary = nullptr, size_t dictionarySize = 0)
+		{
+			const uint8_t* ip = src;
+			const uint8_t* const iend = src + size;
+			uint8_t* op = dst;
+			uint8_t* const oend = dst + rawSize;
+
+			auto readLength = [&](size_t& length) -> bool {
+				uint8_t byte;
+				do {
+					if (ip >= iend) {
+						return false;
+					}
+					byte = *ip++;
+					length += byte;
+				} while (byte == 255);
+				return true;
+			};
+
+			while (ip < iend) {
+				const uint8_t token = *ip++;
+
+				size_t literals = token >> 4;
+				if (literals == 15 && !readLength(literals)) {
+					return false;
+				}
+				if (static_cast<size_t>(iend - ip) < literals || static_cast<size_t>(oend - op) < literals) {
+					return false;
+				}
+				std::memcpy(op, ip, literals);
+				op += literals;
+				ip += literals;
+
+				if (ip == iend) {
+					return op == oend;                  // Last sequence has no match
+				}
+
+				if (iend - ip < 2) {
+					return false;
+				}
+				const size_t offset = static_cast<size_t>(ip[0]) | (static_cast<size_t>(ip[1]) << 8);
+				ip += 2;
+				const size_t produced = static_cast<size_t>(op - dst);
+				if (offset == 0 || offset > produced + dictionarySize) {
+					return false;
+				}
+
+				size_t matchLength = token & 15;
+				if (matchLength == 15 && !readLength(matchLength)) {
+					return false;
+				}
+				matchLength += LZ4_MIN_MATCH;
+				if (static_cast<size_t>(oend - op) < matchLength) {
+					return false;
+				}
+
+				if (offset > produced) {
+					// Match starts in the dictionary and may run on into dst
+					const size_t back = offset - produced;
+					const size_t fromDictionary = back < matchLength ? back : matchLength;
+					std::memcpy(op, dictionary + dictionarySize - back, fromDictionary);
+					op += fromDictionary;
+					matchLength -= fromDictionary;
+					if (matchLength == 0) {
+						continue;
+					}
+				}
+
+				const uint8_t* ref = op - offset;
+				if (offset >= matchLength) {
+					std::memcpy(op, ref, matchLength);
+					op += matchLength;
+				} else {
+					// Overlapping copy repeats the last offset bytes
+					for (size_t i = 0; i < matchLength; ++i) {
+						*op++ = *ref++;
+					}
+				}
+			}
+
+			return false;
+		}
+#endif
+
+		class Lz4Codec : public ChunkCodec
+		{
+		public:
+			ChunkCodecType GetType() const override { return ChunkCodecType::LZ4; }
+			const char* GetName() const override { return "lz4"; }
+			int GetFastLevel() const override { return 1; }
+			int GetHighRatioLevel() const override { return 1; }
+
+			size_t GetMaxCompressedSize(size_t size) const override
+			{
+				return size + size / 255 + 16;
+			}
+
+			size_t Compress(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity, int level) const override
+			{
+#ifdef VOXELCRAFT_LZ4_ENABLED
+				const int written = LZ4_compress_fast(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst),
+					static_cast<int>(size), static_cast<int>(capacity), level > 0 ? level : 1);
+				return written > 0 ? static_cast<size_t>(written) : 0;
+#else
+				(void)level;
+				return Lz4Compress(src, size, dst, capacity);
+#endif
+			}
+
+			bool Decompress(const uint8_t* src, size_t size, uint8_t* dst, size_t rawSize) const override
+			{
+#ifdef VOXELCRAFT_LZ4_ENABLED
+				return LZ4_decompress_safe(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst),
+					static_cast<int>(size), static_cast<int>(rawSize)) == static_cast<int>(rawSize);
+#else
+				return Lz4Decompress(src, size, dst, rawSize);
+#endif
+			}
+
+			size_t CompressWithDictionary(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity, int level,
+				const uint8_t* dictionary, size_t dictionarySize) const override
+			{
+#ifdef VOXELCRAFT_LZ4_ENABLED
+				thread_local LZ4_stream_t stream;
+				LZ4_loadDict(&stream, reinterpret_cast<const char*>(dictionary), static_cast<int>(dictionarySize));
+				const int written = LZ4_compress_fast_continue(&stream, reinterpret_cast<const char*>(src),
+					reinterpret_cast<char*>(dst), static_cast<int>(size), static_cast<int>(capacity), level > 0 ? level : 1);
+				return written > 0 ? static_cast<size_t>(written) : 0;
+#else
+				(void)level;
+				return Lz4CompressWithPrefix(src, size, dst, capacity, dictionary, dictionarySize);
+#endif
+			}
+
+			bool DecompressWithDictionary(const uint8_t* src, size_t size, uint8_t* dst, size_t rawSize,
+				const uint8_t* dictionary, size_t dictionarySize) const override
+			{
+#ifdef VOXELCRAFT_LZ4_ENABLED
+				return LZ4_decompress_safe_usingDict(reinterpret_cast<const char*>(src), reinterpret_cast<char*>(dst),
+					static_cast<int>(size), static_cast<int>(rawSize),
+					reinterpret_cast<const char*>(dictionary), static_cast<int>(dictionarySize)) == static_cast<int>(rawSize);
+#else
+				return Lz4Decompress(src, size, dst, rawSize, dictionary, dictionarySize);
+#endif
+			}
+		};
+
+		// ------------------------------------------------------------------
+		// DEFLATE (zlib)
+		// ------------------------------------------------------------------
+
+#ifdef VOXELCRAFT_ZLIB_ENABLED
+		class DeflateCodec : public ChunkCodec
+		{
+		public:
+			ChunkCodecType GetType() const override { return ChunkCodecType::DEFLATE; }
+			const char* GetName() const override { return "deflate"; }
+			int GetFastLevel() const override { return Z_BEST_SPEED; }
+			int GetHighRatioLevel() const override { return Z_BEST_COMPRESSION; }
+
+			size_t GetMaxCompressedSize(size_t size) const override
+			{
+				return compressBound(static_cast<uLong>(size));
+			}
+
+			size_t Compress(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity, int level) const override
+			{
+				uLongf written = static_cast<uLongf>(capacity);
+				if (compress2(dst, &written, src, static_cast<uLong>(size), level) != Z_OK) {
+					return 0;
+				}
+				return written;
+			}
+
+			bool Decompress(const uint8_t* src, size_t size, uint8_t* dst, size_t rawSize) const override
+			{
+				uLongf written = static_cast<uLongf>(rawSize);
+				return uncompress(dst, &written, src, static_cast<uLong>(size)) == Z_OK && written == rawSize;
+			}
+
+			size_t CompressWithDictionary(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity, int level,
+				const uint8_t* dictionary, size_t dictionarySize) const override
+			{
+				// deflateInit allocates ~256 KiB; keep one stream per thread and reset it
+				struct DeflateState
+				{
+					z_stream stream{};
+					int level = -1;
+					~DeflateState() { if (level >= 0) deflateEnd(&stream); }
+				};
+				thread_local DeflateState state;
+
+				if (state.level != level) {
+					if (state.level >= 0) {
+						deflateEnd(&state.stream);
+						state.level = -1;
+					}
+					state.stream = z_stream{};
+					if (deflateInit(&state.stream, level) != Z_OK) {
+						return 0;
+					}
+					state.level = level;
+				} else if (deflateReset(&state.stream) != Z_OK) {
+					return 0;
+				}
+
+				z_stream& stream = state.stream;
+				if (deflateSetDictionary(&stream, dictionary, static_cast<uInt>(dictionarySize)) != Z_OK) {
+					return 0;
+				}
+				stream.next_in = const_cast<Bytef*>(src);
+				stream.avail_in = static_cast<uInt>(size);
+				stream.next_out = dst;
+				stream.avail_out = static_cast<uInt>(capacity);
+				if (deflate(&stream, Z_FINISH) != Z_STREAM_END) {
+					return 0;
+				}
+				return static_cast<size_t>(stream.total_out);
+			}
+
+			bool DecompressWithDictionary(const uint8_t* src, size_t size, uint8_t* dst, size_t rawSize,
+				const uint8_t* dictionary, size_t dictionarySize) const override
+			{
+				struct InflateState
+				{
+					z_stream stream{};
+					bool ready = false;
+					~InflateState() { if (ready) inflateEnd(&stream); }
+				};
+				thread_local InflateState state;
+
+				if (!state.ready) {
+					if (inflateInit(&state.stream) != Z_OK) {
+						return false;
+					}
+					state.ready = true;
+				} else if (inflateReset(&state.stream) != Z_OK) {
+					return false;
+				}
+
+				z_stream& stream = state.stream;
+				stream.next_in = const_cast<Bytef*>(src);
+				stream.avail_in = static_cast<uInt>(size);
+				stream.next_out = dst;
+				stream.avail_out = static_cast<uInt>(rawSize);
+
+				// The stream names its dictionary by Adler-32 and stops to ask for it
+				int result = inflate(&stream, Z_FINISH);
+				if (result == Z_NEED_DICT) {
+					if (inflateSetDictionary(&stream, dictionary, static_cast<uInt>(dictionarySize)) != Z_OK) {
+						return false;
+					}
+					result = inflate(&stream, Z_FINISH);
+				}
+				return result == Z_STREAM_END && stream.total_out == rawSize;
+			}
+		};
+#endif
+
+		// ------------------------------------------------------------------
+		// ZSTD
+		// ------------------------------------------------------------------
+
+#ifdef VOXELCRAFT_ZSTD_ENABLED
+		class ZstdCodec : public ChunkCodec
+		{
+		public:
+			ChunkCodecType GetType() const override { return ChunkCodecType::ZSTD; }
+			const char* GetName() const override { return "zstd"; }
+			int GetFastLevel() const override { return 1; }
+			int GetHighRatioLevel() const override { return 19; }
+
+			size_t GetMaxCompressedSize(size_t size) const override
+			{
+				return ZSTD_compressBound(size);
+			}
+
+			size_t Compress(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity, int level) const override
+			{
+				// Contexts are reused per thread; creating one costs more than a chunk
+				thread_local std::unique_ptr<ZSTD_CCtx, size_t (*)(ZSTD_CCtx*)> context(ZSTD_createCCtx(), ZSTD_freeCCtx);
+				const size_t written = ZSTD_compressCCtx(context.get(), dst, capacity, src, size, level);
+				return ZSTD_isError(written) ? 0 : written;
+			}
+
+			bool Decompress(const uint8_t* src, size_t size, uint8_t* dst, size_t rawSize) const override
+			{
+				thread_local std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx*)> context(ZSTD_createDCtx(), ZSTD_freeDCtx);
+				const size_t written = ZSTD_decompressDCtx(context.get(), dst, rawSize, src, size);
+				return !ZSTD_isError(written) && written == rawSize;
+			}
+
+			size_t CompressWithDictionary(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity, int level,
+				const uint8_t* dictionary, size_t dictionarySize) const override
+			{
+				// Digesting a dictionary costs more than a chunk; keep the last one per thread
+				struct DictionaryState
+				{
+					const uint8_t* dictionary = nullptr;
+					size_t dictionarySize = 0;
+					int level = 0;
+					std::unique_ptr<ZSTD_CDict, size_t (*)(ZSTD_CDict*)> cdict{ nullptr, ZSTD_freeCDict };
+				};
+				thread_local std::unique_ptr<ZSTD_CCtx, size_t (*)(ZSTD_CCtx*)> context(ZSTD_createCCtx(), ZSTD_freeCCtx);
+				thread_local DictionaryState state;
+
+				if (!state.cdict || state.dictionary != dictionary || state.dictionarySize != dictionarySize || state.level != level) {
+					state.cdict.reset(ZSTD_createCDict(dictionary, dictionarySize, level));
+					state.dictionary = dictionary;
+					state.dictionarySize = dictionarySize;
+					state.level = level;
+				}
+				if (!state.cdict) {
+					return 0;
+				}
+
+				const size_t written = ZSTD_compress_usingCDict(context.get(), dst, capacity, src, size, state.cdict.get());
+				return ZSTD_isError(written) ? 0 : written;
+			}
+
+			bool DecompressWithDictionary(const uint8_t* src, size_t size, uint8_t* dst, size_t rawSize,
+				const uint8_t* dictionary, size_t dictionarySize) const override
+			{
+				struct DictionaryState
+				{
+					const uint8_t* dictionary = nullptr;
+					size_t dictionarySize = 0;
+					std::unique_ptr<ZSTD_DDict, size_t (*)(ZSTD_DDict*)> ddict{ nullptr, ZSTD_freeDDict };
+				};
+				thread_local std::unique_ptr<ZSTD_DCtx, size_t (*)(ZSTD_DCtx*)> context(ZSTD_createDCtx(), ZSTD_freeDCtx);
+				thread_local DictionaryState state;
+
+				if (!state.ddict || state.dictionary != dictionary || state.dictionarySize != dictionarySize) {
+					state.ddict.reset(ZSTD_createDDict(dictionary, dictionarySize));
+					state.dictionary = dictionary;
+					state.dictionarySize = dictionarySize;
+				}
+				if (!state.ddict) {
+					return false;
+				}
+
+				const size_t written = ZSTD_decompress_usingDDict(context.get(), dst, rawSize, src, size, state.ddict.get());
+				return !ZSTD_isError(written) && written == rawSize;
+			}
+		};
+#endif
+
+		const StoredCodec g_storedCodec;
+		const Lz4Codec g_lz4Codec;
+#ifdef VOXELCRAFT_ZLIB_ENABLED
+		const DeflateCodec g_deflateCodec;
+#endif
+#ifdef VOXELCRAFT_ZSTD_ENABLED
+		const ZstdCodec g_zstdCodec;
+#endif
+
+		// First byte of a zlib stream with the default 32K window
+		constexpr uint8_t LEGACY_ZLIB_HEADER = 0x78;
+
+	} // namespace
+
+	const ChunkCodec* ChunkCompression::GetCodec(ChunkCodecType type)
+	{
+		switch (type) {
+		case ChunkCodecType::NONE:
+			return &g_storedCodec;
+		case ChunkCodecType::LZ4:
+			return &g_lz4Codec;
+#ifdef VOXELCRAFT_ZLIB_ENABLED
+		case ChunkCodecType::DEFLATE:
+			return &g_deflateCodec;
+#endif
+#ifdef VOXELCRAFT_ZSTD_ENABLED
+		case ChunkCodecType::ZSTD:
+			return &g_zstdCodec;
+#endif
+		default:
+			return nullptr;
+		}
+	}
+
+	ChunkCodecType ChunkCompression::Resolve(ChunkCodecType type)
+	{
+		if (type == ChunkCodecType::ZSTD && !GetCodec(type)) {
+			type = ChunkCodecType::DEFLATE;
+		}
+		if (type == ChunkCodecType::DEFLATE && !GetCodec(type)) {
+			type = ChunkCodecType::LZ4;
+		}
+		return GetCodec(type) ? type : ChunkCodecType::LZ4;
+	}
+
+	const char* ChunkCompression::GetName(ChunkCodecType type)
+	{
+		static const char* names[] = { "none", "lz4", "deflate", "zstd" };
+		const size_t index = static_cast<size_t>(type);
+		return index < CHUNK_CODEC_COUNT ? names[index] : "unknown";
+	}
+
+	bool ChunkCompression::Encode(ChunkCodecType type, int level, const uint8_t* data, size_t size,
+		std::vector<uint8_t>& frame)
+	{
+		const ChunkCodec* codec = GetCodec(type);
+		if (!codec || size == 0 || size > MAX_RAW_SIZE) {
+			return false;
+		}
+		if (level == 0) {
+			level = codec->GetFastLevel();
+		}
+
+		auto start = std::chrono::steady_clock::now();
+
+		frame.resize(FRAME_HEADER_SIZE + codec->GetMaxCompressedSize(size));
+		const size_t written = codec->Compress(data, size, frame.data() + FRAME_HEADER_SIZE,
+			frame.size() - FRAME_HEADER_SIZE, level);
+		if (written == 0) {
+			frame.clear();
+			return false;
+		}
+
+		frame.resize(FRAME_HEADER_SIZE + written);
+		frame[0] = static_cast<uint8_t>(type);
+		for (size_t i = 0; i < 4; ++i) {
+			frame[1 + i] = static_cast<uint8_t>(size >> (i * 8));
+		}
+
+		CodecCounters& counters = g_counters[static_cast<size_t>(type)];
+		counters.compressions.fetch_add(1, std::memory_order_relaxed);
+		counters.rawBytes.fetch_add(size, std::memory_order_relaxed);
+		counters.compressedBytes.fetch_add(frame.size(), std::memory_order_relaxed);
+		counters.compressNanoseconds.fetch_add(ElapsedNanoseconds(start), std::memory_order_relaxed);
+		return true;
+	}
+
+	const uint8_t* ChunkCompression::Decode(const uint8_t* frame, size_t size, size_t& rawSize)
+	{
+		thread_local std::vector<uint8_t> buffer;
+
+		auto start = std::chrono::steady_clock::now();
+
+#ifdef VOXELCRAFT_ZLIB_ENABLED
+		if (size > 0 && frame[0] == LEGACY_ZLIB_HEADER) {
+			// Unframed: raw size unknown, so inflate into the largest buffer
+			buffer.resize(MAX_RAW_SIZE);
+			uLongf written = static_cast<uLongf>(buffer.size());
+			if (uncompress(buffer.data(), &written, frame, static_cast<uLong>(size)) != Z_OK) {
+				return nullptr;
+			}
+			rawSize = written;
+			return buffer.data();
+		}
+#endif
+
+		ChunkCodecType type;
+		if (!PeekFrame(frame, size, type, rawSize)) {
+			return nullptr;
+		}
+
+		const uint8_t* payload = frame + FRAME_HEADER_SIZE;
+		const size_t payloadSize = size - FRAME_HEADER_SIZE;
+		if (type == ChunkCodecType::NONE) {
+			return payloadSize == rawSize ? payload : nullptr;
+		}
+
+		const ChunkCodec* codec = GetCodec(type);
+		if (!codec) {
+			return nullptr;
+		}
+
+		if (buffer.size() < rawSize) {
+			buffer.resize(rawSize);
+		}
+		if (!codec->Decompress(payload, payloadSize, buffer.data(), rawSize)) {
+			return nullptr;
+		}
+
+		CodecCounters& counters = g_counters[static_cast<size_t>(type)];
+		counters.decompressions.fetch_add(1, std::memory_order_relaxed);
+		counters.decompressedBytes.fetch_add(rawSize, std::memory_order_relaxed);
+		counters.decompressNanoseconds.fetch_add(ElapsedNanoseconds(start), std::memory_order_relaxed);
+		return buffer.data();
+	}
+
+	bool ChunkCompression::PeekFrame(const uint8_t* frame, size_t size, ChunkCodecType& type, size_t& rawSize)
+	{
+		if (size < FRAME_HEADER_SIZE || frame[0] >= CHUNK_CODEC_COUNT) {
+			return false;
+		}
+
+		type = static_cast<ChunkCodecType>(frame[0]);
+		rawSize = 0;
+		for (size_t i = 0; i < 4; ++i) {
+			rawSize |= static_cast<size_t>(frame[1 + i]) << (i * 8);
+		}
+		return rawSize > 0 && rawSize <= MAX_RAW_SIZE;
+	}
+
+	std::array<ChunkCodecStats, CHUNK_CODEC_COUNT> ChunkCompression::GetStats()
+	{
+		std::array<ChunkCodecStats, CHUNK_CODEC_COUNT> stats{};
+
+		for (size_t i = 0; i < CHUNK_CODEC_COUNT; ++i) {
+			const CodecCounters& counters = g_counters[i];
+			ChunkCodecStats& out = stats[i];
+
+			out.available = GetCodec(static_cast<ChunkCodecType>(i)) != nullptr;
+			out.compressions = counters.compressions.load(std::memory_order_relaxed);
+			out.decompressions = counters.decompressions.load(std::memory_order_relaxed);
+			out.rawBytes = counters.rawBytes.load(std::memory_order_relaxed);
+			out.compressedBytes = counters.compressedBytes.load(std::memory_order_relaxed);
+
+			const uint64_t compressNs = counters.compressNanoseconds.load(std::memory_order_relaxed);
+			const uint64_t decompressNs = counters.decompressNanoseconds.load(std::memory_order_relaxed);
+			const uint64_t decompressed = counters.decompressedBytes.load(std::memory_order_relaxed);
+
+			out.ratio = out.compressedBytes > 0
+				? static_cast<float>(out.rawBytes) / static_cast<float>(out.compressedBytes) : 0.0f;
+			out.compressMBps = compressNs > 0
+				? static_cast<float>(static_cast<double>(out.rawBytes) / (static_cast<double>(compressNs) * 1e-9) / (1024.0 * 1024.0)) : 0.0f;
+			out.decompressMBps = decompressNs > 0
+				? static_cast<float>(static_cast<double>(decompressed) / (static_cast<double>(decompressNs) * 1e-9) / (1024.0 * 1024.0)) : 0.0f;
+		}
+
+		return stats;
+	}
+
+} // namespace VoxelCraft
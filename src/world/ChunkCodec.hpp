@@ -0,0 +1,134 @@
+/**
+ * @file ChunkCodec.hpp
+ * @brief VoxelCraft World System - Pluggable chunk payload compression
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#pragma once
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "ChunkSystem.hpp"
+
+namespace VoxelCraft {
+
+	/**
+	 * @brief One compression algorithm over whole serialized chunks
+	 *
+	 * Codecs are stateless and shared by all threads.
+	 */
+	class ChunkCodec
+	{
+	public:
+		virtual ~ChunkCodec() = default;
+
+		virtual ChunkCodecType GetType() const = 0;
+		virtual const char* GetName() const = 0;
+
+		/**
+		 * @brief Level for hot data (cache, first save)
+		 */
+		virtual int GetFastLevel() const = 0;
+
+		/**
+		 * @brief Level for cold data (idle recompression)
+		 */
+		virtual int GetHighRatioLevel() const = 0;
+
+		/**
+		 * @brief Worst-case output size for size input bytes
+		 */
+		virtual size_t GetMaxCompressedSize(size_t size) const = 0;
+
+		/**
+		 * @brief Compress into dst
+		 * @return Compressed size, or 0 on failure
+		 */
+		virtual size_t Compress(const uint8_t* src, size_t size, uint8_t* dst, size_t capacity, int level) const = 0;
+
+		/**
+		 * @brief Decompress exactly rawSize bytes into dst
+		 */
+		virtual bool Decompress(const uint8_t* src, size_t size, uint8_t* dst, size_t rawSize) const = 0;
+
+		/**
+		 * @brief Compress with a preset dictionary both ends share
+		 *
+		 * The dictionary must stay alive and unchanged while it is in use:
+		 * codecs cache state derived from it per thread, keyed by address.
+		 * @return Compressed size, or 0 on failure or if the codec has no dictionary support
+		 */
+		virtual size_t CompressWithDictionary(const uint8_t*, size_t, uint8_t*, size_t, int,
+			const uint8_t*, size_t) const { return 0; }
+
+		/**
+		 * @brief Decompress data produced by CompressWithDictionary with the same dictionary
+		 */
+		virtual bool DecompressWithDictionary(const uint8_t*, size_t, uint8_t*, size_t,
+			const uint8_t*, size_t) const { return false; }
+	};
+
+	/**
+	 * @brief Codec registry, framing and per-codec statistics
+	 *
+	 * Every compressed chunk is a frame: codec ID (1 byte), raw size
+	 * (uint32, little-endian) and the codec's output. Frames are
+	 * self-describing, so hot and cold data can be mixed freely and a
+	 * recompressor can tell which tier a stored chunk is in. Bare zlib
+	 * streams from before framing (first byte 0x78) still decode.
+	 *
+	 * LZ4 is always available: liblz4 when found at build time, otherwise an
+	 * in-tree implementation of the same block format. DEFLATE needs zlib
+	 * and ZSTD needs libzstd.
+	 */
+	class ChunkCompression
+	{
+	public:
+		static constexpr size_t FRAME_HEADER_SIZE = 5;
+		static constexpr size_t MAX_RAW_SIZE = 1u << 20;
+
+		/**
+		 * @brief Get codec, nullptr if not built into this binary
+		 */
+		static const ChunkCodec* GetCodec(ChunkCodecType type);
+
+		/**
+		 * @brief Nearest available codec (ZSTD -> DEFLATE -> LZ4)
+		 */
+		static ChunkCodecType Resolve(ChunkCodecType type);
+
+		/**
+		 * @brief Get codec name
+		 */
+		static const char* GetName(ChunkCodecType type);
+
+		/**
+		 * @brief Compress data into a frame
+		 * @param level Codec level, 0 for the codec's fast level
+		 * @return false if the codec is unavailable, data is empty or too large
+		 */
+		static bool Encode(ChunkCodecType type, int level, const uint8_t* data, size_t size,
+			std::vector<uint8_t>& frame);
+
+		/**
+		 * @brief Decompress a frame
+		 * @return Raw bytes, valid until the next Decode on this thread, or
+		 *         nullptr on corrupt data. NONE frames return a pointer into
+		 *         frame itself.
+		 */
+		static const uint8_t* Decode(const uint8_t* frame, size_t size, size_t& rawSize);
+
+		/**
+		 * @brief Read a frame's codec and raw size without decoding
+		 */
+		static bool PeekFrame(const uint8_t* frame, size_t size, ChunkCodecType& type, size_t& rawSize);
+
+		/**
+		 * @brief Statistics for every codec since startup
+		 */
+		static std::array<ChunkCodecStats, CHUNK_CODEC_COUNT> GetStats();
+	};
+
+} // namespace VoxelCraft
@@ -0,0 +1,112 @@
+/**
+ * @file ChunkLightStorage.hpp
+ * @brief VoxelCraft World System - Packed sky/block light storage for a chunk
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#pragma once
+#include <memory>
+#include <atomic>
+#include <cstdint>
+
+namespace VoxelCraft {
+
+	/**
+	 * @brief Two-channel light storage for a 16x256x16 chunk column
+	 *
+	 * One byte per block: lower 4 bits block light, upper 4 bits sky light.
+	 * Bytes are atomic so light propagation running on worker threads can
+	 * cross into a neighbor chunk while the renderer reads it; nibble writes
+	 * use a CAS so the two channels never clobber each other.
+	 *
+	 * Indexing matches ChunkSection: x fastest, then z, then y.
+	 */
+	class ChunkLightStorage
+	{
+	public:
+		static constexpr uint32_t COLUMN_HEIGHT = 256;
+		static constexpr uint32_t VOLUME = 16 * COLUMN_HEIGHT * 16;
+		static constexpr uint8_t MAX_LIGHT = 15;
+
+		ChunkLightStorage()
+			: m_data(std::make_unique<std::atomic<uint8_t>[]>(VOLUME))
+			, m_lit(false)
+		{
+			Fill(MAX_LIGHT, 0);
+		}
+
+		/**
+		 * @brief Get index from local coordinates
+		 */
+		static uint32_t GetIndex(uint32_t x, uint32_t y, uint32_t z) {
+			return (y << 8) | (z << 4) | x;
+		}
+
+		uint8_t GetSky(uint32_t index) const {
+			return static_cast<uint8_t>(m_data[index].load(std::memory_order_relaxed) >> 4);
+		}
+
+		uint8_t GetBlock(uint32_t index) const {
+			return static_cast<uint8_t>(m_data[index].load(std::memory_order_relaxed) & 0x0F);
+		}
+
+		void SetSky(uint32_t index, uint8_t level) {
+			SetNibble(index, 0x0F, static_cast<uint8_t>((level & 0x0F) << 4));
+		}
+
+		void SetBlock(uint32_t index, uint8_t level) {
+			SetNibble(index, 0xF0, static_cast<uint8_t>(level & 0x0F));
+		}
+
+		/**
+		 * @brief Set both channels everywhere; the chunk counts as unlit again
+		 */
+		void Fill(uint8_t sky, uint8_t block) {
+			const uint8_t packed = static_cast<uint8_t>(((sky & 0x0F) << 4) | (block & 0x0F));
+			for (uint32_t i = 0; i < VOLUME; ++i) {
+				m_data[i].store(packed, std::memory_order_relaxed);
+			}
+			m_lit.store(false, std::memory_order_release);
+		}
+
+		/**
+		 * @brief Check if a full relight has run since the last Fill
+		 *
+		 * Unlit chunks hold placeholder values and are ignored as neighbors.
+		 */
+		bool IsLit() const { return m_lit.load(std::memory_order_acquire); }
+
+		/**
+		 * @brief Mark the chunk as lit
+		 */
+		void SetLit(bool lit) { m_lit.store(lit, std::memory_order_release); }
+
+		/**
+		 * @brief Zero the block channel, keeping sky light
+		 *
+		 * Not atomic as a whole; call while no propagation touches this chunk.
+		 */
+		void ClearBlockChannel() {
+			for (uint32_t i = 0; i < VOLUME; ++i) {
+				m_data[i].store(static_cast<uint8_t>(m_data[i].load(std::memory_order_relaxed) & 0xF0),
+					std::memory_order_relaxed);
+			}
+		}
+
+		size_t GetMemoryUsage() const { return sizeof(*this) + VOLUME * sizeof(uint8_t); }
+
+	private:
+		std::unique_ptr<std::atomic<uint8_t>[]> m_data;
+		std::atomic<bool> m_lit;
+
+		void SetNibble(uint32_t index, uint8_t keepMask, uint8_t bits) {
+			std::atomic<uint8_t>& slot = m_data[index];
+			uint8_t expected = slot.load(std::memory_order_relaxed);
+			while (!slot.compare_exchange_weak(expected, static_cast<uint8_t>((expected & keepMask) | bits),
+				std::memory_order_relaxed)) {
+			}
+		}
+	};
+
+} // namespace VoxelCraft
@@ -0,0 +1,605 @@
+#include "ChunkPipeline.hpp"
+#include "Chunk.hpp"
+#include "core/WorkStealingPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+namespace VoxelCraft {
+
+	ChunkPipeline::ChunkPipeline(ChunkStageHandlers handlers, WorkStealingPool* pool, uint32_t maxInFlight)
+		: m_handlers(std::move(handlers))
+		, m_pool(pool)
+		, m_maxInFlight(maxInFlight)
+		, m_sequence(0)
+		, m_inFlight(0)
+		, m_stopping(false)
+	{
+		if (m_maxInFlight == 0) {
+			// Two per worker keeps every deque fed while leaving the ordering to m_ready
+			m_maxInFlight = m_pool ? static_cast<uint32_t>(m_pool->GetThreadCount()) * 2 : 1;
+		}
+	}
+
+	ChunkPipeline::~ChunkPipeline()
+	{
+		Shutdown();
+	}
+
+	void ChunkPipeline::Request(const ChunkCoord& coord, ChunkStage target, ChunkPriority priority)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_stopping) {
+			return;
+		}
+
+		std::vector<ChunkCoord> touched;
+		RequestLocked(coord, std::min(target, ChunkStage::READY), priority, true, touched);
+
+		for (const auto& c : touched) {
+			EvaluateLocked(c);
+		}
+		DispatchLocked();
+	}
+
+	void ChunkPipeline::Remove(const ChunkCoord& coord)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		auto it = m_entries.find(coord);
+		if (it == m_entries.end()) {
+			return;
+		}
+
+		// Queued tasks for it are discarded when popped
+		it->second.removed = true;
+		it->second.target = ChunkStage::NONE;
+		EraseIfUnusedLocked(coord);
+	}
+
+	void ChunkPipeline::RequestRemesh(const ChunkCoord& coord, ChunkPriority priority)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_stopping) {
+			return;
+		}
+
+		auto it = m_entries.find(coord);
+		if (it == m_entries.end() || it->second.removed || it->second.failed) {
+			return;
+		}
+
+		Entry& entry = it->second;
+		if (entry.running) {
+			// A running mesh may have read the old blocks; a READY chunk is
+			// running an update and is meshed again once it finishes
+			if (entry.stage >= ChunkStage::LIGHT) {
+				entry.remesh = true;
+			}
+			return;
+		}
+		if (entry.stage != ChunkStage::READY) {
+			return;
+		}
+
+		// Neighbors already passed LIGHT, so MESH is runnable again right away
+		entry.stage = ChunkStage::LIGHT;
+		entry.target = ChunkStage::READY;
+		if (priority < entry.priority) {
+			entry.priority = priority;
+		}
+
+		EvaluateLocked(coord);
+		DispatchLocked();
+	}
+
+	bool ChunkPipeline::RequestUpdate(const ChunkCoord& coord, ChunkPriority priority)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_stopping) {
+			return false;
+		}
+
+		auto it = m_entries.find(coord);
+		if (it == m_entries.end() || it->second.removed || it->second.failed) {
+			return false;
+		}
+
+		Entry& entry = it->second;
+		entry.update = true;
+		if (priority < entry.priority) {
+			entry.priority = priority;
+		}
+
+		EvaluateLocked(coord);
+		DispatchLocked();
+		return true;
+	}
+
+	void ChunkPipeline::SetStageCallback(StageCallback callback)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stageCallback = std::move(callback);
+	}
+
+	uint32_t ChunkPipeline::RunPending(uint32_t maxTasks)
+	{
+		uint32_t ran = 0;
+
+		while (ran < maxTasks) {
+			ReadyTask task;
+			ChunkNeighborhood area;
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (m_stopping || !PopRunnableLocked(task, area)) {
+					break;
+				}
+				m_inFlight++;
+			}
+
+			Execute(task, area);
+			ran++;
+		}
+
+		return ran;
+	}
+
+	void ChunkPipeline::WaitIdle()
+	{
+		if (!m_pool) {
+			RunPending(std::numeric_limits<uint32_t>::max());
+			return;
+		}
+
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_idleCondition.wait(lock, [this]() {
+			return m_inFlight == 0 && (m_ready.empty() || m_stopping);
+		});
+	}
+
+	void ChunkPipeline::Shutdown()
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_stopping = true;
+
+		// Tasks already handed to the pool still run; the pool must outlive us
+		m_idleCondition.wait(lock, [this]() { return m_inFlight == 0; });
+	}
+
+	ChunkStage ChunkPipeline::GetStage(const ChunkCoord& coord) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_entries.find(coord);
+		return it != m_entries.end() ? it->second.stage : ChunkStage::NONE;
+	}
+
+	std::shared_ptr<Chunk> ChunkPipeline::GetChunk(const ChunkCoord& coord) const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		auto it = m_entries.find(coord);
+		return it != m_entries.end() ? it->second.chunk : nullptr;
+	}
+
+	size_t ChunkPipeline::GetChunkCount() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		return m_entries.size();
+	}
+
+	std::array<ChunkStageStats, CHUNK_STAGE_COUNT> ChunkPipeline::GetStageStats() const
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		std::array<ChunkStageStats, CHUNK_STAGE_COUNT> stats{};
+		for (size_t i = 0; i < CHUNK_STAGE_COUNT; ++i) {
+			const StageCounters& counters = m_counters[i];
+			stats[i].queued = counters.queued;
+			stats[i].running = counters.running;
+			stats[i].completed = counters.completed;
+			stats[i].averageTime = counters.completed > 0
+				? static_cast<float>(static_cast<double>(counters.totalNanoseconds) / 1e6 / static_cast<double>(counters.completed))
+				: 0.0f;
+			stats[i].chunksPerSecond = 0.0f;
+		}
+		return stats;
+	}
+
+	ChunkStage ChunkPipeline::GetNeighborRequirement(ChunkStage stage)
+	{
+		switch (stage) {
+		case ChunkStage::DECORATE:
+			return ChunkStage::GENERATE;    // Features may spill into neighbors
+		case ChunkStage::LIGHT:
+			return ChunkStage::DECORATE;    // Light crosses borders, blocks must be final
+		case ChunkStage::MESH:
+		case ChunkStage::READY:
+			return ChunkStage::LIGHT;       // Border faces and AO read neighbor light
+		default:
+			return ChunkStage::NONE;
+		}
+	}
+
+	void ChunkPipeline::RequestLocked(const ChunkCoord& coord, ChunkStage target, ChunkPriority priority,
+		bool explicitPriority, std::vector<ChunkCoord>& touched)
+	{
+		Entry& entry = m_entries[coord];
+		bool changed = false;
+
+		if (entry.removed) {
+			// Revived: neighbors waiting on it need another look
+			entry.removed = false;
+			changed = true;
+			for (int dz = -1; dz <= 1; ++dz) {
+				for (int dx = -1; dx <= 1; ++dx) {
+					if (dx != 0 || dz != 0) {
+						touched.push_back(ChunkCoord(coord.x + dx, coord.z + dz));
+					}
+				}
+			}
+		}
+
+		if (target > entry.target) {
+			entry.target = target;
+			changed = true;
+		}
+
+		// Dependencies only ever make a chunk more urgent
+		if (explicitPriority ? priority != entry.priority : priority < entry.priority) {
+			entry.priority = priority;
+			changed = true;
+		}
+
+		if (!changed) {
+			return;
+		}
+		touched.push_back(coord);
+
+		const ChunkStage needed = GetNeighborRequirement(std::min(entry.target, ChunkStage::MESH));
+		if (needed == ChunkStage::NONE) {
+			return;
+		}
+
+		const ChunkPriority dependencyPriority = entry.priority;
+		for (int dz = -1; dz <= 1; ++dz) {
+			for (int dx = -1; dx <= 1; ++dx) {
+				if (dx != 0 || dz != 0) {
+					RequestLocked(ChunkCoord(coord.x + dx, coord.z + dz), needed, dependencyPriority, false, touched);
+				}
+			}
+		}
+	}
+
+	void ChunkPipeline::EvaluateLocked(const ChunkCoord& coord)
+	{
+		auto it = m_entries.find(coord);
+		if (it == m_entries.end()) {
+			return;
+		}
+
+		Entry& entry = it->second;
+		if (entry.removed || entry.failed || entry.running) {
+			return;
+		}
+
+		// Updates need the chunk, their claim is checked when popped
+		if (entry.update && !entry.updateQueued && entry.chunk) {
+			m_ready.push({ coord, ChunkStage::NONE, entry.priority, m_sequence++, true });
+			entry.updateQueued = true;
+		}
+
+		if (entry.queued || entry.stage >= entry.target) {
+			return;
+		}
+
+		const ChunkStage next = NextStage(entry.stage);
+		if (next >= ChunkStage::READY || !NeighborsReadyLocked(coord, next)) {
+			return;
+		}
+
+		m_ready.push({ coord, next, entry.priority, m_sequence++ });
+		m_counters[static_cast<size_t>(next)].queued++;
+		entry.queued = true;
+	}
+
+	void ChunkPipeline::EvaluateAroundLocked(const ChunkCoord& coord)
+	{
+		for (int dz = -2; dz <= 2; ++dz) {
+			for (int dx = -2; dx <= 2; ++dx) {
+				EvaluateLocked(ChunkCoord(coord.x + dx, coord.z + dz));
+			}
+		}
+	}
+
+	bool ChunkPipeline::NeighborsReadyLocked(const ChunkCoord& coord, ChunkStage stage) const
+	{
+		const ChunkStage required = GetNeighborRequirement(stage);
+		if (required == ChunkStage::NONE) {
+			return true;
+		}
+
+		for (int dz = -1; dz <= 1; ++dz) {
+			for (int dx = -1; dx <= 1; ++dx) {
+				if (dx == 0 && dz == 0) {
+					continue;
+				}
+				auto it = m_entries.find(ChunkCoord(coord.x + dx, coord.z + dz));
+				if (it == m_entries.end() || it->second.removed || it->second.stage < required) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	bool ChunkPipeline::ClaimFreeLocked(const ReadyTask& task) const
+	{
+		// Nothing reads a chunk before it is generated
+		if (!task.update && task.stage == ChunkStage::GENERATE) {
+			return true;
+		}
+
+		const bool write = task.update || task.stage != ChunkStage::MESH;
+		for (int dz = -1; dz <= 1; ++dz) {
+			for (int dx = -1; dx <= 1; ++dx) {
+				auto it = m_entries.find(ChunkCoord(task.coord.x + dx, task.coord.z + dz));
+				if (it == m_entries.end()) {
+					// No stage runs on untracked chunks for an update to overlap
+					if (task.update) {
+						continue;
+					}
+					return false;
+				}
+				if (it->second.writeClaims > 0 || (write && it->second.readClaims > 0)) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	void ChunkPipeline::ClaimLocked(const ReadyTask& task, bool acquire)
+	{
+		if (!task.update && task.stage == ChunkStage::GENERATE) {
+			return;
+		}
+
+		const bool write = task.update || task.stage != ChunkStage::MESH;
+		for (int dz = -1; dz <= 1; ++dz) {
+			for (int dx = -1; dx <= 1; ++dx) {
+				const ChunkCoord c(task.coord.x + dx, task.coord.z + dz);
+				auto it = m_entries.find(c);
+				if (it == m_entries.end()) {
+					continue;
+				}
+
+				Entry& entry = it->second;
+				if (write) {
+					entry.writeClaims = static_cast<uint8_t>(entry.writeClaims + (acquire ? 1 : -1));
+				} else {
+					entry.readClaims = static_cast<uint16_t>(entry.readClaims + (acquire ? 1 : -1));
+				}
+
+				if (!acquire) {
+					EraseIfUnusedLocked(c);
+				}
+			}
+		}
+	}
+
+	bool ChunkPipeline::PopRunnableLocked(ReadyTask& task, ChunkNeighborhood& area)
+	{
+		while (!m_ready.empty()) {
+			ReadyTask candidate = m_ready.top();
+			m_ready.pop();
+			if (!candidate.update) {
+				m_counters[static_cast<size_t>(candidate.stage)].queued--;
+			}
+
+			auto it = m_entries.find(candidate.coord);
+			if (it == m_entries.end()) {
+				continue;
+			}
+
+			Entry& entry = it->second;
+			if (candidate.update) {
+				entry.updateQueued = false;
+				if (entry.removed || entry.failed || entry.running || !entry.update) {
+					continue;
+				}
+			} else {
+				entry.queued = false;
+				if (entry.removed || entry.failed || entry.running || entry.stage >= entry.target ||
+					NextStage(entry.stage) != candidate.stage) {
+					continue;
+				}
+			}
+
+			// Priority changed while queued: requeue at the new one
+			if (candidate.priority != entry.priority) {
+				candidate.priority = entry.priority;
+				candidate.sequence = m_sequence++;
+				m_ready.push(candidate);
+				if (candidate.update) {
+					entry.updateQueued = true;
+				} else {
+					m_counters[static_cast<size_t>(candidate.stage)].queued++;
+					entry.queued = true;
+				}
+				continue;
+			}
+
+			// Blocked tasks are dropped; releasing the claim re-evaluates them
+			if ((!candidate.update && !NeighborsReadyLocked(candidate.coord, candidate.stage)) ||
+				!ClaimFreeLocked(candidate)) {
+				continue;
+			}
+
+			ClaimLocked(candidate, true);
+			entry.running = true;
+			if (candidate.update) {
+				entry.update = false;
+			} else {
+				m_counters[static_cast<size_t>(candidate.stage)].running++;
+			}
+
+			area = ChunkNeighborhood();
+			area.chunks[ChunkNeighborhood::Index(0, 0)] = entry.chunk;
+			if (candidate.update || candidate.stage != ChunkStage::GENERATE) {
+				for (int dz = -1; dz <= 1; ++dz) {
+					for (int dx = -1; dx <= 1; ++dx) {
+						auto neighbor = m_entries.find(ChunkCoord(candidate.coord.x + dx, candidate.coord.z + dz));
+						if ((dx != 0 || dz != 0) && neighbor != m_entries.end()) {
+							area.chunks[ChunkNeighborhood::Index(dx, dz)] = neighbor->second.chunk;
+						}
+					}
+				}
+			}
+
+			task = candidate;
+			return true;
+		}
+
+		return false;
+	}
+
+	void ChunkPipeline::DispatchLocked()
+	{
+		if (!m_pool || m_stopping) {
+			return;
+		}
+
+		while (m_inFlight < m_maxInFlight) {
+			ReadyTask task;
+			ChunkNeighborhood area;
+			if (!PopRunnableLocked(task, area)) {
+				break;
+			}
+
+			m_inFlight++;
+			m_pool->Submit([this, task, area]() { Execute(task, area); });
+		}
+	}
+
+	void ChunkPipeline::Execute(const ReadyTask& task, const ChunkNeighborhood& area)
+	{
+		auto startTime = std::chrono::steady_clock::now();
+
+		std::shared_ptr<Chunk> chunk = area.Center();
+		ChunkStage reached = task.stage;
+		bool ok = true;
+
+		try {
+			if (task.update) {
+				if (m_handlers.update) m_handlers.update(area);
+			} else {
+				switch (task.stage) {
+				case ChunkStage::GENERATE:
+					chunk = m_handlers.generate ? m_handlers.generate(task.coord, reached) : nullptr;
+					ok = chunk != nullptr;
+					// Light and meshes are never stored, so a loaded chunk resumes at LIGHT at most
+					reached = std::clamp(reached, ChunkStage::GENERATE, ChunkStage::DECORATE);
+					break;
+				case ChunkStage::DECORATE:
+					if (m_handlers.decorate) m_handlers.decorate(area);
+					break;
+				case ChunkStage::LIGHT:
+					if (m_handlers.light) m_handlers.light(area);
+					break;
+				case ChunkStage::MESH:
+					if (m_handlers.mesh) m_handlers.mesh(area);
+					reached = ChunkStage::READY;
+					break;
+				default:
+					break;
+				}
+			}
+		}
+		catch (const std::exception& e) {
+			if (task.update) {
+				VOXELCRAFT_LOG_ERROR("Chunk ({}, {}) update failed: {}", task.coord.x, task.coord.z, e.what());
+			} else {
+				VOXELCRAFT_LOG_ERROR("Chunk ({}, {}) failed in stage {}: {}",
+					task.coord.x, task.coord.z, static_cast<int>(task.stage), e.what());
+			}
+			ok = false;
+		}
+
+		auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - startTime).count();
+
+		// Publish to the owner before dependents can see the new stage
+		StageCallback callback;
+		if (!task.update) {
+			std::lock_guard<std::mutex> lock(m_mutex);
+			auto it = m_entries.find(task.coord);
+			if (it != m_entries.end() && !it->second.removed) {
+				callback = m_stageCallback;
+			}
+		}
+		if (ok && callback) {
+			callback(chunk, reached);
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		ClaimLocked(task, false);
+		if (!task.update) {
+			m_counters[static_cast<size_t>(task.stage)].running--;
+		}
+
+		auto it = m_entries.find(task.coord);
+		if (it != m_entries.end()) {
+			Entry& entry = it->second;
+			entry.running = false;
+
+			if (task.update) {
+				// A failed update leaves the chunk as it was; only its stages can fail it
+				if (entry.remesh && entry.stage == ChunkStage::READY) {
+					entry.stage = ChunkStage::LIGHT;
+				}
+				entry.remesh = false;
+			} else if (ok) {
+				StageCounters& counters = m_counters[static_cast<size_t>(task.stage)];
+				counters.completed++;
+				counters.totalNanoseconds += static_cast<uint64_t>(elapsed);
+				if (task.stage == ChunkStage::GENERATE) {
+					entry.chunk = chunk;
+				}
+				entry.stage = reached;
+				if (reached == ChunkStage::READY) {
+					m_counters[static_cast<size_t>(ChunkStage::READY)].completed++;
+					if (entry.remesh) {
+						entry.stage = ChunkStage::LIGHT;
+					}
+				}
+				entry.remesh = false;
+			} else {
+				entry.failed = true;
+			}
+
+			EraseIfUnusedLocked(task.coord);
+		}
+
+		m_inFlight--;
+		EvaluateAroundLocked(task.coord);
+		DispatchLocked();
+
+		if (m_inFlight == 0) {
+			m_idleCondition.notify_all();
+		}
+	}
+
+	void ChunkPipeline::EraseIfUnusedLocked(const ChunkCoord& coord)
+	{
+		auto it = m_entries.find(coord);
+		if (it == m_entries.end()) {
+			return;
+		}
+
+		const Entry& entry = it->second;
+		if (entry.removed && !entry.running && entry.readClaims == 0 && entry.writeClaims == 0) {
+			m_entries.erase(it);
+		}
+	}
+
+} // namespace VoxelCraft
@@ -0,0 +1,308 @@
+/**
+ * @file ChunkPipeline.hpp
+ * @brief VoxelCraft World System - Staged, neighbor-aware chunk pipeline
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#pragma once
+#include <array>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include <queue>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cstdint>
+#include "ChunkSystem.hpp"
+
+namespace VoxelCraft {
+
+	class Chunk;
+	class WorkStealingPool;
+
+	/**
+	 * @brief A chunk and its eight neighbors, handed to stage handlers
+	 *
+	 * Indexed by (dx + 1) + 3 * (dz + 1), matching ChunkMeshNeighbors.
+	 * Every entry is present for DECORATE, LIGHT and MESH; updates get
+	 * nullptr for neighbors the pipeline does not track.
+	 */
+	struct ChunkNeighborhood
+	{
+		std::array<std::shared_ptr<Chunk>, 9> chunks;
+
+		static size_t Index(int dx, int dz) { return static_cast<size_t>((dx + 1) + 3 * (dz + 1)); }
+
+		const std::shared_ptr<Chunk>& Get(int dx, int dz) const { return chunks[Index(dx, dz)]; }
+		const std::shared_ptr<Chunk>& Center() const { return chunks[4]; }
+	};
+
+	/**
+	 * @brief Work done at each stage
+	 *
+	 * Handlers run on pool workers. DECORATE, LIGHT and updates may write
+	 * into the neighbors they are given; MESH may only read them.
+	 */
+	struct ChunkStageHandlers
+	{
+		/**
+		 * @brief Produce the chunk; set reached to the last stage it already passed
+		 *
+		 * Chunks loaded from disk are already decorated and report DECORATE.
+		 * Returning nullptr marks the chunk as failed.
+		 */
+		std::function<std::shared_ptr<Chunk>(const ChunkCoord& coord, ChunkStage& reached)> generate;
+		std::function<void(const ChunkNeighborhood& area)> decorate;
+		std::function<void(const ChunkNeighborhood& area)> light;
+		std::function<void(const ChunkNeighborhood& area)> mesh;
+
+		/**
+		 * @brief Edit a generated chunk outside its stages, e.g. relight queued block changes
+		 */
+		std::function<void(const ChunkNeighborhood& area)> update;
+	};
+
+	/**
+	 * @brief Schedules chunks through GENERATE, DECORATE, LIGHT, MESH and READY
+	 *
+	 * A chunk's next stage is runnable once its eight neighbors reached the
+	 * stage before it: DECORATE needs generated neighbors, LIGHT decorated
+	 * ones and MESH lit ones. Requesting a chunk at a stage therefore requests
+	 * its neighbors at the stage they must reach first, so a READY chunk pulls
+	 * in a three-chunk ring of partially processed ones.
+	 *
+	 * Stages that write into neighbors (DECORATE, LIGHT) take a write claim on
+	 * the 3x3 area, MESH takes a read claim; overlapping claims never run
+	 * together. Updates requested for generated chunks take the same write
+	 * claim, so edits made after a chunk loaded never race its neighbors'
+	 * stages. Runnable work waits in one priority queue (chunk priority,
+	 * then later stages first) and at most maxInFlight tasks are handed to
+	 * the work-stealing pool, so urgent chunks do not queue behind far ones.
+	 *
+	 * Without a pool, RunPending() executes stages on the calling thread.
+	 */
+	class ChunkPipeline
+	{
+	public:
+		/**
+		 * @brief Called on the worker right after a stage finished, before dependents can start
+		 */
+		using StageCallback = std::function<void(const std::shared_ptr<Chunk>& chunk, ChunkStage stage)>;
+
+		/**
+		 * @brief Constructor
+		 * @param handlers Stage work
+		 * @param pool Worker pool, or nullptr to run stages through RunPending()
+		 * @param maxInFlight Tasks handed to the pool at once (0 = two per worker)
+		 */
+		ChunkPipeline(ChunkStageHandlers handlers, WorkStealingPool* pool = nullptr, uint32_t maxInFlight = 0);
+
+		/**
+		 * @brief Destructor, waits for running stages
+		 */
+		~ChunkPipeline();
+
+		ChunkPipeline(const ChunkPipeline&) = delete;
+		ChunkPipeline& operator=(const ChunkPipeline&) = delete;
+
+		/**
+		 * @brief Ask for a chunk to reach a stage
+		 *
+		 * Raises the target (never lowers it) and sets the priority. Neighbors
+		 * are requested as dependencies with at least this priority.
+		 */
+		void Request(const ChunkCoord& coord, ChunkStage target = ChunkStage::READY,
+			ChunkPriority priority = ChunkPriority::MEDIUM);
+
+		/**
+		 * @brief Run MESH again for a chunk whose blocks or light changed
+		 *
+		 * Only chunks that are READY or being meshed are affected: a READY
+		 * chunk drops back to LIGHT, a running mesh is redone once it
+		 * finishes. Chunks still short of MESH will read the change anyway.
+		 */
+		void RequestRemesh(const ChunkCoord& coord, ChunkPriority priority = ChunkPriority::HIGH);
+
+		/**
+		 * @brief Run the update handler on a chunk under a write claim on its area
+		 *
+		 * Requests made before the update starts run once. The update waits
+		 * until the chunk is generated and no overlapping claim is held.
+		 * @return False if the chunk is not tracked, so no update will run
+		 */
+		bool RequestUpdate(const ChunkCoord& coord, ChunkPriority priority = ChunkPriority::HIGH);
+
+		/**
+		 * @brief Drop a chunk; deferred while a running stage uses it
+		 *
+		 * Chunks that still depend on it stall until it is requested again.
+		 */
+		void Remove(const ChunkCoord& coord);
+
+		/**
+		 * @brief Set the stage completion callback
+		 */
+		void SetStageCallback(StageCallback callback);
+
+		/**
+		 * @brief Run up to maxTasks runnable stages on the calling thread
+		 * @return Number of stages run
+		 */
+		uint32_t RunPending(uint32_t maxTasks);
+
+		/**
+		 * @brief Block until no stage is runnable or running
+		 */
+		void WaitIdle();
+
+		/**
+		 * @brief Stop dispatching and wait for running stages
+		 */
+		void Shutdown();
+
+		/**
+		 * @brief Last stage the chunk completed (NONE if unknown)
+		 */
+		ChunkStage GetStage(const ChunkCoord& coord) const;
+
+		/**
+		 * @brief Get chunk (nullptr before GENERATE)
+		 */
+		std::shared_ptr<Chunk> GetChunk(const ChunkCoord& coord) const;
+
+		/**
+		 * @brief Number of chunks tracked
+		 */
+		size_t GetChunkCount() const;
+
+		/**
+		 * @brief Per-stage counters; chunksPerSecond is left to the caller
+		 */
+		std::array<ChunkStageStats, CHUNK_STAGE_COUNT> GetStageStats() const;
+
+		/**
+		 * @brief Stage every neighbor must have finished before stage can run
+		 */
+		static ChunkStage GetNeighborRequirement(ChunkStage stage);
+
+	private:
+		struct Entry
+		{
+			std::shared_ptr<Chunk> chunk;
+			ChunkStage stage = ChunkStage::NONE;       // Last completed
+			ChunkStage target = ChunkStage::NONE;
+			ChunkPriority priority = ChunkPriority::IDLE;
+			uint16_t readClaims = 0;
+			uint8_t writeClaims = 0;
+			bool running = false;
+			bool queued = false;
+			bool removed = false;
+			bool failed = false;
+			bool remesh = false;                       // Changed while its mesh or an update was running
+			bool update = false;                       // Update requested, not started yet
+			bool updateQueued = false;
+		};
+
+		struct ReadyTask
+		{
+			ChunkCoord coord;
+			ChunkStage stage;
+			ChunkPriority priority;
+			uint64_t sequence;
+			bool update = false;                       // Update handler instead of stage
+
+			bool operator<(const ReadyTask& other) const {
+				if (priority != other.priority) {
+					return static_cast<int>(priority) > static_cast<int>(other.priority);
+				}
+				if (update != other.update) {
+					return other.update;             // Edits to loaded chunks before stage work
+				}
+				if (stage != other.stage) {
+					return stage < other.stage;      // Finish chunks before starting new ones
+				}
+				return sequence > other.sequence;
+			}
+		};
+
+		struct StageCounters
+		{
+			uint32_t queued = 0;
+			uint32_t running = 0;
+			uint64_t completed = 0;
+			uint64_t totalNanoseconds = 0;
+		};
+
+		ChunkStageHandlers m_handlers;
+		WorkStealingPool* m_pool;
+		uint32_t m_maxInFlight;
+		StageCallback m_stageCallback;
+
+		mutable std::mutex m_mutex;
+		std::condition_variable m_idleCondition;
+		std::unordered_map<ChunkCoord, Entry> m_entries;
+		std::priority_queue<ReadyTask> m_ready;
+		std::array<StageCounters, CHUNK_STAGE_COUNT> m_counters;
+		uint64_t m_sequence;
+		uint32_t m_inFlight;
+		bool m_stopping;
+
+		/**
+		 * @brief Raise target/priority and recurse into neighbors
+		 */
+		void RequestLocked(const ChunkCoord& coord, ChunkStage target, ChunkPriority priority,
+			bool explicitPriority, std::vector<ChunkCoord>& touched);
+
+		/**
+		 * @brief Queue the chunk's next stage if its neighbors allow it
+		 */
+		void EvaluateLocked(const ChunkCoord& coord);
+
+		/**
+		 * @brief Evaluate every chunk whose 3x3 area overlaps coord's
+		 */
+		void EvaluateAroundLocked(const ChunkCoord& coord);
+
+		/**
+		 * @brief Check that neighbors reached the stage's requirement
+		 */
+		bool NeighborsReadyLocked(const ChunkCoord& coord, ChunkStage stage) const;
+
+		/**
+		 * @brief Check whether the task's claim over the 3x3 area is free
+		 */
+		bool ClaimFreeLocked(const ReadyTask& task) const;
+
+		/**
+		 * @brief Take or release the task's claim over the 3x3 area
+		 */
+		void ClaimLocked(const ReadyTask& task, bool acquire);
+
+		/**
+		 * @brief Pop the most urgent task that can start now and claim it
+		 */
+		bool PopRunnableLocked(ReadyTask& task, ChunkNeighborhood& area);
+
+		/**
+		 * @brief Hand runnable tasks to the pool up to maxInFlight
+		 */
+		void DispatchLocked();
+
+		/**
+		 * @brief Run one stage or update and publish its result
+		 */
+		void Execute(const ReadyTask& task, const ChunkNeighborhood& area);
+
+		/**
+		 * @brief Erase a removed entry once nothing uses it
+		 */
+		void EraseIfUnusedLocked(const ChunkCoord& coord);
+
+		static ChunkStage NextStage(ChunkStage stage) {
+			return static_cast<ChunkStage>(static_cast<uint8_t>(stage) + 1);
+		}
+	};
+
+} // namespace VoxelCraft
@@ -0,0 +1,559 @@
+/**
+ * @file ChunkSection.cpp
+ * @brief VoxelCraft World System - Palette-compressed chunk block storage
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#include "ChunkSection.hpp"
+#include "blocks/BlockPropertyTable.hpp"
+#include <algorithm>
+
+namespace VoxelCraft {
+
+	namespace {
+
+		/**
+		 * @brief Count palette index occurrences in LSB-first packed entries
+		 *
+		 * Eight entries span Bits bytes; each of the eight gets its own set
+		 * of counters so runs of one index do not serialize on a single one.
+		 */
+		template<uint32_t Bits>
+		void CountIndices(const uint8_t* packed, uint32_t* histogram)
+		{
+			constexpr uint32_t entries = 1u << Bits;
+			constexpr uint64_t mask = entries - 1u;
+			uint32_t lanes[8][entries] = {};
+
+			for (uint32_t group = 0; group < ChunkSection::SECTION_VOLUME / 8; ++group) {
+				uint64_t value = 0;
+				for (uint32_t b = 0; b < Bits; ++b) {
+					value |= static_cast<uint64_t>(packed[group * Bits + b]) << (b * 8);
+				}
+				for (uint32_t e = 0; e < 8; ++e) {
+					++lanes[e][(value >> (e * Bits)) & mask];
+				}
+			}
+
+			for (uint32_t i = 0; i < entries; ++i) {
+				for (uint32_t e = 0; e < 8; ++e) {
+					histogram[i] += lanes[e][i];
+				}
+			}
+		}
+
+	} // namespace
+
+	// ------------------------------------------------------------------
+	// ChunkSection::Buffer
+	// ------------------------------------------------------------------
+
+	ChunkSection::Buffer::Buffer(uint8_t bits)
+		: bitsPerEntry(bits)
+		, bitsLog2(0)
+		, paletteCapacity(0)
+		, paletteSize(0)
+		, wordCount(0)
+	{
+		while ((1u << bitsLog2) < bits) {
+			bitsLog2++;
+		}
+
+		wordCount = (SECTION_VOLUME * bitsPerEntry) / 64u;
+		words = std::make_unique<std::atomic<uint64_t>[]>(wordCount);
+
+		if (bitsPerEntry != DIRECT_BITS) {
+			paletteCapacity = 1u << bitsPerEntry;
+			palette = std::make_unique<std::atomic<uint16_t>[]>(paletteCapacity);
+		}
+	}
+
+	void ChunkSection::Buffer::WriteRaw(uint32_t index, uint32_t value)
+	{
+		const uint32_t entriesLog2 = 6u - bitsLog2;
+		std::atomic<uint64_t>& slot = words[index >> entriesLog2];
+		const uint32_t shift = (index & ((1u << entriesLog2) - 1u)) << bitsLog2;
+		const uint64_t mask = ((uint64_t(1) << bitsPerEntry) - 1u) << shift;
+
+		// Single writer per section, so load/modify/store needs no CAS.
+		// Release pairs with ReadRaw's acquire so a freshly appended palette
+		// entry is visible before any word referencing it.
+		uint64_t word = slot.load(std::memory_order_relaxed);
+		word = (word & ~mask) | ((uint64_t(value) << shift) & mask);
+		slot.store(word, std::memory_order_release);
+	}
+
+	int32_t ChunkSection::Buffer::FindOrAdd(uint16_t id)
+	{
+		auto it = lookup.find(id);
+		if (it != lookup.end()) {
+			return it->second;
+		}
+
+		if (paletteSize >= paletteCapacity) {
+			return -1;
+		}
+
+		const uint16_t paletteIndex = static_cast<uint16_t>(paletteSize++);
+		palette[paletteIndex].store(id, std::memory_order_relaxed);
+		lookup.emplace(id, paletteIndex);
+		return paletteIndex;
+	}
+
+	size_t ChunkSection::Buffer::GetMemoryUsage() const
+	{
+		return sizeof(Buffer) +
+			wordCount * sizeof(uint64_t) +
+			paletteCapacity * sizeof(uint16_t) +
+			lookup.size() * (sizeof(uint16_t) * 2 + sizeof(void*) * 2);
+	}
+
+	// ------------------------------------------------------------------
+	// ChunkSection
+	// ------------------------------------------------------------------
+
+	ChunkSection::ChunkSection(uint16_t fillId)
+		: m_buffer(nullptr)
+		, m_uniformId(fillId)
+		, m_solidCount(BlockPropertyTable::IsSolid(fillId) ? SECTION_VOLUME : 0)
+		, m_nonAirCount(BlockPropertyTable::IsAir(fillId) ? 0 : SECTION_VOLUME)
+	{
+	}
+
+	ChunkSection::~ChunkSection() = default;
+
+	uint16_t ChunkSection::Set(uint32_t index, uint16_t id)
+	{
+		std::lock_guard<std::mutex> lock(m_writeMutex);
+
+		Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+		const uint16_t oldId = Get(index);
+		if (oldId == id) {
+			return oldId;
+		}
+
+		if (!buffer) {
+			// Leave the uniform fast path: index 0 is the old uniform ID,
+			// which is what zero-initialized words already encode.
+			auto grown = std::make_unique<Buffer>(uint8_t(1));
+			grown->FindOrAdd(m_uniformId.load(std::memory_order_relaxed));
+			grown->FindOrAdd(id);
+			grown->WriteRaw(index, 1);
+			Publish(std::move(grown));
+			UpdateCounts(oldId, id);
+			return oldId;
+		}
+
+		if (buffer->bitsPerEntry == DIRECT_BITS) {
+			buffer->WriteRaw(index, id);
+			UpdateCounts(oldId, id);
+			return oldId;
+		}
+
+		int32_t paletteIndex = buffer->FindOrAdd(id);
+		if (paletteIndex >= 0) {
+			buffer->WriteRaw(index, static_cast<uint32_t>(paletteIndex));
+			UpdateCounts(oldId, id);
+			return oldId;
+		}
+
+		// Palette is full: copy-on-write into the next width
+		std::vector<uint16_t> values(SECTION_VOLUME);
+		Unpack(values.data());
+		values[index] = id;
+
+		std::vector<uint16_t> palette(buffer->paletteSize);
+		for (uint32_t i = 0; i < buffer->paletteSize; ++i) {
+			palette[i] = buffer->palette[i].load(std::memory_order_relaxed);
+		}
+		palette.push_back(id);
+
+		Publish(Build(NextBits(buffer->bitsPerEntry), values.data(), palette));
+		UpdateCounts(oldId, id);
+		return oldId;
+	}
+
+	void ChunkSection::Fill(uint16_t id)
+	{
+		std::lock_guard<std::mutex> lock(m_writeMutex);
+
+		m_uniformId.store(id, std::memory_order_relaxed);
+		Publish(nullptr);
+
+		m_solidCount.store(BlockPropertyTable::IsSolid(id) ? SECTION_VOLUME : 0, std::memory_order_relaxed);
+		m_nonAirCount.store(BlockPropertyTable::IsAir(id) ? 0 : SECTION_VOLUME, std::memory_order_relaxed);
+	}
+
+	void ChunkSection::Unpack(uint16_t* out) const
+	{
+		const Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+		if (!buffer) {
+			std::fill(out, out + SECTION_VOLUME, m_uniformId.load(std::memory_order_relaxed));
+			return;
+		}
+
+		const uint32_t entriesPerWord = 64u >> buffer->bitsLog2;
+		const uint64_t mask = (uint64_t(1) << buffer->bitsPerEntry) - 1u;
+		const bool direct = buffer->bitsPerEntry == DIRECT_BITS;
+
+		// Snapshot the palette once instead of per entry
+		std::array<uint16_t, 1u << MAX_PALETTE_BITS> palette{};
+		if (!direct) {
+			for (uint32_t i = 0; i < buffer->paletteCapacity; ++i) {
+				palette[i] = buffer->palette[i].load(std::memory_order_relaxed);
+			}
+		}
+
+		uint32_t index = 0;
+		for (uint32_t w = 0; w < buffer->wordCount; ++w) {
+			uint64_t word = buffer->words[w].load(std::memory_order_acquire);
+			for (uint32_t e = 0; e < entriesPerWord; ++e) {
+				const uint32_t raw = static_cast<uint32_t>(word & mask);
+				out[index++] = direct ? static_cast<uint16_t>(raw) : palette[raw];
+				word >>= buffer->bitsPerEntry;
+			}
+		}
+	}
+
+	void ChunkSection::Serialize(std::vector<uint8_t>& out) const
+	{
+		auto writeU16 = [&out](uint16_t value) {
+			out.push_back(static_cast<uint8_t>(value & 0xFF));
+			out.push_back(static_cast<uint8_t>(value >> 8));
+		};
+
+		if (IsUniform()) {
+			out.push_back(0);
+			writeU16(GetUniformId());
+			return;
+		}
+
+		std::array<uint16_t, SECTION_VOLUME> values;
+		Unpack(values.data());
+
+		std::vector<uint16_t> palette(values.begin(), values.end());
+		std::sort(palette.begin(), palette.end());
+		palette.erase(std::unique(palette.begin(), palette.end()), palette.end());
+
+		if (palette.size() == 1) {
+			out.push_back(0);
+			writeU16(palette[0]);
+			return;
+		}
+
+		const uint8_t bits = BitsForPalette(palette.size());
+		out.push_back(bits);
+
+		if (bits == DIRECT_BITS) {
+			for (uint16_t id : values) {
+				writeU16(id);
+			}
+			return;
+		}
+
+		writeU16(static_cast<uint16_t>(palette.size()));
+		std::array<uint8_t, 65536> lookup;
+		for (size_t i = 0; i < palette.size(); ++i) {
+			writeU16(palette[i]);
+			lookup[palette[i]] = static_cast<uint8_t>(i);
+		}
+
+		// Entries never straddle a byte: widths are 1, 2, 4 or 8
+		const size_t base = out.size();
+		out.resize(base + SECTION_VOLUME * bits / 8, 0);
+		for (uint32_t i = 0; i < SECTION_VOLUME; ++i) {
+			const uint32_t bit = i * bits;
+			out[base + (bit >> 3)] |= static_cast<uint8_t>(lookup[values[i]] << (bit & 7));
+		}
+	}
+
+	size_t ChunkSection::Deserialize(const uint8_t* data, size_t size)
+	{
+		auto readU16 = [data](size_t offset) {
+			return static_cast<uint16_t>(data[offset] | (data[offset + 1] << 8));
+		};
+
+		if (size < 3) {
+			return 0;
+		}
+
+		const uint8_t bits = data[0];
+		if (bits == 0) {
+			Fill(readU16(1));
+			return 3;
+		}
+		if (bits != 1 && bits != 2 && bits != 4 && bits != 8 && bits != DIRECT_BITS) {
+			return 0;
+		}
+
+		const uint32_t paletteSize = bits == DIRECT_BITS ? 0u : readU16(1);
+		const size_t paletteOffset = 3;
+		const size_t dataOffset = bits == DIRECT_BITS ? 1 : paletteOffset + paletteSize * 2;
+		const size_t needed = dataOffset + SECTION_VOLUME * bits / 8;
+		if (size < needed || (bits != DIRECT_BITS && (paletteSize == 0 || paletteSize > (1u << bits)))) {
+			return 0;
+		}
+
+		auto buffer = std::make_unique<Buffer>(bits);
+		for (uint32_t i = 0; i < paletteSize; ++i) {
+			if (buffer->FindOrAdd(readU16(paletteOffset + i * 2)) != static_cast<int32_t>(i)) {
+				return 0;                                  // Duplicate palette entry
+			}
+		}
+
+		// The wire packs entries LSB first at the buffer's own width, so each
+		// word is just eight little-endian bytes; no per-entry re-encoding
+		const uint8_t* packed = data + dataOffset;
+		for (uint32_t w = 0; w < buffer->wordCount; ++w) {
+			uint64_t word = 0;
+			for (uint32_t b = 0; b < 8; ++b) {
+				word |= static_cast<uint64_t>(packed[w * 8 + b]) << (b * 8);
+			}
+			buffer->words[w].store(word, std::memory_order_relaxed);
+		}
+
+		uint32_t solid = 0;
+		uint32_t nonAir = 0;
+		if (bits == DIRECT_BITS) {
+			for (uint32_t i = 0; i < SECTION_VOLUME; ++i) {
+				const auto& props = BlockPropertyTable::Get(readU16(dataOffset + i * 2));
+				solid += props.isSolid ? 1u : 0u;
+				nonAir += props.isAir ? 0u : 1u;
+			}
+		} else {
+			std::array<uint32_t, 256> histogram{};
+			switch (bits) {
+				case 1: CountIndices<1>(packed, histogram.data()); break;
+				case 2: CountIndices<2>(packed, histogram.data()); break;
+				case 4: CountIndices<4>(packed, histogram.data()); break;
+				default: CountIndices<8>(packed, histogram.data()); break;
+			}
+
+			uint32_t used = 0;
+			uint16_t usedId = 0;
+			for (uint32_t i = 0; i < histogram.size(); ++i) {
+				if (histogram[i] == 0) {
+					continue;
+				}
+				if (i >= paletteSize) {
+					return 0;                              // Index past the palette
+				}
+				const uint16_t id = buffer->palette[i].load(std::memory_order_relaxed);
+				const auto& props = BlockPropertyTable::Get(id);
+				solid += props.isSolid ? histogram[i] : 0u;
+				nonAir += props.isAir ? 0u : histogram[i];
+				usedId = id;
+				++used;
+			}
+
+			if (used == 1) {
+				Fill(usedId);
+				return needed;
+			}
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_writeMutex);
+			Publish(std::move(buffer));
+			m_solidCount.store(solid, std::memory_order_relaxed);
+			m_nonAirCount.store(nonAir, std::memory_order_relaxed);
+		}
+		return needed;
+	}
+
+	void ChunkSection::Compact()
+	{
+		std::lock_guard<std::mutex> lock(m_writeMutex);
+
+		const Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+		if (buffer) {
+			std::vector<uint16_t> values(SECTION_VOLUME);
+			Unpack(values.data());
+
+			std::vector<uint16_t> palette(values);
+			std::sort(palette.begin(), palette.end());
+			palette.erase(std::unique(palette.begin(), palette.end()), palette.end());
+
+			if (palette.size() == 1) {
+				m_uniformId.store(palette[0], std::memory_order_relaxed);
+				Publish(nullptr);
+			} else {
+				const uint8_t bits = BitsForPalette(palette.size());
+				if (bits != buffer->bitsPerEntry || palette.size() != buffer->paletteSize) {
+					Publish(Build(bits, values.data(), palette));
+				}
+			}
+		}
+
+		m_retired.clear();
+	}
+
+	void ChunkSection::ReclaimRetired()
+	{
+		std::lock_guard<std::mutex> lock(m_writeMutex);
+		m_retired.clear();
+	}
+
+	uint8_t ChunkSection::GetBitsPerEntry() const
+	{
+		const Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+		return buffer ? buffer->bitsPerEntry : 0;
+	}
+
+	size_t ChunkSection::GetMemoryUsage() const
+	{
+		size_t memory = sizeof(ChunkSection);
+
+		if (m_ownedBuffer) {
+			memory += m_ownedBuffer->GetMemoryUsage();
+		}
+		for (const auto& retired : m_retired) {
+			memory += retired->GetMemoryUsage();
+		}
+
+		return memory;
+	}
+
+	std::unique_ptr<ChunkSection::Buffer> ChunkSection::Build(uint8_t bits, const uint16_t* values,
+		const std::vector<uint16_t>& palette)
+	{
+		auto buffer = std::make_unique<Buffer>(bits);
+
+		if (bits == DIRECT_BITS) {
+			for (uint32_t i = 0; i < SECTION_VOLUME; ++i) {
+				buffer->WriteRaw(i, values[i]);
+			}
+			return buffer;
+		}
+
+		for (uint16_t id : palette) {
+			buffer->FindOrAdd(id);
+		}
+		for (uint32_t i = 0; i < SECTION_VOLUME; ++i) {
+			buffer->WriteRaw(i, buffer->lookup[values[i]]);
+		}
+		return buffer;
+	}
+
+	void ChunkSection::Publish(std::unique_ptr<Buffer> buffer)
+	{
+		m_buffer.store(buffer.get(), std::memory_order_release);
+
+		// Readers may still hold the old pointer; keep it alive until the
+		// owner reclaims at a point where no reads are in flight.
+		if (m_ownedBuffer) {
+			m_retired.push_back(std::move(m_ownedBuffer));
+		}
+		m_ownedBuffer = std::move(buffer);
+	}
+
+	void ChunkSection::UpdateCounts(uint16_t oldId, uint16_t newId)
+	{
+		const auto& oldProps = BlockPropertyTable::Get(oldId);
+		const auto& newProps = BlockPropertyTable::Get(newId);
+
+		if (oldProps.isSolid != newProps.isSolid) {
+			if (newProps.isSolid) {
+				m_solidCount.fetch_add(1, std::memory_order_relaxed);
+			} else {
+				m_solidCount.fetch_sub(1, std::memory_order_relaxed);
+			}
+		}
+
+		if (oldProps.isAir != newProps.isAir) {
+			if (newProps.isAir) {
+				m_nonAirCount.fetch_sub(1, std::memory_order_relaxed);
+			} else {
+				m_nonAirCount.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	uint8_t ChunkSection::NextBits(uint8_t bits)
+	{
+		return bits >= MAX_PALETTE_BITS ? DIRECT_BITS : static_cast<uint8_t>(bits * 2);
+	}
+
+	uint8_t ChunkSection::BitsForPalette(size_t paletteSize)
+	{
+		uint8_t bits = 1;
+		while (bits <= MAX_PALETTE_BITS && (1u << bits) < paletteSize) {
+			bits = NextBits(bits);
+		}
+		return bits;
+	}
+
+	// ------------------------------------------------------------------
+	// ChunkBlockStorage
+	// ------------------------------------------------------------------
+
+	void ChunkBlockStorage::Fill(uint16_t id)
+	{
+		for (auto& section : m_sections) {
+			section.Fill(id);
+		}
+	}
+
+	void ChunkBlockStorage::Compact()
+	{
+		for (auto& section : m_sections) {
+			section.Compact();
+		}
+	}
+
+	void ChunkBlockStorage::ReclaimRetired()
+	{
+		for (auto& section : m_sections) {
+			section.ReclaimRetired();
+		}
+	}
+
+	uint32_t ChunkBlockStorage::GetSolidBlockCount() const
+	{
+		uint32_t count = 0;
+		for (const auto& section : m_sections) {
+			count += section.GetSolidCount();
+		}
+		return count;
+	}
+
+	uint32_t ChunkBlockStorage::GetNonAirBlockCount() const
+	{
+		uint32_t count = 0;
+		for (const auto& section : m_sections) {
+			count += section.GetNonAirCount();
+		}
+		return count;
+	}
+
+	void ChunkBlockStorage::Serialize(std::vector<uint8_t>& out) const
+	{
+		for (const auto& section : m_sections) {
+			section.Serialize(out);
+		}
+	}
+
+	size_t ChunkBlockStorage::Deserialize(const uint8_t* data, size_t size)
+	{
+		size_t offset = 0;
+		for (auto& section : m_sections) {
+			const size_t consumed = section.Deserialize(data + offset, size - offset);
+			if (consumed == 0) {
+				return 0;
+			}
+			offset += consumed;
+		}
+		return offset;
+	}
+
+	size_t ChunkBlockStorage::GetMemoryUsage() const
+	{
+		size_t memory = 0;
+		for (const auto& section : m_sections) {
+			memory += section.GetMemoryUsage();
+		}
+		return memory;
+	}
+
+} // namespace VoxelCraft
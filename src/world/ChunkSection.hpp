@@ -0,0 +1,305 @@
+/**
+ * @file ChunkSection.hpp
+ * @brief VoxelCraft World System - Palette-compressed chunk block storage
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#pragma once
+#include <memory>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <cstdint>
+
+namespace VoxelCraft {
+
+	/**
+	 * @brief Block storage for one 16x16x16 section of a chunk
+	 *
+	 * Blocks are stored as indices into a per-section palette, bit-packed into
+	 * 64-bit words. The width grows through 1, 2, 4 and 8 bits per entry as the
+	 * palette fills up; beyond 256 distinct IDs the section switches to direct
+	 * 16-bit storage without a palette. A section holding a single block type
+	 * keeps no buffer at all (uniform fast path).
+	 *
+	 * Concurrency:
+	 * - Get() is lock-free and never blocks on writers.
+	 * - Set()/Fill() serialize on a per-section writer mutex.
+	 * - Growing the bit width is copy-on-write: a new buffer is built and
+	 *   published atomically, and the old one is retired rather than freed so
+	 *   in-flight readers stay valid. Palette entries are append-only.
+	 * - Compact() and ReclaimRetired() require exclusive access (no readers),
+	 *   e.g. while the owning chunk is generating or being unloaded.
+	 */
+	class ChunkSection
+	{
+	public:
+		static constexpr uint32_t SECTION_SIZE = 16;
+		static constexpr uint32_t SECTION_VOLUME = SECTION_SIZE * SECTION_SIZE * SECTION_SIZE;
+		static constexpr uint8_t MAX_PALETTE_BITS = 8;
+		static constexpr uint8_t DIRECT_BITS = 16;
+
+		/**
+		 * @brief Constructor
+		 * @param fillId Block ID the section is uniformly filled with
+		 */
+		explicit ChunkSection(uint16_t fillId = 0);
+
+		/**
+		 * @brief Destructor
+		 */
+		~ChunkSection();
+
+		ChunkSection(const ChunkSection&) = delete;
+		ChunkSection& operator=(const ChunkSection&) = delete;
+
+		/**
+		 * @brief Get index from section-local coordinates (x fastest, then z, then y)
+		 */
+		static uint32_t GetIndex(uint32_t x, uint32_t y, uint32_t z) {
+			return (y << 8) | (z << 4) | x;
+		}
+
+		/**
+		 * @brief Get block ID at index (lock-free)
+		 */
+		uint16_t Get(uint32_t index) const
+		{
+			const Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+			if (!buffer) {
+				return m_uniformId.load(std::memory_order_relaxed);
+			}
+
+			const uint32_t raw = buffer->ReadRaw(index);
+			if (buffer->bitsPerEntry == DIRECT_BITS) {
+				return static_cast<uint16_t>(raw);
+			}
+			return buffer->palette[raw].load(std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Set block ID at index
+		 * @return Previous block ID
+		 */
+		uint16_t Set(uint32_t index, uint16_t id);
+
+		/**
+		 * @brief Fill the whole section with one block ID
+		 */
+		void Fill(uint16_t id);
+
+		/**
+		 * @brief Decode all 4096 block IDs into out (in GetIndex order)
+		 */
+		void Unpack(uint16_t* out) const;
+
+		/**
+		 * @brief Append the section's wire form to out
+		 *
+		 * One width byte (0 = uniform, then a u16 ID), otherwise a u16 palette
+		 * size, the palette and the indices bit-packed LSB first; width 16 has
+		 * no palette. Integers are little-endian.
+		 */
+		void Serialize(std::vector<uint8_t>& out) const;
+
+		/**
+		 * @brief Load the wire form written by Serialize
+		 * @return Bytes consumed, or 0 if the data is malformed
+		 */
+		size_t Deserialize(const uint8_t* data, size_t size);
+
+		/**
+		 * @brief Drop unused palette entries and shrink to the minimal width
+		 *
+		 * Requires exclusive access. Collapses to the uniform fast path when
+		 * only one block ID remains.
+		 */
+		void Compact();
+
+		/**
+		 * @brief Free buffers retired by copy-on-write growth
+		 *
+		 * Requires exclusive access.
+		 */
+		void ReclaimRetired();
+
+		/**
+		 * @brief Check if section holds a single block ID
+		 */
+		bool IsUniform() const { return m_buffer.load(std::memory_order_acquire) == nullptr; }
+
+		/**
+		 * @brief Get uniform block ID (only meaningful if IsUniform())
+		 */
+		uint16_t GetUniformId() const { return m_uniformId.load(std::memory_order_relaxed); }
+
+		/**
+		 * @brief Get current bits per entry (0 for uniform sections)
+		 */
+		uint8_t GetBitsPerEntry() const;
+
+		/**
+		 * @brief Get number of solid blocks
+		 */
+		uint32_t GetSolidCount() const { return m_solidCount.load(std::memory_order_relaxed); }
+
+		/**
+		 * @brief Get number of non-air blocks
+		 */
+		uint32_t GetNonAirCount() const { return m_nonAirCount.load(std::memory_order_relaxed); }
+
+		/**
+		 * @brief Get memory usage in bytes, including retired buffers
+		 */
+		size_t GetMemoryUsage() const;
+
+	private:
+		/**
+		 * @brief Packed entry buffer, immutable in shape once published
+		 */
+		struct Buffer
+		{
+			uint8_t bitsPerEntry;                              // 1, 2, 4, 8 or DIRECT_BITS
+			uint8_t bitsLog2;
+			uint32_t paletteCapacity;
+			uint32_t paletteSize;                              // Writer-only
+			uint32_t wordCount;
+			std::unique_ptr<std::atomic<uint16_t>[]> palette;  // Append-only
+			std::unique_ptr<std::atomic<uint64_t>[]> words;
+			std::unordered_map<uint16_t, uint16_t> lookup;     // Writer-only: ID -> palette index
+
+			explicit Buffer(uint8_t bits);
+
+			uint32_t ReadRaw(uint32_t index) const
+			{
+				const uint32_t entriesLog2 = 6u - bitsLog2;
+				const uint64_t word = words[index >> entriesLog2].load(std::memory_order_acquire);
+				const uint32_t shift = (index & ((1u << entriesLog2) - 1u)) << bitsLog2;
+				const uint64_t mask = (uint64_t(1) << bitsPerEntry) - 1u;
+				return static_cast<uint32_t>((word >> shift) & mask);
+			}
+
+			void WriteRaw(uint32_t index, uint32_t value);
+
+			/**
+			 * @brief Find or append palette entry, returns -1 if full
+			 */
+			int32_t FindOrAdd(uint16_t id);
+
+			size_t GetMemoryUsage() const;
+		};
+
+		std::atomic<Buffer*> m_buffer;
+		std::unique_ptr<Buffer> m_ownedBuffer;
+		std::vector<std::unique_ptr<Buffer>> m_retired;
+		std::atomic<uint16_t> m_uniformId;
+		std::atomic<uint32_t> m_solidCount;
+		std::atomic<uint32_t> m_nonAirCount;
+		std::mutex m_writeMutex;
+
+		/**
+		 * @brief Build a buffer of the given width from decoded block IDs
+		 * @param palette Palette order to use (ignored for direct storage)
+		 */
+		static std::unique_ptr<Buffer> Build(uint8_t bits, const uint16_t* values,
+			const std::vector<uint16_t>& palette);
+
+		/**
+		 * @brief Publish a new buffer and retire the old one
+		 */
+		void Publish(std::unique_ptr<Buffer> buffer);
+
+		/**
+		 * @brief Update solid and non-air counts for a block replacement
+		 */
+		void UpdateCounts(uint16_t oldId, uint16_t newId);
+
+		/**
+		 * @brief Next width after bits
+		 */
+		static uint8_t NextBits(uint8_t bits);
+
+		/**
+		 * @brief Smallest width whose palette holds paletteSize IDs
+		 */
+		static uint8_t BitsForPalette(size_t paletteSize);
+	};
+
+	/**
+	 * @brief Sectioned block storage for a full 16x256x16 chunk column
+	 */
+	class ChunkBlockStorage
+	{
+	public:
+		static constexpr uint32_t COLUMN_HEIGHT = 256;
+		static constexpr uint32_t SECTION_COUNT = COLUMN_HEIGHT / ChunkSection::SECTION_SIZE;
+
+		/**
+		 * @brief Get block ID at local coordinates (lock-free)
+		 */
+		uint16_t Get(uint8_t x, uint8_t y, uint8_t z) const {
+			return m_sections[y >> 4].Get(ChunkSection::GetIndex(x, y & 15u, z));
+		}
+
+		/**
+		 * @brief Set block ID at local coordinates
+		 * @return Previous block ID
+		 */
+		uint16_t Set(uint8_t x, uint8_t y, uint8_t z, uint16_t id) {
+			return m_sections[y >> 4].Set(ChunkSection::GetIndex(x, y & 15u, z), id);
+		}
+
+		/**
+		 * @brief Fill every section with one block ID
+		 */
+		void Fill(uint16_t id);
+
+		/**
+		 * @brief Compact all sections (requires exclusive access)
+		 */
+		void Compact();
+
+		/**
+		 * @brief Free retired section buffers (requires exclusive access)
+		 */
+		void ReclaimRetired();
+
+		/**
+		 * @brief Get section by vertical index
+		 */
+		const ChunkSection& GetSection(uint32_t sectionY) const { return m_sections[sectionY]; }
+
+		/**
+		 * @brief Append all sections' wire form to out
+		 */
+		void Serialize(std::vector<uint8_t>& out) const;
+
+		/**
+		 * @brief Load all sections from the form written by Serialize
+		 * @return Bytes consumed, or 0 if the data is malformed
+		 */
+		size_t Deserialize(const uint8_t* data, size_t size);
+
+		/**
+		 * @brief Get total solid block count
+		 */
+		uint32_t GetSolidBlockCount() const;
+
+		/**
+		 * @brief Get total non-air block count
+		 */
+		uint32_t GetNonAirBlockCount() const;
+
+		/**
+		 * @brief Get memory usage in bytes
+		 */
+		size_t GetMemoryUsage() const;
+
+	private:
+		std::array<ChunkSection, SECTION_COUNT> m_sections;
+	};
+
+} // namespace VoxelCraft
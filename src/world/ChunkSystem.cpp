@@ -1,14 +1,21 @@
 #include "ChunkSystem.hpp"
 #include "Chunk.hpp"
+#include "ChunkPipeline.hpp"
+#include "RegionFile.hpp"
+#include "ChunkCodec.hpp"
+#include "CompressedChunkCache.hpp"
+#include "SectionCulling.hpp"
+#include "LightPropagator.hpp"
 #include "TerrainGenerator.hpp"
 #include "Biome.hpp"
 #include "Block.hpp"
 #include "World.hpp"
+#include "blocks/BlockMeshGenerator.hpp"
+#include "core/WorkStealingPool.hpp"
 #include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <sstream>
-#include <zlib.h>
 #include <memory>
 
 namespace VoxelCraft {
@@ -16,13 +23,17 @@ namespace VoxelCraft {
 	ChunkSystem::ChunkSystem(const ChunkSystemConfig& config)
 		: m_config(config)
 		, m_world(nullptr)
+		, m_hasLegacyChunkFiles(false)
 		, m_initialized(false)
-		, m_generating(true)
 		, m_saving(true)
+		, m_recompressedChunks(0)
+		, m_nextListenerId(1)
+		, m_sectionCuller(std::make_unique<SectionOcclusionCuller>())
 		, m_playerChunk(0, 0)
 	{
 		// Initialize statistics
 		std::memset(&m_stats, 0, sizeof(ChunkSystemStats));
+		std::memset(m_lastStageCompleted, 0, sizeof(m_lastStageCompleted));
 
 		VOXELCRAFT_LOG_INFO("ChunkSystem initialized with config: maxChunks={}, renderDistance={}",
 			config.maxLoadedChunks, config.renderDistance);
@@ -45,13 +56,45 @@ namespace VoxelCraft {
 		// Initialize terrain generator
 		m_terrainGenerator = std::make_shared<TerrainGenerator>();
 
-		// Start worker threads
-		if (m_config.enableMultithreading) {
-			m_generating = true;
-			for (uint32_t i = 0; i < m_config.generationThreads; ++i) {
-				m_generationThreads.emplace_back(&ChunkSystem::GenerationThreadFunction, this);
+		// Initialize light propagation (neighbor-aware; queued edits run as pipeline updates)
+		m_lightPropagator = std::make_unique<LightPropagator>(
+			[this](const ChunkCoord& coord) { return GetChunk(coord); });
+		// Meshes bake light in, so every chunk whose light changed is re-meshed
+		m_lightPropagator->SetLightChangedCallback([this](const ChunkCoord& coord) {
+			if (m_pipeline) {
+				m_pipeline->RequestRemesh(coord);
 			}
+		});
+
+		m_meshGenerator = std::make_unique<BlockMeshGenerator>();
+		m_meshGenerator->Initialize();
+
+		// Stage workers; without multithreading Update() runs stages inline
+		if (m_config.enableMultithreading) {
+			m_workerPool = std::make_unique<WorkStealingPool>(m_config.generationThreads);
+			m_workerPool->Initialize();
+		}
 
+		ChunkStageHandlers handlers;
+		handlers.generate = [this](const ChunkCoord& coord, ChunkStage& reached) { return RunGenerateStage(coord, reached); };
+		handlers.decorate = [this](const ChunkNeighborhood& area) { RunDecorateStage(area); };
+		handlers.light = [this](const ChunkNeighborhood& area) { RunLightStage(area); };
+		handlers.mesh = [this](const ChunkNeighborhood& area) { RunMeshStage(area); };
+		handlers.update = [this](const ChunkNeighborhood& area) { RunLightUpdate(area); };
+
+		m_pipeline = std::make_unique<ChunkPipeline>(std::move(handlers), m_workerPool.get());
+		m_pipeline->SetStageCallback([this](const std::shared_ptr<Chunk>& chunk, ChunkStage stage) {
+			OnStageCompleted(chunk, stage);
+		});
+
+		m_chunkCache = std::make_unique<CompressedChunkCache>(m_config.chunkCacheBudget, m_config.chunkCachePolicy);
+
+		// 32x32 chunks per region file; old per-chunk files are still read
+		m_regionStorage = std::make_unique<RegionStorage>("world/region");
+		m_hasLegacyChunkFiles = std::filesystem::is_directory(
+			std::filesystem::path(GetChunkFilePath(ChunkCoord(0, 0))).parent_path());
+
+		if (m_config.enableMultithreading) {
 			m_saving = true;
 			m_saveThread = std::thread(&ChunkSystem::SaveThreadFunction, this);
 		}
@@ -59,6 +102,7 @@ namespace VoxelCraft {
 		// Initialize timing
 		m_lastCleanupTime = std::chrono::steady_clock::now();
 		m_lastStatsUpdate = std::chrono::steady_clock::now();
+		m_lastSaveTime = std::chrono::steady_clock::now();
 
 		m_initialized = true;
 		VOXELCRAFT_LOG_INFO("ChunkSystem initialized successfully");
@@ -73,37 +117,48 @@ namespace VoxelCraft {
 
 		VOXELCRAFT_LOG_INFO("Shutting down ChunkSystem...");
 
-		// Stop worker threads
-		m_generating = false;
-		m_saving = false;
-
-		{
-			std::unique_lock<std::mutex> lock(m_generationMutex);
-			m_generationCV.notify_all();
+		// Stop the pipeline before the workers its running stages live on
+		if (m_pipeline) {
+			m_pipeline->Shutdown();
+			m_pipeline.reset();
 		}
+		if (m_workerPool) {
+			m_workerPool->Shutdown();
+			m_workerPool.reset();
+		}
+
+		m_saving = false;
 
 		{
 			std::unique_lock<std::mutex> lock(m_saveMutex);
 			m_saveCV.notify_all();
 		}
 
-		for (auto& thread : m_generationThreads) {
-			if (thread.joinable()) {
-				thread.join();
-			}
-		}
-		m_generationThreads.clear();
-
 		if (m_saveThread.joinable()) {
 			m_saveThread.join();
 		}
 
 		// Save all chunks
 		SaveAllChunks();
+		if (m_regionStorage) {
+			m_regionStorage->Flush();
+			m_regionStorage.reset();
+		}
 
-		// Clear all data
+		// Clear all data; SaveAllChunks left nothing dirty in the cache
 		m_chunks.clear();
-		m_compressedChunks.clear();
+		std::vector<DirtyChunkFrame> unsaved;
+		m_chunkCache->Clear(unsaved);
+		{
+			std::unique_lock<std::mutex> lock(m_meshMutex);
+			m_chunkMeshes.clear();
+			m_sectionCuller->Clear();
+			m_visibleSections.clear();
+		}
+		{
+			std::unique_lock<std::mutex> lock(m_callbackMutex);
+			m_readyCallbacks.clear();
+		}
 		m_world = nullptr;
 		m_initialized = false;
 
@@ -125,7 +180,10 @@ namespace VoxelCraft {
 		// Update chunk priorities
 		UpdateChunkPriorities();
 
-		// Process generation queue
+		// Queue relights and block light updates behind the stages they overlap
+		ProcessLightQueue();
+
+		// Run pipeline stages and updates inline if there are no workers
 		ProcessGenerationQueue();
 
 		// Process save queue
@@ -166,6 +224,53 @@ namespace VoxelCraft {
 		}
 	}
 
+	void ChunkSystem::Render(const ViewFrustum& frustum, float cameraX, float cameraY, float cameraZ)
+	{
+		if (!m_initialized) {
+			return;
+		}
+
+		// Only meshed chunks have connectivity, so the culler's chunk set is
+		// the renderable set; frustum culling off means an all-inside frustum
+		std::vector<ChunkCoord> chunksToRender;
+		{
+			std::unique_lock<std::mutex> lock(m_meshMutex);
+			m_sectionCuller->Cull(m_config.enableFrustumCulling ? frustum : ViewFrustum(),
+				cameraX, cameraY, cameraZ, static_cast<int>(m_config.renderDistance),
+				m_config.enableOcclusionCulling, m_visibleSections);
+
+			const SectionCullingStats& culling = m_sectionCuller->GetStats();
+			m_stats.cullingTests = culling.cullingTests;
+			m_stats.cullingPassed = culling.cullingPassed;
+			m_stats.occlusionTests = culling.occlusionTests;
+			m_stats.occlusionPassed = culling.occlusionPassed;
+
+			// Chunk meshes are not split by section yet: draw each chunk once,
+			// in the order its first section survived (front to back when walking)
+			std::unordered_set<ChunkCoord> seen;
+			for (const VisibleSection& section : m_visibleSections) {
+				if (seen.insert(section.chunk).second) {
+					chunksToRender.push_back(section.chunk);
+				}
+			}
+		}
+
+		std::unique_lock<std::mutex> lock(m_chunkMutex);
+		for (const ChunkCoord& coord : chunksToRender) {
+			auto it = m_chunks.find(coord);
+			if (it != m_chunks.end() && it->second && it->second->GetState() == ChunkState::READY) {
+				it->second->Render();
+				m_stats.renderedChunks++;
+			}
+		}
+	}
+
+	std::vector<VisibleSection> ChunkSystem::GetVisibleSections() const
+	{
+		std::unique_lock<std::mutex> lock(m_meshMutex);
+		return m_visibleSections;
+	}
+
 	std::shared_ptr<Chunk> ChunkSystem::GetChunk(const ChunkCoord& coord)
 	{
 		std::unique_lock<std::mutex> lock(m_chunkMutex);
@@ -191,22 +296,32 @@ namespace VoxelCraft {
 			return;
 		}
 
-		ChunkRequest request;
-		request.coord = coord;
-		request.priority = priority;
-		request.timestamp = std::chrono::steady_clock::now();
-		request.callback = callback;
-
-		{
-			std::unique_lock<std::mutex> lock(m_generationMutex);
-			m_generationQueue.push(request);
+		if (callback) {
+			std::unique_lock<std::mutex> lock(m_callbackMutex);
+			m_readyCallbacks[coord].push_back(std::move(callback));
 		}
 
-		m_generationCV.notify_one();
+		m_pipeline->Request(coord, ChunkStage::READY, priority);
+
+		// Already ready: OnStageCompleted will not run again for it. Checked after
+		// registering so a chunk turning ready concurrently fires exactly once.
+		auto chunk = GetChunk(coord);
+		if (chunk && chunk->GetState() == ChunkState::READY) {
+			FireReadyCallbacks(coord, chunk);
+		}
 	}
 
 	void ChunkSystem::UnloadChunk(const ChunkCoord& coord)
 	{
+		if (m_pipeline) {
+			m_pipeline->Remove(coord);
+		}
+		{
+			std::unique_lock<std::mutex> lock(m_meshMutex);
+			m_chunkMeshes.erase(coord);
+			m_sectionCuller->RemoveChunk(coord);
+		}
+
 		std::unique_lock<std::mutex> lock(m_chunkMutex);
 
 		auto it = m_chunks.find(coord);
@@ -214,19 +329,7 @@ namespace VoxelCraft {
 			auto& chunk = it->second;
 			if (chunk) {
 				chunk->SetState(ChunkState::UNLOADING);
-
-				// Save chunk before unloading if modified
-				if (chunk->IsModified()) {
-					SaveChunk(coord);
-				}
-
-				// Compress and cache chunk
-				if (m_config.enableCompression) {
-					auto compressed = CompressChunk(chunk);
-					if (compressed.size() < m_config.chunkCacheSize) {
-						m_compressedChunks[coord] = compressed;
-					}
-				}
+				CacheUnloadedChunk(coord, chunk);
 			}
 
 			m_chunks.erase(it);
@@ -243,6 +346,7 @@ namespace VoxelCraft {
 		{
 			std::unique_lock<std::mutex> lock(m_saveMutex);
 			m_saveQueue.push(coord);
+			m_lastSaveTime = std::chrono::steady_clock::now();
 		}
 
 		m_saveCV.notify_one();
@@ -263,6 +367,20 @@ namespace VoxelCraft {
 			}
 		}
 
+		// Unloaded chunks whose saves have not been written yet
+		std::vector<DirtyChunkFrame> unsaved;
+		m_chunkCache->CopyAllDirty(unsaved);
+		{
+			std::unique_lock<std::mutex> saveLock(m_saveMutex);
+			for (auto& pair : m_evictedDirtyChunks) {
+				unsaved.push_back({ pair.first, std::move(pair.second) });
+			}
+			m_evictedDirtyChunks.clear();
+		}
+		for (const auto& frame : unsaved) {
+			SaveChunkToDisk(frame.coord, frame.data);
+		}
+
 		VOXELCRAFT_LOG_INFO("All chunks saved");
 	}
 
@@ -293,9 +411,24 @@ namespace VoxelCraft {
 		}
 
 		auto blockCoord = coord.toBlockCoord();
+		uint16_t oldId = chunk->GetBlockId(blockCoord.x, blockCoord.y, blockCoord.z);
 		chunk->SetBlock(blockCoord.x, blockCoord.y, blockCoord.z, block);
 		chunk->SetModified(true);
 
+		uint16_t newId = block ? static_cast<uint16_t>(block->GetType()) : 0;
+		if (m_lightPropagator && oldId != newId) {
+			m_lightPropagator->QueueBlockChange(coord, oldId, newId);
+		}
+		if (oldId != newId) {
+			for (const auto& listener : m_blockChangeListeners) {
+				listener.second(coord, oldId, newId);
+			}
+		}
+
+		if (oldId != newId) {
+			RemeshAroundBlock(chunkCoord, blockCoord.x, blockCoord.z);
+		}
+
 		// Update neighboring chunks if on boundary
 		if (blockCoord.x == 0) {
 			auto neighbor = GetChunk(ChunkCoord(chunkCoord.x - 1, chunkCoord.z));
@@ -314,6 +447,19 @@ namespace VoxelCraft {
 		}
 	}
 
+	uint32_t ChunkSystem::AddBlockChangeListener(BlockChangeListener listener)
+	{
+		const uint32_t id = m_nextListenerId++;
+		m_blockChangeListeners.emplace_back(id, std::move(listener));
+		return id;
+	}
+
+	void ChunkSystem::RemoveBlockChangeListener(uint32_t id)
+	{
+		m_blockChangeListeners.erase(std::remove_if(m_blockChangeListeners.begin(), m_blockChangeListeners.end(),
+			[id](const auto& listener) { return listener.first == id; }), m_blockChangeListeners.end());
+	}
+
 	std::shared_ptr<Biome> ChunkSystem::GetBiome(const WorldCoord& coord)
 	{
 		if (!m_terrainGenerator) {
@@ -389,11 +535,17 @@ namespace VoxelCraft {
 			return existing;
 		}
 
-		// Generate new chunk
+		// Generate new chunk; the pipeline adopts it and runs the later stages
 		auto chunk = GenerateChunk(coord);
 		if (chunk) {
-			std::unique_lock<std::mutex> lock(m_chunkMutex);
-			m_chunks[coord] = chunk;
+			{
+				std::unique_lock<std::mutex> lock(m_chunkMutex);
+				chunk = m_chunks.emplace(coord, chunk).first->second;
+			}
+
+			if (m_pipeline) {
+				m_pipeline->Request(coord, ChunkStage::READY, ChunkPriority::CRITICAL);
+			}
 		}
 
 		return chunk;
@@ -401,8 +553,9 @@ namespace VoxelCraft {
 
 	void ChunkSystem::ClearCache()
 	{
-		std::unique_lock<std::mutex> lock(m_chunkMutex);
-		m_compressedChunks.clear();
+		std::vector<DirtyChunkFrame> unsaved;
+		m_chunkCache->Clear(unsaved);
+		QueueEvictedChunks(unsaved);
 		VOXELCRAFT_LOG_INFO("Chunk cache cleared");
 	}
 
@@ -420,13 +573,31 @@ namespace VoxelCraft {
 		}
 
 		// Add compressed chunks memory
-		for (auto& pair : m_compressedChunks) {
-			memory += pair.second.size();
+		memory += m_chunkCache->GetStats().bytes;
+
+		// Add meshes
+		{
+			std::unique_lock<std::mutex> meshLock(m_meshMutex);
+			for (auto& pair : m_chunkMeshes) {
+				memory += pair.second->GetMemoryUsage();
+			}
 		}
 
 		return memory;
 	}
 
+	ChunkStage ChunkSystem::GetChunkStage(const ChunkCoord& coord) const
+	{
+		return m_pipeline ? m_pipeline->GetStage(coord) : ChunkStage::NONE;
+	}
+
+	std::shared_ptr<const PackedChunkMesh> ChunkSystem::GetChunkMesh(const ChunkCoord& coord) const
+	{
+		std::unique_lock<std::mutex> lock(m_meshMutex);
+		auto it = m_chunkMeshes.find(coord);
+		return it != m_chunkMeshes.end() ? it->second : nullptr;
+	}
+
 	std::shared_ptr<Chunk> ChunkSystem::GenerateChunk(const ChunkCoord& coord)
 	{
 		auto startTime = std::chrono::steady_clock::now();
@@ -441,7 +612,8 @@ namespace VoxelCraft {
 				m_terrainGenerator->GenerateChunk(chunk);
 			}
 
-			chunk->SetState(ChunkState::READY);
+			// READY once the pipeline has lit and meshed it
+			chunk->SetState(ChunkState::GENERATING);
 
 			auto endTime = std::chrono::steady_clock::now();
 			auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
@@ -461,25 +633,61 @@ namespace VoxelCraft {
 		auto startTime = std::chrono::steady_clock::now();
 
 		try {
-			// Check compressed cache first
+			// Check compressed cache first; decompress outside the lock so
+			// pipeline workers do not serialize on it
+			std::vector<uint8_t> cached;
+			bool unsaved = false;
 			{
-				std::unique_lock<std::mutex> lock(m_chunkMutex);
-				auto it = m_compressedChunks.find(coord);
-				if (it != m_compressedChunks.end()) {
-					auto chunk = DecompressChunk(coord, it->second);
-					if (chunk) {
-						m_compressedChunks.erase(it); // Remove from cache
-						auto endTime = std::chrono::steady_clock::now();
-						auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
-						VOXELCRAFT_LOG_DEBUG("Loaded chunk ({}, {}) from cache in {}ms", coord.x, coord.z, duration.count());
-						return chunk;
+				// Evicted before the save thread wrote it: newer than the region
+				std::unique_lock<std::mutex> lock(m_saveMutex);
+				auto it = m_evictedDirtyChunks.find(coord);
+				if (it != m_evictedDirtyChunks.end()) {
+					cached = std::move(it->second);
+					m_evictedDirtyChunks.erase(it);
+					unsaved = true;
+				}
+			}
+			if (cached.empty()) {
+				m_chunkCache->Take(coord, cached, unsaved);
+			}
+
+			if (!cached.empty()) {
+				auto chunk = DecompressChunk(coord, cached);
+				if (chunk) {
+					// Changes still pending; saved again when next unloaded or saved
+					if (unsaved) {
+						chunk->SetModified(true);
 					}
+
+					auto endTime = std::chrono::steady_clock::now();
+					auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+					VOXELCRAFT_LOG_DEBUG("Loaded chunk ({}, {}) from cache in {}ms", coord.x, coord.z, duration.count());
+					return chunk;
 				}
 			}
 
-			// Load from disk
+			// Load from the chunk's region, decoding straight out of the mapping
+			std::shared_ptr<Chunk> stored;
+			ChunkCodecType storedCodec = ChunkCodecType::COUNT;
+			const bool inRegion = m_regionStorage && m_regionStorage->ReadChunk(coord,
+				[this, &coord, &stored, &storedCodec](const uint8_t* data, size_t size) {
+					size_t rawSize = 0;
+					ChunkCompression::PeekFrame(data, size, storedCodec, rawSize);
+					stored = DecompressChunk(coord, data, size);
+				});
+			if (stored) {
+				// Chunks saved hot in an earlier session still need their cold pass
+				QueueRecompression(coord, storedCodec);
+
+				auto endTime = std::chrono::steady_clock::now();
+				auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+				VOXELCRAFT_LOG_DEBUG("Loaded chunk ({}, {}) from region in {}ms", coord.x, coord.z, duration.count());
+				return stored;
+			}
+
+			// Legacy one-file-per-chunk saves move into regions when next saved
 			auto filePath = GetChunkFilePath(coord);
-			if (std::filesystem::exists(filePath)) {
+			if (!inRegion && m_hasLegacyChunkFiles && std::filesystem::exists(filePath)) {
 				std::ifstream file(filePath, std::ios::binary);
 				if (file) {
 					std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
@@ -493,8 +701,7 @@ namespace VoxelCraft {
 				}
 			}
 
-			// Generate new chunk if not found
-			return GenerateChunk(coord);
+			return nullptr;
 		}
 		catch (const std::exception& e) {
 			VOXELCRAFT_LOG_ERROR("Failed to load chunk ({}, {}): {}", coord.x, coord.z, e.what());
@@ -502,18 +709,142 @@ namespace VoxelCraft {
 		}
 	}
 
+	std::shared_ptr<Chunk> ChunkSystem::RunGenerateStage(const ChunkCoord& coord, ChunkStage& reached)
+	{
+		// Adopt chunks ForceGenerateChunk already created
+		auto existing = GetChunk(coord);
+		if (existing) {
+			reached = ChunkStage::GENERATE;
+			return existing;
+		}
+
+		// Saved chunks were decorated before they were written
+		auto chunk = LoadChunk(coord);
+		if (chunk) {
+			chunk->SetState(ChunkState::GENERATING);
+			reached = ChunkStage::DECORATE;
+			return chunk;
+		}
+
+		reached = ChunkStage::GENERATE;
+		return GenerateChunk(coord);
+	}
+
+	void ChunkSystem::RunDecorateStage(const ChunkNeighborhood& area)
+	{
+		if (m_terrainGenerator) {
+			m_terrainGenerator->DecorateChunk(area.Center());
+		}
+	}
+
+	void ChunkSystem::RunLightStage(const ChunkNeighborhood& area)
+	{
+		// Neighbors are registered in m_chunks, so the relight can reach them
+		m_lightPropagator->RelightChunk(area.Center().get());
+	}
+
+	void ChunkSystem::RunMeshStage(const ChunkNeighborhood& area)
+	{
+		ChunkMeshNeighbors neighbors;
+		for (size_t i = 0; i < neighbors.chunks.size(); ++i) {
+			neighbors.chunks[i] = area.chunks[i].get();
+		}
+
+		auto mesh = std::make_shared<PackedChunkMesh>();
+		m_meshGenerator->GenerateChunkMesh(area.Center().get(), MeshingMode::GREEDY, neighbors, *mesh);
+
+		const ChunkCoord coord = area.Center()->GetCoord();
+		std::unique_lock<std::mutex> lock(m_meshMutex);
+		m_sectionCuller->SetChunk(coord, mesh->sectionConnectivity);
+		m_chunkMeshes[coord] = std::move(mesh);
+	}
+
+	void ChunkSystem::RemeshAroundBlock(const ChunkCoord& chunkCoord, int localX, int localZ)
+	{
+		if (!m_pipeline) {
+			return;
+		}
+
+		// Border faces and AO read one block into the neighbors, diagonals included
+		const int minX = localX == 0 ? -1 : 0;
+		const int maxX = localX == 15 ? 1 : 0;
+		const int minZ = localZ == 0 ? -1 : 0;
+		const int maxZ = localZ == 15 ? 1 : 0;
+		for (int dz = minZ; dz <= maxZ; ++dz) {
+			for (int dx = minX; dx <= maxX; ++dx) {
+				m_pipeline->RequestRemesh(ChunkCoord(chunkCoord.x + dx, chunkCoord.z + dz), ChunkPriority::CRITICAL);
+			}
+		}
+	}
+
+	void ChunkSystem::ProcessLightQueue()
+	{
+		// Queued work writes light across the chunk's 3x3 area, so it runs as a
+		// pipeline update under the same write claim LIGHT takes; an update
+		// already waiting picks up changes queued since
+		for (const ChunkCoord& coord : m_lightPropagator->GetQueuedChunks()) {
+			if (!m_pipeline->RequestUpdate(coord, ChunkPriority::CRITICAL)) {
+				m_lightPropagator->DiscardQueued(coord);
+			}
+		}
+	}
+
+	void ChunkSystem::RunLightUpdate(const ChunkNeighborhood& area)
+	{
+		m_lightPropagator->ProcessQueuedChunk(area.Center()->GetCoord());
+	}
+
+	void ChunkSystem::OnStageCompleted(const std::shared_ptr<Chunk>& chunk, ChunkStage stage)
+	{
+		const ChunkCoord coord = chunk->GetCoord();
+
+		// Join the chunk map as soon as neighbors and light may look at it
+		if (stage == ChunkStage::GENERATE || stage == ChunkStage::DECORATE) {
+			std::unique_lock<std::mutex> lock(m_chunkMutex);
+			m_chunks.emplace(coord, chunk);
+		}
+
+		if (stage == ChunkStage::READY) {
+			chunk->SetState(ChunkState::READY);
+			FireReadyCallbacks(coord, chunk);
+		}
+	}
+
+	void ChunkSystem::FireReadyCallbacks(const ChunkCoord& coord, const std::shared_ptr<Chunk>& chunk)
+	{
+		std::vector<std::function<void(std::shared_ptr<Chunk>)>> callbacks;
+		{
+			std::unique_lock<std::mutex> lock(m_callbackMutex);
+			auto it = m_readyCallbacks.find(coord);
+			if (it == m_readyCallbacks.end()) {
+				return;
+			}
+			callbacks = std::move(it->second);
+			m_readyCallbacks.erase(it);
+		}
+
+		for (auto& callback : callbacks) {
+			callback(chunk);
+		}
+	}
+
 	void ChunkSystem::SaveChunkToDisk(const ChunkCoord& coord, const std::vector<uint8_t>& data)
 	{
 		try {
-			auto filePath = GetChunkFilePath(coord);
-
-			// Create directory if it doesn't exist
-			std::filesystem::create_directories(std::filesystem::path(filePath).parent_path());
+			bool written = false;
+			{
+				std::unique_lock<std::mutex> lock(m_regionWriteMutex);
+				written = m_regionStorage && m_regionStorage->WriteChunk(coord, data.data(), data.size());
+			}
 
-			std::ofstream file(filePath, std::ios::binary);
-			if (file) {
-				file.write(reinterpret_cast<const char*>(data.data()), data.size());
+			if (written) {
 				VOXELCRAFT_LOG_DEBUG("Saved chunk ({}, {}) to disk", coord.x, coord.z);
+
+				ChunkCodecType codec;
+				size_t rawSize;
+				if (ChunkCompression::PeekFrame(data.data(), data.size(), codec, rawSize)) {
+					QueueRecompression(coord, codec);
+				}
 			} else {
 				VOXELCRAFT_LOG_ERROR("Failed to save chunk ({}, {}) to disk", coord.x, coord.z);
 			}
@@ -523,64 +854,202 @@ namespace VoxelCraft {
 		}
 	}
 
-	std::vector<uint8_t> ChunkSystem::CompressChunk(const std::shared_ptr<Chunk>& chunk)
+	void ChunkSystem::SaveQueuedChunk(const ChunkCoord& coord)
+	{
+		auto chunk = GetChunk(coord);
+		if (chunk && chunk->IsModified()) {
+			// The live chunk supersedes any frame evicted before it was reloaded
+			{
+				std::unique_lock<std::mutex> lock(m_saveMutex);
+				m_evictedDirtyChunks.erase(coord);
+			}
+			auto compressed = CompressChunk(chunk);
+			SaveChunkToDisk(coord, compressed);
+			chunk->SetModified(false);
+			return;
+		}
+
+		// Unloaded before its save ran: write the frame it was unloaded with
+		std::vector<uint8_t> data;
+		{
+			std::unique_lock<std::mutex> lock(m_saveMutex);
+			auto it = m_evictedDirtyChunks.find(coord);
+			if (it != m_evictedDirtyChunks.end()) {
+				data = std::move(it->second);
+				m_evictedDirtyChunks.erase(it);
+			}
+		}
+		if (!data.empty() || m_chunkCache->CopyDirty(coord, data)) {
+			SaveChunkToDisk(coord, data);
+		}
+	}
+
+	void ChunkSystem::CacheUnloadedChunk(const ChunkCoord& coord, const std::shared_ptr<Chunk>& chunk)
 	{
-		if (!m_config.enableCompression) {
-			// Return raw data if compression is disabled
-			return chunk->Serialize();
+		// Compressed once for both the cache and, if modified, the save
+		const bool modified = chunk->IsModified();
+		std::vector<DirtyChunkFrame> evicted;
+		m_chunkCache->Put(coord, CompressChunk(chunk), modified, evicted);
+
+		if (modified) {
+			std::unique_lock<std::mutex> lock(m_saveMutex);
+			m_saveQueue.push(coord);
+			m_lastSaveTime = std::chrono::steady_clock::now();
 		}
+		QueueEvictedChunks(evicted);
 
+		if (modified) {
+			m_saveCV.notify_one();
+		}
+	}
+
+	void ChunkSystem::QueueEvictedChunks(std::vector<DirtyChunkFrame>& evicted)
+	{
+		if (evicted.empty()) {
+			return;
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(m_saveMutex);
+			for (auto& frame : evicted) {
+				m_evictedDirtyChunks[frame.coord] = std::move(frame.data);
+				m_saveQueue.push(frame.coord);
+			}
+			m_lastSaveTime = std::chrono::steady_clock::now();
+		}
+
+		m_saveCV.notify_one();
+	}
+
+	std::vector<uint8_t> ChunkSystem::CompressChunk(const std::shared_ptr<Chunk>& chunk)
+	{
 		auto rawData = chunk->Serialize();
 		if (rawData.empty()) {
 			return {};
 		}
 
-		uLongf compressedSize = compressBound(rawData.size());
-		std::vector<uint8_t> compressed(compressedSize);
+		// Hot tier only: this runs on the save thread and on unload, so it
+		// must stay cheap. The cold codec is applied later by the idle pass.
+		const ChunkCodecType codec = m_config.enableCompression
+			? ChunkCompression::Resolve(m_config.hotCodec)
+			: ChunkCodecType::NONE;
 
-		int result = compress2(compressed.data(), &compressedSize,
-			rawData.data(), rawData.size(), Z_BEST_COMPRESSION);
-
-		if (result != Z_OK) {
+		std::vector<uint8_t> compressed;
+		if (!ChunkCompression::Encode(codec, 0, rawData.data(), rawData.size(), compressed)) {
 			VOXELCRAFT_LOG_ERROR("Failed to compress chunk ({}, {})", chunk->GetCoord().x, chunk->GetCoord().z);
-			return rawData; // Return uncompressed data on failure
+			ChunkCompression::Encode(ChunkCodecType::NONE, 0, rawData.data(), rawData.size(), compressed);
 		}
 
-		compressed.resize(compressedSize);
 		return compressed;
 	}
 
 	std::shared_ptr<Chunk> ChunkSystem::DecompressChunk(const ChunkCoord& coord, const std::vector<uint8_t>& data)
 	{
-		if (!m_config.enableCompression) {
-			// Data is not compressed
-			auto chunk = std::make_shared<Chunk>(coord);
-			if (chunk->Deserialize(data)) {
-				return chunk;
-			}
-			return nullptr;
+		return DecompressChunk(coord, data.data(), data.size());
+	}
+
+	std::shared_ptr<Chunk> ChunkSystem::DecompressChunk(const ChunkCoord& coord, const uint8_t* data, size_t size)
+	{
+		auto chunk = std::make_shared<Chunk>(coord);
+
+		// Frames name their codec, so the current config does not matter;
+		// the decoded bytes live in a per-thread buffer
+		size_t rawSize = 0;
+		const uint8_t* raw = ChunkCompression::Decode(data, size, rawSize);
+		if (raw) {
+			return chunk->Deserialize(raw, rawSize) ? chunk : nullptr;
 		}
 
-		// Estimate decompressed size (chunk volume * sizeof(Block) + header)
-		uLongf decompressedSize = ChunkSystemConfig::CHUNK_VOLUME * sizeof(uint16_t) + 1024;
-		std::vector<uint8_t> decompressed(decompressedSize);
+		// Unframed saves from before codecs with compression disabled
+		if (chunk->Deserialize(data, size)) {
+			return chunk;
+		}
 
-		int result = uncompress(decompressed.data(), &decompressedSize,
-			data.data(), data.size());
+		VOXELCRAFT_LOG_ERROR("Failed to decompress chunk ({}, {})", coord.x, coord.z);
+		return nullptr;
+	}
 
-		if (result != Z_OK) {
-			VOXELCRAFT_LOG_ERROR("Failed to decompress chunk ({}, {})", coord.x, coord.z);
-			return nullptr;
+	void ChunkSystem::QueueRecompression(const ChunkCoord& coord, ChunkCodecType storedCodec)
+	{
+		if (!m_config.enableIdleRecompression || !m_config.enableCompression) {
+			return;
 		}
 
-		decompressed.resize(decompressedSize);
+		const ChunkCodecType cold = ChunkCompression::Resolve(m_config.coldCodec);
+		if (storedCodec == cold || storedCodec >= ChunkCodecType::COUNT) {
+			return;
+		}
 
-		auto chunk = std::make_shared<Chunk>(coord);
-		if (chunk->Deserialize(decompressed)) {
-			return chunk;
+		std::unique_lock<std::mutex> lock(m_saveMutex);
+		if (m_recompressPending.insert(coord).second) {
+			m_recompressQueue.push_back(coord);
 		}
+	}
 
-		return nullptr;
+	bool ChunkSystem::IsSaveQueueIdle(std::chrono::steady_clock::time_point now) const
+	{
+		const auto delay = std::chrono::duration<float>(m_config.idleRecompressDelay);
+		return m_saveQueue.empty() && now - m_lastSaveTime >= delay;
+	}
+
+	uint32_t ChunkSystem::RecompressIdleChunks(uint32_t maxChunks)
+	{
+		const ChunkCodecType cold = ChunkCompression::Resolve(m_config.coldCodec);
+		const ChunkCodec* codec = ChunkCompression::GetCodec(cold);
+		if (!m_regionStorage || !codec) {
+			return 0;
+		}
+		const int level = m_config.coldCompressionLevel != 0 ? m_config.coldCompressionLevel : codec->GetHighRatioLevel();
+
+		std::vector<uint8_t> raw;
+		std::vector<uint8_t> frame;
+		uint32_t recompressed = 0;
+
+		while (recompressed < maxChunks) {
+			ChunkCoord coord;
+			{
+				// Pending saves win; they would overwrite this work anyway
+				std::unique_lock<std::mutex> lock(m_saveMutex);
+				if (m_recompressQueue.empty() || !m_saveQueue.empty()) {
+					break;
+				}
+				coord = m_recompressQueue.front();
+				m_recompressQueue.pop_front();
+				m_recompressPending.erase(coord);
+			}
+
+			// Held from the read to the write so a save in between (the save
+			// thread, or SaveAllChunks on the main thread) is never overwritten
+			// with the older data re-encoded here
+			std::unique_lock<std::mutex> regionLock(m_regionWriteMutex);
+
+			// Copy out of the mapping; the region cannot be written while it is read
+			bool hot = false;
+			m_regionStorage->ReadChunk(coord, [&raw, &hot, cold](const uint8_t* data, size_t size) {
+				ChunkCodecType type;
+				size_t rawSize;
+				if (!ChunkCompression::PeekFrame(data, size, type, rawSize) || type == cold) {
+					return;
+				}
+				const uint8_t* decoded = ChunkCompression::Decode(data, size, rawSize);
+				if (decoded) {
+					raw.assign(decoded, decoded + rawSize);
+					hot = true;
+				}
+			});
+
+			if (hot &&
+				ChunkCompression::Encode(cold, level, raw.data(), raw.size(), frame) &&
+				m_regionStorage->WriteChunk(coord, frame.data(), frame.size())) {
+				++recompressed;
+				m_recompressedChunks.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		if (recompressed > 0) {
+			VOXELCRAFT_LOG_DEBUG("Recompressed {} chunks with {}", recompressed, ChunkCompression::GetName(cold));
+		}
+		return recompressed;
 	}
 
 	void ChunkSystem::UpdateChunkLOD(std::shared_ptr<Chunk>& chunk, float distance)
@@ -618,12 +1087,9 @@ namespace VoxelCraft {
 		auto chunksToLoad = GetChunksToLoad(m_playerChunk);
 		auto chunksToUnload = GetChunksToUnload(m_playerChunk);
 
-		// Queue chunks for loading
+		// Request every chunk in range: new ones start, queued ones are reprioritized
 		for (const auto& coord : chunksToLoad) {
-			if (!HasChunk(coord)) {
-				auto priority = CalculatePriority(coord);
-				LoadChunkAsync(coord, priority);
-			}
+			m_pipeline->Request(coord, ChunkStage::READY, CalculatePriority(coord));
 		}
 
 		// Queue chunks for unloading
@@ -647,36 +1113,13 @@ namespace VoxelCraft {
 
 	void ChunkSystem::ProcessGenerationQueue()
 	{
-		if (m_config.enableMultithreading) {
-			// Worker threads handle generation
+		if (m_workerPool) {
+			// Pool workers run the pipeline
 			return;
 		}
 
-		// Single-threaded generation
-		uint32_t processed = 0;
-		while (processed < m_config.maxChunksPerFrame && !m_generationQueue.empty()) {
-			ChunkRequest request;
-			{
-				std::unique_lock<std::mutex> lock(m_generationMutex);
-				if (m_generationQueue.empty()) break;
-				request = m_generationQueue.top();
-				m_generationQueue.pop();
-			}
-
-			auto chunk = LoadChunk(request.coord);
-			if (chunk) {
-				{
-					std::unique_lock<std::mutex> lock(m_chunkMutex);
-					m_chunks[request.coord] = chunk;
-				}
-
-				if (request.callback) {
-					request.callback(chunk);
-				}
-			}
-
-			processed++;
-		}
+		// Single-threaded: one budget unit per stage
+		m_pipeline->RunPending(m_config.maxChunksPerFrame * 4);
 	}
 
 	void ChunkSystem::ProcessSaveQueue()
@@ -697,15 +1140,19 @@ namespace VoxelCraft {
 				m_saveQueue.pop();
 			}
 
-			auto chunk = GetChunk(coord);
-			if (chunk && chunk->IsModified()) {
-				auto compressed = CompressChunk(chunk);
-				SaveChunkToDisk(coord, compressed);
-				chunk->SetModified(false);
-			}
-
+			SaveQueuedChunk(coord);
 			processed++;
 		}
+
+		// One cold recompression per frame at most; this is the main thread
+		bool idle = false;
+		{
+			std::unique_lock<std::mutex> lock(m_saveMutex);
+			idle = !m_recompressQueue.empty() && IsSaveQueueIdle(std::chrono::steady_clock::now());
+		}
+		if (idle) {
+			RecompressIdleChunks(1);
+		}
 	}
 
 	void ChunkSystem::CleanupChunks()
@@ -722,22 +1169,22 @@ namespace VoxelCraft {
 		}
 
 		for (auto& coord : toRemove) {
+			m_pipeline->Remove(coord);
+			{
+				std::unique_lock<std::mutex> meshLock(m_meshMutex);
+				m_chunkMeshes.erase(coord);
+				m_sectionCuller->RemoveChunk(coord);
+			}
+
 			auto it = m_chunks.find(coord);
 			if (it != m_chunks.end()) {
-				auto& chunk = it->second;
-				if (chunk && chunk->IsModified()) {
-					SaveChunk(coord);
+				if (it->second) {
+					CacheUnloadedChunk(coord, it->second);
 				}
 				m_chunks.erase(it);
 			}
 		}
 
-		// Cleanup compressed cache if too large
-		while (m_compressedChunks.size() > m_config.chunkCacheSize) {
-			auto it = m_compressedChunks.begin();
-			m_compressedChunks.erase(it);
-		}
-
 		VOXELCRAFT_LOG_DEBUG("Cleaned up {} chunks", toRemove.size());
 	}
 
@@ -747,7 +1194,30 @@ namespace VoxelCraft {
 
 		m_stats.totalChunks = m_chunks.size();
 		m_stats.loadedChunks = 0;
-		m_stats.cachedChunks = m_compressedChunks.size();
+
+		// Cache footprint against what the same chunks serialize to
+		const auto cacheStats = m_chunkCache->GetStats();
+		uint64_t cacheRawBytes = 0;
+		m_chunkCache->ForEach([&cacheRawBytes](const ChunkCoord&, const std::vector<uint8_t>& frame) {
+			ChunkCodecType codec;
+			size_t rawSize;
+			if (!ChunkCompression::PeekFrame(frame.data(), frame.size(), codec, rawSize)) {
+				rawSize = frame.size();
+			}
+			cacheRawBytes += rawSize;
+		});
+		m_stats.cachedChunks = static_cast<uint32_t>(cacheStats.entries);
+		m_stats.compressedMemory = cacheStats.bytes;
+		m_stats.compressionRatio = cacheStats.bytes > 0
+			? static_cast<float>(cacheRawBytes) / static_cast<float>(cacheStats.bytes)
+			: 0.0f;
+
+		const uint64_t lookups = cacheStats.hits + cacheStats.misses;
+		m_stats.cacheHits = static_cast<uint32_t>(cacheStats.hits);
+		m_stats.cacheMisses = static_cast<uint32_t>(cacheStats.misses);
+		m_stats.cacheEvictions = static_cast<uint32_t>(cacheStats.evictions);
+		m_stats.cacheDirtyFlushes = static_cast<uint32_t>(cacheStats.dirtyEvictions);
+		m_stats.cacheHitRate = lookups > 0 ? static_cast<float>(cacheStats.hits) / static_cast<float>(lookups) : 0.0f;
 		m_stats.generatingChunks = 0;
 		m_stats.savingChunks = 0;
 
@@ -792,46 +1262,42 @@ namespace VoxelCraft {
 			}
 		}
 
+		lock.unlock(); // GetMemoryUsage takes the chunk mutex itself
+
 		// Calculate memory usage
 		m_stats.memoryUsed = GetMemoryUsage();
 		m_stats.memoryAvailable = m_config.maxLoadedChunks * ChunkSystemConfig::CHUNK_VOLUME * sizeof(uint16_t);
-	}
-
-	void ChunkSystem::GenerationThreadFunction()
-	{
-		VOXELCRAFT_LOG_INFO("Generation thread started");
-
-		while (m_generating) {
-			ChunkRequest request;
-
-			{
-				std::unique_lock<std::mutex> lock(m_generationMutex);
-				m_generationCV.wait(lock, [this]() {
-					return !m_generating || !m_generationQueue.empty();
-				});
-
-				if (!m_generating) break;
 
-				if (m_generationQueue.empty()) continue;
-
-				request = m_generationQueue.top();
-				m_generationQueue.pop();
-			}
+		// Pipeline stages; rates over the time since the last update
+		auto now = std::chrono::steady_clock::now();
+		float seconds = std::chrono::duration<float>(now - m_lastStatsUpdate).count();
+		auto stages = m_pipeline->GetStageStats();
+		for (size_t i = 0; i < CHUNK_STAGE_COUNT; ++i) {
+			stages[i].chunksPerSecond = seconds > 0.0f
+				? static_cast<float>(stages[i].completed - m_lastStageCompleted[i]) / seconds
+				: 0.0f;
+			m_lastStageCompleted[i] = stages[i].completed;
+			m_stats.stages[i] = stages[i];
+		}
 
-			auto chunk = LoadChunk(request.coord);
-			if (chunk) {
-				{
-					std::unique_lock<std::mutex> lock(m_chunkMutex);
-					m_chunks[request.coord] = chunk;
-				}
+		const ChunkStageStats& generate = m_stats.stages[static_cast<size_t>(ChunkStage::GENERATE)];
+		m_stats.averageGenerationTime = generate.averageTime;
+		m_stats.chunksGeneratedPerSecond = static_cast<uint32_t>(generate.chunksPerSecond);
+		m_stats.pipelineChunks = static_cast<uint32_t>(m_pipeline->GetChunkCount());
 
-				if (request.callback) {
-					request.callback(chunk);
-				}
-			}
+		const auto codecStats = ChunkCompression::GetStats();
+		std::copy(codecStats.begin(), codecStats.end(), m_stats.codecs);
+		{
+			std::unique_lock<std::mutex> saveLock(m_saveMutex);
+			m_stats.pendingRecompression = static_cast<uint32_t>(m_recompressQueue.size());
 		}
+		m_stats.recompressedChunks = m_recompressedChunks.load(std::memory_order_relaxed);
 
-		VOXELCRAFT_LOG_INFO("Generation thread stopped");
+		if (m_workerPool) {
+			auto poolStats = m_workerPool->GetStats();
+			m_stats.workerThreads = poolStats.threadCount;
+			m_stats.tasksStolen = poolStats.tasksStolen;
+		}
 	}
 
 	void ChunkSystem::SaveThreadFunction()
@@ -843,24 +1309,33 @@ namespace VoxelCraft {
 
 			{
 				std::unique_lock<std::mutex> lock(m_saveMutex);
-				m_saveCV.wait(lock, [this]() {
+				auto wake = [this]() {
 					return !m_saving || !m_saveQueue.empty();
-				});
+				};
+				if (m_recompressQueue.empty()) {
+					m_saveCV.wait(lock, wake);
+				} else {
+					// Wake when saves have been quiet for the idle delay
+					const auto delay = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+						std::chrono::duration<float>(m_config.idleRecompressDelay));
+					m_saveCV.wait_until(lock, m_lastSaveTime + delay, wake);
+				}
 
 				if (!m_saving) break;
 
-				if (m_saveQueue.empty()) continue;
+				if (m_saveQueue.empty()) {
+					if (!m_recompressQueue.empty() && IsSaveQueueIdle(std::chrono::steady_clock::now())) {
+						lock.unlock();
+						RecompressIdleChunks(m_config.maxChunksToRecompress);
+					}
+					continue;
+				}
 
 				coord = m_saveQueue.front();
 				m_saveQueue.pop();
 			}
 
-			auto chunk = GetChunk(coord);
-			if (chunk && chunk->IsModified()) {
-				auto compressed = CompressChunk(chunk);
-				SaveChunkToDisk(coord, compressed);
-				chunk->SetModified(false);
-			}
+			SaveQueuedChunk(coord);
 		}
 
 		VOXELCRAFT_LOG_INFO("Save thread stopped");
@@ -888,13 +1363,15 @@ namespace VoxelCraft {
 		int32_t radius = m_config.loadDistance;
 		for (int32_t x = playerChunk.x - radius; x <= playerChunk.x + radius; ++x) {
 			for (int32_t z = playerChunk.z - radius; z <= playerChunk.z + radius; ++z) {
-				ChunkCoord coord(x, z);
-				if (!HasChunk(coord)) {
-					coords.push_back(coord);
-				}
+				coords.push_back(ChunkCoord(x, z));
 			}
 		}
 
+		// Nearest first so equal-priority requests queue in distance order
+		std::sort(coords.begin(), coords.end(), [&playerChunk](const ChunkCoord& a, const ChunkCoord& b) {
+			return playerChunk.distance(a) < playerChunk.distance(b);
+		});
+
 		return coords;
 	}
 
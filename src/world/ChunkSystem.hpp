@@ -4,7 +4,10 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <queue>
+#include <deque>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
 #include <atomic>
 #include <functional>
 #include <cstdint>
@@ -17,7 +20,18 @@ namespace VoxelCraft {
 	class Chunk;
 	class Block;
 	class TerrainGenerator;
+	class LightPropagator;
+	class ChunkPipeline;
+	class WorkStealingPool;
+	class RegionStorage;
+	class CompressedChunkCache;
+	class BlockMeshGenerator;
 	class Biome;
+	struct ChunkNeighborhood;
+	struct PackedChunkMesh;
+	class ViewFrustum;
+	class SectionOcclusionCuller;
+	struct VisibleSection;
 
 	/**
 	 * @brief Chunk coordinates structure
@@ -165,6 +179,86 @@ namespace VoxelCraft {
 		IDLE            // Background loading
 	};
 
+	/**
+	 * @brief Pipeline stages a chunk passes through, in order
+	 *
+	 * A stage becomes runnable once the chunk finished the previous one and
+	 * its eight neighbors finished the stage before that (see ChunkPipeline).
+	 */
+	enum class ChunkStage : uint8_t
+	{
+		NONE,           // Requested, nothing done yet
+		GENERATE,       // Base terrain generated or loaded
+		DECORATE,       // Features that may cross into neighbors placed
+		LIGHT,          // Sky and block light propagated
+		MESH,           // Render mesh built
+		READY,          // Usable and renderable
+		COUNT
+	};
+
+	static constexpr size_t CHUNK_STAGE_COUNT = static_cast<size_t>(ChunkStage::COUNT);
+
+	/**
+	 * @brief Per-stage pipeline statistics
+	 */
+	struct ChunkStageStats
+	{
+		uint32_t queued;                // Runnable, waiting for a worker
+		uint32_t running;               // Currently executing
+		uint64_t completed;             // Total completions
+		float averageTime;              // Average execution time (ms)
+		float chunksPerSecond;          // Completions per second over the last stats interval
+	};
+
+	/**
+	 * @brief Chunk payload compression algorithms (see ChunkCodec)
+	 *
+	 * Values are stored in frame headers on disk; never renumber.
+	 */
+	enum class ChunkCodecType : uint8_t
+	{
+		NONE = 0,       // Stored as-is
+		LZ4 = 1,        // Fast; in-memory cache and first save
+		DEFLATE = 2,    // zlib
+		ZSTD = 3,       // High ratio at high levels; cold on-disk data
+		COUNT
+	};
+
+	static constexpr size_t CHUNK_CODEC_COUNT = static_cast<size_t>(ChunkCodecType::COUNT);
+
+	/**
+	 * @brief Replacement policy of the compressed chunk cache
+	 */
+	enum class ChunkCachePolicy : uint8_t
+	{
+		LRU,            // Least recently unloaded goes first; best for walking back over old ground
+		ARC             // Adaptive: keeps a revisited area across one-way trips and teleports
+	};
+
+	/**
+	 * @brief Compressed chunk whose changes are not on disk yet
+	 */
+	struct DirtyChunkFrame
+	{
+		ChunkCoord coord;
+		std::vector<uint8_t> data;
+	};
+
+	/**
+	 * @brief Per-codec compression statistics since startup
+	 */
+	struct ChunkCodecStats
+	{
+		bool available;                 // Built into this binary
+		uint64_t compressions;
+		uint64_t decompressions;
+		uint64_t rawBytes;              // Compression input
+		uint64_t compressedBytes;       // Compression output
+		float ratio;                    // rawBytes / compressedBytes
+		float compressMBps;             // Input consumed per second of compression
+		float decompressMBps;           // Output produced per second of decompression
+	};
+
 	/**
 	 * @brief Chunk generation request structure
 	 */
@@ -196,7 +290,8 @@ namespace VoxelCraft {
 		// Memory management
 		uint32_t maxLoadedChunks = 1024;     // Maximum chunks in memory
 		uint32_t maxRenderChunks = 256;      // Maximum chunks to render
-		uint32_t chunkCacheSize = 512;       // Size of compressed chunk cache
+		size_t chunkCacheBudget = 16 * 1024 * 1024; // Compressed chunk cache, in bytes
+		ChunkCachePolicy chunkCachePolicy = ChunkCachePolicy::LRU;
 
 		// Distance settings
 		uint32_t loadDistance = 8;           // Chunks to load around player
@@ -209,7 +304,7 @@ namespace VoxelCraft {
 		float cleanupInterval = 30.0f;       // Cleanup interval in seconds
 
 		// Threading
-		uint32_t generationThreads = 2;      // Number of generation threads
+		uint32_t generationThreads = 0;      // Pipeline worker threads (0 = hardware concurrency)
 		uint32_t saveThreads = 1;            // Number of save threads
 
 		// Features
@@ -218,6 +313,16 @@ namespace VoxelCraft {
 		bool enableStreaming = true;         // Enable chunk streaming
 		bool enableMultithreading = true;    // Enable multithreaded generation
 		bool enableProfiling = true;         // Enable performance profiling
+		bool enableFrustumCulling = true;    // Cull 16x16x16 sections outside the view frustum
+		bool enableOcclusionCulling = true;  // Cull sections hidden behind solid terrain (cave culling)
+
+		// Compression tiers; unavailable codecs fall back (ZSTD -> DEFLATE -> LZ4)
+		ChunkCodecType hotCodec = ChunkCodecType::LZ4;    // Compressed cache and saves
+		ChunkCodecType coldCodec = ChunkCodecType::ZSTD;  // Saved chunks, rewritten when idle
+		int coldCompressionLevel = 0;        // 0 = codec's high-ratio default
+		bool enableIdleRecompression = true; // Recompress saved chunks with coldCodec
+		float idleRecompressDelay = 2.0f;    // Seconds without saves before recompressing
+		uint32_t maxChunksToRecompress = 16; // Per idle pass
 	};
 
 	/**
@@ -254,10 +359,29 @@ namespace VoxelCraft {
 		uint32_t lodQuarterChunks;
 		uint32_t lodEighthChunks;
 
+		// Culling stats of the last Render(frustum, ...), in sections
+		uint32_t cullingTests;
+		uint32_t cullingPassed;
+		uint32_t occlusionTests;
+		uint32_t occlusionPassed;
+
 		// Cache stats
 		float cacheHitRate;
 		uint32_t cacheMisses;
 		uint32_t cacheHits;
+		uint32_t cacheEvictions;
+		uint32_t cacheDirtyFlushes;          // Evicted before their save was written
+
+		// Pipeline stats, indexed by ChunkStage
+		ChunkStageStats stages[CHUNK_STAGE_COUNT];
+		uint32_t pipelineChunks;             // Chunks tracked by the pipeline
+		uint32_t workerThreads;
+		uint64_t tasksStolen;
+
+		// Compression stats, indexed by ChunkCodecType
+		ChunkCodecStats codecs[CHUNK_CODEC_COUNT];
+		uint32_t pendingRecompression;       // Saved chunks still in the hot codec
+		uint64_t recompressedChunks;
 	};
 
 	/**
@@ -270,10 +394,21 @@ namespace VoxelCraft {
 	 * - Chunk compression and caching
 	 * - Multi-threaded generation
 	 * - Memory management for large worlds
+	 *
+	 * Chunks are produced by a ChunkPipeline running generate, decorate,
+	 * light and mesh stages on a shared work-stealing pool. A chunk joins
+	 * the chunk map once generated and is marked READY (and rendered) once
+	 * meshed; chunks just outside the load distance stay partially processed
+	 * as neighbors of the ones inside it.
 	 */
 	class ChunkSystem
 	{
 	public:
+		/**
+		 * @brief Called after SetBlock changed a block ID
+		 */
+		using BlockChangeListener = std::function<void(const WorldCoord& coord, uint16_t oldId, uint16_t newId)>;
+
 		/**
 		 * @brief Constructor
 		 */
@@ -304,6 +439,21 @@ namespace VoxelCraft {
 		 */
 		void Render();
 
+		/**
+		 * @brief Render chunks with a visible section
+		 *
+		 * Sections within the render distance are culled against the
+		 * frustum and, with enableOcclusionCulling, by the cave visibility
+		 * graph built at mesh time; the survivors are kept for
+		 * GetVisibleSections.
+		 */
+		void Render(const ViewFrustum& frustum, float cameraX, float cameraY, float cameraZ);
+
+		/**
+		 * @brief Sections that survived the last Render(frustum, ...), nearest first with occlusion culling
+		 */
+		std::vector<VisibleSection> GetVisibleSections() const;
+
 		/**
 		 * @brief Get chunk at coordinates
 		 */
@@ -345,6 +495,19 @@ namespace VoxelCraft {
 		 */
 		void SetBlock(const WorldCoord& coord, std::shared_ptr<Block> block);
 
+		/**
+		 * @brief Register a listener for block changes (e.g. PathRequestService::OnBlockChanged)
+		 * @return Listener ID for RemoveBlockChangeListener
+		 *
+		 * Not synchronized with SetBlock; register listeners during setup.
+		 */
+		uint32_t AddBlockChangeListener(BlockChangeListener listener);
+
+		/**
+		 * @brief Remove a block change listener
+		 */
+		void RemoveBlockChangeListener(uint32_t id);
+
 		/**
 		 * @brief Get biome at world coordinates
 		 */
@@ -405,18 +568,54 @@ namespace VoxelCraft {
 		 */
 		const ChunkCoord& GetPlayerChunk() const { return m_playerChunk; }
 
+		/**
+		 * @brief Get light propagator (nullptr before Initialize)
+		 */
+		LightPropagator* GetLightPropagator() const { return m_lightPropagator.get(); }
+
+		/**
+		 * @brief Get stage worker pool (nullptr before Initialize or without multithreading)
+		 */
+		WorkStealingPool* GetWorkerPool() const { return m_workerPool.get(); }
+
+		/**
+		 * @brief Get chunk pipeline (nullptr before Initialize)
+		 */
+		ChunkPipeline* GetPipeline() const { return m_pipeline.get(); }
+
+		/**
+		 * @brief Get pipeline stage of a chunk
+		 */
+		ChunkStage GetChunkStage(const ChunkCoord& coord) const;
+
+		/**
+		 * @brief Get mesh built by the MESH stage (nullptr if not meshed)
+		 */
+		std::shared_ptr<const PackedChunkMesh> GetChunkMesh(const ChunkCoord& coord) const;
+
 	private:
 		ChunkSystemConfig m_config;
 		ChunkSystemStats m_stats;
 		World* m_world;
 		std::shared_ptr<TerrainGenerator> m_terrainGenerator;
+		std::unique_ptr<LightPropagator> m_lightPropagator;
+		std::unique_ptr<BlockMeshGenerator> m_meshGenerator;
+		std::unique_ptr<WorkStealingPool> m_workerPool;
+		std::unique_ptr<ChunkPipeline> m_pipeline;
+		std::unique_ptr<RegionStorage> m_regionStorage;
+		bool m_hasLegacyChunkFiles;
 		bool m_initialized;
 
 		// Chunk storage
 		std::unordered_map<ChunkCoord, std::shared_ptr<Chunk>> m_chunks;
-		std::unordered_map<ChunkCoord, std::vector<uint8_t>> m_compressedChunks; // Cache
-		std::priority_queue<ChunkRequest> m_generationQueue;
+		std::unique_ptr<CompressedChunkCache> m_chunkCache;  // Unloaded chunks, compressed
+		std::unordered_map<ChunkCoord, std::shared_ptr<PackedChunkMesh>> m_chunkMeshes;
+		std::unique_ptr<SectionOcclusionCuller> m_sectionCuller;     // Guarded by m_meshMutex
+		std::vector<VisibleSection> m_visibleSections;               // Guarded by m_meshMutex
+		std::unordered_map<ChunkCoord, std::vector<std::function<void(std::shared_ptr<Chunk>)>>> m_readyCallbacks;
 		std::queue<ChunkCoord> m_saveQueue;
+		std::vector<std::pair<uint32_t, BlockChangeListener>> m_blockChangeListeners;
+		uint32_t m_nextListenerId;
 
 		// Player tracking
 		ChunkCoord m_playerChunk;
@@ -424,19 +623,28 @@ namespace VoxelCraft {
 		std::vector<ChunkCoord> m_chunksToUnload;
 
 		// Threading
-		std::vector<std::thread> m_generationThreads;
 		std::thread m_saveThread;
 		std::mutex m_chunkMutex;
-		std::mutex m_generationMutex;
+		mutable std::mutex m_meshMutex;
+		std::mutex m_callbackMutex;
 		std::mutex m_saveMutex;
-		std::condition_variable m_generationCV;
 		std::condition_variable m_saveCV;
-		std::atomic<bool> m_generating;
 		std::atomic<bool> m_saving;
+		std::mutex m_regionWriteMutex;       // Serializes region writes (main thread saves, save thread, recompression)
+
+		// Idle recompression of saved chunks into the cold codec (guarded by m_saveMutex)
+		std::deque<ChunkCoord> m_recompressQueue;
+		std::unordered_set<ChunkCoord> m_recompressPending;
+		std::chrono::steady_clock::time_point m_lastSaveTime;
+
+		// Dirty chunks evicted from the cache, waiting for the save thread (guarded by m_saveMutex)
+		std::unordered_map<ChunkCoord, std::vector<uint8_t>> m_evictedDirtyChunks;
+		std::atomic<uint64_t> m_recompressedChunks;
 
 		// Performance tracking
 		std::chrono::steady_clock::time_point m_lastCleanupTime;
 		std::chrono::steady_clock::time_point m_lastStatsUpdate;
+		uint64_t m_lastStageCompleted[CHUNK_STAGE_COUNT];
 
 		/**
 		 * @brief Generate chunk
@@ -444,15 +652,75 @@ namespace VoxelCraft {
 		std::shared_ptr<Chunk> GenerateChunk(const ChunkCoord& coord);
 
 		/**
-		 * @brief Load chunk from disk
+		 * @brief Load chunk from the compressed cache or disk (nullptr if neither has it)
 		 */
 		std::shared_ptr<Chunk> LoadChunk(const ChunkCoord& coord);
 
+		/**
+		 * @brief GENERATE stage: adopt, load or generate the chunk
+		 */
+		std::shared_ptr<Chunk> RunGenerateStage(const ChunkCoord& coord, ChunkStage& reached);
+
+		/**
+		 * @brief DECORATE stage: place surface features
+		 */
+		void RunDecorateStage(const ChunkNeighborhood& area);
+
+		/**
+		 * @brief LIGHT stage: full relight of the chunk
+		 */
+		void RunLightStage(const ChunkNeighborhood& area);
+
+		/**
+		 * @brief MESH stage: build the packed greedy mesh
+		 */
+		void RunMeshStage(const ChunkNeighborhood& area);
+
+		/**
+		 * @brief Re-mesh a block's chunk and the neighbors whose border meshes see it
+		 */
+		void RemeshAroundBlock(const ChunkCoord& chunkCoord, int localX, int localZ);
+
+		/**
+		 * @brief Hand chunks with queued light work to the pipeline as updates
+		 */
+		void ProcessLightQueue();
+
+		/**
+		 * @brief Pipeline update: apply the light work queued for the chunk
+		 */
+		void RunLightUpdate(const ChunkNeighborhood& area);
+
+		/**
+		 * @brief Pipeline stage callback (worker thread)
+		 */
+		void OnStageCompleted(const std::shared_ptr<Chunk>& chunk, ChunkStage stage);
+
+		/**
+		 * @brief Run callbacks registered through LoadChunkAsync
+		 */
+		void FireReadyCallbacks(const ChunkCoord& coord, const std::shared_ptr<Chunk>& chunk);
+
 		/**
 		 * @brief Save chunk to disk
 		 */
 		void SaveChunkToDisk(const ChunkCoord& coord, const std::vector<uint8_t>& data);
 
+		/**
+		 * @brief Write a queued chunk: live if loaded and modified, else its unsaved frame
+		 */
+		void SaveQueuedChunk(const ChunkCoord& coord);
+
+		/**
+		 * @brief Compress an unloading chunk into the cache (m_chunkMutex held)
+		 */
+		void CacheUnloadedChunk(const ChunkCoord& coord, const std::shared_ptr<Chunk>& chunk);
+
+		/**
+		 * @brief Hand dirty frames evicted from the cache to the save thread
+		 */
+		void QueueEvictedChunks(std::vector<DirtyChunkFrame>& evicted);
+
 		/**
 		 * @brief Compress chunk data
 		 */
@@ -463,6 +731,27 @@ namespace VoxelCraft {
 		 */
 		std::shared_ptr<Chunk> DecompressChunk(const ChunkCoord& coord, const std::vector<uint8_t>& data);
 
+		/**
+		 * @brief Decompress chunk data in place (e.g. from a mapped region file)
+		 */
+		std::shared_ptr<Chunk> DecompressChunk(const ChunkCoord& coord, const uint8_t* data, size_t size);
+
+		/**
+		 * @brief Queue a saved chunk for recompression if its frame is not in the cold codec
+		 */
+		void QueueRecompression(const ChunkCoord& coord, ChunkCodecType storedCodec);
+
+		/**
+		 * @brief Rewrite queued chunks with the cold codec; stops when a save is queued
+		 * @return Number of chunks rewritten
+		 */
+		uint32_t RecompressIdleChunks(uint32_t maxChunks);
+
+		/**
+		 * @brief Whether saves have been quiet long enough to recompress (m_saveMutex held)
+		 */
+		bool IsSaveQueueIdle(std::chrono::steady_clock::time_point now) const;
+
 		/**
 		 * @brief Update chunk LOD
 		 */
@@ -484,7 +773,7 @@ namespace VoxelCraft {
 		void UpdateChunkPriorities();
 
 		/**
-		 * @brief Process generation queue
+		 * @brief Run pipeline stages inline when multithreading is disabled
 		 */
 		void ProcessGenerationQueue();
 
@@ -503,11 +792,6 @@ namespace VoxelCraft {
 		 */
 		void UpdateStats();
 
-		/**
-		 * @brief Generation thread function
-		 */
-		void GenerationThreadFunction();
-
 		/**
 		 * @brief Save thread function
 		 */
@@ -519,7 +803,7 @@ namespace VoxelCraft {
 		ChunkPriority CalculatePriority(const ChunkCoord& coord) const;
 
 		/**
-		 * @brief Get chunks to load
+		 * @brief Get chunks in load range, nearest first
 		 */
 		std::vector<ChunkCoord> GetChunksToLoad(const ChunkCoord& playerChunk);
 
@@ -534,7 +818,7 @@ namespace VoxelCraft {
 		bool IsChunkInRange(const ChunkCoord& coord, const ChunkCoord& center, uint32_t range) const;
 
 		/**
-		 * @brief Get chunk file path
+		 * @brief Get legacy per-chunk file path, read when a chunk is not in its region
 		 */
 		std::string GetChunkFilePath(const ChunkCoord& coord) const;
 	};
@@ -0,0 +1,261 @@
+#include "CompressedChunkCache.hpp"
+#include <algorithm>
+
+namespace VoxelCraft {
+
+	CompressedChunkCache::CompressedChunkCache(size_t budget, ChunkCachePolicy policy)
+		: m_policy(policy)
+		, m_budget(budget)
+		, m_recentTarget(0)
+		, m_listBytes{}
+		, m_hits(0)
+		, m_misses(0)
+		, m_evictions(0)
+		, m_dirtyEvictions(0)
+	{
+	}
+
+	void CompressedChunkCache::Put(const ChunkCoord& coord, std::vector<uint8_t> data, bool dirty,
+		std::vector<DirtyChunkFrame>& evicted)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		const size_t size = data.size();
+		ListId target = RECENT;
+		bool frequentGhostHit = false;
+
+		auto it = m_entries.find(coord);
+		if (it != m_entries.end()) {
+			Entry& entry = it->second;
+			if (m_policy == ChunkCachePolicy::ARC) {
+				target = FREQUENT;
+
+				// Ghost hits: that side of the cache was too small
+				if (entry.list == GHOST_RECENT) {
+					const size_t delta = std::max(size, size * m_listBytes[GHOST_FREQUENT] /
+						std::max<size_t>(m_listBytes[GHOST_RECENT], 1));
+					m_recentTarget = std::min(m_budget, m_recentTarget + delta);
+				} else if (entry.list == GHOST_FREQUENT) {
+					const size_t delta = std::max(size, size * m_listBytes[GHOST_RECENT] /
+						std::max<size_t>(m_listBytes[GHOST_FREQUENT], 1));
+					m_recentTarget = m_recentTarget > delta ? m_recentTarget - delta : 0;
+					frequentGhostHit = true;
+				}
+			}
+
+			// Replacing a resident copy must not lose its unsaved changes
+			if (IsResident(entry.list)) {
+				dirty |= entry.dirty;
+			}
+			Unlink(entry);
+		} else {
+			it = m_entries.emplace(coord, Entry{}).first;
+		}
+
+		Entry& entry = it->second;
+		if (size > m_budget) {
+			// Can never fit; goes straight back to the caller
+			++m_evictions;
+			if (dirty) {
+				++m_dirtyEvictions;
+				evicted.push_back({ coord, std::move(data) });
+			}
+			m_entries.erase(it);
+			return;
+		}
+
+		// Make room first so the new entry is never its own victim
+		entry.list = LIST_COUNT;
+		Evict(size, frequentGhostHit, evicted);
+
+		entry.size = size;
+		entry.data = std::move(data);
+		entry.dirty = dirty;
+		Link(entry, coord, target);
+		TrimGhosts();
+	}
+
+	bool CompressedChunkCache::Take(const ChunkCoord& coord, std::vector<uint8_t>& data, bool& dirty)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		auto it = m_entries.find(coord);
+		if (it == m_entries.end() || !IsResident(it->second.list)) {
+			++m_misses;
+			return false;
+		}
+
+		++m_hits;
+		Entry& entry = it->second;
+		data = std::move(entry.data);
+		dirty = entry.dirty;
+		Unlink(entry);
+
+		if (m_policy == ChunkCachePolicy::ARC) {
+			entry.data = {};
+			entry.dirty = false;
+			Link(entry, coord, TAKEN);
+			TrimGhosts();
+		} else {
+			m_entries.erase(it);
+		}
+		return true;
+	}
+
+	bool CompressedChunkCache::CopyDirty(const ChunkCoord& coord, std::vector<uint8_t>& data)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		auto it = m_entries.find(coord);
+		if (it == m_entries.end() || !IsResident(it->second.list) || !it->second.dirty) {
+			return false;
+		}
+
+		data = it->second.data;
+		it->second.dirty = false;
+		return true;
+	}
+
+	void CompressedChunkCache::CopyAllDirty(std::vector<DirtyChunkFrame>& dirty)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		for (auto& pair : m_entries) {
+			if (IsResident(pair.second.list) && pair.second.dirty) {
+				dirty.push_back({ pair.first, pair.second.data });
+				pair.second.dirty = false;
+			}
+		}
+	}
+
+	void CompressedChunkCache::Clear(std::vector<DirtyChunkFrame>& dirty)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		for (auto& pair : m_entries) {
+			if (IsResident(pair.second.list) && pair.second.dirty) {
+				dirty.push_back({ pair.first, std::move(pair.second.data) });
+			}
+		}
+
+		m_entries.clear();
+		for (size_t i = 0; i < LIST_COUNT; ++i) {
+			m_lists[i].clear();
+			m_listBytes[i] = 0;
+		}
+		m_recentTarget = 0;
+	}
+
+	void CompressedChunkCache::SetBudget(size_t budget, std::vector<DirtyChunkFrame>& evicted)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		m_budget = budget;
+		m_recentTarget = std::min(m_recentTarget, m_budget);
+		Evict(0, false, evicted);
+		TrimGhosts();
+	}
+
+	bool CompressedChunkCache::Contains(const ChunkCoord& coord) const
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		auto it = m_entries.find(coord);
+		return it != m_entries.end() && IsResident(it->second.list);
+	}
+
+	CompressedChunkCache::Stats CompressedChunkCache::GetStats() const
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+
+		Stats stats;
+		stats.hits = m_hits;
+		stats.misses = m_misses;
+		stats.evictions = m_evictions;
+		stats.dirtyEvictions = m_dirtyEvictions;
+		stats.entries = m_lists[RECENT].size() + m_lists[FREQUENT].size();
+		stats.bytes = ResidentBytes();
+		stats.budget = m_budget;
+		stats.recentBytes = m_listBytes[RECENT];
+		stats.frequentBytes = m_listBytes[FREQUENT];
+		stats.recentTarget = m_recentTarget;
+		return stats;
+	}
+
+	void CompressedChunkCache::Link(Entry& entry, const ChunkCoord& coord, ListId list)
+	{
+		entry.list = list;
+		m_lists[list].push_front(coord);
+		entry.position = m_lists[list].begin();
+		m_listBytes[list] += entry.size;
+	}
+
+	void CompressedChunkCache::Unlink(Entry& entry)
+	{
+		m_lists[entry.list].erase(entry.position);
+		m_listBytes[entry.list] -= entry.size;
+	}
+
+	void CompressedChunkCache::Evict(size_t incoming, bool frequentGhostHit, std::vector<DirtyChunkFrame>& evicted)
+	{
+		while (ResidentBytes() + incoming > m_budget) {
+			// ARC's REPLACE: shrink whichever resident list is over its share
+			ListId from = RECENT;
+			if (m_policy == ChunkCachePolicy::ARC) {
+				const size_t recentBytes = m_listBytes[RECENT];
+				const bool recentOver = recentBytes > m_recentTarget ||
+					(frequentGhostHit && recentBytes >= m_recentTarget);
+				from = !m_lists[RECENT].empty() && (recentOver || m_lists[FREQUENT].empty())
+					? RECENT : FREQUENT;
+			}
+
+			const ChunkCoord victim = m_lists[from].back();
+			auto it = m_entries.find(victim);
+			Entry& entry = it->second;
+
+			++m_evictions;
+			if (entry.dirty) {
+				++m_dirtyEvictions;
+				evicted.push_back({ victim, std::move(entry.data) });
+			}
+
+			Unlink(entry);
+			if (m_policy == ChunkCachePolicy::ARC) {
+				entry.data = {};
+				entry.dirty = false;
+				Link(entry, victim, from == RECENT ? GHOST_RECENT : GHOST_FREQUENT);
+			} else {
+				m_entries.erase(it);
+			}
+		}
+	}
+
+	void CompressedChunkCache::TrimGhosts()
+	{
+		if (m_policy != ChunkCachePolicy::ARC) {
+			return;
+		}
+
+		auto dropOldest = [this](ListId list) {
+			m_listBytes[list] -= m_entries.find(m_lists[list].back())->second.size;
+			m_entries.erase(m_lists[list].back());
+			m_lists[list].pop_back();
+		};
+
+		// Ghost history is bounded like ARC's: |T1| + |B1| <= c, total <= 2c
+		while (!m_lists[GHOST_RECENT].empty() &&
+			m_listBytes[RECENT] + m_listBytes[GHOST_RECENT] > m_budget) {
+			dropOldest(GHOST_RECENT);
+		}
+		while (!m_lists[GHOST_FREQUENT].empty() &&
+			ResidentBytes() + m_listBytes[GHOST_RECENT] + m_listBytes[GHOST_FREQUENT] > 2 * m_budget) {
+			dropOldest(GHOST_FREQUENT);
+		}
+
+		// Live chunks remembered for their next unload
+		while (!m_lists[TAKEN].empty() && m_listBytes[TAKEN] > m_budget) {
+			dropOldest(TAKEN);
+		}
+	}
+
+} // namespace VoxelCraft
@@ -0,0 +1,147 @@
+/**
+ * @file CompressedChunkCache.hpp
+ * @brief VoxelCraft World System - Byte-budgeted cache of unloaded chunks
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#pragma once
+#include <list>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+#include "ChunkSystem.hpp"
+
+namespace VoxelCraft {
+
+	/**
+	 * @brief Compressed frames of recently unloaded chunks
+	 *
+	 * Entries are charged by their compressed size against a byte budget.
+	 * LRU evicts the least recently unloaded chunk. ARC (adaptive replacement
+	 * cache) splits residents into chunks seen once and chunks seen again,
+	 * remembers the keys of evicted chunks and shifts the budget towards
+	 * whichever side those ghosts show was evicted too early, so a long
+	 * one-way trip cannot flush the area the player keeps coming back to.
+	 *
+	 * A hit hands the frame back (Take) because the chunk becomes live again;
+	 * under ARC its key is kept so that unloading it again counts as a repeat.
+	 *
+	 * Dirty entries hold modifications that are not on disk yet. They are
+	 * never dropped silently: eviction returns them to the caller to write.
+	 * All methods are thread-safe.
+	 */
+	class CompressedChunkCache
+	{
+	public:
+		struct Stats
+		{
+			uint64_t hits;
+			uint64_t misses;
+			uint64_t evictions;
+			uint64_t dirtyEvictions;        // Evictions handed back for writing
+			size_t entries;
+			size_t bytes;
+			size_t budget;
+			size_t recentBytes;             // ARC: chunks unloaded once
+			size_t frequentBytes;           // ARC: chunks unloaded again
+			size_t recentTarget;            // ARC: adaptive share of the budget for recentBytes
+		};
+
+		CompressedChunkCache(size_t budget, ChunkCachePolicy policy);
+
+		/**
+		 * @brief Insert or replace a chunk's frame
+		 * @param evicted Receives dirty entries evicted to make room (possibly this one)
+		 */
+		void Put(const ChunkCoord& coord, std::vector<uint8_t> data, bool dirty, std::vector<DirtyChunkFrame>& evicted);
+
+		/**
+		 * @brief Remove and return a chunk's frame; counts a hit or a miss
+		 */
+		bool Take(const ChunkCoord& coord, std::vector<uint8_t>& data, bool& dirty);
+
+		/**
+		 * @brief Copy a dirty entry for writing and mark it clean
+		 */
+		bool CopyDirty(const ChunkCoord& coord, std::vector<uint8_t>& data);
+
+		/**
+		 * @brief Copy every dirty entry for writing and mark them clean
+		 */
+		void CopyAllDirty(std::vector<DirtyChunkFrame>& dirty);
+
+		/**
+		 * @brief Drop everything; dirty entries are returned
+		 */
+		void Clear(std::vector<DirtyChunkFrame>& dirty);
+
+		/**
+		 * @brief Change the budget, evicting as needed
+		 */
+		void SetBudget(size_t budget, std::vector<DirtyChunkFrame>& evicted);
+
+		bool Contains(const ChunkCoord& coord) const;
+		Stats GetStats() const;
+
+		/**
+		 * @brief Visit every resident frame (under the cache lock)
+		 */
+		template<typename Fn>
+		void ForEach(Fn&& fn) const
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			for (const auto& pair : m_entries) {
+				if (IsResident(pair.second.list)) {
+					fn(pair.first, pair.second.data);
+				}
+			}
+		}
+
+	private:
+		enum ListId : uint8_t
+		{
+			RECENT = 0,         // Resident, unloaded once (T1)
+			FREQUENT,           // Resident, unloaded again (T2)
+			GHOST_RECENT,       // Evicted from RECENT, key only (B1)
+			GHOST_FREQUENT,     // Evicted from FREQUENT, key only (B2)
+			TAKEN,              // Handed back by Take, key only
+			LIST_COUNT
+		};
+
+		struct Entry
+		{
+			ListId list;
+			std::list<ChunkCoord>::iterator position;
+			size_t size;                    // Frame size, remembered by key-only entries
+			std::vector<uint8_t> data;
+			bool dirty;
+		};
+
+		using EntryMap = std::unordered_map<ChunkCoord, Entry>;
+
+		static bool IsResident(ListId list) { return list == RECENT || list == FREQUENT; }
+
+		void Link(Entry& entry, const ChunkCoord& coord, ListId list);
+		void Unlink(Entry& entry);
+		void Evict(size_t incoming, bool frequentGhostHit, std::vector<DirtyChunkFrame>& evicted);
+		void TrimGhosts();
+		size_t ResidentBytes() const { return m_listBytes[RECENT] + m_listBytes[FREQUENT]; }
+
+		mutable std::mutex m_mutex;
+		ChunkCachePolicy m_policy;
+		size_t m_budget;
+		size_t m_recentTarget;              // ARC "p", in bytes
+		EntryMap m_entries;
+		std::list<ChunkCoord> m_lists[LIST_COUNT];  // Front is most recent
+		size_t m_listBytes[LIST_COUNT];
+
+		uint64_t m_hits;
+		uint64_t m_misses;
+		uint64_t m_evictions;
+		uint64_t m_dirtyEvictions;
+	};
+
+} // namespace VoxelCraft
@@ -0,0 +1,767 @@
+/**
+ * @file LightPropagator.cpp
+ * @brief VoxelCraft Lighting System - Light Propagator Implementation
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#include "LightPropagator.hpp"
+#include "Chunk.hpp"
+#include "ChunkSection.hpp"
+#include "ChunkLightStorage.hpp"
+#include "../blocks/BlockPropertyTable.hpp"
+#include "../core/ThreadPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <future>
+
+namespace VoxelCraft {
+
+    namespace {
+
+        constexpr uint8_t MAX_LIGHT = ChunkLightStorage::MAX_LIGHT;
+        constexpr int32_t COLUMN_HEIGHT = static_cast<int32_t>(ChunkLightStorage::COLUMN_HEIGHT);
+        constexpr int32_t REGION_MIN = -16;
+        constexpr int32_t REGION_MAX = 32;
+
+        // +X, -X, +Y, -Y, +Z, -Z
+        constexpr int32_t DIR_X[6] = { 1, -1, 0, 0, 0, 0 };
+        constexpr int32_t DIR_Y[6] = { 0, 0, 1, -1, 0, 0 };
+        constexpr int32_t DIR_Z[6] = { 0, 0, 0, 0, 1, -1 };
+        constexpr int DIR_DOWN = 3;
+
+        /**
+         * @brief BFS node: region-local position and level packed into 24 bits
+         */
+        inline uint32_t PackNode(int32_t lx, int32_t y, int32_t lz, uint8_t level = 0) {
+            return static_cast<uint32_t>(lx - REGION_MIN) |
+                   (static_cast<uint32_t>(lz - REGION_MIN) << 6) |
+                   (static_cast<uint32_t>(y) << 12) |
+                   (static_cast<uint32_t>(level) << 20);
+        }
+
+        inline void UnpackNode(uint32_t node, int32_t& lx, int32_t& y, int32_t& lz, uint8_t& level) {
+            lx = static_cast<int32_t>(node & 63u) + REGION_MIN;
+            lz = static_cast<int32_t>((node >> 6) & 63u) + REGION_MIN;
+            y = static_cast<int32_t>((node >> 12) & 255u);
+            level = static_cast<uint8_t>((node >> 20) & 15u);
+        }
+
+    } // namespace
+
+    /**
+     * @brief 3x3 chunk neighborhood, addressed in coordinates local to the
+     *        center chunk's origin ([-16, 32) horizontally)
+     */
+    struct LightPropagator::Region {
+        ChunkCoord center;
+        int32_t originX = 0;
+        int32_t originZ = 0;
+        std::array<Chunk*, 9> chunks{};
+        std::array<std::shared_ptr<Chunk>, 9> owners;
+        std::array<bool, 9> touched{};
+
+        struct Cell {
+            Chunk* chunk;
+            uint32_t slot;
+            uint32_t index;
+            uint8_t x, y, z;
+        };
+
+        bool Resolve(int32_t lx, int32_t y, int32_t lz, Cell& cell) const {
+            if (lx < REGION_MIN || lx >= REGION_MAX || lz < REGION_MIN || lz >= REGION_MAX ||
+                y < 0 || y >= COLUMN_HEIGHT) {
+                return false;
+            }
+
+            cell.slot = static_cast<uint32_t>(((lx - REGION_MIN) >> 4) + 3 * ((lz - REGION_MIN) >> 4));
+            cell.chunk = chunks[cell.slot];
+            if (!cell.chunk) {
+                return false;
+            }
+
+            cell.x = static_cast<uint8_t>(lx & 15);
+            cell.y = static_cast<uint8_t>(y);
+            cell.z = static_cast<uint8_t>(lz & 15);
+            cell.index = ChunkLightStorage::GetIndex(cell.x, cell.y, cell.z);
+            return true;
+        }
+
+        uint16_t BlockId(const Cell& cell) const {
+            return cell.chunk->GetBlockStorage().Get(cell.x, cell.y, cell.z);
+        }
+
+        uint8_t GetLight(const Cell& cell, bool sky) const {
+            const auto& light = cell.chunk->GetLightStorage();
+            return sky ? light.GetSky(cell.index) : light.GetBlock(cell.index);
+        }
+
+        void SetLight(const Cell& cell, bool sky, uint8_t level) {
+            auto& light = cell.chunk->GetLightStorage();
+            if (sky) {
+                light.SetSky(cell.index, level);
+            } else {
+                light.SetBlock(cell.index, level);
+            }
+            touched[cell.slot] = true;
+        }
+    };
+
+    /**
+     * @brief Per-thread BFS queues, reused across jobs to avoid allocation
+     */
+    struct LightPropagator::Workspace {
+        std::vector<uint32_t> addQueue;
+        std::vector<uint32_t> removeQueue;
+        std::vector<uint16_t> sectionIds;
+        uint64_t added = 0;
+        uint64_t removed = 0;
+
+        void ResetCounters() {
+            added = 0;
+            removed = 0;
+        }
+    };
+
+    LightPropagator::LightPropagator(ChunkProvider chunkProvider)
+        : m_chunkProvider(std::move(chunkProvider))
+        , m_chunksRelit(0)
+        , m_blockUpdates(0)
+        , m_nodesAdded(0)
+        , m_nodesRemoved(0)
+        , m_batches(0)
+        , m_lastBatchMs(0.0)
+    {
+    }
+
+    LightPropagator::~LightPropagator() = default;
+
+    void LightPropagator::RelightChunk(Chunk* chunk, LightChannel channels) {
+        if (!chunk) {
+            return;
+        }
+
+        Region region;
+        BuildRegion(region, chunk->GetCoord(), chunk);
+
+        Workspace& ws = GetThreadWorkspace();
+        ws.ResetCounters();
+        RelightInRegion(region, ws, channels);
+
+        m_chunksRelit.fetch_add(1, std::memory_order_relaxed);
+        m_nodesAdded.fetch_add(ws.added, std::memory_order_relaxed);
+        m_nodesRemoved.fetch_add(ws.removed, std::memory_order_relaxed);
+        NotifyTouched(region);
+    }
+
+    void LightPropagator::UpdateBlock(const WorldCoord& coord, uint16_t oldId, uint16_t newId) {
+        const auto& oldProps = BlockPropertyTable::Get(oldId);
+        const auto& newProps = BlockPropertyTable::Get(newId);
+        if (oldProps.lightOpacity == newProps.lightOpacity && oldProps.lightEmission == newProps.lightEmission) {
+            return; // e.g. stone -> dirt: light cannot change
+        }
+
+        Region region;
+        BuildRegion(region, coord.toChunkCoord(), nullptr);
+        if (!region.chunks[4]) {
+            return;
+        }
+
+        Workspace& ws = GetThreadWorkspace();
+        ws.ResetCounters();
+        UpdateBlockInRegion(region, ws, coord, newId);
+
+        m_blockUpdates.fetch_add(1, std::memory_order_relaxed);
+        m_nodesAdded.fetch_add(ws.added, std::memory_order_relaxed);
+        m_nodesRemoved.fetch_add(ws.removed, std::memory_order_relaxed);
+        NotifyTouched(region);
+    }
+
+    void LightPropagator::AddLight(const WorldCoord& coord, uint8_t level, LightChannel channel) {
+        Region region;
+        BuildRegion(region, coord.toChunkCoord(), nullptr);
+
+        Region::Cell cell;
+        if (!region.Resolve(coord.x - region.originX, coord.y, coord.z - region.originZ, cell)) {
+            return;
+        }
+
+        Workspace& ws = GetThreadWorkspace();
+        ws.ResetCounters();
+        level = std::min(level, MAX_LIGHT);
+
+        for (bool sky : { true, false }) {
+            if (!(static_cast<uint8_t>(channel) & static_cast<uint8_t>(sky ? LightChannel::SKY : LightChannel::BLOCK))) {
+                continue;
+            }
+            if (region.GetLight(cell, sky) >= level) {
+                continue;
+            }
+            region.SetLight(cell, sky, level);
+            ws.addQueue.push_back(PackNode(coord.x - region.originX, coord.y, coord.z - region.originZ));
+            PropagateAdd(region, ws, sky);
+        }
+
+        m_nodesAdded.fetch_add(ws.added, std::memory_order_relaxed);
+        NotifyTouched(region);
+    }
+
+    void LightPropagator::RemoveLight(const WorldCoord& coord, LightChannel channel) {
+        Region region;
+        BuildRegion(region, coord.toChunkCoord(), nullptr);
+
+        const int32_t lx = coord.x - region.originX;
+        const int32_t lz = coord.z - region.originZ;
+        Region::Cell cell;
+        if (!region.Resolve(lx, coord.y, lz, cell)) {
+            return;
+        }
+
+        Workspace& ws = GetThreadWorkspace();
+        ws.ResetCounters();
+
+        for (bool sky : { true, false }) {
+            if (!(static_cast<uint8_t>(channel) & static_cast<uint8_t>(sky ? LightChannel::SKY : LightChannel::BLOCK))) {
+                continue;
+            }
+            uint8_t current = region.GetLight(cell, sky);
+            if (current == 0) {
+                continue;
+            }
+            region.SetLight(cell, sky, 0);
+            ws.removeQueue.push_back(PackNode(lx, coord.y, lz, current));
+            PropagateRemove(region, ws, sky);
+            PropagateAdd(region, ws, sky);
+        }
+
+        m_nodesAdded.fetch_add(ws.added, std::memory_order_relaxed);
+        m_nodesRemoved.fetch_add(ws.removed, std::memory_order_relaxed);
+        NotifyTouched(region);
+    }
+
+    void LightPropagator::QueueBlockChange(const WorldCoord& coord, uint16_t oldId, uint16_t newId) {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        m_pending[coord.toChunkCoord()].changes.push_back({ coord, oldId, newId });
+    }
+
+    void LightPropagator::QueueChunkRelight(const ChunkCoord& coord) {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        m_pending[coord].relight = true;
+    }
+
+    bool LightPropagator::HasQueuedWork() const {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        return !m_pending.empty();
+    }
+
+    std::vector<ChunkCoord> LightPropagator::GetQueuedChunks() const {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        std::vector<ChunkCoord> coords;
+        coords.reserve(m_pending.size());
+        for (const auto& pair : m_pending) {
+            coords.push_back(pair.first);
+        }
+        return coords;
+    }
+
+    bool LightPropagator::ProcessQueuedChunk(const ChunkCoord& coord) {
+        PendingChunk job;
+        {
+            std::lock_guard<std::mutex> lock(m_pendingMutex);
+            auto it = m_pending.find(coord);
+            if (it == m_pending.end()) {
+                return false;
+            }
+            job = std::move(it->second);
+            m_pending.erase(it);
+        }
+
+        RunJob(coord, job);
+        return true;
+    }
+
+    void LightPropagator::DiscardQueued(const ChunkCoord& coord) {
+        std::lock_guard<std::mutex> lock(m_pendingMutex);
+        m_pending.erase(coord);
+    }
+
+    size_t LightPropagator::ProcessQueued(ThreadPool* pool) {
+        std::unordered_map<ChunkCoord, PendingChunk> pending;
+        {
+            std::lock_guard<std::mutex> lock(m_pendingMutex);
+            pending.swap(m_pending);
+        }
+
+        if (pending.empty()) {
+            return 0;
+        }
+
+        auto startTime = std::chrono::steady_clock::now();
+
+        // Color jobs by (x mod 3, z mod 3): same-colored 3x3 neighborhoods
+        // are disjoint, so a whole color can run concurrently
+        std::array<std::vector<std::pair<ChunkCoord, PendingChunk*>>, 9> colors;
+        for (auto& pair : pending) {
+            int32_t cx = ((pair.first.x % 3) + 3) % 3;
+            int32_t cz = ((pair.first.z % 3) + 3) % 3;
+            colors[static_cast<size_t>(cx + 3 * cz)].emplace_back(pair.first, &pair.second);
+        }
+
+        for (auto& jobs : colors) {
+            if (pool && pool->IsRunning() && jobs.size() > 1) {
+                std::vector<std::future<void>> futures;
+                futures.reserve(jobs.size());
+                for (auto& job : jobs) {
+                    futures.push_back(pool->SubmitTask([this, job]() { RunJob(job.first, *job.second); },
+                        ThreadPool::TaskPriority::HIGH, "LightPropagator"));
+                }
+                for (auto& future : futures) {
+                    future.get();
+                }
+            } else {
+                for (auto& job : jobs) {
+                    RunJob(job.first, *job.second);
+                }
+            }
+        }
+
+        auto endTime = std::chrono::steady_clock::now();
+        m_lastBatchMs.store(std::chrono::duration<double, std::milli>(endTime - startTime).count(),
+            std::memory_order_relaxed);
+        m_batches.fetch_add(1, std::memory_order_relaxed);
+
+        return pending.size();
+    }
+
+    bool LightPropagator::CanSeeSky(const WorldCoord& coord) const {
+        if (coord.y >= COLUMN_HEIGHT - 1) {
+            return true;
+        }
+        if (!m_chunkProvider || coord.y < 0) {
+            return false;
+        }
+
+        auto chunk = m_chunkProvider(coord.toChunkCoord());
+        if (!chunk) {
+            return false;
+        }
+
+        const auto& blocks = chunk->GetBlockStorage();
+        const auto local = coord.toBlockCoord();
+        for (int32_t y = coord.y + 1; y < COLUMN_HEIGHT; ++y) {
+            if (BlockPropertyTable::GetLightOpacity(blocks.Get(local.x, static_cast<uint8_t>(y), local.z)) > 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    uint8_t LightPropagator::GetSkyLight(const WorldCoord& coord) const {
+        if (!m_chunkProvider || coord.y < 0 || coord.y >= COLUMN_HEIGHT) {
+            return coord.y >= COLUMN_HEIGHT ? MAX_LIGHT : 0;
+        }
+        auto chunk = m_chunkProvider(coord.toChunkCoord());
+        if (!chunk) {
+            return 0;
+        }
+        const auto local = coord.toBlockCoord();
+        return chunk->GetLightStorage().GetSky(ChunkLightStorage::GetIndex(local.x, local.y, local.z));
+    }
+
+    uint8_t LightPropagator::GetBlockLight(const WorldCoord& coord) const {
+        if (!m_chunkProvider || coord.y < 0 || coord.y >= COLUMN_HEIGHT) {
+            return 0;
+        }
+        auto chunk = m_chunkProvider(coord.toChunkCoord());
+        if (!chunk) {
+            return 0;
+        }
+        const auto local = coord.toBlockCoord();
+        return chunk->GetLightStorage().GetBlock(ChunkLightStorage::GetIndex(local.x, local.y, local.z));
+    }
+
+    void LightPropagator::SetLightChangedCallback(std::function<void(const ChunkCoord&)> callback) {
+        m_lightChangedCallback = std::move(callback);
+    }
+
+    LightPropagatorStats LightPropagator::GetStats() const {
+        LightPropagatorStats stats;
+        stats.chunksRelit = m_chunksRelit.load(std::memory_order_relaxed);
+        stats.blockUpdates = m_blockUpdates.load(std::memory_order_relaxed);
+        stats.nodesAdded = m_nodesAdded.load(std::memory_order_relaxed);
+        stats.nodesRemoved = m_nodesRemoved.load(std::memory_order_relaxed);
+        stats.batches = m_batches.load(std::memory_order_relaxed);
+        stats.lastBatchMs = m_lastBatchMs.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void LightPropagator::BuildRegion(Region& region, const ChunkCoord& coord, Chunk* center) const {
+        region.center = coord;
+        region.originX = coord.x * 16;
+        region.originZ = coord.z * 16;
+
+        for (int32_t dz = -1; dz <= 1; ++dz) {
+            for (int32_t dx = -1; dx <= 1; ++dx) {
+                const size_t slot = static_cast<size_t>((dx + 1) + 3 * (dz + 1));
+
+                if (dx == 0 && dz == 0 && center) {
+                    region.chunks[slot] = center;
+                    continue;
+                }
+
+                if (m_chunkProvider) {
+                    region.owners[slot] = m_chunkProvider(ChunkCoord(coord.x + dx, coord.z + dz));
+                    region.chunks[slot] = region.owners[slot].get();
+                }
+
+                // Neighbors still holding placeholder light would leak it in
+                if (region.chunks[slot] && slot != 4 && !region.chunks[slot]->GetLightStorage().IsLit()) {
+                    region.chunks[slot] = nullptr;
+                }
+            }
+        }
+    }
+
+    void LightPropagator::RunJob(const ChunkCoord& coord, PendingChunk& job) {
+        Region region;
+        BuildRegion(region, coord, nullptr);
+        if (!region.chunks[4]) {
+            return;
+        }
+
+        Workspace& ws = GetThreadWorkspace();
+        ws.ResetCounters();
+
+        if (job.relight) {
+            RelightInRegion(region, ws, LightChannel::BOTH);
+            m_chunksRelit.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        for (const auto& change : job.changes) {
+            const auto& oldProps = BlockPropertyTable::Get(change.oldId);
+            const auto& newProps = BlockPropertyTable::Get(change.newId);
+            if (oldProps.lightOpacity == newProps.lightOpacity && oldProps.lightEmission == newProps.lightEmission) {
+                continue;
+            }
+            UpdateBlockInRegion(region, ws, change.coord, change.newId);
+            m_blockUpdates.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        m_nodesAdded.fetch_add(ws.added, std::memory_order_relaxed);
+        m_nodesRemoved.fetch_add(ws.removed, std::memory_order_relaxed);
+        NotifyTouched(region);
+    }
+
+    void LightPropagator::RelightInRegion(Region& region, Workspace& ws, LightChannel channels) {
+        const uint8_t mask = static_cast<uint8_t>(channels);
+
+        if (mask & static_cast<uint8_t>(LightChannel::SKY)) {
+            SeedSkyColumns(region, ws);
+            SeedBorders(region, ws, true);
+            PropagateAdd(region, ws, true);
+        }
+
+        if (mask & static_cast<uint8_t>(LightChannel::BLOCK)) {
+            region.chunks[4]->GetLightStorage().ClearBlockChannel();
+            SeedEmitters(region, ws);
+            SeedBorders(region, ws, false);
+            PropagateAdd(region, ws, false);
+        }
+
+        region.chunks[4]->GetLightStorage().SetLit(true);
+        region.touched[4] = true;
+    }
+
+    void LightPropagator::UpdateBlockInRegion(Region& region, Workspace& ws, const WorldCoord& coord, uint16_t newId) {
+        const int32_t lx = coord.x - region.originX;
+        const int32_t lz = coord.z - region.originZ;
+        const int32_t y = coord.y;
+
+        // Unlit chunks get the change through their pending full relight
+        Region::Cell cell;
+        if (!region.Resolve(lx, y, lz, cell) || !cell.chunk->GetLightStorage().IsLit()) {
+            return;
+        }
+
+        const uint8_t opacity = BlockPropertyTable::GetLightOpacity(newId);
+        const uint8_t emission = BlockPropertyTable::GetLightEmission(newId);
+
+        for (bool sky : { true, false }) {
+            // Clear the old value and everything that was lit through it;
+            // the remove pass re-seeds the add queue from brighter survivors
+            const uint8_t current = region.GetLight(cell, sky);
+            if (current > 0) {
+                region.SetLight(cell, sky, 0);
+                ws.removeQueue.push_back(PackNode(lx, y, lz, current));
+                PropagateRemove(region, ws, sky);
+            }
+
+            if (!sky && emission > 0) {
+                region.SetLight(cell, sky, emission);
+                ws.addQueue.push_back(PackNode(lx, y, lz));
+            }
+
+            if (opacity < MAX_LIGHT) {
+                if (sky && y == COLUMN_HEIGHT - 1) {
+                    region.SetLight(cell, sky, static_cast<uint8_t>(MAX_LIGHT - opacity));
+                    ws.addQueue.push_back(PackNode(lx, y, lz));
+                }
+
+                // Let light flow back in from lit neighbors
+                for (int d = 0; d < 6; ++d) {
+                    Region::Cell neighbor;
+                    const int32_t nx = lx + DIR_X[d];
+                    const int32_t ny = y + DIR_Y[d];
+                    const int32_t nz = lz + DIR_Z[d];
+                    if (region.Resolve(nx, ny, nz, neighbor) && region.GetLight(neighbor, sky) > 0) {
+                        ws.addQueue.push_back(PackNode(nx, ny, nz));
+                    }
+                }
+            }
+
+            PropagateAdd(region, ws, sky);
+        }
+    }
+
+    void LightPropagator::SeedSkyColumns(Region& region, Workspace& ws) {
+        Chunk* chunk = region.chunks[4];
+        auto& light = chunk->GetLightStorage();
+        const auto& blocks = chunk->GetBlockStorage();
+
+        // Lowest y of the unobstructed (level 15) part of each column
+        std::array<int32_t, 256> openFrom{};
+
+        for (uint32_t z = 0; z < 16; ++z) {
+            for (uint32_t x = 0; x < 16; ++x) {
+                int32_t level = MAX_LIGHT;
+                int32_t open = COLUMN_HEIGHT;
+
+                for (int32_t y = COLUMN_HEIGHT - 1; y >= 0; --y) {
+                    const uint8_t opacity = BlockPropertyTable::GetLightOpacity(
+                        blocks.Get(static_cast<uint8_t>(x), static_cast<uint8_t>(y), static_cast<uint8_t>(z)));
+
+                    // Same rule as PropagateAdd going down
+                    if (!(level == MAX_LIGHT && opacity == 0)) {
+                        level = std::max(0, level - std::max<int32_t>(1, opacity));
+                    }
+                    if (level == MAX_LIGHT) {
+                        open = y;
+                    }
+
+                    light.SetSky(ChunkLightStorage::GetIndex(x, static_cast<uint32_t>(y), z), static_cast<uint8_t>(level));
+                }
+
+                openFrom[z * 16 + x] = open;
+            }
+        }
+
+        // A lit cell only needs to spread sideways where a neighbor column
+        // is darker, i.e. below that neighbor's open part. Cross-chunk
+        // neighbors are handled by SeedBorders.
+        for (int32_t z = 0; z < 16; ++z) {
+            for (int32_t x = 0; x < 16; ++x) {
+                int32_t seedBelow = 0;
+                for (int d = 0; d < 6; ++d) {
+                    const int32_t nx = x + DIR_X[d];
+                    const int32_t nz = z + DIR_Z[d];
+                    if (DIR_Y[d] != 0 || nx < 0 || nx >= 16 || nz < 0 || nz >= 16) {
+                        continue;
+                    }
+                    seedBelow = std::max(seedBelow, openFrom[static_cast<size_t>(nz * 16 + nx)]);
+                }
+
+                seedBelow = std::min(seedBelow, COLUMN_HEIGHT);
+                for (int32_t y = 0; y < seedBelow; ++y) {
+                    if (light.GetSky(ChunkLightStorage::GetIndex(static_cast<uint32_t>(x), static_cast<uint32_t>(y),
+                        static_cast<uint32_t>(z))) > 1) {
+                        ws.addQueue.push_back(PackNode(x, y, z));
+                    }
+                }
+            }
+        }
+    }
+
+    void LightPropagator::SeedEmitters(Region& region, Workspace& ws) {
+        Chunk* chunk = region.chunks[4];
+        auto& light = chunk->GetLightStorage();
+        const auto& blocks = chunk->GetBlockStorage();
+
+        ws.sectionIds.resize(ChunkSection::SECTION_VOLUME);
+
+        for (uint32_t s = 0; s < ChunkBlockStorage::SECTION_COUNT; ++s) {
+            const ChunkSection& section = blocks.GetSection(s);
+            if (section.IsUniform() && BlockPropertyTable::GetLightEmission(section.GetUniformId()) == 0) {
+                continue;
+            }
+
+            section.Unpack(ws.sectionIds.data());
+            for (uint32_t i = 0; i < ChunkSection::SECTION_VOLUME; ++i) {
+                const uint8_t emission = BlockPropertyTable::GetLightEmission(ws.sectionIds[i]);
+                if (emission == 0) {
+                    continue;
+                }
+
+                const int32_t x = static_cast<int32_t>(i & 15u);
+                const int32_t z = static_cast<int32_t>((i >> 4) & 15u);
+                const int32_t y = static_cast<int32_t>(s * ChunkSection::SECTION_SIZE + (i >> 8));
+                light.SetBlock(ChunkLightStorage::GetIndex(static_cast<uint32_t>(x), static_cast<uint32_t>(y),
+                    static_cast<uint32_t>(z)), emission);
+                ws.addQueue.push_back(PackNode(x, y, z));
+            }
+        }
+    }
+
+    void LightPropagator::SeedBorders(Region& region, Workspace& ws, bool sky) {
+        // Inside cell and outside neighbor cell for each of the four faces
+        struct Face { int32_t insideX, insideZ, outsideX, outsideZ, stepX, stepZ; };
+        static constexpr Face faces[4] = {
+            { 0, 0, -1, 0, 0, 1 },     // -X
+            { 15, 0, 16, 0, 0, 1 },    // +X
+            { 0, 0, 0, -1, 1, 0 },     // -Z
+            { 0, 15, 0, 16, 1, 0 },    // +Z
+        };
+
+        for (const Face& face : faces) {
+            for (int32_t i = 0; i < 16; ++i) {
+                const int32_t ix = face.insideX + face.stepX * i;
+                const int32_t iz = face.insideZ + face.stepZ * i;
+                const int32_t ox = face.outsideX + face.stepX * i;
+                const int32_t oz = face.outsideZ + face.stepZ * i;
+
+                for (int32_t y = 0; y < COLUMN_HEIGHT; ++y) {
+                    Region::Cell inside;
+                    Region::Cell outside;
+                    if (!region.Resolve(ox, y, oz, outside) || !region.Resolve(ix, y, iz, inside)) {
+                        break; // Neighbor chunk not loaded: whole face is skipped
+                    }
+
+                    const uint8_t a = region.GetLight(inside, sky);
+                    const uint8_t b = region.GetLight(outside, sky);
+                    if (a > b + 1) {
+                        ws.addQueue.push_back(PackNode(ix, y, iz));
+                    } else if (b > a + 1) {
+                        ws.addQueue.push_back(PackNode(ox, y, oz));
+                    }
+                }
+            }
+        }
+    }
+
+    void LightPropagator::PropagateAdd(Region& region, Workspace& ws, bool sky) {
+        auto& queue = ws.addQueue;
+
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int32_t lx, y, lz;
+            uint8_t unused;
+            UnpackNode(queue[head], lx, y, lz, unused);
+
+            Region::Cell cell;
+            if (!region.Resolve(lx, y, lz, cell)) {
+                continue;
+            }
+
+            const uint8_t level = region.GetLight(cell, sky);
+            if (level <= 1) {
+                continue;
+            }
+            ws.added++;
+
+            for (int d = 0; d < 6; ++d) {
+                const int32_t nx = lx + DIR_X[d];
+                const int32_t ny = y + DIR_Y[d];
+                const int32_t nz = lz + DIR_Z[d];
+
+                Region::Cell neighbor;
+                if (!region.Resolve(nx, ny, nz, neighbor)) {
+                    continue;
+                }
+
+                const uint8_t opacity = BlockPropertyTable::GetLightOpacity(region.BlockId(neighbor));
+                if (opacity >= MAX_LIGHT) {
+                    continue;
+                }
+
+                int32_t newLevel;
+                if (sky && d == DIR_DOWN && level == MAX_LIGHT && opacity == 0) {
+                    newLevel = MAX_LIGHT; // Direct skylight does not attenuate going down
+                } else {
+                    newLevel = static_cast<int32_t>(level) - std::max<int32_t>(1, opacity);
+                }
+
+                if (newLevel > 0 && region.GetLight(neighbor, sky) < newLevel) {
+                    region.SetLight(neighbor, sky, static_cast<uint8_t>(newLevel));
+                    queue.push_back(PackNode(nx, ny, nz));
+                }
+            }
+        }
+
+        queue.clear();
+    }
+
+    void LightPropagator::PropagateRemove(Region& region, Workspace& ws, bool sky) {
+        auto& queue = ws.removeQueue;
+
+        for (size_t head = 0; head < queue.size(); ++head) {
+            int32_t lx, y, lz;
+            uint8_t oldLevel;
+            UnpackNode(queue[head], lx, y, lz, oldLevel);
+            ws.removed++;
+
+            for (int d = 0; d < 6; ++d) {
+                const int32_t nx = lx + DIR_X[d];
+                const int32_t ny = y + DIR_Y[d];
+                const int32_t nz = lz + DIR_Z[d];
+
+                Region::Cell neighbor;
+                if (!region.Resolve(nx, ny, nz, neighbor)) {
+                    continue;
+                }
+
+                const uint8_t level = region.GetLight(neighbor, sky);
+                if (level == 0) {
+                    continue;
+                }
+
+                const bool dependent = level < oldLevel ||
+                    (sky && d == DIR_DOWN && oldLevel == MAX_LIGHT && level == MAX_LIGHT);
+
+                if (dependent) {
+                    region.SetLight(neighbor, sky, 0);
+                    queue.push_back(PackNode(nx, ny, nz, level));
+
+                    // An emitter keeps its own light; re-spread it afterwards
+                    if (!sky) {
+                        const uint8_t emission = BlockPropertyTable::GetLightEmission(region.BlockId(neighbor));
+                        if (emission > 0) {
+                            region.SetLight(neighbor, sky, emission);
+                            ws.addQueue.push_back(PackNode(nx, ny, nz));
+                        }
+                    }
+                } else {
+                    // Independently lit: it will refill the cleared area
+                    ws.addQueue.push_back(PackNode(nx, ny, nz));
+                }
+            }
+        }
+
+        queue.clear();
+    }
+
+    void LightPropagator::NotifyTouched(const Region& region) {
+        if (!m_lightChangedCallback) {
+            return;
+        }
+
+        for (size_t slot = 0; slot < region.chunks.size(); ++slot) {
+            if (region.touched[slot] && region.chunks[slot]) {
+                m_lightChangedCallback(region.chunks[slot]->GetCoord());
+            }
+        }
+    }
+
+    LightPropagator::Workspace& LightPropagator::GetThreadWorkspace() {
+        thread_local Workspace workspace;
+        return workspace;
+    }
+
+} // namespace VoxelCraft
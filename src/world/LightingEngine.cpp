@@ -8,6 +8,8 @@
 #include "LightingEngine.hpp"
 #include "World.hpp"
 #include "Chunk.hpp"
+#include "LightPropagator.hpp"
+#include "../blocks/BlockPropertyTable.hpp"
 #include <algorithm>
 #include <cmath>
 #include <random>
@@ -19,6 +21,8 @@ namespace VoxelCraft {
         : m_gameTime(0)
         , m_dayTime(6000) // Start at noon
         , m_timeSpeed(1.0f)
+        , m_propagator(std::make_unique<LightPropagator>())
+        , m_chunkSystem(nullptr)
         , m_weatherTimer(0.0f)
         , m_weatherDuration(1200.0f) // 20 minutes default
         , m_cachedTimeOfDay(TimeOfDay::DAY)
@@ -28,6 +32,15 @@ namespace VoxelCraft {
         UpdateCachedValues();
     }
 
+    LightingEngine::~LightingEngine() = default;
+
+    LightPropagator* LightingEngine::GetPropagator() const {
+        if (m_chunkSystem && m_chunkSystem->GetLightPropagator()) {
+            return m_chunkSystem->GetLightPropagator();
+        }
+        return m_propagator.get();
+    }
+
     void LightingEngine::Update(float deltaTime) {
         UpdateGameTime(deltaTime);
         UpdateWeather(deltaTime);
@@ -54,30 +67,48 @@ namespace VoxelCraft {
     }
 
     LightLevel LightingEngine::GetLightLevel(const Vec3& position) const {
-        // This would need to query the world/chunk for actual light data
-        // For now, return basic calculation
-        uint8_t skyLight = CalculateSkyLightLevel(static_cast<int>(position.y));
-        uint8_t blockLight = 0; // Would query block light sources
+        WorldCoord coord(static_cast<int32_t>(std::floor(position.x)),
+                         static_cast<int32_t>(std::floor(position.y)),
+                         static_cast<int32_t>(std::floor(position.z)));
+
+        // Without a world to look into, use the time-of-day estimate
+        const LightPropagator* propagator = GetPropagator();
+        if (!propagator->HasChunkProvider()) {
+            return LightLevel(CalculateSkyLightLevel(coord.y), 0);
+        }
+
+        // Stored sky light is relative to full daylight
+        int darkening = ChunkLightStorage::MAX_LIGHT - GetDaylightLevel();
+        int skyLight = std::max(0, propagator->GetSkyLight(coord) - darkening);
+        uint8_t blockLight = propagator->GetBlockLight(coord);
 
-        return LightLevel(skyLight, blockLight);
+        return LightLevel(static_cast<uint8_t>(skyLight), blockLight);
     }
 
     LightLevel LightingEngine::GetLightLevel(const Chunk* chunk, int localX, int y, int localZ) const {
-        // Would query chunk light data
-        uint8_t skyLight = CalculateSkyLightLevel(y);
-        uint8_t blockLight = 0; // Would query chunk block lights
+        if (!chunk || localX < 0 || localX >= 16 || localZ < 0 || localZ >= 16 || y < 0 || y >= 256) {
+            return LightLevel(CalculateSkyLightLevel(y), 0);
+        }
+
+        const auto& light = chunk->GetLightStorage();
+        uint32_t index = ChunkLightStorage::GetIndex(static_cast<uint32_t>(localX), static_cast<uint32_t>(y),
+                                                     static_cast<uint32_t>(localZ));
+
+        int darkening = ChunkLightStorage::MAX_LIGHT - GetDaylightLevel();
+        int skyLight = std::max(0, light.GetSky(index) - darkening);
 
-        return LightLevel(skyLight, blockLight);
+        return LightLevel(static_cast<uint8_t>(skyLight), light.GetBlock(index));
     }
 
     void LightingEngine::SetBlockLightLevel(const Vec3& position, uint8_t level) {
-        // Would update block light data in chunk
         if (level > 0) {
             LightSource source(position, level, LightType::BLOCK);
             AddLightSource(source);
         } else {
             RemoveLightSource(position);
         }
+
+        PropagateLight(position, level, LightType::BLOCK);
     }
 
     void LightingEngine::AddLightSource(const LightSource& lightSource) {
@@ -110,24 +141,27 @@ namespace VoxelCraft {
     }
 
     void LightingEngine::CalculateLightPropagation(Chunk* chunk) {
-        UpdateSkyLight(chunk);
-        UpdateBlockLight(chunk);
+        GetPropagator()->RelightChunk(chunk, LightChannel::BOTH);
     }
 
     void LightingEngine::UpdateSkyLight(Chunk* chunk) {
-        // Would implement sky light calculation for chunk
-        // This involves ray tracing from sky to each block
+        GetPropagator()->RelightChunk(chunk, LightChannel::SKY);
     }
 
     void LightingEngine::UpdateBlockLight(Chunk* chunk) {
-        // Would implement block light calculation for chunk
-        // This involves flood fill from light sources
+        GetPropagator()->RelightChunk(chunk, LightChannel::BLOCK);
     }
 
     bool LightingEngine::CanSeeSky(const Vec3& position) const {
-        // Would implement sky visibility check
-        // This would check blocks above the position
-        return position.y >= 255; // Simplified
+        const LightPropagator* propagator = GetPropagator();
+        if (!propagator->HasChunkProvider()) {
+            // Same cut-off as CalculateSkyLightLevel's full sky light
+            return position.y >= 255.0f;
+        }
+
+        return propagator->CanSeeSky(WorldCoord(static_cast<int32_t>(std::floor(position.x)),
+                                                  static_cast<int32_t>(std::floor(position.y)),
+                                                  static_cast<int32_t>(std::floor(position.z))));
     }
 
     float LightingEngine::GetBrightness() const {
@@ -229,24 +263,7 @@ namespace VoxelCraft {
         // Sky light decreases with depth
         if (y >= 255) return 15; // Full sky light above world
 
-        int skyLight = 15;
-
-        // Reduce light based on time of day
-        switch (m_cachedTimeOfDay) {
-            case TimeOfDay::DAY:
-                skyLight = 15;
-                break;
-            case TimeOfDay::DAWN:
-            case TimeOfDay::DUSK:
-                skyLight = 12;
-                break;
-            case TimeOfDay::NIGHT:
-                skyLight = 4; // Moon light
-                break;
-            case TimeOfDay::MIDNIGHT:
-                skyLight = 0; // No light at midnight
-                break;
-        }
+        int skyLight = GetDaylightLevel();
 
         // Reduce light with depth
         if (y < 255) {
@@ -257,39 +274,37 @@ namespace VoxelCraft {
         return static_cast<uint8_t>(skyLight);
     }
 
-    uint8_t LightingEngine::GetBlockLightLevel(BlockType blockType) const {
-        switch (blockType) {
-            case BlockType::TORCH:
-                return 14;
-            case BlockType::GLOWSTONE:
-                return 15;
-            case BlockType::LAVA:
-                return 15;
-            case BlockType::SOUL_TORCH:
-                return 10;
-            case BlockType::SEA_LANTERN:
-                return 15;
-            case BlockType::END_ROD:
-                return 14;
-            case BlockType::CRYING_OBSIDIAN:
-                return 10;
-            case BlockType::SOUL_LANTERN:
-                return 10;
-            case BlockType::CAMPFIRE:
-            case BlockType::SOUL_CAMPFIRE:
-                return 15;
-            case BlockType::LANTERN:
-            case BlockType::SOUL_LANTERN:
+    uint8_t LightingEngine::GetDaylightLevel() const {
+        // Reduce light based on time of day
+        switch (m_cachedTimeOfDay) {
+            case TimeOfDay::DAY:
                 return 15;
-            default:
-                return 0;
+            case TimeOfDay::DAWN:
+            case TimeOfDay::DUSK:
+                return 12;
+            case TimeOfDay::NIGHT:
+                return 4; // Moon light
+            case TimeOfDay::MIDNIGHT:
+                return 0; // No light at midnight
         }
+        return 15;
+    }
+
+    uint8_t LightingEngine::GetBlockLightLevel(BlockType blockType) const {
+        return BlockPropertyTable::GetLightEmission(static_cast<uint16_t>(blockType));
     }
 
     void LightingEngine::PropagateLight(const Vec3& position, uint8_t level, LightType type) {
-        // Would implement light propagation algorithm
-        // This is a complex flood fill algorithm that would need to be implemented
-        // based on the specific lighting system design
+        WorldCoord coord(static_cast<int32_t>(std::floor(position.x)),
+                         static_cast<int32_t>(std::floor(position.y)),
+                         static_cast<int32_t>(std::floor(position.z)));
+        LightChannel channel = type == LightType::SKY ? LightChannel::SKY : LightChannel::BLOCK;
+
+        if (level > 0) {
+            GetPropagator()->AddLight(coord, level, channel);
+        } else {
+            GetPropagator()->RemoveLight(coord, channel);
+        }
     }
 
     void LightingEngine::InitializeSkyColors() {
@@ -21,6 +21,8 @@ namespace VoxelCraft {
     // Forward declarations
     class World;
     class Chunk;
+    class ChunkSystem;
+    class LightPropagator;
     struct Vec3;
 
     /**
@@ -196,6 +198,23 @@ namespace VoxelCraft {
          */
         LightingEngine();
 
+        /**
+         * @brief Destructor
+         */
+        ~LightingEngine();
+
+        /**
+         * @brief Attach the chunk system whose light propagator is used
+         * @param chunkSystem Chunk system (nullptr lights chunks in isolation)
+         */
+        void SetChunkSystem(ChunkSystem* chunkSystem) { m_chunkSystem = chunkSystem; }
+
+        /**
+         * @brief Get the BFS light propagator in use
+         * @return Chunk system propagator if attached, else the local one
+         */
+        LightPropagator* GetPropagator() const;
+
         /**
          * @brief Update lighting system
          * @param deltaTime Time since last update
@@ -389,6 +408,8 @@ namespace VoxelCraft {
         // Lighting data
         std::unordered_map<Vec3, LightSource, std::hash<Vec3>> m_lightSources;
         mutable std::mutex m_lightSourcesMutex;
+        std::unique_ptr<LightPropagator> m_propagator;   // Fallback without ChunkSystem
+        ChunkSystem* m_chunkSystem;
 
         // Weather system
         WeatherCondition m_weather;
@@ -428,6 +449,12 @@ namespace VoxelCraft {
          */
         uint8_t CalculateSkyLightLevel(int y) const;
 
+        /**
+         * @brief Get open-sky light level for the current time of day
+         * @return Sky light level (0-15)
+         */
+        uint8_t GetDaylightLevel() const;
+
         /**
          * @brief Get light level from block
          * @param blockType Block type
@@ -0,0 +1,575 @@
+/**
+ * @file NoiseGenerator.cpp
+ * @brief VoxelCraft Advanced Noise Generation System Implementation
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#include "NoiseGenerator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+
+#if VOXELCRAFT_NOISE_X86 && defined(_MSC_VER) && !defined(__clang__)
+    #include <intrin.h>
+    #include <immintrin.h>
+#endif
+
+namespace VoxelCraft {
+
+namespace {
+
+NoiseSimdLevel DetectSimdLevel() {
+#if VOXELCRAFT_NOISE_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    const bool sse41 = (info[2] & (1 << 19)) != 0;
+    // AVX state must also be enabled by the OS (OSXSAVE + XCR0 bits 1-2)
+    const bool osAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 &&
+                       (_xgetbv(0) & 0x6) == 0x6;
+    bool avx2 = false;
+    if (maxLeaf >= 7 && osAvx) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    const bool sse41 = __builtin_cpu_supports("sse4.1");
+    const bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+    if (avx2) {
+        return NoiseSimdLevel::AVX2;
+    }
+    if (sse41) {
+        return NoiseSimdLevel::SSE41;
+    }
+#endif
+    return NoiseSimdLevel::Scalar;
+}
+
+NoiseKernels::Basis BasisOf(NoiseType type) {
+    switch (type) {
+        case NoiseType::Simplex:
+        case NoiseType::OpenSimplex:
+            return NoiseKernels::Basis::Simplex;
+        case NoiseType::Value:
+            return NoiseKernels::Basis::Value;
+        case NoiseType::Worley:
+            return NoiseKernels::Basis::Worley;
+        case NoiseType::White:
+            return NoiseKernels::Basis::White;
+        default:
+            return NoiseKernels::Basis::Perlin;
+    }
+}
+
+NoiseKernels::Fractal FractalOf(NoiseType type) {
+    switch (type) {
+        case NoiseType::Fractal:
+            return NoiseKernels::Fractal::FBm;
+        case NoiseType::Ridged:
+            return NoiseKernels::Fractal::Ridged;
+        case NoiseType::Billow:
+            return NoiseKernels::Fractal::Billow;
+        case NoiseType::Hybrid:
+            return NoiseKernels::Fractal::Hybrid;
+        default:
+            return NoiseKernels::Fractal::None;
+    }
+}
+
+uint32_t FloatBits(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+} // namespace
+
+NoiseGenerator::NoiseGenerator(const NoiseConfig& config)
+    : m_config(config)
+    , m_simdLevel(GetSupportedSimdLevel())
+    , m_permutationTable{}
+    , m_randomEngine(static_cast<uint32_t>(config.seed))
+    , m_cachingEnabled(false)
+    , m_maxCacheSize(65536)
+    , m_metrics{}
+{
+    Initialize();
+}
+
+NoiseGenerator::~NoiseGenerator() = default;
+
+void NoiseGenerator::Initialize() {
+    GeneratePermutationTable();
+
+    const NoiseKernels::Basis basis = BasisOf(m_config.type);
+    m_params = MakeParams(basis, FractalOf(m_config.type));
+    m_fractalParams = MakeParams(basis, NoiseKernels::Fractal::FBm);
+    m_ridgedParams = MakeParams(basis, NoiseKernels::Fractal::Ridged);
+    m_billowParams = MakeParams(basis, NoiseKernels::Fractal::Billow);
+    m_hybridParams = MakeParams(basis, NoiseKernels::Fractal::Hybrid);
+    m_cellularParams = MakeParams(NoiseKernels::Basis::Worley, NoiseKernels::Fractal::None);
+    m_cellularParams.amplitude = 1.0f;
+}
+
+void NoiseGenerator::GeneratePermutationTable() {
+    // Explicit Fisher-Yates on raw mt19937 output: std::shuffle differs between
+    // standard libraries, and a seed must give the same world everywhere
+    m_randomEngine.seed(static_cast<uint32_t>(m_config.seed));
+    std::iota(m_permutationTable.begin(), m_permutationTable.begin() + 256, 0);
+    for (uint32_t i = 255; i > 0; --i) {
+        const uint32_t j = static_cast<uint32_t>(m_randomEngine() % (i + 1));
+        std::swap(m_permutationTable[i], m_permutationTable[j]);
+    }
+    std::copy_n(m_permutationTable.begin(), 256, m_permutationTable.begin() + 256);
+}
+
+NoiseKernels::Params NoiseGenerator::MakeParams(NoiseKernels::Basis basis, NoiseKernels::Fractal fractal) const {
+    NoiseKernels::Params params;
+    params.permutation = m_permutationTable.data();
+    params.basis = basis;
+    params.fractal = fractal;
+    params.octaves = fractal == NoiseKernels::Fractal::None
+                   ? 1 : std::clamp(m_config.octaves, 1, NoiseKernels::MAX_OCTAVES);
+    params.seed = m_config.seed;
+    params.amplitude = m_config.amplitude;
+    params.gain = m_config.gain;
+
+    float frequency = m_config.frequency * m_config.scale;
+    float amplitude = 1.0f;
+    float amplitudeSum = 0.0f;
+    for (int octave = 0; octave < params.octaves; ++octave) {
+        params.octaveFrequency[octave] = frequency;
+        params.octaveAmplitude[octave] = amplitude;
+        amplitudeSum += amplitude;
+        frequency *= m_config.lacunarity;
+        amplitude *= m_config.persistence;
+    }
+    params.bounding = amplitudeSum > 0.0f ? 1.0f / amplitudeSum : 1.0f;
+    return params;
+}
+
+// 2D Noise Functions
+
+float NoiseGenerator::GetNoise(float x, float y) {
+    return Evaluate2D(x, y);
+}
+
+float NoiseGenerator::GetNoise(int x, int y) {
+    return Evaluate2D(static_cast<float>(x), static_cast<float>(y));
+}
+
+float NoiseGenerator::GetFractal(float x, float y) {
+    return NoiseKernels::Scalar::Evaluate2D(m_fractalParams, x, y);
+}
+
+// 3D Noise Functions
+
+float NoiseGenerator::GetNoise(float x, float y, float z) {
+    return Evaluate3D(x, y, z);
+}
+
+float NoiseGenerator::GetNoise(int x, int y, int z) {
+    return Evaluate3D(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z));
+}
+
+float NoiseGenerator::GetFractal(float x, float y, float z) {
+    return NoiseKernels::Scalar::Evaluate3D(m_fractalParams, x, y, z);
+}
+
+// Specialized Noise Functions
+
+float NoiseGenerator::GetRidged(float x, float y) {
+    return NoiseKernels::Scalar::Evaluate2D(m_ridgedParams, x, y);
+}
+
+float NoiseGenerator::GetBillow(float x, float y) {
+    return NoiseKernels::Scalar::Evaluate2D(m_billowParams, x, y);
+}
+
+float NoiseGenerator::GetCellular(float x, float y) {
+    return NoiseUtils::Normalize(NoiseKernels::Scalar::Evaluate2D(m_cellularParams, x, y));
+}
+
+float NoiseGenerator::GetHybrid(float x, float y) {
+    return NoiseKernels::Scalar::Evaluate2D(m_hybridParams, x, y);
+}
+
+// Batch Functions
+
+void NoiseGenerator::FillGrid2D(float* out, float x, float y, float step, int width, int height) {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    NoiseKernels::Grid grid;
+    grid.x = x;
+    grid.y = y;
+    grid.step = step;
+    grid.width = width;
+    grid.height = height;
+
+    const auto start = std::chrono::steady_clock::now();
+    switch (m_simdLevel) {
+#if VOXELCRAFT_NOISE_X86
+        case NoiseSimdLevel::AVX2:
+            NoiseKernels::Avx2::FillGrid2D(m_params, grid, out);
+            break;
+        case NoiseSimdLevel::SSE41:
+            NoiseKernels::Sse41::FillGrid2D(m_params, grid, out);
+            break;
+#endif
+        default:
+            NoiseKernels::Scalar::FillGrid2D(m_params, grid, out);
+            break;
+    }
+    UpdateMetrics(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(),
+                  static_cast<size_t>(width) * static_cast<size_t>(height));
+}
+
+void NoiseGenerator::FillGrid3D(float* out, float x, float y, float z, float step, int width, int height, int depth) {
+    if (width <= 0 || height <= 0 || depth <= 0) {
+        return;
+    }
+
+    NoiseKernels::Grid grid;
+    grid.x = x;
+    grid.y = y;
+    grid.z = z;
+    grid.step = step;
+    grid.width = width;
+    grid.height = height;
+    grid.depth = depth;
+
+    const auto start = std::chrono::steady_clock::now();
+    switch (m_simdLevel) {
+#if VOXELCRAFT_NOISE_X86
+        case NoiseSimdLevel::AVX2:
+            NoiseKernels::Avx2::FillGrid3D(m_params, grid, out);
+            break;
+        case NoiseSimdLevel::SSE41:
+            NoiseKernels::Sse41::FillGrid3D(m_params, grid, out);
+            break;
+#endif
+        default:
+            NoiseKernels::Scalar::FillGrid3D(m_params, grid, out);
+            break;
+    }
+    UpdateMetrics(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(),
+                  static_cast<size_t>(width) * static_cast<size_t>(height) * static_cast<size_t>(depth));
+}
+
+void NoiseGenerator::GetNoiseBatch(const float* xs, const float* ys, size_t count, float* out) {
+    if (count == 0) {
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    switch (m_simdLevel) {
+#if VOXELCRAFT_NOISE_X86
+        case NoiseSimdLevel::AVX2:
+            NoiseKernels::Avx2::FillPoints2D(m_params, xs, ys, count, out);
+            break;
+        case NoiseSimdLevel::SSE41:
+            NoiseKernels::Sse41::FillPoints2D(m_params, xs, ys, count, out);
+            break;
+#endif
+        default:
+            NoiseKernels::Scalar::FillPoints2D(m_params, xs, ys, count, out);
+            break;
+    }
+    UpdateMetrics(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), count);
+}
+
+void NoiseGenerator::GetNoiseBatch(const float* xs, const float* ys, const float* zs, size_t count, float* out) {
+    if (count == 0) {
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    switch (m_simdLevel) {
+#if VOXELCRAFT_NOISE_X86
+        case NoiseSimdLevel::AVX2:
+            NoiseKernels::Avx2::FillPoints3D(m_params, xs, ys, zs, count, out);
+            break;
+        case NoiseSimdLevel::SSE41:
+            NoiseKernels::Sse41::FillPoints3D(m_params, xs, ys, zs, count, out);
+            break;
+#endif
+        default:
+            NoiseKernels::Scalar::FillPoints3D(m_params, xs, ys, zs, count, out);
+            break;
+    }
+    UpdateMetrics(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(), count);
+}
+
+NoiseSimdLevel NoiseGenerator::GetSupportedSimdLevel() {
+    static const NoiseSimdLevel level = DetectSimdLevel();
+    return level;
+}
+
+void NoiseGenerator::SetSimdLevel(NoiseSimdLevel level) {
+    m_simdLevel = std::min(level, GetSupportedSimdLevel());
+}
+
+// Configuration
+
+void NoiseGenerator::SetConfig(const NoiseConfig& config) {
+    m_config = config;
+    Initialize();
+    ClearCache();
+}
+
+void NoiseGenerator::ResetMetrics() {
+    std::unique_lock<std::shared_mutex> lock(m_metricsMutex);
+    m_metrics = NoiseMetrics{};
+}
+
+// Caching system
+
+void NoiseGenerator::SetCachingEnabled(bool enabled) {
+    m_cachingEnabled = enabled;
+    if (!enabled) {
+        ClearCache();
+    }
+}
+
+void NoiseGenerator::ClearCache() {
+    std::unique_lock<std::shared_mutex> lock(m_cacheMutex);
+    m_cache2D.clear();
+    m_cache3D.clear();
+}
+
+size_t NoiseGenerator::GetCacheSize() const {
+    std::shared_lock<std::shared_mutex> lock(m_cacheMutex);
+    return m_cache2D.size() + m_cache3D.size();
+}
+
+double NoiseGenerator::GetCacheHitRate() const {
+    std::shared_lock<std::shared_mutex> lock(m_metricsMutex);
+    return m_metrics.cacheHitRate;
+}
+
+float NoiseGenerator::Evaluate2D(float x, float y) {
+    if (!m_cachingEnabled) {
+        return NoiseKernels::Scalar::Evaluate2D(m_params, x, y);
+    }
+
+    const uint64_t key = MakeCacheKey2D(x, y);
+    {
+        std::shared_lock<std::shared_mutex> lock(m_cacheMutex);
+        auto it = m_cache2D.find(key);
+        if (it != m_cache2D.end()) {
+            const float value = it->second;
+            lock.unlock();
+            UpdateCacheMetrics(true);
+            return value;
+        }
+    }
+
+    const float value = NoiseKernels::Scalar::Evaluate2D(m_params, x, y);
+    {
+        std::unique_lock<std::shared_mutex> lock(m_cacheMutex);
+        if (m_cache2D.size() >= m_maxCacheSize) {
+            m_cache2D.clear();
+        }
+        m_cache2D.emplace(key, value);
+    }
+    UpdateCacheMetrics(false);
+    return value;
+}
+
+float NoiseGenerator::Evaluate3D(float x, float y, float z) {
+    const uint64_t key = m_cachingEnabled ? MakeCacheKey3D(x, y, z) : UINT64_MAX;
+    if (key == UINT64_MAX) {
+        return NoiseKernels::Scalar::Evaluate3D(m_params, x, y, z);
+    }
+
+    {
+        std::shared_lock<std::shared_mutex> lock(m_cacheMutex);
+        auto it = m_cache3D.find(key);
+        if (it != m_cache3D.end()) {
+            const float value = it->second;
+            lock.unlock();
+            UpdateCacheMetrics(true);
+            return value;
+        }
+    }
+
+    const float value = NoiseKernels::Scalar::Evaluate3D(m_params, x, y, z);
+    {
+        std::unique_lock<std::shared_mutex> lock(m_cacheMutex);
+        if (m_cache3D.size() >= m_maxCacheSize) {
+            m_cache3D.clear();
+        }
+        m_cache3D.emplace(key, value);
+    }
+    UpdateCacheMetrics(false);
+    return value;
+}
+
+void NoiseGenerator::UpdateMetrics(double time, size_t samples) {
+    std::unique_lock<std::shared_mutex> lock(m_metricsMutex);
+    const double perSample = time / static_cast<double>(samples);
+    if (m_metrics.totalCalls == 0 || perSample < m_metrics.minTime) {
+        m_metrics.minTime = perSample;
+    }
+    m_metrics.maxTime = std::max(m_metrics.maxTime, perSample);
+    m_metrics.totalCalls += samples;
+    m_metrics.totalTime += time;
+    m_metrics.averageTime = m_metrics.totalTime / static_cast<double>(m_metrics.totalCalls);
+}
+
+void NoiseGenerator::UpdateCacheMetrics(bool cacheHit) {
+    std::unique_lock<std::shared_mutex> lock(m_metricsMutex);
+    if (cacheHit) {
+        m_metrics.cacheHits++;
+    } else {
+        m_metrics.cacheMisses++;
+    }
+    m_metrics.cacheHitRate = static_cast<double>(m_metrics.cacheHits) /
+                             static_cast<double>(m_metrics.cacheHits + m_metrics.cacheMisses);
+}
+
+uint64_t NoiseGenerator::MakeCacheKey2D(float x, float y) const {
+    return (static_cast<uint64_t>(FloatBits(x)) << 32) | FloatBits(y);
+}
+
+uint64_t NoiseGenerator::MakeCacheKey3D(float x, float y, float z) const {
+    // Exact only for integer coordinates within +-2^20; anything else bypasses the cache
+    constexpr float LIMIT = 1048576.0f;
+    if (std::floor(x) != x || std::floor(y) != y || std::floor(z) != z ||
+        std::fabs(x) >= LIMIT || std::fabs(y) >= LIMIT || std::fabs(z) >= LIMIT) {
+        return UINT64_MAX;
+    }
+    auto pack = [](float v) {
+        return static_cast<uint64_t>(static_cast<int64_t>(v) + (1 << 20)) & 0x1FFFFFu;
+    };
+    return (pack(x) << 42) | (pack(y) << 21) | pack(z);
+}
+
+// NoiseGeneratorFactory
+
+std::unique_ptr<NoiseGenerator> NoiseGeneratorFactory::CreateGenerator(const NoiseConfig& config) {
+    return std::make_unique<NoiseGenerator>(config);
+}
+
+std::unique_ptr<NoiseGenerator> NoiseGeneratorFactory::CreatePerlinGenerator(int seed, float frequency, float amplitude) {
+    NoiseConfig config = GetDefaultConfig(NoiseType::Perlin, seed);
+    config.frequency = frequency;
+    config.amplitude = amplitude;
+    return CreateGenerator(config);
+}
+
+std::unique_ptr<NoiseGenerator> NoiseGeneratorFactory::CreateSimplexGenerator(int seed, float frequency, float amplitude) {
+    NoiseConfig config = GetDefaultConfig(NoiseType::Simplex, seed);
+    config.frequency = frequency;
+    config.amplitude = amplitude;
+    return CreateGenerator(config);
+}
+
+std::unique_ptr<NoiseGenerator> NoiseGeneratorFactory::CreateFractalGenerator(int seed, int octaves,
+                                                                             float persistence, float lacunarity) {
+    NoiseConfig config = GetDefaultConfig(NoiseType::Fractal, seed);
+    config.octaves = octaves;
+    config.persistence = persistence;
+    config.lacunarity = lacunarity;
+    return CreateGenerator(config);
+}
+
+std::unique_ptr<NoiseGenerator> NoiseGeneratorFactory::CreateTerrainGenerator(int seed) {
+    NoiseConfig config = GetDefaultConfig(NoiseType::Fractal, seed);
+    config.frequency = 0.005f;
+    config.octaves = 6;
+    return CreateGenerator(config);
+}
+
+std::unique_ptr<NoiseGenerator> NoiseGeneratorFactory::CreateCaveGenerator(int seed) {
+    NoiseConfig config = GetDefaultConfig(NoiseType::Fractal, seed);
+    config.frequency = 0.03f;
+    config.octaves = 3;
+    return CreateGenerator(config);
+}
+
+NoiseConfig NoiseGeneratorFactory::GetDefaultConfig(NoiseType type, int seed) {
+    NoiseConfig config;
+    config.type = type;
+    config.seed = seed;
+    config.frequency = 0.01f;
+    config.amplitude = 1.0f;
+    config.octaves = FractalOf(type) == NoiseKernels::Fractal::None ? 1 : 4;
+    config.persistence = 0.5f;
+    config.lacunarity = 2.0f;
+    config.scale = 1.0f;
+    config.quality = NoiseQuality::Medium;
+    config.fractalBounding = 1.0f;
+    config.gain = 2.0f;
+    config.weightedStrength = 0.0f;
+    return config;
+}
+
+// NoiseUtils
+
+float NoiseUtils::Normalize(float noise) {
+    return std::clamp((noise + 1.0f) * 0.5f, 0.0f, 1.0f);
+}
+
+float NoiseUtils::Clamp(float noise, float min, float max) {
+    return std::clamp(noise, min, max);
+}
+
+float NoiseUtils::ApplyCurve(float noise, std::function<float(float)> curve) {
+    return curve ? curve(noise) : noise;
+}
+
+float NoiseUtils::Combine(float noise1, float noise2, std::function<float(float, float)> operation) {
+    return operation ? operation(noise1, noise2) : noise1;
+}
+
+int NoiseUtils::SeedFromString(const std::string& seedString) {
+    // FNV-1a, stable across platforms unlike std::hash
+    uint32_t hash = 2166136261u;
+    for (const char c : seedString) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 16777619u;
+    }
+    return static_cast<int>(hash);
+}
+
+int NoiseUtils::GenerateRandomSeed() {
+    std::random_device device;
+    return static_cast<int>(device());
+}
+
+float NoiseUtils::MixNoises(const std::vector<float>& noises, const std::vector<float>& weights) {
+    const size_t count = std::min(noises.size(), weights.size());
+    float sum = 0.0f;
+    float weightSum = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        sum += noises[i] * weights[i];
+        weightSum += weights[i];
+    }
+    return weightSum != 0.0f ? sum / weightSum : 0.0f;
+}
+
+float NoiseUtils::ApplyTurbulence(float noise, float turbulence) {
+    return noise + std::fabs(noise) * turbulence;
+}
+
+std::pair<float, float> NoiseUtils::GenerateGradient(NoiseGenerator* noiseGenerator, float x, float y, float radius) {
+    if (!noiseGenerator || radius <= 0.0f) {
+        return {0.0f, 0.0f};
+    }
+    const float dx = noiseGenerator->GetNoise(x + radius, y) - noiseGenerator->GetNoise(x - radius, y);
+    const float dy = noiseGenerator->GetNoise(x, y + radius) - noiseGenerator->GetNoise(x, y - radius);
+    return {dx / (2.0f * radius), dy / (2.0f * radius)};
+}
+
+} // namespace VoxelCraft
@@ -16,11 +16,14 @@
 #include <array>
 #include <random>
 #include <functional>
+#include <string>
+#include <cstdint>
 #include <unordered_map>
 #include <mutex>
 #include <shared_mutex>
 
 #include "../core/Config.hpp"
+#include "NoiseKernels.hpp"
 
 namespace VoxelCraft {
 
@@ -53,6 +56,16 @@ namespace VoxelCraft {
         Ultra           ///< Ultra quality, slowest generation
     };
 
+    /**
+     * @enum NoiseSimdLevel
+     * @brief Instruction set used by the batch functions
+     */
+    enum class NoiseSimdLevel {
+        Scalar,         ///< Portable, one sample at a time
+        SSE41,          ///< 4 samples per instruction
+        AVX2            ///< 8 samples per instruction
+    };
+
     /**
      * @struct NoiseConfig
      * @brief Configuration for noise generation
@@ -105,9 +118,19 @@ namespace VoxelCraft {
      * Features:
      * - Configurable parameters (frequency, amplitude, octaves)
      * - Multiple quality levels
-     * - Caching system for performance
+     * - Batch evaluation of whole grids with SSE4.1/AVX2, picked at runtime
+     * - Optional coordinate cache (off by default)
      * - Thread-safe operations
      * - 2D and 3D noise generation
+     *
+     * Sample coordinates are multiplied by frequency * scale. OpenSimplex
+     * uses the Simplex kernel and Gradient the Perlin one; the fractal types
+     * (Fractal, Ridged, Billow, Hybrid) layer Perlin octaves.
+     *
+     * The batch functions return exactly the same bits as calling GetNoise
+     * on each point, whichever instruction set runs them, so callers can
+     * mix both freely. Prefer them for anything larger than a few samples:
+     * one call fills a 16x16 column grid or a 16x16x16 section.
      */
     class NoiseGenerator {
     public:
@@ -221,6 +244,59 @@ namespace VoxelCraft {
          */
         float GetHybrid(float x, float y);
 
+        // Batch Functions
+
+        /**
+         * @brief Fill a width x height grid of 2D noise
+         * @param out Receives out[j * width + i] = GetNoise(x + i * step, y + j * step)
+         * @param x X of the first sample
+         * @param y Y of the first sample
+         * @param step Distance between samples
+         * @param width Samples along X
+         * @param height Samples along Y
+         */
+        void FillGrid2D(float* out, float x, float y, float step, int width, int height);
+
+        /**
+         * @brief Fill a width x height x depth grid of 3D noise
+         * @param out Receives XZ slices stacked along Y:
+         *            out[(j * depth + k) * width + i] = GetNoise(x + i * step, y + j * step, z + k * step)
+         * @param x X of the first sample
+         * @param y Y of the first sample
+         * @param z Z of the first sample
+         * @param step Distance between samples
+         * @param width Samples along X
+         * @param height Samples along Y
+         * @param depth Samples along Z
+         */
+        void FillGrid3D(float* out, float x, float y, float z, float step, int width, int height, int depth);
+
+        /**
+         * @brief 2D noise at arbitrary points: out[i] = GetNoise(xs[i], ys[i])
+         */
+        void GetNoiseBatch(const float* xs, const float* ys, size_t count, float* out);
+
+        /**
+         * @brief 3D noise at arbitrary points: out[i] = GetNoise(xs[i], ys[i], zs[i])
+         */
+        void GetNoiseBatch(const float* xs, const float* ys, const float* zs, size_t count, float* out);
+
+        /**
+         * @brief Best instruction set this CPU supports
+         */
+        static NoiseSimdLevel GetSupportedSimdLevel();
+
+        /**
+         * @brief Instruction set used by the batch functions
+         */
+        NoiseSimdLevel GetSimdLevel() const { return m_simdLevel; }
+
+        /**
+         * @brief Force an instruction set; clamped to what the CPU supports
+         * @param level Requested level
+         */
+        void SetSimdLevel(NoiseSimdLevel level);
+
         // Configuration
 
         /**
@@ -255,7 +331,12 @@ namespace VoxelCraft {
         // Caching system
 
         /**
-         * @brief Enable/disable caching
+         * @brief Enable/disable caching of GetNoise results
+         *
+         * Off by default: a hash lookup under a lock costs more than the
+         * noise itself for every type except deep fractals. Batch functions
+         * never use the cache.
+         *
          * @param enabled Enable state
          */
         void SetCachingEnabled(bool enabled);
@@ -295,49 +376,42 @@ namespace VoxelCraft {
         void GeneratePermutationTable();
 
         /**
-         * @brief Update metrics after noise generation
-         * @param time Time taken for generation
-         * @param cacheHit Whether result was cached
+         * @brief Resolve the kernel parameters for one basis/fractal combination
          */
-        void UpdateMetrics(double time, bool cacheHit);
+        NoiseKernels::Params MakeParams(NoiseKernels::Basis basis, NoiseKernels::Fractal fractal) const;
 
-        // Core noise functions
-        float Perlin2D(float x, float y);
-        float Simplex2D(float x, float y);
-        float Value2D(float x, float y);
-        float Worley2D(float x, float y);
-        float OpenSimplex2D(float x, float y);
-
-        float Perlin3D(float x, float y, float z);
-        float Simplex3D(float x, float y, float z);
-        float Value3D(float x, float y, float z);
-        float Worley3D(float x, float y, float z);
-        float OpenSimplex3D(float x, float y, float z);
+        /**
+         * @brief Record a batch call
+         * @param time Seconds spent
+         * @param samples Number of values produced
+         */
+        void UpdateMetrics(double time, size_t samples);
 
-        // Fractal noise functions
-        float Fractal2D(float x, float y);
-        float Fractal3D(float x, float y, float z);
-        float RidgedFractal2D(float x, float y);
-        float BillowFractal2D(float x, float y);
-        float HybridFractal2D(float x, float y);
+        /**
+         * @brief Record a cached GetNoise call
+         */
+        void UpdateCacheMetrics(bool cacheHit);
 
-        // Helper functions
-        float Fade(float t) const;
-        float Lerp(float a, float b, float t) const;
-        float Grad(int hash, float x, float y, float z) const;
-        float Grad(int hash, float x, float y) const;
-        int FastFloor(float x) const;
+        float Evaluate2D(float x, float y);
+        float Evaluate3D(float x, float y, float z);
 
         // Configuration
         NoiseConfig m_config;
+        NoiseSimdLevel m_simdLevel;
 
-        // Permutation tables for noise generation
+        // Permutation table for noise generation (256 entries repeated)
         std::array<int, 512> m_permutationTable;
-        std::array<int, 256> m_gradientTable;
+
+        // Kernel parameters derived from m_config and the permutation table
+        NoiseKernels::Params m_params;          ///< The configured type
+        NoiseKernels::Params m_fractalParams;   ///< GetFractal
+        NoiseKernels::Params m_ridgedParams;    ///< GetRidged
+        NoiseKernels::Params m_billowParams;    ///< GetBillow
+        NoiseKernels::Params m_cellularParams;  ///< GetCellular
+        NoiseKernels::Params m_hybridParams;    ///< GetHybrid
 
         // Random number generation
         std::mt19937 m_randomEngine;
-        std::uniform_int_distribution<int> m_randomInt;
 
         // Caching system
         bool m_cachingEnabled;
@@ -351,9 +425,7 @@ namespace VoxelCraft {
         mutable std::shared_mutex m_metricsMutex;
 
         // Cache key generation
-        uint64_t MakeCacheKey2D(int x, int y) const;
         uint64_t MakeCacheKey2D(float x, float y) const;
-        uint64_t MakeCacheKey3D(int x, int y, int z) const;
         uint64_t MakeCacheKey3D(float x, float y, float z) const;
     };
 
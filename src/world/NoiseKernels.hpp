@@ -0,0 +1,124 @@
+/**
+ * @file NoiseKernels.hpp
+ * @brief VoxelCraft Noise Kernels - Per-ISA batch evaluation entry points
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * The kernels are written once (NoiseKernelsImpl.hpp) against a small lane
+ * abstraction and compiled three times: scalar, SSE4.1 and AVX2, each in its
+ * own translation unit with its own instruction set flags. NoiseGenerator
+ * picks one at runtime. Every lane performs the same IEEE operations in the
+ * same order as the scalar build, so all three produce identical bits.
+ */
+
+#ifndef VOXELCRAFT_WORLD_NOISE_KERNELS_HPP
+#define VOXELCRAFT_WORLD_NOISE_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    #define VOXELCRAFT_NOISE_X86 1
+#else
+    #define VOXELCRAFT_NOISE_X86 0
+#endif
+
+namespace VoxelCraft {
+namespace NoiseKernels {
+
+    /**
+     * @enum Basis
+     * @brief Single-octave noise function
+     */
+    enum class Basis : uint8_t {
+        Perlin,
+        Simplex,
+        Value,
+        Worley,
+        White
+    };
+
+    /**
+     * @enum Fractal
+     * @brief How octaves of the basis are combined
+     */
+    enum class Fractal : uint8_t {
+        None,
+        FBm,
+        Ridged,
+        Billow,
+        Hybrid
+    };
+
+    static constexpr int MAX_OCTAVES = 16;
+
+    /**
+     * @struct Params
+     * @brief Everything a kernel needs, resolved from NoiseConfig once
+     *
+     * Octave frequencies and amplitudes are precomputed so every ISA uses the
+     * exact same per-octave constants.
+     */
+    struct Params {
+        const int* permutation = nullptr;           ///< 512 entries, values 0-255
+        Basis basis = Basis::Perlin;
+        Fractal fractal = Fractal::None;
+        int octaves = 1;
+        int32_t seed = 0;                           ///< Only used by White
+        float amplitude = 1.0f;
+        float gain = 2.0f;                          ///< Ridged octave weighting
+        float bounding = 1.0f;                      ///< 1 / sum of octave amplitudes
+        float octaveFrequency[MAX_OCTAVES] = {};
+        float octaveAmplitude[MAX_OCTAVES] = {};
+    };
+
+    /**
+     * @struct Grid
+     * @brief Regular lattice of sample points starting at (x, y, z)
+     *
+     * Sample (i, j, k) is at (x + i * step, y + j * step, z + k * step).
+     * 2D grids are stored row by row: out[j * width + i]. 3D grids are XZ
+     * slices stacked along Y: out[(j * depth + k) * width + i].
+     */
+    struct Grid {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+        float step = 1.0f;
+        int width = 0;
+        int height = 0;
+        int depth = 1;
+    };
+
+    namespace Scalar {
+        float Evaluate2D(const Params& params, float x, float y);
+        float Evaluate3D(const Params& params, float x, float y, float z);
+        void FillGrid2D(const Params& params, const Grid& grid, float* out);
+        void FillGrid3D(const Params& params, const Grid& grid, float* out);
+        void FillPoints2D(const Params& params, const float* xs, const float* ys, size_t count, float* out);
+        void FillPoints3D(const Params& params, const float* xs, const float* ys, const float* zs,
+                          size_t count, float* out);
+    } // namespace Scalar
+
+#if VOXELCRAFT_NOISE_X86
+    namespace Sse41 {
+        void FillGrid2D(const Params& params, const Grid& grid, float* out);
+        void FillGrid3D(const Params& params, const Grid& grid, float* out);
+        void FillPoints2D(const Params& params, const float* xs, const float* ys, size_t count, float* out);
+        void FillPoints3D(const Params& params, const float* xs, const float* ys, const float* zs,
+                          size_t count, float* out);
+    } // namespace Sse41
+
+    namespace Avx2 {
+        void FillGrid2D(const Params& params, const Grid& grid, float* out);
+        void FillGrid3D(const Params& params, const Grid& grid, float* out);
+        void FillPoints2D(const Params& params, const float* xs, const float* ys, size_t count, float* out);
+        void FillPoints3D(const Params& params, const float* xs, const float* ys, const float* zs,
+                          size_t count, float* out);
+    } // namespace Avx2
+#endif
+
+} // namespace NoiseKernels
+} // namespace VoxelCraft
+
+#endif // VOXELCRAFT_WORLD_NOISE_KERNELS_HPP
@@ -0,0 +1,102 @@
+/**
+ * @file NoiseKernelsAvx2.cpp
+ * @brief VoxelCraft Noise Kernels - 8-lane AVX2 build
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * Compiled with AVX2 enabled (see CMakeLists.txt); only called after
+ * NoiseGenerator has checked the CPU supports it. Permutation lookups use
+ * the AVX2 integer gather.
+ */
+
+#include "NoiseKernelsImpl.hpp"
+
+#if VOXELCRAFT_NOISE_X86
+
+#include <immintrin.h>
+
+namespace VoxelCraft {
+namespace NoiseKernels {
+
+namespace {
+
+struct Float8 { __m256 v; };
+struct Int8 { __m256i v; };
+struct Mask8 { __m256 v; };
+
+inline Float8 operator+(Float8 a, Float8 b) { return {_mm256_add_ps(a.v, b.v)}; }
+inline Float8 operator-(Float8 a, Float8 b) { return {_mm256_sub_ps(a.v, b.v)}; }
+inline Float8 operator*(Float8 a, Float8 b) { return {_mm256_mul_ps(a.v, b.v)}; }
+inline Int8 operator+(Int8 a, Int8 b) { return {_mm256_add_epi32(a.v, b.v)}; }
+inline Int8 operator-(Int8 a, Int8 b) { return {_mm256_sub_epi32(a.v, b.v)}; }
+inline Int8 operator&(Int8 a, Int8 b) { return {_mm256_and_si256(a.v, b.v)}; }
+inline Int8 operator^(Int8 a, Int8 b) { return {_mm256_xor_si256(a.v, b.v)}; }
+
+struct Avx2Ops {
+    using F = Float8;
+    using I = Int8;
+    using M = Mask8;
+    static constexpr int LANES = 8;
+
+    static F Set(float v) { return {_mm256_set1_ps(v)}; }
+    static I SetI(int32_t v) { return {_mm256_set1_epi32(v)}; }
+    static I Iota(int base) {
+        return {_mm256_add_epi32(_mm256_set1_epi32(base), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7))};
+    }
+    static F Load(const float* p) { return {_mm256_loadu_ps(p)}; }
+    static void Store(float* p, F v) { _mm256_storeu_ps(p, v.v); }
+
+    static F Floor(F v) { return {_mm256_floor_ps(v.v)}; }
+    static I ToInt(F v) { return {_mm256_cvttps_epi32(v.v)}; }
+    static F ToFloat(I v) { return {_mm256_cvtepi32_ps(v.v)}; }
+    static F Abs(F v) { return {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), v.v)}; }
+    static F Negate(F v) { return {_mm256_xor_ps(_mm256_set1_ps(-0.0f), v.v)}; }
+    static F Min(F a, F b) { return {_mm256_min_ps(a.v, b.v)}; }
+    static F Max(F a, F b) { return {_mm256_max_ps(a.v, b.v)}; }
+    static F Sqrt(F v) { return {_mm256_sqrt_ps(v.v)}; }
+
+    static M Less(F a, F b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)}; }
+    static M LessEqual(F a, F b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ)}; }
+    static M EqualI(I a, I b) { return {_mm256_castsi256_ps(_mm256_cmpeq_epi32(a.v, b.v))}; }
+    static M LessI(I a, I b) { return {_mm256_castsi256_ps(_mm256_cmpgt_epi32(b.v, a.v))}; }
+    static M And(M a, M b) { return {_mm256_and_ps(a.v, b.v)}; }
+    static M Or(M a, M b) { return {_mm256_or_ps(a.v, b.v)}; }
+    static M Not(M a) { return {_mm256_xor_ps(a.v, _mm256_castsi256_ps(_mm256_set1_epi32(-1)))}; }
+    static M AndNot(M a, M b) { return {_mm256_andnot_ps(a.v, b.v)}; }
+    static F Select(M m, F a, F b) { return {_mm256_blendv_ps(b.v, a.v, m.v)}; }
+    static I SelectI(M m, I a, I b) {
+        return {_mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(b.v), _mm256_castsi256_ps(a.v), m.v))};
+    }
+
+    static I MulI(I a, I b) { return {_mm256_mullo_epi32(a.v, b.v)}; }
+    static I ShiftRight(I v, int bits) { return {_mm256_srl_epi32(v.v, _mm_cvtsi32_si128(bits))}; }
+    static I Gather(const int* table, I index) { return {_mm256_i32gather_epi32(table, index.v, 4)}; }
+};
+
+} // namespace
+
+namespace Avx2 {
+
+void FillGrid2D(const Params& params, const Grid& grid, float* out) {
+    FillGrid2DImpl<Avx2Ops>(params, grid, out);
+}
+
+void FillGrid3D(const Params& params, const Grid& grid, float* out) {
+    FillGrid3DImpl<Avx2Ops>(params, grid, out);
+}
+
+void FillPoints2D(const Params& params, const float* xs, const float* ys, size_t count, float* out) {
+    FillPointsImpl<Avx2Ops>(params, xs, ys, nullptr, count, out);
+}
+
+void FillPoints3D(const Params& params, const float* xs, const float* ys, const float* zs,
+                  size_t count, float* out) {
+    FillPointsImpl<Avx2Ops>(params, xs, ys, zs, count, out);
+}
+
+} // namespace Avx2
+
+} // namespace NoiseKernels
+} // namespace VoxelCraft
+
+#endif // VOXELCRAFT_NOISE_X86
@@ -0,0 +1,507 @@
+/**
+ * @file NoiseKernelsImpl.hpp
+ * @brief VoxelCraft Noise Kernels - ISA-independent kernel templates
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * Included only by the NoiseKernels*.cpp translation units. Kernels are
+ * templates over an Ops type describing one SIMD register:
+ *
+ * - F / I / M: float lanes, int32 lanes, lane mask
+ * - F supports + - *, I supports + - & ^
+ * - Set, SetI, Iota(base), Load, Store
+ * - Floor, ToInt (truncating), ToFloat, Abs, Negate, Min, Max, Sqrt
+ * - Less, LessEqual, EqualI, LessI, And, Or, Not, AndNot(a, b) = !a && b
+ * - Select(m, a, b) / SelectI(m, a, b) = m ? a : b
+ * - MulI (wrapping), ShiftRight (logical), Gather(table, index)
+ *
+ * Min(a, b) and Max(a, b) must return b when a == b (x86 minps/maxps
+ * semantics) so the scalar build matches the vector ones bit for bit.
+ * Nothing here may call shared inline helpers: every instantiation must
+ * stay inside the Ops of its own translation unit.
+ */
+
+#ifndef VOXELCRAFT_WORLD_NOISE_KERNELS_IMPL_HPP
+#define VOXELCRAFT_WORLD_NOISE_KERNELS_IMPL_HPP
+
+#include "NoiseKernels.hpp"
+
+namespace VoxelCraft {
+namespace NoiseKernels {
+
+    template<class Ops>
+    struct Kernels {
+        using F = typename Ops::F;
+        using I = typename Ops::I;
+        using M = typename Ops::M;
+
+        // Gustavson's skew factors
+        static constexpr float F2 = 0.36602540378f;     ///< (sqrt(3) - 1) / 2
+        static constexpr float G2 = 0.21132486540f;     ///< (3 - sqrt(3)) / 6
+        static constexpr float F3 = 1.0f / 3.0f;
+        static constexpr float G3 = 1.0f / 6.0f;
+
+        static F C(float v) { return Ops::Set(v); }
+        static I CI(int32_t v) { return Ops::SetI(v); }
+
+        static I Perm(const Params& p, I index) { return Ops::Gather(p.permutation, index); }
+        static I Wrap(I v) { return v & CI(255); }
+        static M Bit(I h, int32_t bit) { return Ops::EqualI(h & CI(bit), CI(bit)); }
+
+        static F Fade(F t) { return t * t * t * (t * (t * C(6.0f) - C(15.0f)) + C(10.0f)); }
+        static F Lerp(F t, F a, F b) { return a + t * (b - a); }
+
+        /// Eight directions: the four diagonals for h < 4, then +x, -x, +y, -y
+        static F Grad2(I hash, F x, F y) {
+            const I h = hash & CI(7);
+            const F diagonal = Ops::Select(Bit(h, 0), Ops::Negate(x), x) + Ops::Select(Bit(h, 1), Ops::Negate(y), y);
+            const F axis = Ops::Select(Bit(h, 1), Ops::Select(Bit(h, 0), Ops::Negate(y), y),
+                                       Ops::Select(Bit(h, 0), Ops::Negate(x), x));
+            return Ops::Select(Ops::LessI(h, CI(4)), diagonal, axis);
+        }
+
+        /// Improved Perlin gradients: the twelve cube edge midpoints
+        static F Grad3(I hash, F x, F y, F z) {
+            const I h = hash & CI(15);
+            const F u = Ops::Select(Ops::LessI(h, CI(8)), x, y);
+            const M xOrZ = Ops::Or(Ops::EqualI(h, CI(12)), Ops::EqualI(h, CI(14)));
+            const F v = Ops::Select(Ops::LessI(h, CI(4)), y, Ops::Select(xOrZ, x, z));
+            return Ops::Select(Bit(h, 1), Ops::Negate(u), u) + Ops::Select(Bit(h, 2), Ops::Negate(v), v);
+        }
+
+        // Basis functions, all roughly in [-1, 1]
+
+        static F Perlin2(const Params& p, F x, F y) {
+            const F fx = Ops::Floor(x);
+            const F fy = Ops::Floor(y);
+            const I X = Wrap(Ops::ToInt(fx));
+            const I Y = Wrap(Ops::ToInt(fy));
+            const F xf = x - fx;
+            const F yf = y - fy;
+            const F u = Fade(xf);
+            const F v = Fade(yf);
+
+            const I A = Perm(p, X) + Y;
+            const I B = Perm(p, X + CI(1)) + Y;
+            const F xm = xf - C(1.0f);
+            const F ym = yf - C(1.0f);
+
+            const F bottom = Lerp(u, Grad2(Perm(p, A), xf, yf), Grad2(Perm(p, B), xm, yf));
+            const F top = Lerp(u, Grad2(Perm(p, A + CI(1)), xf, ym), Grad2(Perm(p, B + CI(1)), xm, ym));
+            return Lerp(v, bottom, top);
+        }
+
+        static F Perlin3(const Params& p, F x, F y, F z) {
+            const F fx = Ops::Floor(x);
+            const F fy = Ops::Floor(y);
+            const F fz = Ops::Floor(z);
+            const I X = Wrap(Ops::ToInt(fx));
+            const I Y = Wrap(Ops::ToInt(fy));
+            const I Z = Wrap(Ops::ToInt(fz));
+            const F xf = x - fx;
+            const F yf = y - fy;
+            const F zf = z - fz;
+            const F u = Fade(xf);
+            const F v = Fade(yf);
+            const F w = Fade(zf);
+
+            const I A = Perm(p, X) + Y;
+            const I AA = Perm(p, A) + Z;
+            const I AB = Perm(p, A + CI(1)) + Z;
+            const I B = Perm(p, X + CI(1)) + Y;
+            const I BA = Perm(p, B) + Z;
+            const I BB = Perm(p, B + CI(1)) + Z;
+            const F xm = xf - C(1.0f);
+            const F ym = yf - C(1.0f);
+            const F zm = zf - C(1.0f);
+
+            const F near = Lerp(v, Lerp(u, Grad3(Perm(p, AA), xf, yf, zf), Grad3(Perm(p, BA), xm, yf, zf)),
+                                   Lerp(u, Grad3(Perm(p, AB), xf, ym, zf), Grad3(Perm(p, BB), xm, ym, zf)));
+            const F far = Lerp(v, Lerp(u, Grad3(Perm(p, AA + CI(1)), xf, yf, zm), Grad3(Perm(p, BA + CI(1)), xm, yf, zm)),
+                                  Lerp(u, Grad3(Perm(p, AB + CI(1)), xf, ym, zm), Grad3(Perm(p, BB + CI(1)), xm, ym, zm)));
+            return Lerp(w, near, far);
+        }
+
+        static F LatticeValue(I hash) { return Ops::ToFloat(hash) * C(1.0f / 127.5f) - C(1.0f); }
+
+        static F Value2(const Params& p, F x, F y) {
+            const F fx = Ops::Floor(x);
+            const F fy = Ops::Floor(y);
+            const I X = Wrap(Ops::ToInt(fx));
+            const I Y = Wrap(Ops::ToInt(fy));
+            const F u = Fade(x - fx);
+            const F v = Fade(y - fy);
+
+            const I A = Perm(p, X) + Y;
+            const I B = Perm(p, X + CI(1)) + Y;
+            const F bottom = Lerp(u, LatticeValue(Perm(p, A)), LatticeValue(Perm(p, B)));
+            const F top = Lerp(u, LatticeValue(Perm(p, A + CI(1))), LatticeValue(Perm(p, B + CI(1))));
+            return Lerp(v, bottom, top);
+        }
+
+        static F Value3(const Params& p, F x, F y, F z) {
+            const F fx = Ops::Floor(x);
+            const F fy = Ops::Floor(y);
+            const F fz = Ops::Floor(z);
+            const I X = Wrap(Ops::ToInt(fx));
+            const I Y = Wrap(Ops::ToInt(fy));
+            const I Z = Wrap(Ops::ToInt(fz));
+            const F u = Fade(x - fx);
+            const F v = Fade(y - fy);
+            const F w = Fade(z - fz);
+
+            const I A = Perm(p, X) + Y;
+            const I AA = Perm(p, A) + Z;
+            const I AB = Perm(p, A + CI(1)) + Z;
+            const I B = Perm(p, X + CI(1)) + Y;
+            const I BA = Perm(p, B) + Z;
+            const I BB = Perm(p, B + CI(1)) + Z;
+
+            const F near = Lerp(v, Lerp(u, LatticeValue(Perm(p, AA)), LatticeValue(Perm(p, BA))),
+                                   Lerp(u, LatticeValue(Perm(p, AB)), LatticeValue(Perm(p, BB))));
+            const F far = Lerp(v, Lerp(u, LatticeValue(Perm(p, AA + CI(1))), LatticeValue(Perm(p, BA + CI(1)))),
+                                  Lerp(u, LatticeValue(Perm(p, AB + CI(1))), LatticeValue(Perm(p, BB + CI(1)))));
+            return Lerp(w, near, far);
+        }
+
+        static F SimplexCorner2(F x, F y, I hash) {
+            const F t = C(0.5f) - x * x - y * y;
+            const F t2 = t * t;
+            return Ops::Select(Ops::Less(t, C(0.0f)), C(0.0f), t2 * t2 * Grad2(hash, x, y));
+        }
+
+        static F Simplex2(const Params& p, F x, F y) {
+            const F s = (x + y) * C(F2);
+            const F fi = Ops::Floor(x + s);
+            const F fj = Ops::Floor(y + s);
+            const F t = (fi + fj) * C(G2);
+            const F x0 = x - (fi - t);
+            const F y0 = y - (fj - t);
+
+            // Lower or upper triangle of the skewed cell
+            const M lower = Ops::Less(y0, x0);
+            const F i1 = Ops::Select(lower, C(1.0f), C(0.0f));
+            const F j1 = Ops::Select(lower, C(0.0f), C(1.0f));
+            const F x1 = x0 - i1 + C(G2);
+            const F y1 = y0 - j1 + C(G2);
+            const F x2 = x0 - C(1.0f) + C(2.0f * G2);
+            const F y2 = y0 - C(1.0f) + C(2.0f * G2);
+
+            const I ii = Wrap(Ops::ToInt(fi));
+            const I jj = Wrap(Ops::ToInt(fj));
+            const I i1i = Ops::SelectI(lower, CI(1), CI(0));
+            const I j1i = Ops::SelectI(lower, CI(0), CI(1));
+            const I g0 = Perm(p, ii + Perm(p, jj));
+            const I g1 = Perm(p, ii + i1i + Perm(p, jj + j1i));
+            const I g2 = Perm(p, ii + CI(1) + Perm(p, jj + CI(1)));
+
+            return C(70.0f) * (SimplexCorner2(x0, y0, g0) + SimplexCorner2(x1, y1, g1) + SimplexCorner2(x2, y2, g2));
+        }
+
+        static F SimplexCorner3(F x, F y, F z, I hash) {
+            const F t = C(0.6f) - x * x - y * y - z * z;
+            const F t2 = t * t;
+            return Ops::Select(Ops::Less(t, C(0.0f)), C(0.0f), t2 * t2 * Grad3(hash, x, y, z));
+        }
+
+        static F Simplex3(const Params& p, F x, F y, F z) {
+            const F s = (x + y + z) * C(F3);
+            const F fi = Ops::Floor(x + s);
+            const F fj = Ops::Floor(y + s);
+            const F fk = Ops::Floor(z + s);
+            const F t = (fi + fj + fk) * C(G3);
+            const F x0 = x - (fi - t);
+            const F y0 = y - (fj - t);
+            const F z0 = z - (fk - t);
+
+            // Which of the six tetrahedra, as masks instead of the usual branch tree
+            const M xy = Ops::LessEqual(y0, x0);
+            const M yz = Ops::LessEqual(z0, y0);
+            const M xz = Ops::LessEqual(z0, x0);
+            const M i1 = Ops::And(xy, xz);
+            const M j1 = Ops::AndNot(xy, yz);
+            const M k1 = Ops::Not(Ops::Or(i1, j1));
+            const M i2 = Ops::Or(xy, xz);
+            const M j2 = Ops::Or(Ops::Not(xy), yz);
+            const M k2 = Ops::Not(Ops::And(xz, yz));
+
+            const F x1 = x0 - Ops::Select(i1, C(1.0f), C(0.0f)) + C(G3);
+            const F y1 = y0 - Ops::Select(j1, C(1.0f), C(0.0f)) + C(G3);
+            const F z1 = z0 - Ops::Select(k1, C(1.0f), C(0.0f)) + C(G3);
+            const F x2 = x0 - Ops::Select(i2, C(1.0f), C(0.0f)) + C(2.0f * G3);
+            const F y2 = y0 - Ops::Select(j2, C(1.0f), C(0.0f)) + C(2.0f * G3);
+            const F z2 = z0 - Ops::Select(k2, C(1.0f), C(0.0f)) + C(2.0f * G3);
+            const F x3 = x0 - C(1.0f) + C(3.0f * G3);
+            const F y3 = y0 - C(1.0f) + C(3.0f * G3);
+            const F z3 = z0 - C(1.0f) + C(3.0f * G3);
+
+            const I ii = Wrap(Ops::ToInt(fi));
+            const I jj = Wrap(Ops::ToInt(fj));
+            const I kk = Wrap(Ops::ToInt(fk));
+            const I one = CI(1);
+            const I zero = CI(0);
+            const I g0 = Perm(p, ii + Perm(p, jj + Perm(p, kk)));
+            const I g1 = Perm(p, ii + Ops::SelectI(i1, one, zero) +
+                                 Perm(p, jj + Ops::SelectI(j1, one, zero) + Perm(p, kk + Ops::SelectI(k1, one, zero))));
+            const I g2 = Perm(p, ii + Ops::SelectI(i2, one, zero) +
+                                 Perm(p, jj + Ops::SelectI(j2, one, zero) + Perm(p, kk + Ops::SelectI(k2, one, zero))));
+            const I g3 = Perm(p, ii + one + Perm(p, jj + one + Perm(p, kk + one)));
+
+            return C(32.0f) * (SimplexCorner3(x0, y0, z0, g0) + SimplexCorner3(x1, y1, z1, g1) +
+                               SimplexCorner3(x2, y2, z2, g2) + SimplexCorner3(x3, y3, z3, g3));
+        }
+
+        /// Integer hash of a lattice cell; arithmetic only, so it vectorizes without gathers
+        static I HashCell(I hx, I hy, I hz, int32_t seed) {
+            I h = hx ^ hy ^ hz ^ CI(seed);
+            h = h ^ Ops::ShiftRight(h, 15);
+            h = Ops::MulI(h, CI(0x2c1b3c6d));
+            h = h ^ Ops::ShiftRight(h, 12);
+            h = Ops::MulI(h, CI(0x297a2d39));
+            return h ^ Ops::ShiftRight(h, 15);
+        }
+
+        /// 10-bit field of a cell hash as a feature point offset in [0, 1]
+        static F Jitter(I h, int shift) { return Ops::ToFloat(Ops::ShiftRight(h, shift) & CI(0x3FF)) * C(1.0f / 1023.0f); }
+
+        /// F1 distance to one jittered feature point per cell, mapped from [0, 1] to [-1, 1]
+        static F Worley2(const Params& p, F x, F y) {
+            const F fx = Ops::Floor(x);
+            const F fy = Ops::Floor(y);
+            const I X = Ops::ToInt(fx);
+            const I Y = Ops::ToInt(fy);
+            const F px = x - fx;
+            const F py = y - fy;
+
+            F best = C(8.0f);
+            for (int32_t dy = -1; dy <= 1; ++dy) {
+                const I hy = Ops::MulI(Y + CI(dy), CI(0x165667b1));
+                for (int32_t dx = -1; dx <= 1; ++dx) {
+                    const I h = HashCell(Ops::MulI(X + CI(dx), CI(0x27d4eb2d)), hy, CI(0), p.seed);
+                    const F ox = (C(static_cast<float>(dx)) + Jitter(h, 0)) - px;
+                    const F oy = (C(static_cast<float>(dy)) + Jitter(h, 10)) - py;
+                    best = Ops::Min(best, ox * ox + oy * oy);
+                }
+            }
+            return Ops::Min(Ops::Sqrt(best), C(1.0f)) * C(2.0f) - C(1.0f);
+        }
+
+        static F Worley3(const Params& p, F x, F y, F z) {
+            const F fx = Ops::Floor(x);
+            const F fy = Ops::Floor(y);
+            const F fz = Ops::Floor(z);
+            const I X = Ops::ToInt(fx);
+            const I Y = Ops::ToInt(fy);
+            const I Z = Ops::ToInt(fz);
+            const F px = x - fx;
+            const F py = y - fy;
+            const F pz = z - fz;
+
+            F best = C(12.0f);
+            for (int32_t dz = -1; dz <= 1; ++dz) {
+                const I hz = Ops::MulI(Z + CI(dz), CI(0x0b5297a5));
+                for (int32_t dy = -1; dy <= 1; ++dy) {
+                    const I hy = Ops::MulI(Y + CI(dy), CI(0x165667b1));
+                    for (int32_t dx = -1; dx <= 1; ++dx) {
+                        const I h = HashCell(Ops::MulI(X + CI(dx), CI(0x27d4eb2d)), hy, hz, p.seed);
+                        const F ox = (C(static_cast<float>(dx)) + Jitter(h, 0)) - px;
+                        const F oy = (C(static_cast<float>(dy)) + Jitter(h, 10)) - py;
+                        const F oz = (C(static_cast<float>(dz)) + Jitter(h, 20)) - pz;
+                        best = Ops::Min(best, ox * ox + oy * oy + oz * oz);
+                    }
+                }
+            }
+            return Ops::Min(Ops::Sqrt(best), C(1.0f)) * C(2.0f) - C(1.0f);
+        }
+
+        static F HashToSigned(I h) { return Ops::ToFloat(h & CI(0xFFFF)) * C(1.0f / 32767.5f) - C(1.0f); }
+
+        static F White2(const Params& p, F x, F y) {
+            const I X = Ops::ToInt(Ops::Floor(x));
+            const I Y = Ops::ToInt(Ops::Floor(y));
+            return HashToSigned(HashCell(Ops::MulI(X, CI(0x27d4eb2d)), Ops::MulI(Y, CI(0x165667b1)), CI(0), p.seed));
+        }
+
+        static F White3(const Params& p, F x, F y, F z) {
+            const I X = Ops::ToInt(Ops::Floor(x));
+            const I Y = Ops::ToInt(Ops::Floor(y));
+            const I Z = Ops::ToInt(Ops::Floor(z));
+            return HashToSigned(HashCell(Ops::MulI(X, CI(0x27d4eb2d)), Ops::MulI(Y, CI(0x165667b1)),
+                                         Ops::MulI(Z, CI(0x0b5297a5)), p.seed));
+        }
+
+        static F Basis2(const Params& p, F x, F y) {
+            switch (p.basis) {
+                case Basis::Simplex: return Simplex2(p, x, y);
+                case Basis::Value:   return Value2(p, x, y);
+                case Basis::Worley:  return Worley2(p, x, y);
+                case Basis::White:   return White2(p, x, y);
+                default:             return Perlin2(p, x, y);
+            }
+        }
+
+        static F Basis3(const Params& p, F x, F y, F z) {
+            switch (p.basis) {
+                case Basis::Simplex: return Simplex3(p, x, y, z);
+                case Basis::Value:   return Value3(p, x, y, z);
+                case Basis::Worley:  return Worley3(p, x, y, z);
+                case Basis::White:   return White3(p, x, y, z);
+                default:             return Perlin3(p, x, y, z);
+            }
+        }
+
+        /**
+         * @brief Combine the octaves; Sample(frequency) returns one octave of the basis
+         *
+         * None and FBm return [-1, 1], Ridged [0, 1], Billow [-1, 1] and
+         * Hybrid averages FBm with the ridged signal remapped to [-1, 1].
+         */
+        template<typename Sample>
+        static F Combine(const Params& p, Sample&& sample) {
+            if (p.fractal == Fractal::None) {
+                return sample(0) * C(p.amplitude);
+            }
+
+            F sum = C(0.0f);
+            F ridged = C(0.0f);
+            F weight = C(1.0f);
+            for (int octave = 0; octave < p.octaves; ++octave) {
+                const F n = sample(octave);
+                const F amplitude = C(p.octaveAmplitude[octave]);
+                switch (p.fractal) {
+                    case Fractal::Billow:
+                        sum = sum + (Ops::Abs(n) * C(2.0f) - C(1.0f)) * amplitude;
+                        break;
+                    case Fractal::Ridged:
+                    case Fractal::Hybrid: {
+                        // Each octave is weighted by the previous one, sharpening the ridges
+                        F signal = C(1.0f) - Ops::Abs(n);
+                        signal = signal * signal * weight;
+                        weight = Ops::Min(Ops::Max(signal * C(p.gain), C(0.0f)), C(1.0f));
+                        ridged = ridged + signal * amplitude;
+                        if (p.fractal == Fractal::Hybrid) {
+                            sum = sum + n * amplitude;
+                        }
+                        break;
+                    }
+                    default:
+                        sum = sum + n * amplitude;
+                        break;
+                }
+            }
+
+            const F bounding = C(p.bounding);
+            F value;
+            switch (p.fractal) {
+                case Fractal::Ridged:
+                    value = ridged * bounding;
+                    break;
+                case Fractal::Hybrid:
+                    value = C(0.5f) * (sum * bounding + (ridged * bounding * C(2.0f) - C(1.0f)));
+                    break;
+                default:
+                    value = sum * bounding;
+                    break;
+            }
+            return value * C(p.amplitude);
+        }
+
+        static F Evaluate2(const Params& p, F x, F y) {
+            return Combine(p, [&](int octave) {
+                const F frequency = C(p.octaveFrequency[octave]);
+                return Basis2(p, x * frequency, y * frequency);
+            });
+        }
+
+        static F Evaluate3(const Params& p, F x, F y, F z) {
+            return Combine(p, [&](int octave) {
+                const F frequency = C(p.octaveFrequency[octave]);
+                return Basis3(p, x * frequency, y * frequency, z * frequency);
+            });
+        }
+    };
+
+    // Batch drivers. Coordinates are formed as origin + float(index) * step in
+    // every build, the same expression a scalar caller would write.
+
+    template<class Ops>
+    void FillRow(const Params& p, const Grid& g, float y, float z, bool is3D, float* out) {
+        using K = Kernels<Ops>;
+        using F = typename Ops::F;
+        constexpr int LANES = Ops::LANES;
+
+        const F originX = Ops::Set(g.x);
+        const F step = Ops::Set(g.step);
+        const F vy = Ops::Set(y);
+        const F vz = Ops::Set(z);
+
+        int i = 0;
+        for (; i + LANES <= g.width; i += LANES) {
+            const F x = originX + Ops::ToFloat(Ops::Iota(i)) * step;
+            Ops::Store(out + i, is3D ? K::Evaluate3(p, x, vy, vz) : K::Evaluate2(p, x, vy));
+        }
+        if (i < g.width) {
+            float tail[static_cast<size_t>(LANES)];
+            const F x = originX + Ops::ToFloat(Ops::Iota(i)) * step;
+            Ops::Store(tail, is3D ? K::Evaluate3(p, x, vy, vz) : K::Evaluate2(p, x, vy));
+            for (int lane = 0; i + lane < g.width; ++lane) {
+                out[i + lane] = tail[lane];
+            }
+        }
+    }
+
+    template<class Ops>
+    void FillGrid2DImpl(const Params& p, const Grid& g, float* out) {
+        for (int j = 0; j < g.height; ++j) {
+            FillRow<Ops>(p, g, g.y + static_cast<float>(j) * g.step, 0.0f, false,
+                         out + static_cast<size_t>(j) * static_cast<size_t>(g.width));
+        }
+    }
+
+    template<class Ops>
+    void FillGrid3DImpl(const Params& p, const Grid& g, float* out) {
+        for (int j = 0; j < g.height; ++j) {
+            const float y = g.y + static_cast<float>(j) * g.step;
+            for (int k = 0; k < g.depth; ++k) {
+                const size_t row = static_cast<size_t>(j) * static_cast<size_t>(g.depth) + static_cast<size_t>(k);
+                FillRow<Ops>(p, g, y, g.z + static_cast<float>(k) * g.step, true,
+                             out + row * static_cast<size_t>(g.width));
+            }
+        }
+    }
+
+    template<class Ops>
+    void FillPointsImpl(const Params& p, const float* xs, const float* ys, const float* zs, size_t count, float* out) {
+        using K = Kernels<Ops>;
+        using F = typename Ops::F;
+        constexpr size_t LANES = static_cast<size_t>(Ops::LANES);
+
+        size_t i = 0;
+        for (; i + LANES <= count; i += LANES) {
+            const F x = Ops::Load(xs + i);
+            const F y = Ops::Load(ys + i);
+            Ops::Store(out + i, zs ? K::Evaluate3(p, x, y, Ops::Load(zs + i)) : K::Evaluate2(p, x, y));
+        }
+        if (i < count) {
+            float tx[LANES] = {};
+            float ty[LANES] = {};
+            float tz[LANES] = {};
+            float result[LANES];
+            for (size_t lane = 0; i + lane < count; ++lane) {
+                tx[lane] = xs[i + lane];
+                ty[lane] = ys[i + lane];
+                tz[lane] = zs ? zs[i + lane] : 0.0f;
+            }
+            const F x = Ops::Load(tx);
+            const F y = Ops::Load(ty);
+            Ops::Store(result, zs ? K::Evaluate3(p, x, y, Ops::Load(tz)) : K::Evaluate2(p, x, y));
+            for (size_t lane = 0; i + lane < count; ++lane) {
+                out[i + lane] = result[lane];
+            }
+        }
+    }
+
+} // namespace NoiseKernels
+} // namespace VoxelCraft
+
+#endif // VOXELCRAFT_WORLD_NOISE_KERNELS_IMPL_HPP
@@ -0,0 +1,89 @@
+/**
+ * @file NoiseKernelsScalar.cpp
+ * @brief VoxelCraft Noise Kernels - Portable one-lane build
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * Reference for the SIMD builds and the path behind NoiseGenerator::GetNoise.
+ */
+
+#include "NoiseKernelsImpl.hpp"
+#include <cmath>
+
+namespace VoxelCraft {
+namespace NoiseKernels {
+
+namespace {
+
+struct ScalarOps {
+    using F = float;
+    using I = int32_t;
+    using M = bool;
+    static constexpr int LANES = 1;
+
+    static F Set(float v) { return v; }
+    static I SetI(int32_t v) { return v; }
+    static I Iota(int base) { return base; }
+    static F Load(const float* p) { return *p; }
+    static void Store(float* p, F v) { *p = v; }
+
+    static F Floor(F v) { return std::floor(v); }
+    static I ToInt(F v) { return static_cast<int32_t>(v); }
+    static F ToFloat(I v) { return static_cast<float>(v); }
+    static F Abs(F v) { return std::fabs(v); }
+    static F Negate(F v) { return -v; }
+    static F Min(F a, F b) { return a < b ? a : b; }
+    static F Max(F a, F b) { return a > b ? a : b; }
+    static F Sqrt(F v) { return std::sqrt(v); }
+
+    static M Less(F a, F b) { return a < b; }
+    static M LessEqual(F a, F b) { return a <= b; }
+    static M EqualI(I a, I b) { return a == b; }
+    static M LessI(I a, I b) { return a < b; }
+    static M And(M a, M b) { return a && b; }
+    static M Or(M a, M b) { return a || b; }
+    static M Not(M a) { return !a; }
+    static M AndNot(M a, M b) { return !a && b; }
+    static F Select(M m, F a, F b) { return m ? a : b; }
+    static I SelectI(M m, I a, I b) { return m ? a : b; }
+
+    static I MulI(I a, I b) {
+        return static_cast<int32_t>(static_cast<uint32_t>(a) * static_cast<uint32_t>(b));
+    }
+    static I ShiftRight(I v, int bits) { return static_cast<int32_t>(static_cast<uint32_t>(v) >> bits); }
+    static I Gather(const int* table, I index) { return table[index]; }
+};
+
+} // namespace
+
+namespace Scalar {
+
+float Evaluate2D(const Params& params, float x, float y) {
+    return Kernels<ScalarOps>::Evaluate2(params, x, y);
+}
+
+float Evaluate3D(const Params& params, float x, float y, float z) {
+    return Kernels<ScalarOps>::Evaluate3(params, x, y, z);
+}
+
+void FillGrid2D(const Params& params, const Grid& grid, float* out) {
+    FillGrid2DImpl<ScalarOps>(params, grid, out);
+}
+
+void FillGrid3D(const Params& params, const Grid& grid, float* out) {
+    FillGrid3DImpl<ScalarOps>(params, grid, out);
+}
+
+void FillPoints2D(const Params& params, const float* xs, const float* ys, size_t count, float* out) {
+    FillPointsImpl<ScalarOps>(params, xs, ys, nullptr, count, out);
+}
+
+void FillPoints3D(const Params& params, const float* xs, const float* ys, const float* zs,
+                  size_t count, float* out) {
+    FillPointsImpl<ScalarOps>(params, xs, ys, zs, count, out);
+}
+
+} // namespace Scalar
+
+} // namespace NoiseKernels
+} // namespace VoxelCraft
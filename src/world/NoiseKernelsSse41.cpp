@@ -0,0 +1,103 @@
+/**
+ * @file NoiseKernelsSse41.cpp
+ * @brief VoxelCraft Noise Kernels - 4-lane SSE4.1 build
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * Compiled with SSE4.1 enabled (see CMakeLists.txt); only called after
+ * NoiseGenerator has checked the CPU supports it. SSE4.1 has no gather,
+ * so permutation lookups are four scalar loads.
+ */
+
+#include "NoiseKernelsImpl.hpp"
+
+#if VOXELCRAFT_NOISE_X86
+
+#include <smmintrin.h>
+
+namespace VoxelCraft {
+namespace NoiseKernels {
+
+namespace {
+
+struct Float4 { __m128 v; };
+struct Int4 { __m128i v; };
+struct Mask4 { __m128 v; };
+
+inline Float4 operator+(Float4 a, Float4 b) { return {_mm_add_ps(a.v, b.v)}; }
+inline Float4 operator-(Float4 a, Float4 b) { return {_mm_sub_ps(a.v, b.v)}; }
+inline Float4 operator*(Float4 a, Float4 b) { return {_mm_mul_ps(a.v, b.v)}; }
+inline Int4 operator+(Int4 a, Int4 b) { return {_mm_add_epi32(a.v, b.v)}; }
+inline Int4 operator-(Int4 a, Int4 b) { return {_mm_sub_epi32(a.v, b.v)}; }
+inline Int4 operator&(Int4 a, Int4 b) { return {_mm_and_si128(a.v, b.v)}; }
+inline Int4 operator^(Int4 a, Int4 b) { return {_mm_xor_si128(a.v, b.v)}; }
+
+struct Sse41Ops {
+    using F = Float4;
+    using I = Int4;
+    using M = Mask4;
+    static constexpr int LANES = 4;
+
+    static F Set(float v) { return {_mm_set1_ps(v)}; }
+    static I SetI(int32_t v) { return {_mm_set1_epi32(v)}; }
+    static I Iota(int base) { return {_mm_add_epi32(_mm_set1_epi32(base), _mm_setr_epi32(0, 1, 2, 3))}; }
+    static F Load(const float* p) { return {_mm_loadu_ps(p)}; }
+    static void Store(float* p, F v) { _mm_storeu_ps(p, v.v); }
+
+    static F Floor(F v) { return {_mm_floor_ps(v.v)}; }
+    static I ToInt(F v) { return {_mm_cvttps_epi32(v.v)}; }
+    static F ToFloat(I v) { return {_mm_cvtepi32_ps(v.v)}; }
+    static F Abs(F v) { return {_mm_andnot_ps(_mm_set1_ps(-0.0f), v.v)}; }
+    static F Negate(F v) { return {_mm_xor_ps(_mm_set1_ps(-0.0f), v.v)}; }
+    static F Min(F a, F b) { return {_mm_min_ps(a.v, b.v)}; }
+    static F Max(F a, F b) { return {_mm_max_ps(a.v, b.v)}; }
+    static F Sqrt(F v) { return {_mm_sqrt_ps(v.v)}; }
+
+    static M Less(F a, F b) { return {_mm_cmplt_ps(a.v, b.v)}; }
+    static M LessEqual(F a, F b) { return {_mm_cmple_ps(a.v, b.v)}; }
+    static M EqualI(I a, I b) { return {_mm_castsi128_ps(_mm_cmpeq_epi32(a.v, b.v))}; }
+    static M LessI(I a, I b) { return {_mm_castsi128_ps(_mm_cmplt_epi32(a.v, b.v))}; }
+    static M And(M a, M b) { return {_mm_and_ps(a.v, b.v)}; }
+    static M Or(M a, M b) { return {_mm_or_ps(a.v, b.v)}; }
+    static M Not(M a) { return {_mm_xor_ps(a.v, _mm_castsi128_ps(_mm_set1_epi32(-1)))}; }
+    static M AndNot(M a, M b) { return {_mm_andnot_ps(a.v, b.v)}; }
+    static F Select(M m, F a, F b) { return {_mm_blendv_ps(b.v, a.v, m.v)}; }
+    static I SelectI(M m, I a, I b) {
+        return {_mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(b.v), _mm_castsi128_ps(a.v), m.v))};
+    }
+
+    static I MulI(I a, I b) { return {_mm_mullo_epi32(a.v, b.v)}; }
+    static I ShiftRight(I v, int bits) { return {_mm_srl_epi32(v.v, _mm_cvtsi32_si128(bits))}; }
+    static I Gather(const int* table, I index) {
+        return {_mm_setr_epi32(table[_mm_cvtsi128_si32(index.v)], table[_mm_extract_epi32(index.v, 1)],
+                               table[_mm_extract_epi32(index.v, 2)], table[_mm_extract_epi32(index.v, 3)])};
+    }
+};
+
+} // namespace
+
+namespace Sse41 {
+
+void FillGrid2D(const Params& params, const Grid& grid, float* out) {
+    FillGrid2DImpl<Sse41Ops>(params, grid, out);
+}
+
+void FillGrid3D(const Params& params, const Grid& grid, float* out) {
+    FillGrid3DImpl<Sse41Ops>(params, grid, out);
+}
+
+void FillPoints2D(const Params& params, const float* xs, const float* ys, size_t count, float* out) {
+    FillPointsImpl<Sse41Ops>(params, xs, ys, nullptr, count, out);
+}
+
+void FillPoints3D(const Params& params, const float* xs, const float* ys, const float* zs,
+                  size_t count, float* out) {
+    FillPointsImpl<Sse41Ops>(params, xs, ys, zs, count, out);
+}
+
+} // namespace Sse41
+
+} // namespace NoiseKernels
+} // namespace VoxelCraft
+
+#endif // VOXELCRAFT_NOISE_X86
@@ -0,0 +1,708 @@
+#include "RegionFile.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <sstream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace VoxelCraft {
+
+	namespace {
+
+		constexpr intptr_t INVALID_FILE = -1;
+
+		uint32_t ReadLE32(const uint8_t* data)
+		{
+			return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+				(static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+		}
+
+		void WriteLE32(uint8_t* data, uint32_t value)
+		{
+			data[0] = static_cast<uint8_t>(value);
+			data[1] = static_cast<uint8_t>(value >> 8);
+			data[2] = static_cast<uint8_t>(value >> 16);
+			data[3] = static_cast<uint8_t>(value >> 24);
+		}
+
+		uint32_t LocationOffset(uint32_t location) { return location >> 8; }
+		uint32_t LocationCount(uint32_t location) { return location & 0xFF; }
+		uint32_t MakeLocation(uint32_t offset, uint32_t count) { return (offset << 8) | count; }
+
+#ifdef _WIN32
+		HANDLE AsHandle(intptr_t file) { return reinterpret_cast<HANDLE>(file); }
+
+		intptr_t OpenNative(const std::string& path, bool create)
+		{
+			HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE,
+				FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+				create ? OPEN_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+			return handle == INVALID_HANDLE_VALUE ? INVALID_FILE : reinterpret_cast<intptr_t>(handle);
+		}
+
+		void CloseNative(intptr_t file) { CloseHandle(AsHandle(file)); }
+
+		int64_t NativeSize(intptr_t file)
+		{
+			LARGE_INTEGER size;
+			return GetFileSizeEx(AsHandle(file), &size) ? size.QuadPart : -1;
+		}
+
+		bool ResizeNative(intptr_t file, uint64_t size)
+		{
+			LARGE_INTEGER position;
+			position.QuadPart = static_cast<LONGLONG>(size);
+			return SetFilePointerEx(AsHandle(file), position, nullptr, FILE_BEGIN) &&
+				SetEndOfFile(AsHandle(file));
+		}
+
+		bool WriteNative(intptr_t file, uint64_t offset, const uint8_t* data, size_t size)
+		{
+			while (size > 0) {
+				OVERLAPPED overlapped = {};
+				overlapped.Offset = static_cast<DWORD>(offset);
+				overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+				DWORD written = 0;
+				const DWORD chunk = static_cast<DWORD>(std::min<size_t>(size, 1u << 30));
+				if (!WriteFile(AsHandle(file), data, chunk, &written, &overlapped) || written == 0) {
+					return false;
+				}
+				data += written;
+				offset += written;
+				size -= written;
+			}
+			return true;
+		}
+
+		bool SyncNative(intptr_t file) { return FlushFileBuffers(AsHandle(file)) != 0; }
+#else
+		intptr_t OpenNative(const std::string& path, bool create)
+		{
+			int fd = ::open(path.c_str(), O_RDWR | O_CLOEXEC | (create ? O_CREAT : 0), 0644);
+			return fd < 0 ? INVALID_FILE : static_cast<intptr_t>(fd);
+		}
+
+		void CloseNative(intptr_t file) { ::close(static_cast<int>(file)); }
+
+		int64_t NativeSize(intptr_t file)
+		{
+			struct stat info;
+			return ::fstat(static_cast<int>(file), &info) == 0 ? static_cast<int64_t>(info.st_size) : -1;
+		}
+
+		bool ResizeNative(intptr_t file, uint64_t size)
+		{
+			return ::ftruncate(static_cast<int>(file), static_cast<off_t>(size)) == 0;
+		}
+
+		bool WriteNative(intptr_t file, uint64_t offset, const uint8_t* data, size_t size)
+		{
+			while (size > 0) {
+				ssize_t written = ::pwrite(static_cast<int>(file), data, size, static_cast<off_t>(offset));
+				if (written <= 0) {
+					return false;
+				}
+				data += written;
+				offset += static_cast<uint64_t>(written);
+				size -= static_cast<size_t>(written);
+			}
+			return true;
+		}
+
+		bool SyncNative(intptr_t file) { return ::fsync(static_cast<int>(file)) == 0; }
+#endif
+
+	} // namespace
+
+	RegionFile::RegionFile(std::string path)
+		: m_path(std::move(path))
+		, m_file(INVALID_FILE)
+		, m_mapping(0)
+		, m_map(nullptr)
+		, m_fileSectors(0)
+	{
+		m_locations.fill(0);
+		m_lengths.fill(0);
+	}
+
+	RegionFile::~RegionFile()
+	{
+		Close();
+	}
+
+	bool RegionFile::Open(bool create)
+	{
+		std::unique_lock<std::shared_mutex> lock(m_mutex);
+		return OpenLocked(create);
+	}
+
+	void RegionFile::Close()
+	{
+		std::unique_lock<std::shared_mutex> lock(m_mutex);
+		CloseLocked();
+	}
+
+	bool RegionFile::IsOpen() const
+	{
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		return m_file != INVALID_FILE;
+	}
+
+	bool RegionFile::OpenLocked(bool create)
+	{
+		if (m_file != INVALID_FILE) {
+			return true;
+		}
+
+		m_file = OpenNative(m_path, create);
+		if (m_file == INVALID_FILE) {
+			if (create) {
+				VOXELCRAFT_LOG_ERROR("Failed to open region file {}", m_path);
+			}
+			return false;
+		}
+
+		const int64_t size = NativeSize(m_file);
+		if (size < 0) {
+			VOXELCRAFT_LOG_ERROR("Failed to stat region file {}", m_path);
+			CloseLocked();
+			return false;
+		}
+
+		// New files get a zeroed header; partial trailing sectors are padded
+		uint32_t sectors = static_cast<uint32_t>((static_cast<uint64_t>(size) + SECTOR_SIZE - 1) / SECTOR_SIZE);
+		sectors = std::max(sectors, HEADER_SECTORS);
+		if (static_cast<uint64_t>(size) != static_cast<uint64_t>(sectors) * SECTOR_SIZE &&
+			!ResizeNative(m_file, static_cast<uint64_t>(sectors) * SECTOR_SIZE)) {
+			VOXELCRAFT_LOG_ERROR("Failed to size region file {}", m_path);
+			CloseLocked();
+			return false;
+		}
+
+		m_fileSectors = sectors;
+		if (!MapLocked()) {
+			CloseLocked();
+			return false;
+		}
+
+		LoadHeaderLocked();
+		return true;
+	}
+
+	void RegionFile::CloseLocked()
+	{
+		UnmapLocked();
+		if (m_file != INVALID_FILE) {
+			CloseNative(m_file);
+			m_file = INVALID_FILE;
+		}
+		m_fileSectors = 0;
+		m_locations.fill(0);
+		m_lengths.fill(0);
+		m_usedSectors.clear();
+	}
+
+	void RegionFile::LoadHeaderLocked()
+	{
+		m_usedSectors.assign(m_fileSectors, false);
+		MarkSectors(0, HEADER_SECTORS, true);
+
+		uint32_t dropped = 0;
+		for (uint32_t i = 0; i < REGION_CHUNKS; ++i) {
+			const uint32_t location = ReadLE32(m_map + i * 4);
+			const uint32_t length = ReadLE32(m_map + SECTOR_SIZE + i * 4);
+			m_locations[i] = 0;
+			m_lengths[i] = 0;
+			if (location == 0) {
+				continue;
+			}
+
+			// Entries pointing outside the file or into used sectors are dropped
+			const uint32_t offset = LocationOffset(location);
+			const uint32_t count = LocationCount(location);
+			bool valid = count > 0 && offset >= HEADER_SECTORS && offset + count <= m_fileSectors &&
+				length > 0 && length <= count * SECTOR_SIZE;
+			for (uint32_t s = offset; valid && s < offset + count; ++s) {
+				valid = !m_usedSectors[s];
+			}
+			if (!valid) {
+				++dropped;
+				continue;
+			}
+
+			m_locations[i] = location;
+			m_lengths[i] = length;
+			MarkSectors(offset, count, true);
+		}
+
+		if (dropped > 0) {
+			VOXELCRAFT_LOG_WARN("Dropped {} invalid chunk entries from region file {}", dropped, m_path);
+			for (uint32_t i = 0; i < REGION_CHUNKS; ++i) {
+				if (m_locations[i] == 0 && ReadLE32(m_map + i * 4) != 0) {
+					WriteHeaderEntryLocked(i);
+				}
+			}
+		}
+	}
+
+	bool RegionFile::HasChunk(int32_t localX, int32_t localZ) const
+	{
+		if (!IsValidLocal(localX, localZ)) {
+			return false;
+		}
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		return m_locations[GetIndex(localX, localZ)] != 0;
+	}
+
+	bool RegionFile::ReadChunk(int32_t localX, int32_t localZ, const ChunkReader& reader) const
+	{
+		if (!IsValidLocal(localX, localZ)) {
+			return false;
+		}
+
+		// The shared lock keeps the mapping and the payload stable while the reader runs
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		const uint32_t index = GetIndex(localX, localZ);
+		const uint32_t location = m_locations[index];
+		if (location == 0 || m_map == nullptr) {
+			return false;
+		}
+
+		reader(m_map + static_cast<size_t>(LocationOffset(location)) * SECTOR_SIZE, m_lengths[index]);
+		return true;
+	}
+
+	bool RegionFile::WriteChunk(int32_t localX, int32_t localZ, const uint8_t* data, size_t size)
+	{
+		if (!IsValidLocal(localX, localZ)) {
+			return false;
+		}
+		if (size == 0) {
+			return DeleteChunk(localX, localZ);
+		}
+
+		const uint32_t needed = SectorsFor(size);
+		if (needed > MAX_CHUNK_SECTORS) {
+			VOXELCRAFT_LOG_ERROR("Chunk payload of {} bytes exceeds region sector limit in {}", size, m_path);
+			return false;
+		}
+
+		std::unique_lock<std::shared_mutex> lock(m_mutex);
+		if (m_file == INVALID_FILE) {
+			return false;
+		}
+
+		const uint32_t index = GetIndex(localX, localZ);
+		const uint32_t oldOffset = LocationOffset(m_locations[index]);
+		const uint32_t oldCount = LocationCount(m_locations[index]);
+
+		uint32_t offset;
+		if (oldCount >= needed) {
+			// Prefer a fresh run so a crash leaves the old copy intact; rewrite
+			// in place only when that would mean growing the file
+			offset = FindFreeRunLocked(needed);
+			if (offset != 0) {
+				MarkSectors(offset, needed, true);
+			} else {
+				offset = oldOffset;
+			}
+		} else {
+			// The old copy stays valid until the header points at the new one
+			offset = AllocateLocked(needed);
+			if (offset == 0) {
+				return false;
+			}
+		}
+
+		if (!WriteAt(static_cast<uint64_t>(offset) * SECTOR_SIZE, data, size)) {
+			VOXELCRAFT_LOG_ERROR("Failed to write chunk payload to {}", m_path);
+			if (offset != oldOffset) {
+				MarkSectors(offset, needed, false);
+			}
+			return false;
+		}
+
+		m_locations[index] = MakeLocation(offset, needed);
+		m_lengths[index] = static_cast<uint32_t>(size);
+		if (!WriteHeaderEntryLocked(index)) {
+			return false;
+		}
+
+		// Sectors are freed only once the header no longer references them
+		if (offset != oldOffset) {
+			MarkSectors(oldOffset, oldCount, false);
+		} else {
+			MarkSectors(oldOffset + needed, oldCount - needed, false);
+		}
+		return true;
+	}
+
+	bool RegionFile::DeleteChunk(int32_t localX, int32_t localZ)
+	{
+		if (!IsValidLocal(localX, localZ)) {
+			return false;
+		}
+
+		std::unique_lock<std::shared_mutex> lock(m_mutex);
+		const uint32_t index = GetIndex(localX, localZ);
+		const uint32_t location = m_locations[index];
+		if (location == 0) {
+			return true;
+		}
+
+		m_locations[index] = 0;
+		m_lengths[index] = 0;
+		MarkSectors(LocationOffset(location), LocationCount(location), false);
+		return WriteHeaderEntryLocked(index);
+	}
+
+	bool RegionFile::Flush()
+	{
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		return m_file == INVALID_FILE || SyncNative(m_file);
+	}
+
+	bool RegionFile::Compact()
+	{
+		std::unique_lock<std::shared_mutex> lock(m_mutex);
+		if (m_file == INVALID_FILE) {
+			return false;
+		}
+
+		const std::string tempPath = m_path + ".tmp";
+		intptr_t temp = OpenNative(tempPath, true);
+		if (temp == INVALID_FILE) {
+			VOXELCRAFT_LOG_ERROR("Failed to create {}", tempPath);
+			return false;
+		}
+
+		std::vector<uint8_t> header(HEADER_SECTORS * SECTOR_SIZE, 0);
+		uint32_t nextSector = HEADER_SECTORS;
+		bool ok = ResizeNative(temp, 0);
+
+		for (uint32_t i = 0; ok && i < REGION_CHUNKS; ++i) {
+			if (m_locations[i] == 0) {
+				continue;
+			}
+
+			const uint32_t count = SectorsFor(m_lengths[i]);
+			const uint8_t* payload = m_map + static_cast<size_t>(LocationOffset(m_locations[i])) * SECTOR_SIZE;
+			ok = WriteNative(temp, static_cast<uint64_t>(nextSector) * SECTOR_SIZE, payload, m_lengths[i]);
+
+			WriteLE32(header.data() + i * 4, MakeLocation(nextSector, count));
+			WriteLE32(header.data() + SECTOR_SIZE + i * 4, m_lengths[i]);
+			nextSector += count;
+		}
+
+		ok = ok && WriteNative(temp, 0, header.data(), header.size()) &&
+			ResizeNative(temp, static_cast<uint64_t>(nextSector) * SECTOR_SIZE) &&
+			SyncNative(temp);
+		CloseNative(temp);
+
+		if (!ok) {
+			VOXELCRAFT_LOG_ERROR("Failed to write compacted region {}", tempPath);
+			std::error_code error;
+			std::filesystem::remove(tempPath, error);
+			return false;
+		}
+
+		CloseLocked();
+
+		std::error_code error;
+		std::filesystem::rename(tempPath, m_path, error);
+		if (error) {
+			VOXELCRAFT_LOG_ERROR("Failed to replace {} with compacted copy: {}", m_path, error.message());
+			std::filesystem::remove(tempPath, error);
+		}
+
+		return OpenLocked(false) && !error;
+	}
+
+	RegionFile::Stats RegionFile::GetStats() const
+	{
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+		Stats stats;
+		stats.fileSectors = m_fileSectors;
+		for (uint32_t i = 0; i < REGION_CHUNKS; ++i) {
+			if (m_locations[i] != 0) {
+				++stats.chunkCount;
+				stats.payloadBytes += m_lengths[i];
+			}
+		}
+		stats.usedSectors = static_cast<uint32_t>(std::count(m_usedSectors.begin(), m_usedSectors.end(), true));
+		stats.freeSectors = m_fileSectors - stats.usedSectors;
+		return stats;
+	}
+
+	uint32_t RegionFile::FindFreeRunLocked(uint32_t count) const
+	{
+		// First fit over the bitmap
+		uint32_t runStart = 0;
+		uint32_t runLength = 0;
+		for (uint32_t s = HEADER_SECTORS; s < m_fileSectors; ++s) {
+			if (m_usedSectors[s]) {
+				runLength = 0;
+				continue;
+			}
+			if (runLength == 0) {
+				runStart = s;
+			}
+			if (++runLength == count) {
+				return runStart;
+			}
+		}
+		return 0;
+	}
+
+	uint32_t RegionFile::AllocateLocked(uint32_t count)
+	{
+		const uint32_t run = FindFreeRunLocked(count);
+		if (run != 0) {
+			MarkSectors(run, count, true);
+			return run;
+		}
+
+		// A free run at the end only needs extending
+		uint32_t first = m_fileSectors;
+		while (first > HEADER_SECTORS && !m_usedSectors[first - 1]) {
+			--first;
+		}
+		const uint32_t required = first + count;
+
+		// Grow geometrically so appends do not remap on every chunk
+		const uint32_t grown = std::max(required,
+			m_fileSectors + std::max(MIN_GROWTH_SECTORS, m_fileSectors / 4));
+		if (!ResizeLocked(grown)) {
+			VOXELCRAFT_LOG_ERROR("Failed to grow region file {} to {} sectors", m_path, grown);
+			return 0;
+		}
+
+		MarkSectors(first, count, true);
+		return first;
+	}
+
+	void RegionFile::MarkSectors(uint32_t first, uint32_t count, bool used)
+	{
+		for (uint32_t s = first; s < first + count; ++s) {
+			m_usedSectors[s] = used;
+		}
+	}
+
+	bool RegionFile::ResizeLocked(uint32_t sectors)
+	{
+		UnmapLocked();
+		const bool resized = ResizeNative(m_file, static_cast<uint64_t>(sectors) * SECTOR_SIZE);
+		if (resized) {
+			m_fileSectors = sectors;
+			m_usedSectors.resize(sectors, false);
+		}
+		return MapLocked() && resized;
+	}
+
+	bool RegionFile::MapLocked()
+	{
+		const size_t size = static_cast<size_t>(m_fileSectors) * SECTOR_SIZE;
+
+#ifdef _WIN32
+		HANDLE mapping = CreateFileMappingA(AsHandle(m_file), nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr) {
+			VOXELCRAFT_LOG_ERROR("Failed to map region file {}", m_path);
+			return false;
+		}
+		void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size);
+		if (view == nullptr) {
+			CloseHandle(mapping);
+			VOXELCRAFT_LOG_ERROR("Failed to map region file {}", m_path);
+			return false;
+		}
+		m_mapping = reinterpret_cast<intptr_t>(mapping);
+		m_map = static_cast<uint8_t*>(view);
+#else
+		void* view = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, static_cast<int>(m_file), 0);
+		if (view == MAP_FAILED) {
+			VOXELCRAFT_LOG_ERROR("Failed to map region file {}", m_path);
+			return false;
+		}
+		m_map = static_cast<uint8_t*>(view);
+#endif
+		return true;
+	}
+
+	void RegionFile::UnmapLocked()
+	{
+		if (m_map == nullptr) {
+			return;
+		}
+
+#ifdef _WIN32
+		UnmapViewOfFile(m_map);
+		CloseHandle(reinterpret_cast<HANDLE>(m_mapping));
+		m_mapping = 0;
+#else
+		::munmap(m_map, static_cast<size_t>(m_fileSectors) * SECTOR_SIZE);
+#endif
+		m_map = nullptr;
+	}
+
+	bool RegionFile::WriteAt(uint64_t offset, const void* data, size_t size)
+	{
+		// The mapping is shared, so writes through the file are visible to readers
+		return WriteNative(m_file, offset, static_cast<const uint8_t*>(data), size);
+	}
+
+	bool RegionFile::WriteHeaderEntryLocked(uint32_t index)
+	{
+		uint8_t entry[4];
+		WriteLE32(entry, m_locations[index]);
+		if (!WriteAt(static_cast<uint64_t>(index) * 4, entry, sizeof(entry))) {
+			VOXELCRAFT_LOG_ERROR("Failed to write header of region file {}", m_path);
+			return false;
+		}
+		WriteLE32(entry, m_lengths[index]);
+		return WriteAt(SECTOR_SIZE + static_cast<uint64_t>(index) * 4, entry, sizeof(entry));
+	}
+
+	RegionStorage::RegionStorage(std::string directory)
+		: m_directory(std::move(directory))
+		, m_directoryCreated(false)
+	{
+	}
+
+	RegionStorage::~RegionStorage()
+	{
+		Close();
+	}
+
+	bool RegionStorage::ReadChunk(const ChunkCoord& coord, const RegionFile::ChunkReader& reader)
+	{
+		auto region = GetRegion(GetRegionCoord(coord), false);
+		return region && region->ReadChunk(coord.x & 31, coord.z & 31, reader);
+	}
+
+	bool RegionStorage::WriteChunk(const ChunkCoord& coord, const uint8_t* data, size_t size)
+	{
+		auto region = GetRegion(GetRegionCoord(coord), true);
+		return region && region->WriteChunk(coord.x & 31, coord.z & 31, data, size);
+	}
+
+	bool RegionStorage::HasChunk(const ChunkCoord& coord)
+	{
+		auto region = GetRegion(GetRegionCoord(coord), false);
+		return region && region->HasChunk(coord.x & 31, coord.z & 31);
+	}
+
+	bool RegionStorage::DeleteChunk(const ChunkCoord& coord)
+	{
+		auto region = GetRegion(GetRegionCoord(coord), false);
+		return !region || region->DeleteChunk(coord.x & 31, coord.z & 31);
+	}
+
+	void RegionStorage::Flush()
+	{
+		std::vector<std::shared_ptr<RegionFile>> regions;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			for (const auto& pair : m_regions) {
+				regions.push_back(pair.second);
+			}
+		}
+
+		for (const auto& region : regions) {
+			if (!region->Flush()) {
+				VOXELCRAFT_LOG_ERROR("Failed to flush region file {}", region->GetPath());
+			}
+		}
+	}
+
+	void RegionStorage::Close()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (auto& pair : m_regions) {
+			pair.second->Close();
+		}
+		m_regions.clear();
+		m_missingRegions.clear();
+	}
+
+	size_t RegionStorage::CompactAll()
+	{
+		std::error_code error;
+		if (!std::filesystem::is_directory(m_directory, error)) {
+			return 0;
+		}
+
+		size_t compacted = 0;
+		for (const auto& entry : std::filesystem::directory_iterator(m_directory, error)) {
+			ChunkCoord region;
+			char suffix[8] = {};
+			const std::string name = entry.path().filename().string();
+			if (std::sscanf(name.c_str(), "r.%d.%d.%7s", &region.x, &region.z, suffix) != 3 ||
+				std::strcmp(suffix, "vcr") != 0) {
+				continue;
+			}
+
+			auto file = GetRegion(region, false);
+			if (file && file->Compact()) {
+				++compacted;
+			}
+		}
+		return compacted;
+	}
+
+	std::string RegionStorage::GetRegionFileName(const ChunkCoord& region)
+	{
+		std::stringstream ss;
+		ss << "r." << region.x << "." << region.z << ".vcr";
+		return ss.str();
+	}
+
+	std::shared_ptr<RegionFile> RegionStorage::GetRegion(const ChunkCoord& region, bool create)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		auto it = m_regions.find(region);
+		if (it != m_regions.end()) {
+			return it->second;
+		}
+		if (!create && m_missingRegions.count(region) > 0) {
+			return nullptr;
+		}
+
+		if (create && !m_directoryCreated) {
+			std::error_code error;
+			std::filesystem::create_directories(m_directory, error);
+			if (error) {
+				VOXELCRAFT_LOG_ERROR("Failed to create region directory {}: {}", m_directory, error.message());
+				return nullptr;
+			}
+			m_directoryCreated = true;
+		}
+
+		auto file = std::make_shared<RegionFile>(
+			(std::filesystem::path(m_directory) / GetRegionFileName(region)).string());
+		if (!file->Open(create)) {
+			if (!create) {
+				m_missingRegions.insert(region);
+			}
+			return nullptr;
+		}
+
+		m_missingRegions.erase(region);
+		m_regions.emplace(region, file);
+		return file;
+	}
+
+} // namespace VoxelCraft
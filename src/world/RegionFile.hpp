@@ -0,0 +1,305 @@
+/**
+ * @file RegionFile.hpp
+ * @brief VoxelCraft World System - Region files packing 32x32 chunks per file
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#pragma once
+#include <array>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <mutex>
+#include <shared_mutex>
+#include <functional>
+#include <cstdint>
+#include "ChunkSystem.hpp"
+
+namespace VoxelCraft {
+
+	/**
+	 * @brief One region file holding up to 32x32 chunks
+	 *
+	 * Layout, in 4 KiB sectors:
+	 * - Sector 0: 1024 uint32 locations, (firstSector << 8) | sectorCount,
+	 *   0 when the chunk is absent
+	 * - Sector 1: 1024 uint32 payload lengths in bytes
+	 * - Sector 2+: chunk payloads, each starting on a sector boundary
+	 *
+	 * Entries are indexed by localX + localZ * 32 and stored little-endian.
+	 * The header has a fixed size and offset, so it is read straight from
+	 * the mapping on open. Free sectors are tracked in a bitmap and allocated
+	 * first-fit; a rewrite goes to a fresh run when one exists without
+	 * growing the file and otherwise overwrites its own sectors in place.
+	 * Space freed by growing chunks is reused but never returned to the file
+	 * system until Compact().
+	 *
+	 * The whole file is memory-mapped. ReadChunk() hands the reader a pointer
+	 * into the mapping under a shared lock, so payloads reach the decoder
+	 * without an intermediate copy. Writes go through the file descriptor
+	 * under an exclusive lock, payload first and header entry last, and old
+	 * sectors are freed only after that. A rewrite into a fresh run survives
+	 * a crash with the old copy intact; an in-place rewrite does not.
+	 */
+	class RegionFile
+	{
+	public:
+		static constexpr int32_t REGION_SIZE = 32;
+		static constexpr uint32_t REGION_CHUNKS = REGION_SIZE * REGION_SIZE;
+		static constexpr uint32_t SECTOR_SIZE = 4096;
+		static constexpr uint32_t HEADER_SECTORS = 2;
+		static constexpr uint32_t MAX_CHUNK_SECTORS = 255;
+		static constexpr uint32_t MIN_GROWTH_SECTORS = 8;
+
+		/**
+		 * @brief Receives a payload; the pointer is only valid during the call
+		 */
+		using ChunkReader = std::function<void(const uint8_t* data, size_t size)>;
+
+		/**
+		 * @brief Region statistics
+		 */
+		struct Stats
+		{
+			uint32_t chunkCount = 0;
+			uint32_t fileSectors = 0;
+			uint32_t usedSectors = 0;        // Header included
+			uint32_t freeSectors = 0;
+			uint64_t payloadBytes = 0;
+		};
+
+		/**
+		 * @brief Constructor
+		 * @param path Region file path
+		 */
+		explicit RegionFile(std::string path);
+
+		/**
+		 * @brief Destructor, unmaps and closes the file
+		 */
+		~RegionFile();
+
+		RegionFile(const RegionFile&) = delete;
+		RegionFile& operator=(const RegionFile&) = delete;
+
+		/**
+		 * @brief Open and map the file
+		 * @param create Create an empty region if the file does not exist
+		 * @return true if the region is usable
+		 */
+		bool Open(bool create);
+
+		/**
+		 * @brief Unmap and close the file
+		 */
+		void Close();
+
+		/**
+		 * @brief Check if the file is open
+		 */
+		bool IsOpen() const;
+
+		/**
+		 * @brief Check if a chunk is stored
+		 */
+		bool HasChunk(int32_t localX, int32_t localZ) const;
+
+		/**
+		 * @brief Pass a stored payload to reader without copying it
+		 * @return false if the chunk is absent
+		 */
+		bool ReadChunk(int32_t localX, int32_t localZ, const ChunkReader& reader) const;
+
+		/**
+		 * @brief Store a payload, in place if it fits the chunk's sectors
+		 */
+		bool WriteChunk(int32_t localX, int32_t localZ, const uint8_t* data, size_t size);
+
+		/**
+		 * @brief Remove a chunk and free its sectors
+		 */
+		bool DeleteChunk(int32_t localX, int32_t localZ);
+
+		/**
+		 * @brief Flush written data to stable storage
+		 */
+		bool Flush();
+
+		/**
+		 * @brief Rewrite the file with payloads packed in index order
+		 *
+		 * Writes a temporary file next to the region, renames it over the
+		 * original and reopens it. Drops free sectors and the growth tail.
+		 */
+		bool Compact();
+
+		/**
+		 * @brief Get region statistics
+		 */
+		Stats GetStats() const;
+
+		/**
+		 * @brief Get file path
+		 */
+		const std::string& GetPath() const { return m_path; }
+
+		/**
+		 * @brief Header index of a chunk
+		 */
+		static uint32_t GetIndex(int32_t localX, int32_t localZ) {
+			return static_cast<uint32_t>(localX + localZ * REGION_SIZE);
+		}
+
+		/**
+		 * @brief Sectors needed for a payload
+		 */
+		static uint32_t SectorsFor(size_t size) {
+			return static_cast<uint32_t>((size + SECTOR_SIZE - 1) / SECTOR_SIZE);
+		}
+
+	private:
+		std::string m_path;
+		intptr_t m_file;                        // File descriptor or HANDLE
+		intptr_t m_mapping;                     // Mapping HANDLE (Windows only)
+		uint8_t* m_map;
+		uint32_t m_fileSectors;
+		std::array<uint32_t, REGION_CHUNKS> m_locations;
+		std::array<uint32_t, REGION_CHUNKS> m_lengths;
+		std::vector<bool> m_usedSectors;
+		mutable std::shared_mutex m_mutex;
+
+		bool OpenLocked(bool create);
+		void CloseLocked();
+
+		/**
+		 * @brief Build the in-memory header and sector bitmap from the mapping
+		 */
+		void LoadHeaderLocked();
+
+		/**
+		 * @brief Find count free sectors without growing the file
+		 * @return First sector, or 0 if no free run is long enough
+		 */
+		uint32_t FindFreeRunLocked(uint32_t count) const;
+
+		/**
+		 * @brief Find count free sectors, growing the file if needed
+		 * @return First sector, or 0 on failure
+		 */
+		uint32_t AllocateLocked(uint32_t count);
+
+		void MarkSectors(uint32_t first, uint32_t count, bool used);
+
+		/**
+		 * @brief Resize the file to sectors and remap it
+		 */
+		bool ResizeLocked(uint32_t sectors);
+
+		bool MapLocked();
+		void UnmapLocked();
+
+		bool WriteAt(uint64_t offset, const void* data, size_t size);
+
+		/**
+		 * @brief Persist one header entry
+		 */
+		bool WriteHeaderEntryLocked(uint32_t index);
+
+		static bool IsValidLocal(int32_t localX, int32_t localZ) {
+			return localX >= 0 && localX < REGION_SIZE && localZ >= 0 && localZ < REGION_SIZE;
+		}
+	};
+
+	/**
+	 * @brief Directory of region files addressed by chunk coordinate
+	 *
+	 * Regions are opened lazily and stay open until Close(). Reads never
+	 * create files and remember regions that do not exist.
+	 */
+	class RegionStorage
+	{
+	public:
+		/**
+		 * @brief Constructor
+		 * @param directory Directory holding r.<x>.<z>.vcr files
+		 */
+		explicit RegionStorage(std::string directory);
+
+		/**
+		 * @brief Destructor, closes all regions
+		 */
+		~RegionStorage();
+
+		RegionStorage(const RegionStorage&) = delete;
+		RegionStorage& operator=(const RegionStorage&) = delete;
+
+		/**
+		 * @brief Pass a stored payload to reader without copying it
+		 */
+		bool ReadChunk(const ChunkCoord& coord, const RegionFile::ChunkReader& reader);
+
+		/**
+		 * @brief Store a payload, creating the region if needed
+		 */
+		bool WriteChunk(const ChunkCoord& coord, const uint8_t* data, size_t size);
+
+		/**
+		 * @brief Check if a chunk is stored
+		 */
+		bool HasChunk(const ChunkCoord& coord);
+
+		/**
+		 * @brief Remove a chunk
+		 */
+		bool DeleteChunk(const ChunkCoord& coord);
+
+		/**
+		 * @brief Flush all open regions
+		 */
+		void Flush();
+
+		/**
+		 * @brief Close all open regions
+		 */
+		void Close();
+
+		/**
+		 * @brief Compact every region file in the directory
+		 * @return Number of regions compacted
+		 */
+		size_t CompactAll();
+
+		/**
+		 * @brief Get directory
+		 */
+		const std::string& GetDirectory() const { return m_directory; }
+
+		/**
+		 * @brief Region containing a chunk
+		 */
+		static ChunkCoord GetRegionCoord(const ChunkCoord& coord) {
+			return ChunkCoord(coord.x >> 5, coord.z >> 5);
+		}
+
+		/**
+		 * @brief File name of a region, e.g. r.-1.2.vcr
+		 */
+		static std::string GetRegionFileName(const ChunkCoord& region);
+
+	private:
+		std::string m_directory;
+		std::mutex m_mutex;
+		std::unordered_map<ChunkCoord, std::shared_ptr<RegionFile>> m_regions;
+		std::unordered_set<ChunkCoord> m_missingRegions;
+		bool m_directoryCreated;
+
+		/**
+		 * @brief Get an open region, or nullptr if it does not exist and create is false
+		 */
+		std::shared_ptr<RegionFile> GetRegion(const ChunkCoord& region, bool create);
+	};
+
+} // namespace VoxelCraft
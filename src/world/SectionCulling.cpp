@@ -0,0 +1,586 @@
+/**
+ * @file SectionCulling.cpp
+ * @brief VoxelCraft World System - Section frustum culling and cave visibility graph Implementation
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#include "SectionCulling.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define VOXELCRAFT_CULLING_SSE2 1
+#else
+	#define VOXELCRAFT_CULLING_SSE2 0
+#endif
+
+namespace VoxelCraft {
+
+	namespace {
+
+		constexpr uint8_t NO_FACE = SectionCulling::FACE_COUNT;    // Entry face of the camera section
+
+		FrustumPlane MakePlane(float a, float b, float c, float d)
+		{
+			FrustumPlane plane;
+			const float length = std::sqrt(a * a + b * b + c * c);
+			if (length > 0.0f) {
+				plane.a = a / length;
+				plane.b = b / length;
+				plane.c = c / length;
+				plane.d = d / length;
+			}
+			return plane;
+		}
+
+		/**
+		 * @brief Plane through a point with the given inward normal
+		 */
+		FrustumPlane PlaneThrough(const float normal[3], const float point[3])
+		{
+			FrustumPlane plane = MakePlane(normal[0], normal[1], normal[2], 0.0f);
+			plane.d = -(plane.a * point[0] + plane.b * point[1] + plane.c * point[2]);
+			return plane;
+		}
+
+		void Normalize(float v[3])
+		{
+			const float length = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+			if (length > 0.0f) {
+				v[0] /= length;
+				v[1] /= length;
+				v[2] /= length;
+			}
+		}
+
+		void Cross(const float a[3], const float b[3], float out[3])
+		{
+			out[0] = a[1] * b[2] - a[2] * b[1];
+			out[1] = a[2] * b[0] - a[0] * b[2];
+			out[2] = a[0] * b[1] - a[1] * b[0];
+		}
+
+		/**
+		 * @brief Signed distance of the box corner furthest along the plane normal
+		 *
+		 * Same operation order as the SSE2 path so both agree bit for bit.
+		 */
+		inline float PositiveVertexDistance(const FrustumPlane& plane,
+			float minX, float minY, float minZ, float maxX, float maxY, float maxZ)
+		{
+			const float x = plane.a >= 0.0f ? maxX : minX;
+			const float y = plane.b >= 0.0f ? maxY : minY;
+			const float z = plane.c >= 0.0f ? maxZ : minZ;
+			return (plane.a * x + plane.b * y) + (plane.c * z + plane.d);
+		}
+
+		inline bool BoxInside(const std::array<FrustumPlane, 6>& planes, const SectionBoxes& boxes, size_t i)
+		{
+			for (const FrustumPlane& plane : planes) {
+				if (PositiveVertexDistance(plane, boxes.minX[i], boxes.minY[i], boxes.minZ[i],
+					boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i]) < 0.0f) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		size_t CullRangeScalar(const std::array<FrustumPlane, 6>& planes, const SectionBoxes& boxes,
+			size_t from, uint8_t* visible)
+		{
+			size_t passed = 0;
+			for (size_t i = from; i < boxes.Size(); ++i) {
+				visible[i] = BoxInside(planes, boxes, i) ? 1 : 0;
+				passed += visible[i];
+			}
+			return passed;
+		}
+
+		inline int FloorDiv16(float value)
+		{
+			return static_cast<int>(std::floor(value / 16.0f));
+		}
+
+	} // namespace
+
+	// ViewFrustum
+
+	ViewFrustum::ViewFrustum()
+	{
+		// Everything inside until built
+		for (FrustumPlane& plane : m_planes) {
+			plane.d = 1.0f;
+		}
+	}
+
+	ViewFrustum ViewFrustum::FromMatrix(const float* m)
+	{
+		// Gribb-Hartmann: clip-space rows combined; m is column-major
+		const float r0[4] = { m[0], m[4], m[8], m[12] };
+		const float r1[4] = { m[1], m[5], m[9], m[13] };
+		const float r2[4] = { m[2], m[6], m[10], m[14] };
+		const float r3[4] = { m[3], m[7], m[11], m[15] };
+
+		ViewFrustum frustum;
+		frustum.m_planes[0] = MakePlane(r3[0] + r0[0], r3[1] + r0[1], r3[2] + r0[2], r3[3] + r0[3]);
+		frustum.m_planes[1] = MakePlane(r3[0] - r0[0], r3[1] - r0[1], r3[2] - r0[2], r3[3] - r0[3]);
+		frustum.m_planes[2] = MakePlane(r3[0] + r1[0], r3[1] + r1[1], r3[2] + r1[2], r3[3] + r1[3]);
+		frustum.m_planes[3] = MakePlane(r3[0] - r1[0], r3[1] - r1[1], r3[2] - r1[2], r3[3] - r1[3]);
+		frustum.m_planes[4] = MakePlane(r3[0] + r2[0], r3[1] + r2[1], r3[2] + r2[2], r3[3] + r2[3]);
+		frustum.m_planes[5] = MakePlane(r3[0] - r2[0], r3[1] - r2[1], r3[2] - r2[2], r3[3] - r2[3]);
+		return frustum;
+	}
+
+	ViewFrustum ViewFrustum::FromCamera(const float position[3], const float forward[3], const float up[3],
+		float fovY, float aspect, float nearPlane, float farPlane)
+	{
+		float f[3] = { forward[0], forward[1], forward[2] };
+		Normalize(f);
+		float r[3];
+		Cross(f, up, r);
+		Normalize(r);
+		float u[3];
+		Cross(r, f, u);
+
+		const float halfV = std::tan(fovY * 0.5f);
+		const float halfH = halfV * aspect;
+
+		// Side planes pass through the eye; each normal is perpendicular to
+		// the frustum edge direction (e.g. f - r * halfH for the left side)
+		const float left[3] = { r[0] + f[0] * halfH, r[1] + f[1] * halfH, r[2] + f[2] * halfH };
+		const float right[3] = { -r[0] + f[0] * halfH, -r[1] + f[1] * halfH, -r[2] + f[2] * halfH };
+		const float bottom[3] = { u[0] + f[0] * halfV, u[1] + f[1] * halfV, u[2] + f[2] * halfV };
+		const float top[3] = { -u[0] + f[0] * halfV, -u[1] + f[1] * halfV, -u[2] + f[2] * halfV };
+		const float back[3] = { -f[0], -f[1], -f[2] };
+		const float nearPoint[3] = { position[0] + f[0] * nearPlane, position[1] + f[1] * nearPlane, position[2] + f[2] * nearPlane };
+		const float farPoint[3] = { position[0] + f[0] * farPlane, position[1] + f[1] * farPlane, position[2] + f[2] * farPlane };
+
+		ViewFrustum frustum;
+		frustum.m_planes[0] = PlaneThrough(left, position);
+		frustum.m_planes[1] = PlaneThrough(right, position);
+		frustum.m_planes[2] = PlaneThrough(bottom, position);
+		frustum.m_planes[3] = PlaneThrough(top, position);
+		frustum.m_planes[4] = PlaneThrough(f, nearPoint);
+		frustum.m_planes[5] = PlaneThrough(back, farPoint);
+		return frustum;
+	}
+
+	bool ViewFrustum::TestBox(float minX, float minY, float minZ, float maxX, float maxY, float maxZ) const
+	{
+		for (const FrustumPlane& plane : m_planes) {
+			if (PositiveVertexDistance(plane, minX, minY, minZ, maxX, maxY, maxZ) < 0.0f) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// SectionBoxes
+
+	void SectionBoxes::Clear()
+	{
+		minX.clear(); minY.clear(); minZ.clear();
+		maxX.clear(); maxY.clear(); maxZ.clear();
+	}
+
+	void SectionBoxes::Reserve(size_t count)
+	{
+		minX.reserve(count); minY.reserve(count); minZ.reserve(count);
+		maxX.reserve(count); maxY.reserve(count); maxZ.reserve(count);
+	}
+
+	void SectionBoxes::Add(float x0, float y0, float z0, float x1, float y1, float z1)
+	{
+		minX.push_back(x0); minY.push_back(y0); minZ.push_back(z0);
+		maxX.push_back(x1); maxY.push_back(y1); maxZ.push_back(z1);
+	}
+
+	// SectionCulling
+
+	namespace SectionCulling {
+
+		uint16_t ComputeConnectivity(const uint16_t* opaqueRows)
+		{
+			constexpr int ROWS = SECTION_SIZE * SECTION_SIZE;
+
+			bool solid = true;
+			bool open = true;
+			for (int row = 0; row < ROWS; ++row) {
+				solid &= opaqueRows[row] == 0xFFFF;
+				open &= opaqueRows[row] == 0;
+			}
+			if (solid) {
+				return CONNECT_NONE;
+			}
+			if (open) {
+				return CONNECT_ALL;
+			}
+
+			// Opaque cells start out visited; cell index is (y * 16 + z) * 16 + x
+			uint16_t visited[ROWS];
+			std::memcpy(visited, opaqueRows, sizeof(visited));
+			uint16_t stack[ROWS * SECTION_SIZE];
+			uint16_t connectivity = CONNECT_NONE;
+
+			for (int y = 0; y < SECTION_SIZE; ++y) {
+				for (int z = 0; z < SECTION_SIZE; ++z) {
+					// Regions that never touch the border join no faces: only flood from it
+					const int row = y * SECTION_SIZE + z;
+					const bool borderRow = y == 0 || y == SECTION_SIZE - 1 || z == 0 || z == SECTION_SIZE - 1;
+					const uint16_t borderMask = borderRow ? 0xFFFF : 0x8001;
+
+					uint16_t seeds = static_cast<uint16_t>(~visited[row] & borderMask);
+					while (seeds != 0) {
+						const int x = std::countr_zero(seeds);
+						visited[row] |= static_cast<uint16_t>(1u << x);
+
+						int top = 0;
+						stack[top++] = static_cast<uint16_t>(row * SECTION_SIZE + x);
+						uint8_t faces = 0;
+
+						while (top > 0) {
+							const int cell = stack[--top];
+							const int cx = cell & 15;
+							const int cz = (cell >> 4) & 15;
+							const int cy = cell >> 8;
+
+							faces |= static_cast<uint8_t>(
+								(cy == 0 ? 1 << 0 : 0) | (cy == 15 ? 1 << 1 : 0) |
+								(cz == 0 ? 1 << 2 : 0) | (cz == 15 ? 1 << 3 : 0) |
+								(cx == 0 ? 1 << 4 : 0) | (cx == 15 ? 1 << 5 : 0));
+
+							auto push = [&](int nx, int ny, int nz) {
+								uint16_t& bits = visited[ny * SECTION_SIZE + nz];
+								const uint16_t bit = static_cast<uint16_t>(1u << nx);
+								if ((bits & bit) == 0) {
+									bits |= bit;
+									stack[top++] = static_cast<uint16_t>((ny * SECTION_SIZE + nz) * SECTION_SIZE + nx);
+								}
+							};
+							if (cx > 0) push(cx - 1, cy, cz);
+							if (cx < 15) push(cx + 1, cy, cz);
+							if (cy > 0) push(cx, cy - 1, cz);
+							if (cy < 15) push(cx, cy + 1, cz);
+							if (cz > 0) push(cx, cy, cz - 1);
+							if (cz < 15) push(cx, cy, cz + 1);
+						}
+
+						for (int a = 0; a < FACE_COUNT; ++a) {
+							if ((faces & (1 << a)) == 0) {
+								continue;
+							}
+							for (int b = a + 1; b < FACE_COUNT; ++b) {
+								if ((faces & (1 << b)) != 0) {
+									connectivity |= static_cast<uint16_t>(1u << PairBit(a, b));
+								}
+							}
+						}
+						if (connectivity == CONNECT_ALL) {
+							return connectivity;
+						}
+
+						seeds = static_cast<uint16_t>(~visited[row] & borderMask);
+					}
+				}
+			}
+			return connectivity;
+		}
+
+		size_t CullBoxesScalar(const ViewFrustum& frustum, const SectionBoxes& boxes, uint8_t* visible)
+		{
+			return CullRangeScalar(frustum.GetPlanes(), boxes, 0, visible);
+		}
+
+		size_t CullBoxes(const ViewFrustum& frustum, const SectionBoxes& boxes, uint8_t* visible)
+		{
+#if VOXELCRAFT_CULLING_SSE2
+			const auto& planes = frustum.GetPlanes();
+			const size_t count = boxes.Size();
+
+			// The tested corner depends only on the plane's signs: pick the
+			// arrays once, then every step is three multiplies and a compare
+			__m128 a[6], b[6], c[6], d[6];
+			const float* xs[6];
+			const float* ys[6];
+			const float* zs[6];
+			for (size_t p = 0; p < 6; ++p) {
+				a[p] = _mm_set1_ps(planes[p].a);
+				b[p] = _mm_set1_ps(planes[p].b);
+				c[p] = _mm_set1_ps(planes[p].c);
+				d[p] = _mm_set1_ps(planes[p].d);
+				xs[p] = planes[p].a >= 0.0f ? boxes.maxX.data() : boxes.minX.data();
+				ys[p] = planes[p].b >= 0.0f ? boxes.maxY.data() : boxes.minY.data();
+				zs[p] = planes[p].c >= 0.0f ? boxes.maxZ.data() : boxes.minZ.data();
+			}
+
+			const __m128 zero = _mm_setzero_ps();
+			size_t passed = 0;
+			size_t i = 0;
+			for (; i + 4 <= count; i += 4) {
+				__m128 outside = zero;
+				for (size_t p = 0; p < 6; ++p) {
+					const __m128 xy = _mm_add_ps(_mm_mul_ps(a[p], _mm_loadu_ps(xs[p] + i)),
+						_mm_mul_ps(b[p], _mm_loadu_ps(ys[p] + i)));
+					const __m128 zw = _mm_add_ps(_mm_mul_ps(c[p], _mm_loadu_ps(zs[p] + i)), d[p]);
+					outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(xy, zw), zero));
+				}
+
+				const int mask = _mm_movemask_ps(outside);
+				for (size_t k = 0; k < 4; ++k) {
+					visible[i + k] = static_cast<uint8_t>(((mask >> k) & 1) ^ 1);
+				}
+				passed += static_cast<size_t>(4 - std::popcount(static_cast<unsigned>(mask)));
+			}
+			return passed + CullRangeScalar(planes, boxes, i, visible);
+#else
+			return CullBoxesScalar(frustum, boxes, visible);
+#endif
+		}
+
+		bool IsVectorized()
+		{
+			return VOXELCRAFT_CULLING_SSE2 != 0;
+		}
+
+	} // namespace SectionCulling
+
+	// SectionOcclusionCuller
+
+	SectionOcclusionCuller::SectionOcclusionCuller()
+		: m_gridDirty(true)
+		, m_gridCenter(0, 0)
+		, m_gridRadius(-1)
+		, m_stamp(0)
+	{
+	}
+
+	void SectionOcclusionCuller::SetChunk(const ChunkCoord& coord,
+		const std::array<uint16_t, SectionCulling::SECTIONS_PER_CHUNK>& connectivity)
+	{
+		auto it = m_chunks.find(coord);
+		if (it == m_chunks.end()) {
+			m_chunks.emplace(coord, connectivity);
+			m_gridDirty |= IsInGrid(coord);
+			return;
+		}
+
+		// Remesh: boxes are unchanged, patch the connectivity in place
+		it->second = connectivity;
+		if (!m_gridDirty && IsInGrid(coord)) {
+			for (int s = 0; s < SectionCulling::SECTIONS_PER_CHUNK; ++s) {
+				m_gridConnectivity[CellIndex(coord, s)] = connectivity[static_cast<size_t>(s)];
+			}
+		}
+	}
+
+	void SectionOcclusionCuller::RemoveChunk(const ChunkCoord& coord)
+	{
+		if (m_chunks.erase(coord) != 0) {
+			m_gridDirty |= IsInGrid(coord);
+		}
+	}
+
+	void SectionOcclusionCuller::Clear()
+	{
+		m_chunks.clear();
+		m_gridDirty = true;
+	}
+
+	bool SectionOcclusionCuller::IsInGrid(const ChunkCoord& coord) const
+	{
+		return m_gridRadius >= 0 &&
+			std::abs(coord.x - m_gridCenter.x) <= m_gridRadius &&
+			std::abs(coord.z - m_gridCenter.z) <= m_gridRadius;
+	}
+
+	uint32_t SectionOcclusionCuller::CellIndex(const ChunkCoord& coord, int section) const
+	{
+		const uint32_t ix = static_cast<uint32_t>(coord.x - m_gridCenter.x + m_gridRadius);
+		const uint32_t iz = static_cast<uint32_t>(coord.z - m_gridCenter.z + m_gridRadius);
+		return (iz * GridWidth() + ix) * SectionCulling::SECTIONS_PER_CHUNK + static_cast<uint32_t>(section);
+	}
+
+	VisibleSection SectionOcclusionCuller::CellSection(uint32_t cell) const
+	{
+		const uint32_t column = cell / SectionCulling::SECTIONS_PER_CHUNK;
+		VisibleSection result;
+		result.chunk = ChunkCoord(
+			m_gridCenter.x + static_cast<int32_t>(column % GridWidth()) - m_gridRadius,
+			m_gridCenter.z + static_cast<int32_t>(column / GridWidth()) - m_gridRadius);
+		result.section = static_cast<int>(cell % SectionCulling::SECTIONS_PER_CHUNK);
+		return result;
+	}
+
+	void SectionOcclusionCuller::RebuildGrid(const ChunkCoord& center, int radius)
+	{
+		m_gridCenter = center;
+		m_gridRadius = radius;
+		m_gridDirty = false;
+
+		const uint32_t width = GridWidth();
+		const size_t cells = static_cast<size_t>(width) * width * SectionCulling::SECTIONS_PER_CHUNK;
+		m_gridConnectivity.assign(cells, SectionCulling::CONNECT_NONE);
+		m_gridBox.assign(cells, -1);
+		m_visitStamp.assign(cells, 0);
+		m_entryFace.assign(cells, NO_FACE);
+		m_directions.assign(cells, 0);
+		m_stamp = 0;
+
+		m_boxes.Clear();
+		m_boxCells.clear();
+		m_boxes.Reserve(cells);
+		m_boxCells.reserve(cells);
+
+		const float size = static_cast<float>(SectionCulling::SECTION_SIZE);
+		for (int dz = -radius; dz <= radius; ++dz) {
+			for (int dx = -radius; dx <= radius; ++dx) {
+				// Same circle as ChunkSystem's distance check
+				if (dx * dx + dz * dz > radius * radius) {
+					continue;
+				}
+				const ChunkCoord coord(center.x + dx, center.z + dz);
+				auto it = m_chunks.find(coord);
+				if (it == m_chunks.end()) {
+					continue;
+				}
+
+				const float x0 = static_cast<float>(coord.x) * size;
+				const float z0 = static_cast<float>(coord.z) * size;
+				for (int s = 0; s < SectionCulling::SECTIONS_PER_CHUNK; ++s) {
+					const uint32_t cell = CellIndex(coord, s);
+					const float y0 = static_cast<float>(s) * size;
+					m_gridConnectivity[cell] = it->second[static_cast<size_t>(s)];
+					m_gridBox[cell] = static_cast<int32_t>(m_boxes.Size());
+					m_boxes.Add(x0, y0, z0, x0 + size, y0 + size, z0 + size);
+					m_boxCells.push_back(cell);
+				}
+			}
+		}
+		m_boxVisible.resize(m_boxes.Size());
+	}
+
+	void SectionOcclusionCuller::Cull(const ViewFrustum& frustum, float cameraX, float cameraY, float cameraZ,
+		int renderDistance, bool useOcclusion, std::vector<VisibleSection>& visible)
+	{
+		visible.clear();
+		m_stats = SectionCullingStats();
+
+		const ChunkCoord center(FloorDiv16(cameraX), FloorDiv16(cameraZ));
+		const int radius = std::max(renderDistance, 0);
+		if (m_gridDirty || center != m_gridCenter || radius != m_gridRadius) {
+			RebuildGrid(center, radius);
+		}
+
+		m_stats.cullingTests = static_cast<uint32_t>(m_boxes.Size());
+		m_stats.cullingPassed = static_cast<uint32_t>(SectionCulling::CullBoxes(frustum, m_boxes, m_boxVisible.data()));
+
+		// Without the camera chunk's connectivity there is nowhere to start the walk
+		const bool cameraLoaded = m_gridBox[CellIndex(center, 0)] >= 0;
+		if (!useOcclusion || !cameraLoaded) {
+			visible.reserve(m_stats.cullingPassed);
+			for (size_t i = 0; i < m_boxes.Size(); ++i) {
+				if (m_boxVisible[i]) {
+					visible.push_back(CellSection(m_boxCells[i]));
+				}
+			}
+			return;
+		}
+
+		Walk(cameraY, visible);
+		m_stats.occlusionUsed = true;
+		m_stats.occlusionTests = m_stats.cullingPassed;
+		m_stats.occlusionPassed = static_cast<uint32_t>(visible.size());
+	}
+
+	void SectionOcclusionCuller::Walk(float cameraY, std::vector<VisibleSection>& visible)
+	{
+		using namespace SectionCulling;
+
+		if (++m_stamp == 0) {
+			std::fill(m_visitStamp.begin(), m_visitStamp.end(), 0);
+			m_stamp = 1;
+		}
+		m_queue.clear();
+
+		auto enter = [&](uint32_t cell, uint8_t entryFace, uint8_t directions) {
+			m_visitStamp[cell] = m_stamp;
+			m_entryFace[cell] = entryFace;
+			m_directions[cell] = directions;
+			m_queue.push_back(cell);
+		};
+
+		const int cameraSection = FloorDiv16(cameraY);
+		const uint32_t centerColumn = CellIndex(m_gridCenter, 0);
+		if (cameraSection >= 0 && cameraSection < SECTIONS_PER_CHUNK) {
+			// The camera's own section is drawn even if the near plane clips it
+			enter(centerColumn + static_cast<uint32_t>(cameraSection), NO_FACE, 0);
+		}
+		else {
+			// Above or below the world: enter every visible top (bottom) section from outside
+			const bool above = cameraSection >= SECTIONS_PER_CHUNK;
+			const int section = above ? SECTIONS_PER_CHUNK - 1 : 0;
+			const uint8_t entryFace = above ? 1 : 0;
+			const uint8_t direction = static_cast<uint8_t>(1u << OppositeFace(entryFace));
+			for (size_t i = 0; i < m_boxes.Size(); ++i) {
+				const uint32_t cell = m_boxCells[i];
+				if (m_boxVisible[i] && static_cast<int>(cell % SECTIONS_PER_CHUNK) == section) {
+					enter(cell, entryFace, direction);
+				}
+			}
+		}
+
+		const int width = static_cast<int>(GridWidth());
+		const int columnStride = SECTIONS_PER_CHUNK;
+		const int rowStride = width * SECTIONS_PER_CHUNK;
+
+		for (size_t head = 0; head < m_queue.size(); ++head) {
+			const uint32_t cell = m_queue[head];
+			const uint16_t connectivity = m_gridConnectivity[cell];
+			const uint8_t entryFace = m_entryFace[cell];
+			const uint8_t directions = m_directions[cell];
+
+			const int section = static_cast<int>(cell % SECTIONS_PER_CHUNK);
+			const int column = static_cast<int>(cell / SECTIONS_PER_CHUNK);
+			const int ix = column % width;
+			const int iz = column / width;
+
+			for (int face = 0; face < FACE_COUNT; ++face) {
+				// Never turn back along an axis already travelled
+				if (directions & (1u << OppositeFace(face))) {
+					continue;
+				}
+				if (entryFace != NO_FACE && !IsConnected(connectivity, entryFace, face)) {
+					continue;
+				}
+
+				int offset = 0;
+				switch (face) {
+					case 0: if (section == 0) continue; offset = -1; break;
+					case 1: if (section == SECTIONS_PER_CHUNK - 1) continue; offset = 1; break;
+					case 2: if (iz == 0) continue; offset = -rowStride; break;
+					case 3: if (iz == width - 1) continue; offset = rowStride; break;
+					case 4: if (ix == 0) continue; offset = -columnStride; break;
+					default: if (ix == width - 1) continue; offset = columnStride; break;
+				}
+
+				const uint32_t next = static_cast<uint32_t>(static_cast<int>(cell) + offset);
+				const int32_t box = m_gridBox[next];
+				if (box < 0 || !m_boxVisible[static_cast<size_t>(box)] || m_visitStamp[next] == m_stamp) {
+					continue;
+				}
+				enter(next, static_cast<uint8_t>(OppositeFace(face)), static_cast<uint8_t>(directions | (1u << face)));
+			}
+		}
+
+		visible.reserve(m_queue.size());
+		for (uint32_t cell : m_queue) {
+			visible.push_back(CellSection(cell));
+		}
+	}
+
+} // namespace VoxelCraft
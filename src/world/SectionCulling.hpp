@@ -0,0 +1,243 @@
+/**
+ * @file SectionCulling.hpp
+ * @brief VoxelCraft World System - Section frustum culling and cave visibility graph
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ *
+ * Chunks are culled per 16x16x16 section in two steps:
+ *
+ * - Frustum: section boxes are kept as structure-of-arrays and tested
+ *   against the six planes, four boxes per step on SSE2 builds. Only the
+ *   box corner furthest along each plane normal is tested.
+ * - Occlusion: at mesh time every section records which pairs of its six
+ *   faces are joined through non-opaque blocks. Culling walks these
+ *   sections breadth-first from the camera, entering a neighbor only if
+ *   the path through the current section connects the face it came in by
+ *   to the face it leaves by, and never turning back along an axis
+ *   already travelled. Sections the walk never reaches (sealed caves
+ *   seen from the surface, the surface seen from a sealed cave) are
+ *   dropped. The walk keeps some hidden sections; CullingBenchmark
+ *   checks with rays that it drops none the camera can see.
+ *
+ * Everything runs on the CPU and has no renderer dependency.
+ */
+
+#pragma once
+#include <array>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+#include "ChunkSystem.hpp"
+
+namespace VoxelCraft {
+
+	/**
+	 * @brief Plane a*x + b*y + c*z + d = 0, normal pointing into the frustum
+	 */
+	struct FrustumPlane
+	{
+		float a = 0.0f;
+		float b = 0.0f;
+		float c = 0.0f;
+		float d = 0.0f;
+	};
+
+	/**
+	 * @brief View frustum as six inward-facing planes (left, right, bottom, top, near, far)
+	 */
+	class ViewFrustum
+	{
+	public:
+		ViewFrustum();
+
+		/**
+		 * @brief Extract the planes of a column-major OpenGL view-projection matrix
+		 */
+		static ViewFrustum FromMatrix(const float* viewProjection);
+
+		/**
+		 * @brief Build the frustum of a perspective camera
+		 * @param position Eye position
+		 * @param forward View direction (need not be normalized)
+		 * @param up Up hint, not parallel to forward
+		 * @param fovY Vertical field of view in radians
+		 * @param aspect Width over height
+		 */
+		static ViewFrustum FromCamera(const float position[3], const float forward[3], const float up[3],
+			float fovY, float aspect, float nearPlane, float farPlane);
+
+		/**
+		 * @brief Whether an axis-aligned box is at least partly inside
+		 */
+		bool TestBox(float minX, float minY, float minZ, float maxX, float maxY, float maxZ) const;
+
+		const std::array<FrustumPlane, 6>& GetPlanes() const { return m_planes; }
+
+	private:
+		std::array<FrustumPlane, 6> m_planes;
+	};
+
+	/**
+	 * @brief Axis-aligned boxes as structure-of-arrays for batched frustum tests
+	 */
+	struct SectionBoxes
+	{
+		std::vector<float> minX, minY, minZ;
+		std::vector<float> maxX, maxY, maxZ;
+
+		size_t Size() const { return minX.size(); }
+
+		void Clear();
+		void Reserve(size_t count);
+		void Add(float x0, float y0, float z0, float x1, float y1, float z1);
+	};
+
+	namespace SectionCulling {
+
+		// Face order matches BlockFace: BOTTOM (-Y), TOP (+Y), NORTH (-Z), SOUTH (+Z), WEST (-X), EAST (+X)
+		constexpr int FACE_COUNT = 6;
+		constexpr int SECTION_SIZE = 16;
+		constexpr int SECTIONS_PER_CHUNK = 16;
+
+		constexpr uint16_t CONNECT_NONE = 0;         // No face sees another (solid section)
+		constexpr uint16_t CONNECT_ALL = 0x7FFF;     // All 15 face pairs joined (empty section)
+
+		/**
+		 * @brief Face on the other side of the section
+		 */
+		constexpr int OppositeFace(int face) { return face ^ 1; }
+
+		/**
+		 * @brief Bit of the face pair (a, b) in a connectivity mask
+		 */
+		constexpr int PairBit(int a, int b)
+		{
+			return a < b ? a * (11 - a) / 2 + (b - a - 1) : b * (11 - b) / 2 + (a - b - 1);
+		}
+
+		/**
+		 * @brief Whether faces a and b see each other through the section
+		 */
+		constexpr bool IsConnected(uint16_t connectivity, int a, int b)
+		{
+			return a == b || (connectivity & (1u << PairBit(a, b))) != 0;
+		}
+
+		/**
+		 * @brief Face-to-face connectivity of one section
+		 * @param opaqueRows 256 rows indexed y * 16 + z; bit x set where the block is opaque
+		 *
+		 * Flood-fills the non-opaque cells from the section border; each
+		 * region joins every pair of border faces it touches.
+		 */
+		uint16_t ComputeConnectivity(const uint16_t* opaqueRows);
+
+		/**
+		 * @brief Test boxes against a frustum
+		 * @param visible One byte per box, set to 1 when inside or intersecting
+		 * @return Boxes passed
+		 */
+		size_t CullBoxes(const ViewFrustum& frustum, const SectionBoxes& boxes, uint8_t* visible);
+
+		/**
+		 * @brief Scalar reference for CullBoxes; same results on every build
+		 */
+		size_t CullBoxesScalar(const ViewFrustum& frustum, const SectionBoxes& boxes, uint8_t* visible);
+
+		/**
+		 * @brief Whether CullBoxes uses the SSE2 path on this build
+		 */
+		bool IsVectorized();
+
+	} // namespace SectionCulling
+
+	/**
+	 * @brief Section that survived culling
+	 */
+	struct VisibleSection
+	{
+		ChunkCoord chunk;
+		int section = 0;                     // 0-15, bottom to top
+	};
+
+	/**
+	 * @brief Counters of the last SectionOcclusionCuller::Cull
+	 */
+	struct SectionCullingStats
+	{
+		uint32_t cullingTests = 0;           // Loaded sections tested against the frustum
+		uint32_t cullingPassed = 0;          // Inside or intersecting the frustum
+		uint32_t occlusionTests = 0;         // Frustum survivors the visibility walk could reach
+		uint32_t occlusionPassed = 0;        // Reached by the walk
+		bool occlusionUsed = false;          // False when the camera chunk had no connectivity yet
+	};
+
+	/**
+	 * @brief Per-section frustum and cave culling around the camera
+	 *
+	 * Holds each meshed chunk's section connectivity. Section boxes and
+	 * connectivity are laid out on a grid around the camera chunk, rebuilt
+	 * only when the camera changes chunk, the radius changes or a chunk is
+	 * added or removed; a remesh that keeps the chunk only patches its
+	 * cells.
+	 *
+	 * Not thread-safe: ChunkSystem guards it with its mesh mutex.
+	 */
+	class SectionOcclusionCuller
+	{
+	public:
+		SectionOcclusionCuller();
+
+		/**
+		 * @brief Add or update a chunk's section connectivity
+		 */
+		void SetChunk(const ChunkCoord& coord, const std::array<uint16_t, SectionCulling::SECTIONS_PER_CHUNK>& connectivity);
+
+		void RemoveChunk(const ChunkCoord& coord);
+		void Clear();
+		size_t GetChunkCount() const { return m_chunks.size(); }
+
+		/**
+		 * @brief Collect the sections to draw
+		 * @param renderDistance Horizontal radius in chunks
+		 * @param useOcclusion Walk the visibility graph after the frustum test
+		 * @param visible Replaced with the surviving sections, nearest first when walking
+		 */
+		void Cull(const ViewFrustum& frustum, float cameraX, float cameraY, float cameraZ,
+			int renderDistance, bool useOcclusion, std::vector<VisibleSection>& visible);
+
+		const SectionCullingStats& GetStats() const { return m_stats; }
+
+	private:
+		std::unordered_map<ChunkCoord, std::array<uint16_t, SectionCulling::SECTIONS_PER_CHUNK>> m_chunks;
+
+		// Grid of (2 * radius + 1)^2 columns x 16 sections around m_gridCenter
+		bool m_gridDirty;
+		ChunkCoord m_gridCenter;
+		int m_gridRadius;
+		std::vector<uint16_t> m_gridConnectivity;
+		std::vector<int32_t> m_gridBox;      // Box index per cell, -1 when not loaded or out of range
+		SectionBoxes m_boxes;
+		std::vector<uint32_t> m_boxCells;    // Cell per box
+
+		// Per-cull scratch
+		std::vector<uint8_t> m_boxVisible;
+		std::vector<uint32_t> m_visitStamp;
+		std::vector<uint8_t> m_entryFace;
+		std::vector<uint8_t> m_directions;
+		std::vector<uint32_t> m_queue;
+		uint32_t m_stamp;
+
+		SectionCullingStats m_stats;
+
+		void RebuildGrid(const ChunkCoord& center, int radius);
+		uint32_t GridWidth() const { return static_cast<uint32_t>(2 * m_gridRadius + 1); }
+		bool IsInGrid(const ChunkCoord& coord) const;
+		uint32_t CellIndex(const ChunkCoord& coord, int section) const;
+		VisibleSection CellSection(uint32_t cell) const;
+		void Walk(float cameraY, std::vector<VisibleSection>& visible);
+	};
+
+} // namespace VoxelCraft
@@ -0,0 +1,282 @@
+#include "TerrainDensity.hpp"
+#include "NoiseGenerator.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include <utility>
+
+namespace VoxelCraft {
+
+	namespace {
+
+		int32_t FloorDiv(int32_t value, int32_t divisor)
+		{
+			int32_t quotient = value / divisor;
+			if ((value % divisor != 0) && ((value < 0) != (divisor < 0))) {
+				--quotient;
+			}
+			return quotient;
+		}
+
+		float Lerp(float a, float b, float t)
+		{
+			return a + (b - a) * t;
+		}
+
+	} // namespace
+
+	ColumnClimateCache::ColumnClimateCache(const DensityLatticeSettings& settings, size_t capacity, TileFiller filler)
+		: m_spacing(settings.cellWidth)
+		, m_tileColumns(settings.chunkSize / settings.cellWidth)
+		, m_chunkSize(settings.chunkSize)
+		, m_capacity(std::max<size_t>(capacity, 4))
+		, m_filler(std::move(filler))
+		, m_tilesBuilt(0)
+	{
+	}
+
+	ColumnClimate ColumnClimateCache::Get(int32_t latticeX, int32_t latticeZ)
+	{
+		int32_t tileX = FloorDiv(latticeX, m_tileColumns);
+		int32_t tileZ = FloorDiv(latticeZ, m_tileColumns);
+		auto tile = AcquireTile(tileX, tileZ);
+
+		int localX = latticeX - tileX * m_tileColumns;
+		int localZ = latticeZ - tileZ * m_tileColumns;
+		return (*tile)[static_cast<size_t>(localZ * m_tileColumns + localX)];
+	}
+
+	ColumnClimate ColumnClimateCache::Sample(int32_t worldX, int32_t worldZ)
+	{
+		int32_t latticeX = FloorDiv(worldX, m_spacing);
+		int32_t latticeZ = FloorDiv(worldZ, m_spacing);
+		float fx = static_cast<float>(worldX - latticeX * m_spacing) / static_cast<float>(m_spacing);
+		float fz = static_cast<float>(worldZ - latticeZ * m_spacing) / static_cast<float>(m_spacing);
+
+		ColumnClimate c00 = Get(latticeX, latticeZ);
+		ColumnClimate c10 = Get(latticeX + 1, latticeZ);
+		ColumnClimate c01 = Get(latticeX, latticeZ + 1);
+		ColumnClimate c11 = Get(latticeX + 1, latticeZ + 1);
+
+		auto bilerp = [fx, fz](float v00, float v10, float v01, float v11) {
+			return Lerp(Lerp(v00, v10, fx), Lerp(v01, v11, fx), fz);
+		};
+
+		ColumnClimate result;
+		result.temperature = bilerp(c00.temperature, c10.temperature, c01.temperature, c11.temperature);
+		result.humidity = bilerp(c00.humidity, c10.humidity, c01.humidity, c11.humidity);
+		result.continentalness = bilerp(c00.continentalness, c10.continentalness, c01.continentalness, c11.continentalness);
+		result.erosion = bilerp(c00.erosion, c10.erosion, c01.erosion, c11.erosion);
+		result.depth = bilerp(c00.depth, c10.depth, c01.depth, c11.depth);
+		result.weirdness = bilerp(c00.weirdness, c10.weirdness, c01.weirdness, c11.weirdness);
+		result.surfaceHeight = bilerp(c00.surfaceHeight, c10.surfaceHeight, c01.surfaceHeight, c11.surfaceHeight);
+
+		// Biomes are categorical, take the nearest lattice column
+		const ColumnClimate& nearestRow0 = fx < 0.5f ? c00 : c10;
+		const ColumnClimate& nearestRow1 = fx < 0.5f ? c01 : c11;
+		result.biome = (fz < 0.5f ? nearestRow0 : nearestRow1).biome;
+		return result;
+	}
+
+	void ColumnClimateCache::GetChunkColumns(int32_t chunkX, int32_t chunkZ, ColumnClimate* out)
+	{
+		// Own tile plus the +X, +Z and diagonal neighbors for the border row/column
+		std::shared_ptr<const Tile> tiles[2][2] = {
+			{ AcquireTile(chunkX, chunkZ), AcquireTile(chunkX + 1, chunkZ) },
+			{ AcquireTile(chunkX, chunkZ + 1), AcquireTile(chunkX + 1, chunkZ + 1) }
+		};
+
+		const int n = m_tileColumns;
+		const int stride = n + 1;
+		for (int z = 0; z <= n; ++z) {
+			int tz = z == n ? 1 : 0;
+			int localZ = z == n ? 0 : z;
+			for (int x = 0; x <= n; ++x) {
+				int tx = x == n ? 1 : 0;
+				int localX = x == n ? 0 : x;
+				out[z * stride + x] = (*tiles[tz][tx])[static_cast<size_t>(localZ * n + localX)];
+			}
+		}
+	}
+
+	void ColumnClimateCache::Clear()
+	{
+		std::unique_lock<std::shared_mutex> lock(m_mutex);
+		m_tiles.clear();
+	}
+
+	size_t ColumnClimateCache::GetTileCount() const
+	{
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		return m_tiles.size();
+	}
+
+	uint64_t ColumnClimateCache::KeyOf(int32_t tileX, int32_t tileZ)
+	{
+		return (static_cast<uint64_t>(static_cast<uint32_t>(tileX)) << 32) | static_cast<uint32_t>(tileZ);
+	}
+
+	std::shared_ptr<const ColumnClimateCache::Tile> ColumnClimateCache::AcquireTile(int32_t tileX, int32_t tileZ)
+	{
+		const uint64_t key = KeyOf(tileX, tileZ);
+		{
+			std::shared_lock<std::shared_mutex> lock(m_mutex);
+			auto it = m_tiles.find(key);
+			if (it != m_tiles.end()) {
+				return it->second;
+			}
+		}
+
+		// Build outside the lock; a racing thread computes the same tile and the first insert wins
+		auto tile = std::make_shared<Tile>(static_cast<size_t>(m_tileColumns * m_tileColumns));
+		m_filler(tileX * m_chunkSize, tileZ * m_chunkSize, m_spacing, m_tileColumns, tile->data());
+		m_tilesBuilt.fetch_add(1, std::memory_order_relaxed);
+
+		std::unique_lock<std::shared_mutex> lock(m_mutex);
+		auto result = m_tiles.emplace(key, std::move(tile));
+		std::shared_ptr<const Tile> acquired = result.first->second;
+		if (result.second && m_tiles.size() > m_capacity) {
+			EvictFarthest(tileX, tileZ);
+		}
+		return acquired;
+	}
+
+	void ColumnClimateCache::EvictFarthest(int32_t tileX, int32_t tileZ)
+	{
+		// Generation moves with the players, so the tiles farthest from the newest one go first
+		std::vector<std::pair<int64_t, uint64_t>> byDistance;
+		byDistance.reserve(m_tiles.size());
+		for (const auto& entry : m_tiles) {
+			int64_t x = static_cast<int32_t>(static_cast<uint32_t>(entry.first >> 32));
+			int64_t z = static_cast<int32_t>(static_cast<uint32_t>(entry.first));
+			int64_t distance = std::max(std::abs(x - tileX), std::abs(z - tileZ));
+			byDistance.emplace_back(distance, entry.first);
+		}
+
+		size_t keep = std::max<size_t>(m_capacity * 3 / 4, 1);
+		std::nth_element(byDistance.begin(), byDistance.begin() + static_cast<std::ptrdiff_t>(keep), byDistance.end());
+		for (size_t i = keep; i < byDistance.size(); ++i) {
+			m_tiles.erase(byDistance[i].second);
+		}
+	}
+
+	ChunkDensityField::ChunkDensityField(const DensityLatticeSettings& settings)
+		: m_settings(settings)
+		, m_columns(settings.chunkSize / settings.cellWidth + 1)
+		, m_layers(settings.height / settings.cellHeight + 1)
+		, m_hasCaves(false)
+	{
+		size_t count = static_cast<size_t>(m_columns * m_columns * m_layers);
+		m_density.resize(count);
+		m_cave.resize(count);
+		m_xs.resize(count);
+		m_ys.resize(count);
+		m_zs.resize(count);
+	}
+
+	void ChunkDensityField::Sample(int32_t chunkX, int32_t chunkZ, const ColumnClimate* columns,
+		NoiseGenerator* detail, NoiseGenerator* caves)
+	{
+		const int32_t originX = chunkX * m_settings.chunkSize;
+		const int32_t originZ = chunkZ * m_settings.chunkSize;
+
+		size_t index = 0;
+		for (int z = 0; z < m_columns; ++z) {
+			for (int x = 0; x < m_columns; ++x) {
+				for (int y = 0; y < m_layers; ++y, ++index) {
+					m_xs[index] = static_cast<float>(originX + x * m_settings.cellWidth);
+					m_ys[index] = static_cast<float>(y * m_settings.cellHeight);
+					m_zs[index] = static_cast<float>(originZ + z * m_settings.cellWidth);
+				}
+			}
+		}
+
+		const size_t count = m_density.size();
+		if (detail) {
+			detail->GetNoiseBatch(m_xs.data(), m_ys.data(), m_zs.data(), count, m_density.data());
+		} else {
+			std::fill(m_density.begin(), m_density.end(), 0.0f);
+		}
+
+		// Signed distance to the column's target surface, in units of squash
+		const float invSquash = 1.0f / m_settings.squash;
+		index = 0;
+		for (int column = 0; column < m_columns * m_columns; ++column) {
+			const float surface = columns[column].surfaceHeight;
+			for (int y = 0; y < m_layers; ++y, ++index) {
+				m_density[index] += (surface - m_ys[index]) * invSquash;
+			}
+		}
+
+		m_hasCaves = caves != nullptr;
+		if (m_hasCaves) {
+			caves->GetNoiseBatch(m_xs.data(), m_ys.data(), m_zs.data(), count, m_cave.data());
+		}
+	}
+
+	uint32_t ChunkDensityField::Rasterize(uint8_t* solid) const
+	{
+		const int size = m_settings.chunkSize;
+		const int height = m_settings.height;
+		const int cellWidth = m_settings.cellWidth;
+		const int cellHeight = m_settings.cellHeight;
+		const float invWidth = 1.0f / static_cast<float>(cellWidth);
+		const float invHeight = 1.0f / static_cast<float>(cellHeight);
+
+		std::vector<float> columnDensity(static_cast<size_t>(m_layers));
+		std::vector<float> columnCave(static_cast<size_t>(m_layers));
+		uint32_t carved = 0;
+
+		for (int z = 0; z < size; ++z) {
+			const int cellZ = z / cellWidth;
+			const float fz = static_cast<float>(z - cellZ * cellWidth) * invWidth;
+
+			for (int x = 0; x < size; ++x) {
+				const int cellX = x / cellWidth;
+				const float fx = static_cast<float>(x - cellX * cellWidth) * invWidth;
+
+				// Collapse the four surrounding lattice columns into one, then interpolate along Y
+				const size_t i00 = static_cast<size_t>((cellZ * m_columns + cellX) * m_layers);
+				const size_t i10 = i00 + static_cast<size_t>(m_layers);
+				const size_t i01 = i00 + static_cast<size_t>(m_columns * m_layers);
+				const size_t i11 = i01 + static_cast<size_t>(m_layers);
+
+				for (size_t j = 0; j < static_cast<size_t>(m_layers); ++j) {
+					columnDensity[j] = Lerp(Lerp(m_density[i00 + j], m_density[i10 + j], fx),
+						Lerp(m_density[i01 + j], m_density[i11 + j], fx), fz);
+				}
+				if (m_hasCaves) {
+					for (size_t j = 0; j < static_cast<size_t>(m_layers); ++j) {
+						columnCave[j] = Lerp(Lerp(m_cave[i00 + j], m_cave[i10 + j], fx),
+							Lerp(m_cave[i01 + j], m_cave[i11 + j], fx), fz);
+					}
+				}
+
+				uint8_t* column = solid + static_cast<size_t>((z * size + x) * height);
+				for (int y = 0; y < height; ++y) {
+					const size_t j = static_cast<size_t>(y / cellHeight);
+					const float fy = static_cast<float>(y - static_cast<int>(j) * cellHeight) * invHeight;
+
+					bool isSolid = Lerp(columnDensity[j], columnDensity[j + 1], fy) > 0.0f;
+					if (isSolid && m_hasCaves) {
+						float threshold = m_settings.caveThreshold -
+							(static_cast<float>(y) / static_cast<float>(height)) * m_settings.caveThresholdSlope;
+						if (Lerp(columnCave[j], columnCave[j + 1], fy) > threshold) {
+							isSolid = false;
+							++carved;
+						}
+					}
+					column[y] = isSolid ? 1 : 0;
+				}
+			}
+		}
+
+		return carved;
+	}
+
+	size_t ChunkDensityField::GetVoxelCount() const
+	{
+		return static_cast<size_t>(m_settings.chunkSize * m_settings.chunkSize * m_settings.height);
+	}
+
+} // namespace VoxelCraft
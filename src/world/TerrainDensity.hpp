@@ -0,0 +1,185 @@
+/**
+ * @file TerrainDensity.hpp
+ * @brief VoxelCraft World System - Coarse-lattice density field and column climate cache
+ * @version 1.0.0
+ * @author VoxelCraft Team
+ */
+
+#pragma once
+#include <memory>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <shared_mutex>
+#include <atomic>
+#include <cstdint>
+
+namespace VoxelCraft {
+
+	class NoiseGenerator;
+
+	/**
+	 * @brief Climate and terrain shape of one lattice column
+	 */
+	struct ColumnClimate
+	{
+		float temperature = 0.5f;        // 0-1
+		float humidity = 0.5f;           // 0-1
+		float continentalness = 0.5f;    // 0-1
+		float erosion = 0.5f;            // 0-1
+		float depth = 0.5f;              // 0-1
+		float weirdness = 0.5f;          // 0-1
+		float surfaceHeight = 64.0f;     // Target surface height in blocks
+		uint8_t biome = 0;               // Index into the generator's biome list
+	};
+
+	/**
+	 * @brief Lattice spacing and density shaping
+	 *
+	 * Noise is sampled every cellWidth blocks along X/Z and every cellHeight
+	 * blocks along Y, then trilinearly interpolated. Both spacings must divide
+	 * the chunk dimensions so lattice points fall on chunk borders.
+	 */
+	struct DensityLatticeSettings
+	{
+		int cellWidth = 4;               // X/Z spacing, divides chunkSize
+		int cellHeight = 8;              // Y spacing, divides height
+		int chunkSize = 16;              // Chunk width in blocks
+		int height = 256;                // Column height in blocks
+		float squash = 8.0f;             // Blocks over which density falls by 1 at the surface
+		float caveThreshold = 0.8f;      // Cave noise above this carves air at y = 0
+		float caveThresholdSlope = 0.3f; // Threshold drop from bottom to top of the column
+	};
+
+	/**
+	 * @brief Lattice-column climate shared by every chunk that touches it
+	 *
+	 * Tiles hold one chunk's lattice columns (chunkSize / cellWidth squared,
+	 * starting at the chunk origin). A chunk's own lattice also needs the
+	 * columns on its +X/+Z border, which belong to the neighbors' tiles; those
+	 * tiles are built once and reused when the neighbors generate, so each
+	 * lattice column is evaluated once no matter how many chunks read it.
+	 *
+	 * The filler must be a pure function of its arguments: tiles may be
+	 * evicted and rebuilt, or built concurrently by two threads, and every
+	 * copy has to be identical for generation to stay deterministic.
+	 */
+	class ColumnClimateCache
+	{
+	public:
+		/**
+		 * @brief Fill out[z * columns + x] for the column at (worldX + x * spacing, worldZ + z * spacing)
+		 */
+		using TileFiller = std::function<void(int32_t worldX, int32_t worldZ, int spacing, int columns, ColumnClimate* out)>;
+
+		/**
+		 * @brief Constructor
+		 * @param settings Lattice layout; tiles match its chunk and cell width
+		 * @param capacity Tiles kept before the farthest ones are evicted
+		 * @param filler Computes a tile
+		 */
+		ColumnClimateCache(const DensityLatticeSettings& settings, size_t capacity, TileFiller filler);
+
+		/**
+		 * @brief Climate of the lattice column at lattice coordinates (world / cellWidth)
+		 */
+		ColumnClimate Get(int32_t latticeX, int32_t latticeZ);
+
+		/**
+		 * @brief Climate at any world column, bilinearly interpolated between lattice columns
+		 *
+		 * surfaceHeight and the climate values are interpolated; biome comes from
+		 * the nearest lattice column.
+		 */
+		ColumnClimate Sample(int32_t worldX, int32_t worldZ);
+
+		/**
+		 * @brief The (columns + 1)^2 lattice columns of a chunk, border included
+		 * @param out Receives out[z * (columns + 1) + x]
+		 */
+		void GetChunkColumns(int32_t chunkX, int32_t chunkZ, ColumnClimate* out);
+
+		/**
+		 * @brief Drop every tile
+		 */
+		void Clear();
+
+		int GetTileColumns() const { return m_tileColumns; }
+		size_t GetTileCount() const;
+		uint64_t GetTilesBuilt() const { return m_tilesBuilt.load(std::memory_order_relaxed); }
+
+	private:
+		using Tile = std::vector<ColumnClimate>;
+
+		int m_spacing;
+		int m_tileColumns;
+		int m_chunkSize;
+		size_t m_capacity;
+		TileFiller m_filler;
+
+		mutable std::shared_mutex m_mutex;
+		std::unordered_map<uint64_t, std::shared_ptr<const Tile>> m_tiles;
+		std::atomic<uint64_t> m_tilesBuilt;
+
+		static uint64_t KeyOf(int32_t tileX, int32_t tileZ);
+		std::shared_ptr<const Tile> AcquireTile(int32_t tileX, int32_t tileZ);
+		void EvictFarthest(int32_t tileX, int32_t tileZ);
+	};
+
+	/**
+	 * @brief One chunk's density and cave fields on the coarse lattice
+	 *
+	 * Density is (surfaceHeight - y) / squash plus 3D detail noise, so the
+	 * surface follows the climate's target height with overhangs where the
+	 * detail dominates. Cave noise is sampled on the same lattice and carves
+	 * air where it exceeds a threshold that falls with height.
+	 *
+	 * Rasterize() interpolates both fields to every voxel: for a 16x256x16
+	 * chunk with a 4x8x4 lattice that is 5 * 33 * 5 = 825 noise samples per
+	 * field instead of 65536.
+	 */
+	class ChunkDensityField
+	{
+	public:
+		explicit ChunkDensityField(const DensityLatticeSettings& settings = DensityLatticeSettings());
+
+		/**
+		 * @brief Sample the lattice of a chunk
+		 * @param columns Lattice columns from ColumnClimateCache::GetChunkColumns
+		 * @param detail 3D noise added to the density; nullptr for a heightmap-only surface
+		 * @param caves 3D cave noise; nullptr disables carving
+		 */
+		void Sample(int32_t chunkX, int32_t chunkZ, const ColumnClimate* columns,
+			NoiseGenerator* detail, NoiseGenerator* caves);
+
+		/**
+		 * @brief Interpolate to full resolution
+		 * @param solid Receives chunkSize * chunkSize * height voxels, one column after
+		 *        another: solid[(z * chunkSize + x) * height + y], 1 for solid
+		 * @return Voxels turned to air by caves
+		 */
+		uint32_t Rasterize(uint8_t* solid) const;
+
+		const DensityLatticeSettings& GetSettings() const { return m_settings; }
+		int GetLatticeColumns() const { return m_columns; }
+		int GetLatticeLayers() const { return m_layers; }
+		size_t GetSampleCount() const { return m_density.size(); }
+		size_t GetVoxelCount() const;
+
+	private:
+		DensityLatticeSettings m_settings;
+		int m_columns;                   // Lattice points along X and Z
+		int m_layers;                    // Lattice points along Y
+		bool m_hasCaves;
+
+		// Lattice values, (z * columns + x) * layers + y
+		std::vector<float> m_density;
+		std::vector<float> m_cave;
+
+		// Batch noise coordinates
+		std::vector<float> m_xs;
+		std::vector<float> m_ys;
+		std::vector<float> m_zs;
+	};
+
+} // namespace VoxelCraft
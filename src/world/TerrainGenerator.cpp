@@ -3,6 +3,7 @@
 #include "Biome.hpp"
 #include "Block.hpp"
 #include "World.hpp"
+#include "NoiseGenerator.hpp"
 #include <algorithm>
 #include <cmath>
 #include <numeric>
@@ -43,6 +44,9 @@ namespace VoxelCraft {
 		// Initialize biomes
 		InitializeBiomes();
 
+		// Initialize density lattice and climate cache
+		InitializeDensityField();
+
 		// Initialize structure generators
 		InitializeStructureGenerators();
 
@@ -70,6 +74,7 @@ namespace VoxelCraft {
 		m_ridgeNoise.reset();
 		m_temperatureNoise.reset();
 		m_humidityNoise.reset();
+		m_climateCache.reset();
 
 		// Clear biomes
 		m_biomes.clear();
@@ -92,8 +97,12 @@ namespace VoxelCraft {
 			// Set chunk state to generating
 			chunk->SetState(ChunkState::GENERATING);
 
-			// Generate base terrain
-			GenerateBaseTerrain(chunk);
+			// Generate base terrain, with caves when it comes from the density field
+			if (m_params.useDensityField) {
+				GenerateDensityTerrain(chunk);
+			} else {
+				GenerateBaseTerrain(chunk);
+			}
 
 			// Apply biome modifications
 			if (m_params.enableBiomes) {
@@ -101,15 +110,14 @@ namespace VoxelCraft {
 			}
 
 			// Generate caves
-			if (m_params.enableCaves) {
+			if (m_params.enableCaves && !m_params.useDensityField) {
 				GenerateCaveSystems(chunk);
 			}
 
 			// Generate underground features
 			GenerateUnderground(chunk);
 
-			// Generate surface features
-			GenerateSurface(chunk);
+			// Surface features are placed later by DecorateChunk
 
 			// Generate ores
 			if (m_params.enableOres) {
@@ -134,7 +142,7 @@ namespace VoxelCraft {
 			chunk->SetState(ChunkState::READY);
 
 			auto endTime = std::chrono::steady_clock::now();
-			auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
+			std::chrono::duration<double, std::milli> duration = endTime - startTime;
 
 			// Update statistics
 			m_stats.chunksGenerated++;
@@ -148,12 +156,30 @@ namespace VoxelCraft {
 		}
 	}
 
+	void TerrainGenerator::DecorateChunk(std::shared_ptr<Chunk> chunk)
+	{
+		if (!m_initialized || !chunk) {
+			return;
+		}
+
+		try {
+			GenerateSurface(chunk);
+		} catch (const std::exception& e) {
+			VOXELCRAFT_LOG_ERROR("Failed to decorate chunk ({}, {}): {}", chunk->GetCoord().x, chunk->GetCoord().z, e.what());
+			chunk->SetState(ChunkState::ERROR);
+		}
+	}
+
 	float TerrainGenerator::GenerateHeight(int32_t worldX, int32_t worldZ)
 	{
 		if (!m_initialized || !m_terrainNoise) {
 			return m_params.baseHeight;
 		}
 
+		if (m_params.useDensityField && m_climateCache) {
+			return m_climateCache->Sample(worldX, worldZ).surfaceHeight;
+		}
+
 		// Get biome region
 		auto region = GetBiomeRegion(worldX, worldZ);
 
@@ -182,6 +208,19 @@ namespace VoxelCraft {
 	{
 		BiomeRegion region;
 
+		if (m_params.useDensityField && m_climateCache) {
+			// Interpolated from the lattice columns the chunk was generated from
+			ColumnClimate climate = m_climateCache->Sample(worldX, worldZ);
+			region.biome = m_biomes[climate.biome];
+			region.temperature = climate.temperature;
+			region.humidity = climate.humidity;
+			region.continentalness = climate.continentalness;
+			region.erosion = climate.erosion;
+			region.depth = climate.depth;
+			region.weirdness = climate.weirdness;
+			return region;
+		}
+
 		// Get biome noise values
 		GetBiomeNoiseValues(worldX, worldZ, region.temperature, region.humidity,
 			region.continentalness, region.erosion, region.depth, region.weirdness);
@@ -269,6 +308,12 @@ namespace VoxelCraft {
 	void TerrainGenerator::SetParams(const TerrainParams& params)
 	{
 		m_params = params;
+
+		// Cached climate depends on the terrain parameters
+		if (m_initialized) {
+			InitializeDensityField();
+		}
+
 		VOXELCRAFT_LOG_INFO("TerrainGenerator parameters updated");
 	}
 
@@ -297,54 +342,38 @@ namespace VoxelCraft {
 
 	void TerrainGenerator::InitializeNoiseGenerators()
 	{
+		auto makeNoise = [](uint64_t seed, int octaves, float persistence, float lacunarity, float scale) {
+			NoiseConfig config = NoiseGeneratorFactory::GetDefaultConfig(NoiseType::Fractal,
+				static_cast<int>(static_cast<uint32_t>(seed ^ (seed >> 32))));
+			config.octaves = octaves;
+			config.persistence = persistence;
+			config.lacunarity = lacunarity;
+			config.frequency = scale;
+			return std::make_unique<NoiseGenerator>(config);
+		};
+
 		// Initialize terrain noise generator
-		m_terrainNoise = std::make_unique<NoiseGenerator>(m_seed.terrainSeed);
-		m_terrainNoise->SetOctaves(m_params.octaves);
-		m_terrainNoise->SetPersistence(m_params.persistence);
-		m_terrainNoise->SetLacunarity(m_params.lacunarity);
-		m_terrainNoise->SetScale(m_params.noiseScale);
+		m_terrainNoise = makeNoise(m_seed.terrainSeed, m_params.octaves, m_params.persistence,
+			m_params.lacunarity, m_params.noiseScale);
 
 		// Initialize biome noise generator
-		m_biomeNoise = std::make_unique<NoiseGenerator>(m_seed.biomeSeed);
-		m_biomeNoise->SetOctaves(4);
-		m_biomeNoise->SetPersistence(0.6f);
-		m_biomeNoise->SetLacunarity(2.2f);
-		m_biomeNoise->SetScale(m_params.biomeScale);
+		m_biomeNoise = makeNoise(m_seed.biomeSeed, 4, 0.6f, 2.2f, m_params.biomeScale);
 
 		// Initialize cave noise generator
-		m_caveNoise = std::make_unique<NoiseGenerator>(m_seed.caveSeed);
-		m_caveNoise->SetOctaves(3);
-		m_caveNoise->SetPersistence(0.7f);
-		m_caveNoise->SetLacunarity(2.0f);
-		m_caveNoise->SetScale(m_params.caveScale);
+		m_caveNoise = makeNoise(m_seed.caveSeed, 3, 0.7f, 2.0f, m_params.caveScale);
 
 		// Initialize structure noise generator
-		m_structureNoise = std::make_unique<NoiseGenerator>(m_seed.structureSeed);
-		m_structureNoise->SetOctaves(2);
-		m_structureNoise->SetPersistence(0.8f);
-		m_structureNoise->SetLacunarity(1.8f);
-		m_structureNoise->SetScale(m_params.structureScale);
+		m_structureNoise = makeNoise(m_seed.structureSeed, 2, 0.8f, 1.8f, m_params.structureScale);
 
 		// Initialize ridge noise generator
-		m_ridgeNoise = std::make_unique<NoiseGenerator>(m_seed.terrainSeed + 1);
-		m_ridgeNoise->SetOctaves(m_params.octaves);
-		m_ridgeNoise->SetPersistence(m_params.persistence);
-		m_ridgeNoise->SetLacunarity(m_params.lacunarity);
-		m_ridgeNoise->SetScale(m_params.noiseScale * 0.5f);
+		m_ridgeNoise = makeNoise(m_seed.terrainSeed + 1, m_params.octaves, m_params.persistence,
+			m_params.lacunarity, m_params.noiseScale * 0.5f);
 
 		// Initialize temperature noise generator
-		m_temperatureNoise = std::make_unique<NoiseGenerator>(m_seed.biomeSeed + 1);
-		m_temperatureNoise->SetOctaves(4);
-		m_temperatureNoise->SetPersistence(0.6f);
-		m_temperatureNoise->SetLacunarity(2.2f);
-		m_temperatureNoise->SetScale(m_params.biomeScale);
+		m_temperatureNoise = makeNoise(m_seed.biomeSeed + 1, 4, 0.6f, 2.2f, m_params.biomeScale);
 
 		// Initialize humidity noise generator
-		m_humidityNoise = std::make_unique<NoiseGenerator>(m_seed.biomeSeed + 2);
-		m_humidityNoise->SetOctaves(4);
-		m_humidityNoise->SetPersistence(0.6f);
-		m_humidityNoise->SetLacunarity(2.2f);
-		m_humidityNoise->SetScale(m_params.biomeScale);
+		m_humidityNoise = makeNoise(m_seed.biomeSeed + 2, 4, 0.6f, 2.2f, m_params.biomeScale);
 
 		VOXELCRAFT_LOG_INFO("Noise generators initialized");
 	}
@@ -420,6 +449,27 @@ namespace VoxelCraft {
 		VOXELCRAFT_LOG_INFO("Biomes initialized: {} total", m_biomes.size());
 	}
 
+	void TerrainGenerator::InitializeDensityField()
+	{
+		m_densitySettings = DensityLatticeSettings();
+		m_densitySettings.cellWidth = m_params.densityCellWidth;
+		m_densitySettings.cellHeight = m_params.densityCellHeight;
+		m_densitySettings.squash = m_params.densitySquash;
+
+		if (Chunk::CHUNK_SIZE % m_densitySettings.cellWidth != 0 ||
+			m_densitySettings.height % m_densitySettings.cellHeight != 0) {
+			VOXELCRAFT_LOG_WARN("Density lattice {}x{} does not divide the chunk, using 4x8",
+				m_densitySettings.cellWidth, m_densitySettings.cellHeight);
+			m_densitySettings.cellWidth = 4;
+			m_densitySettings.cellHeight = 8;
+		}
+
+		m_climateCache = std::make_unique<ColumnClimateCache>(m_densitySettings, m_params.climateCacheTiles,
+			[this](int32_t worldX, int32_t worldZ, int spacing, int columns, ColumnClimate* out) {
+				FillClimateTile(worldX, worldZ, spacing, columns, out);
+			});
+	}
+
 	void TerrainGenerator::InitializeStructureGenerators()
 	{
 		// Initialize structure generators
@@ -475,6 +525,92 @@ namespace VoxelCraft {
 		}
 	}
 
+	void TerrainGenerator::GenerateDensityTerrain(std::shared_ptr<Chunk> chunk)
+	{
+		if (!chunk || !m_climateCache) return;
+
+		auto chunkCoord = chunk->GetCoord();
+		ChunkDensityField field(m_densitySettings);
+
+		// Lattice columns of this chunk, the +X/+Z border shared with the neighbors
+		const int latticeColumns = field.GetLatticeColumns();
+		std::vector<ColumnClimate> columns(static_cast<size_t>(latticeColumns * latticeColumns));
+		m_climateCache->GetChunkColumns(chunkCoord.x, chunkCoord.z, columns.data());
+
+		field.Sample(chunkCoord.x, chunkCoord.z, columns.data(), m_terrainNoise.get(),
+			m_params.enableCaves ? m_caveNoise.get() : nullptr);
+
+		std::vector<uint8_t> solid(field.GetVoxelCount());
+		m_stats.cavesGenerated += field.Rasterize(solid.data());
+
+		const int height = m_densitySettings.height;
+		for (int x = 0; x < Chunk::CHUNK_SIZE; ++x) {
+			for (int z = 0; z < Chunk::CHUNK_SIZE; ++z) {
+				const uint8_t* column = &solid[static_cast<size_t>((z * Chunk::CHUNK_SIZE + x) * height)];
+
+				int surface = height - 1;
+				while (surface > 0 && !column[surface]) {
+					--surface;
+				}
+
+				for (int y = 0; y < height; ++y) {
+					uint16_t blockId = 0; // Air
+					if (column[y]) {
+						if (y == surface) {
+							blockId = 3; // Grass
+						} else if (y >= surface - 3) {
+							blockId = 2; // Dirt
+						} else {
+							blockId = 1; // Stone
+						}
+					}
+					chunk->SetBlockId(static_cast<uint8_t>(x), static_cast<uint8_t>(y), static_cast<uint8_t>(z), blockId);
+				}
+
+				chunk->SetHeight(static_cast<uint8_t>(x), static_cast<uint8_t>(z), static_cast<uint8_t>(surface));
+			}
+		}
+	}
+
+	void TerrainGenerator::FillClimateTile(int32_t worldX, int32_t worldZ, int spacing, int columns, ColumnClimate* out)
+	{
+		const size_t count = static_cast<size_t>(columns * columns);
+		std::vector<float> temperature(count), humidity(count), continentalness(count);
+		std::vector<float> erosion(count), weirdness(count), baseNoise(count), ridgeNoise(count);
+
+		// The same XZ planes GetBiomeNoiseValues and GenerateHeight sample, one batch each
+		const float x = static_cast<float>(worldX);
+		const float z = static_cast<float>(worldZ);
+		const float step = static_cast<float>(spacing);
+		m_temperatureNoise->FillGrid3D(temperature.data(), x, 0.0f, z, step, columns, 1, columns);
+		m_humidityNoise->FillGrid3D(humidity.data(), x, 0.0f, z, step, columns, 1, columns);
+		m_biomeNoise->FillGrid3D(continentalness.data(), x, 0.0f, z, step, columns, 1, columns);
+		m_structureNoise->FillGrid3D(erosion.data(), x, 100.0f, z, step, columns, 1, columns);
+		m_ridgeNoise->FillGrid3D(weirdness.data(), x, 200.0f, z, step, columns, 1, columns);
+		m_terrainNoise->FillGrid3D(baseNoise.data(), x, 0.0f, z, step, columns, 1, columns);
+		m_ridgeNoise->FillGrid3D(ridgeNoise.data(), x, 0.0f, z, step, columns, 1, columns);
+
+		for (size_t i = 0; i < count; ++i) {
+			const int64_t columnX = worldX + static_cast<int32_t>(i % static_cast<size_t>(columns)) * spacing;
+			const int64_t columnZ = worldZ + static_cast<int32_t>(i / static_cast<size_t>(columns)) * spacing;
+
+			ColumnClimate& climate = out[i];
+			climate.temperature = (temperature[i] + 1.0f) * 0.5f;
+			climate.humidity = (humidity[i] + 1.0f) * 0.5f;
+			climate.continentalness = (continentalness[i] + 1.0f) * 0.5f;
+			climate.erosion = (erosion[i] + 1.0f) * 0.5f;
+			climate.depth = (static_cast<float>(columnX * columnZ % 100) / 100.0f + 1.0f) * 0.5f;
+			climate.weirdness = (weirdness[i] + 1.0f) * 0.5f;
+			climate.biome = FindClosestBiome(climate.temperature, climate.humidity);
+
+			// GenerateHeight and ApplyHeightModifications folded together
+			float combinedNoise = baseNoise[i] * (1.0f - m_params.ridgeWeight) + ridgeNoise[i] * m_params.ridgeWeight;
+			combinedNoise *= m_biomes[climate.biome]->GetHeightVariation();
+			combinedNoise *= (1.0f - climate.erosion * 0.5f) * (1.0f + climate.continentalness * 0.3f);
+			climate.surfaceHeight = m_params.baseHeight + combinedNoise * m_params.heightVariation;
+		}
+	}
+
 	void TerrainGenerator::ApplyBiomeModifications(std::shared_ptr<Chunk> chunk)
 	{
 		if (!chunk) return;
@@ -721,23 +857,28 @@ namespace VoxelCraft {
 
 	std::shared_ptr<Biome> TerrainGenerator::DetermineBiome(float temperature, float humidity,
 		float continentalness, float erosion, float depth, float weirdness)
+	{
+		m_stats.biomesGenerated++;
+		return m_biomes[FindClosestBiome(temperature, humidity)];
+	}
+
+	uint8_t TerrainGenerator::FindClosestBiome(float temperature, float humidity) const
 	{
 		// Simple biome selection based on temperature and humidity
-		std::shared_ptr<Biome> bestBiome = m_biomes[0];
+		uint8_t bestBiome = 0;
 		float bestScore = std::numeric_limits<float>::max();
 
-		for (auto& biome : m_biomes) {
-			float tempDiff = std::abs(biome->GetTemperature() - temperature);
-			float humidDiff = std::abs(biome->GetHumidity() - humidity);
+		for (size_t i = 0; i < m_biomes.size(); ++i) {
+			float tempDiff = std::abs(m_biomes[i]->GetTemperature() - temperature);
+			float humidDiff = std::abs(m_biomes[i]->GetHumidity() - humidity);
 			float score = tempDiff * tempDiff + humidDiff * humidDiff;
 
 			if (score < bestScore) {
 				bestScore = score;
-				bestBiome = biome;
+				bestBiome = static_cast<uint8_t>(i);
 			}
 		}
 
-		m_stats.biomesGenerated++;
 		return bestBiome;
 	}
 
@@ -6,6 +6,7 @@
 #include <cstdint>
 #include "core/Logger.hpp"
 #include "world/ChunkSystem.hpp"
+#include "world/TerrainDensity.hpp"
 
 namespace VoxelCraft {
 
@@ -52,6 +53,13 @@ namespace VoxelCraft {
 		bool enableStructures = true;    // Enable structure generation
 		bool enableBiomes = true;        // Enable biome-based generation
 		bool enableOres = true;          // Enable ore generation
+
+		// Density field generation
+		bool useDensityField = true;     // Sample noise on a coarse lattice and interpolate
+		int densityCellWidth = 4;        // Lattice spacing along X/Z, divides CHUNK_SIZE
+		int densityCellHeight = 8;       // Lattice spacing along Y, divides the column height
+		float densitySquash = 8.0f;      // Blocks over which density falls by 1 at the surface
+		size_t climateCacheTiles = 4096; // Chunk columns of cached lattice climate
 	};
 
 	/**
@@ -113,6 +121,12 @@ namespace VoxelCraft {
 	 * - Trees, plants, and natural decorations
 	 * - Weather and climate variations
 	 * - Procedural structures (villages, dungeons, etc.)
+	 *
+	 * With TerrainParams::useDensityField the base terrain and caves come from
+	 * a ChunkDensityField sampled on a coarse lattice, and per-column climate
+	 * is read from a ColumnClimateCache shared with the neighboring chunks.
+	 * Both are pure functions of the seed, so the result does not depend on
+	 * generation order.
 	 */
 	class TerrainGenerator
 	{
@@ -138,10 +152,18 @@ namespace VoxelCraft {
 		void Shutdown();
 
 		/**
-		 * @brief Generate a complete chunk
+		 * @brief Generate a chunk's terrain, caves, ores and structures
 		 */
 		void GenerateChunk(std::shared_ptr<Chunk> chunk);
 
+		/**
+		 * @brief Place surface vegetation and decorations
+		 *
+		 * Runs after GenerateChunk once the chunk's neighbors are generated,
+		 * so features may extend across the chunk border.
+		 */
+		void DecorateChunk(std::shared_ptr<Chunk> chunk);
+
 		/**
 		 * @brief Generate terrain height at world coordinates
 		 */
@@ -232,6 +254,10 @@ namespace VoxelCraft {
 		std::unique_ptr<NoiseGenerator> m_temperatureNoise;
 		std::unique_ptr<NoiseGenerator> m_humidityNoise;
 
+		// Density field generation
+		DensityLatticeSettings m_densitySettings;
+		std::unique_ptr<ColumnClimateCache> m_climateCache;
+
 		// Biome registry
 		std::vector<std::shared_ptr<Biome>> m_biomes;
 		std::unordered_map<std::string, std::shared_ptr<Biome>> m_biomeMap;
@@ -253,11 +279,26 @@ namespace VoxelCraft {
 		 */
 		void InitializeBiomes();
 
+		/**
+		 * @brief Initialize the lattice settings and climate cache
+		 */
+		void InitializeDensityField();
+
 		/**
 		 * @brief Generate base terrain
 		 */
 		void GenerateBaseTerrain(std::shared_ptr<Chunk> chunk);
 
+		/**
+		 * @brief Generate base terrain and caves from the interpolated density field
+		 */
+		void GenerateDensityTerrain(std::shared_ptr<Chunk> chunk);
+
+		/**
+		 * @brief Compute the climate of a tile of lattice columns for the climate cache
+		 */
+		void FillClimateTile(int32_t worldX, int32_t worldZ, int spacing, int columns, ColumnClimate* out);
+
 		/**
 		 * @brief Apply biome modifications
 		 */
@@ -304,6 +345,11 @@ namespace VoxelCraft {
 		std::shared_ptr<Biome> DetermineBiome(float temperature, float humidity,
 			float continentalness, float erosion, float depth, float weirdness);
 
+		/**
+		 * @brief Index of the biome closest to a climate
+		 */
+		uint8_t FindClosestBiome(float temperature, float humidity) const;
+
 		/**
 		 * @brief Calculate terrain height at coordinates
 		 */
@@ -6,6 +6,7 @@
  */
 
 #include "World.hpp"
+#include "SectionCulling.hpp"
 #include <algorithm>
 #include <cmath>
 #include <iostream>
@@ -38,6 +39,8 @@ World::World(const WorldSettings& settings)
     m_stats.chunkGenTime = 0.0f;
     m_stats.memoryUsage = 0;
     m_stats.chunksInQueue = 0;
+    m_stats.cullingTests = 0;
+    m_stats.cullingPassed = 0;
 }
 
 World::~World() {
@@ -114,19 +117,56 @@ void World::Update(float deltaTime, const Vec3& playerPosition) {
 }
 
 void World::Render(const Vec3& cameraPosition) {
+    // No view direction: distance culling only
+    Render(cameraPosition, ViewFrustum());
+}
+
+void World::Render(const Vec3& cameraPosition, const ViewFrustum& frustum) {
     if (m_state != WorldState::READY) {
         return;
     }
 
     std::lock_guard<std::mutex> lock(m_chunkMutex);
 
-    // Simple frustum culling and render chunks
+    const int cameraChunkX = static_cast<int>(std::floor(cameraPosition.x / CHUNK_SIZE));
+    const int cameraChunkZ = static_cast<int>(std::floor(cameraPosition.z / CHUNK_SIZE));
+    const int renderDistance = m_settings.renderDistance;
+    const int sections = std::max(1, m_settings.worldHeight / SectionCulling::SECTION_SIZE);
+
+    // Gather the sections of every chunk in range, then test them in one batch
+    std::vector<Chunk*> candidates;
+    SectionBoxes boxes;
+    boxes.Reserve(m_loadedChunks.size() * static_cast<size_t>(sections));
     for (const auto& pair : m_loadedChunks) {
-        std::shared_ptr<Chunk> chunk = pair.second;
-        if (chunk && chunk->IsVisible()) {
-            // TODO: Add proper frustum culling
-            // For now, render all loaded chunks
-            chunk->Render();
+        Chunk* chunk = pair.second.get();
+        if (!chunk || !chunk->IsVisible()) {
+            continue;
+        }
+        const int dx = pair.first.x - cameraChunkX;
+        const int dz = pair.first.z - cameraChunkZ;
+        if (dx * dx + dz * dz > renderDistance * renderDistance) {
+            continue;
+        }
+
+        const float x0 = static_cast<float>(pair.first.x * CHUNK_SIZE);
+        const float z0 = static_cast<float>(pair.first.z * CHUNK_SIZE);
+        for (int s = 0; s < sections; ++s) {
+            const float y0 = static_cast<float>(s * SectionCulling::SECTION_SIZE);
+            boxes.Add(x0, y0, z0, x0 + CHUNK_SIZE, y0 + SectionCulling::SECTION_SIZE, z0 + CHUNK_SIZE);
+        }
+        candidates.push_back(chunk);
+    }
+
+    std::vector<uint8_t> visible(boxes.Size());
+    const size_t passed = SectionCulling::CullBoxes(frustum, boxes, visible.data());
+    m_stats.cullingTests = static_cast<int>(boxes.Size());
+    m_stats.cullingPassed = static_cast<int>(passed);
+
+    // A chunk is drawn whole if any of its sections is in view
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        const uint8_t* chunkVisible = &visible[i * static_cast<size_t>(sections)];
+        if (std::any_of(chunkVisible, chunkVisible + sections, [](uint8_t v) { return v != 0; })) {
+            candidates[i]->Render();
         }
     }
 }
@@ -29,6 +29,7 @@ namespace VoxelCraft {
     class WorldGenerator;
     struct Vec3;
     struct Vec2;
+    class ViewFrustum;
 
     /**
      * @enum WorldType
@@ -99,6 +100,8 @@ namespace VoxelCraft {
         float chunkGenTime;    // Average chunk generation time in ms
         size_t memoryUsage;    // Memory used by world data
         int chunksInQueue;     // Chunks waiting to be loaded/generated
+        int cullingTests;      // Sections tested against the frustum in the last Render
+        int cullingPassed;     // Sections inside it
     };
 
     /**
@@ -148,6 +151,13 @@ namespace VoxelCraft {
          */
         void Render(const Vec3& cameraPosition);
 
+        /**
+         * @brief Render the chunks within render distance that have a section in the frustum
+         * @param cameraPosition Camera position for distance culling
+         * @param frustum Camera view frustum
+         */
+        void Render(const Vec3& cameraPosition, const ViewFrustum& frustum);
+
         // Block operations
 
         /**